@@ -552,6 +552,8 @@ public:
     friend class PollingPreservedDirDepthUnittest;
     friend class InputStaticFileUnittest;
     friend class LogInputReaderUnittest;
+    friend class CheckpointManagerUnittest;
+    friend class CheckpointJournalBenchmark;
 #endif
 };
 
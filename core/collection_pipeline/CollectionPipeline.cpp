@@ -27,6 +27,7 @@
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
 #include "collection_pipeline/plugin/PluginRegistry.h"
+#include "collection_pipeline/queue/PendingPushManager.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "collection_pipeline/queue/SenderQueueManager.h"
@@ -35,12 +36,16 @@
 #include "config/OnetimeConfigInfoManager.h"
 #include "go_pipeline/LogtailPlugin.h"
 #include "logger/Logger.h"
+#include "monitor/CpuProfiler.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
 #include "plugin/input/InputFeedbackInterfaceRegistry.h"
 #include "plugin/processor/ProcessorParseApsaraNative.h"
 #include "plugin/processor/inner/ProcessorTagNative.h"
 
 DECLARE_FLAG_INT32(default_plugin_log_queue_size);
+DEFINE_FLAG_BOOL(enable_processor_fusion,
+                 "run consecutive processors supporting per event processing in a single pass over each group",
+                 false);
 
 using namespace std;
 
@@ -347,8 +352,10 @@ bool CollectionPipeline::Init(CollectionConfig&& config) {
                 feedbackSet.insert(feedback);
             }
         }
-        ProcessQueueManager::GetInstance()->SetFeedbackInterface(
-            mContext.GetProcessQueueKey(), vector<FeedbackInterface*>(feedbackSet.begin(), feedbackSet.end()));
+        vector<FeedbackInterface*> feedbacks(feedbackSet.begin(), feedbackSet.end());
+        // for items parked by producers when the queue is full
+        feedbacks.push_back(PendingPushManager::GetInstance());
+        ProcessQueueManager::GetInstance()->SetFeedbackInterface(mContext.GetProcessQueueKey(), std::move(feedbacks));
 
         vector<BoundedSenderQueueInterface*> senderQueues;
         for (const auto& flusher : mFlushers) {
@@ -370,15 +377,22 @@ bool CollectionPipeline::Init(CollectionConfig&& config) {
                                                          {METRIC_LABEL_KEY_PIPELINE_NAME, mName},
                                                          {METRIC_LABEL_KEY_LOGSTORE, mContext.GetLogstoreName()}});
     mStartTime = mMetricsRecordRef.CreateIntGauge(METRIC_PIPELINE_START_TIME);
-    mProcessorsInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL);
-    mProcessorsInGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL);
-    mProcessorsInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES);
+    mProcessorsInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL, true);
+    mProcessorsInGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL, true);
+    mProcessorsInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES, true);
     mProcessorsTotalProcessTimeMs
-        = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS);
-    mFlushersInGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL);
-    mFlushersInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL);
-    mFlushersInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES);
-    mFlushersTotalPackageTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS);
+        = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS, true);
+    mProcessorsInLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_PIPELINE_PROCESSORS_IN_LATENCY_MS);
+    mFlushersInGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL, true);
+    mFlushersInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL, true);
+    mFlushersInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES, true);
+    mFlushersTotalPackageTimeMs
+        = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS, true);
+    mFlushersInLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_PIPELINE_FLUSHERS_IN_LATENCY_MS);
+    if (CpuProfiler::IsEnabled()) {
+        mCpuProfileTag = CpuProfiler::GetInstance()->RegisterTag(
+            mName, "", "", mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_CPU_TIME_MS, true));
+    }
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 
     return true;
@@ -411,17 +425,17 @@ void CollectionPipeline::Start() {
 }
 
 void CollectionPipeline::Process(vector<PipelineEventGroup>& logGroupList, size_t inputIndex) {
+    auto now = chrono::system_clock::now();
     for (const auto& logGroup : logGroupList) {
         ADD_COUNTER(mProcessorsInEventsTotal, logGroup.GetEvents().size());
         ADD_COUNTER(mProcessorsInSizeBytes, logGroup.DataSize());
+        ADD_HISTOGRAM(mProcessorsInLatencyMs, now - logGroup.GetCreateTime());
     }
     ADD_COUNTER(mProcessorsInGroupsTotal, logGroupList.size())
 
     auto before = chrono::system_clock::now();
     if (inputIndex < mInputs.size()) {
-        for (auto& p : mInputs[inputIndex]->GetInnerProcessors()) {
-            p->Process(logGroupList);
-        }
+        ProcessLine(mInputs[inputIndex]->GetInnerProcessors(), logGroupList);
     } else {
         LOG_WARNING(sLogger,
                     ("input index out of range", "skip inner processing")(
@@ -435,19 +449,41 @@ void CollectionPipeline::Process(vector<PipelineEventGroup>& logGroupList, size_
             GetContext().GetConfigName(),
             GetContext().GetLogstoreName());
     }
-    for (auto& p : mPipelineInnerProcessorLine) {
-        p->Process(logGroupList);
+    ProcessLine(mPipelineInnerProcessorLine, logGroupList);
+    ProcessLine(mProcessorLine, logGroupList);
+    ADD_COUNTER(mProcessorsTotalProcessTimeMs, chrono::system_clock::now() - before);
+}
+
+void CollectionPipeline::ProcessLine(const vector<unique_ptr<ProcessorInstance>>& processorLine,
+                                     vector<PipelineEventGroup>& logGroupList) {
+    if (!BOOL_FLAG(enable_processor_fusion)) {
+        for (auto& p : processorLine) {
+            p->Process(logGroupList);
+        }
+        return;
     }
-    for (auto& p : mProcessorLine) {
-        p->Process(logGroupList);
+    // consecutive per event processors are fused, while the others, e.g. split and multiline, work on whole groups
+    for (size_t begin = 0; begin < processorLine.size();) {
+        size_t end = begin;
+        while (end < processorLine.size() && processorLine[end]->SupportsEventProcessing()) {
+            ++end;
+        }
+        if (end - begin > 1) {
+            ProcessorInstance::ProcessFused(processorLine, begin, end, logGroupList);
+            begin = end;
+        } else {
+            processorLine[begin]->Process(logGroupList);
+            ++begin;
+        }
     }
-    ADD_COUNTER(mProcessorsTotalProcessTimeMs, chrono::system_clock::now() - before);
 }
 
 bool CollectionPipeline::Send(vector<PipelineEventGroup>&& groupList) {
+    auto now = chrono::system_clock::now();
     for (const auto& group : groupList) {
         ADD_COUNTER(mFlushersInEventsTotal, group.GetEvents().size());
         ADD_COUNTER(mFlushersInSizeBytes, group.DataSize());
+        ADD_HISTOGRAM(mFlushersInLatencyMs, now - group.GetCreateTime());
     }
     ADD_COUNTER(mFlushersInGroupsTotal, groupList.size());
 
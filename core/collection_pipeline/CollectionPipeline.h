@@ -71,6 +71,7 @@ public:
     const std::optional<std::string>& GetSingletonInput() const { return mSingletonInput; }
     const std::vector<std::unique_ptr<FlusherInstance>>& GetFlushers() const { return mFlushers; }
     bool IsFlushingThroughGoPipeline() const { return !mGoPipelineWithoutInput.isNull(); }
+    uint32_t GetCpuProfileTag() const { return mCpuProfileTag; }
 
     // only for input_file
     const std::vector<std::unique_ptr<InputInstance>>& GetInputs() const { return mInputs; }
@@ -93,6 +94,8 @@ private:
     void CopyNativeGlobalParamToGoPipeline(Json::Value& root);
     void CopyTagParamToGoPipeline(Json::Value& root, const Json::Value* config);
     bool ShouldAddPluginToGoPipelineWithInput() const { return mInputs.empty() && mProcessorLine.empty(); }
+    static void ProcessLine(const std::vector<std::unique_ptr<ProcessorInstance>>& processorLine,
+                            std::vector<PipelineEventGroup>& logGroupList);
     void WaitAllItemsInProcessFinished();
 
     std::string mName;
@@ -118,10 +121,15 @@ private:
     CounterPtr mProcessorsInGroupsTotal;
     CounterPtr mProcessorsInSizeBytes;
     TimeCounterPtr mProcessorsTotalProcessTimeMs;
+    // time from the groups being created by inputs to entering processors and flushers
+    HistogramPtr mProcessorsInLatencyMs;
     CounterPtr mFlushersInGroupsTotal;
     CounterPtr mFlushersInEventsTotal;
     CounterPtr mFlushersInSizeBytes;
     TimeCounterPtr mFlushersTotalPackageTimeMs;
+    HistogramPtr mFlushersInLatencyMs;
+    // marks the cpu used by the pipeline, including its plugins, for the cpu profiler
+    uint32_t mCpuProfileTag = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PipelineMock;
@@ -64,6 +64,8 @@ private:
     ~CollectionPipelineManager() = default;
 
     virtual std::shared_ptr<CollectionPipeline> BuildPipeline(CollectionConfig&& config); // virtual for ut
+    // the i-th pipeline is built from configs[i], and is nullptr if failed
+    std::vector<std::shared_ptr<CollectionPipeline>> BuildPipelines(std::vector<CollectionConfig>& configs);
     void FlushAllBatch();
     // TODO: 长期过渡使用
     bool CheckIfFileServerUpdated(CollectionConfigDiff& diff);
@@ -76,6 +78,7 @@ private:
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PipelineManagerMock;
     friend class PipelineManagerUnittest;
+    friend class PipelineBuildBenchmark;
     friend class ProcessQueueManagerUnittest;
     friend class ExactlyOnceQueueManagerUnittest;
     friend class BoundedProcessQueueUnittest;
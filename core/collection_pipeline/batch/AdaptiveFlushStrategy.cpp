@@ -0,0 +1,95 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/batch/AdaptiveFlushStrategy.h"
+
+#include <algorithm>
+
+DEFINE_FLAG_INT32(batcher_adaptive_adjust_interval_secs, "interval to adjust the adaptive batch size targets", 10);
+
+using namespace std;
+
+namespace logtail {
+
+AdaptiveFlushStrategy::AdaptiveFlushStrategy(uint32_t minSizeBytes,
+                                             uint32_t maxSizeBytes,
+                                             uint32_t maxSerializedSizeBytes,
+                                             uint32_t timeoutMs)
+    : mConfiguredMinSizeBytes(minSizeBytes),
+      mConfiguredMaxSizeBytes(maxSizeBytes),
+      mMaxSerializedSizeBytes(maxSerializedSizeBytes),
+      mTimeoutMs(timeoutMs),
+      mMinSizeBytes(minSizeBytes),
+      mMaxSizeBytes(maxSizeBytes) {
+}
+
+void AdaptiveFlushStrategy::OnSerialized(size_t inSizeBytes, size_t outSizeBytes) {
+    if (inSizeBytes == 0) {
+        return;
+    }
+    double ratio = static_cast<double>(outSizeBytes) / inSizeBytes;
+    if (mSerializeRatio == 0.0) {
+        mSerializeRatio = ratio;
+    } else {
+        mSerializeRatio
+            = (1 - kSerializeRatioSmoothingFactor) * mSerializeRatio + kSerializeRatioSmoothingFactor * ratio;
+    }
+}
+
+void AdaptiveFlushStrategy::OnSendDone(chrono::milliseconds queueTime, chrono::milliseconds responseTime) {
+    ++mSendDoneCnt;
+    mQueueTimeSumMs += max<int64_t>(queueTime.count(), 0);
+    mResponseTimeSumMs += max<int64_t>(responseTime.count(), 0);
+}
+
+bool AdaptiveFlushStrategy::Update(chrono::steady_clock::time_point now) {
+    if (mLastUpdateTime == chrono::steady_clock::time_point()) {
+        mLastUpdateTime = now;
+        return false;
+    }
+    auto elapsed = now - mLastUpdateTime;
+    if (elapsed <= chrono::steady_clock::duration::zero()
+        || elapsed < chrono::seconds(INT32_FLAG(batcher_adaptive_adjust_interval_secs))) {
+        return false;
+    }
+    double inRate = mInSizeBytes / chrono::duration<double>(elapsed).count();
+    mLastUpdateTime = now;
+    mInSizeBytes = 0;
+
+    // without any request done in the interval, the sender is assumed to be as busy as before
+    if (mSendDoneCnt > 0) {
+        double rttPressure = (mResponseTimeSumMs / mSendDoneCnt - kLowRttMs) / (kHighRttMs - kLowRttMs);
+        double queuePressure = mTimeoutMs == 0 ? 0.0 : mQueueTimeSumMs / mSendDoneCnt / mTimeoutMs;
+        mPressure = clamp(max(rttPressure, queuePressure), 0.0, 1.0);
+        mSendDoneCnt = 0;
+        mQueueTimeSumMs = 0.0;
+        mResponseTimeSumMs = 0.0;
+    }
+
+    double maxSize = mConfiguredMaxSizeBytes;
+    if (mSerializeRatio > 0.0 && mMaxSerializedSizeBytes > 0) {
+        maxSize = min(maxSize, mMaxSerializedSizeBytes * kSerializedSizeSafetyRatio / mSerializeRatio);
+    }
+    double minSize = inRate * mTimeoutMs / 1000.0 * (kMinFillRatio + (1 - kMinFillRatio) * mPressure);
+    minSize = min(max(minSize, static_cast<double>(mConfiguredMinSizeBytes)), maxSize);
+
+    auto newMinSize = static_cast<uint32_t>(minSize);
+    auto newMaxSize = static_cast<uint32_t>(maxSize);
+    bool changed = newMinSize != mMinSizeBytes || newMaxSize != mMaxSizeBytes;
+    mMinSizeBytes = newMinSize;
+    mMaxSizeBytes = newMaxSize;
+    return changed;
+}
+
+} // namespace logtail
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <chrono>
+
+#include "common/Flags.h"
+
+DECLARE_FLAG_INT32(batcher_adaptive_adjust_interval_secs);
+
+namespace logtail {
+
+// Chooses the batch size targets of a batcher from what is observed downstream, instead of fixing them at Init.
+//
+// The min size is the data the batcher receives in a fraction of the timeout, which grows from a half to the whole
+// timeout as the sender gets slower (longer rtt, or items waiting longer in the sender queue), so that requests get
+// fewer and fuller while batches are still flushed by the timeout at the latest. The max size is the configured one,
+// lowered when needed so that the serialized batch stays within the serialized size limit at the observed
+// serialization ratio.
+//
+// Not thread safe, should be protected by the batcher.
+class AdaptiveFlushStrategy {
+public:
+    static constexpr double kMinFillRatio = 0.5;
+    static constexpr double kLowRttMs = 100;
+    static constexpr double kHighRttMs = 2000;
+    // serialized sizes of batches vary around the average ratio
+    static constexpr double kSerializedSizeSafetyRatio = 0.8;
+    static constexpr double kSerializeRatioSmoothingFactor = 0.2;
+
+    AdaptiveFlushStrategy(uint32_t minSizeBytes,
+                          uint32_t maxSizeBytes,
+                          uint32_t maxSerializedSizeBytes,
+                          uint32_t timeoutMs);
+
+    void OnAdd(size_t sizeBytes) { mInSizeBytes += sizeBytes; }
+    void OnSerialized(size_t inSizeBytes, size_t outSizeBytes);
+    void OnSendDone(std::chrono::milliseconds queueTime, std::chrono::milliseconds responseTime);
+    // recomputes the targets once per adjust interval, returns true if any of them has changed
+    bool Update(std::chrono::steady_clock::time_point now);
+
+    uint32_t GetMinSizeBytes() const { return mMinSizeBytes; }
+    uint32_t GetMaxSizeBytes() const { return mMaxSizeBytes; }
+    double GetPressure() const { return mPressure; }
+    double GetSerializeRatio() const { return mSerializeRatio; }
+
+private:
+    const uint32_t mConfiguredMinSizeBytes;
+    const uint32_t mConfiguredMaxSizeBytes;
+    const uint32_t mMaxSerializedSizeBytes;
+    const uint32_t mTimeoutMs;
+
+    uint32_t mMinSizeBytes;
+    uint32_t mMaxSizeBytes;
+    double mPressure = 0.0;
+    // serialized size / batched size, 0 means unknown
+    double mSerializeRatio = 0.0;
+
+    std::chrono::steady_clock::time_point mLastUpdateTime;
+    uint64_t mInSizeBytes = 0;
+    uint64_t mSendDoneCnt = 0;
+    double mQueueTimeSumMs = 0.0;
+    double mResponseTimeSumMs = 0.0;
+};
+
+} // namespace logtail
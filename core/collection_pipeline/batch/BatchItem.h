@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <unordered_set>
 #include <vector>
@@ -149,6 +150,8 @@ public:
         AddSourceBuffer(sourceBuffer);
     }
 
+    void UpdateCreateTime(std::chrono::system_clock::time_point createTime) { mBatch.UpdateCreateTime(createTime); }
+
     void AddSourceBuffer(const std::shared_ptr<SourceBuffer>& sourceBuffer) {
         if (mSourceBuffers.find(sourceBuffer.get()) == mSourceBuffers.end()) {
             mSourceBuffers.insert(sourceBuffer.get());
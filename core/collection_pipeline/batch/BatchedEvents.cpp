@@ -95,6 +95,7 @@ void BatchedEvents::Clear() {
     mTags.Clear();
     mSourceBuffers.clear();
     mSizeBytes = 0;
+    mCreateTime = std::chrono::system_clock::time_point();
     mExactlyOnceCheckpoint.reset();
     mPackIdPrefix = StringView();
 }
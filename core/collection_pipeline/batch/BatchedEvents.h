@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <unordered_set>
 #include <vector>
 
@@ -29,6 +30,8 @@ struct BatchedEvents {
     SizedMap mTags;
     std::vector<std::shared_ptr<SourceBuffer>> mSourceBuffers;
     size_t mSizeBytes = 0; // only set on completion
+    // the earliest create time of the groups that the events come from
+    std::chrono::system_clock::time_point mCreateTime;
     // for flusher_sls only
     RangeCheckpointPtr mExactlyOnceCheckpoint;
     StringView mPackIdPrefix;
@@ -41,6 +44,7 @@ struct BatchedEvents {
           mTags(std::move(other.mTags)),
           mSourceBuffers(std::move(other.mSourceBuffers)),
           mSizeBytes(other.mSizeBytes),
+          mCreateTime(other.mCreateTime),
           mExactlyOnceCheckpoint(std::move(other.mExactlyOnceCheckpoint)),
           mPackIdPrefix(other.mPackIdPrefix) {}
     BatchedEvents& operator=(BatchedEvents&&) noexcept = delete;
@@ -53,6 +57,12 @@ struct BatchedEvents {
                   StringView packIdPrefix,
                   RangeCheckpointPtr&& eoo);
 
+    void UpdateCreateTime(std::chrono::system_clock::time_point createTime) {
+        if (mCreateTime == std::chrono::system_clock::time_point() || createTime < mCreateTime) {
+            mCreateTime = createTime;
+        }
+    }
+
     void Clear();
 };
 
@@ -26,6 +26,7 @@
 #include "json/json.h"
 
 #include "collection_pipeline/CollectionPipelineContext.h"
+#include "collection_pipeline/batch/AdaptiveFlushStrategy.h"
 #include "collection_pipeline/batch/BatchItem.h"
 #include "collection_pipeline/batch/BatchStatus.h"
 #include "collection_pipeline/batch/FlushStrategy.h"
@@ -87,13 +88,45 @@ public:
                                   ctx.GetRegion());
         }
 
+        // TimeoutMs, for batches to be flushed at sub-second granularity
+        uint32_t timeoutMs = timeoutSecs * 1000;
+        if (!GetOptionalUIntParam(config, "TimeoutMs", timeoutMs, errorMsg)) {
+            timeoutMs = timeoutSecs * 1000;
+            PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                  ctx.GetAlarm(),
+                                  errorMsg,
+                                  timeoutMs,
+                                  flusher->Name(),
+                                  ctx.GetConfigName(),
+                                  ctx.GetProjectName(),
+                                  ctx.GetLogstoreName(),
+                                  ctx.GetRegion());
+        }
+
+        bool enableAdaptiveFlush = false;
+        if (!GetOptionalBoolParam(config, "EnableAdaptiveFlush", enableAdaptiveFlush, errorMsg)) {
+            PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                  ctx.GetAlarm(),
+                                  errorMsg,
+                                  enableAdaptiveFlush,
+                                  flusher->Name(),
+                                  ctx.GetConfigName(),
+                                  ctx.GetProjectName(),
+                                  ctx.GetLogstoreName(),
+                                  ctx.GetRegion());
+        }
+        if (enableAdaptiveFlush) {
+            mAdaptiveFlushStrategy.emplace(
+                minSizeBytes, strategy.mMaxSizeBytes, strategy.mMaxSerializedSizeBytes, timeoutMs);
+        }
+
         if (enableGroupBatch) {
-            uint32_t groupTimeout = timeoutSecs / 2;
-            mGroupFlushStrategy = GroupFlushStrategy(minSizeBytes, groupTimeout);
+            uint32_t groupTimeoutMs = timeoutMs / 2;
+            mGroupFlushStrategy = GroupFlushStrategy(minSizeBytes, groupTimeoutMs);
             mGroupQueue = GroupBatchItem();
-            mEventFlushStrategy.SetTimeoutSecs(timeoutSecs - groupTimeout);
+            mEventFlushStrategy.SetTimeoutMs(timeoutMs - groupTimeoutMs);
         } else {
-            mEventFlushStrategy.SetTimeoutSecs(timeoutSecs);
+            mEventFlushStrategy.SetTimeoutMs(timeoutMs);
         }
         mEventFlushStrategy.SetMaxSizeBytes(strategy.mMaxSizeBytes);
         mEventFlushStrategy.SetMinSizeBytes(minSizeBytes);
@@ -122,7 +155,11 @@ public:
         mBufferedEventsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL);
         mBufferedDataSizeByte = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES);
         mTotalAddTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS);
+        mTargetMinSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_TARGET_MIN_SIZE_BYTES);
+        mTargetMaxSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_TARGET_MAX_SIZE_BYTES);
         WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
+        SET_GAUGE(mTargetMinSizeBytes, mEventFlushStrategy.GetMinSizeBytes());
+        SET_GAUGE(mTargetMaxSizeBytes, mEventFlushStrategy.GetMaxSizeBytes());
 
         return true;
     }
@@ -136,6 +173,12 @@ public:
         ADD_COUNTER(mInEventsTotal, g.GetEvents().size());
         ADD_COUNTER(mInGroupDataSizeBytes, g.DataSize());
         SET_GAUGE(mEventBatchItemsTotal, mEventQueueMap.size());
+        if (mAdaptiveFlushStrategy) {
+            mAdaptiveFlushStrategy->OnAdd(g.DataSize());
+            if (mAdaptiveFlushStrategy->Update(std::chrono::steady_clock::now())) {
+                ApplyAdaptiveFlushStrategy();
+            }
+        }
 
         if (g.DataSize() > mEventFlushStrategy.GetMinSizeBytes()) {
             // for group size larger than min batch size, separate group only if size is larger than max batch size
@@ -158,6 +201,7 @@ public:
                         item.AddSourceBuffer(extraSourceBuffer);
                     }
                 }
+                item.UpdateCreateTime(g.GetCreateTime());
                 item.Add(std::move(e));
                 if (mEventFlushStrategy.SizeReachingUpperLimit(item.GetStatus())) {
                     ADD_COUNTER(mOutEventsTotal, item.EventSize());
@@ -183,7 +227,7 @@ public:
                             TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
                                                                              mFlusher->GetFlusherIndex(),
                                                                              0,
-                                                                             mGroupFlushStrategy->GetTimeoutSecs(),
+                                                                             mGroupFlushStrategy->GetTimeoutMs(),
                                                                              mFlusher);
                         }
                         item.Flush(mGroupQueue.value());
@@ -204,7 +248,7 @@ public:
                     TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
                                                                      mFlusher->GetFlusherIndex(),
                                                                      key,
-                                                                     mEventFlushStrategy.GetTimeoutSecs(),
+                                                                     mEventFlushStrategy.GetTimeoutMs(),
                                                                      mFlusher);
                     ADD_GAUGE(mBufferedGroupsTotal, 1);
                     ADD_GAUGE(mBufferedDataSizeByte, item.DataSize());
@@ -216,6 +260,7 @@ public:
                 }
                 ADD_GAUGE(mBufferedEventsTotal, 1);
                 ADD_GAUGE(mBufferedDataSizeByte, e->DataSize());
+                item.UpdateCreateTime(g.GetCreateTime());
                 item.Add(std::move(e));
                 if (mEventFlushStrategy.NeedFlushBySize(item.GetStatus())
                     || mEventFlushStrategy.NeedFlushByCnt(item.GetStatus())) {
@@ -260,7 +305,7 @@ public:
             TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
                                                              mFlusher->GetFlusherIndex(),
                                                              0,
-                                                             mGroupFlushStrategy->GetTimeoutSecs(),
+                                                             mGroupFlushStrategy->GetTimeoutMs(),
                                                              mFlusher);
         }
         iter->second.Flush(mGroupQueue.value());
@@ -298,12 +343,41 @@ public:
         mEventQueueMap.clear();
     }
 
+    // feedback of the flusher for the adaptive flush strategy, should be called after a batch is serialized and after a
+    // request is sent successfully respectively
+    void OnSerialized(size_t inSizeBytes, size_t outSizeBytes) {
+        if (!mAdaptiveFlushStrategy) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMux);
+        mAdaptiveFlushStrategy->OnSerialized(inSizeBytes, outSizeBytes);
+    }
+
+    void OnSendDone(std::chrono::milliseconds queueTime, std::chrono::milliseconds responseTime) {
+        if (!mAdaptiveFlushStrategy) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMux);
+        mAdaptiveFlushStrategy->OnSendDone(queueTime, responseTime);
+    }
+
 #ifdef APSARA_UNIT_TEST_MAIN
     EventFlushStrategy<T>& GetEventFlushStrategy() { return mEventFlushStrategy; }
+    std::optional<AdaptiveFlushStrategy>& GetAdaptiveFlushStrategy() { return mAdaptiveFlushStrategy; }
     std::optional<GroupFlushStrategy>& GetGroupFlushStrategy() { return mGroupFlushStrategy; }
 #endif
 
 private:
+    void ApplyAdaptiveFlushStrategy() {
+        mEventFlushStrategy.SetMinSizeBytes(mAdaptiveFlushStrategy->GetMinSizeBytes());
+        mEventFlushStrategy.SetMaxSizeBytes(mAdaptiveFlushStrategy->GetMaxSizeBytes());
+        if (mGroupFlushStrategy) {
+            mGroupFlushStrategy->SetMinSizeBytes(mAdaptiveFlushStrategy->GetMinSizeBytes());
+        }
+        SET_GAUGE(mTargetMinSizeBytes, mAdaptiveFlushStrategy->GetMinSizeBytes());
+        SET_GAUGE(mTargetMaxSizeBytes, mAdaptiveFlushStrategy->GetMaxSizeBytes());
+    }
+
     void UpdateMetricsOnFlushingEventQueue(const EventBatchItem<T>& item) {
         ADD_COUNTER(mOutEventsTotal, item.EventSize());
         // ADD_COUNTER(mTotalDelayMs,
@@ -336,6 +410,7 @@ private:
 
     std::optional<GroupBatchItem> mGroupQueue;
     std::optional<GroupFlushStrategy> mGroupFlushStrategy;
+    std::optional<AdaptiveFlushStrategy> mAdaptiveFlushStrategy;
 
     Flusher* mFlusher = nullptr;
 
@@ -349,6 +424,8 @@ private:
     IntGaugePtr mBufferedEventsTotal;
     IntGaugePtr mBufferedDataSizeByte;
     TimeCounterPtr mTotalAddTimeMs;
+    IntGaugePtr mTargetMinSizeBytes;
+    IntGaugePtr mTargetMaxSizeBytes;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BatcherUnittest;
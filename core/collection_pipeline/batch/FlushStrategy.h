@@ -24,6 +24,7 @@
 #include "json/json.h"
 
 #include "collection_pipeline/batch/BatchStatus.h"
+#include "common/TimeUtil.h"
 #include "models/PipelineEventPtr.h"
 
 namespace logtail {
@@ -33,6 +34,8 @@ struct DefaultFlushStrategyOptions {
     uint32_t mMinSizeBytes = 0;
     uint32_t mMinCnt = 0;
     uint32_t mTimeoutSecs = 0;
+    // limit of the serialized size of a batch, 0 means no limit
+    uint32_t mMaxSerializedSizeBytes = 0;
 };
 
 template <class T = EventBatchStatus>
@@ -41,18 +44,20 @@ public:
     void SetMaxSizeBytes(uint32_t size) { mMaxSizeBytes = size; }
     void SetMinSizeBytes(uint32_t size) { mMinSizeBytes = size; }
     void SetMinCnt(uint32_t cnt) { mMinCnt = cnt; }
-    void SetTimeoutSecs(uint32_t secs) { mTimeoutSecs = secs; }
+    void SetTimeoutSecs(uint32_t secs) { mTimeoutMs = secs * 1000; }
+    void SetTimeoutMs(uint32_t ms) { mTimeoutMs = ms; }
     uint32_t GetMaxSizeBytes() const { return mMaxSizeBytes; }
     uint32_t GetMinSizeBytes() const { return mMinSizeBytes; }
     uint32_t GetMinCnt() const { return mMinCnt; }
-    uint32_t GetTimeoutSecs() const { return mTimeoutSecs; }
+    uint32_t GetTimeoutSecs() const { return mTimeoutMs / 1000; }
+    uint32_t GetTimeoutMs() const { return mTimeoutMs; }
 
     // should be called after event is added
     bool NeedFlushBySize(const T& status) { return status.GetSize() >= mMinSizeBytes; }
     bool NeedFlushByCnt(const T& status) { return status.GetCnt() == mMinCnt; }
     // should be called before event is added
     bool NeedFlushByTime(const T& status, const PipelineEventPtr& e) {
-        return time(nullptr) - status.GetCreateTime() >= mTimeoutSecs;
+        return static_cast<int64_t>(GetCurrentTimeInMilliSeconds()) - status.GetCreateTimeMs() >= mTimeoutMs;
     }
     bool SizeReachingUpperLimit(const T& status) { return status.GetSize() >= mMaxSizeBytes; }
 
@@ -60,28 +65,30 @@ private:
     uint32_t mMaxSizeBytes = 0;
     uint32_t mMinSizeBytes = 0;
     uint32_t mMinCnt = 0;
-    uint32_t mTimeoutSecs = 0;
+    uint32_t mTimeoutMs = 0;
 };
 
 class GroupFlushStrategy {
 public:
-    GroupFlushStrategy(uint32_t size, uint32_t timeout) : mMinSizeBytes(size), mTimeoutSecs(timeout) {}
+    GroupFlushStrategy(uint32_t size, uint32_t timeoutMs) : mMinSizeBytes(size), mTimeoutMs(timeoutMs) {}
 
     void SetMinSizeBytes(uint32_t size) { mMinSizeBytes = size; }
-    void SetTimeoutSecs(uint32_t secs) { mTimeoutSecs = secs; }
+    void SetTimeoutSecs(uint32_t secs) { mTimeoutMs = secs * 1000; }
+    void SetTimeoutMs(uint32_t ms) { mTimeoutMs = ms; }
     uint32_t GetMinSizeBytes() const { return mMinSizeBytes; }
-    uint32_t GetTimeoutSecs() const { return mTimeoutSecs; }
+    uint32_t GetTimeoutSecs() const { return mTimeoutMs / 1000; }
+    uint32_t GetTimeoutMs() const { return mTimeoutMs; }
 
     // should be called after event is added
     bool NeedFlushBySize(const GroupBatchStatus& status) { return status.GetSize() >= mMinSizeBytes; }
     // should be called before event is added
     bool NeedFlushByTime(const GroupBatchStatus& status) {
-        return time(nullptr) - status.GetCreateTime() >= mTimeoutSecs;
+        return static_cast<int64_t>(GetCurrentTimeInMilliSeconds()) - status.GetCreateTimeMs() >= mTimeoutMs;
     }
 
 private:
     uint32_t mMinSizeBytes = 0;
-    uint32_t mTimeoutSecs = 0;
+    uint32_t mTimeoutMs = 0;
 };
 
 template <>
@@ -91,10 +98,10 @@ inline bool EventFlushStrategy<SLSEventBatchStatus>::NeedFlushByTime(const SLSEv
         // It is necessary to flush, if the event timestamp and the batch creation time differ by more than 300 seconds.
         // The 300 seconds is to avoid frequent batching to reduce the flusher traffic, because metrics such as cAdvisor
         // has out-of-order situations.
-        return time(nullptr) - status.GetCreateTime() > mTimeoutSecs
+        return static_cast<int64_t>(GetCurrentTimeInMilliSeconds()) - status.GetCreateTimeMs() > mTimeoutMs
             || abs(status.GetCreateTime() - e->GetTimestamp()) > 300;
     }
-    return time(nullptr) - status.GetCreateTime() > mTimeoutSecs
+    return static_cast<int64_t>(GetCurrentTimeInMilliSeconds()) - status.GetCreateTimeMs() > mTimeoutMs
         || status.GetCreateTimeMinute() != e->GetTimestamp() / 60;
 }
 
@@ -14,43 +14,98 @@
 
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
 
+#include <algorithm>
+#include <chrono>
+
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "common/Flags.h"
+#include "logger/Logger.h"
+#include "monitor/CpuProfiler.h"
+
+DEFINE_FLAG_INT32(default_flush_merged_buffer_interval, "max interval to check batch timeout, seconds", 1);
+
 using namespace std;
 
 namespace logtail {
 
+void TimeoutFlushManager::Start() {
+    if (mIsThreadRunning.exchange(true)) {
+        return;
+    }
+    mThreadRes = async(launch::async, &TimeoutFlushManager::Run, this);
+}
+
+void TimeoutFlushManager::Stop() {
+    if (!mIsThreadRunning.exchange(false)) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(mSchedulerMux);
+    }
+    mCV.notify_one();
+    if (!mThreadRes.valid()) {
+        return;
+    }
+    future_status s = mThreadRes.wait_for(chrono::seconds(1));
+    if (s == future_status::ready) {
+        LOG_INFO(sLogger, ("timeout flush scheduler", "stopped successfully"));
+    } else {
+        LOG_WARNING(sLogger, ("timeout flush scheduler", "forced to stopped"));
+    }
+}
+
 void TimeoutFlushManager::UpdateRecord(
-    const string& config, size_t index, size_t key, uint32_t timeoutSecs, Flusher* f) {
+    const string& config, size_t index, size_t key, uint32_t timeoutMs, Flusher* f) {
     lock_guard<mutex> lock(mTimeoutRecordsMux);
     auto& item = mTimeoutRecords[config];
     auto it = item.find({index, key});
     if (it == item.end()) {
-        item.try_emplace({index, key}, f, key, timeoutSecs);
+        it = item.try_emplace({index, key}, f, key, timeoutMs).first;
+        if (it->second.GetDeadlineMs() < mNextDeadlineMs.load()) {
+            SetNextDeadline(it->second.GetDeadlineMs());
+        }
     } else {
+        // the deadline can only be postponed, so the next deadline is still no later than the earliest one
         it->second.Update();
     }
 }
 
 void TimeoutFlushManager::FlushTimeoutBatch() {
+    // called by processor runner threads in each loop, so the check should be cheap
+    if (static_cast<int64_t>(GetCurrentTimeInMilliSeconds()) < mNextDeadlineMs.load()) {
+        return;
+    }
+    unique_lock<mutex> flushLock(mFlushMux, try_to_lock);
+    if (!flushLock.owns_lock()) {
+        return;
+    }
+
     multimap<string, pair<Flusher*, size_t>> records;
     {
         lock_guard<mutex> lock(mTimeoutRecordsMux);
+        int64_t now = GetCurrentTimeInMilliSeconds();
+        int64_t nextDeadline = numeric_limits<int64_t>::max();
+        bool flushAll = mIsEarlyFlushRequested.exchange(false);
         for (auto& item : mTimeoutRecords) {
             for (auto it = item.second.begin(); it != item.second.end();) {
-                if (time(nullptr) - it->second.mUpdateTime >= it->second.mTimeoutSecs) {
+                if (flushAll || now >= it->second.GetDeadlineMs()) {
                     // cannot flush here, since flush may also update record, which might invalidate map iterator and
                     // lead to deadlock
                     records.emplace(item.first, make_pair(it->second.mFlusher, it->second.mKey));
                     it = item.second.erase(it);
                 } else {
+                    nextDeadline = min(nextDeadline, it->second.GetDeadlineMs());
                     ++it;
                 }
             }
         }
+        SetNextDeadline(nextDeadline);
     }
     {
         lock_guard<mutex> lock(mDeletedFlushersMux);
         for (auto& item : records) {
             if (mDeletedFlushers.find(make_pair(item.first, item.second.first)) == mDeletedFlushers.end()) {
+                CpuProfileScope scope(item.second.first->GetCpuProfileTag());
                 item.second.first->Flush(item.second.second);
             }
         }
@@ -58,11 +113,19 @@ void TimeoutFlushManager::FlushTimeoutBatch() {
     }
 }
 
+void TimeoutFlushManager::FlushAllBatchesEarly() {
+    mIsEarlyFlushRequested.store(true);
+    lock_guard<mutex> lock(mTimeoutRecordsMux);
+    SetNextDeadline(0);
+}
+
 void TimeoutFlushManager::UnregisterFlushers(const string& config,
                                              const vector<unique_ptr<FlusherInstance>>& flushers) {
     {
         lock_guard<mutex> lock(mTimeoutRecordsMux);
         mTimeoutRecords.erase(config);
+        // make the next check clear the deleted flushers
+        SetNextDeadline(0);
     }
     {
         lock_guard<mutex> lock(mDeletedFlushersMux);
@@ -79,4 +142,32 @@ void TimeoutFlushManager::RegisterFlushers(const string& config, const vector<un
     }
 }
 
+void TimeoutFlushManager::Run() {
+    LOG_INFO(sLogger, ("timeout flush scheduler", "started"));
+    unique_lock<mutex> lock(mSchedulerMux);
+    while (mIsThreadRunning.load()) {
+        int64_t deadlineMs = mNextDeadlineMs.load();
+        int64_t waitMs = deadlineMs - static_cast<int64_t>(GetCurrentTimeInMilliSeconds());
+        if (waitMs <= 0) {
+            // pipelines are flushed by processor runner threads, the same as they are processed
+            ProcessQueueManager::GetInstance()->Trigger();
+            // wait for the deadline to be moved by the flushing thread
+            waitMs = numeric_limits<int64_t>::max();
+        }
+        waitMs = min<int64_t>(waitMs, INT32_FLAG(default_flush_merged_buffer_interval) * 1000);
+        mCV.wait_for(lock, chrono::milliseconds(waitMs), [this, deadlineMs]() {
+            return !mIsThreadRunning.load() || mNextDeadlineMs.load() != deadlineMs;
+        });
+    }
+}
+
+void TimeoutFlushManager::SetNextDeadline(int64_t deadlineMs) {
+    mNextDeadlineMs.store(deadlineMs);
+    {
+        // the scheduler checks the deadline with mSchedulerMux held, so that the notification cannot be lost
+        lock_guard<mutex> lock(mSchedulerMux);
+    }
+    mCV.notify_one();
+}
+
 } // namespace logtail
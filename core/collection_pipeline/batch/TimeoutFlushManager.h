@@ -17,8 +17,11 @@
 #pragma once
 
 #include <cstdint>
-#include <ctime>
 
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <limits>
 #include <map>
 #include <mutex>
 #include <set>
@@ -27,19 +30,21 @@
 
 #include "collection_pipeline/plugin/instance/FlusherInstance.h"
 #include "collection_pipeline/plugin/interface/Flusher.h"
+#include "common/TimeUtil.h"
 
 namespace logtail {
 
 struct TimeoutRecord {
     Flusher* mFlusher = nullptr;
     size_t mKey;
-    time_t mUpdateTime = 0;
-    uint32_t mTimeoutSecs = 0;
+    int64_t mUpdateTimeMs = 0;
+    uint32_t mTimeoutMs = 0;
 
-    TimeoutRecord(Flusher* flusher, size_t key, uint32_t timeoutSecs)
-        : mFlusher(flusher), mKey(key), mUpdateTime(time(nullptr)), mTimeoutSecs(timeoutSecs) {}
+    TimeoutRecord(Flusher* flusher, size_t key, uint32_t timeoutMs)
+        : mFlusher(flusher), mKey(key), mUpdateTimeMs(GetCurrentTimeInMilliSeconds()), mTimeoutMs(timeoutMs) {}
 
-    void Update() { mUpdateTime = time(nullptr); }
+    void Update() { mUpdateTimeMs = GetCurrentTimeInMilliSeconds(); }
+    int64_t GetDeadlineMs() const { return mUpdateTimeMs + mTimeoutMs; }
 };
 
 class TimeoutFlushManager {
@@ -52,8 +57,15 @@ public:
         return &instance;
     }
 
-    void UpdateRecord(const std::string& config, size_t index, size_t key, uint32_t timeoutSecs, Flusher* f);
+    // the scheduler wakes up processor runner threads at the earliest batch deadline, the flush itself is done by
+    // FlushTimeoutBatch called from these threads
+    void Start();
+    void Stop();
+
+    void UpdateRecord(const std::string& config, size_t index, size_t key, uint32_t timeoutMs, Flusher* f);
     void FlushTimeoutBatch();
+    // flush all batches in the next check regardless of their deadlines, used to release memory under pressure
+    void FlushAllBatchesEarly();
     void UnregisterFlushers(const std::string& config, const std::vector<std::unique_ptr<FlusherInstance>>& flushers);
     void RegisterFlushers(const std::string& config, const std::vector<std::unique_ptr<FlusherInstance>>& flushers);
 
@@ -61,14 +73,28 @@ private:
     TimeoutFlushManager() = default;
     ~TimeoutFlushManager() = default;
 
+    void Run();
+    void SetNextDeadline(int64_t deadlineMs);
+
     // visited by all processor runner threads
     mutable std::mutex mTimeoutRecordsMux;
     std::map<std::string, std::map<std::pair<size_t, size_t>, TimeoutRecord>> mTimeoutRecords;
+    // no earlier than the earliest deadline of all records, only modified with mTimeoutRecordsMux held
+    std::atomic_int64_t mNextDeadlineMs = std::numeric_limits<int64_t>::max();
+    std::atomic_bool mIsEarlyFlushRequested = false;
 
-    // visited by main thread and num 0 processor runner thread
+    // only one processor runner thread flushes at a time
+    std::mutex mFlushMux;
+
+    // visited by main thread and the flushing processor runner thread
     mutable std::mutex mDeletedFlushersMux;
     std::set<std::pair<std::string, const Flusher*>> mDeletedFlushers;
 
+    std::future<void> mThreadRes;
+    std::atomic_bool mIsThreadRunning = false;
+    std::mutex mSchedulerMux;
+    std::condition_variable mCV;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PipelineUnittest;
     friend class TimeoutFlushManagerUnittest;
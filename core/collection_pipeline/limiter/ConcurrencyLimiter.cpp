@@ -14,9 +14,15 @@
 
 #include "collection_pipeline/limiter/ConcurrencyLimiter.h"
 
+#include <cmath>
+
 #include "common/StringTools.h"
 #include "logger/Logger.h"
 
+DEFINE_FLAG_BOOL(enable_latency_based_concurrency_limit,
+                 "adjust send concurrency by the queueing delay estimated from response time, besides send failures",
+                 false);
+
 using namespace std;
 
 namespace logtail {
@@ -47,6 +53,16 @@ bool ConcurrencyLimiter::IsInTimeFallback() const {
     return mInTimeFallback;
 }
 
+double ConcurrencyLimiter::GetMinRttMs() const {
+    lock_guard<mutex> lock(mLimiterMux);
+    return mMinRttMs;
+}
+
+double ConcurrencyLimiter::GetSmoothedRttMs() const {
+    lock_guard<mutex> lock(mLimiterMux);
+    return mSmoothedRttMs;
+}
+
 #endif
 
 bool ConcurrencyLimiter::IsValidToPop() {
@@ -90,12 +106,16 @@ void ConcurrencyLimiter::OnSuccess(std::chrono::system_clock::time_point current
     AdjustConcurrency(true, currentTime);
 }
 
+void ConcurrencyLimiter::OnSuccess(std::chrono::system_clock::time_point currentTime,
+                                   std::chrono::milliseconds responseTime) {
+    AdjustConcurrency(true, currentTime, responseTime);
+}
+
 void ConcurrencyLimiter::OnFail(std::chrono::system_clock::time_point currentTime) {
     AdjustConcurrency(false, currentTime);
 }
 
-void ConcurrencyLimiter::Increase() {
-    lock_guard<mutex> lock(mLimiterMux);
+void ConcurrencyLimiter::ExitTimeFallback() {
     // Clear time fallback state immediately on any success for fast recovery
     if (mInTimeFallback) {
         mInTimeFallback = false;
@@ -105,6 +125,11 @@ void ConcurrencyLimiter::Increase() {
                  ("exit time fallback state on success", mDescription)("reset_duration_ms",
                                                                        mTimeFallbackCurrentDurationMilliSeconds));
     }
+}
+
+void ConcurrencyLimiter::Increase() {
+    lock_guard<mutex> lock(mLimiterMux);
+    ExitTimeFallback();
     if (mCurrenctConcurrency != mMaxConcurrency) {
         ++mCurrenctConcurrency;
         if (mCurrenctConcurrency == mMaxConcurrency) {
@@ -144,15 +169,65 @@ void ConcurrencyLimiter::Decrease(double fallBackRatio) {
     }
 }
 
+void ConcurrencyLimiter::AdjustByLatency(double rttMs, std::chrono::system_clock::time_point currentTime) {
+    lock_guard<mutex> lock(mLimiterMux);
+    ExitTimeFallback();
+    // response time is in milliseconds, avoid a zero min rtt for very fast backends
+    rttMs = std::max(rttMs, 1.0);
+    if (mMinRttMs == 0.0 || rttMs < mMinRttMs) {
+        mMinRttMs = rttMs;
+    }
+    if (mNextMinRttMs == 0.0 || rttMs < mNextMinRttMs) {
+        mNextMinRttMs = rttMs;
+    }
+    if (mMinRttEpochStartTime == std::chrono::system_clock::time_point()) {
+        mMinRttEpochStartTime = currentTime;
+    } else if (chrono::duration_cast<chrono::seconds>(currentTime - mMinRttEpochStartTime).count()
+               >= kMinRttEpochSeconds) {
+        mMinRttMs = mNextMinRttMs;
+        mNextMinRttMs = 0.0;
+        mMinRttEpochStartTime = currentTime;
+    }
+    if (mSmoothedRttMs == 0.0) {
+        mSmoothedRttMs = rttMs;
+    } else {
+        mSmoothedRttMs = mSmoothedRttMs * (1 - kRttSmoothingFactor) + rttMs * kRttSmoothingFactor;
+    }
+
+    // requests queued at the backend, as estimated by vegas, are kept between alpha and beta
+    double limit = std::max(mCurrenctConcurrency, 1U);
+    double queueSize = limit * (1 - mMinRttMs / mSmoothedRttMs);
+    double step = std::max(1.0, std::log10(limit));
+    double alpha = std::max(1.0, 3 * std::log10(limit));
+    double beta = std::max(2.0, 6 * std::log10(limit));
+    auto old = mCurrenctConcurrency;
+    if (queueSize <= alpha) {
+        mCurrenctConcurrency = std::min(static_cast<uint32_t>(limit + step), mMaxConcurrency);
+    } else if (queueSize >= beta) {
+        mCurrenctConcurrency = std::max(static_cast<uint32_t>(std::max(limit - step, 1.0)), mMinConcurrency);
+    }
+    if (old != mCurrenctConcurrency) {
+        LOG_DEBUG(sLogger,
+                  ("adjust send concurrency by latency, type", mDescription)("from", old)("to", mCurrenctConcurrency)(
+                      "min rtt ms", mMinRttMs)("smoothed rtt ms", mSmoothedRttMs)("queue size", queueSize));
+    }
+}
+
 
-void ConcurrencyLimiter::AdjustConcurrency(bool success, std::chrono::system_clock::time_point currentTime) {
+void ConcurrencyLimiter::AdjustConcurrency(bool success,
+                                           std::chrono::system_clock::time_point currentTime,
+                                           std::chrono::milliseconds responseTime) {
     uint32_t failPercentage = 0;
     bool finishStatistics = false;
+    double rttMs = 0.0;
     {
         lock_guard<mutex> lock(mStatisticsMux);
         mStatisticsTotal++;
         if (!success) {
             mStatisticsFailTotal++;
+        } else if (mLatencyBased && responseTime != std::chrono::milliseconds::max()) {
+            mStatisticsRttSumMs += responseTime.count();
+            mStatisticsRttCount++;
         }
         if (mLastStatisticsTime == std::chrono::system_clock::time_point()) {
             mLastStatisticsTime = currentTime;
@@ -161,8 +236,13 @@ void ConcurrencyLimiter::AdjustConcurrency(bool success, std::chrono::system_clo
             || chrono::duration_cast<chrono::seconds>(currentTime - mLastStatisticsTime).count()
                 > mStatisticIntervalThresholdSeconds) {
             failPercentage = mStatisticsFailTotal * 100 / mStatisticsTotal;
+            if (mStatisticsRttCount > 0) {
+                rttMs = mStatisticsRttSumMs / mStatisticsRttCount;
+            }
             mStatisticsTotal = 0;
             mStatisticsFailTotal = 0;
+            mStatisticsRttSumMs = 0.0;
+            mStatisticsRttCount = 0;
             mLastStatisticsTime = currentTime;
             finishStatistics = true;
         }
@@ -170,7 +250,11 @@ void ConcurrencyLimiter::AdjustConcurrency(bool success, std::chrono::system_clo
     if (finishStatistics) {
         if (failPercentage == 0) {
             // 成功
-            Increase();
+            if (rttMs > 0.0) {
+                AdjustByLatency(rttMs, currentTime);
+            } else {
+                Increase();
+            }
         } else if (failPercentage <= NO_FALL_BACK_FAIL_PERCENTAGE) {
             // 不调整
         } else if (failPercentage <= SLOW_FALL_BACK_FAIL_PERCENTAGE) {
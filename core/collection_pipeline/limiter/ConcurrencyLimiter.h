@@ -24,8 +24,11 @@
 #include <string>
 
 #include "app_config/AppConfig.h"
+#include "common/Flags.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
+DECLARE_FLAG_BOOL(enable_latency_based_concurrency_limit);
+
 namespace logtail {
 
 constexpr uint32_t kTimeFallbackDurationMilliSeconds = 1000;
@@ -33,6 +36,9 @@ constexpr double kTimeFallbackBackoffMultiplier = 2.0;
 constexpr uint32_t kTimeFallbackMaxDurationMilliSeconds = 60000; // 60 seconds
 constexpr uint32_t kConcurrencyStatisticThreshold = 10;
 constexpr uint32_t kConcurrencyStatisticIntervalThresholdSeconds = 3;
+// the min rtt is the minimum over the last 1 to 2 epochs, so that it follows a backend whose no-load latency changes
+constexpr uint32_t kMinRttEpochSeconds = 60;
+constexpr double kRttSmoothingFactor = 0.2;
 
 class ConcurrencyLimiter {
 public:
@@ -64,6 +70,8 @@ public:
     void OnSendDone();
 
     void OnSuccess(std::chrono::system_clock::time_point currentTime);
+    // in latency based mode, the concurrency also follows the queueing delay estimated from the response time
+    void OnSuccess(std::chrono::system_clock::time_point currentTime, std::chrono::milliseconds responseTime);
     void OnFail(std::chrono::system_clock::time_point currentTime);
 
 
@@ -86,6 +94,8 @@ public:
     uint32_t GetInSendingCount() const;
     uint32_t GetStatisticThreshold() const;
     bool IsInTimeFallback() const;
+    double GetMinRttMs() const;
+    double GetSmoothedRttMs() const;
 
 #endif
 
@@ -115,16 +125,29 @@ private:
     double mConcurrencyFastFallBackRatio = 0.0;
     double mConcurrencySlowFallBackRatio = 0.0;
 
+    // Latency based control, vegas style
+    const bool mLatencyBased = BOOL_FLAG(enable_latency_based_concurrency_limit);
+    double mMinRttMs = 0.0;
+    double mNextMinRttMs = 0.0;
+    std::chrono::system_clock::time_point mMinRttEpochStartTime;
+    double mSmoothedRttMs = 0.0;
+
     std::chrono::system_clock::time_point mLastCheckTime;
 
     mutable std::mutex mStatisticsMux;
     std::chrono::system_clock::time_point mLastStatisticsTime;
     uint32_t mStatisticsTotal = 0;
     uint32_t mStatisticsFailTotal = 0;
+    double mStatisticsRttSumMs = 0.0;
+    uint32_t mStatisticsRttCount = 0;
 
     void Increase();
     void Decrease(double fallBackRatio);
-    void AdjustConcurrency(bool success, std::chrono::system_clock::time_point currentTime);
+    void AdjustByLatency(double rttMs, std::chrono::system_clock::time_point currentTime);
+    void ExitTimeFallback();
+    void AdjustConcurrency(bool success,
+                           std::chrono::system_clock::time_point currentTime,
+                           std::chrono::milliseconds responseTime = std::chrono::milliseconds::max());
 };
 
 } // namespace logtail
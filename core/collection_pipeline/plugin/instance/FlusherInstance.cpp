@@ -14,6 +14,7 @@
 
 #include "collection_pipeline/plugin/instance/FlusherInstance.h"
 
+#include "monitor/CpuProfiler.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
 using namespace std;
@@ -32,10 +33,19 @@ bool FlusherInstance::Init(const Json::Value& config,
         return false;
     }
 
-    mInGroupsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_EVENT_GROUPS_TOTAL);
-    mInEventsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_EVENTS_TOTAL);
-    mInSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_SIZE_BYTES);
-    mTotalPackageTimeMs = mPlugin->GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_FLUSHER_TOTAL_PACKAGE_TIME_MS);
+    mInGroupsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_EVENT_GROUPS_TOTAL, true);
+    mInEventsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_EVENTS_TOTAL, true);
+    mInSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_SIZE_BYTES, true);
+    mTotalPackageTimeMs
+        = mPlugin->GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_FLUSHER_TOTAL_PACKAGE_TIME_MS, true);
+    mPlugin->CreateStageLatencyHistograms();
+    if (CpuProfiler::IsEnabled()) {
+        mPlugin->SetCpuProfileTag(CpuProfiler::GetInstance()->RegisterTag(
+            context.GetConfigName(),
+            Name(),
+            PluginID(),
+            mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_CPU_TIME_MS, true)));
+    }
     mPlugin->CommitMetricsRecordRef();
     return true;
 }
@@ -46,9 +56,18 @@ bool FlusherInstance::Send(PipelineEventGroup&& g) {
     ADD_COUNTER(mInSizeBytes, g.DataSize());
 
     auto before = chrono::system_clock::now();
-    auto res = mPlugin->Send(std::move(g));
+    bool res = false;
+    {
+        CpuProfileScope scope(mPlugin->GetCpuProfileTag());
+        res = mPlugin->Send(std::move(g));
+    }
     ADD_COUNTER(mTotalPackageTimeMs, chrono::system_clock::now() - before);
     return res;
 }
 
+bool FlusherInstance::FlushAll() {
+    CpuProfileScope scope(mPlugin->GetCpuProfileTag());
+    return mPlugin->FlushAll();
+}
+
 } // namespace logtail
@@ -44,7 +44,7 @@ public:
     bool Start() { return mPlugin->Start(); }
     bool Stop(bool isPipelineRemoving) { return mPlugin->Stop(isPipelineRemoving); }
     bool Send(PipelineEventGroup&& g);
-    bool FlushAll() { return mPlugin->FlushAll(); }
+    bool FlushAll();
     QueueKey GetQueueKey() const { return mPlugin->GetQueueKey(); }
 
 private:
@@ -20,6 +20,7 @@
 
 #include "common/TimeUtil.h"
 #include "logger/Logger.h"
+#include "monitor/CpuProfiler.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
 using namespace std;
@@ -34,11 +35,18 @@ bool ProcessorInstance::Init(const Json::Value& config, CollectionPipelineContex
     }
 
     // should init plugin first， then could GetMetricsRecordRef from plugin
-    mInEventsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_EVENTS_TOTAL);
-    mOutEventsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_EVENTS_TOTAL);
-    mInSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_SIZE_BYTES);
-    mOutSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_SIZE_BYTES);
-    mTotalProcessTimeMs = mPlugin->GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS);
+    mInEventsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_EVENTS_TOTAL, true);
+    mOutEventsTotal = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_EVENTS_TOTAL, true);
+    mInSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_SIZE_BYTES, true);
+    mOutSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_SIZE_BYTES, true);
+    mTotalProcessTimeMs = mPlugin->GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS, true);
+    if (CpuProfiler::IsEnabled()) {
+        mCpuProfileTag = CpuProfiler::GetInstance()->RegisterTag(
+            context.GetConfigName(),
+            Name(),
+            PluginID(),
+            mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_CPU_TIME_MS, true));
+    }
     mPlugin->CommitMetricsRecordRef();
     return true;
 }
@@ -53,7 +61,10 @@ void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList) {
     }
 
     auto before = chrono::system_clock::now();
-    mPlugin->Process(eventGroupList);
+    {
+        CpuProfileScope scope(mCpuProfileTag);
+        mPlugin->Process(eventGroupList);
+    }
     ADD_COUNTER(mTotalProcessTimeMs, chrono::system_clock::now() - before);
 
     for (const auto& eventGroup : eventGroupList) {
@@ -62,4 +73,64 @@ void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList) {
     }
 }
 
+void ProcessorInstance::ProcessFused(const vector<unique_ptr<ProcessorInstance>>& processors,
+                                     size_t begin,
+                                     size_t end,
+                                     vector<PipelineEventGroup>& eventGroupList) {
+    if (eventGroupList.empty() || begin >= end) {
+        return;
+    }
+    size_t cnt = end - begin;
+    // events and bytes reaching each processor, the last ones are what is left
+    vector<uint64_t> inCnts(cnt + 1, 0);
+    vector<uint64_t> inSizes(cnt + 1, 0);
+    // only the calls of each processor are timed, so that the time of a processor is its own
+    vector<chrono::nanoseconds> costs(cnt, chrono::nanoseconds(0));
+    vector<EventProcessContext> contexts(cnt, EventProcessContext(eventGroupList[0]));
+    CpuProfileScope scope(processors[begin]->mCpuProfileTag);
+    for (auto& eventGroup : eventGroupList) {
+        for (auto& context : contexts) {
+            context.Reset(eventGroup);
+        }
+        // the group level part of the size, which processors working on events leave unchanged
+        size_t groupSize = sizeof(EventsContainer) + eventGroup.GetSizedTags().DataSize();
+        for (auto& size : inSizes) {
+            size += groupSize;
+        }
+        EventsContainer& events = eventGroup.MutableEvents();
+        size_t wIdx = 0;
+        for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
+            size_t i = begin;
+            for (; i < end; ++i) {
+                ++inCnts[i - begin];
+                inSizes[i - begin] += events[rIdx]->DataSize();
+                CpuProfiler::SwapThreadTag(processors[i]->mCpuProfileTag);
+                auto before = chrono::steady_clock::now();
+                bool kept = processors[i]->mPlugin->ProcessEvent(events[rIdx], contexts[i - begin]);
+                costs[i - begin] += chrono::steady_clock::now() - before;
+                if (!kept) {
+                    break;
+                }
+            }
+            if (i == end) {
+                ++inCnts[cnt];
+                inSizes[cnt] += events[rIdx]->DataSize();
+                if (wIdx != rIdx) {
+                    events[wIdx] = std::move(events[rIdx]);
+                }
+                ++wIdx;
+            }
+        }
+        events.resize(wIdx);
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+        ADD_COUNTER(processors[i]->mInEventsTotal, inCnts[i - begin]);
+        ADD_COUNTER(processors[i]->mOutEventsTotal, inCnts[i - begin + 1]);
+        ADD_COUNTER(processors[i]->mInSizeBytes, inSizes[i - begin]);
+        ADD_COUNTER(processors[i]->mOutSizeBytes, inSizes[i - begin + 1]);
+        ADD_COUNTER(processors[i]->mTotalProcessTimeMs, costs[i - begin]);
+    }
+}
+
 } // namespace logtail
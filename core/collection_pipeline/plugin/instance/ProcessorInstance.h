@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "json/json.h"
 
@@ -36,6 +37,14 @@ public:
 
     bool Init(const Json::Value& config, CollectionPipelineContext& context);
     void Process(std::vector<PipelineEventGroup>& logGroupList);
+    bool SupportsEventProcessing() const { return mPlugin->SupportsEventProcessing(); }
+
+    // Runs processors [begin, end), which all support per event processing, in a single pass over each group, and an
+    // event discarded by one of them is not passed to the following ones.
+    static void ProcessFused(const std::vector<std::unique_ptr<ProcessorInstance>>& processors,
+                             size_t begin,
+                             size_t end,
+                             std::vector<PipelineEventGroup>& logGroupList);
 
 private:
     std::unique_ptr<Processor> mPlugin;
@@ -45,6 +54,8 @@ private:
     CounterPtr mInSizeBytes;
     CounterPtr mOutSizeBytes;
     TimeCounterPtr mTotalProcessTimeMs;
+    // marks the cpu used by the plugin for the cpu profiler
+    uint32_t mCpuProfileTag = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorInstanceUnittest;
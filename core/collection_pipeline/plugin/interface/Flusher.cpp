@@ -16,6 +16,7 @@
 
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "collection_pipeline/queue/SenderQueueManager.h"
+#include "monitor/metric_constants/MetricConstants.h"
 // TODO: temporarily used here
 #include "collection_pipeline/CollectionPipelineManager.h"
 
@@ -23,6 +24,34 @@ using namespace std;
 
 namespace logtail {
 
+void Flusher::CreateStageLatencyHistogram(FlusherStage stage) {
+    const string* name = nullptr;
+    switch (stage) {
+        case FlusherStage::BATCHED:
+            name = &METRIC_PLUGIN_FLUSHER_BATCHED_LATENCY_MS;
+            break;
+        case FlusherStage::SERIALIZED:
+            name = &METRIC_PLUGIN_FLUSHER_SERIALIZED_LATENCY_MS;
+            break;
+        case FlusherStage::SENT:
+            name = &METRIC_PLUGIN_FLUSHER_SENT_LATENCY_MS;
+            break;
+        case FlusherStage::ACKED:
+            name = &METRIC_PLUGIN_FLUSHER_ACKED_LATENCY_MS;
+            break;
+        default:
+            return;
+    }
+    mStageLatencyMs[static_cast<size_t>(stage)] = GetMetricsRecordRef().CreateHistogram(*name);
+}
+
+void Flusher::AddStageLatency(FlusherStage stage, chrono::system_clock::time_point createTime) {
+    if (createTime == chrono::system_clock::time_point()) {
+        return;
+    }
+    ADD_HISTOGRAM(mStageLatencyMs[static_cast<size_t>(stage)], chrono::system_clock::now() - createTime);
+}
+
 bool Flusher::Start() {
     SenderQueueManager::GetInstance()->ReuseQueue(mQueueKey);
     return true;
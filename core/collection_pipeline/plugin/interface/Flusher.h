@@ -18,6 +18,8 @@
 
 #include <cstdint>
 
+#include <array>
+#include <chrono>
 #include <memory>
 
 #include "json/json.h"
@@ -30,6 +32,9 @@
 
 namespace logtail {
 
+// stages after the events are sent to the flusher, see Flusher::AddStageLatency
+enum class FlusherStage { BATCHED, SERIALIZED, SENT, ACKED, COUNT };
+
 class Flusher : public Plugin {
 public:
     virtual ~Flusher() = default;
@@ -48,8 +53,18 @@ public:
     size_t GetFlusherIndex() { return mIndex; }
     void SetFlusherIndex(size_t idx) { mIndex = idx; }
     const std::string& GetPluginID() const { return mPluginID; }
+    uint32_t GetCpuProfileTag() const { return mCpuProfileTag; }
+    void SetCpuProfileTag(uint32_t tag) { mCpuProfileTag = tag; }
+
+    // creates histograms only for the stages recorded by the flusher, should be called before the metrics record is
+    // committed
+    virtual void CreateStageLatencyHistograms() {}
+    // records the time from the events being read to reaching the stage, which tells where the latency builds up
+    // @createTime: the earliest create time of the event groups, ignored if unknown
+    void AddStageLatency(FlusherStage stage, std::chrono::system_clock::time_point createTime);
 
 protected:
+    void CreateStageLatencyHistogram(FlusherStage stage);
     void GenerateQueueKey(const std::string& target);
     bool PushToQueue(std::unique_ptr<SenderQueueItem>&& item, uint32_t retryTimes = 500);
     void DealSenderQueueItemAfterSend(SenderQueueItem* item, bool keep);
@@ -58,11 +73,15 @@ protected:
     QueueKey mQueueKey;
     std::string mPluginID;
     size_t mIndex = 0;
+    // marks the cpu used by the plugin for the cpu profiler
+    uint32_t mCpuProfileTag = 0;
+    std::array<HistogramPtr, static_cast<size_t>(FlusherStage::COUNT)> mStageLatencyMs;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class FlusherInstanceUnittest;
     friend class FlusherRunnerUnittest;
     friend class FlusherUnittest;
+    friend class HttpSinkUnittest;
     friend class PipelineUpdateUnittest;
 #endif
 };
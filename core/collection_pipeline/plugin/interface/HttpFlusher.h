@@ -35,6 +35,12 @@ public:
     virtual void OnSendDone(const HttpResponse& response, SenderQueueItem* item) = 0;
 
     virtual SinkType GetSinkType() override { return SinkType::HTTP; }
+
+    // recorded by FlusherRunner and HttpSink, only for items with mEventCreateTime set by the flusher
+    void CreateStageLatencyHistograms() override {
+        CreateStageLatencyHistogram(FlusherStage::SENT);
+        CreateStageLatencyHistogram(FlusherStage::ACKED);
+    }
 };
 
 } // namespace logtail
@@ -19,11 +19,31 @@
 #include "json/json.h"
 
 #include "collection_pipeline/plugin/interface/Plugin.h"
+#include "common/StringView.h"
+#include "common/TimeUtil.h"
 #include "models/PipelineEventGroup.h"
 #include "models/PipelineEventPtr.h"
 
 namespace logtail {
 
+// Group level state passed to Processor::ProcessEvent, one for each processor, reset for each event group.
+struct EventProcessContext {
+    explicit EventProcessContext(PipelineEventGroup& group) { Reset(group); }
+
+    void Reset(PipelineEventGroup& group) {
+        mGroup = &group;
+        mLogPath = group.GetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED);
+        mLogTime = {0, 0};
+        mTimeStrCache = StringView();
+    }
+
+    PipelineEventGroup* mGroup = nullptr;
+    StringView mLogPath;
+    // the last parsed time string and its result, shared by the events of the group
+    LogtailTime mLogTime = {0, 0};
+    StringView mTimeStrCache;
+};
+
 class Processor : public Plugin {
 public:
     virtual ~Processor() {}
@@ -31,6 +51,13 @@ public:
     virtual bool Init(const Json::Value& config) = 0;
     virtual void Process(std::vector<PipelineEventGroup>& logGroupList);
 
+    // Processors handling each event independently of the others can support per event processing, so that the
+    // pipeline runs consecutive ones in a single pass over the group. Returns false if the event should be discarded.
+    virtual bool SupportsEventProcessing() const { return false; }
+    virtual bool ProcessEvent([[maybe_unused]] PipelineEventPtr& e, [[maybe_unused]] EventProcessContext& context) {
+        return true;
+    }
+
 protected:
     virtual bool IsSupportedEvent(const PipelineEventPtr& e) const = 0;
     virtual void Process(PipelineEventGroup& logGroup) = 0;
@@ -0,0 +1,206 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/queue/PendingPushManager.h"
+
+#include <algorithm>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(process_queue_max_pending_push_cnt, "max count of items parked for each full process queue", 100);
+DEFINE_FLAG_INT32(process_queue_pending_push_retry_interval_ms,
+                  "interval to retry pushing parked items in case of missing feedback, ms",
+                  1000);
+
+using namespace std;
+
+namespace logtail {
+
+void PendingPushManager::Start() {
+    if (mIsThreadRunning.exchange(true)) {
+        return;
+    }
+    mThreadRes = async(launch::async, &PendingPushManager::Run, this);
+}
+
+void PendingPushManager::Stop() {
+    if (!mIsThreadRunning.exchange(false)) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(mMux);
+    }
+    mCV.notify_one();
+    if (mThreadRes.valid()) {
+        future_status s = mThreadRes.wait_for(chrono::seconds(1));
+        if (s == future_status::ready) {
+            LOG_INFO(sLogger, ("pending push manager", "stopped successfully"));
+        } else {
+            LOG_WARNING(sLogger, ("pending push manager", "forced to stopped"));
+        }
+    }
+    PushPendingItems(true, true);
+}
+
+void PendingPushManager::Feedback(int64_t key) {
+    // called by processor runner threads with process queue lock held, so it should be cheap
+    {
+        lock_guard<mutex> lock(mMux);
+        if (mPendingItems.find(key) == mPendingItems.end()) {
+            return;
+        }
+        mReadyQueues.insert(key);
+    }
+    mCV.notify_one();
+}
+
+uint64_t PendingPushManager::Park(QueueKey key,
+                                  unique_ptr<ProcessQueueItem>& item,
+                                  chrono::steady_clock::time_point deadline,
+                                  PushCallback&& callback) {
+    uint64_t token = 0;
+    {
+        lock_guard<mutex> lock(mMux);
+        if (!mIsThreadRunning.load()) {
+            return 0;
+        }
+        auto& items = mPendingItems[key];
+        if (items.size() >= static_cast<size_t>(INT32_FLAG(process_queue_max_pending_push_cnt))) {
+            return 0;
+        }
+        token = mNextToken++;
+        items.push_back({token, std::move(item), deadline, std::move(callback)});
+        // the queue may become valid to push before the item is parked, in which case no feedback will be given
+        mReadyQueues.insert(key);
+    }
+    mCV.notify_one();
+    return token;
+}
+
+bool PendingPushManager::Cancel(uint64_t token) {
+    lock_guard<mutex> lock(mMux);
+    for (auto& queue : mPendingItems) {
+        auto& items = queue.second;
+        auto it
+            = find_if(items.begin(), items.end(), [token](const PendingItem& item) { return item.mToken == token; });
+        if (it != items.end()) {
+            items.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PendingPushManager::HasPendingItems(QueueKey key) const {
+    lock_guard<mutex> lock(mMux);
+    return mPendingItems.find(key) != mPendingItems.end();
+}
+
+void PendingPushManager::Run() {
+    LOG_INFO(sLogger, ("pending push manager", "started"));
+    unique_lock<mutex> lock(mMux);
+    while (mIsThreadRunning.load()) {
+        auto wakeTime = chrono::steady_clock::now()
+            + chrono::milliseconds(INT32_FLAG(process_queue_pending_push_retry_interval_ms));
+        for (const auto& queue : mPendingItems) {
+            for (const auto& item : queue.second) {
+                wakeTime = min(wakeTime, item.mDeadline);
+            }
+        }
+        mCV.wait_until(lock, wakeTime, [this]() { return !mIsThreadRunning.load() || !mReadyQueues.empty(); });
+        if (!mIsThreadRunning.load()) {
+            break;
+        }
+        // woken up without feedback means either some deadline is reached or it is time to retry all queues
+        bool retryAll = mReadyQueues.empty();
+        lock.unlock();
+        PushPendingItems(retryAll, false);
+        lock.lock();
+    }
+}
+
+void PendingPushManager::PushPendingItems(bool retryAll, bool discardAll) {
+    list<pair<QueueKey, deque<PendingItem>>> queues;
+    {
+        lock_guard<mutex> lock(mMux);
+        for (auto& queue : mPendingItems) {
+            if (retryAll || mReadyQueues.find(queue.first) != mReadyQueues.end()) {
+                queues.emplace_back(queue.first, std::move(queue.second));
+                queue.second.clear();
+            }
+        }
+        mReadyQueues.clear();
+    }
+
+    // the items are pushed without mMux held, since feedback is given with process queue lock held
+    vector<pair<PushCallback, bool>> results;
+    auto now = chrono::steady_clock::now();
+    for (auto& [key, items] : queues) {
+        while (!items.empty()) {
+            auto res = ProcessQueueManager::GetInstance()->PushQueue(key, std::move(items.front().mItem));
+            if (res == QueueStatus::QUEUE_FULL) {
+                break;
+            }
+            if (res == QueueStatus::QUEUE_NOT_EXIST) {
+                LOG_WARNING(sLogger,
+                            ("process queue not found when pushing parked items, perhaps due to config deletion",
+                             "discard data")("config", QueueKeyManager::GetInstance()->GetName(key)));
+            }
+            results.emplace_back(std::move(items.front().mCallback), res == QueueStatus::OK);
+            items.pop_front();
+        }
+        for (auto it = items.begin(); it != items.end();) {
+            if (discardAll || it->mDeadline <= now) {
+                LOG_WARNING(sLogger,
+                            ("failed to push parked item to process queue before deadline",
+                             "discard data")("config", QueueKeyManager::GetInstance()->GetName(key)));
+                results.emplace_back(std::move(it->mCallback), false);
+                it = items.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    {
+        lock_guard<mutex> lock(mMux);
+        for (auto& [key, items] : queues) {
+            auto it = mPendingItems.find(key);
+            if (it == mPendingItems.end()) {
+                // should not happen
+                continue;
+            }
+            // items parked meanwhile are behind the remaining ones
+            move(it->second.begin(), it->second.end(), back_inserter(items));
+            it->second = std::move(items);
+            if (it->second.empty()) {
+                mPendingItems.erase(it);
+            }
+        }
+    }
+
+    for (auto& [callback, success] : results) {
+        if (callback) {
+            callback(success);
+        }
+    }
+}
+
+} // namespace logtail
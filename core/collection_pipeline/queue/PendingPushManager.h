@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "collection_pipeline/queue/ProcessQueueItem.h"
+#include "collection_pipeline/queue/QueueKey.h"
+#include "common/FeedbackInterface.h"
+
+namespace logtail {
+
+enum class PushStatus { PUSHED, PENDING, REJECTED };
+
+// invoked with true if the parked item is finally pushed, or false if it is discarded
+using PushCallback = std::function<void(bool)>;
+
+// Items that cannot be pushed to a full process queue are parked here, so that producers need not wait for the queue.
+// Parked items of a queue are pushed in order once the queue gives feedback that it is valid to push again, and are
+// discarded at their deadlines. Callbacks are invoked by the manager thread without any lock held.
+class PendingPushManager : public FeedbackInterface {
+public:
+    PendingPushManager(const PendingPushManager&) = delete;
+    PendingPushManager& operator=(const PendingPushManager&) = delete;
+
+    static PendingPushManager* GetInstance() {
+        static PendingPushManager instance;
+        return &instance;
+    }
+
+    void Start();
+    // all parked items are pushed for the last time, and the remaining ones are discarded
+    void Stop();
+
+    void Feedback(int64_t key) override;
+
+    // returns the token of the parked item, or 0 if the item is not parked and left intact
+    uint64_t Park(QueueKey key,
+                  std::unique_ptr<ProcessQueueItem>& item,
+                  std::chrono::steady_clock::time_point deadline,
+                  PushCallback&& callback);
+    // returns false if the item is no longer parked, the callback is not invoked if the item is cancelled
+    bool Cancel(uint64_t token);
+    // items parked for the queue must be pushed before any new item to keep the order
+    bool HasPendingItems(QueueKey key) const;
+
+private:
+    struct PendingItem {
+        uint64_t mToken = 0;
+        std::unique_ptr<ProcessQueueItem> mItem;
+        std::chrono::steady_clock::time_point mDeadline;
+        PushCallback mCallback;
+    };
+
+    PendingPushManager() = default;
+    ~PendingPushManager() = default;
+
+    void Run();
+    void PushPendingItems(bool retryAll, bool discardAll);
+
+    mutable std::mutex mMux;
+    // a queue is kept in the map while its items are being pushed by the manager thread, even if emptied
+    std::unordered_map<QueueKey, std::deque<PendingItem>> mPendingItems;
+    std::unordered_set<QueueKey> mReadyQueues;
+    uint64_t mNextToken = 1;
+    std::condition_variable mCV;
+
+    std::future<void> mThreadRes;
+    std::atomic_bool mIsThreadRunning = false;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class PendingPushManagerUnittest;
+#endif
+};
+
+} // namespace logtail
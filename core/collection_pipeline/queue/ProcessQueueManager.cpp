@@ -21,6 +21,7 @@
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "common/Flags.h"
+#include "common/memory/MemoryGovernor.h"
 
 // For one queue, only one of the following two flags will be used.
 DEFINE_FLAG_INT32(count_bounded_process_queue_capacity, "", 5);
@@ -134,6 +135,10 @@ bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
     lock_guard<mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
+        // inputs are throttled by priority under memory pressure
+        if (MemoryGovernor::GetInstance()->IsThrottled((*iter->second.first)->GetPriority())) {
+            return false;
+        }
         if (iter->second.second == QueueType::COUNT_BOUNDED) {
             return static_cast<CountBoundedProcessQueue*>(iter->second.first->get())->IsValidToPush();
         }
@@ -150,6 +155,10 @@ QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueue
         lock_guard<mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
+            // push-mode inputs never call IsValidToPush, so they are throttled here, and either retry or drop the data
+            if (MemoryGovernor::GetInstance()->IsThrottled((*iter->second.first)->GetPriority())) {
+                return QueueStatus::QUEUE_FULL;
+            }
             if (!(*iter->second.first)->Push(std::move(item))) {
                 return QueueStatus::QUEUE_FULL;
             }
@@ -103,6 +103,7 @@ private:
     friend class HostMonitorInputRunnerUnittest;
     friend class ModifyHandlerUnittest;
     friend class LogInputReaderUnittest;
+    friend class PendingPushManagerUnittest;
 #endif
 };
 
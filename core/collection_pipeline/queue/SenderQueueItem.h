@@ -24,6 +24,7 @@
 #include <string>
 
 #include "collection_pipeline/queue/QueueKey.h"
+#include "common/memory/MemoryGovernor.h"
 
 namespace logtail {
 
@@ -46,7 +47,10 @@ struct SenderQueueItem {
     std::chrono::system_clock::time_point mFirstEnqueTime;
     std::chrono::system_clock::time_point mLastSendTime;
     std::chrono::system_clock::time_point mQuickFailNextRetryTime; // for build request failure
+    // the earliest create time of the event groups serialized into the item, left default if unknown
+    std::chrono::system_clock::time_point mEventCreateTime;
     uint32_t mTryCnt = 1;
+    MemoryAccount mMemAccount;
 
     SenderQueueItem(std::string&& data,
                     size_t rawSize,
@@ -60,7 +64,8 @@ struct SenderQueueItem {
           mBufferOrNot(bufferOrNot),
           mFlusher(flusher),
           mQueueKey(key),
-          mStatus(SendingStatus::IDLE) {}
+          mStatus(SendingStatus::IDLE),
+          mMemAccount(MemoryCategory::SENDER_QUEUE, mData.size()) {}
     virtual ~SenderQueueItem() = default;
 
     // for Clone only
@@ -76,7 +81,9 @@ struct SenderQueueItem {
           mFirstEnqueTime(item.mFirstEnqueTime),
           mLastSendTime(item.mLastSendTime),
           mQuickFailNextRetryTime(item.mQuickFailNextRetryTime),
-          mTryCnt(item.mTryCnt) {}
+          mEventCreateTime(item.mEventCreateTime),
+          mTryCnt(item.mTryCnt),
+          mMemAccount(item.mMemAccount) {}
 
     virtual SenderQueueItem* Clone() { return new SenderQueueItem(*this); }
 };
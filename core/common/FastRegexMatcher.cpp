@@ -0,0 +1,481 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/FastRegexMatcher.h"
+
+#include <cctype>
+#include <cstring>
+
+#include <limits>
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+const uint32_t kInfinite = numeric_limits<uint32_t>::max();
+
+bitset<256> MakeSet(const char* chars) {
+    bitset<256> res;
+    for (const char* p = chars; *p != '\0'; ++p) {
+        res.set(static_cast<unsigned char>(*p));
+    }
+    return res;
+}
+
+bitset<256> MakeRange(unsigned char from, unsigned char to) {
+    bitset<256> res;
+    for (uint32_t c = from; c <= to; ++c) {
+        res.set(c);
+    }
+    return res;
+}
+
+const bitset<256>& AsciiSet() {
+    static const bitset<256> sSet = MakeRange(0, 127);
+    return sSet;
+}
+
+// bytes >= 0x80 are classified by the locale used by boost, so they are left to boost
+const bitset<256>& NonAsciiSet() {
+    static const bitset<256> sSet = MakeRange(128, 255);
+    return sSet;
+}
+
+const bitset<256>& DigitSet() {
+    static const bitset<256> sSet = MakeRange('0', '9');
+    return sSet;
+}
+
+const bitset<256>& WordSet() {
+    static const bitset<256> sSet = MakeRange('0', '9') | MakeRange('a', 'z') | MakeRange('A', 'Z') | MakeSet("_");
+    return sSet;
+}
+
+const bitset<256>& SpaceSet() {
+    static const bitset<256> sSet = MakeSet(" \t\n\v\f\r");
+    return sSet;
+}
+
+// characters which may be treated as line separators by boost
+const bitset<256>& LineSeparatorSet() {
+    static const bitset<256> sSet = MakeSet("\n\r\f");
+    return sSet;
+}
+
+bool IsMetaChar(char c) {
+    switch (c) {
+        case '\\':
+        case '.':
+        case '[':
+        case ']':
+        case '{':
+        case '}':
+        case '(':
+        case ')':
+        case '*':
+        case '+':
+        case '?':
+        case '^':
+        case '$':
+        case '|':
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+bool FastRegexMatcher::Compile(const string& pattern) {
+    mBranches.clear();
+    vector<string> branches;
+    if (!SplitBranches(pattern, branches)) {
+        return false;
+    }
+    bool useful = false;
+    mBranches.resize(branches.size());
+    for (size_t i = 0; i < branches.size(); ++i) {
+        CompileBranch(branches[i], mBranches[i]);
+        if (!mBranches[i].mAtoms.empty() || mBranches[i].mIsExact) {
+            useful = true;
+        }
+    }
+    if (!useful) {
+        mBranches.clear();
+        return false;
+    }
+    return true;
+}
+
+bool FastRegexMatcher::IsExact() const {
+    if (mBranches.empty()) {
+        return false;
+    }
+    for (const auto& branch : mBranches) {
+        if (!branch.mIsExact) {
+            return false;
+        }
+    }
+    return true;
+}
+
+FastRegexMatcher::Result FastRegexMatcher::Match(const char* buffer, size_t size) const {
+    if (mBranches.empty()) {
+        return Result::UNKNOWN;
+    }
+    Result res = Result::NOT_MATCH;
+    for (const auto& branch : mBranches) {
+        switch (MatchBranch(branch, buffer, size)) {
+            case Result::MATCH:
+                return Result::MATCH;
+            case Result::UNKNOWN:
+                res = Result::UNKNOWN;
+                break;
+            default:
+                break;
+        }
+    }
+    return res;
+}
+
+FastRegexMatcher::Result FastRegexMatcher::MatchBranch(const Branch& branch, const char* buffer, size_t size) {
+    size_t pos = 0;
+    for (size_t i = 0; i < branch.mAtoms.size(); ++i) {
+        const auto& atom = branch.mAtoms[i];
+        // for the last atom, matching more than the minimum count makes no difference
+        uint32_t max = i + 1 == branch.mAtoms.size() ? atom.mMin : atom.mMax;
+        uint32_t cnt = 0;
+        while (cnt < max && pos < size) {
+            auto c = static_cast<unsigned char>(buffer[pos]);
+            if (atom.mUncertain[c]) {
+                return Result::UNKNOWN;
+            }
+            if (!atom.mAccept[c]) {
+                break;
+            }
+            ++pos;
+            ++cnt;
+        }
+        if (cnt < atom.mMin) {
+            return Result::NOT_MATCH;
+        }
+    }
+    return branch.mIsExact ? Result::MATCH : Result::UNKNOWN;
+}
+
+bool FastRegexMatcher::SplitBranches(const string& pattern, vector<string>& branches) {
+    int depth = 0;
+    bool inClass = false;
+    size_t begin = 0;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        if (c == '\\') {
+            ++i;
+            continue;
+        }
+        if (inClass) {
+            if (c == ']') {
+                inClass = false;
+            }
+            continue;
+        }
+        switch (c) {
+            case '[':
+                inClass = true;
+                // ']' right after '[' or '[^' is a literal
+                if (i + 1 < pattern.size() && pattern[i + 1] == '^') {
+                    ++i;
+                }
+                if (i + 1 < pattern.size() && pattern[i + 1] == ']') {
+                    ++i;
+                }
+                break;
+            case '(':
+                // inline flags like (?i) also apply to the following branches in boost, so they are left to boost
+                if (i + 2 < pattern.size() && pattern[i + 1] == '?' && strchr("imsx-", pattern[i + 2]) != nullptr) {
+                    return false;
+                }
+                ++depth;
+                break;
+            case ')':
+                if (--depth < 0) {
+                    return false;
+                }
+                break;
+            case '|':
+                if (depth == 0) {
+                    branches.emplace_back(pattern.substr(begin, i - begin));
+                    begin = i + 1;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    if (depth != 0 || inClass) {
+        return false;
+    }
+    branches.emplace_back(pattern.substr(begin));
+    return true;
+}
+
+void FastRegexMatcher::CompileBranch(const string& pattern, Branch& branch) {
+    branch.mAtoms.clear();
+    branch.mIsExact = false;
+
+    size_t pos = 0;
+    if (pos < pattern.size() && pattern[pos] == '^') {
+        // the match always starts at the beginning of the buffer
+        ++pos;
+    }
+    bool isComplete = true;
+    while (pos < pattern.size()) {
+        Atom atom;
+        size_t cur = pos;
+        if (!ParseAtom(pattern, cur, atom) || !ParseQuantifier(pattern, cur, atom)) {
+            isComplete = false;
+            break;
+        }
+        branch.mAtoms.emplace_back(std::move(atom));
+        pos = cur;
+    }
+
+    // greedy matching is only equivalent to backtracking when a variable-length atom is followed by a mandatory atom
+    // that accepts none of its characters, so the atoms are cut at the first variable-length atom not satisfying this
+    for (size_t i = 0; i + 1 < branch.mAtoms.size(); ++i) {
+        const auto& atom = branch.mAtoms[i];
+        if (atom.mMin == atom.mMax) {
+            continue;
+        }
+        const auto& next = branch.mAtoms[i + 1];
+        if (next.mMin == 0 || (atom.mAccept & (next.mAccept | next.mUncertain)).any()) {
+            branch.mAtoms.resize(i + 1);
+            isComplete = false;
+            break;
+        }
+    }
+    branch.mIsExact = isComplete;
+}
+
+bool FastRegexMatcher::ParseAtom(const string& pattern, size_t& pos, Atom& atom) {
+    char c = pattern[pos];
+    switch (c) {
+        case '.':
+            atom.mAccept.set();
+            atom.mUncertain = LineSeparatorSet();
+            ++pos;
+            return true;
+        case '[':
+            return ParseClass(pattern, pos, atom);
+        case '\\':
+            if (pos + 1 >= pattern.size() || !ParseEscape(pattern[pos + 1], atom)) {
+                return false;
+            }
+            pos += 2;
+            return true;
+        default:
+            if (IsMetaChar(c)) {
+                return false;
+            }
+            atom.mAccept.set(static_cast<unsigned char>(c));
+            ++pos;
+            return true;
+    }
+}
+
+bool FastRegexMatcher::ParseClass(const string& pattern, size_t& pos, Atom& atom) {
+    size_t cur = pos + 1;
+    bool negative = false;
+    if (cur < pattern.size() && pattern[cur] == '^') {
+        negative = true;
+        ++cur;
+    }
+    bool first = true;
+    while (cur < pattern.size()) {
+        char c = pattern[cur];
+        if (c == ']' && !first) {
+            break;
+        }
+        first = false;
+        if (c == '[') {
+            // posix classes like [:alpha:] are left to boost
+            return false;
+        }
+        if (c == '\\') {
+            if (cur + 1 >= pattern.size()) {
+                return false;
+            }
+            char e = pattern[cur + 1];
+            if (isalpha(static_cast<unsigned char>(e))) {
+                // \d, \w, \s and their complements, as well as control characters
+                if (!ParseEscape(e, atom)) {
+                    return false;
+                }
+                // control characters can still be the beginning of a range, which is not supported for simplicity
+                if (cur + 2 < pattern.size() && pattern[cur + 2] == '-' && cur + 3 < pattern.size()
+                    && pattern[cur + 3] != ']') {
+                    return false;
+                }
+                cur += 2;
+                continue;
+            }
+            c = e;
+            ++cur;
+        }
+        auto from = static_cast<unsigned char>(c);
+        if (cur + 2 < pattern.size() && pattern[cur + 1] == '-' && pattern[cur + 2] != ']') {
+            char to = pattern[cur + 2];
+            if (to == '\\' || to == '[' || static_cast<unsigned char>(to) < from) {
+                return false;
+            }
+            atom.mAccept |= MakeRange(from, static_cast<unsigned char>(to));
+            cur += 3;
+        } else {
+            atom.mAccept.set(from);
+            ++cur;
+        }
+    }
+    if (cur >= pattern.size()) {
+        return false;
+    }
+    if (negative) {
+        atom.mAccept.flip();
+    }
+    pos = cur + 1;
+    return true;
+}
+
+bool FastRegexMatcher::ParseEscape(char c, Atom& atom) {
+    switch (c) {
+        case 'd':
+            atom.mAccept |= DigitSet();
+            atom.mUncertain |= NonAsciiSet();
+            return true;
+        case 'D':
+            atom.mAccept |= AsciiSet() & ~DigitSet();
+            atom.mUncertain |= NonAsciiSet();
+            return true;
+        case 'w':
+            atom.mAccept |= WordSet();
+            atom.mUncertain |= NonAsciiSet();
+            return true;
+        case 'W':
+            atom.mAccept |= AsciiSet() & ~WordSet();
+            atom.mUncertain |= NonAsciiSet();
+            return true;
+        case 's':
+            atom.mAccept |= SpaceSet();
+            atom.mUncertain |= NonAsciiSet();
+            return true;
+        case 'S':
+            atom.mAccept |= AsciiSet() & ~SpaceSet();
+            atom.mUncertain |= NonAsciiSet();
+            return true;
+        case 't':
+            atom.mAccept.set('\t');
+            return true;
+        case 'n':
+            atom.mAccept.set('\n');
+            return true;
+        case 'r':
+            atom.mAccept.set('\r');
+            return true;
+        case 'f':
+            atom.mAccept.set('\f');
+            return true;
+        case 'v':
+            atom.mAccept.set('\v');
+            return true;
+        default:
+            // other escaped letters and digits are assertions, back references or special sequences
+            if (isalnum(static_cast<unsigned char>(c))) {
+                return false;
+            }
+            atom.mAccept.set(static_cast<unsigned char>(c));
+            return true;
+    }
+}
+
+bool FastRegexMatcher::ParseQuantifier(const string& pattern, size_t& pos, Atom& atom) {
+    if (pos >= pattern.size()) {
+        return true;
+    }
+    switch (pattern[pos]) {
+        case '*':
+            atom.mMin = 0;
+            atom.mMax = kInfinite;
+            ++pos;
+            break;
+        case '+':
+            atom.mMin = 1;
+            atom.mMax = kInfinite;
+            ++pos;
+            break;
+        case '?':
+            atom.mMin = 0;
+            atom.mMax = 1;
+            ++pos;
+            break;
+        case '{': {
+            size_t cur = pos + 1;
+            auto parseNum = [&](uint32_t& num) {
+                size_t begin = cur;
+                uint64_t val = 0;
+                while (cur < pattern.size() && isdigit(static_cast<unsigned char>(pattern[cur]))) {
+                    val = val * 10 + (pattern[cur] - '0');
+                    if (val > 65535) {
+                        return false;
+                    }
+                    ++cur;
+                }
+                num = static_cast<uint32_t>(val);
+                return cur > begin;
+            };
+            uint32_t min = 0, max = 0;
+            if (!parseNum(min)) {
+                return false;
+            }
+            if (cur < pattern.size() && pattern[cur] == ',') {
+                ++cur;
+                if (cur < pattern.size() && pattern[cur] == '}') {
+                    max = kInfinite;
+                } else if (!parseNum(max) || max < min) {
+                    return false;
+                }
+            } else {
+                max = min;
+            }
+            if (cur >= pattern.size() || pattern[cur] != '}') {
+                return false;
+            }
+            atom.mMin = min;
+            atom.mMax = max;
+            pos = cur + 1;
+            break;
+        }
+        default:
+            return true;
+    }
+    // lazy and possessive quantifiers are left to boost
+    if (pos < pattern.size() && (pattern[pos] == '?' || pattern[pos] == '+')) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace logtail
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <bitset>
+#include <string>
+#include <vector>
+
+namespace logtail {
+
+// FastRegexMatcher compiles the leading part of a perl-style regex into a sequence of character-class atoms with
+// repetition counts, e.g. ^\d{4}-\d{2}-\d{2} or \s+at\s, and tests it with table lookups instead of boost.
+// It follows the semantics of BoostRegexSearch(buffer, size, ...), i.e. the match must start at the beginning of the
+// buffer. When only a prefix of the regex can be compiled, or a byte whose class membership depends on locale is met,
+// UNKNOWN is returned and the caller should fall back to boost.
+class FastRegexMatcher {
+public:
+    enum class Result { MATCH, NOT_MATCH, UNKNOWN };
+
+    // returns false if no part of the pattern can be compiled, or it has inline flags like (?i)
+    bool Compile(const std::string& pattern);
+    Result Match(const char* buffer, size_t size) const;
+
+    bool IsCompiled() const { return !mBranches.empty(); }
+    // true if the result is never UNKNOWN for ASCII input
+    bool IsExact() const;
+
+private:
+    struct Atom {
+        std::bitset<256> mAccept;
+        // bytes that cannot be judged without boost
+        std::bitset<256> mUncertain;
+        uint32_t mMin = 1;
+        uint32_t mMax = 1;
+    };
+
+    struct Branch {
+        std::vector<Atom> mAtoms;
+        // false if only a prefix of the branch is compiled
+        bool mIsExact = false;
+    };
+
+    static bool SplitBranches(const std::string& pattern, std::vector<std::string>& branches);
+    static void CompileBranch(const std::string& pattern, Branch& branch);
+    static bool ParseAtom(const std::string& pattern, size_t& pos, Atom& atom);
+    static bool ParseClass(const std::string& pattern, size_t& pos, Atom& atom);
+    static bool ParseEscape(char c, Atom& atom);
+    static bool ParseQuantifier(const std::string& pattern, size_t& pos, Atom& atom);
+    static Result MatchBranch(const Branch& branch, const char* buffer, size_t size);
+
+    std::vector<Branch> mBranches;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FastRegexMatcherUnittest;
+#endif
+};
+
+} // namespace logtail
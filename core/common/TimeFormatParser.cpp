@@ -0,0 +1,411 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/TimeFormatParser.h"
+
+#include <cctype>
+#include <cstring>
+#include <ctime>
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+// keep the same with Strptime
+const char* kMonthNames[12] = {"January",
+                               "February",
+                               "March",
+                               "April",
+                               "May",
+                               "June",
+                               "July",
+                               "August",
+                               "September",
+                               "October",
+                               "November",
+                               "December"};
+const char* kMonthAbbrNames[12] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+const char* kWeekdayNames[7] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+const char* kWeekdayAbbrNames[7] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+
+bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// parse exactly @width digits
+bool ParseDigits(StringView str, size_t& pos, size_t width, int32_t& res) {
+    if (pos + width > str.size()) {
+        return false;
+    }
+    int32_t val = 0;
+    for (size_t i = 0; i < width; ++i) {
+        char c = str[pos + i];
+        if (!IsDigit(c)) {
+            return false;
+        }
+        val = val * 10 + (c - '0');
+    }
+    pos += width;
+    res = val;
+    return true;
+}
+
+bool ParseRangedDigits(StringView str, size_t& pos, size_t width, int32_t min, int32_t max, int32_t& res) {
+    return ParseDigits(str, pos, width, res) && res >= min && res <= max;
+}
+
+int32_t FindName(StringView str, size_t& pos, const char* const* names, const char* const* abbrNames, int cnt) {
+    for (const char* const* list : {names, abbrNames}) {
+        for (int i = 0; i < cnt; ++i) {
+            size_t len = strlen(list[i]);
+            if (pos + len > str.size()) {
+                continue;
+            }
+            bool matched = true;
+            for (size_t j = 0; j < len; ++j) {
+                if (tolower(static_cast<unsigned char>(str[pos + j])) != tolower(static_cast<unsigned char>(list[i][j]))) {
+                    matched = false;
+                    break;
+                }
+            }
+            if (matched) {
+                pos += len;
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+bool TimeFormatParser::Compile(const string& format, int32_t specifiedYear) {
+    mFields.clear();
+    mIsTimestamp = false;
+    mHasYear = false;
+    mSpecifiedYear = specifiedYear;
+    mIsCompiled = false;
+
+    if (format == "%s") {
+        mIsTimestamp = true;
+        mIsCompiled = true;
+        return true;
+    }
+    if (format == "%f" || !CompileFields(format.c_str(), 0)) {
+        mFields.clear();
+        return false;
+    }
+    size_t shortYearCnt = 0;
+    for (const auto& field : mFields) {
+        if (field.mType == FieldType::YEAR || field.mType == FieldType::SHORT_YEAR) {
+            mHasYear = true;
+        }
+        if (field.mType == FieldType::SHORT_YEAR) {
+            ++shortYearCnt;
+        }
+    }
+    // the century of the second %y is taken from the first one in Strptime
+    if (shortYearCnt > 1) {
+        mFields.clear();
+        return false;
+    }
+    // year deduction according to current time is left to Strptime
+    if (!mHasYear && specifiedYear <= 0) {
+        mFields.clear();
+        return false;
+    }
+    mIsCompiled = true;
+    return true;
+}
+
+bool TimeFormatParser::CompileFields(const char* format, int depth) {
+    if (depth > 1) {
+        return false;
+    }
+    for (const char* p = format; *p != '\0'; ++p) {
+        char c = *p;
+        if (isspace(static_cast<unsigned char>(c))) {
+            mFields.push_back({FieldType::SPACE});
+            continue;
+        }
+        if (c != '%') {
+            mFields.push_back({FieldType::LITERAL, c});
+            continue;
+        }
+        switch (*++p) {
+            case '%':
+                mFields.push_back({FieldType::LITERAL, '%'});
+                break;
+            case 'F':
+                if (!CompileFields("%Y-%m-%d", depth + 1)) {
+                    return false;
+                }
+                break;
+            case 'T':
+                if (!CompileFields("%H:%M:%S", depth + 1)) {
+                    return false;
+                }
+                break;
+            case 'R':
+                if (!CompileFields("%H:%M", depth + 1)) {
+                    return false;
+                }
+                break;
+            case 'Y':
+                mFields.push_back({FieldType::YEAR});
+                break;
+            case 'y':
+                mFields.push_back({FieldType::SHORT_YEAR});
+                break;
+            case 'm':
+                mFields.push_back({FieldType::MONTH});
+                break;
+            case 'b':
+            case 'B':
+            case 'h':
+                mFields.push_back({FieldType::MONTH_NAME});
+                break;
+            case 'd':
+            case 'e':
+                mFields.push_back({FieldType::DAY});
+                break;
+            case 'a':
+            case 'A':
+                mFields.push_back({FieldType::WEEKDAY_NAME});
+                break;
+            case 'H':
+            case 'k':
+                mFields.push_back({FieldType::HOUR});
+                break;
+            case 'M':
+                mFields.push_back({FieldType::MINUTE});
+                break;
+            case 'S':
+                mFields.push_back({FieldType::SECOND});
+                break;
+            case 'f':
+                mFields.push_back({FieldType::NANOSECOND});
+                break;
+            case 'z':
+                mFields.push_back({FieldType::TIMEZONE});
+                break;
+            case 'n':
+            case 't':
+                mFields.push_back({FieldType::SPACE});
+                break;
+            default:
+                // including '\0', and conversions that are rarely used or depend on other fields
+                return false;
+        }
+    }
+    return true;
+}
+
+bool TimeFormatParser::Parse(StringView str, LogtailTime& logTime, int& nanosecondLength, Cache& cache) const {
+    if (!mIsCompiled) {
+        return false;
+    }
+    if (mIsTimestamp) {
+        return ParseTimestamp(str, logTime, nanosecondLength);
+    }
+
+    int32_t year = mSpecifiedYear, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    long nanosecond = 0;
+    int nanoLen = -1;
+    size_t pos = 0;
+    for (const auto& field : mFields) {
+        switch (field.mType) {
+            case FieldType::LITERAL:
+                if (pos >= str.size() || str[pos] != field.mLiteral) {
+                    return false;
+                }
+                ++pos;
+                break;
+            case FieldType::SPACE:
+                while (pos < str.size() && isspace(static_cast<unsigned char>(str[pos]))) {
+                    ++pos;
+                }
+                break;
+            case FieldType::YEAR:
+                if (!ParseDigits(str, pos, 4, year)) {
+                    return false;
+                }
+                break;
+            case FieldType::SHORT_YEAR:
+                if (!ParseDigits(str, pos, 2, year)) {
+                    return false;
+                }
+                year += year <= 68 ? 2000 : 1900;
+                break;
+            case FieldType::MONTH:
+                if (!ParseRangedDigits(str, pos, 2, 1, 12, month)) {
+                    return false;
+                }
+                --month;
+                break;
+            case FieldType::MONTH_NAME:
+                month = FindName(str, pos, kMonthNames, kMonthAbbrNames, 12);
+                if (month < 0) {
+                    return false;
+                }
+                break;
+            case FieldType::DAY:
+                if (!ParseRangedDigits(str, pos, 2, 1, 31, day)) {
+                    return false;
+                }
+                break;
+            case FieldType::WEEKDAY_NAME:
+                // week day is ignored by mktime
+                if (FindName(str, pos, kWeekdayNames, kWeekdayAbbrNames, 7) < 0) {
+                    return false;
+                }
+                break;
+            case FieldType::HOUR:
+                if (!ParseRangedDigits(str, pos, 2, 0, 23, hour)) {
+                    return false;
+                }
+                break;
+            case FieldType::MINUTE:
+                if (!ParseRangedDigits(str, pos, 2, 0, 59, minute)) {
+                    return false;
+                }
+                break;
+            case FieldType::SECOND:
+                // leap seconds are left to Strptime
+                if (!ParseRangedDigits(str, pos, 2, 0, 59, second)) {
+                    return false;
+                }
+                break;
+            case FieldType::NANOSECOND: {
+                size_t begin = pos;
+                long val = 0;
+                while (pos < str.size() && IsDigit(str[pos]) && pos - begin < 9) {
+                    val = val * 10 + (str[pos] - '0');
+                    ++pos;
+                }
+                nanoLen = static_cast<int>(pos - begin);
+                if (nanoLen == 0 || (pos < str.size() && IsDigit(str[pos]))) {
+                    return false;
+                }
+                for (int i = nanoLen; i < 9; ++i) {
+                    val *= 10;
+                }
+                nanosecond = val;
+                break;
+            }
+            case FieldType::TIMEZONE: {
+                // only Z and numeric offsets are supported, which make no difference to mktime
+                while (pos < str.size() && isspace(static_cast<unsigned char>(str[pos]))) {
+                    ++pos;
+                }
+                if (pos >= str.size()) {
+                    return false;
+                }
+                char sign = str[pos++];
+                if (sign == 'Z') {
+                    break;
+                }
+                if (sign != '+' && sign != '-') {
+                    return false;
+                }
+                int digitCnt = 0;
+                int offset = 0;
+                while (digitCnt < 4 && pos < str.size()) {
+                    if (IsDigit(str[pos])) {
+                        offset = offset * 10 + (str[pos++] - '0');
+                        ++digitCnt;
+                    } else if (digitCnt == 2 && str[pos] == ':') {
+                        ++pos;
+                    } else {
+                        break;
+                    }
+                }
+                if (digitCnt != 2 && (digitCnt != 4 || offset % 100 >= 60)) {
+                    return false;
+                }
+                break;
+            }
+        }
+    }
+
+    if (year != cache.mYear || month != cache.mMonth || day != cache.mDay) {
+        cache.mYear = year;
+        cache.mMonth = month;
+        cache.mDay = day;
+        cache.mDayNumber = DaysFromCivil(year, month + 1, day);
+    }
+    int64_t minuteNumber = cache.mDayNumber * 1440 + hour * 60 + minute;
+    if (minuteNumber != cache.mMinuteNumber) {
+        // mktime is only called once per minute, since the offset between local time and UTC can only change on
+        // minute boundaries
+        struct tm tm = {};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month;
+        tm.tm_mday = day;
+        tm.tm_hour = hour;
+        tm.tm_min = minute;
+        tm.tm_isdst = 0;
+        time_t t = mktime(&tm);
+        if (t == -1) {
+            return false;
+        }
+        cache.mMinuteNumber = minuteNumber;
+        cache.mLocalOffset = static_cast<int64_t>(t) - minuteNumber * 60;
+    }
+    logTime.tv_sec = minuteNumber * 60 + cache.mLocalOffset + second;
+    logTime.tv_nsec = nanosecond;
+    nanosecondLength = nanoLen;
+    return true;
+}
+
+bool TimeFormatParser::ParseTimestamp(StringView str, LogtailTime& logTime, int& nanosecondLength) const {
+    // the first 10 digits are seconds, and the rest are the fraction, see strptime_ns
+    size_t digitCnt = 0;
+    while (digitCnt < str.size() && IsDigit(str[digitCnt])) {
+        ++digitCnt;
+    }
+    if (digitCnt < 10 || digitCnt > 19 || str[0] == '0' || (digitCnt == 19 && str[0] == '9')) {
+        return false;
+    }
+    int64_t sec = 0;
+    for (size_t i = 0; i < 10; ++i) {
+        sec = sec * 10 + (str[i] - '0');
+    }
+    long nanosecond = 0;
+    for (size_t i = 10; i < digitCnt; ++i) {
+        nanosecond = nanosecond * 10 + (str[i] - '0');
+    }
+    for (size_t i = digitCnt; i < 19; ++i) {
+        nanosecond *= 10;
+    }
+    logTime.tv_sec = sec;
+    logTime.tv_nsec = nanosecond;
+    nanosecondLength = static_cast<int>(digitCnt - 10);
+    return true;
+}
+
+int64_t TimeFormatParser::DaysFromCivil(int64_t year, uint32_t month, uint32_t day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yoe = year - era * 400;
+    int64_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + static_cast<int64_t>(day) - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+} // namespace logtail
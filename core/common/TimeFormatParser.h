@@ -0,0 +1,91 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+#include "common/StringView.h"
+#include "common/TimeUtil.h"
+
+namespace logtail {
+
+// TimeFormatParser compiles a strptime format into a list of fixed-width fields, so that the common layouts, e.g.
+// %Y-%m-%d %H:%M:%S, %Y-%m-%dT%H:%M:%S.%f, %d/%b/%Y:%H:%M:%S and %s, can be parsed without going through Strptime.
+// Parse gives exactly the same result as Strptime when it succeeds. When it fails, e.g. a field is not zero padded or
+// is out of range, the caller should fall back to Strptime.
+class TimeFormatParser {
+public:
+    // Cache is not thread safe, each thread should have its own one.
+    struct Cache {
+        // civil date of the last parsed time and its day number since epoch
+        int32_t mYear = -1;
+        int32_t mMonth = -1;
+        int32_t mDay = -1;
+        int64_t mDayNumber = 0;
+        // offset between mktime and the civil time of the last parsed minute
+        int64_t mMinuteNumber = INT64_MIN;
+        int64_t mLocalOffset = 0;
+    };
+
+    // @specifiedYear: the same as Strptime.
+    bool Compile(const std::string& format, int32_t specifiedYear = -1);
+    bool IsCompiled() const { return mIsCompiled; }
+    // @nanosecondLength: the same as Strptime, i.e. -1 if there is no %f in the format.
+    bool Parse(StringView str, LogtailTime& logTime, int& nanosecondLength, Cache& cache) const;
+
+    static int64_t DaysFromCivil(int64_t year, uint32_t month, uint32_t day);
+
+private:
+    enum class FieldType {
+        LITERAL,
+        SPACE,
+        YEAR,
+        SHORT_YEAR,
+        MONTH,
+        MONTH_NAME,
+        DAY,
+        WEEKDAY_NAME,
+        HOUR,
+        MINUTE,
+        SECOND,
+        NANOSECOND,
+        TIMEZONE,
+    };
+
+    struct Field {
+        FieldType mType;
+        char mLiteral = '\0';
+    };
+
+    bool CompileFields(const char* format, int depth);
+    bool ParseTimestamp(StringView str, LogtailTime& logTime, int& nanosecondLength) const;
+
+    std::vector<Field> mFields;
+    bool mIsTimestamp = false;
+    bool mHasYear = false;
+    int32_t mSpecifiedYear = -1;
+    bool mIsCompiled = false;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class TimeFormatParserUnittest;
+#endif
+};
+
+} // namespace logtail
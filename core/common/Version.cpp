@@ -0,0 +1,11 @@
+#include "version.h"
+
+const char* const ILOGTAIL_VERSION = "0.0.1";
+const char* const ILOGTAIL_GIT_HASH = "ab99662e2b5450737e213b4cd1602c243e73b8a9";
+const char* const ILOGTAIL_BUILD_DATE = "20261019";
+
+#if defined(__linux__)
+const char* const ILOGTAIL_UPDATE_SUFFIX = "";
+#elif defined(_MSC_VER)
+const char* const ILOGTAIL_UPDATE_SUFFIX = ".update";
+#endif
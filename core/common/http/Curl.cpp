@@ -129,11 +129,16 @@ CURL* CreateCurlHandler(const string& method,
                         const string& intf,
                         bool followRedirects,
                         const optional<CurlTLS>& tls,
-                        const optional<CurlSocket>& socket // socket is used async, the lifespan must be longer
-) {
-    CURL* curl = curl_easy_init();
+                        const optional<CurlSocket>& socket, // socket is used async, the lifespan must be longer
+                        CURL* reusedCurl) {
+    CURL* curl = reusedCurl;
     if (curl == nullptr) {
-        return nullptr;
+        curl = curl_easy_init();
+        if (curl == nullptr) {
+            return nullptr;
+        }
+    } else {
+        curl_easy_reset(curl);
     }
 
     string totalUrl = httpsFlag ? "https://" : "http://";
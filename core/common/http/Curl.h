@@ -32,6 +32,8 @@ namespace logtail {
 
 NetworkCode GetNetworkStatus(CURLcode code);
 
+// @reusedCurl: if given, the handler is reset and reused instead of creating a new one, so that its caches (e.g. tls
+// sessions) are kept.
 CURL* CreateCurlHandler(const std::string& method,
                         bool httpsFlag,
                         const std::string& endpoint,
@@ -46,7 +48,8 @@ CURL* CreateCurlHandler(const std::string& method,
                         const std::string& intf = "",
                         bool followRedirects = false,
                         const std::optional<CurlTLS>& tls = std::nullopt,
-                        const std::optional<CurlSocket>& socket = std::nullopt);
+                        const std::optional<CurlSocket>& socket = std::nullopt,
+                        CURL* reusedCurl = nullptr);
 
 bool SendHttpRequest(std::unique_ptr<HttpRequest>&& request, HttpResponse& response);
 
@@ -0,0 +1,154 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/memory/ChunkPool.h"
+
+#include "common/Flags.h"
+#include "common/memory/MemoryGovernor.h"
+
+DEFINE_FLAG_INT32(chunk_pool_max_retained_size_mb,
+                  "max size of free chunks retained by the chunk pool, 0 means chunks are always freed to the heap",
+                  64);
+DEFINE_FLAG_INT32(chunk_pool_thread_cache_size_kb, "max size of free chunks cached by each thread", 1024);
+
+using namespace std;
+
+namespace logtail {
+
+uint8_t* ChunkPool::Allocate(size_t size, size_t& capacity) {
+    mAllocTotal.fetch_add(1, memory_order_relaxed);
+    if (size > kMaxChunkSize) {
+        capacity = size;
+        MemoryGovernor::GetInstance()->Add(MemoryCategory::SOURCE_BUFFER, capacity);
+        return new uint8_t[size];
+    }
+    size_t sizeClass = GetSizeClass(size);
+    capacity = GetSizeClassSize(sizeClass);
+    MemoryGovernor::GetInstance()->Add(MemoryCategory::SOURCE_BUFFER, capacity);
+
+    uint8_t* chunk = nullptr;
+    ThreadCache* cache = GetThreadCache();
+    if (cache != nullptr && !cache->mChunks[sizeClass].empty()) {
+        chunk = cache->mChunks[sizeClass].back();
+        cache->mChunks[sizeClass].pop_back();
+        cache->mBytes -= capacity;
+    } else {
+        lock_guard<mutex> lock(mMux);
+        if (!mChunks[sizeClass].empty()) {
+            chunk = mChunks[sizeClass].back();
+            mChunks[sizeClass].pop_back();
+        }
+    }
+    if (chunk == nullptr) {
+        return new uint8_t[capacity];
+    }
+    mRetainedBytes.fetch_sub(capacity, memory_order_relaxed);
+    mHitTotal.fetch_add(1, memory_order_relaxed);
+    return chunk;
+}
+
+void ChunkPool::Free(uint8_t* chunk, size_t capacity) {
+    MemoryGovernor::GetInstance()->Add(MemoryCategory::SOURCE_BUFFER, -static_cast<int64_t>(capacity));
+    if (capacity > kMaxChunkSize || !TryRetain(capacity)) {
+        delete[] chunk;
+        return;
+    }
+    size_t sizeClass = GetSizeClass(capacity);
+    ThreadCache* cache = GetThreadCache();
+    if (cache != nullptr
+        && cache->mBytes + capacity <= static_cast<size_t>(INT32_FLAG(chunk_pool_thread_cache_size_kb)) * 1024) {
+        cache->mChunks[sizeClass].push_back(chunk);
+        cache->mBytes += capacity;
+        return;
+    }
+    lock_guard<mutex> lock(mMux);
+    mChunks[sizeClass].push_back(chunk);
+}
+
+void ChunkPool::Trim() {
+    size_t bytes = 0;
+    lock_guard<mutex> lock(mMux);
+    for (size_t i = 0; i < kSizeClassCnt; ++i) {
+        for (auto chunk : mChunks[i]) {
+            delete[] chunk;
+        }
+        bytes += mChunks[i].size() * GetSizeClassSize(i);
+        mChunks[i].clear();
+        mChunks[i].shrink_to_fit();
+    }
+    mRetainedBytes.fetch_sub(bytes, memory_order_relaxed);
+}
+
+// size classes: 1K, 1.25K, 1.5K, 1.75K, 2K, 2.5K, ..., 3.5M, 4M
+size_t ChunkPool::GetSizeClass(size_t size) {
+    if (size <= kMinChunkSize) {
+        return 0;
+    }
+    // 2^shift < size <= 2^(shift+1)
+    size_t shift = kMinChunkShift;
+    while ((static_cast<size_t>(1) << (shift + 1)) < size) {
+        ++shift;
+    }
+    size_t step = (static_cast<size_t>(1) << shift) / kSubClassCnt;
+    size_t subClass = (size - (static_cast<size_t>(1) << shift) + step - 1) / step;
+    return (shift - kMinChunkShift) * kSubClassCnt + subClass;
+}
+
+size_t ChunkPool::GetSizeClassSize(size_t sizeClass) {
+    if (sizeClass == 0) {
+        return kMinChunkSize;
+    }
+    size_t base = static_cast<size_t>(1) << (kMinChunkShift + (sizeClass - 1) / kSubClassCnt);
+    return base + base / kSubClassCnt * ((sizeClass - 1) % kSubClassCnt + 1);
+}
+
+ChunkPool::ThreadCache* ChunkPool::GetThreadCache() {
+    // trivially destructible, so that it is still valid when chunks are freed after the cache is destructed
+    static thread_local bool sIsCacheDestructed = false;
+    struct ThreadCacheHolder {
+        ~ThreadCacheHolder() {
+            sIsCacheDestructed = true;
+            ChunkPool::GetInstance()->FlushThreadCache(mCache);
+        }
+        ThreadCache mCache;
+    };
+
+    if (sIsCacheDestructed) {
+        return nullptr;
+    }
+    static thread_local ThreadCacheHolder sHolder;
+    return &sHolder.mCache;
+}
+
+bool ChunkPool::TryRetain(size_t capacity) {
+    uint64_t limit = static_cast<uint64_t>(INT32_FLAG(chunk_pool_max_retained_size_mb)) * 1024 * 1024;
+    uint64_t retained = mRetainedBytes.load(memory_order_relaxed);
+    do {
+        if (retained + capacity > limit) {
+            return false;
+        }
+    } while (!mRetainedBytes.compare_exchange_weak(retained, retained + capacity, memory_order_relaxed));
+    return true;
+}
+
+void ChunkPool::FlushThreadCache(ThreadCache& cache) {
+    lock_guard<mutex> lock(mMux);
+    for (size_t i = 0; i < kSizeClassCnt; ++i) {
+        mChunks[i].insert(mChunks[i].end(), cache.mChunks[i].begin(), cache.mChunks[i].end());
+        cache.mChunks[i].clear();
+    }
+    cache.mBytes = 0;
+}
+
+} // namespace logtail
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace logtail {
+
+// Process-wide pool of the memory chunks used by BufferAllocator, so that large chunks are reused instead of going
+// through the heap for each event group. Requested sizes are rounded up to size classes (4 per power of two). Freed
+// chunks are first cached by the freeing thread without lock, then by the shared pool, as long as the total retained
+// size is within chunk_pool_max_retained_size_mb. Chunks larger than kMaxChunkSize are never pooled.
+class ChunkPool {
+public:
+    static constexpr size_t kMinChunkSize = 1024;
+    static constexpr size_t kMaxChunkSize = 4 * 1024 * 1024;
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    static ChunkPool* GetInstance() {
+        // never destructed, since chunks may still be freed by thread exits or static destructors at exit
+        static ChunkPool* instance = new ChunkPool();
+        return instance;
+    }
+
+    // capacity is set to the actual size of the chunk, which is no less than size
+    uint8_t* Allocate(size_t size, size_t& capacity);
+    // capacity must be the one returned by Allocate
+    void Free(uint8_t* chunk, size_t capacity);
+    // releases all chunks in the shared pool to the heap, chunks cached by threads are left intact
+    void Trim();
+
+    uint64_t GetRetainedBytes() const { return mRetainedBytes.load(std::memory_order_relaxed); }
+    uint64_t GetAllocTotal() const { return mAllocTotal.load(std::memory_order_relaxed); }
+    uint64_t GetHitTotal() const { return mHitTotal.load(std::memory_order_relaxed); }
+
+    static size_t GetSizeClass(size_t size);
+    static size_t GetSizeClassSize(size_t sizeClass);
+
+private:
+    static constexpr size_t kMinChunkShift = 10;
+    static constexpr size_t kSubClassCnt = 4;
+    static constexpr size_t kSizeClassCnt = 49; // GetSizeClass(kMaxChunkSize) + 1
+
+    struct ThreadCache {
+        std::array<std::vector<uint8_t*>, kSizeClassCnt> mChunks;
+        size_t mBytes = 0;
+    };
+
+    ChunkPool() = default;
+    ~ChunkPool() = default;
+
+    static ThreadCache* GetThreadCache();
+    bool TryRetain(size_t capacity);
+    void FlushThreadCache(ThreadCache& cache);
+
+    std::array<std::vector<uint8_t*>, kSizeClassCnt> mChunks;
+    mutable std::mutex mMux;
+
+    std::atomic_uint64_t mRetainedBytes = 0;
+    std::atomic_uint64_t mAllocTotal = 0;
+    std::atomic_uint64_t mHitTotal = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ChunkPoolUnittest;
+#endif
+};
+
+} // namespace logtail
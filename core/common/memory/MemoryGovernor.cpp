@@ -0,0 +1,87 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/memory/MemoryGovernor.h"
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+constexpr uint32_t kMaxPriority = 2; // the same as ProcessQueueManager::sMaxPriority
+// percentage of the budget to enter each level
+constexpr uint64_t kLevelPercents[] = {0, 60, 80, 95};
+// the level is only lowered when the usage falls below its threshold by this percentage, to avoid flapping
+constexpr uint64_t kHysteresisPercent = 5;
+
+} // namespace
+
+void MemoryGovernor::Add(MemoryCategory category, int64_t delta) {
+    if (delta == 0) {
+        return;
+    }
+    mBytes[static_cast<size_t>(category)].fetch_add(static_cast<uint64_t>(delta), memory_order_relaxed);
+    uint64_t total = mTotalBytes.fetch_add(static_cast<uint64_t>(delta), memory_order_relaxed) + delta;
+    UpdateLevel(total);
+}
+
+void MemoryGovernor::SetBudget(uint64_t bytes) {
+    mBudget.store(bytes, memory_order_relaxed);
+    UpdateLevel(GetTotalBytes());
+}
+
+bool MemoryGovernor::IsThrottled(uint32_t priority) const {
+    return static_cast<uint32_t>(GetLevel()) + priority > kMaxPriority;
+}
+
+const char* MemoryGovernor::GetLevelName(MemoryPressureLevel level) {
+    switch (level) {
+        case MemoryPressureLevel::NORMAL:
+            return "normal";
+        case MemoryPressureLevel::SOFT:
+            return "soft";
+        case MemoryPressureLevel::HARD:
+            return "hard";
+        case MemoryPressureLevel::CRITICAL:
+            return "critical";
+        default:
+            return "unknown";
+    }
+}
+
+void MemoryGovernor::UpdateLevel(uint64_t total) {
+    // called on each accounting change, so it should be cheap
+    uint64_t budget = mBudget.load(memory_order_relaxed);
+    auto level = mLevel.load(memory_order_relaxed);
+    size_t idx = static_cast<size_t>(level);
+    if (budget == 0) {
+        idx = 0;
+    } else {
+        while (idx < static_cast<size_t>(MemoryPressureLevel::CRITICAL)
+               && total * 100 >= budget * kLevelPercents[idx + 1]) {
+            ++idx;
+        }
+        while (idx > 0 && total * 100 + budget * kHysteresisPercent < budget * kLevelPercents[idx]) {
+            --idx;
+        }
+    }
+    auto newLevel = static_cast<MemoryPressureLevel>(idx);
+    if (newLevel != level) {
+        // concurrent updates may race, the loser's level is corrected by the next update
+        mLevel.compare_exchange_strong(level, newLevel, memory_order_relaxed);
+    }
+}
+
+} // namespace logtail
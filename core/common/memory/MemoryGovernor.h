@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+
+namespace logtail {
+
+// Event groups in process queues, processors and batchers keep their data in SourceBuffers, so they are accounted as
+// SOURCE_BUFFER.
+enum class MemoryCategory { SOURCE_BUFFER, SENDER_QUEUE, READER_CACHE, COUNT };
+
+// Graded by the ratio of accounted bytes to the budget. Inputs whose process queue priority is p are throttled once the
+// level exceeds sMaxPriority - p, i.e., the least important inputs are throttled first.
+enum class MemoryPressureLevel { NORMAL, SOFT, HARD, CRITICAL };
+
+// Agent-wide accounting of the memory held by data in flight. Accounting is always done, while the pressure level is
+// only raised when a budget is set, see LogtailMonitor for the actions taken on each level.
+class MemoryGovernor {
+public:
+    MemoryGovernor(const MemoryGovernor&) = delete;
+    MemoryGovernor& operator=(const MemoryGovernor&) = delete;
+
+    static MemoryGovernor* GetInstance() {
+        // never destructed, since memory may still be released by static destructors at exit
+        static MemoryGovernor* instance = new MemoryGovernor();
+        return instance;
+    }
+
+    void Add(MemoryCategory category, int64_t delta);
+    // 0 means no budget, in which case the level is always NORMAL
+    void SetBudget(uint64_t bytes);
+
+    uint64_t GetBytes(MemoryCategory category) const {
+        return mBytes[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+    uint64_t GetTotalBytes() const { return mTotalBytes.load(std::memory_order_relaxed); }
+    uint64_t GetBudget() const { return mBudget.load(std::memory_order_relaxed); }
+    MemoryPressureLevel GetLevel() const { return mLevel.load(std::memory_order_relaxed); }
+
+    bool IsThrottled(uint32_t priority) const;
+    bool ShouldFlushEarly() const { return GetLevel() >= MemoryPressureLevel::HARD; }
+    bool ShouldSpill() const { return GetLevel() == MemoryPressureLevel::CRITICAL; }
+
+    static const char* GetLevelName(MemoryPressureLevel level);
+
+private:
+    MemoryGovernor() = default;
+    ~MemoryGovernor() = default;
+
+    void UpdateLevel(uint64_t total);
+
+    std::array<std::atomic_uint64_t, static_cast<size_t>(MemoryCategory::COUNT)> mBytes{};
+    std::atomic_uint64_t mTotalBytes = 0;
+    std::atomic_uint64_t mBudget = 0;
+    std::atomic<MemoryPressureLevel> mLevel = MemoryPressureLevel::NORMAL;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class MemoryGovernorUnittest;
+#endif
+};
+
+// Keeps the governor informed of the bytes held by its owner, which are released on destruction. A copy accounts for
+// the same bytes once more, the same as the copied owner does.
+class MemoryAccount {
+public:
+    explicit MemoryAccount(MemoryCategory category, size_t bytes = 0) : mCategory(category) { Update(bytes); }
+    MemoryAccount(const MemoryAccount& rhs) : mCategory(rhs.mCategory) { Update(rhs.mBytes); }
+    MemoryAccount& operator=(const MemoryAccount& rhs) {
+        if (this != &rhs) {
+            Update(0);
+            mCategory = rhs.mCategory;
+            Update(rhs.mBytes);
+        }
+        return *this;
+    }
+    ~MemoryAccount() { Update(0); }
+
+    void Update(size_t bytes) {
+        if (bytes != mBytes) {
+            MemoryGovernor::GetInstance()->Add(mCategory, static_cast<int64_t>(bytes) - static_cast<int64_t>(mBytes));
+            mBytes = bytes;
+        }
+    }
+    size_t GetBytes() const { return mBytes; }
+
+private:
+    MemoryCategory mCategory;
+    size_t mBytes = 0;
+};
+
+} // namespace logtail
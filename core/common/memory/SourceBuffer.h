@@ -18,9 +18,11 @@
 
 #include <list>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "common/StringView.h"
+#include "common/memory/ChunkPool.h"
 
 namespace logtail {
 
@@ -41,7 +43,7 @@ private:
     StringBuffer(char* data, size_t capacity) : data(data), size(0), capacity(capacity) { data[0] = '\0'; }
 };
 
-// only movable
+// only movable, chunks are drawn from and returned to the process-wide ChunkPool
 class BufferAllocator {
 private:
     static const uint32_t kAlignSize = sizeof(void*);
@@ -50,10 +52,8 @@ private:
 public:
     explicit BufferAllocator(uint32_t firstChunkSize = 4096, uint32_t chunkSizeLimit = 1024 * 128)
         : mFirstChunkSize(firstChunkSize), mChunkSizeLimit(chunkSizeLimit), mChunkSize(firstChunkSize) {
-        mAllocPtr = new uint8_t[mChunkSize];
-        mAllocatedChunks.push_back(mAllocPtr);
-        mFreeBytesInChunk = mChunkSize;
-        mAllocated = mChunkSize;
+        mAllocPtr = AllocateChunk(mChunkSize);
+        mFreeBytesInChunk = mAllocatedChunks.back().second;
     }
 
     BufferAllocator(const BufferAllocator&) = delete;
@@ -64,19 +64,19 @@ public:
 
     ~BufferAllocator() {
         for (size_t i = 0; i < mAllocatedChunks.size(); i++) {
-            delete[] mAllocatedChunks[i];
+            ChunkPool::GetInstance()->Free(mAllocatedChunks[i].first, mAllocatedChunks[i].second);
         }
     }
 
     void Reset(void) {
         for (size_t i = 1; i < mAllocatedChunks.size(); i++) {
-            delete[] mAllocatedChunks[i];
+            ChunkPool::GetInstance()->Free(mAllocatedChunks[i].first, mAllocatedChunks[i].second);
         }
         mAllocatedChunks.resize(1);
-        mAllocPtr = mAllocatedChunks[0];
+        mAllocPtr = mAllocatedChunks[0].first;
         mChunkSize = mFirstChunkSize;
-        mFreeBytesInChunk = mChunkSize;
-        mAllocated = mChunkSize;
+        mFreeBytesInChunk = mAllocatedChunks[0].second;
+        mAllocated = mAllocatedChunks[0].second;
         mUsed = 0;
     }
 
@@ -90,7 +90,9 @@ public:
 
     size_t TotalAllocated() { return mAllocated; }
 
-    int64_t GetAllocatedSize() const { return mAllocated + mAllocatedChunks.size() * sizeof(void*); }
+    int64_t GetAllocatedSize() const {
+        return mAllocated + mAllocatedChunks.size() * sizeof(decltype(mAllocatedChunks)::value_type);
+    }
 
 private:
     // Please do not make it public, user should always use Allocate() to get a better performance.
@@ -107,11 +109,15 @@ private:
             /*
              * This request is unexpectedly large. We believe the next request
              * will not be so large. Thus, it is wise to allocate it directly
-             * from heap in order to avoid polluting chunk size.
+             * from the pool in order to avoid polluting chunk size.
              */
-            mem = new uint8_t[bytes];
-            mAllocatedChunks.push_back(mem);
-            mAllocated += bytes;
+            mem = AllocateChunk(bytes);
+            // the chunk may be larger than requested, whose free area is used if it is larger than the current one
+            uint32_t freeBytes = mAllocatedChunks.back().second - bytes;
+            if (freeBytes > mFreeBytesInChunk) {
+                mAllocPtr = mem + bytes;
+                mFreeBytesInChunk = freeBytes;
+            }
         } else {
             /*
              * Here we intentionally waste some space in the current chunk.
@@ -119,23 +125,29 @@ private:
             if (mChunkSize < mChunkSizeLimit) {
                 mChunkSize *= 2;
             }
-            mem = new uint8_t[mChunkSize];
-            mAllocatedChunks.push_back(mem);
+            mem = AllocateChunk(mChunkSize);
             mAllocPtr = mem + bytes;
-            mFreeBytesInChunk = mChunkSize - bytes;
-            mAllocated += mChunkSize;
+            mFreeBytesInChunk = mAllocatedChunks.back().second - bytes;
         }
 
         mUsed += bytes;
         return mem;
     }
 
+    uint8_t* AllocateChunk(uint32_t bytes) {
+        size_t capacity = 0;
+        uint8_t* chunk = ChunkPool::GetInstance()->Allocate(bytes, capacity);
+        mAllocatedChunks.emplace_back(chunk, static_cast<uint32_t>(capacity));
+        mAllocated += capacity;
+        return chunk;
+    }
+
 private:
     uint32_t mFirstChunkSize = 4096;
     uint32_t mChunkSizeLimit = 1024 * 128;
 
-    // The allocated memory chunks
-    std::vector<uint8_t*> mAllocatedChunks;
+    // The allocated memory chunks and their capacities
+    std::vector<std::pair<uint8_t*, uint32_t>> mAllocatedChunks;
     // Statistics data
     uint64_t mAllocated = 0;
     uint64_t mUsed = 0;
@@ -171,8 +183,13 @@ public:
     StringBuffer CopyString(const std::string& s) { return CopyString(s.data(), s.length()); }
     StringBuffer CopyString(StringView s) { return CopyString(s.data(), s.length()); }
 
+    // Keeps memory not allocated by this buffer alive as long as this buffer, so that it can be referenced by
+    // events without being copied.
+    void AddExternalBuffer(std::shared_ptr<const void> buffer) { mExternalBuffers.emplace_back(std::move(buffer)); }
+
 private:
     BufferAllocator mAllocator;
+    std::vector<std::shared_ptr<const void>> mExternalBuffers;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class LogEventUnittest;
@@ -25,6 +25,11 @@ using namespace std;
 namespace logtail {
 
 bool LoadConfigDetailFromFile(const filesystem::path& filepath, Json::Value& detail) {
+    string content;
+    return ReadConfigFile(filepath, content) && ParseConfigFile(filepath, content, detail);
+}
+
+bool ReadConfigFile(const filesystem::path& filepath, string& content) {
     const string& ext = filepath.extension().string();
     const string& configName = filepath.stem().string();
     if (configName == REGION_CONFIG || configName == READABLE_REGION_CONFIG) {
@@ -34,7 +39,6 @@ bool LoadConfigDetailFromFile(const filesystem::path& filepath, Json::Value& det
         LOG_WARNING(sLogger, ("unsupported config file format", "skip current object")("filepath", filepath));
         return false;
     }
-    string content;
     if (!ReadFile(filepath.string(), content)) {
         LOG_WARNING(sLogger, ("failed to open config file", "skip current object")("filepath", filepath));
         return false;
@@ -43,8 +47,12 @@ bool LoadConfigDetailFromFile(const filesystem::path& filepath, Json::Value& det
         LOG_WARNING(sLogger, ("empty config file", "skip current object")("filepath", filepath));
         return false;
     }
+    return true;
+}
+
+bool ParseConfigFile(const filesystem::path& filepath, const string& content, Json::Value& detail) {
     string errorMsg;
-    if (!ParseConfigDetail(content, ext, detail, errorMsg)) {
+    if (!ParseConfigDetail(content, filepath.extension().string(), detail, errorMsg)) {
         LOG_WARNING(sLogger,
                     ("config file format error", "skip current object")("error msg", errorMsg)("filepath", filepath));
         return false;
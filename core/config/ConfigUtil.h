@@ -26,6 +26,9 @@ namespace logtail {
 enum class ConfigType { Collection, Task };
 
 bool LoadConfigDetailFromFile(const std::filesystem::path& filepath, Json::Value& detail);
+// LoadConfigDetailFromFile split in two, so that the content can be checked before being parsed
+bool ReadConfigFile(const std::filesystem::path& filepath, std::string& content);
+bool ParseConfigFile(const std::filesystem::path& filepath, const std::string& content, Json::Value& detail);
 bool ParseConfigDetail(const std::string& content,
                        const std::string& extension,
                        Json::Value& detail,
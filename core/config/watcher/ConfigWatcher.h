@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <filesystem>
 #include <map>
 #include <mutex>
@@ -25,6 +27,18 @@
 
 namespace logtail {
 
+struct ConfigFileInfo {
+    ConfigFileInfo() = default;
+    ConfigFileInfo(uintmax_t size, std::filesystem::file_time_type mTime) : mSize(size), mMTime(mTime) {}
+
+    uintmax_t mSize = 0;
+    std::filesystem::file_time_type mMTime;
+    // files whose mtime changes without any change in content are not parsed again
+    int64_t mContentHash = 0;
+    // current content cannot make a valid config, so it is not parsed again until the content changes
+    bool mIsInvalid = false;
+};
+
 class ConfigWatcher {
 public:
     ConfigWatcher(const ConfigWatcher&) = delete;
@@ -42,8 +56,12 @@ protected:
 
     std::vector<std::filesystem::path> mSourceDir;
     std::map<std::string, std::mutex*> mDirMutexMap;
-    std::map<std::string, std::pair<uintmax_t, std::filesystem::file_time_type>> mFileInfoMap;
+    std::map<std::string, ConfigFileInfo> mFileInfoMap;
     std::map<std::string, std::string> mInnerConfigMap;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ConfigWatcherUnittest;
+#endif
 };
 
 } // namespace logtail
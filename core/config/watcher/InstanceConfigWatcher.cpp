@@ -83,7 +83,7 @@ InstanceConfigDiff InstanceConfigWatcher::CheckConfigDiff() {
             uintmax_t size = filesystem::file_size(path, ec);
             filesystem::file_time_type mTime = filesystem::last_write_time(path, ec);
             if (iter == mFileInfoMap.end()) {
-                mFileInfoMap[filepath] = make_pair(size, mTime);
+                mFileInfoMap[filepath] = ConfigFileInfo(size, mTime);
                 Json::Value detail;
                 if (!LoadConfigDetailFromFile(path, detail)) {
                     continue;
@@ -97,9 +97,9 @@ InstanceConfigDiff InstanceConfigWatcher::CheckConfigDiff() {
                 LOG_INFO(sLogger,
                          ("new config found and passed topology check", "prepare to load instanceConfig")("config",
                                                                                                           configName));
-            } else if (iter->second.first != size || iter->second.second != mTime) {
+            } else if (iter->second.mSize != size || iter->second.mMTime != mTime) {
                 // for config currently running, we leave it untouched if new config is invalid
-                mFileInfoMap[filepath] = make_pair(size, mTime);
+                mFileInfoMap[filepath] = ConfigFileInfo(size, mTime);
                 Json::Value detail;
                 if (!LoadConfigDetailFromFile(path, detail)) {
                     continue;
@@ -18,6 +18,7 @@
 
 #include "collection_pipeline/CollectionPipelineManager.h"
 #include "common/FileSystemUtil.h"
+#include "common/HashUtil.h"
 #include "config/ConfigUtil.h"
 #include "config/common_provider/CommonConfigProvider.h"
 #include "config/feedbacker/ConfigFeedbackReceiver.h"
@@ -238,23 +239,47 @@ void PipelineConfigWatcher::InsertPipelines(CollectionConfigDiff& pDiff,
             uintmax_t size = filesystem::file_size(path, ec);
             filesystem::file_time_type mTime = filesystem::last_write_time(path, ec);
             if (iter == mFileInfoMap.end()) {
-                mFileInfoMap[filepath] = make_pair(size, mTime);
+                ConfigFileInfo& fileInfo = mFileInfoMap[filepath] = ConfigFileInfo(size, mTime);
+                string content;
+                if (!ReadConfigFile(path, content)) {
+                    continue;
+                }
+                fileInfo.mContentHash = HashString(content);
                 unique_ptr<Json::Value> detail = make_unique<Json::Value>();
-                if (!LoadConfigDetailFromFile(path, *detail)) {
+                if (!ParseConfigFile(path, content, *detail)) {
+                    fileInfo.mIsInvalid = true;
                     continue;
                 }
                 if (!IsConfigEnabled(configName, *detail)) {
+                    fileInfo.mIsInvalid = true;
                     LOG_INFO(sLogger, ("new config found and disabled", "skip current object")("config", configName));
                     continue;
                 }
                 if (!CheckAddedConfig(configName, path, std::move(detail), pDiff, tDiff, singletonCache)) {
+                    fileInfo.mIsInvalid = true;
                     continue;
                 }
-            } else if (iter->second.first != size || iter->second.second != mTime) {
+            } else if (iter->second.mSize != size || iter->second.mMTime != mTime) {
                 // for config currently running, we leave it untouched if new config is invalid
-                mFileInfoMap[filepath] = make_pair(size, mTime);
+                ConfigFileInfo& fileInfo = iter->second;
+                fileInfo.mSize = size;
+                fileInfo.mMTime = mTime;
+                string content;
+                if (!ReadConfigFile(path, content)) {
+                    continue;
+                }
+                int64_t contentHash = HashString(content);
+                if (fileInfo.mContentHash == contentHash) {
+                    LOG_DEBUG(sLogger,
+                              ("config file modified, but content unchanged", "skip parsing")("config", configName));
+                    CheckUnchangedConfig(configName, path, fileInfo, pDiff, singletonCache);
+                    continue;
+                }
+                fileInfo.mContentHash = contentHash;
+                fileInfo.mIsInvalid = false;
                 unique_ptr<Json::Value> detail = make_unique<Json::Value>();
-                if (!LoadConfigDetailFromFile(path, *detail)) {
+                if (!ParseConfigFile(path, content, *detail)) {
+                    fileInfo.mIsInvalid = true;
                     continue;
                 }
                 if (!IsConfigEnabled(configName, *detail)) {
@@ -284,14 +309,16 @@ void PipelineConfigWatcher::InsertPipelines(CollectionConfigDiff& pDiff,
                             }
                             break;
                     }
+                    fileInfo.mIsInvalid = true;
                     continue;
                 }
                 if (!CheckModifiedConfig(configName, path, std::move(detail), pDiff, tDiff, singletonCache)) {
+                    fileInfo.mIsInvalid = true;
                     continue;
                 }
             } else {
                 // check unchanged config just for singleton input
-                CheckUnchangedConfig(configName, path, pDiff, singletonCache);
+                CheckUnchangedConfig(configName, path, iter->second, pDiff, singletonCache);
             }
         }
     }
@@ -438,6 +465,7 @@ bool PipelineConfigWatcher::CheckModifiedConfig(const string& configName,
 
 bool PipelineConfigWatcher::CheckUnchangedConfig(const string& configName,
                                                  const filesystem::path& filepath,
+                                                 ConfigFileInfo& fileInfo,
                                                  CollectionConfigDiff& pDiff,
                                                  SingletonConfigCache& singletonCache) {
     if (mTaskPipelineManager->FindPipelineByName(configName)) {
@@ -454,17 +482,24 @@ bool PipelineConfigWatcher::CheckUnchangedConfig(const string& configName,
         PushPipelineConfig(std::move(config), ConfigDiffEnum::AppliedUnchanged, pDiff, singletonCache);
     } else {
         // low priority singleton input in last config update, sort it again
+        if (fileInfo.mIsInvalid) {
+            LOG_DEBUG(sLogger, ("existing invalid config file unchanged", "skip current object")("config", configName));
+            return false;
+        }
         unique_ptr<Json::Value> detail = make_unique<Json::Value>();
         if (!LoadConfigDetailFromFile(filepath, *detail)) {
+            fileInfo.mIsInvalid = true;
             return false;
         }
         if (!IsConfigEnabled(configName, *detail)) {
+            fileInfo.mIsInvalid = true;
             LOG_DEBUG(sLogger,
                       ("existing disabled config file unchanged", "skip current object")("config", configName));
             return false;
         }
         CollectionConfig config(configName, std::move(detail), filepath);
         if (!config.Parse()) {
+            fileInfo.mIsInvalid = true;
             LOG_DEBUG(sLogger, ("existing invalid config file unchanged", "skip current object")("config", configName));
             return false;
         }
@@ -83,6 +83,7 @@ private:
                              SingletonConfigCache& singletonCache);
     bool CheckUnchangedConfig(const std::string& configName,
                               const std::filesystem::path& filepath,
+                              ConfigFileInfo& fileInfo,
                               CollectionConfigDiff& pDiff,
                               SingletonConfigCache& singletonCache);
     void PushPipelineConfig(CollectionConfig&& config,
@@ -258,9 +258,9 @@ void ContainerManager::sendMatchedContainerInfo(std::vector<std::shared_ptr<Matc
         logEventPtr->SetContent("flusher.target_addresses", itr->FlusherTargetAddress);
     }
     if (pipelineEventGroup.GetEvents().size() > 0) {
-        ProcessorRunner::GetInstance()->PushQueue(mMatchedContainerInfoPipelineCtx->GetProcessQueueKey(),
-                                                  mMatchedContainerInfoInputIndex,
-                                                  std::move(pipelineEventGroup));
+        ProcessorRunner::GetInstance()->TryPushQueue(mMatchedContainerInfoPipelineCtx->GetProcessQueueKey(),
+                                                     mMatchedContainerInfoInputIndex,
+                                                     std::move(pipelineEventGroup));
     }
 }
 
@@ -164,188 +164,175 @@ NetworkObserverManager::NetworkObserverManager(const std::shared_ptr<ProcessCach
                                                moodycamel::BlockingConcurrentQueue<std::shared_ptr<CommonEvent>>& queue,
                                                EventPool* pool)
     : AbstractManager(processCacheManager, eBPFAdapter, queue, pool),
-      mAppAggregator(
-          10240,
-          [](std::unique_ptr<AppMetricData>& base, L7Record* other) {
-              if (base == nullptr) {
-                  return;
-              }
-              int statusCode = other->GetStatusCode();
-              if (statusCode >= 500) {
-                  base->m5xxCount += 1;
-              } else if (statusCode >= 400) {
-                  base->m4xxCount += 1;
-              } else if (statusCode >= 300) {
-                  base->m3xxCount += 1;
-              } else {
-                  base->m2xxCount += 1;
-              }
-              base->mCount++;
-              base->mErrCount += other->IsError();
-              base->mSlowCount += other->IsSlow();
-              base->mSum += other->GetLatencySeconds();
-          },
-          [this](L7Record* in, std::shared_ptr<SourceBuffer>& sourceBuffer) -> std::unique_ptr<AppMetricData> {
-              auto spanName = sourceBuffer->CopyString(in->GetConvSpanName());
-              auto connection = in->GetConnection();
-              if (!connection) {
-                  LOG_WARNING(sLogger, ("connection is null", ""));
-                  return nullptr;
-              }
-              auto data
-                  = std::make_unique<AppMetricData>(connection, sourceBuffer, StringView(spanName.data, spanName.size));
-
-              const auto& ctAttrs = connection->GetConnTrackerAttrs();
-              {
-                  auto appConfig = getAppConfigFromReplica(connection); // build func is called by poller thread ...
-                  if (appConfig == nullptr) {
-                      return nullptr;
-                  }
-                  auto host = sourceBuffer->CopyString(ctAttrs.Get<kHostNameIndex>());
-                  data->mTags.SetNoCopy<kHostName>(StringView(host.data, host.size));
-
-                  auto ip = sourceBuffer->CopyString(ctAttrs.Get<kIp>());
-                  data->mTags.SetNoCopy<kIp>(StringView(ip.data, ip.size));
-
-                  auto appId = sourceBuffer->CopyString(appConfig->mAppId);
-                  data->mTags.SetNoCopy<kAppId>(StringView(appId.data, appId.size));
-
-                  auto appName = sourceBuffer->CopyString(appConfig->mAppName);
-                  data->mTags.SetNoCopy<kAppName>(StringView(appName.data, appName.size));
-
-                  auto workspace = sourceBuffer->CopyString(appConfig->mWorkspace);
-                  data->mTags.SetNoCopy<kAppName>(StringView(workspace.data, workspace.size));
-
-                  auto serviceId = sourceBuffer->CopyString(appConfig->mServiceId);
-                  data->mTags.SetNoCopy<kArmsServiceId>(StringView(serviceId.data, serviceId.size));
-
-                  auto language = sourceBuffer->CopyString(appConfig->mLanguage);
-                  data->mTags.SetNoCopy<kLanguage>(StringView(language.data, language.size));
-              }
-
-              auto workloadKind = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadKind>());
-              data->mTags.SetNoCopy<kWorkloadKind>(StringView(workloadKind.data, workloadKind.size));
-
-              auto workloadName = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadName>());
-              data->mTags.SetNoCopy<kWorkloadName>(StringView(workloadName.data, workloadName.size));
-
-              auto mRpcType = sourceBuffer->CopyString(ctAttrs.Get<kRpcType>());
-              data->mTags.SetNoCopy<kRpcType>(StringView(mRpcType.data, mRpcType.size));
-
-              auto mCallType = sourceBuffer->CopyString(ctAttrs.Get<kCallType>());
-              data->mTags.SetNoCopy<kCallType>(StringView(mCallType.data, mCallType.size));
-
-              auto mCallKind = sourceBuffer->CopyString(ctAttrs.Get<kCallKind>());
-              data->mTags.SetNoCopy<kCallKind>(StringView(mCallKind.data, mCallKind.size));
-
-              auto mDestId = sourceBuffer->CopyString(ctAttrs.Get<kDestId>());
-              data->mTags.SetNoCopy<kDestId>(StringView(mDestId.data, mDestId.size));
-
-              auto ns = sourceBuffer->CopyString(ctAttrs.Get<kNamespace>());
-              data->mTags.SetNoCopy<kNamespace>(StringView(ns.data, ns.size));
-              return data;
-          }),
-      mNetAggregator(
-          10240,
-          [](std::unique_ptr<NetMetricData>& base, ConnStatsRecord* other) {
-              if (base == nullptr) {
-                  return;
-              }
-              base->mDropCount += other->mDropCount;
-              base->mRetransCount += other->mRetransCount;
-              base->mRecvBytes += other->mRecvBytes;
-              base->mSendBytes += other->mSendBytes;
-              base->mRecvPkts += other->mRecvPackets;
-              base->mSendPkts += other->mSendPackets;
-              base->mRtt += other->mRtt;
-              base->mRttCount++;
-              if (other->mState > 1 && other->mState < LC_TCP_MAX_STATES) {
-                  base->mStateCounts[other->mState]++;
-              } else {
-                  base->mStateCounts[0]++;
-              }
-          },
-          [this](ConnStatsRecord* in, std::shared_ptr<SourceBuffer>& sourceBuffer) -> std::unique_ptr<NetMetricData> {
-              auto connection = in->GetConnection();
-              if (!connection) {
-                  LOG_WARNING(sLogger, ("connection is null", ""));
-                  return nullptr;
-              }
-              auto appConfig = getAppConfigFromReplica(connection); // build func is called by poller thread ...
-              if (appConfig == nullptr) {
-                  LOG_WARNING(sLogger, ("appConfig is null", ""));
-                  return nullptr;
-              }
-              auto data = std::make_unique<NetMetricData>(connection, sourceBuffer);
-              const auto& ctAttrs = connection->GetConnTrackerAttrs();
-
-              {
-                  auto appId = sourceBuffer->CopyString(appConfig->mAppId);
-                  data->mTags.SetNoCopy<kAppId>(StringView(appId.data, appId.size));
-
-                  auto appName = sourceBuffer->CopyString(appConfig->mAppName);
-                  data->mTags.SetNoCopy<kAppName>(StringView(appName.data, appName.size));
-
-                  auto serviceId = sourceBuffer->CopyString(appConfig->mServiceId);
-                  data->mTags.SetNoCopy<kArmsServiceId>(StringView(serviceId.data, serviceId.size));
-
-                  auto workspace = sourceBuffer->CopyString(appConfig->mWorkspace);
-                  data->mTags.SetNoCopy<kWorkspace>(StringView(workspace.data, workspace.size));
-
-                  auto host = sourceBuffer->CopyString(ctAttrs.Get<kHostNameIndex>());
-                  data->mTags.SetNoCopy<kHostName>(StringView(host.data, host.size));
-
-                  auto ip = sourceBuffer->CopyString(ctAttrs.Get<kIp>());
-                  data->mTags.SetNoCopy<kIp>(StringView(ip.data, ip.size));
-              }
-
-              auto wk = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadKind>());
-              data->mTags.SetNoCopy<kWorkloadKind>(StringView(wk.data, wk.size));
-
-              auto wn = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadName>());
-              data->mTags.SetNoCopy<kWorkloadName>(StringView(wn.data, wn.size));
-
-              auto ns = sourceBuffer->CopyString(ctAttrs.Get<kNamespace>());
-              data->mTags.SetNoCopy<kNamespace>(StringView(ns.data, ns.size));
-
-              auto pn = sourceBuffer->CopyString(ctAttrs.Get<kPodName>());
-              data->mTags.SetNoCopy<kPodName>(StringView(pn.data, pn.size));
-
-              auto pwk = sourceBuffer->CopyString(ctAttrs.Get<kPeerWorkloadKind>());
-              data->mTags.SetNoCopy<kPeerWorkloadKind>(StringView(pwk.data, pwk.size));
-
-              auto pwn = sourceBuffer->CopyString(ctAttrs.Get<kPeerWorkloadName>());
-              data->mTags.SetNoCopy<kPeerWorkloadName>(StringView(pwn.data, pwn.size));
-
-              auto pns = sourceBuffer->CopyString(ctAttrs.Get<kPeerNamespace>());
-              data->mTags.SetNoCopy<kPeerNamespace>(StringView(pns.data, pns.size));
-
-              auto ppn = sourceBuffer->CopyString(ctAttrs.Get<kPeerPodName>());
-              data->mTags.SetNoCopy<kPeerPodName>(StringView(ppn.data, ppn.size));
-              return data;
-          }),
-      mSpanAggregator(
-          4096,
-          [](std::unique_ptr<AppSpanGroup>& base, const std::shared_ptr<CommonEvent>& other) {
-              if (base == nullptr) {
-                  return;
-              }
-              base->mRecords.push_back(other);
-          },
-          [](const std::shared_ptr<CommonEvent>&, std::shared_ptr<SourceBuffer>&) {
-              return std::make_unique<AppSpanGroup>();
-          }),
-      mLogAggregator(
-          4096,
-          [](std::unique_ptr<AppLogGroup>& base, const std::shared_ptr<CommonEvent>& other) {
-              if (base == nullptr) {
-                  return;
-              }
-              base->mRecords.push_back(other);
-          },
-          [](const std::shared_ptr<CommonEvent>&, std::shared_ptr<SourceBuffer>&) {
-              return std::make_unique<AppLogGroup>();
-          }) {
+      mAppAggregator(10240, AppMetricAggregateFunc(), AppMetricBuildFunc{this}),
+      mNetAggregator(10240, NetMetricAggregateFunc(), NetMetricBuildFunc{this}),
+      mSpanAggregator(4096),
+      mLogAggregator(4096) {
+}
+
+void NetworkObserverManager::AppMetricAggregateFunc::operator()(std::unique_ptr<AppMetricData>& base,
+                                                                L7Record* other) const {
+    if (base == nullptr) {
+        return;
+    }
+    int statusCode = other->GetStatusCode();
+    if (statusCode >= 500) {
+        base->m5xxCount += 1;
+    } else if (statusCode >= 400) {
+        base->m4xxCount += 1;
+    } else if (statusCode >= 300) {
+        base->m3xxCount += 1;
+    } else {
+        base->m2xxCount += 1;
+    }
+    base->mCount++;
+    base->mErrCount += other->IsError();
+    base->mSlowCount += other->IsSlow();
+    base->mSum += other->GetLatencySeconds();
+}
+
+std::unique_ptr<AppMetricData>
+NetworkObserverManager::AppMetricBuildFunc::operator()(L7Record* in,
+                                                       std::shared_ptr<SourceBuffer>& sourceBuffer) const {
+    auto spanName = sourceBuffer->CopyString(in->GetConvSpanName());
+    auto connection = in->GetConnection();
+    if (!connection) {
+        LOG_WARNING(sLogger, ("connection is null", ""));
+        return nullptr;
+    }
+    auto data = std::make_unique<AppMetricData>(connection, sourceBuffer, StringView(spanName.data, spanName.size));
+
+    const auto& ctAttrs = connection->GetConnTrackerAttrs();
+    {
+        auto appConfig = mManager->getAppConfigFromReplica(connection); // build func is called by poller thread ...
+        if (appConfig == nullptr) {
+            return nullptr;
+        }
+        auto host = sourceBuffer->CopyString(ctAttrs.Get<kHostNameIndex>());
+        data->mTags.SetNoCopy<kHostName>(StringView(host.data, host.size));
+
+        auto ip = sourceBuffer->CopyString(ctAttrs.Get<kIp>());
+        data->mTags.SetNoCopy<kIp>(StringView(ip.data, ip.size));
+
+        auto appId = sourceBuffer->CopyString(appConfig->mAppId);
+        data->mTags.SetNoCopy<kAppId>(StringView(appId.data, appId.size));
+
+        auto appName = sourceBuffer->CopyString(appConfig->mAppName);
+        data->mTags.SetNoCopy<kAppName>(StringView(appName.data, appName.size));
+
+        auto workspace = sourceBuffer->CopyString(appConfig->mWorkspace);
+        data->mTags.SetNoCopy<kAppName>(StringView(workspace.data, workspace.size));
+
+        auto serviceId = sourceBuffer->CopyString(appConfig->mServiceId);
+        data->mTags.SetNoCopy<kArmsServiceId>(StringView(serviceId.data, serviceId.size));
+
+        auto language = sourceBuffer->CopyString(appConfig->mLanguage);
+        data->mTags.SetNoCopy<kLanguage>(StringView(language.data, language.size));
+    }
+
+    auto workloadKind = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadKind>());
+    data->mTags.SetNoCopy<kWorkloadKind>(StringView(workloadKind.data, workloadKind.size));
+
+    auto workloadName = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadName>());
+    data->mTags.SetNoCopy<kWorkloadName>(StringView(workloadName.data, workloadName.size));
+
+    auto mRpcType = sourceBuffer->CopyString(ctAttrs.Get<kRpcType>());
+    data->mTags.SetNoCopy<kRpcType>(StringView(mRpcType.data, mRpcType.size));
+
+    auto mCallType = sourceBuffer->CopyString(ctAttrs.Get<kCallType>());
+    data->mTags.SetNoCopy<kCallType>(StringView(mCallType.data, mCallType.size));
+
+    auto mCallKind = sourceBuffer->CopyString(ctAttrs.Get<kCallKind>());
+    data->mTags.SetNoCopy<kCallKind>(StringView(mCallKind.data, mCallKind.size));
+
+    auto mDestId = sourceBuffer->CopyString(ctAttrs.Get<kDestId>());
+    data->mTags.SetNoCopy<kDestId>(StringView(mDestId.data, mDestId.size));
+
+    auto ns = sourceBuffer->CopyString(ctAttrs.Get<kNamespace>());
+    data->mTags.SetNoCopy<kNamespace>(StringView(ns.data, ns.size));
+    return data;
+}
+
+void NetworkObserverManager::NetMetricAggregateFunc::operator()(std::unique_ptr<NetMetricData>& base,
+                                                                ConnStatsRecord* other) const {
+    if (base == nullptr) {
+        return;
+    }
+    base->mDropCount += other->mDropCount;
+    base->mRetransCount += other->mRetransCount;
+    base->mRecvBytes += other->mRecvBytes;
+    base->mSendBytes += other->mSendBytes;
+    base->mRecvPkts += other->mRecvPackets;
+    base->mSendPkts += other->mSendPackets;
+    base->mRtt += other->mRtt;
+    base->mRttCount++;
+    if (other->mState > 1 && other->mState < LC_TCP_MAX_STATES) {
+        base->mStateCounts[other->mState]++;
+    } else {
+        base->mStateCounts[0]++;
+    }
+}
+
+std::unique_ptr<NetMetricData>
+NetworkObserverManager::NetMetricBuildFunc::operator()(ConnStatsRecord* in,
+                                                       std::shared_ptr<SourceBuffer>& sourceBuffer) const {
+    auto connection = in->GetConnection();
+    if (!connection) {
+        LOG_WARNING(sLogger, ("connection is null", ""));
+        return nullptr;
+    }
+    auto appConfig = mManager->getAppConfigFromReplica(connection); // build func is called by poller thread ...
+    if (appConfig == nullptr) {
+        LOG_WARNING(sLogger, ("appConfig is null", ""));
+        return nullptr;
+    }
+    auto data = std::make_unique<NetMetricData>(connection, sourceBuffer);
+    const auto& ctAttrs = connection->GetConnTrackerAttrs();
+
+    {
+        auto appId = sourceBuffer->CopyString(appConfig->mAppId);
+        data->mTags.SetNoCopy<kAppId>(StringView(appId.data, appId.size));
+
+        auto appName = sourceBuffer->CopyString(appConfig->mAppName);
+        data->mTags.SetNoCopy<kAppName>(StringView(appName.data, appName.size));
+
+        auto serviceId = sourceBuffer->CopyString(appConfig->mServiceId);
+        data->mTags.SetNoCopy<kArmsServiceId>(StringView(serviceId.data, serviceId.size));
+
+        auto workspace = sourceBuffer->CopyString(appConfig->mWorkspace);
+        data->mTags.SetNoCopy<kWorkspace>(StringView(workspace.data, workspace.size));
+
+        auto host = sourceBuffer->CopyString(ctAttrs.Get<kHostNameIndex>());
+        data->mTags.SetNoCopy<kHostName>(StringView(host.data, host.size));
+
+        auto ip = sourceBuffer->CopyString(ctAttrs.Get<kIp>());
+        data->mTags.SetNoCopy<kIp>(StringView(ip.data, ip.size));
+    }
+
+    auto wk = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadKind>());
+    data->mTags.SetNoCopy<kWorkloadKind>(StringView(wk.data, wk.size));
+
+    auto wn = sourceBuffer->CopyString(ctAttrs.Get<kWorkloadName>());
+    data->mTags.SetNoCopy<kWorkloadName>(StringView(wn.data, wn.size));
+
+    auto ns = sourceBuffer->CopyString(ctAttrs.Get<kNamespace>());
+    data->mTags.SetNoCopy<kNamespace>(StringView(ns.data, ns.size));
+
+    auto pn = sourceBuffer->CopyString(ctAttrs.Get<kPodName>());
+    data->mTags.SetNoCopy<kPodName>(StringView(pn.data, pn.size));
+
+    auto pwk = sourceBuffer->CopyString(ctAttrs.Get<kPeerWorkloadKind>());
+    data->mTags.SetNoCopy<kPeerWorkloadKind>(StringView(pwk.data, pwk.size));
+
+    auto pwn = sourceBuffer->CopyString(ctAttrs.Get<kPeerWorkloadName>());
+    data->mTags.SetNoCopy<kPeerWorkloadName>(StringView(pwn.data, pwn.size));
+
+    auto pns = sourceBuffer->CopyString(ctAttrs.Get<kPeerNamespace>());
+    data->mTags.SetNoCopy<kPeerNamespace>(StringView(pns.data, pns.size));
+
+    auto ppn = sourceBuffer->CopyString(ctAttrs.Get<kPeerPodName>());
+    data->mTags.SetNoCopy<kPeerPodName>(StringView(ppn.data, ppn.size));
+    return data;
 }
 
 std::array<size_t, 2>
@@ -511,10 +498,10 @@ bool NetworkObserverManager::ConsumeLogAggregateTree() { // handler
 #endif
 
     auto aggTree = mLogAggregator.GetAndReset();
-    auto nodes = aggTree.GetNodesWithAggDepth(1);
-    LOG_DEBUG(sLogger, ("enter log aggregator ...", nodes.size())("node size", aggTree.NodeCount()));
+    auto& nodes = aggTree->Groups();
+    LOG_DEBUG(sLogger, ("enter log aggregator ...", nodes.size())("node size", aggTree->NodeCount()));
     if (nodes.empty()) {
-        LOG_DEBUG(sLogger, ("empty nodes...", "")("node size", aggTree.NodeCount()));
+        LOG_DEBUG(sLogger, ("empty nodes...", "")("node size", aggTree->NodeCount()));
         return true;
     }
 
@@ -530,7 +517,7 @@ bool NetworkObserverManager::ConsumeLogAggregateTree() { // handler
         StringView configName;
         CounterPtr pushLogsTotal = nullptr;
         CounterPtr pushLogGroupTotal = nullptr;
-        aggTree.ForEach(node, [&](const AppLogGroup* group) {
+        aggTree->ForEach(node, [&](const AppLogGroup* group) {
             // set process tag
             if (group->mRecords.empty()) {
                 LOG_DEBUG(sLogger, ("", "no records .."));
@@ -638,10 +625,10 @@ bool NetworkObserverManager::ConsumeNetMetricAggregateTree() { // handler
 
     auto aggTree = mNetAggregator.GetAndReset();
 
-    auto nodes = aggTree.GetNodesWithAggDepth(1);
-    LOG_DEBUG(sLogger, ("enter net aggregator ...", nodes.size())("node size", aggTree.NodeCount()));
+    auto& nodes = aggTree->Groups();
+    LOG_DEBUG(sLogger, ("enter net aggregator ...", nodes.size())("node size", aggTree->NodeCount()));
     if (nodes.empty()) {
-        LOG_DEBUG(sLogger, ("empty nodes...", "")("node size", aggTree.NodeCount()));
+        LOG_DEBUG(sLogger, ("empty nodes...", "")("node size", aggTree->NodeCount()));
         return true;
     }
 
@@ -650,12 +637,12 @@ bool NetworkObserverManager::ConsumeNetMetricAggregateTree() { // handler
     auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration).count();
 
     for (auto& node : nodes) {
-        LOG_DEBUG(sLogger, ("node child size", node->mChild.size()));
+        LOG_DEBUG(sLogger, ("node child size", node.mSize));
         // convert to a item and push to process queue
         // every node represent an instance of an arms app ...
 
         // auto sourceBuffer = std::make_shared<SourceBuffer>();
-        std::shared_ptr<SourceBuffer>& sourceBuffer = node->mSourceBuffer;
+        std::shared_ptr<SourceBuffer>& sourceBuffer = node.mSourceBuffer;
         PipelineEventGroup eventGroup(sourceBuffer); // per node represent an APP ...
         eventGroup.SetTagNoCopy(kAppType.MetricKey(), kAPMValue);
         eventGroup.SetTagNoCopy(kTagTechnology, kEBPFValue);
@@ -668,7 +655,7 @@ bool NetworkObserverManager::ConsumeNetMetricAggregateTree() { // handler
         StringView configName;
         CounterPtr pushMetricsTotal = nullptr;
         CounterPtr pushMetricGroupTotal = nullptr;
-        aggTree.ForEach(node, [&](const NetMetricData* group) {
+        aggTree->ForEach(node, [&](const NetMetricData* group) {
             LOG_DEBUG(sLogger,
                       ("dump group attrs", group->ToString())("ct attrs", group->mConnection->DumpConnection()));
             if (group == nullptr || group->mConnection == nullptr) {
@@ -797,8 +784,8 @@ bool NetworkObserverManager::ConsumeMetricAggregateTree() { // handler
 
     auto aggTree = this->mAppAggregator.GetAndReset();
 
-    auto nodes = aggTree.GetNodesWithAggDepth(1);
-    LOG_DEBUG(sLogger, ("enter aggregator ...", nodes.size())("node size", aggTree.NodeCount()));
+    auto& nodes = aggTree->Groups();
+    LOG_DEBUG(sLogger, ("enter aggregator ...", nodes.size())("node size", aggTree->NodeCount()));
     if (nodes.empty()) {
         LOG_DEBUG(sLogger, ("empty nodes...", ""));
         return true;
@@ -809,11 +796,11 @@ bool NetworkObserverManager::ConsumeMetricAggregateTree() { // handler
     auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration).count();
 
     for (auto& node : nodes) {
-        LOG_DEBUG(sLogger, ("node child size", node->mChild.size()));
+        LOG_DEBUG(sLogger, ("node child size", node.mSize));
         // convert to a item and push to process queue
         // every node represent an instance of an arms app ...
         // auto sourceBuffer = std::make_shared<SourceBuffer>();
-        std::shared_ptr<SourceBuffer>& sourceBuffer = node->mSourceBuffer;
+        std::shared_ptr<SourceBuffer>& sourceBuffer = node.mSourceBuffer;
         PipelineEventGroup eventGroup(sourceBuffer); // per node represent an APP ...
         eventGroup.SetTagNoCopy(kAppType.MetricKey(), kAPMValue);
         eventGroup.SetTagNoCopy(kTagTechnology, kEBPFValue);
@@ -825,7 +812,7 @@ bool NetworkObserverManager::ConsumeMetricAggregateTree() { // handler
         StringView configName;
         CounterPtr pushMetricsTotal = nullptr;
         CounterPtr pushMetricGroupTotal = nullptr;
-        aggTree.ForEach(node, [&](const AppMetricData* group) {
+        aggTree->ForEach(node, [&](const AppMetricData* group) {
             LOG_DEBUG(sLogger,
                       ("dump group attrs", group->ToString())("ct attrs", group->mConnection->DumpConnection()));
             // instance dim
@@ -988,8 +975,8 @@ bool NetworkObserverManager::ConsumeSpanAggregateTree() { // handler
 
     auto aggTree = mSpanAggregator.GetAndReset();
 
-    auto nodes = aggTree.GetNodesWithAggDepth(1);
-    LOG_DEBUG(sLogger, ("enter aggregator ...", nodes.size())("node size", aggTree.NodeCount()));
+    auto& nodes = aggTree->Groups();
+    LOG_DEBUG(sLogger, ("enter aggregator ...", nodes.size())("node size", aggTree->NodeCount()));
     if (nodes.empty()) {
         LOG_DEBUG(sLogger, ("empty nodes...", ""));
         return true;
@@ -1006,7 +993,7 @@ bool NetworkObserverManager::ConsumeSpanAggregateTree() { // handler
         StringView configName;
         CounterPtr pushSpansTotal = nullptr;
         CounterPtr pushSpanGroupTotal = nullptr;
-        aggTree.ForEach(node, [&](const AppSpanGroup* group) {
+        aggTree->ForEach(node, [&](const AppSpanGroup* group) {
             // set process tag
             if (group->mRecords.empty()) {
                 LOG_DEBUG(sLogger, ("", "no records .."));
@@ -25,7 +25,7 @@
 #include "ebpf/plugin/network_observer/ConnectionManager.h"
 #include "ebpf/type/CommonDataEvent.h"
 #include "ebpf/type/NetworkObserverEvent.h"
-#include "ebpf/util/AggregateTree.h"
+#include "ebpf/util/FlatAggregateTree.h"
 #include "ebpf/util/Converger.h"
 #include "ebpf/util/FrequencyManager.h"
 #include "ebpf/util/sampler/Sampler.h"
@@ -200,11 +200,54 @@ private:
 
     int mCidOffset = -1;
 
+    // aggregate and build functions, passed to the aggregators as types so that they can be inlined
+    struct AppMetricAggregateFunc {
+        void operator()(std::unique_ptr<AppMetricData>& base, L7Record* other) const;
+    };
+    struct AppMetricBuildFunc {
+        NetworkObserverManager* mManager = nullptr;
+        std::unique_ptr<AppMetricData> operator()(L7Record* in, std::shared_ptr<SourceBuffer>& sourceBuffer) const;
+    };
+    struct NetMetricAggregateFunc {
+        void operator()(std::unique_ptr<NetMetricData>& base, ConnStatsRecord* other) const;
+    };
+    struct NetMetricBuildFunc {
+        NetworkObserverManager* mManager = nullptr;
+        std::unique_ptr<NetMetricData> operator()(ConnStatsRecord* in,
+                                                  std::shared_ptr<SourceBuffer>& sourceBuffer) const;
+    };
+    template <class RecordGroup>
+    struct RecordGroupAggregateFunc {
+        void operator()(std::unique_ptr<RecordGroup>& base, const std::shared_ptr<CommonEvent>& other) const {
+            if (base == nullptr) {
+                return;
+            }
+            base->mRecords.push_back(other);
+        }
+    };
+    template <class RecordGroup>
+    struct RecordGroupBuildFunc {
+        std::unique_ptr<RecordGroup> operator()(const std::shared_ptr<CommonEvent>&,
+                                                std::shared_ptr<SourceBuffer>&) const {
+            return std::make_unique<RecordGroup>();
+        }
+    };
+
     // handler thread ...
-    SIZETAggTreeWithSourceBuffer<AppMetricData, L7Record*> mAppAggregator;
-    SIZETAggTreeWithSourceBuffer<NetMetricData, ConnStatsRecord*> mNetAggregator;
-    SIZETAggTree<AppSpanGroup, std::shared_ptr<CommonEvent>> mSpanAggregator;
-    SIZETAggTree<AppLogGroup, std::shared_ptr<CommonEvent>> mLogAggregator;
+    FlatAggTree<AppMetricData, L7Record*, 2, AppMetricAggregateFunc, AppMetricBuildFunc, true> mAppAggregator;
+    FlatAggTree<NetMetricData, ConnStatsRecord*, 2, NetMetricAggregateFunc, NetMetricBuildFunc, true> mNetAggregator;
+    FlatAggTree<AppSpanGroup,
+                std::shared_ptr<CommonEvent>,
+                1,
+                RecordGroupAggregateFunc<AppSpanGroup>,
+                RecordGroupBuildFunc<AppSpanGroup>>
+        mSpanAggregator;
+    FlatAggTree<AppLogGroup,
+                std::shared_ptr<CommonEvent>,
+                1,
+                RecordGroupAggregateFunc<AppLogGroup>,
+                RecordGroupBuildFunc<AppLogGroup>>
+        mLogAggregator;
 
     void updateConfigVersionAndWhitelist(std::vector<std::pair<std::string, uint64_t>>&& newCids,
                                          std::vector<std::string>&& expiredCids) {
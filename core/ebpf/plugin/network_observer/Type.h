@@ -22,6 +22,7 @@ extern "C" {
 #include <atomic>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "collection_pipeline/queue/QueueKey.h"
@@ -206,7 +207,8 @@ struct CaseInsensitiveLess {
     }
 };
 
-using HeadersMap = std::multimap<std::string, std::string, CaseInsensitiveLess>;
+// names and values refer to the header buffers of the http record
+using HeadersMap = std::multimap<std::string_view, std::string_view, CaseInsensitiveLess>;
 
 inline enum support_proto_e& operator++(enum support_proto_e& pt) {
     pt = static_cast<enum support_proto_e>(static_cast<int>(pt) + 1);
@@ -14,9 +14,9 @@
 
 #include "HttpParser.h"
 
+#include <charconv>
 #include <map>
 
-#include "common/StringTools.h"
 #include "ebpf/type/NetworkObserverEvent.h"
 #include "ebpf/util/TraceId.h"
 #include "logger/Logger.h"
@@ -32,7 +32,7 @@ HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
                           const std::shared_ptr<Connection>& conn,
                           const std::shared_ptr<AppDetail>& appDetail,
                           const std::shared_ptr<AppConvergerManager>& converger) {
-    auto record = std::make_shared<HttpRecord>(conn, appDetail);
+    auto record = mRecordPool->Acquire(conn, appDetail);
     record->SetEndTsNs(dataEvent->end_ts);
     record->SetStartTsNs(dataEvent->start_ts);
     auto spanId = GenerateSpanID();
@@ -72,12 +72,23 @@ HTTPProtocolParser::Parse(struct conn_data_event_t* dataEvent,
 }
 
 namespace http {
-HeadersMap GetHTTPHeadersMap(const phr_header* headers, size_t numHeaders) {
+HeadersMap GetHTTPHeadersMap(const phr_header* headers, size_t numHeaders, std::string& buffer) {
     HeadersMap result;
+    if (numHeaders == 0) {
+        buffer.clear();
+        return result;
+    }
+    // headers are parsed in place, so the names and values lie in order in the same block of the data event, which is
+    // copied once instead of copying each of them. The name of a multiline header continuation is null.
+    const char* begin = headers[0].name ? headers[0].name : headers[0].value;
+    const char* end = headers[numHeaders - 1].value + headers[numHeaders - 1].value_len;
+    buffer.assign(begin, end - begin);
     for (size_t i = 0; i < numHeaders; i++) {
-        std::string name(headers[i].name, headers[i].name_len);
-        std::string value(headers[i].value, headers[i].value_len);
-        result.emplace(std::move(name), std::move(value));
+        std::string_view name;
+        if (headers[i].name) {
+            name = std::string_view(buffer.data() + (headers[i].name - begin), headers[i].name_len);
+        }
+        result.emplace(name, std::string_view(buffer.data() + (headers[i].value - begin), headers[i].value_len));
     }
     return result;
 }
@@ -95,35 +106,46 @@ int ParseHttpRequest(std::string_view& buf, HTTPRequest& result) {
                              /*last_len*/ 0);
 }
 
-const std::string kRootPath = "/";
+const std::string_view kRootPath = "/";
 const char kQuestionMark = '?';
+const std::string_view kHttp10 = "http1.0";
+const std::string_view kHttp11 = "http1.1";
 const std::string kHttP1Prefix = "http1.";
 
+static std::string_view TrimSpace(std::string_view str) {
+    auto begin = str.find_first_not_of(' ');
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    return str.substr(begin, str.find_last_not_of(' ') - begin + 1);
+}
+
 ParseState ParseRequest(std::string_view& buf, std::shared_ptr<HttpRecord>& result, bool forceSample) {
     HTTPRequest req;
     int retval = http::ParseHttpRequest(buf, req);
     if (retval >= 0) {
         buf.remove_prefix(retval);
 
-        auto orginPath = std::string(req.mPath, req.mPathLen);
-        auto trimPath = TrimString(orginPath);
-        std::size_t pos = trimPath.find(kQuestionMark);
-
-        if (trimPath.empty() || (pos != std::string::npos && pos == 0)) {
-            result->SetPath(kRootPath);
-            result->SetRealPath(kRootPath);
-        } else if (pos != std::string::npos) {
-            result->SetPath(trimPath.substr(0, pos));
-            result->SetRealPath(trimPath.substr(0, pos));
-        } else {
-            result->SetPath(trimPath);
-            result->SetRealPath(trimPath);
+        auto path = TrimSpace(std::string_view(req.mPath, req.mPathLen));
+        std::size_t pos = path.find(kQuestionMark);
+        if (path.empty() || pos == 0) {
+            path = kRootPath;
+        } else if (pos != std::string_view::npos) {
+            path = path.substr(0, pos);
         }
+        result->SetPath(path);
+        result->SetRealPath(path);
 
         if (result->ShouldSample() || forceSample) {
-            result->SetProtocolVersion(kHttP1Prefix + std::to_string(req.mMinorVersion));
-            result->SetMethod(std::string(req.mMethod, req.mMethodLen));
-            result->SetReqHeaderMap(http::GetHTTPHeadersMap(req.mHeaders, req.mNumHeaders));
+            if (req.mMinorVersion == 1) {
+                result->SetProtocolVersion(kHttp11);
+            } else if (req.mMinorVersion == 0) {
+                result->SetProtocolVersion(kHttp10);
+            } else {
+                result->SetProtocolVersion(kHttP1Prefix + std::to_string(req.mMinorVersion));
+            }
+            result->SetMethod(std::string_view(req.mMethod, req.mMethodLen));
+            result->SetReqHeaderMap(http::GetHTTPHeadersMap(req.mHeaders, req.mNumHeaders, result->mReqHeaderBuffer));
             return ParseRequestBody(buf, result);
         }
         return ParseState::kSuccess;
@@ -135,48 +157,106 @@ ParseState ParseRequest(std::string_view& buf, std::shared_ptr<HttpRecord>& resu
     return ParseState::kInvalid;
 }
 
-ParseState PicoParseChunked(std::string_view& data, size_t bodySizeLimitBytes, std::string& result, size_t& bodySize) {
-    // Make a copy of the data because phr_decode_chunked mutates the input,
-    // and if the original parse fails due to a lack of data, we need the original
-    // state to be preserved.
-    std::string dataCopy(data);
-
-    phr_chunked_decoder chunkDecoder = {};
-    chunkDecoder.consume_trailer = 1;
-    char* buf = dataCopy.data();
-    size_t bufSize = dataCopy.size();
-    ssize_t retval = phr_decode_chunked(&chunkDecoder, buf, &bufSize);
-
-    if (retval == -1) {
-        // Parse failed.
-        return ParseState::kInvalid;
+static int DecodeHex(char ch) {
+    if ('0' <= ch && ch <= '9') {
+        return ch - '0';
     }
-    if (retval == -2) {
-        // Incomplete message.
-        return ParseState::kNeedsMoreData;
+    if ('A' <= ch && ch <= 'F') {
+        return ch - 'A' + 0xa;
     }
-    if (retval >= 0) {
-        // Found a complete message.
-        dataCopy.resize(std::min(bufSize, bodySizeLimitBytes));
-        // data_copy.resize(buf_size);
-        dataCopy.shrink_to_fit();
-        result = std::move(dataCopy);
-        bodySize = bufSize;
-
-        // phr_decode_chunked rewrites the buffer in place, removing chunked-encoding headers.
-        // So we cannot simply remove the prefix, but rather have to shorten the buffer too.
-        // This is done via retval, which specifies how many unprocessed bytes are left.
-        data.remove_prefix(data.size() - retval);
-
-        return ParseState::kSuccess;
+    if ('a' <= ch && ch <= 'f') {
+        return ch - 'a' + 0xa;
     }
-
-    return ParseState::kUnknown;
+    return -1;
 }
 
-
+// Decodes the chunked body the same way as phr_decode_chunked with consume_trailer set, but without rewriting the
+// buffer, so only the first bodySizeLimitBytes bytes of the body are copied.
 ParseState ParseChunked(std::string_view& data, size_t bodySizeLimitBytes, std::string& result, size_t& bodySize) {
-    return PicoParseChunked(data, bodySizeLimitBytes, result, bodySize);
+    size_t pos = 0;
+    size_t totalSize = 0;
+    result.clear();
+    while (true) {
+        // chunk size in hex, followed by optional extensions and CRLF
+        size_t chunkSize = 0;
+        size_t hexCount = 0;
+        for (;; ++pos, ++hexCount) {
+            if (pos == data.size()) {
+                return ParseState::kNeedsMoreData;
+            }
+            int v = DecodeHex(data[pos]);
+            if (v == -1) {
+                break;
+            }
+            if (hexCount == sizeof(size_t) * 2) {
+                return ParseState::kInvalid;
+            }
+            chunkSize = chunkSize * 16 + v;
+        }
+        if (hexCount == 0) {
+            return ParseState::kInvalid;
+        }
+        switch (data[pos]) {
+            case ' ':
+            case '\t':
+            case ';':
+            case '\n':
+            case '\r':
+                break;
+            default:
+                return ParseState::kInvalid;
+        }
+        pos = data.find('\n', pos);
+        if (pos == std::string_view::npos) {
+            return ParseState::kNeedsMoreData;
+        }
+        ++pos;
+        if (chunkSize == 0) {
+            break;
+        }
+
+        // chunk data, followed by CRLF
+        if (data.size() - pos < chunkSize) {
+            return ParseState::kNeedsMoreData;
+        }
+        if (result.size() < bodySizeLimitBytes) {
+            result.append(data.data() + pos, std::min(chunkSize, bodySizeLimitBytes - result.size()));
+        }
+        totalSize += chunkSize;
+        pos += chunkSize;
+        while (pos < data.size() && data[pos] == '\r') {
+            ++pos;
+        }
+        if (pos == data.size()) {
+            return ParseState::kNeedsMoreData;
+        }
+        if (data[pos] != '\n') {
+            return ParseState::kInvalid;
+        }
+        ++pos;
+    }
+
+    // trailers, ended by an empty line
+    while (true) {
+        while (pos < data.size() && data[pos] == '\r') {
+            ++pos;
+        }
+        if (pos == data.size()) {
+            return ParseState::kNeedsMoreData;
+        }
+        if (data[pos++] == '\n') {
+            break;
+        }
+        pos = data.find('\n', pos);
+        if (pos == std::string_view::npos) {
+            return ParseState::kNeedsMoreData;
+        }
+        ++pos;
+    }
+
+    bodySize = totalSize;
+    data.remove_prefix(pos);
+    return ParseState::kSuccess;
 }
 
 ParseState ParseRequestBody(std::string_view& buf, std::shared_ptr<HttpRecord>& result) {
@@ -203,7 +283,7 @@ ParseState ParseRequestBody(std::string_view& buf, std::shared_ptr<HttpRecord>&
     // not contain a payload body and the method semantics do not anticipate such a body."
     //
     // We apply this to all methods, since we have no better strategy in other cases.
-    result->mReqBody = "";
+    result->mReqBody.clear();
     return ParseState::kSuccess;
 }
 
@@ -221,22 +301,12 @@ int ParseHttpResponse(std::string_view buf, HTTPResponse* result) {
 }
 
 bool ParseContentLength(const std::string_view& contentLenStr, size_t* len) {
-    if (len == nullptr) {
+    if (len == nullptr || contentLenStr.empty()) {
         return false;
     }
-
-    try {
-        size_t pos;
-        std::stoull(contentLenStr.data());
-        *len = std::stoull(std::string(contentLenStr), &pos);
-        if (pos != contentLenStr.size()) {
-            return false;
-        }
-    } catch (const std::exception& e) {
-        return false;
-    }
-
-    return true;
+    const char* end = contentLenStr.data() + contentLenStr.size();
+    auto res = std::from_chars(contentLenStr.data(), end, *len);
+    return res.ec == std::errc() && res.ptr == end;
 }
 
 ParseState ParseContent(std::string_view& contentLenStr,
@@ -297,7 +367,7 @@ ParseState ParseResponseBody(std::string_view& buf, std::shared_ptr<HttpRecord>&
     // The status codes below MUST not have a body, according to the spec.
     // See: https://tools.ietf.org/html/rfc2616#section-4.4
     if ((result->mCode >= 100 && result->mCode < 200) || result->mCode == 204 || result->mCode == 304) {
-        result->mRespBody = "";
+        result->mRespBody.clear();
 
         // Status 101 is an even more special case.
         if (result->mCode == 101) {
@@ -337,8 +407,9 @@ ParseState ParseResponse(std::string_view& buf, std::shared_ptr<HttpRecord>& res
         }
 
         if (result->ShouldSample() || forceSample) {
-            result->SetRespHeaderMap(http::GetHTTPHeadersMap(resp.mHeaders, resp.mNumHeaders));
-            result->SetRespMsg(std::string(resp.mMsg, resp.mMsgLen));
+            result->SetRespHeaderMap(
+                http::GetHTTPHeadersMap(resp.mHeaders, resp.mNumHeaders, result->mRespHeaderBuffer));
+            result->SetRespMsg(std::string_view(resp.mMsg, resp.mMsgLen));
             return ParseResponseBody(buf, result, closed);
         }
         return ParseState::kSuccess;
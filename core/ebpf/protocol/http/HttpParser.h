@@ -13,6 +13,7 @@
 #include "ebpf/protocol/ParserRegistry.h"
 #include "ebpf/type/NetworkObserverEvent.h"
 #include "ebpf/util/Converger.h"
+#include "ebpf/util/RecordPool.h"
 #include "ebpf/util/sampler/Sampler.h"
 #include "picohttpparser.h"
 
@@ -75,7 +76,10 @@ ParseState ParseRequest(std::string_view& buf, std::shared_ptr<HttpRecord>& resu
 
 ParseState ParseRequestBody(std::string_view& buf, std::shared_ptr<HttpRecord>& result);
 
-HeadersMap GetHTTPHeadersMap(const phr_header* headers, size_t numHeaders);
+// @buffer: where the header block is copied, which the returned map refers to
+HeadersMap GetHTTPHeadersMap(const phr_header* headers, size_t numHeaders, std::string& buffer);
+
+ParseState ParseChunked(std::string_view& data, size_t bodySizeLimitBytes, std::string& result, size_t& bodySize);
 
 ParseState ParseContent(std::string_view& contentLenStr,
                         std::string_view& data,
@@ -90,6 +94,9 @@ int ParseHttpRequest(std::string_view& buf, HTTPRequest& result);
 } // namespace http
 
 
+// records released by the consumers are kept for reuse, up to this number
+constexpr size_t kMaxPooledHttpRecords = 4096;
+
 class HTTPProtocolParser : public AbstractProtocolParser {
 public:
     std::shared_ptr<AbstractProtocolParser> Create() override { return std::make_shared<HTTPProtocolParser>(); }
@@ -98,6 +105,14 @@ public:
                                                  const std::shared_ptr<Connection>& conn,
                                                  const std::shared_ptr<AppDetail>& appDetail,
                                                  const std::shared_ptr<AppConvergerManager>& converger) override;
+
+private:
+    std::shared_ptr<RecordPool<HttpRecord>> mRecordPool
+        = std::make_shared<RecordPool<HttpRecord>>(kMaxPooledHttpRecords);
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ProtocolParserUnittest;
+#endif
 };
 
 REGISTER_PROTOCOL_PARSER(support_proto_e::ProtoHTTP, HTTPProtocolParser)
@@ -16,6 +16,7 @@
 
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "ebpf/plugin/network_observer/Connection.h"
@@ -69,6 +70,17 @@ public:
     void SetTraceId(std::array<uint64_t, 4>&& traceId) { mTraceId = traceId; }
     void SetSpanId(std::array<uint64_t, 2>&& spanId) { mSpanId = spanId; }
 
+protected:
+    void Reset(const std::shared_ptr<Connection>& conn, const std::shared_ptr<AppDetail>& appDetail) {
+        mConnection = conn;
+        mAppDetail = appDetail;
+        mStartTs = 0;
+        mEndTs = 0;
+        mSample = false;
+        mTraceId = {};
+        mSpanId = {};
+    }
+
 private:
     std::shared_ptr<Connection> mConnection;
     std::shared_ptr<AppDetail> mAppDetail;
@@ -83,6 +95,29 @@ class HttpRecord : public L7Record {
 public:
     HttpRecord(const std::shared_ptr<Connection>& conn, const std::shared_ptr<AppDetail>& appDetail)
         : L7Record(conn, appDetail) {}
+    // header maps refer to the header buffers of the record
+    HttpRecord(const HttpRecord&) = delete;
+    HttpRecord& operator=(const HttpRecord&) = delete;
+
+    // reinitializes a pooled record, the capacity of the strings is kept, see RecordPool
+    void Reset(const std::shared_ptr<Connection>& conn = nullptr,
+               const std::shared_ptr<AppDetail>& appDetail = nullptr) {
+        L7Record::Reset(conn, appDetail);
+        mCode = 0;
+        mReqBodySize = 0;
+        mRespBodySize = 0;
+        mPath.clear();
+        mRealPath.clear();
+        mReqBody.clear();
+        mRespBody.clear();
+        mHttpMethod.clear();
+        mProtocolVersion.clear();
+        mRespMsg.clear();
+        mReqHeaderMap.clear();
+        mRespHeaderMap.clear();
+        mReqHeaderBuffer.clear();
+        mRespHeaderBuffer.clear();
+    }
     [[nodiscard]] virtual bool IsError() const override { return mCode >= 400; }
     [[nodiscard]] virtual bool IsSlow() const override { return GetLatencyMs() >= 500; }
     void SetStatusCode(int code) { mCode = code; }
@@ -103,17 +138,17 @@ public:
     void SetReqHeaderMap(HeadersMap&& headerMap) { mReqHeaderMap = std::move(headerMap); }
     void SetRespHeaderMap(HeadersMap&& headerMap) { mRespHeaderMap = std::move(headerMap); }
 
-    void SetProtocolVersion(const std::string& version) { mProtocolVersion = version; }
+    void SetProtocolVersion(std::string_view version) { mProtocolVersion.assign(version); }
     const std::string& GetProtocolVersion() const { return mProtocolVersion; }
     const std::string& GetPath() const { return mPath; }
     const std::string& GetRealPath() const { return mRealPath; }
-    void SetPath(const std::string& path) { mPath = path; }
-    void SetRealPath(const std::string& path) { mRealPath = path; }
+    void SetPath(std::string_view path) { mPath.assign(path); }
+    void SetRealPath(std::string_view path) { mRealPath.assign(path); }
 
-    void SetReqBody(const std::string& body) { mReqBody = body; }
-    void SetRespBody(const std::string& body) { mRespBody = body; }
-    void SetRespMsg(std::string&& msg) { mRespMsg = std::move(msg); }
-    void SetMethod(const std::string& method) { mHttpMethod = method; }
+    void SetReqBody(std::string_view body) { mReqBody.assign(body); }
+    void SetRespBody(std::string_view body) { mRespBody.assign(body); }
+    void SetRespMsg(std::string_view msg) { mRespMsg.assign(msg); }
+    void SetMethod(std::string_view method) { mHttpMethod.assign(method); }
 
     // private:
     int mCode = 0;
@@ -128,6 +163,9 @@ public:
     std::string mRespMsg;
     HeadersMap mReqHeaderMap;
     HeadersMap mRespHeaderMap;
+    // the header block copied from the data event, which is reused by the poller once the event is parsed
+    std::string mReqHeaderBuffer;
+    std::string mRespHeaderBuffer;
 };
 
 class ConnStatsRecord : public CommonEvent {
@@ -0,0 +1,250 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/HashUtil.h"
+#include "common/memory/SourceBuffer.h"
+#include "logger/Logger.h"
+
+namespace logtail {
+
+/**
+ * Aggregates values by a fixed number of precomputed keys, like AggTree, but without a map per tree level. Entries are
+ * found in one open-addressing table by the combined hash of all keys, and entries sharing the first key form a group,
+ * which is the equivalent of a level1 node of AggTree and owns the source buffer of its entries.
+ *
+ * Entries, groups and hash tables live in an arena. GetAndReset hands the active arena out as a snapshot and continues
+ * with a spare one, and a dropped snapshot is cleared and kept as the next spare, so that their capacity is reused by
+ * the following rounds. Snapshots must be dropped before the tree is destroyed. Not thread safe.
+ */
+template <class Data, class Value, size_t KeyCount, class AggregateFunc, class BuildFunc, bool NeedSourceBuffer = false>
+class FlatAggTree {
+    static_assert(KeyCount > 0, "at least one agg key is required");
+
+public:
+    using KeysType = std::array<size_t, KeyCount>;
+
+    struct Group {
+        size_t mKey = 0;
+        std::shared_ptr<SourceBuffer> mSourceBuffer;
+        uint32_t mSize = 0;
+        // entry index + 1 of the first and the last entry, 0 means none
+        uint32_t mHead = 0;
+        uint32_t mTail = 0;
+    };
+
+    class Arena {
+    public:
+        [[nodiscard]] const std::vector<Group>& Groups() const { return mGroups; }
+        [[nodiscard]] std::vector<Group>& Groups() { return mGroups; }
+
+        template <class Fn>
+        void ForEach(const Group& group, Fn&& call) const {
+            for (uint32_t i = group.mHead; i != 0; i = mEntries[i - 1].mNext) {
+                if (mEntries[i - 1].mData != nullptr) {
+                    call(static_cast<const Data*>(mEntries[i - 1].mData.get()));
+                }
+            }
+        }
+
+        template <class Fn>
+        void ForEach(Fn&& call) const {
+            for (const auto& entry : mEntries) {
+                if (entry.mData != nullptr) {
+                    call(static_cast<const Data*>(entry.mData.get()));
+                }
+            }
+        }
+
+        [[nodiscard]] size_t NodeCount() const { return mNodeCount; }
+
+        [[nodiscard]] size_t EventCount() const { return mEventCount; }
+
+        void Clear() {
+            mEntries.clear();
+            mGroups.clear();
+            std::fill(mEntrySlots.begin(), mEntrySlots.end(), 0);
+            std::fill(mGroupSlots.begin(), mGroupSlots.end(), 0);
+            mNodeCount = 0;
+            mEventCount = 0;
+        }
+
+    private:
+        friend class FlatAggTree;
+
+        struct Entry {
+            KeysType mKeys{};
+            size_t mHash = 0;
+            uint32_t mGroup = 0;
+            uint32_t mNext = 0;
+            std::unique_ptr<Data> mData;
+        };
+
+        std::vector<Entry> mEntries;
+        std::vector<Group> mGroups;
+        // index + 1 of the entry or group, 0 means empty
+        std::vector<uint32_t> mEntrySlots;
+        std::vector<uint32_t> mGroupSlots;
+        size_t mNodeCount = 0;
+        size_t mEventCount = 0;
+    };
+
+    struct ArenaRecycler {
+        FlatAggTree* mTree = nullptr;
+        void operator()(Arena* arena) const { mTree->recycle(arena); }
+    };
+    using Snapshot = std::unique_ptr<Arena, ArenaRecycler>;
+
+    explicit FlatAggTree(size_t maxNodes,
+                         AggregateFunc aggregateFunc = AggregateFunc(),
+                         BuildFunc buildFunc = BuildFunc())
+        : mMaxNodes(maxNodes),
+          mActive(std::make_unique<Arena>()),
+          mAggregateFunc(std::move(aggregateFunc)),
+          mBuildFunc(std::move(buildFunc)) {}
+    FlatAggTree(const FlatAggTree&) = delete;
+    FlatAggTree& operator=(const FlatAggTree&) = delete;
+
+    bool Aggregate(const Value& d, const KeysType& aggKeys) {
+        Arena& arena = *mActive;
+        size_t hash = 0;
+        for (auto key : aggKeys) {
+            AttrHashCombine(hash, key);
+        }
+        reserveSlots(arena.mEntrySlots, arena.mEntries.size(), [&arena](uint32_t idx) {
+            return arena.mEntries[idx].mHash;
+        });
+        uint32_t& entrySlot = findSlot(arena.mEntrySlots, hash, [&](uint32_t idx) {
+            const auto& entry = arena.mEntries[idx];
+            return entry.mHash == hash && entry.mKeys == aggKeys;
+        });
+        if (entrySlot == 0) {
+            reserveSlots(arena.mGroupSlots, arena.mGroups.size(), [&arena](uint32_t idx) {
+                return arena.mGroups[idx].mKey;
+            });
+            uint32_t& groupSlot = findSlot(
+                arena.mGroupSlots, aggKeys[0], [&](uint32_t idx) { return arena.mGroups[idx].mKey == aggKeys[0]; });
+            // a group is a node of its own only when there are deeper levels, same as AggTree
+            size_t newNodes = (groupSlot == 0 && KeyCount > 1) ? 2 : 1;
+            if (arena.mNodeCount + newNodes > mMaxNodes) {
+                // when we exceed the maximum limit, we will drop new metrics
+                LOG_ERROR(sLogger, ("maximum limit exceeded", mMaxNodes));
+                return false;
+            }
+            if (groupSlot == 0) {
+                auto& group = arena.mGroups.emplace_back();
+                group.mKey = aggKeys[0];
+                if constexpr (NeedSourceBuffer) {
+                    group.mSourceBuffer = std::make_shared<SourceBuffer>(kDefaultNodeSourceBufferSize);
+                }
+                groupSlot = static_cast<uint32_t>(arena.mGroups.size());
+            }
+            auto& group = arena.mGroups[groupSlot - 1];
+            auto& entry = arena.mEntries.emplace_back();
+            entry.mKeys = aggKeys;
+            entry.mHash = hash;
+            entry.mGroup = groupSlot - 1;
+            entrySlot = static_cast<uint32_t>(arena.mEntries.size());
+            if (group.mTail == 0) {
+                group.mHead = entrySlot;
+            } else {
+                arena.mEntries[group.mTail - 1].mNext = entrySlot;
+            }
+            group.mTail = entrySlot;
+            ++group.mSize;
+            arena.mNodeCount += newNodes;
+        }
+        auto& entry = arena.mEntries[entrySlot - 1];
+        if (!entry.mData) {
+            // generate new node ...
+            entry.mData = mBuildFunc(d, arena.mGroups[entry.mGroup].mSourceBuffer);
+        }
+        mAggregateFunc(entry.mData, d);
+        ++arena.mEventCount;
+        return true;
+    }
+
+    Snapshot GetAndReset() {
+        std::unique_ptr<Arena> next = mSpare ? std::move(mSpare) : std::make_unique<Arena>();
+        mActive.swap(next);
+        return Snapshot(next.release(), ArenaRecycler{this});
+    }
+
+    template <class Fn>
+    void ForEach(Fn&& call) const {
+        mActive->ForEach(std::forward<Fn>(call));
+    }
+
+    void Reset() { mActive->Clear(); }
+
+    [[nodiscard]] size_t NodeCount() const { return mActive->NodeCount(); }
+
+    [[nodiscard]] size_t EventCount() const { return mActive->EventCount(); }
+
+private:
+    static constexpr size_t kMinSlots = 16;
+
+    static size_t slotOf(size_t hash, size_t mask) {
+        // agg keys are combined std::hash values whose low bits are weak, so mix them before masking
+        uint64_t h = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h ^ (h >> 32)) & mask;
+    }
+
+    template <class Equal>
+    static uint32_t& findSlot(std::vector<uint32_t>& slots, size_t hash, Equal&& equal) {
+        size_t mask = slots.size() - 1;
+        size_t i = slotOf(hash, mask);
+        while (slots[i] != 0 && !equal(slots[i] - 1)) {
+            i = (i + 1) & mask;
+        }
+        return slots[i];
+    }
+
+    // keeps the load factor under 1/2 for the next insertion
+    template <class HashOf>
+    static void reserveSlots(std::vector<uint32_t>& slots, size_t used, HashOf&& hashOf) {
+        if ((used + 1) * 2 <= slots.size()) {
+            return;
+        }
+        size_t size = std::max(kMinSlots, slots.size() * 2);
+        slots.assign(size, 0);
+        for (uint32_t idx = 0; idx < used; ++idx) {
+            findSlot(slots, hashOf(idx), [](uint32_t) { return false; }) = idx + 1;
+        }
+    }
+
+    void recycle(Arena* arena) {
+        arena->Clear();
+        if (!mSpare) {
+            mSpare.reset(arena);
+        } else {
+            delete arena;
+        }
+    }
+
+    size_t mMaxNodes = 0UL;
+    std::unique_ptr<Arena> mActive;
+    std::unique_ptr<Arena> mSpare;
+    AggregateFunc mAggregateFunc;
+    BuildFunc mBuildFunc;
+};
+
+} // namespace logtail
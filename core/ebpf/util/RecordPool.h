@@ -0,0 +1,85 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace logtail::ebpf {
+
+/**
+ * Recycles records released by the consumers, so that the poller thread does not allocate a record and its strings
+ * for each data event. Records are acquired on the poller thread and released on any thread.
+ *
+ * T::Reset(args...) should reinitialize a reused record as if it were constructed with args, keeping the capacity of
+ * its buffers, and T::Reset() should drop the references held by the record.
+ */
+template <typename T>
+class RecordPool : public std::enable_shared_from_this<RecordPool<T>> {
+public:
+    explicit RecordPool(size_t maxSize) : mMaxSize(maxSize) {}
+    RecordPool(const RecordPool&) = delete;
+    RecordPool& operator=(const RecordPool&) = delete;
+    ~RecordPool() {
+        for (auto* record : mFreeRecords) {
+            delete record;
+        }
+    }
+
+    // the pool must be owned by a shared_ptr, which is kept by the acquired records until they are released
+    template <typename... Args>
+    std::shared_ptr<T> Acquire(Args&&... args) {
+        T* record = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mFreeRecords.empty()) {
+                record = mFreeRecords.back();
+                mFreeRecords.pop_back();
+            }
+        }
+        if (record) {
+            record->Reset(std::forward<Args>(args)...);
+        } else {
+            record = new T(std::forward<Args>(args)...);
+        }
+        return std::shared_ptr<T>(record, [pool = this->shared_from_this()](T* r) { pool->Release(r); });
+    }
+
+    size_t FreeSize() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mFreeRecords.size();
+    }
+
+private:
+    void Release(T* record) {
+        record->Reset();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mFreeRecords.size() < mMaxSize) {
+                mFreeRecords.push_back(record);
+                return;
+            }
+        }
+        delete record;
+    }
+
+    const size_t mMaxSize;
+    mutable std::mutex mMutex;
+    std::vector<T*> mFreeRecords;
+};
+
+} // namespace logtail::ebpf
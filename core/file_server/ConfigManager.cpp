@@ -237,14 +237,21 @@ void ConfigManager::RemoveHandler(const string& dir, bool delete_flag) {
 
 // this functions should only be called when register base dir
 bool ConfigManager::RegisterHandlers() {
+    return RegisterHandlers(FileServer::GetInstance()->GetAllFileDiscoveryConfigs());
+}
+
+bool ConfigManager::RegisterHandlers(const unordered_set<string>& configNames) {
+    return RegisterHandlers(FileServer::GetInstance()->GetFileDiscoveryConfigs(configNames));
+}
+
+bool ConfigManager::RegisterHandlers(const unordered_map<string, FileDiscoveryConfig>& nameConfigMap) {
     if (mSharedHandler == NULL) {
         mSharedHandler = new NormalEventHandler();
     }
 
-    // Build and sort path items from all configs.
+    // Build and sort path items from the configs.
     vector<PathItem> sortedPaths; // 所有精确路径（按原始 basePath 排序）
     vector<PathItem> wildcardPaths; // 所有通配符路径
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
     BuildAndSortPathItems(nameConfigMap, sortedPaths, wildcardPaths);
 
     // Check if has container config
@@ -20,6 +20,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -257,6 +258,8 @@ public:
                               int32_t depth);
     bool RegisterHandlers(const std::string& basePath, const FileDiscoveryConfig& config);
     bool RegisterHandlers();
+    // only dirs of the given configs are registered, dirs already registered are left intact
+    bool RegisterHandlers(const std::unordered_set<std::string>& configNames);
     bool RegisterHandlersRecursively(const std::string& dir, const FileDiscoveryConfig& config, bool checkTimeout);
     // 废弃，蚂蚁
     // /**
@@ -505,6 +508,7 @@ private:
                                      int preservedDirDepth,
                                      int maxDepth);
     bool RegisterDescendants(const std::string& path, const FileDiscoveryConfig& config, int withinDepth);
+    bool RegisterHandlers(const std::unordered_map<std::string, FileDiscoveryConfig>& nameConfigMap);
     // bool CheckLogType(const std::string& logTypeStr, LogType& logType);
     // 废弃
     // std::vector<std::string> GetStringVector(const Json::Value& value);
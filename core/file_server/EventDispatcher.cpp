@@ -28,6 +28,7 @@
 #include <limits.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "app_config/AppConfig.h"
@@ -628,7 +629,7 @@ EventDispatcher::ValidateCheckpointResult EventDispatcher::validateCheckpoint(
     return ValidateCheckpointResult::kDevInodeNotFound;
 }
 
-void EventDispatcher::AddExistedCheckPointFileEvents() {
+void EventDispatcher::AddExistedCheckPointFileEvents(const unordered_set<string>* configNames) {
     // All checkpoint will be add into event queue or be deleted
     // This operation will delete not existed file's check point
     map<DevInode, SplitedFilePath> cachePathDevInodeMap;
@@ -637,6 +638,9 @@ void EventDispatcher::AddExistedCheckPointFileEvents() {
     vector<CheckPointManager::CheckPointKey> deleteKeyVec;
     vector<Event*> eventVec;
     for (auto iter = checkPointMap.begin(); iter != checkPointMap.end(); ++iter) {
+        if (configNames && configNames->find(iter->second->mConfigName) == configNames->end()) {
+            continue;
+        }
         auto const result = validateCheckpoint(iter->second, cachePathDevInodeMap, eventVec);
         if (!(result == ValidateCheckpointResult::kNormal || result == ValidateCheckpointResult::kRotate)) {
             deleteKeyVec.push_back(iter->first);
@@ -653,6 +657,14 @@ void EventDispatcher::AddExistedCheckPointFileEvents() {
     // Load exactly once checkpoints and create events from them.
     // Because they are not in v1 checkpoint manager, no need to delete them.
     auto exactlyOnceConfigs = FileServer::GetInstance()->GetExactlyOnceConfigs();
+    if (configNames) {
+        exactlyOnceConfigs.erase(remove_if(exactlyOnceConfigs.begin(),
+                                           exactlyOnceConfigs.end(),
+                                           [configNames](const string& name) {
+                                               return configNames->find(name) == configNames->end();
+                                           }),
+                                 exactlyOnceConfigs.end());
+    }
     if (!exactlyOnceConfigs.empty()) {
         static auto* sCptMV2 = CheckpointManagerV2::GetInstance();
         auto exactlyOnceCpts = sCptMV2->ScanCheckpoints(exactlyOnceConfigs);
@@ -1008,6 +1020,35 @@ void EventDispatcher::DumpAllHandlersMeta(bool remove) {
     LOG_INFO(sLogger, ("save log reader status", "succeeded"));
 }
 
+void EventDispatcher::DumpHandlersMetaOfConfigs(const unordered_set<string>& configNames) {
+    for (auto it = mWdDirInfoMap.begin(); it != mWdDirInfoMap.end(); ++it) {
+        ((it->second)->mHandler)->RemoveReaders(configNames);
+    }
+    LOG_INFO(sLogger, ("save log reader status of configs", "succeeded")("config count", configNames.size()));
+}
+
+void EventDispatcher::UnregisterUnmatchedDirs() {
+    vector<string> unmatchedDirs;
+    for (auto it = mWdDirInfoMap.begin(); it != mWdDirInfoMap.end(); ++it) {
+        if (ConfigManager::GetInstance()->FindBestMatch((it->second)->mPath).first == NULL) {
+            unmatchedDirs.push_back((it->second)->mPath);
+        }
+    }
+    for (const auto& path : unmatchedDirs) {
+        auto pos = mPathWdMap.find(path);
+        if (pos == mPathWdMap.end()) {
+            continue;
+        }
+        EventHandler* handler = mWdDirInfoMap[pos->second]->mHandler;
+        handler->DumpReaderMeta(true, true);
+        handler->DumpReaderMeta(false, true);
+        ConfigManager::GetInstance()->AddHandlerToDelete(handler);
+        UnregisterEventHandler(path);
+        ConfigManager::GetInstance()->RemoveHandler(path, false);
+    }
+    LOG_INFO(sLogger, ("unregister unmatched dirs", "succeeded")("dir count", unmatchedDirs.size()));
+}
+
 void EventDispatcher::ProcessHandlerTimeOut() {
     MapType<int, DirInfo*>::Type::iterator mapIter = mWdDirInfoMap.begin();
     for (; mapIter != mWdDirInfoMap.end(); ++mapIter) {
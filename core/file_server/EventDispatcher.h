@@ -198,6 +198,10 @@ public:
     // virtual void ExtraWork() = 0;
 
     void DumpAllHandlersMeta(bool);
+    // readers of the configs are dumped and removed, while other readers are left intact
+    void DumpHandlersMetaOfConfigs(const std::unordered_set<std::string>& configNames);
+    // dirs not matched by any config are unregistered, and readers in them are dumped
+    void UnregisterUnmatchedDirs();
     std::vector<std::pair<std::string, EventHandler*> > FindAllSubDirAndHandler(const std::string& baseDir);
     void UnregisterAllDir(const std::string& basePath);
     bool IsRegistered(int wd, std::string& path);
@@ -213,7 +217,8 @@ public:
     void ReadInotifyEvents(std::vector<Event*>& eventVec);
 
     void ProcessHandlerTimeOut();
-    void AddExistedCheckPointFileEvents();
+    // only checkpoints of the given configs are verified if configNames is not null
+    void AddExistedCheckPointFileEvents(const std::unordered_set<std::string>* configNames = nullptr);
 
     void DumpInotifyWatcherDirs();
 
@@ -289,6 +294,7 @@ protected:
     friend class EventDispatcherDirUnittest;
     friend class ModifyHandlerUnittest;
     friend class PipelineUpdateUnittest;
+    friend class FileServerUnittest;
 
     void CleanEnviroments();
     int32_t GetInotifyWatcherCount();
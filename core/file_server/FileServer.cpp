@@ -29,6 +29,9 @@
 #include "plugin/input/InputFile.h"
 
 DEFINE_FLAG_BOOL(enable_polling_discovery, "", true);
+DEFINE_FLAG_BOOL(enable_file_server_incremental_update,
+                 "only rebuild readers and dirs of the changed configs on config update, instead of all of them",
+                 false);
 
 using namespace std;
 
@@ -39,6 +42,7 @@ FileServer::FileServer() {
         mMetricsRecordRef,
         MetricCategory::METRIC_CATEGORY_RUNNER,
         {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SERVER}});
+    mConfigUpdatePauseTimeMs = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_FILE_CONFIG_UPDATE_PAUSE_TIME_MS);
 }
 
 // 启动文件服务，包括加载配置、处理检查点、注册事件等
@@ -70,6 +74,10 @@ void FileServer::Start() {
 
 // 暂停文件服务，根据配置更新标志来决定是否要执行相关的清理和保存操作
 void FileServer::Pause(bool isConfigUpdate) {
+    if (isConfigUpdate) {
+        mPauseStartTimeMs = GetCurrentTimeInMilliSeconds();
+        mIsIncrementalUpdate = false;
+    }
     PauseInner();
     if (isConfigUpdate) {
         EventDispatcher::GetInstance()->DumpAllHandlersMeta(true);
@@ -80,6 +88,26 @@ void FileServer::Pause(bool isConfigUpdate) {
     }
 }
 
+// 暂停文件服务，仅保存并移除变更配置的reader，其余reader和目录监听保持不变
+void FileServer::Pause(const unordered_set<string>& configNames) {
+    if (!BOOL_FLAG(enable_file_server_incremental_update)) {
+        Pause(true);
+        return;
+    }
+    mPauseStartTimeMs = GetCurrentTimeInMilliSeconds();
+    PauseInner();
+    mIsIncrementalUpdate = true;
+    mUpdatedConfigNames = configNames;
+    // readers exist only for removed or modified configs, which are still registered at this time
+    mHasStaleReaders = !GetFileDiscoveryConfigs(configNames).empty();
+    if (mHasStaleReaders) {
+        EventDispatcher::GetInstance()->DumpHandlersMetaOfConfigs(configNames);
+    }
+    // the checkpoint file is not dumped, since it would lose checkpoints of the readers left intact
+    PollingDirFile::GetInstance()->ClearCache();
+    ConfigManager::GetInstance()->ClearFilePipelineMatchCache();
+}
+
 // 暂停文件服务的内部实现，记录日志并处理暂停逻辑
 void FileServer::PauseInner() {
     LOG_INFO(sLogger, ("file server pause", "starts"));
@@ -114,17 +142,40 @@ void FileServer::Resume(bool isConfigUpdate, bool isContainerUpdate) {
     LOG_INFO(
         sLogger,
         ("file server resume", "starts")("isConfigUpdate", isConfigUpdate)("isContainerUpdate", isContainerUpdate));
-    ConfigManager::GetInstance()->RegisterHandlers();
-    LOG_INFO(sLogger, ("watch dirs", "succeeded"));
-    if (isConfigUpdate) {
-        EventDispatcher::GetInstance()->AddExistedCheckPointFileEvents();
+    if (isConfigUpdate && mIsIncrementalUpdate) {
+        ResumeIncrementally();
+    } else {
+        ConfigManager::GetInstance()->RegisterHandlers();
+        LOG_INFO(sLogger, ("watch dirs", "succeeded"));
+        if (isConfigUpdate) {
+            EventDispatcher::GetInstance()->AddExistedCheckPointFileEvents();
+        }
     }
     LogInput::GetInstance()->Resume();
     if (BOOL_FLAG(enable_polling_discovery)) {
         PollingModify::GetInstance()->Resume();
         PollingDirFile::GetInstance()->Resume();
     }
-    LOG_INFO(sLogger, ("file server resume", "succeeded"));
+    if (isConfigUpdate) {
+        auto pauseTimeMs = GetCurrentTimeInMilliSeconds() - mPauseStartTimeMs;
+        SET_GAUGE(mConfigUpdatePauseTimeMs, pauseTimeMs);
+        LOG_INFO(sLogger,
+                 ("file server resume", "succeeded")("isIncrementalUpdate",
+                                                     mIsIncrementalUpdate)("pause time", ToString(pauseTimeMs) + "ms"));
+        mIsIncrementalUpdate = false;
+        mUpdatedConfigNames.clear();
+    } else {
+        LOG_INFO(sLogger, ("file server resume", "succeeded"));
+    }
+}
+
+void FileServer::ResumeIncrementally() {
+    if (mHasStaleReaders) {
+        EventDispatcher::GetInstance()->UnregisterUnmatchedDirs();
+    }
+    ConfigManager::GetInstance()->RegisterHandlers(mUpdatedConfigNames);
+    LOG_INFO(sLogger, ("watch dirs of updated configs", "succeeded")("config count", mUpdatedConfigNames.size()));
+    EventDispatcher::GetInstance()->AddExistedCheckPointFileEvents(&mUpdatedConfigNames);
 }
 
 // 停止文件服务，将事件处理程序的元数据以及检查点数据保存到本地
@@ -144,6 +195,20 @@ FileDiscoveryConfig FileServer::GetFileDiscoveryConfig(const string& name) const
     return make_pair(nullptr, nullptr);
 }
 
+// 获取给定名称集合中已存在的文件发现配置
+unordered_map<string, FileDiscoveryConfig>
+FileServer::GetFileDiscoveryConfigs(const unordered_set<string>& names) const {
+    ReadLock lock(mReadWriteLock);
+    unordered_map<string, FileDiscoveryConfig> res;
+    for (const auto& name : names) {
+        auto itr = mPipelineNameFileDiscoveryConfigsMap.find(name);
+        if (itr != mPipelineNameFileDiscoveryConfigsMap.end()) {
+            res.emplace(itr->first, itr->second);
+        }
+    }
+    return res;
+}
+
 // 添加文件发现配置
 void FileServer::AddFileDiscoveryConfig(const string& name,
                                         FileDiscoveryOptions* opts,
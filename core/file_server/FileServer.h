@@ -18,6 +18,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "collection_pipeline/CollectionPipelineContext.h"
@@ -44,12 +45,16 @@ public:
 
     void Start();
     void Pause(bool isConfigUpdate = true);
+    // for config update, only readers and dirs of the given configs are rebuilt if incremental update is enabled
+    void Pause(const std::unordered_set<std::string>& configNames);
 
     // for plugin
     FileDiscoveryConfig GetFileDiscoveryConfig(const std::string& name) const;
     const std::unordered_map<std::string, FileDiscoveryConfig>& GetAllFileDiscoveryConfigs() const {
         return mPipelineNameFileDiscoveryConfigsMap;
     }
+    std::unordered_map<std::string, FileDiscoveryConfig>
+    GetFileDiscoveryConfigs(const std::unordered_set<std::string>& names) const;
     void
     AddFileDiscoveryConfig(const std::string& name, FileDiscoveryOptions* opts, const CollectionPipelineContext* ctx);
     void RemoveFileDiscoveryConfig(const std::string& name);
@@ -102,6 +107,7 @@ private:
     ~FileServer() = default;
 
     void PauseInner();
+    void ResumeIncrementally();
 
     mutable ReadWriteLock mReadWriteLock;
 
@@ -118,7 +124,18 @@ private:
     // 过渡使用
     std::unordered_map<std::string, uint32_t> mPipelineNameEOConcurrencyMap;
 
+    // configs changed since the last Pause, valid only if mIsIncrementalUpdate is true
+    std::unordered_set<std::string> mUpdatedConfigNames;
+    bool mIsIncrementalUpdate = false;
+    bool mHasStaleReaders = false;
+    uint64_t mPauseStartTimeMs = 0;
+
     mutable MetricsRecordRef mMetricsRecordRef;
+    IntGaugePtr mConfigUpdatePauseTimeMs;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FileServerUnittest;
+#endif
 };
 
 } // namespace logtail
@@ -14,6 +14,8 @@
 
 #include "file_server/StaticFileServer.h"
 
+#include <fstream>
+
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "common/LogtailCommonFlags.h"
 #include "file_server/checkpoint/InputStaticFileCheckpointManager.h"
@@ -21,6 +23,16 @@
 
 
 DEFINE_FLAG_INT32(input_static_file_checkpoint_dump_interval_sec, "", 5);
+DEFINE_FLAG_INT32(input_static_file_bulk_thread_count, "worker thread count for static file reading in bulk mode", 4);
+DEFINE_FLAG_INT32(input_static_file_bulk_read_buffer_size,
+                  "read buffer size for static file reading in bulk mode, bytes",
+                  8 * 1024 * 1024);
+DEFINE_FLAG_INT64(input_static_file_bulk_range_size,
+                  "size of the ranges a large file is split into in bulk mode, bytes",
+                  64 * 1024 * 1024);
+DEFINE_FLAG_INT32(input_static_file_bulk_max_reading_files,
+                  "max number of files of one input read concurrently in bulk mode",
+                  4);
 
 using namespace std;
 
@@ -34,6 +46,8 @@ StaticFileServer::StaticFileServer() {
 
     mLastRunTimeGauge = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
     mActiveInputsTotalGauge = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_STATIC_FILE_SERVER_ACTIVE_INPUTS_COUNT);
+    mBulkRangesInProcessGauge
+        = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_STATIC_FILE_SERVER_BULK_RANGES_IN_PROCESS_COUNT);
 
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 }
@@ -61,6 +75,7 @@ void StaticFileServer::Stop() {
     } else {
         LOG_WARNING(sLogger, ("static file server", "forced to stopped"));
     }
+    StopBulkWorkers();
 }
 
 bool StaticFileServer::HasRegisteredPlugins() const {
@@ -78,7 +93,10 @@ void StaticFileServer::ClearUnusedCheckpoints() {
 
 void StaticFileServer::RemoveInput(const string& configName, size_t idx) {
     {
+        // wait for bulk workers to release the readers of this input
+        unique_lock<shared_mutex> bulkLock(mBulkReadMux);
         lock_guard<mutex> lock(mUpdateMux);
+        mBulkInputs.erase(make_pair(configName, idx));
         mInputFileDiscoveryConfigsMap.erase(make_pair(configName, idx));
         mInputFileReaderConfigsMap.erase(make_pair(configName, idx));
         mInputMultilineConfigsMap.erase(make_pair(configName, idx));
@@ -95,13 +113,17 @@ void StaticFileServer::AddInput(const string& configName,
                                 const FileReaderOptions* fileReaderOpts,
                                 const MultilineOptions* multilineOpts,
                                 const FileTagOptions* fileTagOpts,
-                                const CollectionPipelineContext* ctx) {
+                                const CollectionPipelineContext* ctx,
+                                bool enableBulkRead) {
     // check if the server is started, if not, start it
     {
         lock_guard<mutex> lock(mThreadRunningMux);
         if (!mIsThreadRunning || !mThreadRes.valid()) {
             Init();
         }
+        if (enableBulkRead) {
+            StartBulkWorkers();
+        }
     }
 
     // 安全获取Pipeline的时间值，避免空指针解引用
@@ -121,6 +143,9 @@ void StaticFileServer::AddInput(const string& configName,
         mInputFileReaderConfigsMap.try_emplace(make_pair(configName, idx), make_pair(fileReaderOpts, ctx));
         mInputMultilineConfigsMap.try_emplace(make_pair(configName, idx), make_pair(multilineOpts, ctx));
         mInputFileTagConfigsMap.try_emplace(make_pair(configName, idx), make_pair(fileTagOpts, ctx));
+        if (enableBulkRead) {
+            mBulkInputs[make_pair(configName, idx)] = ++mBulkInputVersion;
+        }
         mAddedInputs.emplace(configName, idx);
     }
 }
@@ -149,10 +174,35 @@ void StaticFileServer::Run() {
 
 void StaticFileServer::ReadFiles() {
     for (auto& item : mPipelineNameReadersMap) {
+        const auto& configName = item.first;
+        auto inputIdx = item.second.first;
+        optional<uint64_t> bulkVersion;
+        bool isSplittable = false;
+        {
+            lock_guard<mutex> lock(mUpdateMux);
+            if (mDeletedInputs.find(make_pair(configName, inputIdx)) != mDeletedInputs.end()) {
+                continue;
+            }
+            auto bulkIt = mBulkInputs.find(make_pair(configName, inputIdx));
+            if (bulkIt != mBulkInputs.end()) {
+                bulkVersion = bulkIt->second;
+                // ranges can only be split on line feeds when each line is a complete log
+                auto readerConfig = GetFileReaderConfig(configName, inputIdx);
+                auto multilineConfig = GetMultilineConfig(configName, inputIdx);
+                isSplittable = !(multilineConfig.first && multilineConfig.first->IsMultiline())
+                    && !(readerConfig.second && readerConfig.second->RequiringJsonReader());
+            }
+        }
+        if (bulkVersion) {
+            // files are split with disk reads, which must not block config updates waiting for the lock
+            if (!ScheduleBulkRanges(configName, inputIdx, *bulkVersion, isSplittable)) {
+                lock_guard<mutex> lock(mUpdateMux);
+                mDeletedInputs.emplace(configName, inputIdx);
+            }
+            continue;
+        }
         {
             lock_guard<mutex> lock(mUpdateMux);
-            const auto& configName = item.first;
-            auto inputIdx = item.second.first;
             if (mDeletedInputs.find(make_pair(configName, inputIdx)) != mDeletedInputs.end()) {
                 continue;
             }
@@ -240,6 +290,308 @@ LogFileReaderPtr StaticFileServer::GetNextAvailableReader(const string& configNa
     return LogFileReaderPtr();
 }
 
+bool StaticFileServer::ScheduleBulkRanges(const string& configName, size_t idx, uint64_t version, bool isSplittable) {
+    size_t maxRangesInProcess = 2 * static_cast<size_t>(max(INT32_FLAG(input_static_file_bulk_thread_count), 1));
+    {
+        lock_guard<mutex> lock(mBulkTaskMux);
+        if (mBulkRangesInProcess.size() >= maxRangesInProcess) {
+            return true;
+        }
+    }
+
+    vector<pair<size_t, FileCheckpoint>> files;
+    if (!InputStaticFileCheckpointManager::GetInstance()->GetUnfinishedFiles(
+            configName, idx, static_cast<size_t>(max(INT32_FLAG(input_static_file_bulk_max_reading_files), 1)), &files)) {
+        // all files have been read
+        return false;
+    }
+
+    uint64_t rangeSize = static_cast<uint64_t>(max(INT64_FLAG(input_static_file_bulk_range_size), int64_t(1)));
+    for (auto& [fileIdx, fileCpt] : files) {
+        if (fileCpt.mStatus == FileStatus::READING && !fileCpt.mRanges.empty()) {
+            continue;
+        }
+        error_code ec;
+        uint64_t size = filesystem::file_size(fileCpt.mFilePath, ec);
+        if (ec) {
+            LOG_WARNING(sLogger,
+                        ("failed to get file size", "skip")("config", configName)("input idx", idx)(
+                            "filepath", fileCpt.mFilePath.string())("error msg", ec.message()));
+            InputStaticFileCheckpointManager::GetInstance()->InvalidateFileCheckpoint(configName, idx, fileIdx);
+            continue;
+        }
+        vector<FileRangeCheckpoint> ranges;
+        if (fileCpt.mStatus == FileStatus::READING) {
+            // partially read in sequential mode before
+            if (fileCpt.mOffset < size) {
+                ranges.emplace_back(fileCpt.mOffset, size);
+            }
+        } else {
+            ranges = SplitFileIntoRanges(fileCpt.mFilePath, size, isSplittable ? rangeSize : max(size, uint64_t(1)));
+        }
+        fileCpt.mRanges = ranges;
+        fileCpt.mStatus = FileStatus::READING;
+        // the input may have been removed or recreated while the file was being split
+        if (!IsBulkInputValid(configName, idx, version)) {
+            return true;
+        }
+        InputStaticFileCheckpointManager::GetInstance()->SetFileRanges(configName, idx, fileIdx, size, std::move(ranges));
+    }
+
+    lock_guard<mutex> lock(mBulkTaskMux);
+    for (const auto& [fileIdx, fileCpt] : files) {
+        if (fileCpt.mStatus != FileStatus::READING) {
+            continue;
+        }
+        for (size_t rangeIdx = 0; rangeIdx < fileCpt.mRanges.size(); ++rangeIdx) {
+            if (mBulkRangesInProcess.size() >= maxRangesInProcess) {
+                break;
+            }
+            if (mBulkRangesInProcess.find(make_tuple(configName, idx, fileIdx, rangeIdx))
+                != mBulkRangesInProcess.end()) {
+                continue;
+            }
+            // the range may have been finished by a worker after the files were fetched, so the snapshot is stale
+            FileRangeCheckpoint range;
+            if (!InputStaticFileCheckpointManager::GetInstance()->GetFileRangeCheckpoint(
+                    configName, idx, fileIdx, rangeIdx, &range)) {
+                continue;
+            }
+            mBulkRangesInProcess.emplace(configName, idx, fileIdx, rangeIdx);
+            auto& task = mBulkTasks.emplace_back();
+            task.mConfigName = configName;
+            task.mInputIdx = idx;
+            task.mInputVersion = version;
+            task.mFileIdx = fileIdx;
+            task.mRangeIdx = rangeIdx;
+            task.mFingerprint.mFilePath = fileCpt.mFilePath;
+            task.mFingerprint.mDevInode = fileCpt.mDevInode;
+            task.mFingerprint.mSignatureHash = fileCpt.mSignatureHash;
+            task.mFingerprint.mSignatureSize = fileCpt.mSignatureSize;
+            task.mRange = range;
+        }
+    }
+    SET_GAUGE(mBulkRangesInProcessGauge, mBulkRangesInProcess.size());
+    mBulkTaskCV.notify_all();
+    return true;
+}
+
+void StaticFileServer::StartBulkWorkers() {
+    if (mIsBulkWorkerRunning) {
+        return;
+    }
+    mIsBulkWorkerRunning = true;
+    auto threadCount = static_cast<size_t>(max(INT32_FLAG(input_static_file_bulk_thread_count), 1));
+    mBulkWorkerRes.resize(threadCount);
+    for (auto& res : mBulkWorkerRes) {
+        res = async(launch::async, &StaticFileServer::RunBulkWorker, this);
+    }
+    LOG_INFO(sLogger, ("static file server bulk workers", "started")("thread count", threadCount));
+}
+
+void StaticFileServer::StopBulkWorkers() {
+    if (!mIsBulkWorkerRunning) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(mBulkTaskMux);
+        mIsBulkWorkerRunning = false;
+        mBulkTasks.clear();
+    }
+    mBulkTaskCV.notify_all();
+    for (auto& res : mBulkWorkerRes) {
+        if (!res.valid()) {
+            continue;
+        }
+        if (res.wait_for(chrono::seconds(1)) != future_status::ready) {
+            LOG_WARNING(sLogger, ("static file server bulk worker", "forced to stopped"));
+        }
+    }
+    mBulkWorkerRes.clear();
+    lock_guard<mutex> lock(mBulkTaskMux);
+    mBulkRangesInProcess.clear();
+}
+
+void StaticFileServer::RunBulkWorker() {
+    while (true) {
+        BulkRangeTask task;
+        {
+            unique_lock<mutex> lock(mBulkTaskMux);
+            mBulkTaskCV.wait(lock, [this]() { return !mIsBulkWorkerRunning || !mBulkTasks.empty(); });
+            if (!mIsBulkWorkerRunning) {
+                return;
+            }
+            task = std::move(mBulkTasks.front());
+            mBulkTasks.pop_front();
+        }
+        ReadFileRange(task);
+        {
+            lock_guard<mutex> lock(mBulkTaskMux);
+            mBulkRangesInProcess.erase(make_tuple(task.mConfigName, task.mInputIdx, task.mFileIdx, task.mRangeIdx));
+            SET_GAUGE(mBulkRangesInProcessGauge, mBulkRangesInProcess.size());
+        }
+    }
+}
+
+void StaticFileServer::ReadFileRange(const BulkRangeTask& task) {
+    LogFileReaderPtr reader;
+    unique_ptr<LogBuffer> logBuffer;
+    PipelineEventGroup group(nullptr);
+    bool hasPendingGroup = false;
+    while (mIsBulkWorkerRunning) {
+        shared_lock<shared_mutex> bulkLock(mBulkReadMux);
+        if (!IsBulkInputValid(task.mConfigName, task.mInputIdx, task.mInputVersion)) {
+            return;
+        }
+        if (!reader) {
+            reader = CreateRangeReader(task);
+            if (!reader) {
+                InputStaticFileCheckpointManager::GetInstance()->InvalidateFileCheckpoint(
+                    task.mConfigName, task.mInputIdx, task.mFileIdx);
+                return;
+            }
+        }
+
+        if (!hasPendingGroup) {
+            if (!ProcessQueueManager::GetInstance()->IsValidToPush(reader->GetQueueKey())) {
+                bulkLock.unlock();
+                this_thread::sleep_for(chrono::milliseconds(10));
+                continue;
+            }
+            logBuffer = make_unique<LogBuffer>();
+            bool moreData = reader->ReadLog(*logBuffer, nullptr);
+            if (logBuffer->rawBuffer.empty() && !moreData && reader->HasDataInCache()) {
+                // the last line of the file has no line feed
+                auto event = reader->CreateFlushTimeoutEvent();
+                reader->ReadLog(*logBuffer, event.get());
+            }
+            if (logBuffer->rawBuffer.empty()) {
+                if (reader->GetLastFilePos() < static_cast<int64_t>(task.mRange.mEnd) && !moreData) {
+                    LOG_WARNING(sLogger,
+                                ("file range cannot be read to the end, perhaps file has been truncated",
+                                 "abort")("config", task.mConfigName)("input idx", task.mInputIdx)(
+                                    "filepath", task.mFingerprint.mFilePath.string())("range begin", task.mRange.mBegin)(
+                                    "range end", task.mRange.mEnd)("read offset", reader->GetLastFilePos()));
+                    InputStaticFileCheckpointManager::GetInstance()->InvalidateFileCheckpoint(
+                        task.mConfigName, task.mInputIdx, task.mFileIdx);
+                    return;
+                }
+            } else {
+                group = LogFileReader::GenerateEventGroup(reader, logBuffer.get());
+                hasPendingGroup = true;
+            }
+        }
+        if (hasPendingGroup) {
+            // several workers may push to the same queue, so push may fail even if the queue was valid to push
+            if (!ProcessorRunner::GetInstance()->PushQueue(reader->GetQueueKey(), task.mInputIdx, std::move(group))) {
+                bulkLock.unlock();
+                this_thread::sleep_for(chrono::milliseconds(10));
+                continue;
+            }
+            hasPendingGroup = false;
+        }
+        InputStaticFileCheckpointManager::GetInstance()->UpdateFileRangeCheckpoint(
+            task.mConfigName, task.mInputIdx, task.mFileIdx, task.mRangeIdx, reader->GetLastFilePos());
+        if (reader->GetLastFilePos() >= static_cast<int64_t>(task.mRange.mEnd)) {
+            return;
+        }
+    }
+}
+
+LogFileReaderPtr StaticFileServer::CreateRangeReader(const BulkRangeTask& task) const {
+    lock_guard<mutex> lock(mUpdateMux);
+    const auto& fingerprint = task.mFingerprint;
+    LogFileReaderPtr reader(LogFileReader::CreateLogFileReader(fingerprint.mFilePath.parent_path().string(),
+                                                               fingerprint.mFilePath.filename().string(),
+                                                               fingerprint.mDevInode,
+                                                               GetFileReaderConfig(task.mConfigName, task.mInputIdx),
+                                                               GetMultilineConfig(task.mConfigName, task.mInputIdx),
+                                                               GetFileDiscoveryConfig(task.mConfigName, task.mInputIdx),
+                                                               GetFileTagConfig(task.mConfigName, task.mInputIdx),
+                                                               0,
+                                                               true));
+    string errMsg;
+    if (!reader) {
+        errMsg = "failed to create reader";
+    } else if (!reader->UpdateFilePtr()) {
+        errMsg = "failed to open file";
+    } else if (!reader->CheckFileSignatureAndOffset(false)
+               || reader->GetSignature() != make_pair(fingerprint.mSignatureHash, fingerprint.mSignatureSize)) {
+        errMsg = "file signature check failed";
+    }
+    if (!errMsg.empty()) {
+        LOG_WARNING(sLogger,
+                    ("failed to get reader", errMsg)("config", task.mConfigName)("input idx", task.mInputIdx)(
+                        "filepath", fingerprint.mFilePath.string()));
+        return LogFileReaderPtr();
+    }
+    reader->SetReadRange(task.mRange.mOffset, task.mRange.mEnd);
+    reader->SetReaderBufferSize(static_cast<size_t>(INT32_FLAG(input_static_file_bulk_read_buffer_size)));
+    reader->AdviseSequentialRead();
+    return reader;
+}
+
+bool StaticFileServer::IsBulkInputValid(const string& configName, size_t idx, uint64_t version) const {
+    lock_guard<mutex> lock(mUpdateMux);
+    auto it = mBulkInputs.find(make_pair(configName, idx));
+    return it != mBulkInputs.end() && it->second == version;
+}
+
+vector<FileRangeCheckpoint>
+StaticFileServer::SplitFileIntoRanges(const filesystem::path& filepath, uint64_t size, uint64_t rangeSize) {
+    static constexpr size_t kScanSize = 64 * 1024;
+
+    vector<FileRangeCheckpoint> res;
+    if (size == 0) {
+        return res;
+    }
+    if (rangeSize == 0 || rangeSize >= size) {
+        res.emplace_back(0, size);
+        return res;
+    }
+
+    ifstream is(filepath, ios::binary);
+    if (!is) {
+        res.emplace_back(0, size);
+        return res;
+    }
+    string buf(kScanSize, '\0');
+    uint64_t begin = 0;
+    while (begin < size) {
+        uint64_t end = begin + rangeSize;
+        if (end >= size) {
+            res.emplace_back(begin, size);
+            break;
+        }
+        // move the boundary forward to the byte right after the next line feed
+        bool found = false;
+        uint64_t pos = end - 1;
+        while (pos < size) {
+            is.clear();
+            is.seekg(static_cast<streamoff>(pos));
+            is.read(&buf[0], static_cast<streamsize>(min<uint64_t>(kScanSize, size - pos)));
+            auto cnt = static_cast<size_t>(is.gcount());
+            if (cnt == 0) {
+                break;
+            }
+            auto lf = buf.find('\n');
+            if (lf != string::npos && lf < cnt) {
+                end = pos + lf + 1;
+                found = true;
+                break;
+            }
+            pos += cnt;
+        }
+        if (!found || end >= size) {
+            res.emplace_back(begin, size);
+            break;
+        }
+        res.emplace_back(begin, end);
+        begin = end;
+    }
+    return res;
+}
+
 void StaticFileServer::UpdateInputs() {
     unique_lock<mutex> lock(mUpdateMux);
     for (const auto& item : mDeletedInputs) {
@@ -302,6 +654,10 @@ void StaticFileServer::Clear() {
     mPipelineNameReadersMap.clear();
     mAddedInputs.clear();
     mDeletedInputs.clear();
+    mBulkInputs.clear();
+    lock_guard<mutex> bulkLock(mBulkTaskMux);
+    mBulkTasks.clear();
+    mBulkRangesInProcess.clear();
 }
 #endif
 
@@ -16,20 +16,25 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <future>
 #include <map>
 #include <mutex>
 #include <optional>
 #include <set>
+#include <shared_mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "collection_pipeline/CollectionPipelineContext.h"
 #include "file_server/FileDiscoveryOptions.h"
 #include "file_server/FileTagOptions.h"
 #include "file_server/MultilineOptions.h"
+#include "file_server/checkpoint/FileCheckpoint.h"
 #include "file_server/reader/FileReaderOptions.h"
 #include "file_server/reader/LogFileReader.h"
 #include "monitor/MetricManager.h"
@@ -61,14 +66,31 @@ public:
                   const FileReaderOptions* fileReaderOpts,
                   const MultilineOptions* multilineOpts,
                   const FileTagOptions* fileTagOpts,
-                  const CollectionPipelineContext* ctx);
+                  const CollectionPipelineContext* ctx,
+                  bool enableBulkRead = false);
     void RemoveInput(const std::string& configName, size_t idx);
 
+    // Split the file into ranges of roughly rangeSize bytes, each of which ends right after a line feed (or at the end
+    // of the file), so that they can be read independently.
+    static std::vector<FileRangeCheckpoint>
+    SplitFileIntoRanges(const std::filesystem::path& filepath, uint64_t size, uint64_t rangeSize);
+
 #ifdef APSARA_UNIT_TEST_MAIN
     void Clear();
 #endif
 
 private:
+    struct BulkRangeTask {
+        std::string mConfigName;
+        size_t mInputIdx = 0;
+        uint64_t mInputVersion = 0;
+        size_t mFileIdx = 0;
+        size_t mRangeIdx = 0;
+        FileFingerprint mFingerprint;
+        FileRangeCheckpoint mRange;
+    };
+    using BulkRangeKey = std::tuple<std::string, size_t, size_t, size_t>;
+
     StaticFileServer();
     ~StaticFileServer() = default;
 
@@ -77,6 +99,15 @@ private:
     void UpdateInputs();
     LogFileReaderPtr GetNextAvailableReader(const std::string& configName, size_t idx);
 
+    // called without mUpdateMux held, returns false if all files of the input have been read
+    bool ScheduleBulkRanges(const std::string& configName, size_t idx, uint64_t version, bool isSplittable);
+    void StartBulkWorkers();
+    void StopBulkWorkers();
+    void RunBulkWorker();
+    void ReadFileRange(const BulkRangeTask& task);
+    LogFileReaderPtr CreateRangeReader(const BulkRangeTask& task) const;
+    bool IsBulkInputValid(const std::string& configName, size_t idx, uint64_t version) const;
+
     FileDiscoveryConfig GetFileDiscoveryConfig(const std::string& name, size_t idx) const;
     FileReaderConfig GetFileReaderConfig(const std::string& name, size_t idx) const;
     MultilineConfig GetMultilineConfig(const std::string& name, size_t idx) const;
@@ -104,6 +135,22 @@ private:
     std::map<std::pair<std::string, size_t>, FileTagConfig> mInputFileTagConfigsMap;
     std::multimap<std::string, size_t> mAddedInputs;
     std::set<std::pair<std::string, size_t>> mDeletedInputs;
+    // inputs in bulk mode, with a version to tell apart inputs recreated with the same name and index
+    std::map<std::pair<std::string, size_t>, uint64_t> mBulkInputs;
+    uint64_t mBulkInputVersion = 0;
+
+    // bulk mode, ranges are read concurrently by worker threads, so events of the same file may reach the pipeline
+    // out of order, which is acceptable for backfilling
+    std::vector<std::future<void>> mBulkWorkerRes;
+    std::atomic_bool mIsBulkWorkerRunning = false;
+    // held shared by bulk workers while touching a reader, and exclusively when an input is removed, so that no reader
+    // can access the options of a removed input
+    mutable std::shared_mutex mBulkReadMux;
+    mutable std::mutex mBulkTaskMux;
+    std::condition_variable mBulkTaskCV;
+    std::deque<BulkRangeTask> mBulkTasks;
+    std::set<BulkRangeKey> mBulkRangesInProcess;
+    IntGaugePtr mBulkRangesInProcessGauge;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class StaticFileServerUnittest;
@@ -16,6 +16,7 @@
 
 #include <fcntl.h>
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <thread>
@@ -40,9 +41,84 @@ DEFINE_FLAG_INT32(check_point_version, "now check point version xx.xx.xx such as
 DEFINE_FLAG_INT32(check_point_dump_interval, "default 15 min", 15 * 60);
 DEFINE_FLAG_INT32(check_point_max_count, "max check point count", 100000);
 DEFINE_FLAG_INT32(checkpoint_find_max_file_count, "", 1000);
+DEFINE_FLAG_BOOL(enable_checkpoint_journal,
+                 "dump only changed checkpoints to a binary journal instead of rewriting the json checkpoint file",
+                 false);
 
 namespace logtail {
 
+static string GetCheckPointKey(const CheckPoint& checkPoint) {
+    // use filename + dev + inode + configName to prevent same filename conflict
+    return checkPoint.mFileName + "*" + ToString(checkPoint.mDevInode.dev) + "*"
+        + ToString(checkPoint.mDevInode.inode) + "*" + checkPoint.mConfigName;
+}
+
+static void EncodeCheckPoint(const CheckPoint& checkPoint, string& buf) {
+    CheckpointJournal::EncodeInt(buf, checkPoint.mOffset);
+    CheckpointJournal::EncodeInt(buf, checkPoint.mSignatureSize);
+    CheckpointJournal::EncodeInt(buf, checkPoint.mSignatureHash);
+    CheckpointJournal::EncodeInt(buf, checkPoint.mLastUpdateTime);
+    CheckpointJournal::EncodeInt(buf, checkPoint.mDevInode.dev);
+    CheckpointJournal::EncodeInt(buf, checkPoint.mDevInode.inode);
+    CheckpointJournal::EncodeInt(buf, checkPoint.mIdxInReaderArray);
+    uint8_t flags = (checkPoint.mFileOpenFlag ? 1 : 0) | (checkPoint.mContainerStopped ? 2 : 0)
+        | (checkPoint.mLastForceRead ? 4 : 0);
+    CheckpointJournal::EncodeInt(buf, flags);
+    CheckpointJournal::EncodeString(buf, checkPoint.mFileName);
+    CheckpointJournal::EncodeString(buf, checkPoint.mResolvedFileName);
+    CheckpointJournal::EncodeString(buf, checkPoint.mRealFileName);
+    CheckpointJournal::EncodeString(buf, checkPoint.mContainerID);
+    CheckpointJournal::EncodeString(buf, checkPoint.mConfigName);
+}
+
+static bool DecodeCheckPoint(const string& buf, CheckPoint& checkPoint) {
+    size_t pos = 0;
+    uint8_t flags = 0;
+    if (!CheckpointJournal::DecodeInt(buf, pos, checkPoint.mOffset)
+        || !CheckpointJournal::DecodeInt(buf, pos, checkPoint.mSignatureSize)
+        || !CheckpointJournal::DecodeInt(buf, pos, checkPoint.mSignatureHash)
+        || !CheckpointJournal::DecodeInt(buf, pos, checkPoint.mLastUpdateTime)
+        || !CheckpointJournal::DecodeInt(buf, pos, checkPoint.mDevInode.dev)
+        || !CheckpointJournal::DecodeInt(buf, pos, checkPoint.mDevInode.inode)
+        || !CheckpointJournal::DecodeInt(buf, pos, checkPoint.mIdxInReaderArray)
+        || !CheckpointJournal::DecodeInt(buf, pos, flags)
+        || !CheckpointJournal::DecodeString(buf, pos, checkPoint.mFileName)
+        || !CheckpointJournal::DecodeString(buf, pos, checkPoint.mResolvedFileName)
+        || !CheckpointJournal::DecodeString(buf, pos, checkPoint.mRealFileName)
+        || !CheckpointJournal::DecodeString(buf, pos, checkPoint.mContainerID)
+        || !CheckpointJournal::DecodeString(buf, pos, checkPoint.mConfigName)) {
+        return false;
+    }
+    checkPoint.mFileOpenFlag = flags & 1;
+    checkPoint.mContainerStopped = flags & 2;
+    checkPoint.mLastForceRead = flags & 4;
+    return true;
+}
+
+static void EncodeDirCheckPoint(const DirCheckPoint& checkPoint, string& buf) {
+    CheckpointJournal::EncodeInt(buf, checkPoint.mUpdateTime);
+    CheckpointJournal::EncodeInt(buf, static_cast<uint32_t>(checkPoint.mSubDir.size()));
+    for (const auto& subDir : checkPoint.mSubDir) {
+        CheckpointJournal::EncodeString(buf, subDir);
+    }
+}
+
+static bool DecodeDirCheckPoint(const string& buf, int32_t& updateTime, set<string>& subDirs) {
+    size_t pos = 0;
+    uint32_t cnt = 0;
+    if (!CheckpointJournal::DecodeInt(buf, pos, updateTime) || !CheckpointJournal::DecodeInt(buf, pos, cnt)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < cnt; ++i) {
+        string subDir;
+        if (!CheckpointJournal::DecodeString(buf, pos, subDir)) {
+            return false;
+        }
+        subDirs.insert(std::move(subDir));
+    }
+    return true;
+}
+
 bool CheckPointManager::CheckVersion() {
     return (mLoadVersion == NO_CHECKPOINT_VERSION) || (mLoadVersion / 10000 == INT32_FLAG(check_point_version) / 10000);
 }
@@ -128,6 +204,10 @@ void CheckPointManager::AddDirCheckPoint(const string& dirname) {
     ptr->mSubDir.insert(dirname);
 }
 void CheckPointManager::LoadCheckPoint() {
+    // the journal is newer than the json file whenever it exists, since it is removed once the json file is dumped
+    if (GetJournal().Exists() && LoadCheckPointFromJournal()) {
+        return;
+    }
     Json::Value root;
     ParseConfResult cptRes = ParseConfig(AppConfig::GetInstance()->GetCheckPointFilePath(), root);
     // if new checkpoint file not exist, check old checkpoint file.
@@ -336,8 +416,120 @@ void CheckPointManager::LoadFileCheckPoint(const Json::Value& root) {
         }
     }
 }
+bool CheckPointManager::LoadCheckPointFromJournal() {
+    CheckpointJournal::Records records;
+    uint32_t version = NO_CHECKPOINT_VERSION;
+    if (!GetJournal().Load(records, version)) {
+        AlarmManager::GetInstance()->SendAlarmWarning(CHECKPOINT_ALARM, "failed to load check point journal");
+        return false;
+    }
+    mLoadVersion = version;
+
+    int32_t now = time(NULL);
+    for (const auto& [dirname, value] : records[CheckpointJournal::DIR_CHECKPOINT]) {
+        int32_t updateTime = 0;
+        DirCheckPointPtr dir(new DirCheckPoint(dirname));
+        if (!DecodeDirCheckPoint(value, updateTime, dir->mSubDir)) {
+            LOG_WARNING(sLogger, ("failed to decode dir checkpoint, discard it", dirname));
+            continue;
+        }
+        if (updateTime < now - INT32_FLAG(file_check_point_time_out)) {
+            LOG_INFO(sLogger, ("load timeout dir check point, ignore", dirname)(ToString(updateTime), now));
+            continue;
+        }
+        mDirNameMap.insert(make_pair(dirname, dir));
+    }
+
+    const auto& fileCheckPoints = records[CheckpointJournal::FILE_CHECKPOINT];
+    mReaderCount = fileCheckPoints.size();
+    for (const auto& [key, value] : fileCheckPoints) {
+        CheckPoint* ptr = new CheckPoint();
+        if (!DecodeCheckPoint(value, *ptr) || !ptr->mDevInode.IsValid()) {
+            LOG_WARNING(sLogger, ("failed to decode file checkpoint, discard it", key));
+            delete ptr;
+            continue;
+        }
+        AddCheckPoint(ptr);
+    }
+    LOG_INFO(sLogger,
+             ("load checkpoint from journal, version", mLoadVersion)("file check point",
+                                                                     mDevInodeCheckPointPtrMap.size())(
+                 "dir check point", mDirNameMap.size()));
+    return true;
+}
+
 bool CheckPointManager::DumpCheckPointToLocal() {
     mLastDumpTime = time(NULL);
+    if (BOOL_FLAG(enable_checkpoint_journal)) {
+        return DumpCheckPointToJournal();
+    }
+    if (!DumpCheckPointToJson()) {
+        return false;
+    }
+    // the journal is out of date from now on
+    if (GetJournal().Exists()) {
+        GetJournal().Remove();
+    }
+    return true;
+}
+
+bool CheckPointManager::DumpCheckPointToJournal() {
+    auto& journal = GetJournal();
+    if (!Mkdirs(ParentPath(journal.GetPath()))) {
+        LOG_ERROR(sLogger, ("open check point file dir error", journal.GetPath()));
+        AlarmManager::GetInstance()->SendAlarmWarning(CHECKPOINT_ALARM, "open check point file dir failed");
+        return false;
+    }
+
+    CheckpointJournal::Records records;
+    mReaderCount = mDevInodeCheckPointPtrMap.size();
+    auto& fileCheckPoints = records[CheckpointJournal::FILE_CHECKPOINT];
+    auto checkPoints = GetCheckPointsToDump();
+    fileCheckPoints.reserve(checkPoints.size());
+    for (const auto* checkPointPtr : checkPoints) {
+        EncodeCheckPoint(*checkPointPtr, fileCheckPoints[GetCheckPointKey(*checkPointPtr)]);
+    }
+    auto& dirCheckPoints = records[CheckpointJournal::DIR_CHECKPOINT];
+    for (const auto& item : mDirNameMap) {
+        EncodeDirCheckPoint(*item.second, dirCheckPoints[item.first]);
+    }
+
+    if (!journal.Dump(records, INT32_FLAG(check_point_version))) {
+        LOG_ERROR(sLogger, ("dump check point to journal failed", journal.GetPath()));
+        AlarmManager::GetInstance()->SendAlarmWarning(CHECKPOINT_ALARM, "dump check point to journal failed");
+        return false;
+    }
+    LOG_DEBUG(sLogger,
+              ("dump checkpoint to journal, version", INT32_FLAG(check_point_version))(
+                  "file check point", fileCheckPoints.size())("dir check point", dirCheckPoints.size()));
+    return true;
+}
+
+vector<CheckPoint*> CheckPointManager::GetCheckPointsToDump() {
+    vector<CheckPoint*> res;
+    res.reserve(mDevInodeCheckPointPtrMap.size());
+    for (const auto& item : mDevInodeCheckPointPtrMap) {
+        res.push_back(item.second.get());
+    }
+    if (res.size() > (size_t)INT32_FLAG(check_point_max_count)) {
+        sort(res.begin(), res.end(), CheckPointManager::CheckPointCmpByUpdateTime);
+        res.resize(INT32_FLAG(check_point_max_count));
+        LOG_WARNING(sLogger, ("Too many check point", mDevInodeCheckPointPtrMap.size()));
+        AlarmManager::GetInstance()->SendAlarmWarning(
+            CHECKPOINT_ALARM, "Too many check point:" + ToString(mDevInodeCheckPointPtrMap.size()));
+    }
+    return res;
+}
+
+CheckpointJournal& CheckPointManager::GetJournal() {
+    string path = AppConfig::GetInstance()->GetCheckPointFilePath() + ".journal";
+    if (!mJournal || mJournal->GetPath() != path) {
+        mJournal = make_unique<CheckpointJournal>(path);
+    }
+    return *mJournal;
+}
+
+bool CheckPointManager::DumpCheckPointToJson() {
     string checkPointFile = AppConfig::GetInstance()->GetCheckPointFilePath();
     string checkPointTempFile = checkPointFile + ".bak";
 
@@ -575,6 +767,7 @@ void CheckPointManager::RemoveLocalCheckPoint() {
     std::string checkPointFile = AppConfig::GetInstance()->GetCheckPointFilePath();
     if (remove(checkPointFile.c_str()) == -1) {
     }
+    GetJournal().Remove();
 }
 
 void CheckPointManager::PrintStatus() {
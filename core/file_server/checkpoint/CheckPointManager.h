@@ -21,6 +21,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "boost/optional.hpp"
 #include "json/json.h"
@@ -28,6 +29,7 @@
 #include "common/DevInode.h"
 #include "common/EncodingConverter.h"
 #include "common/SplitedFilePath.h"
+#include "file_server/checkpoint/CheckpointJournal.h"
 #include "file_server/reader/LogFileReader.h"
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -125,9 +127,18 @@ private:
     int32_t mLastDumpTime;
     int32_t mLoadVersion;
     int32_t mReaderCount;
+    // used instead of the json file when enable_checkpoint_journal is set
+    std::unique_ptr<CheckpointJournal> mJournal;
     CheckPointManager()
         : mLastCheckTime(time(NULL)), mLastDumpTime(time(NULL)), mLoadVersion(NO_CHECKPOINT_VERSION), mReaderCount(0) {}
 
+    CheckpointJournal& GetJournal();
+    bool LoadCheckPointFromJournal();
+    bool DumpCheckPointToJournal();
+    bool DumpCheckPointToJson();
+    // at most check_point_max_count checkpoints, the most recently updated ones are kept
+    std::vector<CheckPoint*> GetCheckPointsToDump();
+
 public:
     bool CheckVersion();
     void AddCheckPoint(CheckPoint* checkPointPtr);
@@ -158,6 +169,8 @@ public:
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ConfigUpdatorUnittest;
+    friend class CheckpointManagerUnittest;
+    friend class CheckpointJournalBenchmark;
     void RemoveLocalCheckPoint();
     void PrintStatus();
 #endif
@@ -0,0 +1,276 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/checkpoint/CheckpointJournal.h"
+
+#include <cstdio>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "common/Flags.h"
+#include "common/xxhash/xxhash.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(checkpoint_journal_compact_ratio,
+                  "the checkpoint journal is compacted when its size exceeds this times of the size of live records",
+                  4);
+DEFINE_FLAG_INT32(checkpoint_journal_min_compact_size_kb,
+                  "the checkpoint journal smaller than this is never compacted",
+                  1024);
+
+using namespace std;
+
+namespace logtail {
+
+// header: magic + version
+static const char kJournalMagic[8] = {'L', 'C', 'C', 'K', 'P', 'T', 'J', '1'};
+static constexpr size_t kHeaderSize = sizeof(kJournalMagic) + sizeof(uint32_t);
+// record: body size + checksum of body + body, body: op + category + key size + key + value
+static constexpr size_t kRecordHeaderSize = sizeof(uint32_t) + sizeof(uint64_t);
+static constexpr size_t kBodyHeaderSize = sizeof(uint8_t) * 2 + sizeof(uint32_t);
+
+static uint64_t HashValue(const string& value) {
+    return XXH64(value.data(), value.size(), 0);
+}
+
+bool CheckpointJournal::Exists() const {
+    error_code ec;
+    return filesystem::exists(mPath, ec);
+}
+
+bool CheckpointJournal::Load(Records& records, uint32_t& version) {
+    for (auto& item : records) {
+        item.clear();
+    }
+    for (auto& item : mPersisted) {
+        item.clear();
+    }
+    mSize = 0;
+
+    ifstream fin(mPath, ios::binary);
+    if (!fin) {
+        LOG_WARNING(sLogger, ("failed to open checkpoint journal", mPath));
+        return false;
+    }
+    string content((istreambuf_iterator<char>(fin)), istreambuf_iterator<char>());
+    if (content.size() < kHeaderSize || memcmp(content.data(), kJournalMagic, sizeof(kJournalMagic)) != 0) {
+        LOG_WARNING(sLogger, ("invalid checkpoint journal header", mPath)("size", content.size()));
+        return false;
+    }
+    size_t pos = sizeof(kJournalMagic);
+    DecodeInt(content, pos, mVersion);
+    version = mVersion;
+
+    uint64_t recordCnt = 0;
+    while (pos < content.size()) {
+        uint32_t bodySize = 0;
+        uint64_t checksum = 0;
+        if (!DecodeInt(content, pos, bodySize) || !DecodeInt(content, pos, checksum) || content.size() - pos < bodySize
+            || bodySize < kBodyHeaderSize || XXH64(content.data() + pos, bodySize, 0) != checksum) {
+            break;
+        }
+        string body = content.substr(pos, bodySize);
+        pos += bodySize;
+
+        size_t bodyPos = 0;
+        uint8_t op = 0;
+        uint8_t category = 0;
+        string key;
+        DecodeInt(body, bodyPos, op);
+        DecodeInt(body, bodyPos, category);
+        if (!DecodeString(body, bodyPos, key) || op > static_cast<uint8_t>(Op::DEL) || category >= CATEGORY_CNT) {
+            break;
+        }
+        if (static_cast<Op>(op) == Op::PUT) {
+            records[category][key] = body.substr(bodyPos);
+        } else {
+            records[category].erase(key);
+        }
+        ++recordCnt;
+    }
+    if (pos != content.size()) {
+        // the journal is rewritten on next dump, so that nothing is appended after the broken tail
+        LOG_WARNING(sLogger,
+                    ("checkpoint journal has broken tail, discard it", mPath)("valid size", pos)("file size",
+                                                                                               content.size()));
+    } else {
+        mSize = content.size();
+    }
+    for (size_t i = 0; i < CATEGORY_CNT; ++i) {
+        for (const auto& item : records[i]) {
+            mPersisted[i][item.first] = HashValue(item.second);
+        }
+    }
+    LOG_INFO(sLogger,
+             ("load checkpoint journal", mPath)("journal records", recordCnt)(
+                 "file check point", records[FILE_CHECKPOINT].size())("dir check point",
+                                                                      records[DIR_CHECKPOINT].size()));
+    return true;
+}
+
+bool CheckpointJournal::Dump(const Records& records, uint32_t version) {
+    if (mSize == 0 || version != mVersion) {
+        return Compact(records, version);
+    }
+
+    string buf;
+    uint64_t liveSize = kHeaderSize;
+    vector<pair<const string*, uint64_t>> changed[CATEGORY_CNT];
+    vector<string> removed[CATEGORY_CNT];
+    for (size_t i = 0; i < CATEGORY_CNT; ++i) {
+        auto category = static_cast<Category>(i);
+        for (const auto& [key, value] : records[i]) {
+            liveSize += GetRecordSize(key, value);
+            uint64_t hash = HashValue(value);
+            auto it = mPersisted[i].find(key);
+            if (it == mPersisted[i].end() || it->second != hash) {
+                AppendRecord(buf, Op::PUT, category, key, value);
+                changed[i].emplace_back(&key, hash);
+            }
+        }
+        for (const auto& item : mPersisted[i]) {
+            if (records[i].find(item.first) == records[i].end()) {
+                AppendRecord(buf, Op::DEL, category, item.first, "");
+                removed[i].emplace_back(item.first);
+            }
+        }
+    }
+    if (buf.empty()) {
+        return true;
+    }
+    uint64_t newSize = mSize + buf.size();
+    if (newSize > static_cast<uint64_t>(INT32_FLAG(checkpoint_journal_min_compact_size_kb)) * 1024
+        && newSize > liveSize * max(INT32_FLAG(checkpoint_journal_compact_ratio), 1)) {
+        return Compact(records, version);
+    }
+
+    ofstream fout(mPath, ios::binary | ios::app);
+    if (!fout || !fout.write(buf.data(), buf.size()) || !fout.flush()) {
+        LOG_ERROR(sLogger, ("failed to append checkpoint journal", mPath)("errno", errno));
+        // the tail may be partially written
+        mSize = 0;
+        return false;
+    }
+    mSize = newSize;
+    for (size_t i = 0; i < CATEGORY_CNT; ++i) {
+        for (const auto& item : changed[i]) {
+            mPersisted[i][*item.first] = item.second;
+        }
+        for (const auto& key : removed[i]) {
+            mPersisted[i].erase(key);
+        }
+    }
+    LOG_DEBUG(sLogger,
+              ("append checkpoint journal", mPath)("changed file check point", changed[FILE_CHECKPOINT].size())(
+                  "removed file check point", removed[FILE_CHECKPOINT].size())("journal size", mSize));
+    return true;
+}
+
+bool CheckpointJournal::Compact(const Records& records, uint32_t version) {
+    if (!WriteSnapshot(records, version)) {
+        mSize = 0;
+        return false;
+    }
+    mVersion = version;
+    for (size_t i = 0; i < CATEGORY_CNT; ++i) {
+        mPersisted[i].clear();
+        mPersisted[i].reserve(records[i].size());
+        for (const auto& [key, value] : records[i]) {
+            mPersisted[i][key] = HashValue(value);
+        }
+    }
+    LOG_INFO(sLogger,
+             ("compact checkpoint journal", mPath)("file check point", records[FILE_CHECKPOINT].size())(
+                 "dir check point", records[DIR_CHECKPOINT].size())("journal size", mSize));
+    return true;
+}
+
+void CheckpointJournal::Remove() {
+    error_code ec;
+    filesystem::remove(mPath, ec);
+    for (auto& item : mPersisted) {
+        item.clear();
+    }
+    mSize = 0;
+}
+
+void CheckpointJournal::EncodeString(string& buf, const string& value) {
+    EncodeInt(buf, static_cast<uint32_t>(value.size()));
+    buf.append(value);
+}
+
+bool CheckpointJournal::DecodeString(const string& buf, size_t& pos, string& value) {
+    uint32_t size = 0;
+    if (!DecodeInt(buf, pos, size) || buf.size() - pos < size) {
+        return false;
+    }
+    value.assign(buf.data() + pos, size);
+    pos += size;
+    return true;
+}
+
+void CheckpointJournal::AppendRecord(string& buf, Op op, Category category, const string& key, const string& value) {
+    size_t start = buf.size();
+    // checksum is filled after the body is appended
+    EncodeInt(buf, static_cast<uint32_t>(kBodyHeaderSize + key.size() + value.size()));
+    EncodeInt(buf, static_cast<uint64_t>(0));
+    EncodeInt(buf, static_cast<uint8_t>(op));
+    EncodeInt(buf, static_cast<uint8_t>(category));
+    EncodeString(buf, key);
+    buf.append(value);
+    uint64_t checksum = XXH64(buf.data() + start + kRecordHeaderSize, buf.size() - start - kRecordHeaderSize, 0);
+    memcpy(&buf[start + sizeof(uint32_t)], &checksum, sizeof(checksum));
+}
+
+uint64_t CheckpointJournal::GetRecordSize(const string& key, const string& value) {
+    return kRecordHeaderSize + kBodyHeaderSize + key.size() + value.size();
+}
+
+bool CheckpointJournal::WriteSnapshot(const Records& records, uint32_t version) {
+    string buf(kJournalMagic, sizeof(kJournalMagic));
+    EncodeInt(buf, version);
+    for (size_t i = 0; i < CATEGORY_CNT; ++i) {
+        for (const auto& [key, value] : records[i]) {
+            AppendRecord(buf, Op::PUT, static_cast<Category>(i), key, value);
+        }
+    }
+
+    string tmpPath = mPath + ".bak";
+    {
+        ofstream fout(tmpPath, ios::binary | ios::trunc);
+        if (!fout || !fout.write(buf.data(), buf.size()) || !fout.flush()) {
+            LOG_ERROR(sLogger, ("failed to write checkpoint journal", tmpPath)("errno", errno));
+            return false;
+        }
+    }
+#if defined(_MSC_VER)
+    // The rename on Windows will fail if the destination is existing.
+    remove(mPath.c_str());
+    this_thread::sleep_for(chrono::milliseconds(1));
+#endif
+    if (rename(tmpPath.c_str(), mPath.c_str()) == -1) {
+        LOG_ERROR(sLogger, ("failed to rename checkpoint journal", mPath)("errno", errno));
+        return false;
+    }
+    mSize = buf.size();
+    return true;
+}
+
+} // namespace logtail
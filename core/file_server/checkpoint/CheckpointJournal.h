@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <array>
+#include <string>
+#include <unordered_map>
+
+namespace logtail {
+
+// Append-only binary journal of checkpoint records. Each dump appends only the records whose values have changed since
+// the last dump, together with the deletions of records no longer present. When the journal grows too large compared
+// with the live records, it is compacted into a snapshot of the live records by writing a temp file and renaming it.
+// Each record carries a checksum, so that records torn by a crash are detected and dropped on load.
+class CheckpointJournal {
+public:
+    enum Category : uint8_t { FILE_CHECKPOINT = 0, DIR_CHECKPOINT = 1, CATEGORY_CNT = 2 };
+    // key -> encoded value, for each category
+    using Records = std::array<std::unordered_map<std::string, std::string>, CATEGORY_CNT>;
+
+    explicit CheckpointJournal(const std::string& path) : mPath(path) {}
+
+    bool Exists() const;
+    // version is the one given by the last compaction
+    bool Load(Records& records, uint32_t& version);
+    bool Dump(const Records& records, uint32_t version);
+    bool Compact(const Records& records, uint32_t version);
+    void Remove();
+
+    const std::string& GetPath() const { return mPath; }
+    uint64_t GetSize() const { return mSize; }
+
+    // helpers for encoding values, integers are stored in host byte order since the journal is never shipped
+    template <typename T>
+    static void EncodeInt(std::string& buf, T value) {
+        buf.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    static void EncodeString(std::string& buf, const std::string& value);
+    template <typename T>
+    static bool DecodeInt(const std::string& buf, size_t& pos, T& value) {
+        if (buf.size() - pos < sizeof(T)) {
+            return false;
+        }
+        memcpy(&value, buf.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+    static bool DecodeString(const std::string& buf, size_t& pos, std::string& value);
+
+private:
+    enum class Op : uint8_t { PUT = 0, DEL = 1 };
+
+    static void
+    AppendRecord(std::string& buf, Op op, Category category, const std::string& key, const std::string& value);
+    static uint64_t GetRecordSize(const std::string& key, const std::string& value);
+    bool WriteSnapshot(const Records& records, uint32_t version);
+
+    std::string mPath;
+    uint32_t mVersion = 0;
+    // hash of each persisted value, used to find out the changed records
+    std::array<std::unordered_map<std::string, uint64_t>, CATEGORY_CNT> mPersisted;
+    // size of the journal file, 0 means the journal must be compacted before anything is appended
+    uint64_t mSize = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class CheckpointJournalUnittest;
+#endif
+};
+
+} // namespace logtail
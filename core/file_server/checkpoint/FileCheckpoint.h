@@ -20,6 +20,7 @@
 
 #include <filesystem>
 #include <string>
+#include <vector>
 
 #include "common/DevInode.h"
 
@@ -36,6 +37,18 @@ enum class FileStatus {
 const std::string& FileStatusToString(FileStatus status);
 FileStatus GetFileStatusFromString(const std::string& status);
 
+// A line-aligned byte range [mBegin, mEnd) of a file, read independently in bulk mode.
+struct FileRangeCheckpoint {
+    uint64_t mBegin = 0;
+    uint64_t mEnd = 0;
+    uint64_t mOffset = 0;
+
+    FileRangeCheckpoint() = default;
+    FileRangeCheckpoint(uint64_t begin, uint64_t end) : mBegin(begin), mEnd(end), mOffset(begin) {}
+
+    bool IsFinished() const { return mOffset >= mEnd; }
+};
+
 struct FileCheckpoint {
     std::filesystem::path mFilePath;
     // std::string mRealFileName;
@@ -47,6 +60,8 @@ struct FileCheckpoint {
     FileStatus mStatus = FileStatus::WAITING;
     int32_t mStartTime = 0;
     int32_t mLastUpdateTime = 0;
+    // only used in bulk mode, empty means the file is read sequentially
+    std::vector<FileRangeCheckpoint> mRanges;
 
     FileCheckpoint() = default;
     FileCheckpoint(const std::filesystem::path& filename,
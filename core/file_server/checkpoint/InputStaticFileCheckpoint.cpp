@@ -172,6 +172,140 @@ void InputStaticFileCheckpoint::SetAbort() {
     }
 }
 
+void InputStaticFileCheckpoint::GetUnfinishedFiles(size_t maxCnt,
+                                                   vector<pair<size_t, FileCheckpoint>>& res) const {
+    if (mStatus != StaticFileReadingStatus::RUNNING) {
+        return;
+    }
+    for (size_t i = mCurrentFileIndex; i < mFileCheckpoints.size() && res.size() < maxCnt; ++i) {
+        const auto& fileCpt = mFileCheckpoints[i];
+        if (fileCpt.mStatus == FileStatus::WAITING || fileCpt.mStatus == FileStatus::READING) {
+            res.emplace_back(i, fileCpt);
+        }
+    }
+}
+
+bool InputStaticFileCheckpoint::SetFileRanges(size_t fileIdx, uint64_t size, vector<FileRangeCheckpoint>&& ranges) {
+    if (fileIdx >= mFileCheckpoints.size()) {
+        // should not happen
+        return false;
+    }
+    auto& fileCpt = mFileCheckpoints[fileIdx];
+    if (fileCpt.mStatus == FileStatus::READING && fileCpt.mRanges.empty()) {
+        // file partially read in sequential mode before, ranges start from the recorded offset
+        fileCpt.mLastUpdateTime = time(nullptr);
+    } else if (fileCpt.mStatus == FileStatus::WAITING) {
+        fileCpt.mStatus = FileStatus::READING;
+        fileCpt.mStartTime = time(nullptr);
+        fileCpt.mLastUpdateTime = fileCpt.mStartTime;
+        fileCpt.mOffset = 0;
+    } else {
+        // should not happen
+        return false;
+    }
+    fileCpt.mSize = size;
+    fileCpt.mRanges = std::move(ranges);
+    LOG_INFO(sLogger,
+             ("begin to read file in bulk mode, config", mConfigName)("input idx", mInputIdx)("file idx", fileIdx)(
+                 "filepath", fileCpt.mFilePath.string())("device", fileCpt.mDevInode.dev)(
+                 "inode", fileCpt.mDevInode.inode)("size", size)("range count", fileCpt.mRanges.size()));
+    if (fileCpt.mRanges.empty()) {
+        // empty file
+        fileCpt.mStatus = FileStatus::FINISHED;
+        MoveToNextUnfinishedFile();
+    }
+    return true;
+}
+
+bool InputStaticFileCheckpoint::UpdateFileRangeCheckpoint(size_t fileIdx,
+                                                          size_t rangeIdx,
+                                                          uint64_t offset,
+                                                          bool& needDump) {
+    needDump = false;
+    if (fileIdx >= mFileCheckpoints.size()) {
+        // should not happen
+        return false;
+    }
+    auto& fileCpt = mFileCheckpoints[fileIdx];
+    if (fileCpt.mStatus != FileStatus::READING || rangeIdx >= fileCpt.mRanges.size()) {
+        // should not happen
+        return false;
+    }
+    auto& range = fileCpt.mRanges[rangeIdx];
+    if (offset < range.mOffset || offset > range.mEnd) {
+        // should not happen
+        return false;
+    }
+    fileCpt.mOffset += offset - range.mOffset;
+    range.mOffset = offset;
+    fileCpt.mLastUpdateTime = time(nullptr);
+    if (!range.IsFinished()) {
+        return true;
+    }
+    needDump = true;
+    for (const auto& item : fileCpt.mRanges) {
+        if (!item.IsFinished()) {
+            return true;
+        }
+    }
+    fileCpt.mStatus = FileStatus::FINISHED;
+    fileCpt.mRanges.clear();
+    LOG_INFO(sLogger,
+             ("file read done, config", mConfigName)("input idx", mInputIdx)("file idx", fileIdx)(
+                 "filepath", fileCpt.mFilePath.string())("device", fileCpt.mDevInode.dev)(
+                 "inode", fileCpt.mDevInode.inode)("size", fileCpt.mSize));
+    MoveToNextUnfinishedFile();
+    return true;
+}
+
+bool InputStaticFileCheckpoint::GetFileRangeCheckpoint(size_t fileIdx,
+                                                       size_t rangeIdx,
+                                                       FileRangeCheckpoint* res) const {
+    if (fileIdx >= mFileCheckpoints.size()) {
+        return false;
+    }
+    const auto& fileCpt = mFileCheckpoints[fileIdx];
+    if (fileCpt.mStatus != FileStatus::READING || rangeIdx >= fileCpt.mRanges.size()) {
+        return false;
+    }
+    *res = fileCpt.mRanges[rangeIdx];
+    return !res->IsFinished();
+}
+
+bool InputStaticFileCheckpoint::InvalidateFileCheckpoint(size_t fileIdx) {
+    if (fileIdx >= mFileCheckpoints.size()) {
+        // should not happen
+        return false;
+    }
+    auto& fileCpt = mFileCheckpoints[fileIdx];
+    if (fileCpt.mStatus == FileStatus::ABORT || fileCpt.mStatus == FileStatus::FINISHED) {
+        // may happen when several ranges of the same file fail concurrently
+        return false;
+    }
+    fileCpt.mStatus = FileStatus::ABORT;
+    fileCpt.mLastUpdateTime = time(nullptr);
+    fileCpt.mRanges.clear();
+    LOG_WARNING(sLogger,
+                ("file read abort, config", mConfigName)("input idx", mInputIdx)("file idx", fileIdx)(
+                    "filepath", fileCpt.mFilePath.string())("device", fileCpt.mDevInode.dev)(
+                    "inode", fileCpt.mDevInode.inode)("read bytes", fileCpt.mOffset));
+    MoveToNextUnfinishedFile();
+    return true;
+}
+
+void InputStaticFileCheckpoint::MoveToNextUnfinishedFile() {
+    while (mCurrentFileIndex < mFileCheckpoints.size()
+           && (mFileCheckpoints[mCurrentFileIndex].mStatus == FileStatus::FINISHED
+               || mFileCheckpoints[mCurrentFileIndex].mStatus == FileStatus::ABORT)) {
+        ++mCurrentFileIndex;
+    }
+    if (mCurrentFileIndex == mFileCheckpoints.size() && mStatus == StaticFileReadingStatus::RUNNING) {
+        mStatus = StaticFileReadingStatus::FINISHED;
+        mFinishTime = time(nullptr);
+        LOG_INFO(sLogger, ("all files read done, config", mConfigName)("input idx", mInputIdx));
+    }
+}
+
 bool InputStaticFileCheckpoint::Serialize(string* res) const {
     if (!res) {
         // should not happen
@@ -213,6 +347,17 @@ bool InputStaticFileCheckpoint::Serialize(string* res) const {
                 file["offset"] = cpt.mOffset;
                 file["start_time"] = cpt.mStartTime;
                 file["last_read_time"] = cpt.mLastUpdateTime;
+                if (!cpt.mRanges.empty()) {
+                    file["ranges"] = Json::arrayValue;
+                    auto& ranges = file["ranges"];
+                    for (const auto& range : cpt.mRanges) {
+                        Json::Value item;
+                        item["begin"] = range.mBegin;
+                        item["end"] = range.mEnd;
+                        item["offset"] = range.mOffset;
+                        ranges.append(std::move(item));
+                    }
+                }
                 break;
             case FileStatus::FINISHED:
                 file["size"] = cpt.mSize;
@@ -231,6 +376,45 @@ bool InputStaticFileCheckpoint::Serialize(string* res) const {
     return true;
 }
 
+static bool DeserializeFileRanges(const Json::Value& fileCpt,
+                                  const string& outerKey,
+                                  vector<FileRangeCheckpoint>& ranges,
+                                  string& errMsg) {
+    const char* key = "ranges";
+    auto it = fileCpt.find(key, key + strlen(key));
+    if (!it) {
+        return true;
+    }
+    if (!it->isArray()) {
+        errMsg = "optional param " + outerKey + ".ranges is not of type array";
+        return false;
+    }
+    for (Json::Value::ArrayIndex i = 0; i < it->size(); ++i) {
+        const Json::Value& rangeCpt = (*it)[i];
+        string rangeKey = outerKey + ".ranges[" + ToString(i) + "]";
+        if (!rangeCpt.isObject()) {
+            errMsg = "mandatory param " + rangeKey + " is not of type object";
+            return false;
+        }
+        FileRangeCheckpoint range;
+        if (!GetMandatoryUInt64Param(rangeCpt, rangeKey + ".begin", range.mBegin, errMsg)) {
+            return false;
+        }
+        if (!GetMandatoryUInt64Param(rangeCpt, rangeKey + ".end", range.mEnd, errMsg)) {
+            return false;
+        }
+        if (!GetMandatoryUInt64Param(rangeCpt, rangeKey + ".offset", range.mOffset, errMsg)) {
+            return false;
+        }
+        if (range.mBegin > range.mEnd || range.mOffset < range.mBegin || range.mOffset > range.mEnd) {
+            errMsg = "mandatory param " + rangeKey + " is not valid";
+            return false;
+        }
+        ranges.emplace_back(range);
+    }
+    return true;
+}
+
 bool InputStaticFileCheckpoint::Deserialize(const string& str, string* errMsg) {
     if (!errMsg) {
         // should not happen
@@ -351,6 +535,9 @@ bool InputStaticFileCheckpoint::Deserialize(const string& str, string* errMsg) {
                 if (!GetMandatoryIntParam(fileCpt, outerKey + ".last_read_time", cpt.mLastUpdateTime, *errMsg)) {
                     return false;
                 }
+                if (!DeserializeFileRanges(fileCpt, outerKey, cpt.mRanges, *errMsg)) {
+                    return false;
+                }
                 break;
             case FileStatus::FINISHED:
                 if (!GetMandatoryUInt64Param(fileCpt, outerKey + ".size", cpt.mSize, *errMsg)) {
@@ -48,6 +48,14 @@ public:
     bool GetCurrentFileFingerprint(FileFingerprint* cpt);
     void SetAbort();
 
+    // bulk mode, where several files and several ranges of one file can be read concurrently
+    bool IsRunning() const { return mStatus == StaticFileReadingStatus::RUNNING; }
+    void GetUnfinishedFiles(size_t maxCnt, std::vector<std::pair<size_t, FileCheckpoint>>& res) const;
+    bool SetFileRanges(size_t fileIdx, uint64_t size, std::vector<FileRangeCheckpoint>&& ranges);
+    bool UpdateFileRangeCheckpoint(size_t fileIdx, size_t rangeIdx, uint64_t offset, bool& needDump);
+    bool GetFileRangeCheckpoint(size_t fileIdx, size_t rangeIdx, FileRangeCheckpoint* res) const;
+    bool InvalidateFileCheckpoint(size_t fileIdx);
+
     bool Serialize(std::string* res) const;
     bool Deserialize(const std::string& str, std::string* errMsg);
     bool SerializeToLogEvents() const;
@@ -56,6 +64,8 @@ public:
     size_t GetInputIndex() const { return mInputIdx; }
 
 private:
+    void MoveToNextUnfinishedFile();
+
     std::string mConfigName;
     size_t mInputIdx = 0;
     std::vector<FileCheckpoint> mFileCheckpoints;
@@ -234,6 +234,106 @@ bool InputStaticFileCheckpointManager::GetCurrentFileFingerprint(const string& c
     return it->second.GetCurrentFileFingerprint(cpt);
 }
 
+bool InputStaticFileCheckpointManager::GetUnfinishedFiles(const string& configName,
+                                                          size_t idx,
+                                                          size_t maxCnt,
+                                                          vector<pair<size_t, FileCheckpoint>>* res) {
+    if (!res) {
+        // should not happen
+        return false;
+    }
+    lock_guard<mutex> lock(mUpdateMux);
+    auto it = mInputCheckpointMap.find(make_pair(configName, idx));
+    if (it == mInputCheckpointMap.end()) {
+        // should not happen
+        return false;
+    }
+    if (!it->second.IsRunning()) {
+        return false;
+    }
+    it->second.GetUnfinishedFiles(maxCnt, *res);
+    return true;
+}
+
+bool InputStaticFileCheckpointManager::SetFileRanges(
+    const string& configName, size_t idx, size_t fileIdx, uint64_t size, vector<FileRangeCheckpoint>&& ranges) {
+    lock_guard<mutex> lock(mUpdateMux);
+    auto it = mInputCheckpointMap.find(make_pair(configName, idx));
+    if (it == mInputCheckpointMap.end()) {
+        // should not happen
+        return false;
+    }
+    if (!it->second.SetFileRanges(fileIdx, size, std::move(ranges))) {
+        // should not happen
+        return false;
+    }
+    if (!DumpCheckpointFile(it->second)) {
+        LOG_WARNING(sLogger,
+                    ("failed to set file ranges",
+                     "failed to dump checkpoint file")("config", configName)("input idx", idx));
+        return false;
+    }
+    return true;
+}
+
+bool InputStaticFileCheckpointManager::UpdateFileRangeCheckpoint(
+    const string& configName, size_t idx, size_t fileIdx, size_t rangeIdx, uint64_t offset) {
+    lock_guard<mutex> lock(mUpdateMux);
+    auto it = mInputCheckpointMap.find(make_pair(configName, idx));
+    if (it == mInputCheckpointMap.end()) {
+        // may happen when the input is removed while ranges are still being read
+        return false;
+    }
+    bool needDump = false;
+    if (!it->second.UpdateFileRangeCheckpoint(fileIdx, rangeIdx, offset, needDump)) {
+        // should not happen
+        return false;
+    }
+    if (needDump) {
+        if (!DumpCheckpointFile(it->second)) {
+            LOG_WARNING(sLogger,
+                        ("failed to update file range checkpoint",
+                         "failed to dump checkpoint file")("config", configName)("input idx", idx));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InputStaticFileCheckpointManager::GetFileRangeCheckpoint(
+    const string& configName, size_t idx, size_t fileIdx, size_t rangeIdx, FileRangeCheckpoint* res) {
+    if (!res) {
+        // should not happen
+        return false;
+    }
+    lock_guard<mutex> lock(mUpdateMux);
+    auto it = mInputCheckpointMap.find(make_pair(configName, idx));
+    if (it == mInputCheckpointMap.end()) {
+        return false;
+    }
+    return it->second.GetFileRangeCheckpoint(fileIdx, rangeIdx, res);
+}
+
+bool InputStaticFileCheckpointManager::InvalidateFileCheckpoint(const string& configName,
+                                                                size_t idx,
+                                                                size_t fileIdx) {
+    lock_guard<mutex> lock(mUpdateMux);
+    auto it = mInputCheckpointMap.find(make_pair(configName, idx));
+    if (it == mInputCheckpointMap.end()) {
+        return false;
+    }
+    if (!it->second.InvalidateFileCheckpoint(fileIdx)) {
+        return false;
+    }
+    if (!DumpCheckpointFile(it->second)) {
+        LOG_WARNING(sLogger,
+                    ("failed to update file checkpoint",
+                     "failed to dump checkpoint file")("config", configName)("input idx", idx));
+        return false;
+    }
+    return true;
+}
+
 void InputStaticFileCheckpointManager::DumpAllCheckpointFiles() const {
     lock_guard<mutex> lock(mUpdateMux);
     for (const auto& item : mInputCheckpointMap) {
@@ -52,6 +52,23 @@ public:
     bool InvalidateCurrentFileCheckpoint(const std::string& configName, size_t idx);
     bool GetCurrentFileFingerprint(const std::string& configName, size_t idx, FileFingerprint* cpt);
 
+    // bulk mode
+    bool GetUnfinishedFiles(const std::string& configName,
+                            size_t idx,
+                            size_t maxCnt,
+                            std::vector<std::pair<size_t, FileCheckpoint>>* res);
+    bool SetFileRanges(const std::string& configName,
+                       size_t idx,
+                       size_t fileIdx,
+                       uint64_t size,
+                       std::vector<FileRangeCheckpoint>&& ranges);
+    bool UpdateFileRangeCheckpoint(
+        const std::string& configName, size_t idx, size_t fileIdx, size_t rangeIdx, uint64_t offset);
+    // returns false if the range no longer needs to be read, e.g., its file has been finished or invalidated
+    bool GetFileRangeCheckpoint(
+        const std::string& configName, size_t idx, size_t fileIdx, size_t rangeIdx, FileRangeCheckpoint* res);
+    bool InvalidateFileCheckpoint(const std::string& configName, size_t idx, size_t fileIdx);
+
     void DumpAllCheckpointFiles() const;
     void GetAllCheckpointFileNames();
     void ClearUnusedCheckpoints();
@@ -201,6 +201,35 @@ bool CreateModifyHandler::IsAllFileRead() {
     return true;
 }
 
+void CreateModifyHandler::RemoveReaders(const std::unordered_set<std::string>& configNames) {
+    for (ModifyHandlerMap::iterator iter = mModifyHandlerPtrMap.begin(); iter != mModifyHandlerPtrMap.end();) {
+        if (configNames.find(iter->first) == configNames.end()) {
+            ++iter;
+            continue;
+        }
+        iter->second->DumpReaderMeta(true, true);
+        iter->second->DumpReaderMeta(false, true);
+        delete iter->second;
+        iter = mModifyHandlerPtrMap.erase(iter);
+    }
+}
+
+void CreateModifyHandler::CollectReaders(const Event& event, std::vector<LogFileReaderPtr>& readers) {
+    if (!event.IsModify() || event.IsDir()) {
+        return;
+    }
+    if (!event.GetConfigName().empty()) {
+        auto iter = mModifyHandlerPtrMap.find(event.GetConfigName());
+        if (iter != mModifyHandlerPtrMap.end()) {
+            iter->second->CollectReaders(event, readers);
+        }
+        return;
+    }
+    for (auto& item : mModifyHandlerPtrMap) {
+        item.second->CollectReaders(event, readers);
+    }
+}
+
 ModifyHandler* CreateModifyHandler::GetOrCreateModifyHandler(const std::string& configName,
                                                              const FileDiscoveryConfig& pConfig) {
     ModifyHandlerMap::iterator iter = mModifyHandlerPtrMap.find(configName);
@@ -1079,6 +1108,29 @@ bool ModifyHandler::IsAllFileRead() {
     return true;
 }
 
+void ModifyHandler::CollectReaders(const Event& event, std::vector<LogFileReaderPtr>& readers) {
+    if (!event.IsModify()) {
+        return;
+    }
+    // the reader at the head of the reader array is the one read by Handle, unless the file has been rotated
+    LogFileReaderPtrArray* readerArray = nullptr;
+    DevInode devInode(event.GetDev(), event.GetInode());
+    if (devInode.IsValid()) {
+        auto iter = mDevInodeReaderMap.find(devInode);
+        if (iter != mDevInodeReaderMap.end()) {
+            readerArray = iter->second->GetReaderArray();
+        }
+    } else {
+        auto iter = mNameReaderMap.find(event.GetEventObject());
+        if (iter != mNameReaderMap.end()) {
+            readerArray = &iter->second;
+        }
+    }
+    if (readerArray != nullptr && !readerArray->empty()) {
+        readers.push_back((*readerArray)[0]);
+    }
+}
+
 void ModifyHandler::DeleteTimeoutReader() {
     if ((int32_t)mDevInodeReaderMap.size() > INT32_FLAG(logreader_count_maxlimit))
         DeleteTimeoutReader(86400);
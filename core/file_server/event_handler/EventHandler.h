@@ -20,6 +20,8 @@
 #include <deque>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "file_server/reader/LogFileReader.h"
 
@@ -40,6 +42,10 @@ public:
     virtual void HandleTimeOut() = 0;
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) = 0;
     virtual bool IsAllFileRead() { return true; }
+    // dump meta of the readers belonging to the configs, and then remove the readers
+    virtual void RemoveReaders(const std::unordered_set<std::string>& configNames) {}
+    // collects the readers to be read on the event without touching the file system, so that they can be read ahead
+    virtual void CollectReaders(const Event& event, std::vector<LogFileReaderPtr>& readers) {}
     virtual ~EventHandler() {}
 };
 
@@ -113,6 +119,7 @@ public:
     virtual void HandleTimeOut();
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag);
     bool IsAllFileRead() override;
+    void CollectReaders(const Event& event, std::vector<LogFileReaderPtr>& readers) override;
     const std::string& GetConfigName() const { return mConfigName; }
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -171,6 +178,8 @@ public:
     virtual void HandleTimeOut();
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag);
     bool IsAllFileRead() override;
+    void RemoveReaders(const std::unordered_set<std::string>& configNames) override;
+    void CollectReaders(const Event& event, std::vector<LogFileReaderPtr>& readers) override;
 
     ModifyHandler* GetOrCreateModifyHandler(const std::string& configName, const FileDiscoveryConfig& pConfig);
 
@@ -181,6 +190,7 @@ public:
     friend class SenderUnittest;
     friend class EventDispatcherContainerUnittest;
     friend class LogInputReaderUnittest;
+    friend class FileServerUnittest;
 #endif
 };
 
@@ -39,6 +39,7 @@
 #include "file_server/reader/LogFileReader.h"
 #include "logger/Logger.h"
 #include "monitor/AlarmManager.h"
+#include "monitor/CpuProfiler.h"
 #include "monitor/Monitor.h"
 
 using namespace std;
@@ -56,6 +57,8 @@ DEFINE_FLAG_INT32(read_local_event_interval, "seconds", 60);
 DEFINE_FLAG_BOOL(force_close_file_on_container_stopped,
                  "whether close file handler immediately when associate container stopped",
                  false);
+DECLARE_FLAG_BOOL(enable_batch_file_read);
+DECLARE_FLAG_INT32(batch_file_read_max_files);
 
 
 namespace logtail {
@@ -344,6 +347,43 @@ void LogInput::ProcessEvent(EventDispatcher* dispatcher, Event* ev) {
     delete ev;
 }
 
+void LogInput::ProcessEventBatch(EventDispatcher* dispatcher, Event* ev) {
+    // events are popped before being read ahead, so that modify events coming after the read are not merged
+    vector<Event*> events{ev};
+    while (events.size() < static_cast<size_t>(INT32_FLAG(batch_file_read_max_files))) {
+        Event* next = PopEventQueue();
+        if (next == NULL) {
+            break;
+        }
+        events.push_back(next);
+    }
+    mEventProcessCount += events.size() - 1;
+
+    vector<LogFileReaderPtr> readers;
+    for (const auto* event : events) {
+        if (!event->IsModify() || event->IsDir()) {
+            continue;
+        }
+        EventHandler* handler = dispatcher->GetHandler(event->GetSource().c_str());
+        if (handler != NULL) {
+            handler->CollectReaders(*event, readers);
+        }
+    }
+    mBatchFileReader.Read(readers);
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (IsInterupt()) {
+            // leave the rest to be processed after the main thread is resumed
+            for (size_t j = i; j < events.size(); ++j) {
+                PushEventQueue(events[j]);
+            }
+            break;
+        }
+        ProcessEvent(dispatcher, events[i]);
+    }
+    mBatchFileReader.Clear();
+}
+
 void LogInput::UpdateCriticalMetric(int32_t curTime) {
     SET_GAUGE(mLastRunTime, mLastReadEventTime.load());
     LoongCollectorMonitor::GetInstance()->SetAgentOpenFdTotal(
@@ -356,6 +396,7 @@ void LogInput::UpdateCriticalMetric(int32_t curTime) {
 
 void LogInput::ProcessLoop() {
     LOG_INFO(sLogger, ("event handle daemon", "started"));
+    CpuProfiler::GetInstance()->RegisterThread("log_input");
     EventDispatcher* dispatcher = EventDispatcher::GetInstance();
     dispatcher->StartTimeCount();
     int32_t prevTime = time(NULL);
@@ -383,6 +424,8 @@ void LogInput::ProcessLoop() {
             ++mEventProcessCount;
             if (mIdleFlag) {
                 delete ev;
+            } else if (BOOL_FLAG(enable_batch_file_read)) {
+                ProcessEventBatch(dispatcher, ev);
             } else
                 ProcessEvent(dispatcher, ev);
         } else {
@@ -461,6 +504,7 @@ void LogInput::ProcessLoop() {
         }
     }
 
+    CpuProfiler::GetInstance()->UnregisterThread();
     mInteruptFlag = true;
 }
 
@@ -25,6 +25,7 @@
 
 #include "common/Lock.h"
 #include "common/LogRunnable.h"
+#include "file_server/reader/BatchFileReader.h"
 #include "monitor/Monitor.h"
 
 namespace logtail {
@@ -67,6 +68,8 @@ private:
     ~LogInput();
     void ProcessLoop();
     void ProcessEvent(EventDispatcher* dispatcher, Event* ev);
+    // processes ev and the events following it, with the files of modify events read ahead in one batch
+    void ProcessEventBatch(EventDispatcher* dispatcher, Event* ev);
     Event* PopEventQueue();
     void UpdateCriticalMetric(int32_t curTime);
 
@@ -81,6 +84,7 @@ private:
     volatile bool mIdleFlag;
     int32_t mEventProcessCount;
     int32_t mLastUpdateMetricTime;
+    BatchFileReader mBatchFileReader;
 
     IntGaugePtr mLastRunTime;
     IntGaugePtr mRegisterdHandlersTotal;
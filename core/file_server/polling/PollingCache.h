@@ -19,6 +19,7 @@
 
 #include <deque>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -50,6 +51,16 @@ struct DirFileCache {
     void SetLastEventTime(int32_t curTime) { mLastEventTime = curTime; }
     int32_t GetLastEventTime() const { return mLastEventTime; }
 
+    void SetInode(uint64_t inode) { mInode = inode; }
+    uint64_t GetInode() const { return mInode; }
+
+    // Only for directory, names of the sub directories found when the directory was read completely last time.
+    void SetSubDirs(std::vector<std::string>&& subDirs) {
+        mSubDirs = std::make_unique<std::vector<std::string>>(std::move(subDirs));
+    }
+    const std::vector<std::string>* GetSubDirs() const { return mSubDirs.get(); }
+    void ClearSubDirs() { mSubDirs.reset(); }
+
 private:
     // It indicates if the related file/dir has generated event.
     bool mEventFlag = false;
@@ -61,6 +72,8 @@ private:
     uint64_t mLastCheckRound = 0;
     // Last modified time on filesystem in nanoseconds.
     int64_t mLastModifyTime = 0;
+    uint64_t mInode = 0;
+    std::unique_ptr<std::vector<std::string>> mSubDirs;
 };
 
 typedef std::unordered_map<std::string, DirFileCache> DirCheckCacheMap;
@@ -21,6 +21,8 @@
 #endif
 #include <sys/stat.h>
 
+#include <functional>
+
 #include "app_config/AppConfig.h"
 #include "common/ErrorUtil.h"
 #include "common/FileSystemUtil.h"
@@ -59,6 +61,12 @@ DEFINE_FLAG_INT32(polling_max_stat_count, "max stat count in each round", 100000
 DEFINE_FLAG_INT32(polling_max_stat_count_per_dir, "max stat count per dir in each round", 100000);
 DEFINE_FLAG_INT32(polling_max_stat_count_per_config, "max stat count per config in each round", 100000);
 DEFINE_FLAG_INT32(polling_modify_repush_interval, "polling modify event repush interval, seconds", 10);
+DEFINE_FLAG_BOOL(enable_polling_dir_prune,
+                 "do not read directories whose modify time and inode are unchanged since last polling",
+                 false);
+// Each directory is still read every N rounds, spread over rounds by its path, to find files modified in place.
+// It should be less than delete_dir_file_round, otherwise cache items of unchanged files would be removed.
+DEFINE_FLAG_INT32(polling_dir_full_scan_round, "read unchanged directory every N rounds", 12);
 DECLARE_FLAG_INT32(wildcard_max_sub_dir_count);
 
 using namespace std;
@@ -293,10 +301,12 @@ void PollingDirFile::PollingIteration() {
 bool PollingDirFile::CheckAndUpdateDirMatchCache(const string& dirPath,
                                                  const fsutil::PathStat& statBuf,
                                                  bool exceedPreservedDirDepth,
-                                                 bool& newFlag) {
+                                                 bool& newFlag,
+                                                 optional<vector<string>>& unchangedSubDirs) {
     int64_t sec, nsec;
     statBuf.GetLastWriteTime(sec, nsec);
     int64_t modifyTime = NANO_CONVERTING * sec + nsec;
+    uint64_t inode = statBuf.GetDevInode().inode;
 
     ScopedSpinLock lock(mCacheLock);
     auto iter = mDirCacheMap.find(dirPath);
@@ -308,6 +318,7 @@ bool PollingDirFile::CheckAndUpdateDirMatchCache(const string& dirPath,
         dirCache.SetExceedPreservedDirDepth(exceedPreservedDirDepth);
         dirCache.SetCheckRound(mCurrentRound);
         dirCache.SetLastModifyTime(modifyTime);
+        dirCache.SetInode(inode);
         // Directories found at round 1 or too old are considered as old data.
         auto curTime = static_cast<int32_t>(time(NULL));
         if (mCurrentRound == 1 || curTime - sec > INT32_FLAG(polling_dir_first_watch_timeout)) {
@@ -322,8 +333,20 @@ bool PollingDirFile::CheckAndUpdateDirMatchCache(const string& dirPath,
 
     // Already cached, update last round and modified time.
     newFlag = false;
-    iter->second.SetCheckRound(mCurrentRound);
-    iter->second.SetLastModifyTime(modifyTime);
+    auto& dirCache = iter->second;
+    // Entries added within the same second might not change the modify time on filesystems with
+    // coarse timestamps, so recently modified directories are always read.
+    if (BOOL_FLAG(enable_polling_dir_prune) && dirCache.GetSubDirs() != nullptr
+        && dirCache.GetLastModifyTime() == modifyTime && dirCache.GetInode() == inode && time(NULL) - sec > 1
+        && (mCurrentRound + hash<string>()(dirPath)) % INT32_FLAG(polling_dir_full_scan_round) != 0) {
+        unchangedSubDirs = *dirCache.GetSubDirs();
+    } else {
+        // will be set again once the directory is read completely
+        dirCache.ClearSubDirs();
+    }
+    dirCache.SetCheckRound(mCurrentRound);
+    dirCache.SetLastModifyTime(modifyTime);
+    dirCache.SetInode(inode);
     return true; // iter->second.HasMatchedConfig().
 }
 
@@ -411,11 +434,16 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         return false;
     }
     bool isNewDirectory = false;
-    if (!CheckAndUpdateDirMatchCache(dirPath, statBuf, exceedPreservedDirDepth, isNewDirectory))
+    optional<vector<string>> unchangedSubDirs;
+    if (!CheckAndUpdateDirMatchCache(dirPath, statBuf, exceedPreservedDirDepth, isNewDirectory, unchangedSubDirs))
         return true;
     if (isNewDirectory) {
         PollingEventQueue::GetInstance()->PushEvent(new Event(srcPath, obj, EVENT_CREATE | EVENT_ISDIR, -1, 0));
     }
+    if (unchangedSubDirs) {
+        PollingUnchangedDir(pConfig, dirPath, *unchangedSubDirs, depth);
+        return true;
+    }
 
     // Iterate directories and files in dirPath.
     fsutil::Dir dir(dirPath);
@@ -437,10 +465,15 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         return true;
     }
     int32_t nowStatCount = 0;
+    // Sub directories are recorded only if the directory is read completely.
+    bool isComplete = true;
+    vector<string> subDirs;
     fsutil::Entry ent;
     while ((ent = dir.ReadNext(false))) {
-        if (!mRuningFlag || mHoldOnFlag)
+        if (!mRuningFlag || mHoldOnFlag) {
+            isComplete = false;
             break;
+        }
 
         if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0) {
             usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
@@ -459,6 +492,7 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
                 pConfig.second->GetProjectName(),
                 pConfig.second->GetConfigName(),
                 pConfig.second->GetLogstoreName());
+            isComplete = false;
             break;
         }
 
@@ -475,6 +509,7 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
                 pConfig.second->GetProjectName(),
                 pConfig.second->GetConfigName(),
                 pConfig.second->GetLogstoreName());
+            isComplete = false;
             break;
         }
 
@@ -521,6 +556,9 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         // We should check file type again to make sure that the original file which linked by
         // a symbolic file is DIR or REG.
         if (buf.IsDir() && (!needCheckDirMatch || !pConfig.first->IsDirectoryInBlacklist(item))) {
+            if (BOOL_FLAG(enable_polling_dir_prune)) {
+                subDirs.emplace_back(entName);
+            }
             PollingNormalConfigPath(pConfig, dirPath, entName, buf, depth + 1);
         } else if (buf.IsRegFile()) {
             if (CheckAndUpdateFileMatchCache(dirPath, entName, buf, needFindBestMatch, exceedPreservedDirDepth)) {
@@ -534,9 +572,47 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         }
     }
 
+    if (BOOL_FLAG(enable_polling_dir_prune) && isComplete) {
+        ScopedSpinLock lock(mCacheLock);
+        auto iter = mDirCacheMap.find(dirPath);
+        if (iter != mDirCacheMap.end()) {
+            iter->second.SetSubDirs(std::move(subDirs));
+        }
+    }
     return true;
 }
 
+// Modify time of the directory is not changed, so entries in it are not added, removed or renamed.
+// But its sub directories might have changed, so they are still checked one by one.
+void PollingDirFile::PollingUnchangedDir(const FileDiscoveryConfig& pConfig,
+                                         const string& dirPath,
+                                         const vector<string>& subDirs,
+                                         int depth) {
+    for (const auto& subDir : subDirs) {
+        if (!mRuningFlag || mHoldOnFlag)
+            break;
+
+        if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0) {
+            usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
+        }
+        if (mStatCount > INT32_FLAG(polling_max_stat_count)) {
+            break;
+        }
+
+        string item = PathJoin(dirPath, subDir);
+        fsutil::PathStat buf;
+        if (!fsutil::PathStat::stat(item, buf)) {
+            LOG_DEBUG(sLogger, ("get dir info error", item.c_str())("errno", errno));
+            continue;
+        }
+        // The target of a symbolic link might be changed without changing the directory.
+        if (!buf.IsDir()) {
+            continue;
+        }
+        PollingNormalConfigPath(pConfig, dirPath, subDir, buf, depth + 1);
+    }
+}
+
 // PollingWildcardConfigPath will iterate wildcardPaths one by one, and according to
 // corresponding value in constWildcardPaths, call PollingNormalConfigPath or call
 // PollingWildcardConfigPath recursively.
@@ -16,6 +16,9 @@
 
 #pragma once
 #include <map>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include "common/Lock.h"
 #include "common/LogRunnable.h"
@@ -81,18 +84,29 @@ private:
                                    const std::string& dirPath,
                                    int depth);
 
+    // PollingUnchangedDir polls sub directories of a directory which has not changed since it was
+    // read last time, without reading the directory and stating its files again.
+    // @subDirs: names of the sub directories found when the directory was read last time.
+    void PollingUnchangedDir(const FileDiscoveryConfig& config,
+                             const std::string& dirPath,
+                             const std::vector<std::string>& subDirs,
+                             int depth);
+
     // CheckAndUpdateDirMatchCache updates dir cache (add if not existing).
     // The caller of this method should make sure that there is at least one config matches
     // @dirPath.
     // @dirPath: absolute path of the directory.
     // @statBuf: stat of the directory.
     // @newFlag: a boolean to indicate caller that it is a new directory, generate event for it.
+    // @unchangedSubDirs: set to the cached sub directories if the directory is not changed since
+    //   it was read last time (flag enable_polling_dir_prune), otherwise nullopt.
     // @return a boolean to indicate should the directory be continued to poll.
     //   It will returns true always now (might change in future).
     bool CheckAndUpdateDirMatchCache(const std::string& dirPath,
                                      const fsutil::PathStat& statBuf,
                                      bool exceedPreservedDirDepth,
-                                     bool& newFlag);
+                                     bool& newFlag,
+                                     std::optional<std::vector<std::string>>& unchangedSubDirs);
     // CheckAndUpdateFileMatchCache updates file cache (add if not existing).
     // @fileDir+@fileName: absolute path of the file.
     // @needFindBestMatch: false indicates that the file has already found the
@@ -149,6 +163,8 @@ private:
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PollingUnittest;
     friend class PollingPreservedDirDepthUnittest;
+    friend class PollingDirFileUnittest;
+    friend class PollingDirFileBenchmark;
 #endif
 };
 
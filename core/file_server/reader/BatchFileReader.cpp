@@ -0,0 +1,103 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/reader/BatchFileReader.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "common/Flags.h"
+#include "common/memory/ChunkPool.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_BOOL(enable_batch_file_read,
+                 "read ahead the files of a batch of modify events with one batch of reads before handling them",
+                 false);
+DEFINE_FLAG_BOOL(batch_file_read_use_io_uring, "use io_uring for batch file read if available, or pread is used", true);
+DEFINE_FLAG_BOOL(batch_file_read_register_buffers, "register the read ahead buffers to io_uring", true);
+DEFINE_FLAG_INT32(batch_file_read_max_files, "max count of files read ahead in one batch", 256);
+DEFINE_FLAG_INT32(batch_file_read_buffer_size_kb, "max size read ahead for each file", 64);
+
+using namespace std;
+
+namespace logtail {
+
+BatchFileReader::~BatchFileReader() {
+    Clear();
+    // buffers must be unregistered before being freed
+    mEngine.reset();
+    for (const auto& buffer : mBuffers) {
+        ChunkPool::GetInstance()->Free(reinterpret_cast<uint8_t*>(buffer.first), buffer.second);
+    }
+}
+
+void BatchFileReader::Read(const vector<LogFileReaderPtr>& readers) {
+    Clear();
+    if (!mEngine) {
+        Init();
+    }
+
+    unordered_set<const LogFileReader*> added;
+    for (const auto& reader : readers) {
+        if (mReaders.size() == mBuffers.size()) {
+            break;
+        }
+        if (!added.insert(reader.get()).second) {
+            continue;
+        }
+        FileReadRequest request;
+        request.mBufIndex = static_cast<int32_t>(mReaders.size());
+        request.mBuf = mBuffers[request.mBufIndex].first;
+        request.mSize = mBuffers[request.mBufIndex].second;
+        if (!reader->PrepareReadAhead(request)) {
+            continue;
+        }
+        mReaders.push_back(reader);
+        mRequests.push_back(request);
+    }
+    if (mRequests.empty()) {
+        return;
+    }
+    mEngine->Read(mRequests);
+    for (size_t i = 0; i < mReaders.size(); ++i) {
+        mReaders[i]->SetReadAheadData(mRequests[i]);
+    }
+    LOG_DEBUG(sLogger, ("batch file read, engine", mEngine->GetName())("files", mReaders.size()));
+}
+
+void BatchFileReader::Clear() {
+    for (const auto& reader : mReaders) {
+        reader->ClearReadAheadData();
+    }
+    mReaders.clear();
+    mRequests.clear();
+}
+
+void BatchFileReader::Init() {
+    size_t bufferCnt = static_cast<size_t>(max(INT32_FLAG(batch_file_read_max_files), 1));
+    size_t bufferSize = static_cast<size_t>(max(INT32_FLAG(batch_file_read_buffer_size_kb), 1)) * 1024;
+    mEngine = FileReadEngine::Create(BOOL_FLAG(batch_file_read_use_io_uring), static_cast<uint32_t>(bufferCnt));
+    mBuffers.reserve(bufferCnt);
+    for (size_t i = 0; i < bufferCnt; ++i) {
+        size_t capacity = 0;
+        auto* buffer = ChunkPool::GetInstance()->Allocate(bufferSize, capacity);
+        mBuffers.emplace_back(reinterpret_cast<char*>(buffer), capacity);
+    }
+    bool registered = BOOL_FLAG(batch_file_read_register_buffers) && mEngine->RegisterBuffers(mBuffers);
+    LOG_INFO(sLogger,
+             ("batch file read initialized, engine", mEngine->GetName())("buffer count", bufferCnt)(
+                 "buffer size", bufferSize)("buffers registered", registered));
+}
+
+} // namespace logtail
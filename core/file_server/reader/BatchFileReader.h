@@ -0,0 +1,58 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "file_server/reader/FileReadEngine.h"
+#include "file_server/reader/LogFileReader.h"
+
+namespace logtail {
+
+// Reads ahead the next bytes of many readers in one batch before their modify events are handled, so that slowly
+// growing files do not cost one read syscall each. The bytes read are lent to the readers until Clear is called.
+class BatchFileReader {
+public:
+    BatchFileReader() = default;
+    ~BatchFileReader();
+    BatchFileReader(const BatchFileReader&) = delete;
+    BatchFileReader& operator=(const BatchFileReader&) = delete;
+
+    // readers not opened are skipped, and at most batch_file_read_max_files readers are read
+    void Read(const std::vector<LogFileReaderPtr>& readers);
+    // drops the bytes not consumed by the readers of the last batch, so that the buffers can be reused
+    void Clear();
+
+    const char* GetEngineName() const { return mEngine ? mEngine->GetName() : ""; }
+
+private:
+    void Init();
+
+    std::unique_ptr<FileReadEngine> mEngine;
+    // taken from the chunk pool, and registered to the engine if possible
+    std::vector<std::pair<char*, size_t>> mBuffers;
+    std::vector<LogFileReaderPtr> mReaders;
+    std::vector<FileReadRequest> mRequests;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class BatchFileReaderUnittest;
+#endif
+};
+
+} // namespace logtail
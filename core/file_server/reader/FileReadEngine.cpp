@@ -0,0 +1,296 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/reader/FileReadEngine.h"
+
+#include <cerrno>
+#include <cstring>
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define LOGTAIL_HAS_IO_URING
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+#include "common/LogFileOperator.h"
+#include "logger/Logger.h"
+
+// the syscall numbers are the same on all architectures except alpha, but may be missing in old libc headers
+#if defined(LOGTAIL_HAS_IO_URING) && !defined(__NR_io_uring_setup)
+#define __NR_io_uring_setup 425
+#define __NR_io_uring_enter 426
+#define __NR_io_uring_register 427
+#endif
+
+using namespace std;
+
+namespace logtail {
+
+unique_ptr<FileReadEngine> FileReadEngine::Create(bool preferIoUring, uint32_t queueDepth) {
+#if defined(__linux__)
+    if (preferIoUring) {
+        auto engine = make_unique<IoUringFileReadEngine>();
+        if (engine->Init(queueDepth)) {
+            return engine;
+        }
+        LOG_WARNING(sLogger, ("io_uring is not available", "fall back to pread"));
+    }
+#endif
+    return make_unique<PreadFileReadEngine>();
+}
+
+void PreadFileReadEngine::Read(vector<FileReadRequest>& requests) {
+    for (auto& request : requests) {
+        Read(request);
+    }
+}
+
+void PreadFileReadEngine::Read(FileReadRequest& request) {
+    int nbytes = request.mFileOp->Pread(request.mBuf, 1, request.mSize, request.mOffset);
+    request.mResult = nbytes < 0 ? -errno : nbytes;
+}
+
+#if defined(__linux__)
+
+#ifdef LOGTAIL_HAS_IO_URING
+static constexpr int64_t kPendingResult = numeric_limits<int64_t>::min();
+
+static void* MapRing(int ringFd, size_t size, off_t offset) {
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+IoUringFileReadEngine::~IoUringFileReadEngine() {
+    if (mSqes != nullptr) {
+        munmap(mSqes, mSqesSize);
+    }
+    if (mCqRing != nullptr && mCqRing != mSqRing) {
+        munmap(mCqRing, mCqRingSize);
+    }
+    if (mSqRing != nullptr) {
+        munmap(mSqRing, mSqRingSize);
+    }
+    if (mRingFd >= 0) {
+        close(mRingFd);
+    }
+}
+
+bool IoUringFileReadEngine::Init(uint32_t queueDepth) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    mRingFd = static_cast<int>(syscall(__NR_io_uring_setup, max(queueDepth, 1U), &params));
+    if (mRingFd < 0) {
+        LOG_WARNING(sLogger, ("failed to set up io_uring", strerror(errno)));
+        return false;
+    }
+    mSqEntries = params.sq_entries;
+    mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+        mSqRingSize = mCqRingSize = max(mSqRingSize, mCqRingSize);
+    }
+    mSqRing = MapRing(mRingFd, mSqRingSize, IORING_OFF_SQ_RING);
+    if (mSqRing == nullptr) {
+        LOG_WARNING(sLogger, ("failed to map io_uring submission queue", strerror(errno)));
+        return false;
+    }
+    mCqRing = singleMmap ? mSqRing : MapRing(mRingFd, mCqRingSize, IORING_OFF_CQ_RING);
+    if (mCqRing == nullptr) {
+        LOG_WARNING(sLogger, ("failed to map io_uring completion queue", strerror(errno)));
+        return false;
+    }
+    mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    mSqes = MapRing(mRingFd, mSqesSize, IORING_OFF_SQES);
+    if (mSqes == nullptr) {
+        LOG_WARNING(sLogger, ("failed to map io_uring submission queue entries", strerror(errno)));
+        return false;
+    }
+
+    auto* sq = static_cast<char*>(mSqRing);
+    mSqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    mSqMask = reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    mSqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    auto* cq = static_cast<char*>(mCqRing);
+    mCqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    mCqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    mCqMask = reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    mCqes = cq + params.cq_off.cqes;
+    mIovecs.resize(mSqEntries);
+    LOG_INFO(sLogger, ("io_uring file read engine initialized, queue depth", mSqEntries));
+    return true;
+}
+
+bool IoUringFileReadEngine::RegisterBuffers(const vector<pair<char*, size_t>>& buffers) {
+    if (mBuffersRegistered) {
+        syscall(__NR_io_uring_register, mRingFd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        mBuffersRegistered = false;
+    }
+    vector<iovec> iovecs(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        iovecs[i].iov_base = buffers[i].first;
+        iovecs[i].iov_len = buffers[i].second;
+    }
+    if (syscall(__NR_io_uring_register, mRingFd, IORING_REGISTER_BUFFERS, iovecs.data(), iovecs.size()) < 0) {
+        // registered buffers are charged to RLIMIT_MEMLOCK
+        LOG_WARNING(sLogger,
+                    ("failed to register buffers to io_uring", strerror(errno))("buffer count", buffers.size()));
+        return false;
+    }
+    mBuffersRegistered = true;
+    return true;
+}
+
+void IoUringFileReadEngine::Read(vector<FileReadRequest>& requests) {
+    size_t begin = 0;
+    while (begin < requests.size() && !mBroken) {
+        size_t end = min(requests.size(), begin + mSqEntries);
+        int64_t res = SubmitAndWait(requests, begin, end);
+        if (res < 0) {
+            LOG_ERROR(sLogger, ("io_uring failed, fall back to pread", strerror(-res)));
+            mBroken = true;
+            for (size_t i = begin; i < end; ++i) {
+                if (requests[i].mResult == kPendingResult) {
+                    PreadFileReadEngine::Read(requests[i]);
+                }
+            }
+        }
+        begin = end;
+    }
+    for (size_t i = begin; i < requests.size(); ++i) {
+        PreadFileReadEngine::Read(requests[i]);
+    }
+}
+
+int64_t IoUringFileReadEngine::SubmitAndWait(vector<FileReadRequest>& requests, size_t begin, size_t end) {
+    // this is the only producer of the submission queue and the only consumer of the completion queue
+    uint32_t sqTail = *mSqTail;
+    uint32_t sqMask = *mSqMask;
+    auto* sqes = static_cast<io_uring_sqe*>(mSqes);
+    for (size_t i = begin; i < end; ++i) {
+        auto& request = requests[i];
+        request.mResult = kPendingResult;
+        uint32_t idx = sqTail & sqMask;
+        io_uring_sqe& sqe = sqes[idx];
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.fd = request.mFileOp->GetFd();
+        sqe.off = static_cast<uint64_t>(request.mOffset);
+        sqe.user_data = i;
+        if (mBuffersRegistered && request.mBufIndex >= 0) {
+            sqe.opcode = IORING_OP_READ_FIXED;
+            sqe.addr = reinterpret_cast<uint64_t>(request.mBuf);
+            sqe.len = request.mSize;
+            sqe.buf_index = request.mBufIndex;
+        } else {
+            // readv is used instead of read, which is only supported since linux 5.6
+            mIovecs[idx].iov_base = request.mBuf;
+            mIovecs[idx].iov_len = request.mSize;
+            sqe.opcode = IORING_OP_READV;
+            sqe.addr = reinterpret_cast<uint64_t>(&mIovecs[idx]);
+            sqe.len = 1;
+        }
+        mSqArray[idx] = idx;
+        ++sqTail;
+    }
+    __atomic_store_n(mSqTail, sqTail, __ATOMIC_RELEASE);
+
+    size_t total = end - begin;
+    size_t toSubmit = total;
+    size_t completed = 0;
+    while (completed < total) {
+        long ret = syscall(
+            __NR_io_uring_enter, mRingFd, toSubmit, total - completed, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (ret < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                continue;
+            }
+            int err = errno;
+            WaitInFlight(requests, total - toSubmit - completed);
+            return -err;
+        }
+        toSubmit -= min(static_cast<size_t>(ret), toSubmit);
+        completed += ReapCompletions(requests);
+    }
+    return completed;
+}
+
+size_t IoUringFileReadEngine::ReapCompletions(vector<FileReadRequest>& requests) {
+    uint32_t cqHead = *mCqHead;
+    uint32_t cqTail = __atomic_load_n(mCqTail, __ATOMIC_ACQUIRE);
+    uint32_t cqMask = *mCqMask;
+    auto* cqes = static_cast<io_uring_cqe*>(mCqes);
+    size_t reaped = 0;
+    for (; cqHead != cqTail; ++cqHead) {
+        const io_uring_cqe& cqe = cqes[cqHead & cqMask];
+        requests[cqe.user_data].mResult = cqe.res;
+        ++reaped;
+    }
+    __atomic_store_n(mCqHead, cqHead, __ATOMIC_RELEASE);
+    return reaped;
+}
+
+void IoUringFileReadEngine::WaitInFlight(vector<FileReadRequest>& requests, size_t inFlight) {
+    // the kernel may still write to the buffers of submitted requests, so these requests must be completed before the
+    // buffers are read by pread or reused. Entries not submitted yet are left in the submission queue, and are never
+    // submitted since the engine is broken.
+    while (true) {
+        inFlight -= min(ReapCompletions(requests), inFlight);
+        if (inFlight == 0) {
+            return;
+        }
+        if (syscall(__NR_io_uring_enter, mRingFd, 0, inFlight, IORING_ENTER_GETEVENTS, nullptr, 0) < 0
+            && errno != EINTR) {
+            // completions are posted to the mapped completion queue anyway, so it is polled instead
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    }
+}
+#else
+IoUringFileReadEngine::~IoUringFileReadEngine() {
+}
+
+bool IoUringFileReadEngine::Init(uint32_t queueDepth) {
+    LOG_WARNING(sLogger, ("io_uring is not supported", "built without linux/io_uring.h"));
+    return false;
+}
+
+bool IoUringFileReadEngine::RegisterBuffers(const vector<pair<char*, size_t>>& buffers) {
+    return false;
+}
+
+void IoUringFileReadEngine::Read(vector<FileReadRequest>& requests) {
+    PreadFileReadEngine().Read(requests);
+}
+
+int64_t IoUringFileReadEngine::SubmitAndWait(vector<FileReadRequest>& requests, size_t begin, size_t end) {
+    return -ENOSYS;
+}
+
+size_t IoUringFileReadEngine::ReapCompletions(vector<FileReadRequest>& requests) {
+    return 0;
+}
+
+void IoUringFileReadEngine::WaitInFlight(vector<FileReadRequest>& requests, size_t inFlight) {
+}
+#endif
+
+#endif
+
+} // namespace logtail
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#if defined(__linux__)
+#include <sys/uio.h>
+#endif
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace logtail {
+
+class LogFileOperator;
+
+struct FileReadRequest {
+    LogFileOperator* mFileOp = nullptr;
+    int64_t mOffset = 0;
+    char* mBuf = nullptr;
+    size_t mSize = 0;
+    // index of the registered buffer which mBuf points into, -1 if mBuf is not in any registered buffer
+    int32_t mBufIndex = -1;
+    // bytes read, or -errno on failure
+    int64_t mResult = 0;
+};
+
+// Reads a batch of requests on different files. Each request is a positional read, so that the file offsets are left
+// intact.
+class FileReadEngine {
+public:
+    virtual ~FileReadEngine() = default;
+
+    virtual const char* GetName() const = 0;
+    // returns after all requests are completed
+    virtual void Read(std::vector<FileReadRequest>& requests) = 0;
+    // buffers registered can be read into without being mapped by the kernel for each request, returns false if not
+    // supported, in which case the buffers can still be used as normal ones
+    virtual bool RegisterBuffers(const std::vector<std::pair<char*, size_t>>& buffers) { return false; }
+
+    // an io_uring engine with queueDepth entries is returned if preferIoUring is set and io_uring is available, or a
+    // pread engine is returned
+    static std::unique_ptr<FileReadEngine> Create(bool preferIoUring, uint32_t queueDepth);
+};
+
+class PreadFileReadEngine : public FileReadEngine {
+public:
+    const char* GetName() const override { return "pread"; }
+    void Read(std::vector<FileReadRequest>& requests) override;
+
+    static void Read(FileReadRequest& request);
+};
+
+#if defined(__linux__)
+// io_uring accessed by raw syscalls, so that no extra library is needed. Requests more than the queue depth are
+// submitted in several rounds, each of which costs one syscall for both submission and completion.
+class IoUringFileReadEngine : public FileReadEngine {
+public:
+    IoUringFileReadEngine() = default;
+    ~IoUringFileReadEngine() override;
+    IoUringFileReadEngine(const IoUringFileReadEngine&) = delete;
+    IoUringFileReadEngine& operator=(const IoUringFileReadEngine&) = delete;
+
+    bool Init(uint32_t queueDepth);
+    const char* GetName() const override { return "io_uring"; }
+    void Read(std::vector<FileReadRequest>& requests) override;
+    bool RegisterBuffers(const std::vector<std::pair<char*, size_t>>& buffers) override;
+
+private:
+    // returns the count of requests completed, or -errno if io_uring is broken, in which case all requests submitted
+    // have been completed before return
+    int64_t SubmitAndWait(std::vector<FileReadRequest>& requests, size_t begin, size_t end);
+    size_t ReapCompletions(std::vector<FileReadRequest>& requests);
+    void WaitInFlight(std::vector<FileReadRequest>& requests, size_t inFlight);
+
+    int mRingFd = -1;
+    void* mSqRing = nullptr;
+    size_t mSqRingSize = 0;
+    void* mCqRing = nullptr;
+    size_t mCqRingSize = 0;
+    void* mSqes = nullptr;
+    size_t mSqesSize = 0;
+    uint32_t mSqEntries = 0;
+
+    uint32_t* mSqTail = nullptr;
+    uint32_t* mSqMask = nullptr;
+    uint32_t* mSqArray = nullptr;
+    uint32_t* mCqHead = nullptr;
+    uint32_t* mCqTail = nullptr;
+    uint32_t* mCqMask = nullptr;
+    void* mCqes = nullptr;
+    // iovecs of the requests submitted, indexed by submission queue entry
+    std::vector<iovec> mIovecs;
+
+    bool mBuffersRegistered = false;
+    // set when io_uring fails unexpectedly, all requests are read by pread afterwards
+    bool mBroken = false;
+};
+#endif
+
+} // namespace logtail
@@ -19,8 +19,8 @@
 #include "TagConstants.h"
 #include "common/StringView.h"
 
-#if defined(_MSC_VER)
 #include <fcntl.h>
+#if defined(_MSC_VER)
 #include <io.h>
 #endif
 #include <time.h>
@@ -54,6 +54,7 @@
 #include "file_server/checkpoint/CheckpointManagerV2.h"
 #include "file_server/event/BlockEventManager.h"
 #include "file_server/event_handler/LogInput.h"
+#include "file_server/reader/FileReadEngine.h"
 #include "file_server/reader/GloablFileDescriptorManager.h"
 #include "file_server/reader/JsonLogFileReader.h"
 #include "logger/Logger.h"
@@ -994,7 +995,12 @@ bool LogFileReader::ReadLog(LogBuffer& logBuffer, const Event* event) {
             return false;
         }
     }
-    bool moreData = GetRawData(logBuffer, mLastFileSize, tryRollback);
+    int64_t readEnd = mLastFileSize;
+    if (mReadRangeEnd >= 0 && mReadRangeEnd < readEnd) {
+        readEnd = mReadRangeEnd;
+    }
+    bool moreData = GetRawData(logBuffer, readEnd, tryRollback);
+    mCacheMemAccount.Update(mCache.capacity());
     if (!logBuffer.rawBuffer.empty()) {
         if (mEOOption) {
             // This read was replayed by checkpoint, adjust mLastFilePos to skip hole.
@@ -1225,8 +1231,10 @@ void LogFileReader::CloseFilePtr() {
 }
 
 void LogFileReader::CloseFilePtr(bool& isDeleted) {
+    ClearReadAheadData();
     if (mLogFileOp.IsOpen()) {
         mCache.shrink_to_fit();
+        mCacheMemAccount.Update(mCache.capacity());
         LOG_DEBUG(sLogger, ("start close LogFileReader", mHostLogPath));
 
         // if mHostLogPath is symbolic link, then we should not update it accrding to /dev/fd/xx
@@ -1423,6 +1431,18 @@ void LogFileReader::ResetTopic(const std::string& topicFormat) {
     mTopicName = GetTopicName(topicFormat, mHostLogPath);
 }
 
+void LogFileReader::AdviseSequentialRead() {
+#if defined(__linux__)
+    if (!mLogFileOp.IsOpen()) {
+        return;
+    }
+    int ret = posix_fadvise(mLogFileOp.GetFd(), 0, 0, POSIX_FADV_SEQUENTIAL);
+    if (ret != 0) {
+        LOG_DEBUG(sLogger, ("failed to advise sequential read", mHostLogPath)("error", strerror(ret)));
+    }
+#endif
+}
+
 void LogFileReader::SetReadBufferSize(int32_t bufSize) {
     if (bufSize < 1024 * 10 || bufSize > 1024 * 1024 * 1024) {
         LOG_ERROR(sLogger, ("invalid read buffer size", bufSize));
@@ -1550,8 +1570,8 @@ size_t LogFileReader::getNextReadSize(int64_t fileEnd, bool& fromCpt) {
         readSize = checkpoint.read_length();
         LOG_INFO(sLogger, ("read specified length", readSize)("offset", mLastFilePos));
     }
-    if (readSize > BUFFER_SIZE && !allowMoreBufferSize) {
-        readSize = BUFFER_SIZE;
+    if (readSize > GetReadBufferSize() && !allowMoreBufferSize) {
+        readSize = GetReadBufferSize();
     }
     return readSize;
 }
@@ -1637,7 +1657,7 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
         logBuffer.truncateInfo.reset(truncateInfo);
         lastReadPos = mLastFilePos + nbytes; // this doesn't seem right when ulogfs is used and a hole is skipped
         LOG_DEBUG(sLogger, ("read bytes", nbytes)("last read pos", lastReadPos));
-        moreData = (nbytes == BUFFER_SIZE);
+        moreData = (nbytes == GetReadBufferSize());
         auto alignedBytes = nbytes;
         if (allowRollback) {
             alignedBytes = AlignLastCharacter(stringBuffer, nbytes);
@@ -1649,7 +1669,7 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
 
         if (nbytes == 0) {
             if (moreData) { // excessively long line without '\n' or multiline begin or valid wchar
-                nbytes = alignedBytes ? alignedBytes : BUFFER_SIZE;
+                nbytes = alignedBytes ? alignedBytes : GetReadBufferSize();
                 if (mReaderConfig.second->RequiringJsonReader()) {
                     int32_t rollbackLineFeedCount = 0;
                     nbytes = RemoveLastIncompleteLog(stringBuffer, nbytes, rollbackLineFeedCount, false);
@@ -1770,7 +1790,7 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
         logBuffer.truncateInfo.reset(truncateInfo);
         lastReadPos = mLastFilePos + readCharCount;
         originReadCount = readCharCount;
-        moreData = (readCharCount == BUFFER_SIZE);
+        moreData = (readCharCount == GetReadBufferSize());
         auto alignedBytes = readCharCount;
         if (allowRollback) {
             alignedBytes = AlignLastCharacter(gbkBuffer, readCharCount);
@@ -1778,7 +1798,7 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
         if (alignedBytes == 0) {
             if (moreData) { // excessively long line without valid wchar
                 logTooLongSplitFlag = true;
-                alignedBytes = BUFFER_SIZE;
+                alignedBytes = GetReadBufferSize();
             } else {
                 // line is not finished yet nor more data, put all data in cache
                 mCache.assign(gbkBuffer, originReadCount);
@@ -1884,20 +1904,55 @@ LogFileReader::ReadFile(LogFileOperator& op, void* buf, size_t size, int64_t& of
         return 0;
     }
 
+    size_t readAheadBytes = 0;
+    if (&op == &mLogFileOp && mReadAheadData != nullptr) {
+        if (offset == mReadAheadOffset) {
+            readAheadBytes = min(size, mReadAheadSize);
+            memcpy(buf, mReadAheadData, readAheadBytes);
+        }
+        // the position has moved on after this read
+        ClearReadAheadData();
+    }
     int nbytes = 0;
-    nbytes = op.Pread(buf, 1, size, offset);
-    if (nbytes < 0) {
-        LOG_ERROR(sLogger,
-                  ("Pread fail to read log file", mHostLogPath)("mLastFilePos", mLastFilePos)("size", size)("offset",
-                                                                                                            offset));
-        return 0;
+    if (readAheadBytes < size) {
+        nbytes = op.Pread((char*)buf + readAheadBytes, 1, size - readAheadBytes, offset + readAheadBytes);
+        if (nbytes < 0) {
+            LOG_ERROR(sLogger,
+                      ("Pread fail to read log file", mHostLogPath)("mLastFilePos", mLastFilePos)("size", size)(
+                          "offset", offset));
+            if (readAheadBytes == 0) {
+                return 0;
+            }
+            nbytes = 0;
+        }
     }
-    // }
+    nbytes += readAheadBytes;
 
     *((char*)buf + nbytes) = '\0';
     return nbytes;
 }
 
+bool LogFileReader::PrepareReadAhead(FileReadRequest& request) const {
+    // reads replayed from exactly once checkpoints do not start at the last read position
+    if (!mLogFileOp.IsOpen() || mEOOption) {
+        return false;
+    }
+    request.mFileOp = const_cast<LogFileOperator*>(&mLogFileOp);
+    request.mOffset = GetLastReadPos();
+    request.mSize = min(request.mSize, GetReadBufferSize());
+    return request.mSize > 0;
+}
+
+void LogFileReader::SetReadAheadData(const FileReadRequest& request) {
+    if (request.mResult <= 0) {
+        ClearReadAheadData();
+        return;
+    }
+    mReadAheadData = request.mBuf;
+    mReadAheadSize = static_cast<size_t>(request.mResult);
+    mReadAheadOffset = request.mOffset;
+}
+
 LogFileReader::FileCompareResult LogFileReader::CompareToFile(const string& filePath) {
     LogFileOperator logFileOp;
     logFileOp.Open(filePath.c_str());
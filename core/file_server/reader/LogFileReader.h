@@ -32,6 +32,7 @@
 #include "common/StringTools.h"
 #include "common/StringView.h"
 #include "common/TimeUtil.h"
+#include "common/memory/MemoryGovernor.h"
 #include "common/memory/SourceBuffer.h"
 #include "constants/TagConstants.h"
 #include "file_server/FileDiscoveryOptions.h"
@@ -48,6 +49,7 @@ namespace logtail {
 struct LogBuffer;
 class LogFileReader;
 class DevInode;
+struct FileReadRequest;
 
 typedef std::shared_ptr<LogFileReader> LogFileReaderPtr;
 typedef std::deque<LogFileReaderPtr> LogFileReaderPtrArray;
@@ -278,6 +280,19 @@ public:
             mFirstWatched = false;
         mLastFilePos = pos;
     }
+
+    // Restrict the reader to [begin, end) of the file, used by bulk static file reading where a large file is split
+    // into independent line-aligned ranges. A negative end means reading till the end of the file.
+    void SetReadRange(int64_t begin, int64_t end) {
+        SetLastFilePos(begin);
+        mReadRangeEnd = end;
+    }
+
+    // Override the global BUFFER_SIZE for this reader only, 0 means the global one is used.
+    void SetReaderBufferSize(size_t size) { mReaderBufferSize = size; }
+
+    // Hint the kernel that the file will be read sequentially from now on, so that readahead can be more aggressive.
+    void AdviseSequentialRead();
     void
     InitReader(bool tailExisted = false, FileReadPolicy policy = BACKWARD_TO_FIXED_POS, uint32_t eoConcurrency = 0);
 
@@ -305,6 +320,15 @@ public:
 
     bool IsFileOpened() const { return mLogFileOp.IsOpen(); }
 
+    // fills the file and range of the next read into request, the size of which is the capacity of its buffer
+    bool PrepareReadAhead(FileReadRequest& request) const;
+    // the bytes read ahead are consumed by the next read if it starts at the same offset, and dropped otherwise
+    void SetReadAheadData(const FileReadRequest& request);
+    void ClearReadAheadData() {
+        mReadAheadData = nullptr;
+        mReadAheadSize = 0;
+    }
+
     bool ShouldForceReleaseDeletedFileFd();
 
     // void SetPluginFlag(bool flag) { mPluginFlag = flag; }
@@ -482,6 +506,7 @@ protected:
     inline int64_t GetLastReadPos() const { // pos read but may not consumed, used for read needed
         return mLastFilePos + mCache.size();
     }
+    size_t GetReadBufferSize() const { return mReaderBufferSize ? mReaderBufferSize : BUFFER_SIZE; }
     void ResolveHostLogPath();
 
     // std::string mRegion;
@@ -500,8 +525,12 @@ protected:
     uint32_t mLastFileSignatureSize = 0;
     int64_t mLastFilePos = 0; // pos read and consumed, used for next read begin
     int64_t mLastFileSize = 0;
+    int64_t mReadRangeEnd = -1; // < 0 means no limit
+    size_t mReaderBufferSize = 0; // 0 means BUFFER_SIZE is used
     time_t mLastMTime = 0;
     std::string mCache;
+    // updated after each read, since mCache is changed in many places
+    MemoryAccount mCacheMemAccount{MemoryCategory::READER_CACHE};
     // >= 0: index of reader array, -1: new reader, -2: not in reader array, -3: not found
     int32_t mIdxInReaderArrayFromLastCpt = CHECKPOINT_IDX_OF_NEW_READER_IN_ARRAY;
     // std::string mProjectName;
@@ -535,6 +564,10 @@ protected:
     // bool mMarkOffsetFlag = false;
     // std::string mTimeFormat; // for backward reading
     LogFileOperator mLogFileOp; // encapsulate fuse & non-fuse mode
+    // bytes of the file read ahead at mReadAheadOffset, owned by BatchFileReader
+    const char* mReadAheadData = nullptr;
+    size_t mReadAheadSize = 0;
+    int64_t mReadAheadOffset = 0;
     // std::string mFuseTrimedFilename;
     LogFileReaderPtrArray* mReaderArray = nullptr;
     // uint64_t mLogstoreKey;
@@ -726,6 +759,7 @@ private:
     friend class CreateModifyHandlerUnittest;
     friend class LogFileReaderHoleUnittest;
     friend class LogFileReaderResolvedPathUnittest;
+    friend class BatchFileReaderUnittest;
 
 protected:
     void UpdateReaderManual();
@@ -18,6 +18,7 @@
 
 #include <grpcpp/support/status.h>
 
+#include <algorithm>
 #include <memory>
 
 #include "common/Flags.h"
@@ -94,56 +95,98 @@ grpc::ServerUnaryReactor* LoongSuiteForwardServiceImpl::Forward(grpc::CallbackSe
     if (FindMatchingConfig(context, config)) {
         // config maybe removed, so we need to copy config here
         int32_t retryTimes = mRetryTimeController.GetRetryTimes(config->configName);
-        ProcessForwardRequest(request, config, retryTimes, status);
-
-        if (status.ok()) {
-            mRetryTimeController.UpRetryTimes(config->configName);
-        } else {
-            mRetryTimeController.DownRetryTimes(config->configName);
+        std::shared_ptr<const LoongSuiteForwardRequest> sharedRequest;
+        auto* holder = dynamic_cast<ForwardMessageHolder*>(context->GetRpcAllocatorState());
+        if (holder && holder->request() == request) {
+            sharedRequest = holder->GetSharedRequest();
         }
+        // the call is finished by the callback if the request has to wait for the queue, so that the gRPC thread is
+        // not blocked
+        auto done = [this, reactor, configName = config->configName](const grpc::Status& status) {
+            if (status.ok()) {
+                mRetryTimeController.UpRetryTimes(configName);
+            } else {
+                mRetryTimeController.DownRetryTimes(configName);
+            }
+            reactor->Finish(status);
+        };
+        if (ProcessForwardRequest(request, config, retryTimes, status, std::move(sharedRequest), done)) {
+            done(status);
+        }
+        return reactor;
     }
 
     reactor->Finish(status);
     return reactor;
 }
 
-void LoongSuiteForwardServiceImpl::ProcessForwardRequest(const LoongSuiteForwardRequest* request,
+bool LoongSuiteForwardServiceImpl::ProcessForwardRequest(const LoongSuiteForwardRequest* request,
                                                          std::shared_ptr<ForwardConfig> config,
                                                          int32_t retryTimes,
-                                                         grpc::Status& status) {
+                                                         grpc::Status& status,
+                                                         std::shared_ptr<const LoongSuiteForwardRequest> sharedRequest,
+                                                         std::function<void(const grpc::Status&)> callback) {
     if (!request) {
         status = grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "Invalid request");
-        return;
+        return true;
     }
 
     if (request->data_size() == 0) {
         status = grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "Empty data in forward request");
-        return;
+        return true;
     }
 
     auto eventGroup = PipelineEventGroup(std::make_shared<SourceBuffer>());
+    // the data is referenced instead of copied if the request can be kept alive by the event group
+    bool noCopy = sharedRequest != nullptr;
+    if (noCopy) {
+        eventGroup.GetSourceBuffer()->AddExternalBuffer(std::move(sharedRequest));
+    }
     for (const auto& singleData : request->data()) {
         if (singleData.empty()) {
             continue;
         }
         auto* event = eventGroup.AddRawEvent(true);
-        event->SetContent(singleData);
+        if (noCopy) {
+            event->SetContentNoCopy(StringView(singleData));
+        } else {
+            event->SetContent(singleData);
+        }
         event->SetTimestamp(time(nullptr), 0);
     }
 
     if (eventGroup.GetEvents().empty()) {
         status = grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "No raw event in forward request");
-        return;
+        return true;
     }
 
-    bool result = ProcessorRunner::GetInstance()->PushQueue(
-        config->queueKey, config->inputIndex, std::move(eventGroup), retryTimes);
+    bool result = false;
+    if (callback) {
+        // the request waits for the queue as long as it used to be retried, 10ms per retry
+        auto res = ProcessorRunner::GetInstance()->TryPushQueue(
+            config->queueKey,
+            config->inputIndex,
+            std::move(eventGroup),
+            [callback](bool success) {
+                callback(success ? grpc::Status::OK
+                                 : grpc::Status(grpc::StatusCode::UNAVAILABLE, "Queue is full, please retry later"));
+            },
+            static_cast<uint32_t>(std::max(retryTimes, 1)) * 10);
+        if (res == PushStatus::PENDING) {
+            return false;
+        }
+        result = res == PushStatus::PUSHED;
+    } else {
+        result = ProcessorRunner::GetInstance()->PushQueue(
+            config->queueKey, config->inputIndex, std::move(eventGroup), retryTimes);
+    }
 
     if (!result) {
         status = grpc::Status(grpc::StatusCode::UNAVAILABLE, "Queue is full, please retry later");
     } else {
         status = grpc::Status::OK;
     }
+    return true;
 }
 
 bool LoongSuiteForwardServiceImpl::AddToIndex(std::string& configName, ForwardConfig&& config, std::string& errorMsg) {
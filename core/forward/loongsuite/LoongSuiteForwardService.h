@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <grpcpp/support/message_allocator.h>
+
 #include <atomic>
+#include <functional>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -76,9 +79,34 @@ private:
     mutable std::shared_mutex mRetryTimesMutex;
 };
 
+// Holds the messages of a Forward call. The request is shared, so that event groups referencing the data in it
+// can keep it alive after the call is finished.
+class ForwardMessageHolder : public grpc::MessageHolder<LoongSuiteForwardRequest, LoongSuiteForwardResponse> {
+public:
+    ForwardMessageHolder() : mRequest(std::make_shared<LoongSuiteForwardRequest>()) {
+        set_request(mRequest.get());
+        set_response(&mResponse);
+    }
+
+    void Release() override { delete this; }
+
+    const std::shared_ptr<LoongSuiteForwardRequest>& GetSharedRequest() const { return mRequest; }
+
+private:
+    std::shared_ptr<LoongSuiteForwardRequest> mRequest;
+    LoongSuiteForwardResponse mResponse;
+};
+
+class ForwardMessageAllocator : public grpc::MessageAllocator<LoongSuiteForwardRequest, LoongSuiteForwardResponse> {
+public:
+    grpc::MessageHolder<LoongSuiteForwardRequest, LoongSuiteForwardResponse>* AllocateMessages() override {
+        return new ForwardMessageHolder();
+    }
+};
+
 class LoongSuiteForwardServiceImpl : public BaseService, public LoongSuiteForwardService::CallbackService {
 public:
-    LoongSuiteForwardServiceImpl() = default;
+    LoongSuiteForwardServiceImpl() { SetMessageAllocatorFor_Forward(&mMessageAllocator); }
     ~LoongSuiteForwardServiceImpl() override = default;
 
     bool Update(std::string configName, const Json::Value& config) override;
@@ -98,16 +126,23 @@ private:
     mutable std::shared_mutex mMatchIndexMutex;
 
     RetryTimeController mRetryTimeController;
+    ForwardMessageAllocator mMessageAllocator;
 
     bool AddToIndex(std::string& configName, ForwardConfig&& config, std::string& errorMsg);
     bool FindMatchingConfig(grpc::CallbackServerContext* context, std::shared_ptr<ForwardConfig>& config) const;
-    void ProcessForwardRequest(const LoongSuiteForwardRequest* request,
+    // @sharedRequest: the request itself if it can be kept alive after the call, so that its data is not copied.
+    // @callback: if set, the request waits for a full queue without blocking. In such case, false is returned and the
+    // final status is passed to the callback instead.
+    bool ProcessForwardRequest(const LoongSuiteForwardRequest* request,
                                std::shared_ptr<ForwardConfig> config,
                                int32_t retryTimes,
-                               grpc::Status& status);
+                               grpc::Status& status,
+                               std::shared_ptr<const LoongSuiteForwardRequest> sharedRequest = nullptr,
+                               std::function<void(const grpc::Status&)> callback = nullptr);
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class GrpcInputManagerUnittest;
     friend class LoongSuiteForwardServiceUnittest;
+    friend class LoongSuiteForwardBenchmark;
 #endif
 };
 
@@ -90,6 +90,7 @@ bool LogtailPlugin::LoadPipeline(const std::string& pipelineName,
                                  const std::string& region,
                                  logtail::QueueKey logstoreKey) {
 #ifndef APSARA_UNIT_TEST_MAIN
+    std::lock_guard<std::mutex> lock(mLoadPipelineMux);
     if (!mPluginValid) {
         LoadPluginBase();
     }
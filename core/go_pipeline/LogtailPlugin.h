@@ -22,6 +22,7 @@
 
 #include <cstdint>
 
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <unordered_map>
@@ -254,6 +255,8 @@ private:
 
     LoadGlobalConfigFun mLoadGlobalConfigFun;
     LoadPipelineFun mLoadPipelineFun;
+    // pipelines may be built concurrently, see pipeline_build_thread_count
+    std::mutex mLoadPipelineMux;
     UnloadPipelineFun mUnloadPipelineFun;
     StopAllPipelinesFun mStopAllPipelinesFun;
     StopFun mStopFun;
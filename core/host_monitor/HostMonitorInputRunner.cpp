@@ -308,9 +308,18 @@ void HostMonitorInputRunner::PushQueue(CollectContextPtr context, PipelineEventG
     if (it == mRegisteredCollector.end() || it->second.startTime != context->mStartTime) {
         return;
     }
-    bool pushResult
-        = ProcessorRunner::GetInstance()->PushQueue(context->mProcessQueueKey, context->mInputIndex, std::move(group));
-    if (!pushResult) {
+    // collector threads should not wait for the queue, the group is parked if the queue is full
+    auto pushResult = ProcessorRunner::GetInstance()->TryPushQueue(
+        context->mProcessQueueKey,
+        context->mInputIndex,
+        std::move(group),
+        [collectorName = context->mCollectorName](bool success) {
+            if (!success) {
+                LOG_ERROR(sLogger,
+                          ("host monitor push process queue failed", "discard data")("collector", collectorName));
+            }
+        });
+    if (pushResult == PushStatus::REJECTED) {
         LOG_ERROR(sLogger,
                   ("host monitor push process queue failed", "discard data")("collector", context->mCollectorName));
     }
@@ -28,6 +28,10 @@ macro(all_link target_name)
     endif()
     if (UNIX)
         target_link_libraries(${target_name} dl)
+        if (LINUX)
+            # timer_create for the cpu profiler, which is not in libc before glibc 2.34
+            target_link_libraries(${target_name} rt)
+        endif ()
         if (ENABLE_COMPATIBLE_MODE)
             target_link_libraries(${target_name} rt -static-libstdc++ -static-libgcc)
         endif ()
@@ -91,6 +91,7 @@ public:
 
     StringView GetLevel() const { return mLevel; }
     void SetLevel(const std::string& level);
+    void SetLevelNoCopy(StringView level) { mLevel = level; }
 
     bool Empty() const { return mIndex.empty(); }
     size_t Size() const { return mIndex.size(); }
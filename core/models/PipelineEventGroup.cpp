@@ -68,7 +68,8 @@ PipelineEventGroup::PipelineEventGroup(PipelineEventGroup&& rhs) noexcept
       mTags(std::move(rhs.mTags)),
       mEvents(std::move(rhs.mEvents)),
       mSourceBuffer(std::move(rhs.mSourceBuffer)),
-      mExtraSourceBuffers(std::move(rhs.mExtraSourceBuffers)) {
+      mExtraSourceBuffers(std::move(rhs.mExtraSourceBuffers)),
+      mCreateTime(rhs.mCreateTime) {
     for (auto& item : mEvents) {
         item->ResetPipelineEventGroup(this);
     }
@@ -86,6 +87,7 @@ PipelineEventGroup& PipelineEventGroup::operator=(PipelineEventGroup&& rhs) noex
         mEvents = std::move(rhs.mEvents);
         mSourceBuffer = std::move(rhs.mSourceBuffer);
         mExtraSourceBuffers = std::move(rhs.mExtraSourceBuffers);
+        mCreateTime = rhs.mCreateTime;
         for (auto& item : mEvents) {
             item->ResetPipelineEventGroup(this);
         }
@@ -99,6 +101,7 @@ PipelineEventGroup PipelineEventGroup::Copy() const {
     res.mTags = mTags;
     res.mExactlyOnceCheckpoint = mExactlyOnceCheckpoint;
     res.mExtraSourceBuffers = mExtraSourceBuffers;
+    res.mCreateTime = mCreateTime;
     for (auto& event : mEvents) {
         res.mEvents.emplace_back(event.Copy());
         res.mEvents.back()->ResetPipelineEventGroup(&res);
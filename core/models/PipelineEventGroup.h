@@ -18,6 +18,7 @@
 
 #include <cstddef>
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -79,9 +80,12 @@ using SourceBufferSet = std::unordered_set<std::shared_ptr<SourceBuffer>>;
 // only movable
 class PipelineEventGroup {
 public:
-    PipelineEventGroup(const std::shared_ptr<SourceBuffer>& sourceBuffer) : mSourceBuffer(sourceBuffer) {}
+    PipelineEventGroup(const std::shared_ptr<SourceBuffer>& sourceBuffer)
+        : mSourceBuffer(sourceBuffer), mCreateTime(std::chrono::system_clock::now()) {}
     PipelineEventGroup(const std::shared_ptr<SourceBuffer>& sourceBuffer, SourceBufferSet& extraSourceBuffers)
-        : mSourceBuffer(sourceBuffer), mExtraSourceBuffers(extraSourceBuffers) {}
+        : mSourceBuffer(sourceBuffer),
+          mExtraSourceBuffers(extraSourceBuffers),
+          mCreateTime(std::chrono::system_clock::now()) {}
     ~PipelineEventGroup();
     PipelineEventGroup(const PipelineEventGroup&) = delete;
     PipelineEventGroup& operator=(const PipelineEventGroup&) = delete;
@@ -135,6 +139,10 @@ public:
     RangeCheckpointPtr& GetExactlyOnceCheckpoint() { return mExactlyOnceCheckpoint; }
     bool IsReplay() const;
 
+    // time when the group is created by the input, used to measure the latency of each stage in the pipeline
+    std::chrono::system_clock::time_point GetCreateTime() const { return mCreateTime; }
+    void SetCreateTime(std::chrono::system_clock::time_point createTime) { mCreateTime = createTime; }
+
     size_t DataSize() const;
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -155,6 +163,7 @@ private:
     RangeCheckpointPtr mExactlyOnceCheckpoint;
 
     SourceBufferSet mExtraSourceBuffers;
+    std::chrono::system_clock::time_point mCreateTime;
 };
 
 } // namespace logtail
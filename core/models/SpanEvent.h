@@ -99,6 +99,7 @@ public:
 
         StringView GetName() const { return mName; }
         void SetName(const std::string& name);
+        void SetNameNoCopy(StringView name) { mName = name; }
 
         StringView GetTag(StringView key) const;
         bool HasTag(StringView key) const;
@@ -146,18 +147,23 @@ public:
 
     StringView GetTraceId() const { return mTraceId; }
     void SetTraceId(const std::string& traceId);
+    void SetTraceIdNoCopy(StringView traceId) { mTraceId = traceId; }
 
     StringView GetSpanId() const { return mSpanId; }
     void SetSpanId(const std::string& spanId);
+    void SetSpanIdNoCopy(StringView spanId) { mSpanId = spanId; }
 
     StringView GetTraceState() const { return mTraceState; }
     void SetTraceState(const std::string& traceState);
+    void SetTraceStateNoCopy(StringView traceState) { mTraceState = traceState; }
 
     StringView GetParentSpanId() const { return mParentSpanId; }
     void SetParentSpanId(const std::string& parentSpanId);
+    void SetParentSpanIdNoCopy(StringView parentSpanId) { mParentSpanId = parentSpanId; }
 
     StringView GetName() const { return mName; }
     void SetName(const std::string& name);
+    void SetNameNoCopy(StringView name) { mName = name; }
 
     Kind GetKind() const { return mKind; }
     void SetKind(Kind kind) { mKind = kind; }
@@ -0,0 +1,405 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "monitor/CpuProfiler.h"
+
+#if defined(__linux__)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_BOOL(enable_cpu_profiler,
+                 "sample the cpu of the processor and flusher threads, and attribute it to pipelines and plugins",
+                 false);
+DEFINE_FLAG_INT32(cpu_profiler_frequency, "samples per second of cpu time of each thread", 99);
+DEFINE_FLAG_INT32(cpu_profiler_max_stacks, "max distinct stacks kept between two exports", 10000);
+
+// may be missing in old libc headers
+#if defined(__linux__) && !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+using namespace std;
+
+namespace logtail {
+
+thread_local int32_t CpuProfiler::sThreadIdx = -1;
+
+bool CpuProfiler::IsEnabled() {
+#if defined(__linux__)
+    return BOOL_FLAG(enable_cpu_profiler);
+#else
+    return false;
+#endif
+}
+
+uint32_t CpuProfiler::RegisterTag(const string& configName,
+                                  const string& pluginType,
+                                  const string& pluginID,
+                                  const CounterPtr& cpuTimeMs) {
+    if (!IsEnabled()) {
+        return 0;
+    }
+    string plugin = pluginType.empty() ? "" : pluginType + "/" + pluginID;
+    string key = configName + "\n" + plugin;
+    lock_guard<mutex> lock(mTagsMux);
+    auto it = mTagIdx.find(key);
+    if (it != mTagIdx.end()) {
+        auto& tag = mTags[it->second - 1];
+        tag.mCpuTimeMs = cpuTimeMs;
+        tag.mPendingUs = 0;
+        return it->second;
+    }
+    // 0 means no tag
+    uint32_t idx = static_cast<uint32_t>(mTags.size()) + 1;
+    mTags.push_back({configName, plugin, cpuTimeMs, 0});
+    mTagIdx[key] = idx;
+    if (plugin.empty()) {
+        mPipelineTags[configName] = idx;
+    }
+    return idx;
+}
+
+void CpuProfiler::RegisterThread(const string& name) {
+    if (!IsEnabled() || sThreadIdx >= 0) {
+        return;
+    }
+    ThreadInfo thread;
+    thread.mName = name;
+#if defined(__linux__)
+    thread.mTid = static_cast<pid_t>(syscall(SYS_gettid));
+    if (pthread_getcpuclockid(pthread_self(), &thread.mClockID) != 0) {
+        LOG_WARNING(sLogger, ("failed to get cpu clock of thread, thread not profiled", name));
+        return;
+    }
+#endif
+    lock_guard<mutex> lock(mThreadsMux);
+    sThreadIdx = static_cast<int32_t>(mThreads.size());
+    mThreads.push_back(thread);
+    if (mIsRunning) {
+        ArmTimer(mThreads.back());
+    }
+}
+
+void CpuProfiler::UnregisterThread() {
+    if (sThreadIdx < 0) {
+        return;
+    }
+    lock_guard<mutex> lock(mThreadsMux);
+    // the entry is kept, since the samples not aggregated yet refer to it by index
+    auto& thread = mThreads[sThreadIdx];
+    DisarmTimer(thread);
+    thread.mExited = true;
+    sThreadIdx = -1;
+}
+
+#if defined(__linux__)
+bool CpuProfiler::Start() {
+    if (!IsEnabled() || mIsRunning) {
+        return false;
+    }
+    struct sigaction oldAction;
+    if (sigaction(SIGPROF, nullptr, &oldAction) != 0) {
+        LOG_WARNING(sLogger, ("cpu profiler not started, failed to get signal handler", strerror(errno)));
+        return false;
+    }
+    bool handledByOthers = (oldAction.sa_flags & SA_SIGINFO)
+        ? oldAction.sa_sigaction != &CpuProfiler::OnSignal
+        : oldAction.sa_handler != SIG_DFL && oldAction.sa_handler != SIG_IGN;
+    if (handledByOthers) {
+        LOG_WARNING(sLogger, ("cpu profiler not started", "SIGPROF is already handled by another profiler"));
+        return false;
+    }
+    // backtrace loads libgcc lazily on first use, which must not happen in the signal handler
+    void* frames[1];
+    backtrace(frames, 1);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = &CpuProfiler::OnSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, nullptr) != 0) {
+        LOG_WARNING(sLogger, ("cpu profiler not started, failed to install signal handler", strerror(errno)));
+        return false;
+    }
+
+    mPeriodUs = 1000000 / max(1, min(INT32_FLAG(cpu_profiler_frequency), 1000));
+    mIsRunning = true;
+    {
+        lock_guard<mutex> lock(mThreadsMux);
+        for (auto& thread : mThreads) {
+            if (!thread.mExited) {
+                ArmTimer(thread);
+            }
+        }
+    }
+    LOG_INFO(sLogger, ("cpu profiler", "started")("sample period us", mPeriodUs));
+    return true;
+}
+
+void CpuProfiler::Stop() {
+    if (!mIsRunning) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(mThreadsMux);
+        for (auto& thread : mThreads) {
+            DisarmTimer(thread);
+        }
+    }
+    mIsRunning = false;
+    // the handler is kept, since a signal may still be pending, and it does nothing when the profiler is stopped
+    Aggregate();
+    LOG_INFO(sLogger, ("cpu profiler", "stopped"));
+}
+
+bool CpuProfiler::ArmTimer(ThreadInfo& thread) {
+    if (thread.mArmed) {
+        return true;
+    }
+    sigevent event;
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    event.sigev_notify_thread_id = thread.mTid;
+    if (timer_create(thread.mClockID, &event, &thread.mTimer) != 0) {
+        LOG_WARNING(sLogger,
+                    ("failed to create cpu timer, thread not profiled", thread.mName)("error", strerror(errno)));
+        return false;
+    }
+    itimerspec spec;
+    spec.it_interval.tv_sec = mPeriodUs / 1000000;
+    spec.it_interval.tv_nsec = (mPeriodUs % 1000000) * 1000;
+    spec.it_value = spec.it_interval;
+    if (timer_settime(thread.mTimer, 0, &spec, nullptr) != 0) {
+        LOG_WARNING(sLogger, ("failed to arm cpu timer, thread not profiled", thread.mName)("error", strerror(errno)));
+        timer_delete(thread.mTimer);
+        return false;
+    }
+    thread.mArmed = true;
+    return true;
+}
+
+void CpuProfiler::DisarmTimer(ThreadInfo& thread) {
+    if (!thread.mArmed) {
+        return;
+    }
+    timer_delete(thread.mTimer);
+    thread.mArmed = false;
+}
+
+// only async-signal-safe operations are allowed here: the slot is claimed with a CAS and backtrace is preloaded
+void CpuProfiler::OnSignal(int sig, siginfo_t* info, void* ucontext) {
+    int savedErrno = errno;
+    CpuProfiler* profiler = GetInstance();
+    if (profiler->mIsRunning.load(memory_order_relaxed) && sThreadIdx >= 0) {
+        Sample& sample = profiler->mSamples[profiler->mNextSlot.fetch_add(1, memory_order_relaxed) % kSlotCnt];
+        uint32_t expected = EMPTY;
+        if (sample.mState.compare_exchange_strong(expected, WRITING, memory_order_acquire)) {
+            void* frames[kMaxStackDepth + kSkippedFrames];
+            int depth = backtrace(frames, kMaxStackDepth + kSkippedFrames);
+            uint32_t skipped = min(static_cast<uint32_t>(max(depth, 0)), static_cast<uint32_t>(kSkippedFrames));
+            sample.mDepth = static_cast<uint32_t>(max(depth, 0)) - skipped;
+            memcpy(sample.mFrames, frames + skipped, sample.mDepth * sizeof(void*));
+            sample.mTag = sThreadTag;
+            sample.mThreadIdx = sThreadIdx;
+            sample.mState.store(READY, memory_order_release);
+        } else {
+            // the slots are not drained in time
+            profiler->mDroppedSamples.fetch_add(1, memory_order_relaxed);
+        }
+    }
+    errno = savedErrno;
+}
+
+const string& CpuProfiler::Symbolize(void* pc) {
+    auto it = mSymbols.find(pc);
+    if (it != mSymbols.end()) {
+        return it->second;
+    }
+    string symbol;
+    Dl_info info;
+    // pc is a return address except for the innermost frame, which is good enough to find the function
+    if (dladdr(pc, &info) != 0 && info.dli_sname != nullptr) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        symbol = status == 0 && demangled != nullptr ? demangled : info.dli_sname;
+        free(demangled);
+    } else if (info.dli_fname != nullptr) {
+        const char* module = strrchr(info.dli_fname, '/');
+        ostringstream oss;
+        oss << (module == nullptr ? info.dli_fname : module + 1) << "+0x" << hex
+            << (reinterpret_cast<uintptr_t>(pc) - reinterpret_cast<uintptr_t>(info.dli_fbase));
+        symbol = oss.str();
+    } else {
+        ostringstream oss;
+        oss << "0x" << hex << reinterpret_cast<uintptr_t>(pc);
+        symbol = oss.str();
+    }
+    // ';' separates the frames in the collapsed format
+    replace(symbol.begin(), symbol.end(), ';', ',');
+    return mSymbols.emplace(pc, std::move(symbol)).first->second;
+}
+#else
+bool CpuProfiler::Start() {
+    return false;
+}
+
+void CpuProfiler::Stop() {
+}
+
+bool CpuProfiler::ArmTimer(ThreadInfo& thread) {
+    return false;
+}
+
+void CpuProfiler::DisarmTimer(ThreadInfo& thread) {
+}
+
+const string& CpuProfiler::Symbolize(void* pc) {
+    auto it = mSymbols.find(pc);
+    if (it != mSymbols.end()) {
+        return it->second;
+    }
+    ostringstream oss;
+    oss << "0x" << hex << reinterpret_cast<uintptr_t>(pc);
+    return mSymbols.emplace(pc, oss.str()).first->second;
+}
+#endif
+
+void CpuProfiler::Aggregate() {
+    unordered_map<uint32_t, uint64_t> samplesPerTag;
+    {
+        lock_guard<mutex> lock(mStacksMux);
+        size_t maxStacks = static_cast<size_t>(max(INT32_FLAG(cpu_profiler_max_stacks), 0));
+        StackKey key;
+        for (auto& sample : mSamples) {
+            if (sample.mState.load(memory_order_acquire) != READY) {
+                continue;
+            }
+            key.first = {sample.mTag, sample.mThreadIdx};
+            key.second.assign(sample.mFrames, sample.mFrames + sample.mDepth);
+            sample.mState.store(EMPTY, memory_order_release);
+
+            ++samplesPerTag[key.first.first];
+            auto it = mStacks.find(key);
+            if (it != mStacks.end()) {
+                ++it->second;
+            } else if (mStacks.size() < maxStacks) {
+                mStacks.emplace(key, 1);
+            } else {
+                ++mTruncatedSamples;
+            }
+        }
+    }
+    for (const auto& item : samplesPerTag) {
+        AddCpuTime(item.first, item.second);
+    }
+    uint64_t dropped = mDroppedSamples.exchange(0);
+    if (dropped > 0) {
+        LOG_WARNING(sLogger, ("cpu profiler samples dropped", dropped));
+    }
+}
+
+void CpuProfiler::AddCpuTime(uint32_t tag, uint64_t samples) {
+    if (tag == 0) {
+        return;
+    }
+    lock_guard<mutex> lock(mTagsMux);
+    if (tag > mTags.size()) {
+        return;
+    }
+    auto add = [&](Tag& t) {
+        t.mPendingUs += samples * mPeriodUs;
+        if (t.mCpuTimeMs) {
+            ADD_COUNTER(t.mCpuTimeMs, t.mPendingUs / 1000);
+        }
+        t.mPendingUs %= 1000;
+    };
+    Tag& t = mTags[tag - 1];
+    add(t);
+    if (!t.mPlugin.empty()) {
+        // the cpu of a plugin is also the cpu of its pipeline
+        auto it = mPipelineTags.find(t.mConfigName);
+        if (it != mPipelineTags.end()) {
+            add(mTags[it->second - 1]);
+        }
+    }
+}
+
+vector<CpuProfileStack> CpuProfiler::FlushStacks() {
+    map<StackKey, uint64_t> stacks;
+    uint64_t truncated = 0;
+    {
+        lock_guard<mutex> lock(mStacksMux);
+        stacks.swap(mStacks);
+        swap(truncated, mTruncatedSamples);
+    }
+
+    vector<CpuProfileStack> res;
+    res.reserve(stacks.size() + 1);
+    for (const auto& item : stacks) {
+        CpuProfileStack stack;
+        uint32_t tag = item.first.first.first;
+        int32_t threadIdx = item.first.first.second;
+        if (tag != 0) {
+            lock_guard<mutex> lock(mTagsMux);
+            if (tag <= mTags.size()) {
+                stack.mConfigName = mTags[tag - 1].mConfigName;
+                stack.mPlugin = mTags[tag - 1].mPlugin;
+            }
+        }
+        {
+            lock_guard<mutex> lock(mThreadsMux);
+            if (threadIdx >= 0 && static_cast<size_t>(threadIdx) < mThreads.size()) {
+                stack.mThreadName = mThreads[threadIdx].mName;
+            }
+        }
+        const auto& frames = item.first.second;
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            if (!stack.mFrames.empty()) {
+                stack.mFrames += ';';
+            }
+            stack.mFrames += Symbolize(*it);
+        }
+        stack.mSamples = item.second;
+        stack.mCpuTimeMs = item.second * mPeriodUs / 1000;
+        res.emplace_back(std::move(stack));
+    }
+    if (truncated > 0) {
+        CpuProfileStack stack;
+        stack.mFrames = "[truncated]";
+        stack.mSamples = truncated;
+        stack.mCpuTimeMs = truncated * mPeriodUs / 1000;
+        res.emplace_back(std::move(stack));
+    }
+    return res;
+}
+
+} // namespace logtail
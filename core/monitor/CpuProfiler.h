@@ -0,0 +1,174 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#if defined(__linux__)
+#include <signal.h>
+#include <time.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "monitor/metric_models/MetricTypes.h"
+
+namespace logtail {
+
+struct CpuProfileStack {
+    std::string mThreadName;
+    std::string mConfigName;
+    // plugin type and id, e.g. processor_parse_json_native/2, empty for the pipeline itself
+    std::string mPlugin;
+    // frames from the outermost to the innermost, separated by ';', i.e. the collapsed format of flame graphs
+    std::string mFrames;
+    uint64_t mSamples = 0;
+    uint64_t mCpuTimeMs = 0;
+};
+
+// Samples the cpu of the registered threads with a timer on the cpu clock of each thread, and attributes each sample
+// to the pipeline or plugin the thread is running for, which is marked by CpuProfileScope. The cpu time attributed
+// is added to the cpu_time_ms counter of the plugin and the pipeline, and the stacks sampled are kept for export.
+class CpuProfiler {
+public:
+    CpuProfiler(const CpuProfiler&) = delete;
+    CpuProfiler& operator=(const CpuProfiler&) = delete;
+
+    static CpuProfiler* GetInstance() {
+        static CpuProfiler instance;
+        return &instance;
+    }
+
+    static bool IsEnabled();
+
+    // returns the tag marking the pipeline when pluginType is empty, or a plugin of it, 0 if the profiler is disabled.
+    // A plugin recreated by a pipeline update gets the same tag, whose counter is replaced.
+    uint32_t RegisterTag(const std::string& configName,
+                         const std::string& pluginType,
+                         const std::string& pluginID,
+                         const CounterPtr& cpuTimeMs);
+    // only the registered threads are sampled, and they must unregister before exiting
+    void RegisterThread(const std::string& name);
+    void UnregisterThread();
+
+    bool Start();
+    void Stop();
+    // moves the samples taken so far to the counters and the stacks, called periodically by the self monitor
+    void Aggregate();
+    // returns the stacks aggregated since the last call
+    std::vector<CpuProfileStack> FlushStacks();
+
+    static uint32_t SwapThreadTag(uint32_t tag) {
+        uint32_t prev = sThreadTag;
+        sThreadTag = tag;
+        return prev;
+    }
+
+private:
+    static const size_t kMaxStackDepth = 32;
+    // the signal handler and the signal trampoline
+    static const size_t kSkippedFrames = 2;
+    static const size_t kSlotCnt = 8192;
+
+    enum SlotState : uint32_t { EMPTY, WRITING, READY };
+
+    // written by the signal handler, so it must be lock free and fixed size
+    struct Sample {
+        std::atomic<uint32_t> mState{EMPTY};
+        uint32_t mTag = 0;
+        int32_t mThreadIdx = -1;
+        uint32_t mDepth = 0;
+        void* mFrames[kMaxStackDepth];
+    };
+
+    struct Tag {
+        std::string mConfigName;
+        std::string mPlugin;
+        CounterPtr mCpuTimeMs;
+        uint64_t mPendingUs = 0;
+    };
+
+    struct ThreadInfo {
+        std::string mName;
+#if defined(__linux__)
+        pid_t mTid = 0;
+        clockid_t mClockID;
+        timer_t mTimer;
+#endif
+        bool mArmed = false;
+        bool mExited = false;
+    };
+
+    using StackKey = std::pair<std::pair<uint32_t, int32_t>, std::vector<void*>>;
+
+    CpuProfiler() = default;
+    ~CpuProfiler() = default;
+
+#if defined(__linux__)
+    static void OnSignal(int sig, siginfo_t* info, void* ucontext);
+#endif
+    bool ArmTimer(ThreadInfo& thread);
+    void DisarmTimer(ThreadInfo& thread);
+    void AddCpuTime(uint32_t tag, uint64_t samples);
+    const std::string& Symbolize(void* pc);
+
+    // inline, so that marking a thread costs a plain store of a thread local variable
+    static inline thread_local uint32_t sThreadTag = 0;
+    static thread_local int32_t sThreadIdx;
+
+    std::atomic_bool mIsRunning = false;
+    uint64_t mPeriodUs = 0;
+    std::array<Sample, kSlotCnt> mSamples;
+    std::atomic<uint64_t> mNextSlot = 0;
+    std::atomic<uint64_t> mDroppedSamples = 0;
+
+    std::mutex mThreadsMux;
+    std::vector<ThreadInfo> mThreads;
+
+    std::mutex mTagsMux;
+    std::vector<Tag> mTags;
+    std::unordered_map<std::string, uint32_t> mTagIdx;
+    std::unordered_map<std::string, uint32_t> mPipelineTags;
+
+    std::mutex mStacksMux;
+    std::map<StackKey, uint64_t> mStacks;
+    uint64_t mTruncatedSamples = 0;
+    std::unordered_map<void*, std::string> mSymbols;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class CpuProfilerUnittest;
+#endif
+};
+
+// Marks the cpu used by this thread in its lifetime as used by the tag, and restores the former tag on destruction.
+class CpuProfileScope {
+public:
+    explicit CpuProfileScope(uint32_t tag) : mPrevTag(CpuProfiler::SwapThreadTag(tag)) {}
+    ~CpuProfileScope() { CpuProfiler::SwapThreadTag(mPrevTag); }
+    CpuProfileScope(const CpuProfileScope&) = delete;
+    CpuProfileScope& operator=(const CpuProfileScope&) = delete;
+
+private:
+    uint32_t mPrevTag;
+};
+
+} // namespace logtail
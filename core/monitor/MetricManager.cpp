@@ -65,7 +65,26 @@ void WriteMetrics::Clear() {
     }
 }
 
-MetricsRecord* WriteMetrics::DoSnapshot() {
+MetricsRecord* WriteMetrics::DoSnapshot(MetricsRecord* recycled) {
+    // the recycled snapshot is in reverse order of the write list, reverse it so that each record is likely to be
+    // collected into the one with the same metrics in the last round
+    MetricsRecord* reusable = nullptr;
+    while (recycled) {
+        MetricsRecord* next = recycled->GetNext();
+        recycled->SetNext(reusable);
+        reusable = recycled;
+        recycled = next;
+    }
+    auto collect = [&reusable](MetricsRecord* metrics) {
+        if (reusable == nullptr) {
+            return metrics->Collect();
+        }
+        MetricsRecord* res = reusable;
+        reusable = reusable->GetNext();
+        metrics->CollectTo(*res);
+        return res;
+    };
+
     // new read head
     MetricsRecord* snapshot = nullptr;
     MetricsRecord* toDeleteHead = nullptr;
@@ -110,7 +129,7 @@ MetricsRecord* WriteMetrics::DoSnapshot() {
 
     // copy head
     if (preTmp) {
-        MetricsRecord* newMetrics = preTmp->Collect();
+        MetricsRecord* newMetrics = collect(preTmp);
         newMetrics->SetNext(snapshot);
         snapshot = newMetrics;
         metricsSnapshotTotal++;
@@ -125,7 +144,7 @@ MetricsRecord* WriteMetrics::DoSnapshot() {
             toDeleteHead = tmp;
             tmp = preTmp->GetNext();
         } else {
-            MetricsRecord* newMetrics = tmp->Collect();
+            MetricsRecord* newMetrics = collect(tmp);
             newMetrics->SetNext(snapshot);
             snapshot = newMetrics;
             preTmp = tmp;
@@ -140,6 +159,11 @@ MetricsRecord* WriteMetrics::DoSnapshot() {
         delete toDelete;
         writeMetricsDeleteTotal++;
     }
+    while (reusable) {
+        MetricsRecord* toDelete = reusable;
+        reusable = reusable->GetNext();
+        delete toDelete;
+    }
     LOG_INFO(sLogger,
              ("writeMetricsTotal", writeMetricsTotal)("writeMetricsDeleteTotal", writeMetricsDeleteTotal)(
                  "metricsSnapshotTotal", metricsSnapshotTotal));
@@ -183,20 +207,14 @@ void ReadMetrics::UpdateMetrics() {
     }
 #endif
     // 获取c++指标
-    MetricsRecord* snapshot = WriteMetrics::GetInstance()->DoSnapshot();
-    MetricsRecord* toDelete;
+    // the last snapshot is no longer read after the head is changed, so it is kept and reused by the next round
+    MetricsRecord* snapshot = WriteMetrics::GetInstance()->DoSnapshot(mRecycledHead);
     {
         // Only lock when change head
         WriteLock lock(mReadWriteLock);
-        toDelete = mHead;
+        mRecycledHead = mHead;
         mHead = snapshot;
     }
-    // delete old linklist
-    while (toDelete) {
-        MetricsRecord* obj = toDelete;
-        toDelete = toDelete->GetNext();
-        delete obj;
-    }
 }
 
 MetricsRecord* ReadMetrics::GetHead() {
@@ -211,6 +229,11 @@ void ReadMetrics::Clear() {
         mHead = mHead->GetNext();
         delete toDelete;
     }
+    while (mRecycledHead) {
+        MetricsRecord* toDelete = mRecycledHead;
+        mRecycledHead = mRecycledHead->GetNext();
+        delete toDelete;
+    }
 }
 
 // metrics from Go that are provided by cpp
@@ -54,7 +54,8 @@ public:
                                 MetricLabels&& labels,
                                 DynamicMetricLabels&& dynamicLabels = {});
     void CommitMetricsRecordRef(MetricsRecordRef& ref);
-    MetricsRecord* DoSnapshot();
+    // @recycled: the snapshot of the last but one round, whose records are reused and then released.
+    MetricsRecord* DoSnapshot(MetricsRecord* recycled = nullptr);
 
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -67,6 +68,8 @@ private:
     ReadMetrics() = default;
     mutable ReadWriteLock mReadWriteLock;
     MetricsRecord* mHead = nullptr;
+    // only accessed by UpdateMetrics
+    MetricsRecord* mRecycledHead = nullptr;
     std::vector<std::map<std::string, std::string>> mGoMetrics;
     void Clear();
     MetricsRecord* GetHead();
@@ -31,6 +31,7 @@
 #include "app_config/AppConfig.h"
 #include "application/Application.h"
 #include "collection_pipeline/CollectionPipelineManager.h"
+#include "collection_pipeline/batch/TimeoutFlushManager.h"
 #include "common/DevInode.h"
 #include "common/ExceptionBase.h"
 #include "common/LogtailCommonFlags.h"
@@ -38,6 +39,7 @@
 #include "common/RuntimeUtil.h"
 #include "common/StringTools.h"
 #include "common/TimeUtil.h"
+#include "common/memory/ChunkPool.h"
 #include "common/version.h"
 #include "constants/Constants.h"
 #include "file_server/event_handler/LogInput.h"
@@ -57,6 +59,10 @@ using namespace std;
 using namespace sls_logs;
 
 DEFINE_FLAG_BOOL(logtail_dump_monitor_info, "enable to dump Logtail monitor info (CPU, mem)", false);
+DEFINE_FLAG_BOOL(enable_memory_governor,
+                 "throttle inputs, flush batches early and spill data to disk when data in flight nears the budget",
+                 false);
+DEFINE_FLAG_INT32(memory_governor_budget_percent, "budget of data in flight, in percentage of memory usage limit", 50);
 DECLARE_FLAG_BOOL(check_profile_region);
 
 namespace logtail {
@@ -153,6 +159,7 @@ void LogtailMonitor::Monitor() {
     LOG_INFO(sLogger, ("profiling", "started"));
     int32_t lastMonitorTime = time(NULL), lastCheckHardLimitTime = time(nullptr);
     CpuStat curCpuStat;
+    uint64_t lastChunkAllocTotal = 0, lastChunkHitTotal = 0;
     {
         unique_lock<mutex> lock(mThreadRunningMux);
         while (mIsThreadRunning) {
@@ -160,6 +167,7 @@ void LogtailMonitor::Monitor() {
                 break;
             }
             GetCpuStat(curCpuStat);
+            CheckMemoryGovernor();
 
             // Update mRealtimeCpuStat for InputFlowControl.
             if (AppConfig::GetInstance()->IsInputFlowControl()) {
@@ -192,6 +200,18 @@ void LogtailMonitor::Monitor() {
                 LoongCollectorMonitor::GetInstance()->SetAgentMemory(mMemStat.mRss);
                 CalCpuStat(curCpuStat, mCpuStat);
                 LoongCollectorMonitor::GetInstance()->SetAgentCpu(mCpuStat.mCpuUsage);
+                // hit rate of chunk allocations since last check
+                uint64_t chunkAllocTotal = ChunkPool::GetInstance()->GetAllocTotal();
+                uint64_t chunkHitTotal = ChunkPool::GetInstance()->GetHitTotal();
+                double chunkHitRate = 0.0;
+                if (chunkAllocTotal > lastChunkAllocTotal) {
+                    chunkHitRate = static_cast<double>(chunkHitTotal - lastChunkHitTotal)
+                        / (chunkAllocTotal - lastChunkAllocTotal);
+                }
+                LoongCollectorMonitor::GetInstance()->SetAgentChunkPoolStat(
+                    chunkHitRate, ChunkPool::GetInstance()->GetRetainedBytes());
+                lastChunkAllocTotal = chunkAllocTotal;
+                lastChunkHitTotal = chunkHitTotal;
                 if (CheckHardMemLimit()) {
                     LOG_ERROR(sLogger,
                               ("Resource used by program exceeds hard limit",
@@ -211,6 +231,7 @@ void LogtailMonitor::Monitor() {
                 if (1 == mMemStat.mViolateNum) {
                     LOG_DEBUG(sLogger, ("Memory is upper limit", "run gabbage collection."));
                     LogInput::GetInstance()->SetForceClearFlag(true);
+                    ChunkPool::GetInstance()->Trim();
 #ifndef LOGTAIL_NO_TC_MALLOC
                     gLastTcmallocReleaseMemTime = 0;
 #endif
@@ -393,6 +414,35 @@ bool LogtailMonitor::CheckHardMemLimit() {
     return mMemStat.mRss > 5 * AppConfig::GetInstance()->GetMemUsageUpLimit();
 }
 
+void LogtailMonitor::CheckMemoryGovernor() {
+    auto governor = MemoryGovernor::GetInstance();
+    uint64_t budget = 0;
+    if (BOOL_FLAG(enable_memory_governor)) {
+        budget = static_cast<uint64_t>(AppConfig::GetInstance()->GetMemUsageUpLimit()) * 1024 * 1024
+            * INT32_FLAG(memory_governor_budget_percent) / 100;
+    }
+    governor->SetBudget(budget);
+
+    auto level = governor->GetLevel();
+    if (level != mMemoryPressureLevel) {
+        LOG_WARNING(sLogger,
+                    ("memory pressure level changed", MemoryGovernor::GetLevelName(level))(
+                        "last level", MemoryGovernor::GetLevelName(mMemoryPressureLevel))(
+                        "governed bytes", governor->GetTotalBytes())("budget", budget)(
+                        "source buffer bytes", governor->GetBytes(MemoryCategory::SOURCE_BUFFER))(
+                        "sender queue bytes", governor->GetBytes(MemoryCategory::SENDER_QUEUE))(
+                        "reader cache bytes", governor->GetBytes(MemoryCategory::READER_CACHE)));
+        mMemoryPressureLevel = level;
+    }
+    if (governor->ShouldFlushEarly()) {
+        // batched data is much smaller once serialized and compressed into sender queues
+        TimeoutFlushManager::GetInstance()->FlushAllBatchesEarly();
+        ChunkPool::GetInstance()->Trim();
+    }
+    LoongCollectorMonitor::GetInstance()->SetAgentGovernedMemory(governor->GetTotalBytes(),
+                                                                 static_cast<uint32_t>(level));
+}
+
 bool LogtailMonitor::DumpMonitorInfo(time_t monitorTime) {
     string path = GetAgentLogDir() + GetMonitorInfoFileName();
     ofstream outfile(path.c_str(), ofstream::app);
@@ -664,6 +714,10 @@ void LoongCollectorMonitor::Init() {
     mAgentOpenFdTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_OPEN_FD_TOTAL);
     mAgentConfigTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_PIPELINE_CONFIG_TOTAL);
     mAgentHostMonitorTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_HOST_MONITOR_TOTAL);
+    mAgentChunkPoolHitRate = mMetricsRecordRef.CreateDoubleGauge(METRIC_AGENT_CHUNK_POOL_HIT_RATE);
+    mAgentChunkPoolRetainedBytes = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_CHUNK_POOL_RETAINED_BYTES);
+    mAgentGovernedMemoryBytes = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_GOVERNED_MEMORY_BYTES);
+    mAgentMemoryPressureLevel = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_MEMORY_PRESSURE_LEVEL);
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 }
 
@@ -24,6 +24,7 @@
 
 #include "MetricManager.h"
 #include "MetricTypes.h"
+#include "common/memory/MemoryGovernor.h"
 
 #if defined(_MSC_VER)
 #include <Windows.h>
@@ -121,6 +122,9 @@ private:
 
     bool CheckHardMemLimit();
 
+    // CheckMemoryGovernor updates the budget of the memory governor and releases memory according to its level.
+    void CheckMemoryGovernor();
+
     // SendStatusProfile collects status profile and send them to server.
     // @suicide indicates if the target LogStore is logtail_suicide_profile.
     //   Because sending is an asynchronous procedure, the caller should wait for
@@ -165,6 +169,7 @@ private:
     CpuStat mCpuStat;
     // Memory usage statistics.
     MemStat mMemStat;
+    MemoryPressureLevel mMemoryPressureLevel = MemoryPressureLevel::NORMAL;
 
     // Current scale up level, updated by CheckScaledCpuUsageUpLimit.
     float mScaledCpuUsageUpLimit;
@@ -217,6 +222,14 @@ public:
         SET_GAUGE(mAgentHostMonitorTotal, total);
 #endif
     }
+    void SetAgentChunkPoolStat(double hitRate, uint64_t retainedBytes) {
+        SET_GAUGE(mAgentChunkPoolHitRate, hitRate);
+        SET_GAUGE(mAgentChunkPoolRetainedBytes, retainedBytes);
+    }
+    void SetAgentGovernedMemory(uint64_t bytes, uint32_t level) {
+        SET_GAUGE(mAgentGovernedMemoryBytes, bytes);
+        SET_GAUGE(mAgentMemoryPressureLevel, level);
+    }
 
     static std::string mHostname;
     static std::string mIpAddr;
@@ -252,6 +265,10 @@ private:
     IntGaugePtr mAgentOpenFdTotal;
     IntGaugePtr mAgentConfigTotal;
     IntGaugePtr mAgentHostMonitorTotal;
+    DoubleGaugePtr mAgentChunkPoolHitRate;
+    IntGaugePtr mAgentChunkPoolRetainedBytes;
+    IntGaugePtr mAgentGovernedMemoryBytes;
+    IntGaugePtr mAgentMemoryPressureLevel;
 };
 
 } // namespace logtail
@@ -18,8 +18,13 @@
 
 #include "MetricConstants.h"
 #include "Monitor.h"
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "monitor/CpuProfiler.h"
 #include "runner/ProcessorRunner.h"
 
+DEFINE_FLAG_INT32(cpu_profiler_export_interval_sec, "interval of exporting the stacks sampled by the cpu profiler", 60);
+
 using namespace std;
 
 namespace logtail {
@@ -28,6 +33,7 @@ const string SelfMonitorServer::INTERNAL_DATA_TYPE_ALARM = "__alarm__";
 const string SelfMonitorServer::INTERNAL_DATA_TYPE_METRIC = "__metric__";
 const string SelfMonitorServer::INTERNAL_DATA_TYPE_TASK_STATUS = "__task_status__";
 const string SelfMonitorServer::INTERNAL_DATA_TYPE_CONTAINER = "__container__";
+const string SelfMonitorServer::INTERNAL_DATA_TYPE_PROFILE = "__profile__";
 
 SelfMonitorServer::SelfMonitorServer() {
 }
@@ -38,6 +44,9 @@ SelfMonitorServer* SelfMonitorServer::GetInstance() {
 }
 
 void SelfMonitorServer::Init() {
+    if (CpuProfiler::IsEnabled()) {
+        CpuProfiler::GetInstance()->Start();
+    }
     mThreadRes = async(launch::async, &SelfMonitorServer::Monitor, this);
 }
 
@@ -45,6 +54,7 @@ void SelfMonitorServer::Monitor() {
     LOG_INFO(sLogger, ("self-monitor", "started"));
     int32_t lastMonitorTime = time(NULL);
     int32_t lastAlarmTime = time(NULL);
+    int32_t lastProfileTime = time(NULL);
     {
         unique_lock<mutex> lock(mThreadRunningMux);
         while (mIsThreadRunning) {
@@ -60,6 +70,14 @@ void SelfMonitorServer::Monitor() {
                 lastAlarmTime = nowTime;
                 SendAlarms();
             }
+            if (CpuProfiler::IsEnabled()) {
+                // drained every second, so that the sample slots hardly run out
+                CpuProfiler::GetInstance()->Aggregate();
+                if ((nowTime - lastProfileTime) >= INT32_FLAG(cpu_profiler_export_interval_sec)) {
+                    lastProfileTime = nowTime;
+                    SendProfiles();
+                }
+            }
         }
     }
     SendMetrics();
@@ -67,6 +85,7 @@ void SelfMonitorServer::Monitor() {
 }
 
 void SelfMonitorServer::Stop() {
+    CpuProfiler::GetInstance()->Stop();
     AlarmManager::GetInstance()->ForceToSend();
     {
         lock_guard<mutex> lock(mThreadRunningMux);
@@ -120,7 +139,7 @@ void SelfMonitorServer::SendMetrics() {
     ReadAsPipelineEventGroup(pipelineEventGroup);
 
     if (pipelineEventGroup.GetEvents().size() > 0) {
-        ProcessorRunner::GetInstance()->PushQueue(
+        ProcessorRunner::GetInstance()->TryPushQueue(
             mMetricPipelineCtx->GetProcessQueueKey(), mMetricInputIndex, std::move(pipelineEventGroup));
     }
 }
@@ -209,7 +228,7 @@ void SelfMonitorServer::SendAlarms() {
 
     for (auto& pipelineEventGroup : pipelineEventGroupList) {
         if (pipelineEventGroup.GetEvents().size() > 0) {
-            ProcessorRunner::GetInstance()->PushQueue(
+            ProcessorRunner::GetInstance()->TryPushQueue(
                 mAlarmPipelineCtx->GetProcessQueueKey(), mAlarmInputIndex, std::move(pipelineEventGroup));
         }
     }
@@ -238,12 +257,42 @@ void SelfMonitorServer::SendTaskStatus() {
 
     for (auto& pipelineEventGroup : pipelineEventGroupList) {
         if (pipelineEventGroup.GetEvents().size() > 0) {
-            ProcessorRunner::GetInstance()->PushQueue(
+            ProcessorRunner::GetInstance()->TryPushQueue(
                 mAlarmPipelineCtx->GetProcessQueueKey(), mAlarmInputIndex, std::move(pipelineEventGroup));
         }
     }
 }
 
+void SelfMonitorServer::SendProfiles() {
+    // metadata:
+    // INTERNAL_DATA_TYPE:__profile__
+    vector<CpuProfileStack> stacks = CpuProfiler::GetInstance()->FlushStacks();
+    if (stacks.empty()) {
+        return;
+    }
+    PipelineEventGroup pipelineEventGroup(std::make_shared<SourceBuffer>());
+    pipelineEventGroup.SetTagNoCopy(LOG_RESERVED_KEY_SOURCE, LoongCollectorMonitor::mIpAddr);
+    pipelineEventGroup.SetMetadata(EventGroupMetaKey::INTERNAL_DATA_TYPE, INTERNAL_DATA_TYPE_PROFILE);
+    time_t now = time(nullptr);
+    for (const auto& stack : stacks) {
+        LogEvent* logEvent = pipelineEventGroup.AddLogEvent();
+        logEvent->SetTimestamp(now);
+        logEvent->SetContent("thread", stack.mThreadName);
+        logEvent->SetContent("config_name", stack.mConfigName);
+        logEvent->SetContent("plugin", stack.mPlugin);
+        logEvent->SetContent("stack", stack.mFrames);
+        logEvent->SetContent("samples", ToString(stack.mSamples));
+        logEvent->SetContent("cpu_time_ms", ToString(stack.mCpuTimeMs));
+    }
+
+    ReadLock lock(mAlarmPipelineMux);
+    if (mAlarmPipelineCtx == nullptr) {
+        return;
+    }
+    ProcessorRunner::GetInstance()->TryPushQueue(
+        mAlarmPipelineCtx->GetProcessQueueKey(), mAlarmInputIndex, std::move(pipelineEventGroup));
+}
+
 LogEvent* SelfMonitorServer::AddTaskStatus(const std::string& region) {
     std::lock_guard<std::mutex> lock(mTaskStatusMutex);
     if (mTaskStatusMap.find(region) == mTaskStatusMap.end()) {
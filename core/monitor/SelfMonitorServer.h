@@ -47,6 +47,7 @@ public:
     static const std::string INTERNAL_DATA_TYPE_METRIC;
     static const std::string INTERNAL_DATA_TYPE_TASK_STATUS;
     static const std::string INTERNAL_DATA_TYPE_CONTAINER;
+    static const std::string INTERNAL_DATA_TYPE_PROFILE;
 
 private:
     SelfMonitorServer();
@@ -76,6 +77,9 @@ private:
     CollectionPipelineContext* mAlarmPipelineCtx = nullptr;
     size_t mAlarmInputIndex = 0;
 
+    // cpu profiles, sent through the alarm pipeline
+    void SendProfiles();
+
     // task status
     std::mutex mTaskStatusMutex;
     std::map<std::string, PipelineEventGroup> mTaskStatusMap;
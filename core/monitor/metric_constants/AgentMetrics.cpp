@@ -42,5 +42,9 @@ const string METRIC_AGENT_MEMORY_GO = "go_memory_used_mb";
 const string METRIC_AGENT_OPEN_FD_TOTAL = "open_fd_total";
 const string METRIC_AGENT_PIPELINE_CONFIG_TOTAL = "pipeline_config_total";
 const string METRIC_AGENT_HOST_MONITOR_TOTAL = "host_monitor_config_total";
+const string METRIC_AGENT_CHUNK_POOL_HIT_RATE = "chunk_pool_hit_rate";
+const string METRIC_AGENT_CHUNK_POOL_RETAINED_BYTES = "chunk_pool_retained_bytes";
+const string METRIC_AGENT_GOVERNED_MEMORY_BYTES = "governed_memory_bytes";
+const string METRIC_AGENT_MEMORY_PRESSURE_LEVEL = "memory_pressure_level";
 
 } // namespace logtail
@@ -63,6 +63,8 @@ const string METRIC_COMPONENT_BATCHER_BUFFERED_GROUPS_TOTAL = "buffered_groups_t
 const string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL = "buffered_events_total";
 const string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES = "buffered_size_bytes";
 const string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS = "total_add_time_ms";
+const string METRIC_COMPONENT_BATCHER_TARGET_MIN_SIZE_BYTES = "target_min_size_bytes";
+const string METRIC_COMPONENT_BATCHER_TARGET_MAX_SIZE_BYTES = "target_max_size_bytes";
 
 /**********************************************************
  *   queue
@@ -46,6 +46,10 @@ extern const std::string METRIC_AGENT_MEMORY_GO;
 extern const std::string METRIC_AGENT_OPEN_FD_TOTAL;
 extern const std::string METRIC_AGENT_PIPELINE_CONFIG_TOTAL;
 extern const std::string METRIC_AGENT_HOST_MONITOR_TOTAL;
+extern const std::string METRIC_AGENT_CHUNK_POOL_HIT_RATE;
+extern const std::string METRIC_AGENT_CHUNK_POOL_RETAINED_BYTES;
+extern const std::string METRIC_AGENT_GOVERNED_MEMORY_BYTES;
+extern const std::string METRIC_AGENT_MEMORY_PRESSURE_LEVEL;
 
 //////////////////////////////////////////////////////////////////////////
 // pipeline
@@ -61,11 +65,14 @@ extern const std::string METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL;
 extern const std::string METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL;
 extern const std::string METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES;
 extern const std::string METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS;
+extern const std::string METRIC_PIPELINE_PROCESSORS_IN_LATENCY_MS;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES;
 extern const std::string METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS;
+extern const std::string METRIC_PIPELINE_FLUSHERS_IN_LATENCY_MS;
 extern const std::string METRIC_PIPELINE_START_TIME;
+extern const std::string METRIC_PIPELINE_CPU_TIME_MS;
 
 //////////////////////////////////////////////////////////////////////////
 // plugin
@@ -84,6 +91,7 @@ extern const std::string& METRIC_PLUGIN_OUT_EVENT_GROUPS_TOTAL;
 extern const std::string& METRIC_PLUGIN_OUT_SIZE_BYTES;
 extern const std::string& METRIC_PLUGIN_TOTAL_DELAY_MS;
 extern const std::string& METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS;
+extern const std::string METRIC_PLUGIN_CPU_TIME_MS;
 
 /**********************************************************
  *   input_file
@@ -188,6 +196,10 @@ extern const std::string METRIC_PLUGIN_FLUSHER_SERVER_ERROR_TOTAL;
 extern const std::string METRIC_PLUGIN_FLUSHER_UNAUTH_ERROR_TOTAL;
 extern const std::string METRIC_PLUGIN_FLUSHER_PARAMS_ERROR_TOTAL;
 extern const std::string METRIC_PLUGIN_FLUSHER_OTHER_ERROR_TOTAL;
+extern const std::string METRIC_PLUGIN_FLUSHER_BATCHED_LATENCY_MS;
+extern const std::string METRIC_PLUGIN_FLUSHER_SERIALIZED_LATENCY_MS;
+extern const std::string METRIC_PLUGIN_FLUSHER_SENT_LATENCY_MS;
+extern const std::string METRIC_PLUGIN_FLUSHER_ACKED_LATENCY_MS;
 
 /**********************************************************
  *   processor_parse_apsara_native
@@ -262,6 +274,8 @@ extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_GROUPS_TOTAL;
 extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL;
 extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES;
 extern const std::string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS;
+extern const std::string METRIC_COMPONENT_BATCHER_TARGET_MIN_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_BATCHER_TARGET_MAX_SIZE_BYTES;
 
 /**********************************************************
  *   queue
@@ -328,6 +342,7 @@ extern const std::string METRIC_RUNNER_SINK_SEND_CONCURRENCY;
 extern const std::string METRIC_RUNNER_FLUSHER_IN_RAW_SIZE_BYTES;
 extern const std::string METRIC_RUNNER_FLUSHER_OUT_RAW_SIZE_BYTES;
 extern const std::string METRIC_RUNNER_FLUSHER_WAITING_ITEMS_TOTAL;
+extern const std::string METRIC_RUNNER_FLUSHER_SPILLED_ITEMS_TOTAL;
 
 /**********************************************************
  *   file server
@@ -338,11 +353,13 @@ extern const std::string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIG
 extern const std::string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE;
+extern const std::string METRIC_RUNNER_FILE_CONFIG_UPDATE_PAUSE_TIME_MS;
 
 /**********************************************************
  *   static file server
  **********************************************************/
 extern const std::string METRIC_RUNNER_STATIC_FILE_SERVER_ACTIVE_INPUTS_COUNT;
+extern const std::string METRIC_RUNNER_STATIC_FILE_SERVER_BULK_RANGES_IN_PROCESS_COUNT;
 
 /**********************************************************
  *   ebpf server
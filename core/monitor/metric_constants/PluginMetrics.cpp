@@ -32,6 +32,7 @@ const string& METRIC_PLUGIN_OUT_EVENT_GROUPS_TOTAL = METRIC_OUT_EVENT_GROUPS_TOT
 const string& METRIC_PLUGIN_OUT_SIZE_BYTES = METRIC_OUT_SIZE_BYTES;
 const string& METRIC_PLUGIN_TOTAL_DELAY_MS = METRIC_TOTAL_DELAY_MS;
 const string& METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS = METRIC_TOTAL_PROCESS_TIME_MS;
+const string METRIC_PLUGIN_CPU_TIME_MS = "cpu_time_ms";
 
 /**********************************************************
  *   input_file
@@ -161,6 +162,10 @@ const string METRIC_PLUGIN_FLUSHER_SERVER_ERROR_TOTAL = "server_error_total";
 const string METRIC_PLUGIN_FLUSHER_UNAUTH_ERROR_TOTAL = "unauth_error_total";
 const string METRIC_PLUGIN_FLUSHER_PARAMS_ERROR_TOTAL = "params_error_total";
 const string METRIC_PLUGIN_FLUSHER_OTHER_ERROR_TOTAL = "other_error_total";
+const string METRIC_PLUGIN_FLUSHER_BATCHED_LATENCY_MS = "batched_latency_ms";
+const string METRIC_PLUGIN_FLUSHER_SERIALIZED_LATENCY_MS = "serialized_latency_ms";
+const string METRIC_PLUGIN_FLUSHER_SENT_LATENCY_MS = "sent_latency_ms";
+const string METRIC_PLUGIN_FLUSHER_ACKED_LATENCY_MS = "acked_latency_ms";
 
 /**********************************************************
  *   flusher_sls
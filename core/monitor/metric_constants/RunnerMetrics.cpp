@@ -62,6 +62,7 @@ const string METRIC_RUNNER_SINK_SEND_CONCURRENCY = "send_concurrency";
 const string METRIC_RUNNER_FLUSHER_IN_RAW_SIZE_BYTES = "in_raw_size_bytes";
 const string METRIC_RUNNER_FLUSHER_OUT_RAW_SIZE_BYTES = "out_raw_size_bytes";
 const string METRIC_RUNNER_FLUSHER_WAITING_ITEMS_TOTAL = "waiting_items_total";
+const string METRIC_RUNNER_FLUSHER_SPILLED_ITEMS_TOTAL = "spilled_items_total";
 
 /**********************************************************
  *   file server
@@ -72,11 +73,13 @@ const string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG = "en
 const string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE = "polling_modify_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE = "polling_dir_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE = "polling_file_cache_size";
+const string METRIC_RUNNER_FILE_CONFIG_UPDATE_PAUSE_TIME_MS = "config_update_pause_time_ms";
 
 /**********************************************************
  *   static file server
  **********************************************************/
 const string METRIC_RUNNER_STATIC_FILE_SERVER_ACTIVE_INPUTS_COUNT = "active_inputs_count";
+const string METRIC_RUNNER_STATIC_FILE_SERVER_BULK_RANGES_IN_PROCESS_COUNT = "bulk_ranges_in_process_count";
 
 /**********************************************************
  *   ebpf server
@@ -16,10 +16,36 @@
 
 #include "MetricRecord.h"
 
+#include <algorithm>
 #include <utility>
 
+#include "app_config/AppConfig.h"
+
 namespace logtail {
 
+static const uint32_t kMaxCounterShardCount = 32;
+
+// sharded counters are mainly added by processor threads, so one cell for each of them is enough
+static uint32_t GetCounterShardCount() {
+    uint32_t threadCount = static_cast<uint32_t>(std::max(AppConfig::GetInstance()->GetProcessThreadCount(), 1));
+    uint32_t shardCount = 1;
+    while (shardCount < threadCount && shardCount < kMaxCounterShardCount) {
+        shardCount <<= 1;
+    }
+    return shardCount;
+}
+
+template <typename T>
+static void CollectMetricsTo(const std::vector<std::shared_ptr<T>>& src, std::vector<std::shared_ptr<T>>& dst) {
+    dst.resize(src.size());
+    for (size_t i = 0; i < src.size(); ++i) {
+        if (!dst[i]) {
+            dst[i] = std::make_shared<T>(src[i]->GetName());
+        }
+        src[i]->CollectTo(*dst[i]);
+    }
+}
+
 const std::string MetricCategory::METRIC_CATEGORY_UNKNOWN = "unknown";
 const std::string MetricCategory::METRIC_CATEGORY_AGENT = "agent";
 const std::string MetricCategory::METRIC_CATEGORY_RUNNER = "runner";
@@ -36,20 +62,20 @@ MetricsRecord::MetricsRecord(const std::string& category, MetricLabelsPtr labels
       mDeleted(false) {
 }
 
-CounterPtr MetricsRecord::CreateCounter(const std::string& name) {
+CounterPtr MetricsRecord::CreateCounter(const std::string& name, bool sharded) {
     if (mCommitted) {
         return nullptr;
     }
-    CounterPtr counterPtr = std::make_shared<Counter>(name);
+    CounterPtr counterPtr = std::make_shared<Counter>(name, 0, sharded ? GetCounterShardCount() : 0);
     mCounters.emplace_back(counterPtr);
     return counterPtr;
 }
 
-TimeCounterPtr MetricsRecord::CreateTimeCounter(const std::string& name) {
+TimeCounterPtr MetricsRecord::CreateTimeCounter(const std::string& name, bool sharded) {
     if (mCommitted) {
         return nullptr;
     }
-    TimeCounterPtr counterPtr = std::make_shared<TimeCounter>(name);
+    TimeCounterPtr counterPtr = std::make_shared<TimeCounter>(name, 0, sharded ? GetCounterShardCount() : 0);
     mTimeCounters.emplace_back(counterPtr);
     return counterPtr;
 }
@@ -72,6 +98,15 @@ DoubleGaugePtr MetricsRecord::CreateDoubleGauge(const std::string& name) {
     return gaugePtr;
 }
 
+HistogramPtr MetricsRecord::CreateHistogram(const std::string& name) {
+    if (mCommitted) {
+        return nullptr;
+    }
+    HistogramPtr histogramPtr = std::make_shared<Histogram>(name);
+    mHistograms.emplace_back(histogramPtr);
+    return histogramPtr;
+}
+
 void MetricsRecord::AddLabels(MetricLabels&& labels) {
     if (mCommitted) {
         return;
@@ -123,27 +158,27 @@ const std::vector<DoubleGaugePtr>& MetricsRecord::GetDoubleGauges() const {
     return mDoubleGauges;
 }
 
+const std::vector<HistogramPtr>& MetricsRecord::GetHistograms() const {
+    return mHistograms;
+}
+
 MetricsRecord* MetricsRecord::Collect() {
     auto* metrics = new MetricsRecord(mCategory, mLabels, mDynamicLabels);
-    for (auto& item : mCounters) {
-        CounterPtr newPtr(item->Collect());
-        metrics->mCounters.emplace_back(newPtr);
-    }
-    for (auto& item : mTimeCounters) {
-        TimeCounterPtr newPtr(item->Collect());
-        metrics->mTimeCounters.emplace_back(newPtr);
-    }
-    for (auto& item : mIntGauges) {
-        IntGaugePtr newPtr(item->Collect());
-        metrics->mIntGauges.emplace_back(newPtr);
-    }
-    for (auto& item : mDoubleGauges) {
-        DoubleGaugePtr newPtr(item->Collect());
-        metrics->mDoubleGauges.emplace_back(newPtr);
-    }
+    CollectTo(*metrics);
     return metrics;
 }
 
+void MetricsRecord::CollectTo(MetricsRecord& record) {
+    record.mCategory = mCategory;
+    record.mLabels = mLabels;
+    record.mDynamicLabels = mDynamicLabels;
+    CollectMetricsTo(mCounters, record.mCounters);
+    CollectMetricsTo(mTimeCounters, record.mTimeCounters);
+    CollectMetricsTo(mIntGauges, record.mIntGauges);
+    CollectMetricsTo(mDoubleGauges, record.mDoubleGauges);
+    CollectMetricsTo(mHistograms, record.mHistograms);
+}
+
 MetricsRecord* MetricsRecord::GetNext() const {
     return mNext;
 }
@@ -180,12 +215,12 @@ const DynamicMetricLabelsPtr& MetricsRecordRef::GetDynamicLabels() const {
     return mMetrics->GetDynamicLabels();
 }
 
-CounterPtr MetricsRecordRef::CreateCounter(const std::string& name) {
-    return mMetrics->CreateCounter(name);
+CounterPtr MetricsRecordRef::CreateCounter(const std::string& name, bool sharded) {
+    return mMetrics->CreateCounter(name, sharded);
 }
 
-TimeCounterPtr MetricsRecordRef::CreateTimeCounter(const std::string& name) {
-    return mMetrics->CreateTimeCounter(name);
+TimeCounterPtr MetricsRecordRef::CreateTimeCounter(const std::string& name, bool sharded) {
+    return mMetrics->CreateTimeCounter(name, sharded);
 }
 
 IntGaugePtr MetricsRecordRef::CreateIntGauge(const std::string& name) {
@@ -196,6 +231,10 @@ DoubleGaugePtr MetricsRecordRef::CreateDoubleGauge(const std::string& name) {
     return mMetrics->CreateDoubleGauge(name);
 }
 
+HistogramPtr MetricsRecordRef::CreateHistogram(const std::string& name) {
+    return mMetrics->CreateHistogram(name);
+}
+
 void MetricsRecordRef::AddLabels(MetricLabels&& labels) {
     mMetrics->AddLabels(std::move(labels));
 }
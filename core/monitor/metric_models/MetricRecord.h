@@ -39,6 +39,7 @@ private:
     std::vector<TimeCounterPtr> mTimeCounters;
     std::vector<IntGaugePtr> mIntGauges;
     std::vector<DoubleGaugePtr> mDoubleGauges;
+    std::vector<HistogramPtr> mHistograms;
 
     std::atomic_bool mCommitted;
     std::atomic_bool mDeleted;
@@ -58,12 +59,17 @@ public:
     const std::vector<TimeCounterPtr>& GetTimeCounters() const;
     const std::vector<IntGaugePtr>& GetIntGauges() const;
     const std::vector<DoubleGaugePtr>& GetDoubleGauges() const;
-    CounterPtr CreateCounter(const std::string& name);
-    TimeCounterPtr CreateTimeCounter(const std::string& name);
+    const std::vector<HistogramPtr>& GetHistograms() const;
+    // @sharded: whether the counter is added by many threads concurrently, see Counter.
+    CounterPtr CreateCounter(const std::string& name, bool sharded = false);
+    TimeCounterPtr CreateTimeCounter(const std::string& name, bool sharded = false);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
+    HistogramPtr CreateHistogram(const std::string& name);
     void AddLabels(MetricLabels&& labels);
     MetricsRecord* Collect();
+    // the same as Collect, but into an existing record, whose metrics are reused if possible
+    void CollectTo(MetricsRecord& record);
     void SetNext(MetricsRecord* next);
     MetricsRecord* GetNext() const;
 };
@@ -87,10 +93,11 @@ public:
     const std::string& GetCategory() const;
     const MetricLabelsPtr& GetLabels() const;
     const DynamicMetricLabelsPtr& GetDynamicLabels() const;
-    CounterPtr CreateCounter(const std::string& name);
-    TimeCounterPtr CreateTimeCounter(const std::string& name);
+    CounterPtr CreateCounter(const std::string& name, bool sharded = false);
+    TimeCounterPtr CreateTimeCounter(const std::string& name, bool sharded = false);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
+    HistogramPtr CreateHistogram(const std::string& name);
     void AddLabels(MetricLabels&& labels);
     const MetricsRecord* operator->() const;
 #ifdef APSARA_UNIT_TEST_MAIN
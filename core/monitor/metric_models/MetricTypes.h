@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <functional>
@@ -25,6 +26,10 @@
 #include <string>
 #include <vector>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace logtail {
 
 enum class MetricType {
@@ -34,26 +39,76 @@ enum class MetricType {
     METRIC_TYPE_DOUBLE_GAUGE,
 };
 
+// CounterCell is padded to a cache line, so that threads adding to different cells of a sharded counter do not
+// contend for the same line.
+struct alignas(64) CounterCell {
+    std::atomic_uint64_t mVal{0};
+};
+
+// the cell of sharded counters that the current thread adds to
+inline uint32_t GetCounterShardIndex() {
+    static std::atomic_uint32_t sNextIndex{0};
+    thread_local uint32_t sIndex = sNextIndex.fetch_add(1, std::memory_order_relaxed);
+    return sIndex;
+}
+
 class Counter {
 protected:
     std::string mName;
     std::atomic_uint64_t mVal;
+    // cells of a sharded counter, each thread adds to one of them and they are merged when the counter is read
+    std::unique_ptr<CounterCell[]> mShards;
+    uint32_t mShardMask = 0;
+
+    void AddValue(uint64_t val) {
+        if (mShards) {
+            mShards[GetCounterShardIndex() & mShardMask].mVal.fetch_add(val, std::memory_order_relaxed);
+        } else {
+            mVal.fetch_add(val);
+        }
+    }
+    uint64_t LoadValue() const {
+        uint64_t val = mVal.load();
+        for (uint32_t i = 0; mShards && i <= mShardMask; ++i) {
+            val += mShards[i].mVal.load(std::memory_order_relaxed);
+        }
+        return val;
+    }
+    uint64_t ExchangeValue() {
+        uint64_t val = mVal.exchange(0);
+        for (uint32_t i = 0; mShards && i <= mShardMask; ++i) {
+            val += mShards[i].mVal.exchange(0, std::memory_order_relaxed);
+        }
+        return val;
+    }
 
 public:
-    Counter(const std::string& name, uint64_t val = 0) : mName(name), mVal(val) {}
-    uint64_t GetValue() const { return mVal.load(); }
+    // @shardCount: should be a power of 2. Counters added by many threads concurrently, e.g. by all processor threads,
+    // should be sharded. 0 or 1 means not sharded.
+    Counter(const std::string& name, uint64_t val = 0, uint32_t shardCount = 0) : mName(name), mVal(val) {
+        if (shardCount > 1) {
+            mShards = std::make_unique<CounterCell[]>(shardCount);
+            mShardMask = shardCount - 1;
+        }
+    }
+    uint64_t GetValue() const { return LoadValue(); }
     const std::string& GetName() const { return mName; }
-    void Add(uint64_t val) { mVal.fetch_add(val); }
-    Counter* Collect() { return new Counter(mName, mVal.exchange(0)); }
+    void Add(uint64_t val) { AddValue(val); }
+    Counter* Collect() { return new Counter(mName, ExchangeValue()); }
+    // the same as Collect, but into an existing counter to avoid allocation
+    void CollectTo(Counter& counter) {
+        counter.mName = mName;
+        counter.mVal.store(ExchangeValue());
+    }
 };
 
 // input: nanosecond, output: milisecond
 class TimeCounter : public Counter {
 public:
-    TimeCounter(const std::string& name, uint64_t val = 0) : Counter(name, val) {}
-    uint64_t GetValue() const { return mVal.load() / 1000000; }
-    void Add(std::chrono::nanoseconds val) { mVal.fetch_add(val.count()); }
-    TimeCounter* Collect() { return new TimeCounter(mName, mVal.exchange(0)); }
+    TimeCounter(const std::string& name, uint64_t val = 0, uint32_t shardCount = 0) : Counter(name, val, shardCount) {}
+    uint64_t GetValue() const { return LoadValue() / 1000000; }
+    void Add(std::chrono::nanoseconds val) { AddValue(val.count()); }
+    TimeCounter* Collect() { return new TimeCounter(mName, ExchangeValue()); }
 };
 
 template <typename T>
@@ -66,6 +121,10 @@ public:
     const std::string& GetName() const { return mName; }
     void Set(T val) { mVal.store(val); }
     Gauge* Collect() { return new Gauge<T>(mName, mVal.load()); }
+    void CollectTo(Gauge& gauge) const {
+        gauge.mName = mName;
+        gauge.mVal.store(mVal.load());
+    }
 
 protected:
     std::string mName;
@@ -82,10 +141,106 @@ public:
     void Sub(uint64_t val) { mVal.fetch_sub(val); }
 };
 
+// Histogram records durations into log-linear buckets, which is lock free and keeps the relative error of percentiles
+// within 1/kSubBucketCount. Values less than kSubBucketCount have their own buckets, and each power of 2 above is
+// split into kSubBucketCount linear buckets.
+// input: nanosecond, recorded in microsecond, output: milisecond
+class Histogram {
+public:
+    static constexpr uint32_t kSubBucketBits = 3;
+    static constexpr uint32_t kSubBucketCount = 1U << kSubBucketBits;
+    // values no less than 2^kMaxExponent us (about 12 days) are recorded in the last bucket
+    static constexpr uint32_t kMaxExponent = 40;
+    static constexpr uint32_t kBucketCount = (kMaxExponent - kSubBucketBits + 1) * kSubBucketCount;
+
+    Histogram(const std::string& name) : mName(name) {}
+
+    const std::string& GetName() const { return mName; }
+    void Add(std::chrono::nanoseconds val) {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(val).count();
+        mBuckets[GetBucketIndex(us > 0 ? static_cast<uint64_t>(us) : 0)].fetch_add(1, std::memory_order_relaxed);
+    }
+    uint64_t GetCount() const {
+        uint64_t count = 0;
+        for (const auto& bucket : mBuckets) {
+            count += bucket.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+    void GetBuckets(std::vector<uint64_t>& buckets) const {
+        buckets.resize(kBucketCount);
+        for (uint32_t i = 0; i < kBucketCount; ++i) {
+            buckets[i] = mBuckets[i].load(std::memory_order_relaxed);
+        }
+    }
+    double GetPercentile(double percentile) const {
+        std::vector<uint64_t> buckets;
+        GetBuckets(buckets);
+        return GetPercentile(buckets, percentile);
+    }
+    void CollectTo(Histogram& histogram) {
+        histogram.mName = mName;
+        for (uint32_t i = 0; i < kBucketCount; ++i) {
+            histogram.mBuckets[i].store(mBuckets[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    static uint32_t GetBucketIndex(uint64_t val) {
+        if (val < kSubBucketCount) {
+            return static_cast<uint32_t>(val);
+        }
+#if defined(_MSC_VER)
+        unsigned long exponent = 0;
+        _BitScanReverse64(&exponent, val);
+#else
+        uint32_t exponent = 63 - __builtin_clzll(val);
+#endif
+        if (exponent >= kMaxExponent) {
+            return kBucketCount - 1;
+        }
+        return (exponent - kSubBucketBits + 1) * kSubBucketCount
+            + static_cast<uint32_t>((val >> (exponent - kSubBucketBits)) & (kSubBucketCount - 1));
+    }
+    // the largest value in us recorded into the bucket
+    static uint64_t GetBucketUpperBound(uint32_t index) {
+        if (index < kSubBucketCount) {
+            return index;
+        }
+        uint32_t shift = index / kSubBucketCount - 1;
+        return ((static_cast<uint64_t>(kSubBucketCount + index % kSubBucketCount + 1)) << shift) - 1;
+    }
+    // @percentile: in [0, 100]. The upper bound of the bucket where the percentile falls is returned, 0 if empty.
+    static double GetPercentile(const std::vector<uint64_t>& buckets, double percentile) {
+        uint64_t count = 0;
+        for (auto bucket : buckets) {
+            count += bucket;
+        }
+        if (count == 0) {
+            return 0;
+        }
+        // rank of the percentile, starting from 1
+        auto rank = static_cast<uint64_t>(percentile / 100 * count + 0.5);
+        rank = rank == 0 ? 1 : (rank > count ? count : rank);
+        uint64_t cur = 0;
+        for (uint32_t i = 0; i < buckets.size(); ++i) {
+            cur += buckets[i];
+            if (cur >= rank) {
+                return GetBucketUpperBound(i) / 1000.0;
+            }
+        }
+        return GetBucketUpperBound(kBucketCount - 1) / 1000.0;
+    }
+
+private:
+    std::string mName;
+    std::array<std::atomic_uint64_t, kBucketCount> mBuckets{};
+};
+
 using CounterPtr = std::shared_ptr<Counter>;
 using TimeCounterPtr = std::shared_ptr<TimeCounter>;
 using IntGaugePtr = std::shared_ptr<IntGauge>;
 using DoubleGaugePtr = std::shared_ptr<Gauge<double>>;
+using HistogramPtr = std::shared_ptr<Histogram>;
 
 using MetricLabels = std::vector<std::pair<std::string, std::string>>;
 using MetricLabelsPtr = std::shared_ptr<MetricLabels>;
@@ -108,5 +263,9 @@ using DynamicMetricLabelsPtr = std::shared_ptr<DynamicMetricLabels>;
     if (gaugePtr) { \
         (gaugePtr)->Sub(value); \
     }
+#define ADD_HISTOGRAM(histogramPtr, value) \
+    if (histogramPtr) { \
+        (histogramPtr)->Add(value); \
+    }
 
 } // namespace logtail
@@ -16,6 +16,8 @@
 
 #include "SelfMonitorMetricEvent.h"
 
+#include <algorithm>
+
 #include "common/HashUtil.h"
 #include "common/JsonUtil.h"
 #include "common/TimeUtil.h"
@@ -29,6 +31,10 @@ const string METRIC_GO_KEY_LABELS = "labels";
 const string METRIC_GO_KEY_COUNTERS = "counters";
 const string METRIC_GO_KEY_GAUGES = "gauges";
 
+// histograms are exported as gauges named with these suffixes
+static const vector<pair<string, double>> kHistogramPercentiles
+    = {{"_p50", 50}, {"_p90", 90}, {"_p99", 99}, {"_max", 100}};
+
 SelfMonitorMetricEvent::SelfMonitorMetricEvent(MetricsRecord* metricRecord) : mCategory(metricRecord->GetCategory()) {
     // labels
     for (auto item = metricRecord->GetLabels()->begin(); item != metricRecord->GetLabels()->end(); ++item) {
@@ -55,6 +61,10 @@ SelfMonitorMetricEvent::SelfMonitorMetricEvent(MetricsRecord* metricRecord) : mC
     for (const auto& item : metricRecord->GetDoubleGauges()) {
         mGauges[item->GetName()] = item->GetValue();
     }
+    // histograms
+    for (const auto& item : metricRecord->GetHistograms()) {
+        item->GetBuckets(mHistograms[item->GetName()]);
+    }
     CreateKey();
 }
 
@@ -147,6 +157,13 @@ void SelfMonitorMetricEvent::Merge(const SelfMonitorMetricEvent& event) {
     for (auto gauge = event.mGauges.begin(); gauge != event.mGauges.end(); gauge++) {
         mGauges[gauge->first] = gauge->second;
     }
+    for (auto histogram = event.mHistograms.begin(); histogram != event.mHistograms.end(); histogram++) {
+        auto& buckets = mHistograms[histogram->first];
+        buckets.resize(histogram->second.size());
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            buckets[i] += histogram->second[i];
+        }
+    }
     mUpdatedFlag = true;
 }
 
@@ -179,6 +196,14 @@ void SelfMonitorMetricEvent::ReadAsMetricEvent(MetricEvent* metricEventPtr) {
         metricEventPtr->MutableValue<UntypedMultiDoubleValues>()->SetValue(
             gauge->first, {UntypedValueMetricType::MetricTypeGauge, gauge->second});
     }
+    for (auto histogram = mHistograms.begin(); histogram != mHistograms.end(); histogram++) {
+        for (const auto& percentile : kHistogramPercentiles) {
+            double value = Histogram::GetPercentile(histogram->second, percentile.second);
+            metricEventPtr->MutableValue<UntypedMultiDoubleValues>()->SetValue(
+                histogram->first + percentile.first, {UntypedValueMetricType::MetricTypeGauge, value});
+        }
+        fill(histogram->second.begin(), histogram->second.end(), 0);
+    }
     // set flags
     mIntervalsSinceLastSend = 0;
     mUpdatedFlag = false;
@@ -205,4 +230,12 @@ double SelfMonitorMetricEvent::GetGauge(const std::string& gaugeName) {
     return 0;
 }
 
+double SelfMonitorMetricEvent::GetHistogramPercentile(const std::string& histogramName, double percentile) {
+    auto it = mHistograms.find(histogramName);
+    if (it != mHistograms.end()) {
+        return Histogram::GetPercentile(it->second, percentile);
+    }
+    return 0;
+}
+
 } // namespace logtail
@@ -56,6 +56,7 @@ public:
     std::string GetLabel(const std::string& labelKey);
     uint64_t GetCounter(const std::string& counterName);
     double GetGauge(const std::string& gaugeName);
+    double GetHistogramPercentile(const std::string& histogramName, double percentile);
 
     SelfMonitorMetricEventKey mKey = 0L; // labels + category
     std::string mCategory; // category
@@ -65,6 +66,8 @@ private:
     std::unordered_map<std::string, std::string> mLabels;
     std::unordered_map<std::string, uint64_t> mCounters;
     std::unordered_map<std::string, double> mGauges;
+    // bucket counts of histograms, exported as percentile gauges
+    std::unordered_map<std::string, std::vector<uint64_t>> mHistograms;
     int32_t mSendInterval = 0;
     int32_t mIntervalsSinceLastSend = 0;
     bool mUpdatedFlag = false;
@@ -14,8 +14,28 @@
 
 #include "DelimiterModeFsmParser.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
 namespace logtail {
 
+static inline int CountTrailingZeros(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
 DelimiterModeFsmParser::DelimiterModeFsmParser(char quote, char separator) : quote(quote), separator(separator) {
 }
 
@@ -259,38 +279,111 @@ bool DelimiterModeFsmParser::ParseDelimiterLine(const char* buffer,
 
 bool DelimiterModeFsmParser::ParseDelimiterLine(
     StringView buffer, int begin, int end, std::vector<StringView>& columnValues, LogEvent& event) {
-    bool result = true;
-    DelimiterModeFsm fsm(STATE_INITIAL, "");
-
-    // when there is a double quote, we need to allocate a new buffer to store the unquoted field
-    int doubleQuoteNum = 0;
     // here we won't check whether element in buffer is '\0',
     // because we consider that all element in this buffer is valid,
     // despite some '\0' elements which are brought from file system due to system crash
     const char* ch = buffer.data();
     int fieldStart = begin;
-    int fieldEnd = begin;
-    for (int i = begin; i < end; ++i) {
-        if (ch[i] == separator) {
-            result = HandleSeparator(ch, quote, fieldStart, fieldEnd, fsm, columnValues, doubleQuoteNum, event);
-        } else if (ch[i] == quote) {
-            result = HandleQuote(fieldStart, fieldEnd, fsm, doubleQuoteNum);
-        } else // data
-        {
-            result = HandleData(fieldEnd, fsm);
+    // whether the current field has a quote in the previous blocks
+    bool hasQuote = false;
+    // all ones if the previous block ends inside quotes
+    uint64_t inQuoteCarry = 0;
+    for (int blockStart = begin; blockStart < end; blockStart += 64) {
+        int blockSize = std::min(64, end - blockStart);
+        const char* block = ch + blockStart;
+        uint64_t separatorMask = 0;
+        uint64_t quoteMask = 0;
+        int i = 0;
+#ifdef __SSE2__
+        if (blockSize == 64) {
+            const __m128i separators = _mm_set1_epi8(separator);
+            const __m128i quotes = _mm_set1_epi8(quote);
+            for (; i < 64; i += 16) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+                separatorMask |= static_cast<uint64_t>(
+                                     static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, separators))))
+                    << i;
+                quoteMask |= static_cast<uint64_t>(
+                                 static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quotes))))
+                    << i;
+            }
+        }
+#endif
+        for (; i < blockSize; ++i) {
+            separatorMask |= static_cast<uint64_t>(block[i] == separator) << i;
+            quoteMask |= static_cast<uint64_t>(block[i] == quote) << i;
         }
 
-        if (!result) {
-            columnValues.clear();
-            return false;
+        // a bit is set if the char is inside quotes, i.e. there are odd quotes before it (including itself)
+        uint64_t inQuoteMask = PrefixXor(quoteMask) ^ inQuoteCarry;
+        inQuoteCarry = static_cast<uint64_t>(static_cast<int64_t>(inQuoteMask) >> 63);
+        separatorMask &= ~inQuoteMask;
+        while (separatorMask != 0) {
+            int pos = CountTrailingZeros(separatorMask);
+            uint64_t before = (static_cast<uint64_t>(1) << pos) - 1;
+            if (!AddField(ch, fieldStart, blockStart + pos, hasQuote || (quoteMask & before), columnValues, event)) {
+                columnValues.clear();
+                return false;
+            }
+            hasQuote = false;
+            quoteMask &= ~before;
+            fieldStart = blockStart + pos + 1;
+            separatorMask &= separatorMask - 1;
         }
+        hasQuote = hasQuote || quoteMask != 0;
     }
-    result = HandleEOF(ch, quote, fieldStart, fieldEnd, fsm, columnValues, doubleQuoteNum, event);
-    // clear all columns if failed to parse
-    if (!result) {
+    if (!AddField(ch, fieldStart, end, hasQuote, columnValues, event)) {
         columnValues.clear();
+        return false;
     }
-    return result;
+    return true;
+}
+
+uint64_t DelimiterModeFsmParser::PrefixXor(uint64_t mask) {
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+}
+
+bool DelimiterModeFsmParser::AddField(const char* ch,
+                                      int fieldStart,
+                                      int fieldEnd,
+                                      bool hasQuote,
+                                      std::vector<StringView>& columnValues,
+                                      LogEvent& event) const {
+    if (!hasQuote) {
+        columnValues.emplace_back(ch + fieldStart, fieldEnd - fieldStart);
+        return true;
+    }
+    // a field with quotes must be quoted as a whole, and quotes inside must be doubled
+    if (ch[fieldStart] != quote) {
+        return false;
+    }
+    int doubleQuoteNum = 0;
+    int i = fieldStart + 1;
+    while (true) {
+        const char* next = static_cast<const char*>(memchr(ch + i, quote, fieldEnd - i));
+        if (next == nullptr) {
+            return false;
+        }
+        int quotePos = next - ch;
+        if (quotePos == fieldEnd - 1) {
+            break;
+        }
+        if (ch[quotePos + 1] != quote) {
+            return false;
+        }
+        ++doubleQuoteNum;
+        i = quotePos + 2;
+    }
+    int start = fieldStart + 1;
+    int stop = fieldEnd - 1;
+    AddFieldWithUnQuote(ch, quote, start, stop, columnValues, doubleQuoteNum, event);
+    return true;
 }
 
 } // namespace logtail
@@ -17,6 +17,8 @@
 #ifndef __LOG_LOGTAIL_DELIMITER_MODE_FSM_Parser_H__
 #define __LOG_LOGTAIL_DELIMITER_MODE_FSM_Parser_H__
 
+#include <cstdint>
+
 #include <string>
 #include <vector>
 
@@ -91,10 +93,22 @@ public:
 
 public:
     bool ParseDelimiterLine(const char* buffer, int begin, int end, std::vector<std::string>& columnValues);
+    // Gives the same result as the FSM above, but scans 64 bytes at a time: separators and quotes are first turned
+    // into bitmasks, separators inside quotes are masked out, and then fields are cut at the remaining separators.
+    // Only fields containing quotes need to be checked and unquoted char by char.
     bool
     ParseDelimiterLine(StringView buffer, int begin, int end, std::vector<StringView>& columnValues, LogEvent& event);
 
 private:
+    static uint64_t PrefixXor(uint64_t mask);
+
+    bool AddField(const char* ch,
+                  int fieldStart,
+                  int fieldEnd,
+                  bool hasQuote,
+                  std::vector<StringView>& columnValues,
+                  LogEvent& event) const;
+
     const char quote;
     const char separator;
 };
@@ -174,6 +174,18 @@ bool DiskBufferWriter::PushToDiskBuffer(SenderQueueItem* item, uint32_t retryTim
     return false;
 }
 
+bool DiskBufferWriter::TryPushToDiskBuffer(SenderQueueItem* item) {
+    // data of exactly once items is recovered from checkpoints rather than disk buffer
+    if (!item->mBufferOrNot || static_cast<SLSSenderQueueItem*>(item)->mExactlyOnceCheckpoint != nullptr) {
+        return false;
+    }
+    if (mQueue.Size() >= static_cast<size_t>(INT32_FLAG(secondary_buffer_count_limit))) {
+        return false;
+    }
+    mQueue.Push(item->Clone());
+    return true;
+}
+
 void DiskBufferWriter::BufferWriterThread() {
     LOG_INFO(sLogger, ("disk buffer writer", "started"));
     vector<SenderQueueItem*> res;
@@ -54,6 +54,8 @@ public:
     void Stop();
 
     bool PushToDiskBuffer(SenderQueueItem* item, uint32_t retryTimes);
+    // unlike PushToDiskBuffer, the item is left intact if it cannot be buffered
+    bool TryPushToDiskBuffer(SenderQueueItem* item);
 
 private:
     static const int32_t BUFFER_META_BASE_SIZE;
@@ -544,7 +544,8 @@ bool FlusherSLS::Init(const Json::Value& config, Json::Value& optionalGoPipeline
         static_cast<uint32_t>(INT32_FLAG(max_send_log_group_size) / DOUBLE_FLAG(sls_serialize_size_expansion_ratio)),
         static_cast<uint32_t>(INT32_FLAG(batch_send_metric_size)),
         static_cast<uint32_t>(INT32_FLAG(merge_log_count_limit)),
-        static_cast<uint32_t>(INT32_FLAG(batch_send_interval))};
+        static_cast<uint32_t>(INT32_FLAG(batch_send_interval)),
+        static_cast<uint32_t>(INT32_FLAG(max_send_log_group_size))};
     if (!mBatcher.Init(itr ? *itr : Json::Value(),
                        this,
                        strategy,
@@ -772,9 +773,11 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
                 ToString(chrono::duration_cast<chrono::milliseconds>(curSystemTime - item->mFirstEnqueTime).count())
                     + "ms")("try cnt", data->mTryCnt)("endpoint", data->mCurrentDomain)("real ip", data->mCurrentIP)(
                 "real ip flag", data->mUseIPFlag)("is profile data", isProfileData));
-        GetRegionConcurrencyLimiter(mRegion)->OnSuccess(curSystemTime);
-        GetProjectConcurrencyLimiter(mProject)->OnSuccess(curSystemTime);
-        GetLogstoreConcurrencyLimiter(mProject, mLogstore)->OnSuccess(curSystemTime);
+        GetRegionConcurrencyLimiter(mRegion)->OnSuccess(curSystemTime, response.GetResponseTime());
+        GetProjectConcurrencyLimiter(mProject)->OnSuccess(curSystemTime, response.GetResponseTime());
+        GetLogstoreConcurrencyLimiter(mProject, mLogstore)->OnSuccess(curSystemTime, response.GetResponseTime());
+        mBatcher.OnSendDone(chrono::duration_cast<chrono::milliseconds>(item->mLastSendTime - item->mFirstEnqueTime),
+                            response.GetResponseTime());
         SenderQueueManager::GetInstance()->DecreaseConcurrencyLimiterInSendingCnt(item->mQueueKey);
         ADD_COUNTER(mSuccessCnt, 1);
         DealSenderQueueItemAfterSend(item, false);
@@ -964,6 +967,12 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
 #endif
 }
 
+void FlusherSLS::CreateStageLatencyHistograms() {
+    HttpFlusher::CreateStageLatencyHistograms();
+    CreateStageLatencyHistogram(FlusherStage::BATCHED);
+    CreateStageLatencyHistogram(FlusherStage::SERIALIZED);
+}
+
 bool FlusherSLS::Send(string&& data, const string& shardHashKey, const string& logstore) {
     string compressedData;
     if (mCompressor) {
@@ -1030,6 +1039,7 @@ bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
     for (const auto& extraSourceBuffer : group.GetExtraSourceBuffers()) {
         g.mSourceBuffers.emplace_back(extraSourceBuffer);
     }
+    g.mCreateTime = group.GetCreateTime();
     AddPackId(g);
     string errorMsg;
     if (!mGroupSerializer->DoSerialize(std::move(g), serializedData, errorMsg)) {
@@ -1064,18 +1074,20 @@ bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
     } else {
         compressedData = serializedData;
     }
+    AddStageLatency(FlusherStage::SERIALIZED, g.mCreateTime);
     // must create a tmp, because eoo checkpoint is moved in second param
     auto fbKey = g.mExactlyOnceCheckpoint->fbKey;
-    return PushToQueue(fbKey,
-                       make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                       serializedData.size(),
-                                                       this,
-                                                       fbKey,
-                                                       mLogstore,
-                                                       RawDataType::EVENT_GROUP,
-                                                       g.mExactlyOnceCheckpoint->data.hash_key(),
-                                                       std::move(g.mExactlyOnceCheckpoint),
-                                                       false));
+    auto item = make_unique<SLSSenderQueueItem>(std::move(compressedData),
+                                                serializedData.size(),
+                                                this,
+                                                fbKey,
+                                                mLogstore,
+                                                RawDataType::EVENT_GROUP,
+                                                g.mExactlyOnceCheckpoint->data.hash_key(),
+                                                std::move(g.mExactlyOnceCheckpoint),
+                                                false);
+    item->mEventCreateTime = g.mCreateTime;
+    return PushToQueue(fbKey, std::move(item));
 }
 
 bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
@@ -1086,13 +1098,17 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
     string shardHashKey, serializedData, compressedData;
     size_t packageSize = 0;
     bool enablePackageList = groupList.size() > 1;
+    chrono::system_clock::time_point packageCreateTime;
 
     bool allSucceeded = true;
     for (auto& group : groupList) {
+        AddStageLatency(FlusherStage::BATCHED, group.mCreateTime);
+        auto createTime = group.mCreateTime;
         if (!mShardHashKeys.empty()) {
             shardHashKey = GetShardHashKey(group);
         }
         AddPackId(group);
+        auto groupSizeBytes = group.mSizeBytes;
         string errorMsg;
         if (!mGroupSerializer->DoSerialize(std::move(group), serializedData, errorMsg)) {
             LOG_WARNING(mContext->GetLogger(),
@@ -1128,44 +1144,49 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
         } else {
             compressedData = serializedData;
         }
+        AddStageLatency(FlusherStage::SERIALIZED, createTime);
+        mBatcher.OnSerialized(groupSizeBytes, serializedData.size());
         if (enablePackageList) {
             packageSize += serializedData.size();
             compressedLogGroups.emplace_back(std::move(compressedData), serializedData.size());
+            if (packageCreateTime == chrono::system_clock::time_point() || createTime < packageCreateTime) {
+                packageCreateTime = createTime;
+            }
         } else {
             if (group.mExactlyOnceCheckpoint) {
                 // must create a tmp, because eoo checkpoint is moved in second param
                 auto fbKey = group.mExactlyOnceCheckpoint->fbKey;
-                allSucceeded
-                    = PushToQueue(fbKey,
-                                  make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                  serializedData.size(),
-                                                                  this,
-                                                                  fbKey,
-                                                                  mLogstore,
-                                                                  RawDataType::EVENT_GROUP,
-                                                                  group.mExactlyOnceCheckpoint->data.hash_key(),
-                                                                  std::move(group.mExactlyOnceCheckpoint),
-                                                                  false))
-                    && allSucceeded;
+                auto item = make_unique<SLSSenderQueueItem>(std::move(compressedData),
+                                                            serializedData.size(),
+                                                            this,
+                                                            fbKey,
+                                                            mLogstore,
+                                                            RawDataType::EVENT_GROUP,
+                                                            group.mExactlyOnceCheckpoint->data.hash_key(),
+                                                            std::move(group.mExactlyOnceCheckpoint),
+                                                            false);
+                item->mEventCreateTime = createTime;
+                allSucceeded = PushToQueue(fbKey, std::move(item)) && allSucceeded;
             } else {
-                allSucceeded = Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                                    serializedData.size(),
-                                                                                    this,
-                                                                                    mQueueKey,
-                                                                                    mLogstore,
-                                                                                    RawDataType::EVENT_GROUP,
-                                                                                    shardHashKey))
-                    && allSucceeded;
+                auto item = make_unique<SLSSenderQueueItem>(std::move(compressedData),
+                                                            serializedData.size(),
+                                                            this,
+                                                            mQueueKey,
+                                                            mLogstore,
+                                                            RawDataType::EVENT_GROUP,
+                                                            shardHashKey);
+                item->mEventCreateTime = createTime;
+                allSucceeded = Flusher::PushToQueue(std::move(item)) && allSucceeded;
             }
         }
     }
     if (enablePackageList) {
         string errorMsg;
         mGroupListSerializer->DoSerialize(std::move(compressedLogGroups), serializedData, errorMsg);
-        allSucceeded
-            = Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(
-                  std::move(serializedData), packageSize, this, mQueueKey, mLogstore, RawDataType::EVENT_GROUP_LIST))
-            && allSucceeded;
+        auto item = make_unique<SLSSenderQueueItem>(
+            std::move(serializedData), packageSize, this, mQueueKey, mLogstore, RawDataType::EVENT_GROUP_LIST);
+        item->mEventCreateTime = packageCreateTime;
+        allSucceeded = Flusher::PushToQueue(std::move(item)) && allSucceeded;
     }
     return allSucceeded;
 }
@@ -74,6 +74,7 @@ public:
                       bool* keepItem,
                       std::string* errMsg) override;
     void OnSendDone(const HttpResponse& response, SenderQueueItem* item) override;
+    void CreateStageLatencyHistograms() override;
 
     CompressType GetCompressType() const { return mCompressor ? mCompressor->GetCompressType() : CompressType::NONE; }
 
@@ -126,6 +126,19 @@ bool InputStaticFile::Init(const Json::Value& config, Json::Value& optionalGoPip
         return false;
     }
 
+    // EnableBulkRead
+    if (!GetOptionalBoolParam(config, "EnableBulkRead", mEnableBulkRead, errorMsg)) {
+        PARAM_WARNING_DEFAULT(mContext->GetLogger(),
+                              mContext->GetAlarm(),
+                              errorMsg,
+                              mEnableBulkRead,
+                              sName,
+                              mContext->GetConfigName(),
+                              mContext->GetProjectName(),
+                              mContext->GetLogstoreName(),
+                              mContext->GetRegion());
+    }
+
     // Initialize metrics
     mMonitorFileTotal = GetMetricsRecordRef().CreateIntGauge(METRIC_PLUGIN_MONITOR_FILE_TOTAL);
     static const std::unordered_map<std::string, MetricType> inputStaticFileMetricKeys = {
@@ -155,8 +168,15 @@ bool InputStaticFile::Start() {
     if (!mContext->IsOnetimePipelineRunningBeforeStart()) {
         files = GetFiles();
     }
-    StaticFileServer::GetInstance()->AddInput(
-        mContext->GetConfigName(), mIndex, files, &mFileDiscovery, &mFileReader, &mMultiline, &mFileTag, mContext);
+    StaticFileServer::GetInstance()->AddInput(mContext->GetConfigName(),
+                                              mIndex,
+                                              files,
+                                              &mFileDiscovery,
+                                              &mFileReader,
+                                              &mMultiline,
+                                              &mFileTag,
+                                              mContext,
+                                              mEnableBulkRead);
     return true;
 }
 
@@ -49,6 +49,7 @@ public:
     FileReaderOptions mFileReader;
     MultilineOptions mMultiline;
     FileTagOptions mFileTag;
+    bool mEnableBulkRead = false;
 
 private:
     PluginMetricManagerPtr mPluginMetricManager;
@@ -69,6 +70,7 @@ private:
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class InputStaticFileUnittest;
+    friend class StaticFileServerUnittest;
 #endif
 };
 
@@ -156,6 +156,11 @@ void ProcessorDesensitizeNative::Process(PipelineEventGroup& logGroup) {
     }
 }
 
+bool ProcessorDesensitizeNative::ProcessEvent(PipelineEventPtr& e, [[maybe_unused]] EventProcessContext& context) {
+    ProcessEvent(e);
+    return true;
+}
+
 void ProcessorDesensitizeNative::ProcessEvent(PipelineEventPtr& e) {
     if (!IsSupportedEvent(e)) {
         ADD_COUNTER(mOutFailedEventsTotal, 1);
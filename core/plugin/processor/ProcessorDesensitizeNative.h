@@ -31,6 +31,8 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool SupportsEventProcessing() const override { return true; }
+    bool ProcessEvent(PipelineEventPtr& e, EventProcessContext& context) override;
 
     // Source field name.
     std::string mSourceKey;
@@ -175,6 +175,10 @@ void ProcessorFilterNative::Process(PipelineEventGroup& logGroup) {
     events.resize(wIdx);
 }
 
+bool ProcessorFilterNative::ProcessEvent(PipelineEventPtr& e, [[maybe_unused]] EventProcessContext& context) {
+    return ProcessEvent(e);
+}
+
 bool ProcessorFilterNative::ProcessEvent(PipelineEventPtr& e) {
     if (!IsSupportedEvent(e)) {
         return true;
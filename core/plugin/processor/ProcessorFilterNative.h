@@ -105,6 +105,8 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool SupportsEventProcessing() const override { return true; }
+    bool ProcessEvent(PipelineEventPtr& e, EventProcessContext& context) override;
 
     // Log field whitelist. The relationship between multiple conditions is "and". Only when all conditions are met, the
     // log will be collected.
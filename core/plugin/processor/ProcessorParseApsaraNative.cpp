@@ -105,6 +105,10 @@ void ProcessorParseApsaraNative::Process(PipelineEventGroup& logGroup) {
     return;
 }
 
+bool ProcessorParseApsaraNative::ProcessEvent(PipelineEventPtr& e, EventProcessContext& context) {
+    return ProcessEvent(context.mLogPath, e, context.mLogTime, context.mTimeStrCache, context.mGroup->GetAllMetadata());
+}
+
 /*
  * 处理单个日志事件。
  * @param logPath - 日志文件的路径。
@@ -203,6 +203,10 @@ void ProcessorParseDelimiterNative::Process(PipelineEventGroup& logGroup) {
     return;
 }
 
+bool ProcessorParseDelimiterNative::ProcessEvent(PipelineEventPtr& e, EventProcessContext& context) {
+    return ProcessEvent(context.mLogPath, e, context.mGroup->GetAllMetadata());
+}
+
 bool ProcessorParseDelimiterNative::ProcessEvent(const StringView& logPath,
                                                  PipelineEventPtr& e,
                                                  const GroupMetadata& metadata) {
@@ -377,7 +381,15 @@ bool ProcessorParseDelimiterNative::SplitString(
     size_t pos = begIdx;
     size_t top = endIdx - d_size;
     while (pos <= top) {
-        const char* pch = std::search(buffer + pos, buffer + endIdx, mSeparator.begin(), mSeparator.end());
+        const char* pch = nullptr;
+        if (d_size == 1) {
+            pch = static_cast<const char*>(memchr(buffer + pos, mSeparatorChar, endIdx - pos));
+            if (pch == nullptr) {
+                pch = buffer + endIdx;
+            }
+        } else {
+            pch = std::search(buffer + pos, buffer + endIdx, mSeparator.begin(), mSeparator.end());
+        }
         size_t pos2;
         // if not found, pos2 = endIdx
         if (pch == buffer + endIdx) {
@@ -34,6 +34,8 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool SupportsEventProcessing() const override { return true; }
+    bool ProcessEvent(PipelineEventPtr& e, EventProcessContext& context) override;
 
     // Required: source field name.
     std::string mSourceKey;
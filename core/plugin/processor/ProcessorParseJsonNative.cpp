@@ -104,6 +104,10 @@ void ProcessorParseJsonNative::Process(PipelineEventGroup& logGroup) {
     events.resize(wIdx);
 }
 
+bool ProcessorParseJsonNative::ProcessEvent(PipelineEventPtr& e, EventProcessContext& context) {
+    return ProcessEvent(context.mLogPath, e, context.mGroup->GetAllMetadata());
+}
+
 bool ProcessorParseJsonNative::ProcessEvent(const StringView& logPath,
                                             PipelineEventPtr& e,
                                             const GroupMetadata& metadata) {
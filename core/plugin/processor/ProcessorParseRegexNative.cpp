@@ -125,6 +125,10 @@ void ProcessorParseRegexNative::Process(PipelineEventGroup& logGroup) {
     return;
 }
 
+bool ProcessorParseRegexNative::ProcessEvent(PipelineEventPtr& e, EventProcessContext& context) {
+    return ProcessEvent(context.mLogPath, e, context.mGroup->GetAllMetadata());
+}
+
 bool ProcessorParseRegexNative::IsSupportedEvent(const PipelineEventPtr& e) const {
     return e.Is<LogEvent>();
 }
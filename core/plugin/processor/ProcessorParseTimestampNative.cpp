@@ -22,6 +22,7 @@
 #include "common/LogtailCommonFlags.h"
 #include "common/ParamExtractor.h"
 #include "monitor/metric_constants/MetricConstants.h"
+#include "runner/ProcessorRunner.h"
 
 namespace logtail {
 
@@ -88,6 +89,17 @@ bool ProcessorParseTimestampNative::Init(const Json::Value& config) {
                               mContext->GetRegion());
     }
 
+    // Second-level cache only work when:
+    // 1. No %f in the time format
+    // 2. The %f is at the end of the time format
+    const char* nanosecondPos = strstr(mSourceFormat.c_str(), "%f");
+    mHaveNanosecond = nanosecondPos != nullptr;
+    mEndWithNanosecond = nanosecondPos == (mSourceFormat.c_str() + mSourceFormat.size() - 2);
+
+    // common formats are parsed without Strptime, the cache is maintained per thread
+    mTimeFormatParser.Compile(mSourceFormat, mSourceYear);
+    mTimeFormatParserCaches.resize(AppConfig::GetInstance()->GetProcessThreadCount());
+
     mDiscardedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_DISCARDED_EVENTS_TOTAL);
     mOutFailedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_FAILED_EVENTS_TOTAL);
     mOutKeyNotFoundEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_KEY_NOT_FOUND_EVENTS_TOTAL);
@@ -119,6 +131,13 @@ void ProcessorParseTimestampNative::Process(PipelineEventGroup& logGroup) {
     return;
 }
 
+bool ProcessorParseTimestampNative::ProcessEvent(PipelineEventPtr& e, EventProcessContext& context) {
+    if (mSourceFormat.empty() || mSourceKey.empty()) {
+        return true;
+    }
+    return ProcessEvent(context.mLogPath, e, context.mLogTime, context.mTimeStrCache);
+}
+
 bool ProcessorParseTimestampNative::IsSupportedEvent(const PipelineEventPtr& e) const {
     return e.Is<LogEvent>();
 }
@@ -184,24 +203,25 @@ bool ProcessorParseTimestampNative::ParseLogTime(const StringView& curTimeStr, /
                                                  uint64_t& preciseTimestamp,
                                                  StringView& timeStrCache // cache
 ) {
-    // Second-level cache only work when:
-    // 1. No %f in the time format
-    // 2. The %f is at the end of the time format
-    const char* compareResult = strstr(mSourceFormat.c_str(), "%f");
-    bool haveNanosecond = compareResult != nullptr;
-    bool endWithNanosecond = compareResult == (mSourceFormat.c_str() + mSourceFormat.size() - 2);
     int nanosecondLength = -1;
     const char* strptimeResult = NULL;
-    if ((!haveNanosecond || endWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
+    if ((!mHaveNanosecond || mEndWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
         bool isTimestampNanosecond = (mSourceFormat == "%s") && (curTimeStr.length() > timeStrCache.length());
-        if (endWithNanosecond || isTimestampNanosecond) {
+        if (mEndWithNanosecond || isTimestampNanosecond) {
             strptimeResult = Strptime(curTimeStr.data() + timeStrCache.length(), "%f", &logTime, nanosecondLength);
         } else {
             strptimeResult = curTimeStr.data() + timeStrCache.length();
             logTime.tv_nsec = 0;
         }
     } else {
-        strptimeResult = Strptime(curTimeStr.data(), mSourceFormat.c_str(), &logTime, nanosecondLength, mSourceYear);
+        auto threadNo = ProcessorRunner::GetThreadNo();
+        if (mTimeFormatParser.IsCompiled() && threadNo < mTimeFormatParserCaches.size()
+            && mTimeFormatParser.Parse(curTimeStr, logTime, nanosecondLength, mTimeFormatParserCaches[threadNo])) {
+            strptimeResult = curTimeStr.data() + curTimeStr.size();
+        } else {
+            strptimeResult
+                = Strptime(curTimeStr.data(), mSourceFormat.c_str(), &logTime, nanosecondLength, mSourceYear);
+        }
         if (NULL != strptimeResult) {
             timeStrCache = curTimeStr.substr(0, curTimeStr.length() - nanosecondLength);
             logTime.tv_sec = logTime.tv_sec - mLogTimeZoneOffsetSecond;
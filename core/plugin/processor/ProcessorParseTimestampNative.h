@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "collection_pipeline/plugin/interface/Processor.h"
+#include "common/TimeFormatParser.h"
 #include "common/TimeUtil.h"
 
 namespace logtail {
@@ -27,6 +30,8 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool SupportsEventProcessing() const override { return true; }
+    bool ProcessEvent(PipelineEventPtr& e, EventProcessContext& context) override;
 
     // Source field name.
     std::string mSourceKey;
@@ -52,6 +57,10 @@ private:
     bool IsPrefixString(const StringView& all, const StringView& prefix);
 
     int32_t mLogTimeZoneOffsetSecond = 0;
+    bool mHaveNanosecond = false;
+    bool mEndWithNanosecond = false;
+    TimeFormatParser mTimeFormatParser;
+    std::vector<TimeFormatParser::Cache> mTimeFormatParserCaches;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
@@ -166,6 +166,10 @@ void ProcessorTimestampFilterNative::Process(PipelineEventGroup& logGroup) {
     events.resize(wIdx);
 }
 
+bool ProcessorTimestampFilterNative::ProcessEvent(PipelineEventPtr& e, [[maybe_unused]] EventProcessContext& context) {
+    return ProcessEvent(e);
+}
+
 bool ProcessorTimestampFilterNative::IsSupportedEvent(const PipelineEventPtr& e) const {
     return e.Is<LogEvent>();
 }
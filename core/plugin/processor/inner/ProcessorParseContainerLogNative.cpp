@@ -16,7 +16,7 @@
 
 #include "plugin/processor/inner/ProcessorParseContainerLogNative.h"
 
-#include <codecvt>
+#include <cstring>
 
 #include "common/JsonUtil.h"
 #include "common/ParamExtractor.h"
@@ -42,6 +42,9 @@ const std::string ProcessorParseContainerLogNative::containerTimeKey = "_time_";
 const std::string ProcessorParseContainerLogNative::containerSourceKey = "_source_"; // 容器来源字段
 const std::string ProcessorParseContainerLogNative::containerLogKey = "content"; // 容器日志字段
 
+// size of stdout and stderr
+static const int32_t kContainerdSourceSize = 6;
+
 bool ProcessorParseContainerLogNative::Init(const Json::Value& config) {
     std::string errorMsg;
 
@@ -177,11 +180,13 @@ bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sour
                                                                   std::string& errorMsg,
                                                                   PipelineEventGroup& logGroup) {
     StringView contentValue = sourceEvent.GetContent(mSourceKey);
+    const char* end = contentValue.data() + contentValue.size();
 
     // 寻找第一个分隔符位置 时间 _time_
     StringView timeValue;
-    const char* pch1 = std::find(contentValue.begin(), contentValue.end(), CONTAINERD_DELIMITER);
-    if (pch1 == contentValue.end()) {
+    const char* pch1
+        = static_cast<const char*>(memchr(contentValue.data(), CONTAINERD_DELIMITER, contentValue.size()));
+    if (pch1 == nullptr) {
         std::ostringstream errorMsgStream;
         errorMsgStream << "time field cannot be found in log line."
                        << "\tfirst 1KB log:" << contentValue.substr(0, 1024).to_string();
@@ -190,70 +195,59 @@ bool ProcessorParseContainerLogNative::ParseContainerdTextLogLine(LogEvent& sour
     }
     timeValue = StringView(contentValue.data(), pch1 - contentValue.data());
 
-    // 寻找第二个分隔符位置 容器标签 _source_
+    // 容器标签 _source_ 只能是 stdout 或 stderr，直接比较而不再寻找第二个分隔符
     StringView sourceValue;
-    const char* pch2 = std::find(pch1 + 1, contentValue.end(), CONTAINERD_DELIMITER);
-    if (pch2 == contentValue.end()) {
-        std::ostringstream errorMsgStream;
-        errorMsgStream << "source field cannot be found in log line."
-                       << "\tfirst 1KB log:" << contentValue.substr(0, 1024).to_string();
-        errorMsg = errorMsgStream.str();
-        return mKeepingSourceWhenParseFail;
+    const char* pch2 = nullptr;
+    if (end - pch1 > 1 + kContainerdSourceSize && pch1[1 + kContainerdSourceSize] == CONTAINERD_DELIMITER) {
+        pch2 = pch1 + 1 + kContainerdSourceSize;
+        sourceValue = StringView(pch1 + 1, kContainerdSourceSize);
     }
-    sourceValue = StringView(pch1 + 1, pch2 - pch1 - 1);
-
-    if (sourceValue != "stdout" && sourceValue != "stderr") {
-        std::ostringstream errorMsgStream;
-        errorMsgStream << "source field not valid"
-                       << "\tsource:" << sourceValue.to_string()
-                       << "\tfirst 1KB log:" << contentValue.substr(0, 1024).to_string();
-        errorMsg = errorMsgStream.str();
-        return mKeepingSourceWhenParseFail;
-    }
-
     if (sourceValue == "stdout") {
         ADD_COUNTER(mParseStdoutTotal, 1);
         if (mIgnoringStdout) {
             return false;
         }
-    } else {
+    } else if (sourceValue == "stderr") {
         ADD_COUNTER(mParseStderrTotal, 1);
         if (mIgnoringStderr) {
             return false;
         }
+    } else {
+        std::ostringstream errorMsgStream;
+        pch2 = std::find(pch1 + 1, end, CONTAINERD_DELIMITER);
+        if (pch2 == end) {
+            errorMsgStream << "source field cannot be found in log line.";
+        } else {
+            errorMsgStream << "source field not valid"
+                           << "\tsource:" << std::string(pch1 + 1, pch2 - pch1 - 1);
+        }
+        errorMsgStream << "\tfirst 1KB log:" << contentValue.substr(0, 1024).to_string();
+        errorMsg = errorMsgStream.str();
+        return mKeepingSourceWhenParseFail;
     }
 
-    // 如果既不以 CONTAINERD_PART_TAG 开头，也不以 CONTAINERD_FULL_TAG 开头
-    if (*(pch2 + 1) != CONTAINERD_PART_TAG && *(pch2 + 1) != CONTAINERD_FULL_TAG) {
-        // content
-        StringView content = StringView(pch2 + 1, contentValue.end() - pch2 - 1);
-        ResetContainerdTextLog(timeValue, sourceValue, content, false, sourceEvent);
-        return true;
-    }
-
-    // 寻找第三个分隔符位置
-    const char* pch3 = std::find(pch2 + 1, contentValue.end(), CONTAINERD_DELIMITER);
-    if (pch3 == contentValue.end() || pch3 != pch2 + 2) {
-        // case: 2021-08-25T07:00:00.000000000Z stdout P
-        // case: 2021-08-25T07:00:00.000000000Z stdout PP 1
-        StringView content = StringView(pch2 + 1, contentValue.end() - pch2 - 1);
+    // 标签 P/F 后必须紧跟分隔符，否则视为普通内容
+    // case: 2021-08-25T07:00:00.000000000Z stdout P
+    // case: 2021-08-25T07:00:00.000000000Z stdout PP 1
+    const char* tag = pch2 + 1;
+    if (tag + 1 >= end || (*tag != CONTAINERD_PART_TAG && *tag != CONTAINERD_FULL_TAG)
+        || *(tag + 1) != CONTAINERD_DELIMITER) {
+        StringView content = StringView(tag, end - tag);
         ResetContainerdTextLog(timeValue, sourceValue, content, false, sourceEvent);
         return true;
     }
-    if (*(pch2 + 1) == CONTAINERD_FULL_TAG) {
+    StringView content = StringView(tag + 2, end - tag - 2);
+    if (*tag == CONTAINERD_FULL_TAG) {
         // F
-        StringView content = StringView(pch3 + 1, contentValue.end() - pch3 - 1);
         ResetContainerdTextLog(timeValue, sourceValue, content, false, sourceEvent);
-        return true;
     } else {
         // P
-        StringView content = StringView(pch3 + 1, contentValue.end() - pch3 - 1);
         ResetContainerdTextLog(timeValue, sourceValue, content, true, sourceEvent);
         // There are some part logs, set HAS_PART_LOG
         // ProcessorMergeMultilineLogNative will merge the logs when it recognizes this flag.
         logGroup.SetMetadata(EventGroupMetaKey::HAS_PART_LOG, ProcessorMergeMultilineLogNative::PartLogFlag);
-        return true;
     }
+    return true;
 }
 
 static int32_t skipSpaces(char* buffer, int32_t idx, int32_t size) {
@@ -291,70 +285,138 @@ static int32_t parseLogType(char* buffer, int32_t idx, int32_t size, DockerLogTy
     return idx;
 }
 
-// windows can't instantiation with char32_t.
-#if defined(_MSC_VER)
-std::wstring_convert<std::codecvt_utf8<unsigned long>, unsigned long> convert;
-#else
-std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert;
-#endif
+static int32_t parseHex4(const char* buffer) {
+    int32_t res = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = buffer[i];
+        res <<= 4;
+        if (c >= '0' && c <= '9') {
+            res |= c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            res |= c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            res |= c - 'A' + 10;
+        } else {
+            return -1;
+        }
+    }
+    return res;
+}
+
+static void appendUtf8(char* buffer, int32_t& endIndex, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        buffer[endIndex++] = static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        buffer[endIndex++] = static_cast<char>(0xC0 | (codePoint >> 6));
+        buffer[endIndex++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        buffer[endIndex++] = static_cast<char>(0xE0 | (codePoint >> 12));
+        buffer[endIndex++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        buffer[endIndex++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        buffer[endIndex++] = static_cast<char>(0xF0 | (codePoint >> 18));
+        buffer[endIndex++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        buffer[endIndex++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        buffer[endIndex++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+// buffer[idx] is the 'u' of a unicode escape, a high surrogate must be followed by a low one. Return the index of the
+// last parsed char, or -1 if it is not a valid unicode escape.
+static int32_t parseUnicode(char* buffer, int32_t idx, int32_t size, int32_t& endIndex) {
+    if (idx + 4 >= size) {
+        return -1;
+    }
+    int32_t codePoint = parseHex4(buffer + idx + 1);
+    if (codePoint < 0) {
+        return -1;
+    }
+    if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+        // high surrogate must be followed by a low surrogate
+        if (idx + 10 >= size || buffer[idx + 5] != '\\' || buffer[idx + 6] != 'u') {
+            return -1;
+        }
+        int32_t low = parseHex4(buffer + idx + 7);
+        if (low < 0xDC00 || low > 0xDFFF) {
+            return -1;
+        }
+        appendUtf8(buffer, endIndex, 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00));
+        return idx + 10;
+    }
+    if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+        return -1;
+    }
+    appendUtf8(buffer, endIndex, codePoint);
+    return idx + 4;
+}
 
 static int32_t parseValue(char* buffer, int32_t idx, int32_t size, DockerLogType logType, int32_t& endIndex) {
-    while (idx < size && buffer[idx] != '\"') {
-        if (buffer[idx] == '\\') {
-            if (logType != DockerLogType::Log) {
-                return -1;
-            }
-            ++idx; // skip escape char
-            if (idx >= size) {
-                return -1;
-            }
-            switch (buffer[idx]) {
-                case '\"':
-                    buffer[endIndex++] = '\"';
-                    break;
-                case '\\':
+    int32_t quoteIdx = -1;
+    while (true) {
+        // chars between escapes are moved as a whole, and nothing needs to be moved before the first escape
+        if (quoteIdx < idx) {
+            const char* quote = static_cast<const char*>(memchr(buffer + idx, '\"', size - idx));
+            quoteIdx = quote == nullptr ? size : quote - buffer;
+        }
+        const char* escape = static_cast<const char*>(memchr(buffer + idx, '\\', quoteIdx - idx));
+        int32_t escapeIdx = escape == nullptr ? quoteIdx : escape - buffer;
+        if (endIndex != idx) {
+            memmove(buffer + endIndex, buffer + idx, escapeIdx - idx);
+        }
+        endIndex += escapeIdx - idx;
+        idx = escapeIdx;
+        if (escape == nullptr) {
+            return idx;
+        }
+
+        if (logType != DockerLogType::Log) {
+            return -1;
+        }
+        ++idx; // skip escape char
+        if (idx >= size) {
+            return -1;
+        }
+        switch (buffer[idx]) {
+            case '\"':
+                buffer[endIndex++] = '\"';
+                break;
+            case '\\':
+                buffer[endIndex++] = '\\';
+                break;
+            case '/':
+                buffer[endIndex++] = '/';
+                break;
+            case 'b':
+                buffer[endIndex++] = '\b';
+                break;
+            case 'f':
+                buffer[endIndex++] = '\f';
+                break;
+            case 'n':
+                buffer[endIndex++] = '\n';
+                break;
+            case 'r':
+                buffer[endIndex++] = '\r';
+                break;
+            case 't':
+                buffer[endIndex++] = '\t';
+                break;
+            default: {
+                int32_t unicodeEnd = -1;
+                if (buffer[idx] == 'u') {
+                    unicodeEnd = parseUnicode(buffer, idx, size, endIndex);
+                }
+                if (unicodeEnd != -1) {
+                    idx = unicodeEnd;
+                } else {
                     buffer[endIndex++] = '\\';
-                    break;
-                case '/':
-                    buffer[endIndex++] = '/';
-                    break;
-                case 'b':
-                    buffer[endIndex++] = '\b';
-                    break;
-                case 'f':
-                    buffer[endIndex++] = '\f';
-                    break;
-                case 'n':
-                    buffer[endIndex++] = '\n';
-                    break;
-                case 'r':
-                    buffer[endIndex++] = '\r';
-                    break;
-                case 't':
-                    buffer[endIndex++] = '\t';
-                    break;
-                default:
-                    if (idx + 4 < size && buffer[idx] == 'u') {
-                        std::string unicode_seq;
-                        unicode_seq.append(buffer + idx + 1, 4);
-                        unsigned long unicode_char = std::stoul(unicode_seq, nullptr, 16);
-                        std::string res = convert.to_bytes(unicode_char);
-                        for (size_t i = 0; i < res.size(); ++i) {
-                            buffer[endIndex++] = res[i];
-                        }
-                        idx += 4;
-                    } else {
-                        buffer[endIndex++] = '\\';
-                        buffer[endIndex++] = buffer[idx];
-                    }
-                    break;
+                    buffer[endIndex++] = buffer[idx];
+                }
+                break;
             }
-        } else {
-            buffer[endIndex++] = buffer[idx];
         }
         ++idx;
     }
-    return idx;
 }
 
 // buffer: {"log":"Hello, World!","stream":"stdout","time":"2021-12-01T00:00:00.000Z"}
@@ -510,10 +572,10 @@ bool ProcessorParseContainerLogNative::ParseDockerJsonLogLine(LogEvent& sourceEv
     }
 
     // time
-    sourceEvent.SetContent(containerTimeKey, timeValue);
+    sourceEvent.SetContentNoCopy(containerTimeKey, timeValue);
 
     // source
-    sourceEvent.SetContent(containerSourceKey, sourceValue);
+    sourceEvent.SetContentNoCopy(containerSourceKey, sourceValue);
 
     // content
     if (!content.empty() && content.back() == '\n') {
@@ -95,11 +95,13 @@ void ProcessorParseFromPBNative::Process(std::vector<PipelineEventGroup>& eventG
 
             std::string errMsg;
             auto eventGroup = PipelineEventGroup(std::make_shared<SourceBuffer>());
+            // strings in the event group reference the content of the raw event instead of copying it
+            eventGroup.GetSourceBuffer()->AddExternalBuffer(rawEventGroup.GetSourceBuffer());
 
             // parse event group from raw event
             const auto& content = sourceEvent.GetContent();
 
-            ManualPBParser parser(reinterpret_cast<const uint8_t*>(content.data()), content.size(), false);
+            ManualPBParser parser(reinterpret_cast<const uint8_t*>(content.data()), content.size(), false, true);
             if (!parser.ParsePipelineEventGroup(eventGroup, errMsg)) {
                 LOG_WARNING(
                     sLogger,
@@ -78,6 +78,9 @@ bool ProcessorSplitMultilineLogStringNative::Init(const Json::Value& config) {
             mEndPatternReg.emplace_back(mMultiline.mEndPattern);
         }
     }
+    mStartPatternMatcher.Compile(mMultiline.mStartPattern);
+    mContinuePatternMatcher.Compile(mMultiline.mContinuePattern);
+    mEndPatternMatcher.Compile(mMultiline.mEndPattern);
 
     mMatchedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_MATCHED_EVENTS_TOTAL);
     mMatchedLinesTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_MATCHED_LINES_TOTAL);
@@ -175,17 +178,13 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         ++(*inputLines);
         if (!isPartialLog) {
             // it is impossible to enter this state if only end pattern is given
-            boost::regex regex;
-            if (HasStartPattern()) {
-                regex = GetStartPatternReg();
-            } else {
-                regex = GetContinuePatternReg();
-            }
-            if (BoostRegexSearch(content.data(), content.size(), regex, exception)) {
+            bool isMatched = HasStartPattern() ? IsStartPatternMatched(content, exception)
+                                               : IsContinuePatternMatched(content, exception);
+            if (isMatched) {
                 multiStartIndex = content.data();
                 isPartialLog = true;
             } else if (HasEndPattern() && !HasStartPattern() && HasContinuePattern()
-                       && BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                       && IsEndPatternMatched(content, exception)) {
                 // case: continue + end
                 CreateNewEvent(content, isLastLog, sourceKey, sourceEvent, logGroup, newEvents);
                 multiStartIndex = content.data() + content.size() + 1;
@@ -197,7 +196,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         } else {
             // case: start + continue or continue + end
             if (HasContinuePattern()
-                && BoostRegexSearch(content.data(), content.size(), GetContinuePatternReg(), exception)) {
+                && IsContinuePatternMatched(content, exception)) {
                 begin += content.size() + 1;
                 continue;
             }
@@ -206,7 +205,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                 if (HasContinuePattern()) {
                     // current line is not matched against the continue pattern, so the end pattern will decide
                     // if the current log is a match or not
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (IsEndPatternMatched(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -228,7 +227,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                     isPartialLog = false;
                 } else {
                     // case: start + end or end
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (IsEndPatternMatched(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -249,7 +248,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
             } else {
                 if (!HasContinuePattern()) {
                     // case: start
-                    if (BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (IsStartPatternMatched(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() - 1 - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -269,7 +268,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                                    logGroup,
                                    newEvents);
                     ADD_COUNTER(mMatchedEventsTotal, 1);
-                    if (!BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (!IsStartPatternMatched(content, exception)) {
                         // when no end pattern is given, the only chance to enter unmatched state is when both
                         // start and continue pattern are given, and the current line is not matched against the
                         // start pattern
@@ -392,6 +391,20 @@ StringView ProcessorSplitMultilineLogStringNative::GetNextLine(StringView log, s
     return StringView(log.data() + begin, log.size() - begin);
 }
 
+bool ProcessorSplitMultilineLogStringNative::IsPatternMatched(const FastRegexMatcher& matcher,
+                                                              const boost::regex& reg,
+                                                              StringView content,
+                                                              std::string& exception) {
+    switch (matcher.Match(content.data(), content.size())) {
+        case FastRegexMatcher::Result::MATCH:
+            return true;
+        case FastRegexMatcher::Result::NOT_MATCH:
+            return false;
+        default:
+            return BoostRegexSearch(content.data(), content.size(), reg, exception);
+    }
+}
+
 const boost::regex& ProcessorSplitMultilineLogStringNative::GetStartPatternReg() const {
     return mStartPatternReg[ProcessorRunner::GetThreadNo()];
 }
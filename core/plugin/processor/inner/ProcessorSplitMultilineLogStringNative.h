@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "collection_pipeline/plugin/interface/Processor.h"
+#include "common/FastRegexMatcher.h"
 #include "constants/Constants.h"
 #include "file_server/MultilineOptions.h"
 #include "plugin/processor/CommonParserOptions.h"
@@ -71,12 +72,29 @@ private:
     const boost::regex& GetStartPatternReg() const;
     const boost::regex& GetContinuePatternReg() const;
     const boost::regex& GetEndPatternReg() const;
+    bool IsStartPatternMatched(StringView content, std::string& exception) const {
+        return IsPatternMatched(mStartPatternMatcher, GetStartPatternReg(), content, exception);
+    }
+    bool IsContinuePatternMatched(StringView content, std::string& exception) const {
+        return IsPatternMatched(mContinuePatternMatcher, GetContinuePatternReg(), content, exception);
+    }
+    bool IsEndPatternMatched(StringView content, std::string& exception) const {
+        return IsPatternMatched(mEndPatternMatcher, GetEndPatternReg(), content, exception);
+    }
+    static bool IsPatternMatched(const FastRegexMatcher& matcher,
+                                 const boost::regex& reg,
+                                 StringView content,
+                                 std::string& exception);
 
     // boost::regex object shared by multi-thread leads to performance degradation. Therefore, each thread should be
     // allocated a different copy.
     std::vector<boost::regex> mStartPatternReg;
     std::vector<boost::regex> mContinuePatternReg;
     std::vector<boost::regex> mEndPatternReg;
+    // most patterns, e.g. ^\d{4}-\d{2}-\d{2}.*, can be judged without boost, which is much faster
+    FastRegexMatcher mStartPatternMatcher;
+    FastRegexMatcher mContinuePatternMatcher;
+    FastRegexMatcher mEndPatternMatcher;
 
     CounterPtr mMatchedEventsTotal;
     CounterPtr mMatchedLinesTotal;
@@ -89,13 +89,14 @@ enum SpanLinkField {
     kSpanLinkTagsField = 4
 };
 
-ManualPBParser::ManualPBParser(const uint8_t* data, size_t size, bool replaceSpanTags)
-    : mData(data), mPos(data), mEnd(data + size), mSize(size), mReplaceSpanTags(replaceSpanTags) {
+ManualPBParser::ManualPBParser(const uint8_t* data, size_t size, bool replaceSpanTags, bool noCopy)
+    : mData(data), mPos(data), mEnd(data + size), mSize(size), mReplaceSpanTags(replaceSpanTags), mNoCopy(noCopy) {
 }
 
 bool ManualPBParser::ParsePipelineEventGroup(PipelineEventGroup& eventGroup, std::string& errMsg) {
     mLastError.clear();
     mPos = mData;
+    mSourceBuffer = eventGroup.GetSourceBuffer().get();
 
     if (!mData || mSize == 0) {
         errMsg = "Empty or null input data";
@@ -272,6 +273,25 @@ bool ManualPBParser::readString(std::string& str) {
     return true;
 }
 
+bool ManualPBParser::readString(StringView& str) {
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+    if (!readLengthDelimited(data, length)) {
+        return false;
+    }
+
+    str = StringView(reinterpret_cast<const char*>(data), length);
+    return true;
+}
+
+StringView ManualPBParser::keepString(StringView str) {
+    if (mNoCopy) {
+        return str;
+    }
+    const StringBuffer& b = mSourceBuffer->CopyString(str);
+    return StringView(b.data, b.size);
+}
+
 bool ManualPBParser::readBytes(const uint8_t*& data, size_t& length) {
     return readLengthDelimited(data, length);
 }
@@ -314,8 +334,8 @@ bool ManualPBParser::parseMetadata(PipelineEventGroup& eventGroup) {
     mPos = mapData;
     mEnd = mapData + mapLength;
 
-    std::string key;
-    std::string value;
+    StringView key;
+    StringView value;
     bool hasKey = false;
     bool hasValue = false;
 
@@ -371,7 +391,7 @@ bool ManualPBParser::parseMetadata(PipelineEventGroup& eventGroup) {
 
     // Set metadata if both key and value are present
     if (hasKey && hasValue) {
-        eventGroup.SetTag(key, value);
+        eventGroup.SetTagNoCopy(keepString(key), keepString(value));
     }
 
     return true;
@@ -389,8 +409,8 @@ bool ManualPBParser::parseTags(PipelineEventGroup& eventGroup) {
     mPos = mapData;
     mEnd = mapData + mapLength;
 
-    std::string key;
-    std::string value;
+    StringView key;
+    StringView value;
     bool hasKey = false;
     bool hasValue = false;
 
@@ -446,7 +466,7 @@ bool ManualPBParser::parseTags(PipelineEventGroup& eventGroup) {
 
     // Set tag if both key and value are present
     if (hasKey && hasValue) {
-        eventGroup.SetTag(key, value);
+        eventGroup.SetTagNoCopy(keepString(key), keepString(value));
     }
 
     return true;
@@ -627,7 +647,7 @@ bool ManualPBParser::parseLogEvent(PipelineEventGroup& eventGroup) {
     uint64_t timestamp = 0;
     uint64_t fileOffset = 0;
     uint64_t rawSize = 0;
-    std::string level;
+    StringView level;
 
     while (hasMoreData()) {
         uint32_t tag = 0;
@@ -717,7 +737,7 @@ bool ManualPBParser::parseLogEvent(PipelineEventGroup& eventGroup) {
     logEvent->SetTimestamp(timestamp);
     logEvent->SetPosition(fileOffset, rawSize);
     if (!level.empty()) {
-        logEvent->SetLevel(level);
+        logEvent->SetLevelNoCopy(keepString(level));
     }
 
     return true;
@@ -743,7 +763,7 @@ bool ManualPBParser::parseMetricEvent(PipelineEventGroup& eventGroup) {
     mEnd = eventData + eventLength;
 
     uint64_t timestamp = 0;
-    std::string name;
+    StringView name;
 
     while (hasMoreData()) {
         uint32_t tag = 0;
@@ -862,7 +882,7 @@ bool ManualPBParser::parseMetricEvent(PipelineEventGroup& eventGroup) {
     // Set parsed values
     metricEvent->SetTimestamp(timestamp);
     if (!name.empty()) {
-        metricEvent->SetName(name);
+        metricEvent->SetNameNoCopy(keepString(name));
     }
 
     return true;
@@ -890,11 +910,11 @@ bool ManualPBParser::parseSpanEvent(PipelineEventGroup& eventGroup) {
     uint64_t timestamp = 0;
     uint64_t startTime = 0;
     uint64_t endTime = 0;
-    std::string traceId;
-    std::string spanId;
-    std::string traceState;
-    std::string parentSpanId;
-    std::string name;
+    StringView traceId;
+    StringView spanId;
+    StringView traceState;
+    StringView parentSpanId;
+    StringView name;
     uint32_t kind = 0;
 
     while (hasMoreData()) {
@@ -1112,19 +1132,19 @@ bool ManualPBParser::parseSpanEvent(PipelineEventGroup& eventGroup) {
     spanEvent->SetEndTimeNs(endTime);
 
     if (!traceId.empty()) {
-        spanEvent->SetTraceId(traceId);
+        spanEvent->SetTraceIdNoCopy(keepString(traceId));
     }
     if (!spanId.empty()) {
-        spanEvent->SetSpanId(spanId);
+        spanEvent->SetSpanIdNoCopy(keepString(spanId));
     }
     if (!traceState.empty()) {
-        spanEvent->SetTraceState(traceState);
+        spanEvent->SetTraceStateNoCopy(keepString(traceState));
     }
     if (!parentSpanId.empty()) {
-        spanEvent->SetParentSpanId(parentSpanId);
+        spanEvent->SetParentSpanIdNoCopy(keepString(parentSpanId));
     }
     if (!name.empty()) {
-        spanEvent->SetName(name);
+        spanEvent->SetNameNoCopy(keepString(name));
     }
 
     // Set kind (convert from protobuf enum to SpanEvent::Kind)
@@ -1167,8 +1187,8 @@ bool ManualPBParser::parseLogContent(PipelineEventGroup& /* eventGroup */, LogEv
     mPos = contentData;
     mEnd = contentData + contentLength;
 
-    std::string key;
-    std::string value;
+    StringView key;
+    StringView value;
     bool hasKey = false;
     bool hasValue = false;
 
@@ -1224,7 +1244,7 @@ bool ManualPBParser::parseLogContent(PipelineEventGroup& /* eventGroup */, LogEv
 
     // Set content if both key and value are present
     if (hasKey && hasValue) {
-        logEvent->SetContent(key, value);
+        logEvent->SetContentNoCopy(keepString(key), keepString(value));
     }
 
     return true;
@@ -1242,8 +1262,8 @@ bool ManualPBParser::parseMetricTags(PipelineEventGroup& /* eventGroup */, Metri
     mPos = mapData;
     mEnd = mapData + mapLength;
 
-    std::string key;
-    std::string value;
+    StringView key;
+    StringView value;
     bool hasKey = false;
     bool hasValue = false;
 
@@ -1299,7 +1319,7 @@ bool ManualPBParser::parseMetricTags(PipelineEventGroup& /* eventGroup */, Metri
 
     // Set tag if both key and value are present
     if (hasKey && hasValue) {
-        metricEvent->SetTag(key, value);
+        metricEvent->SetTagNoCopy(keepString(key), keepString(value));
     }
 
     return true;
@@ -1317,8 +1337,8 @@ bool ManualPBParser::parseSpanTags(PipelineEventGroup& /* eventGroup */, SpanEve
     mPos = mapData;
     mEnd = mapData + mapLength;
 
-    std::string key;
-    std::string value;
+    StringView key;
+    StringView value;
     bool hasKey = false;
     bool hasValue = false;
 
@@ -1374,7 +1394,7 @@ bool ManualPBParser::parseSpanTags(PipelineEventGroup& /* eventGroup */, SpanEve
 
     // Set tag if both key and value are present
     if (hasKey && hasValue) {
-        spanEvent->AppendTag(key, value);
+        spanEvent->AppendTagNoCopy(keepString(key), keepString(value));
     }
 
     return true;
@@ -1392,8 +1412,8 @@ bool ManualPBParser::parseSpanScopeTags(PipelineEventGroup& /* eventGroup */, Sp
     mPos = mapData;
     mEnd = mapData + mapLength;
 
-    std::string key;
-    std::string value;
+    StringView key;
+    StringView value;
     bool hasKey = false;
     bool hasValue = false;
 
@@ -1449,7 +1469,7 @@ bool ManualPBParser::parseSpanScopeTags(PipelineEventGroup& /* eventGroup */, Sp
 
     // Set scope tag if both key and value are present
     if (hasKey && hasValue) {
-        spanEvent->SetScopeTag(key, value);
+        spanEvent->SetScopeTagNoCopy(keepString(key), keepString(value));
     }
 
     return true;
@@ -1475,7 +1495,7 @@ bool ManualPBParser::parseSpanInnerEvent(PipelineEventGroup& eventGroup, SpanEve
     mEnd = eventData + eventLength;
 
     uint64_t timestamp = 0;
-    std::string name;
+    StringView name;
 
     while (hasMoreData()) {
         uint32_t tag = 0;
@@ -1540,7 +1560,7 @@ bool ManualPBParser::parseSpanInnerEvent(PipelineEventGroup& eventGroup, SpanEve
     // Set parsed values
     innerEvent->SetTimestampNs(timestamp);
     if (!name.empty()) {
-        innerEvent->SetName(name);
+        innerEvent->SetNameNoCopy(keepString(name));
     }
 
     return true;
@@ -1565,9 +1585,9 @@ bool ManualPBParser::parseSpanLink(PipelineEventGroup& eventGroup, SpanEvent* sp
     mPos = linkData;
     mEnd = linkData + linkLength;
 
-    std::string traceId;
-    std::string spanId;
-    std::string traceState;
+    StringView traceId;
+    StringView spanId;
+    StringView traceState;
 
     while (hasMoreData()) {
         uint32_t tag = 0;
@@ -1643,13 +1663,13 @@ bool ManualPBParser::parseSpanLink(PipelineEventGroup& eventGroup, SpanEvent* sp
 
     // Set parsed values
     if (!traceId.empty()) {
-        spanLink->SetTraceId(traceId);
+        spanLink->SetTraceIdNoCopy(keepString(traceId));
     }
     if (!spanId.empty()) {
-        spanLink->SetSpanId(spanId);
+        spanLink->SetSpanIdNoCopy(keepString(spanId));
     }
     if (!traceState.empty()) {
-        spanLink->SetTraceState(traceState);
+        spanLink->SetTraceStateNoCopy(keepString(traceState));
     }
 
     return true;
@@ -1669,8 +1689,8 @@ bool ManualPBParser::parseSpanInnerEventTags(PipelineEventGroup& /* eventGroup *
     mPos = mapData;
     mEnd = mapData + mapLength;
 
-    std::string key;
-    std::string value;
+    StringView key;
+    StringView value;
     bool hasKey = false;
     bool hasValue = false;
 
@@ -1726,7 +1746,7 @@ bool ManualPBParser::parseSpanInnerEventTags(PipelineEventGroup& /* eventGroup *
 
     // Set tag if both key and value are present
     if (hasKey && hasValue) {
-        innerEvent->AppendTag(key, value);
+        innerEvent->AppendTagNoCopy(keepString(key), keepString(value));
     }
 
     return true;
@@ -1746,8 +1766,8 @@ bool ManualPBParser::parseSpanLinkTags(PipelineEventGroup& /* eventGroup */,
     mPos = mapData;
     mEnd = mapData + mapLength;
 
-    std::string key;
-    std::string value;
+    StringView key;
+    StringView value;
     bool hasKey = false;
     bool hasValue = false;
 
@@ -1803,7 +1823,7 @@ bool ManualPBParser::parseSpanLinkTags(PipelineEventGroup& /* eventGroup */,
 
     // Set tag if both key and value are present
     if (hasKey && hasValue) {
-        spanLink->AppendTag(key, value);
+        spanLink->AppendTagNoCopy(keepString(key), keepString(value));
     }
 
     return true;
@@ -39,8 +39,10 @@ public:
      * @brief Construct parser with binary data
      * @param data Pointer to protobuf binary data
      * @param size Size of the binary data
+     * @param noCopy Whether the data is kept alive by the source buffer of the event group to parse into,
+     *        so that strings in the event group can reference the data instead of being copied
      */
-    ManualPBParser(const uint8_t* data, size_t size, bool replaceSpanTags = true);
+    ManualPBParser(const uint8_t* data, size_t size, bool replaceSpanTags = true, bool noCopy = false);
 
     /**
      * @brief Parse PipelineEventGroup from binary data
@@ -58,6 +60,7 @@ private:
     bool readFixed64(uint64_t& value);
     bool readLengthDelimited(const uint8_t*& data, size_t& length);
     bool readString(std::string& str);
+    bool readString(StringView& str);
     bool readBytes(const uint8_t*& data, size_t& length);
 
     // Skip unknown fields
@@ -92,6 +95,8 @@ private:
     inline bool hasMoreData() const { return mPos < mEnd; }
     inline bool checkBounds(size_t bytes) const { return (mEnd - mPos) >= static_cast<ptrdiff_t>(bytes); }
     void setError(const std::string& msg);
+    // returns @str itself in no copy mode, otherwise a copy of it in the source buffer of the event group
+    StringView keepString(StringView str);
 
     // State management for nested parsing
     struct ParseState {
@@ -109,6 +114,8 @@ private:
     size_t mSize;
     std::string mLastError;
     bool mReplaceSpanTags = true;
+    bool mNoCopy = false;
+    SourceBuffer* mSourceBuffer = nullptr;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ManualPBParserUnittest;
@@ -25,8 +25,10 @@
 #include "common/LogtailCommonFlags.h"
 #include "common/StringTools.h"
 #include "common/http/HttpRequest.h"
+#include "common/memory/MemoryGovernor.h"
 #include "logger/Logger.h"
 #include "monitor/AlarmManager.h"
+#include "monitor/CpuProfiler.h"
 #include "plugin/flusher/sls/DiskBufferWriter.h"
 #include "runner/sink/http/HttpSink.h"
 
@@ -56,6 +58,7 @@ bool FlusherRunner::Init() {
     mTotalDelayMs = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_TOTAL_DELAY_MS);
     mLastRunTime = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
     mWaitingItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_FLUSHER_WAITING_ITEMS_TOTAL);
+    mSpilledItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_FLUSHER_SPILLED_ITEMS_TOTAL);
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 
     mThreadRes = async(launch::async, &FlusherRunner::Run, this);
@@ -156,6 +159,9 @@ bool FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
     }
 
     req->mEnqueTime = item->mLastSendTime = chrono::system_clock::now();
+    if (item->mTryCnt == 1) {
+        item->mFlusher->AddStageLatency(FlusherStage::SENT, item->mEventCreateTime);
+    }
     LOG_TRACE(sLogger,
               ("send item to http sink, item address", item)("config-flusher-dst",
                                                              QueueKeyManager::GetInstance()->GetName(item->mQueueKey))(
@@ -167,6 +173,7 @@ bool FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
 
 void FlusherRunner::Run() {
     LOG_INFO(sLogger, ("flusher runner", "started"));
+    CpuProfiler::GetInstance()->RegisterThread("flusher_runner");
     while (true) {
         auto curTime = chrono::system_clock::now();
         SET_GAUGE(mLastRunTime, chrono::duration_cast<chrono::seconds>(curTime.time_since_epoch()).count());
@@ -197,7 +204,12 @@ void FlusherRunner::Run() {
                     ToString(chrono::duration_cast<chrono::milliseconds>(curTime - (*itr)->mFirstEnqueTime).count())
                         + "ms")("try cnt", ToString((*itr)->mTryCnt)));
 
-            if (Dispatch(*itr)) {
+            bool dispatched = false;
+            {
+                CpuProfileScope scope((*itr)->mFlusher->GetCpuProfileTag());
+                dispatched = Dispatch(*itr);
+            }
+            if (dispatched) {
                 // TODO: use rate limiter instead
                 if (!Application::GetInstance()->IsExiting() && mEnableRateLimiter) {
                     RateLimiter::FlowControl(rawSize, mSendLastTime, mSendLastByte, true);
@@ -214,6 +226,7 @@ void FlusherRunner::Run() {
             break;
         }
     }
+    CpuProfiler::GetInstance()->UnregisterThread();
 }
 
 bool FlusherRunner::Dispatch(SenderQueueItem* item) {
@@ -225,9 +238,17 @@ bool FlusherRunner::Dispatch(SenderQueueItem* item) {
                 DiskBufferWriter::GetInstance()->PushToDiskBuffer(item, 3);
                 SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
                 return true;
-            } else {
-                return PushToHttpSink(item);
             }
+            // spill data to disk buffer to release memory under critical memory pressure, the data will be sent by
+            // disk buffer sender later
+            if (MemoryGovernor::GetInstance()->ShouldSpill() && item->mFlusher->Name() == "flusher_sls"
+                && DiskBufferWriter::GetInstance()->TryPushToDiskBuffer(item)) {
+                ADD_COUNTER(mSpilledItemsTotal, 1);
+                SenderQueueManager::GetInstance()->DecreaseConcurrencyLimiterInSendingCnt(item->mQueueKey);
+                SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
+                return true;
+            }
+            return PushToHttpSink(item);
         default:
             SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
             return false;
@@ -80,6 +80,7 @@ private:
     CounterPtr mOutItemRawDataSizeBytes;
     TimeCounterPtr mTotalDelayMs;
     IntGaugePtr mWaitingItemsTotal;
+    CounterPtr mSpilledItemsTotal;
     IntGaugePtr mLastRunTime;
 
 #ifdef APSARA_UNIT_TEST_MAIN
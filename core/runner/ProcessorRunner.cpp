@@ -21,12 +21,15 @@
 #include "go_pipeline/LogtailPlugin.h"
 #include "models/EventPool.h"
 #include "monitor/AlarmManager.h"
+#include "monitor/CpuProfiler.h"
 #include "monitor/metric_constants/MetricConstants.h"
 #include "queue/ProcessQueueManager.h"
 #include "queue/QueueKeyManager.h"
 
-DEFINE_FLAG_INT32(default_flush_merged_buffer_interval, "default flush merged buffer, seconds", 1);
 DEFINE_FLAG_INT32(processor_runner_exit_timeout_sec, "", 60);
+DEFINE_FLAG_INT32(process_queue_pending_push_timeout_ms,
+                  "default max time for an event group to wait for a full process queue before discarded, ms",
+                  10000);
 
 DECLARE_FLAG_INT32(max_send_log_group_size);
 
@@ -50,9 +53,13 @@ void ProcessorRunner::Init() {
         mThreadRes[threadNo] = async(launch::async, &ProcessorRunner::Run, this, threadNo);
     }
     mIsFlush = false;
+    TimeoutFlushManager::GetInstance()->Start();
+    PendingPushManager::GetInstance()->Start();
 }
 
 void ProcessorRunner::Stop() {
+    // parked items are pushed before processor runner threads drain the queues
+    PendingPushManager::GetInstance()->Stop();
     mIsFlush = true;
     ProcessQueueManager::GetInstance()->Trigger();
     for (uint32_t threadNo = 0; threadNo < mThreadCount; ++threadNo) {
@@ -66,12 +73,14 @@ void ProcessorRunner::Stop() {
             LOG_WARNING(sLogger, ("processor runner", "forced to stopped")("threadNo", threadNo));
         }
     }
+    TimeoutFlushManager::GetInstance()->Stop();
 }
 
 bool ProcessorRunner::PushQueue(QueueKey key, size_t inputIndex, PipelineEventGroup&& group, uint32_t retryTimes) {
     unique_ptr<ProcessQueueItem> item = make_unique<ProcessQueueItem>(std::move(group), inputIndex);
     for (size_t i = 0; i < retryTimes; ++i) {
-        if (ProcessQueueManager::GetInstance()->PushQueue(key, std::move(item)) == QueueStatus::OK) {
+        if (!PendingPushManager::GetInstance()->HasPendingItems(key)
+            && ProcessQueueManager::GetInstance()->PushQueue(key, std::move(item)) == QueueStatus::OK) {
             return true;
         }
         if (i % 100 == 0) {
@@ -86,6 +95,42 @@ bool ProcessorRunner::PushQueue(QueueKey key, size_t inputIndex, PipelineEventGr
     return false;
 }
 
+PushStatus ProcessorRunner::TryPushQueue(QueueKey key,
+                                         size_t inputIndex,
+                                         PipelineEventGroup&& group,
+                                         PushCallback&& callback,
+                                         uint32_t timeoutMs,
+                                         uint64_t* token) {
+    unique_ptr<ProcessQueueItem> item = make_unique<ProcessQueueItem>(std::move(group), inputIndex);
+    if (!PendingPushManager::GetInstance()->HasPendingItems(key)) {
+        auto res = ProcessQueueManager::GetInstance()->PushQueue(key, std::move(item));
+        if (res == QueueStatus::OK) {
+            return PushStatus::PUSHED;
+        }
+        if (res == QueueStatus::QUEUE_NOT_EXIST) {
+            group = std::move(item->mEventGroup);
+            return PushStatus::REJECTED;
+        }
+    }
+    if (timeoutMs == 0) {
+        timeoutMs = INT32_FLAG(process_queue_pending_push_timeout_ms);
+    }
+    uint64_t res = PendingPushManager::GetInstance()->Park(
+        key, item, chrono::steady_clock::now() + chrono::milliseconds(timeoutMs), std::move(callback));
+    if (res == 0) {
+        LOG_WARNING(sLogger,
+                    ("process queue is full and too many event groups are waiting",
+                     "reject")("config", QueueKeyManager::GetInstance()->GetName(key))("input index",
+                                                                                       ToString(inputIndex)));
+        group = std::move(item->mEventGroup);
+        return PushStatus::REJECTED;
+    }
+    if (token != nullptr) {
+        *token = res;
+    }
+    return PushStatus::PENDING;
+}
+
 void ProcessorRunner::Run(uint32_t threadNo) {
     LOG_INFO(sLogger, ("processor runner", "started")("thread no", threadNo));
 
@@ -101,14 +146,12 @@ void ProcessorRunner::Run(uint32_t threadNo) {
     sInGroupDataSizeBytes = sMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_SIZE_BYTES);
     sLastRunTime = sMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(sMetricsRecordRef);
+    CpuProfiler::GetInstance()->RegisterThread("processor_runner_" + ToString(threadNo));
 
-    static int32_t lastFlushBatchTime = 0;
     while (true) {
         int32_t curTime = time(nullptr);
-        if (threadNo == 0 && curTime - lastFlushBatchTime >= INT32_FLAG(default_flush_merged_buffer_interval)) {
-            TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
-            lastFlushBatchTime = curTime;
-        }
+        // any thread can do the flush, either woken up by the timeout flush scheduler or passing by
+        TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
 
         SET_GAUGE(sLastRunTime, curTime);
         unique_ptr<ProcessQueueItem> item;
@@ -134,6 +177,8 @@ void ProcessorRunner::Run(uint32_t threadNo) {
             continue;
         }
 
+        // the cpu not used by any processor or flusher, e.g. by the serialization for go pipelines, is the pipeline's
+        CpuProfileScope scope(pipeline->GetCpuProfileTag());
         bool isLog = !item->mEventGroup.GetEvents().empty() && item->mEventGroup.GetEvents()[0].Is<LogEvent>();
 
         vector<PipelineEventGroup> eventGroupList;
@@ -180,6 +225,7 @@ void ProcessorRunner::Run(uint32_t threadNo) {
 
         gThreadedEventPool.CheckGC();
     }
+    CpuProfiler::GetInstance()->UnregisterThread();
 }
 
 bool ProcessorRunner::Serialize(
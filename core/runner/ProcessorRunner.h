@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 
+#include "collection_pipeline/queue/PendingPushManager.h"
 #include "collection_pipeline/queue/QueueKey.h"
 #include "models/PipelineEventGroup.h"
 #include "monitor/MetricManager.h"
@@ -44,6 +45,16 @@ public:
     void Stop();
 
     bool PushQueue(QueueKey key, size_t inputIndex, PipelineEventGroup&& group, uint32_t retryTimes = 1);
+    // Pushes the group without blocking. If the queue is full, the group is parked until the queue is valid to push
+    // again or timeoutMs (0 for the default) expires, and the callback is then invoked from another thread. If the
+    // group is rejected, it is left intact.
+    // @token: set to the token of the parked group, which can be used to cancel it via PendingPushManager.
+    PushStatus TryPushQueue(QueueKey key,
+                            size_t inputIndex,
+                            PipelineEventGroup&& group,
+                            PushCallback&& callback = nullptr,
+                            uint32_t timeoutMs = 0,
+                            uint64_t* token = nullptr);
 
 private:
     ProcessorRunner();
@@ -24,6 +24,7 @@
 #include "common/StringTools.h"
 #include "common/http/Curl.h"
 #include "logger/Logger.h"
+#include "monitor/CpuProfiler.h"
 #include "monitor/metric_constants/MetricConstants.h"
 #include "runner/FlusherRunner.h"
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -31,6 +32,11 @@
 #endif
 
 DEFINE_FLAG_INT32(http_sink_exit_timeout_sec, "", 5);
+DEFINE_FLAG_INT32(http_sink_max_idle_curl_handlers_per_host, "", 32);
+DEFINE_FLAG_INT32(http_sink_http2_mode,
+                  "0: libcurl default, 1: http/2 negotiated by alpn for https endpoints, 2: http/2 for all endpoints, "
+                  "with prior knowledge for http ones. Requests to the same endpoint are multiplexed over one connection",
+                  0);
 
 using namespace std;
 
@@ -71,6 +77,12 @@ bool HttpSink::Init() {
     // TODO: should be dynamic
     SET_GAUGE(mSendConcurrency, AppConfig::GetInstance()->GetSendRequestGlobalConcurrency());
 
+    mHttp2Mode = GetHttp2Mode(INT32_FLAG(http_sink_http2_mode), curl_version_info(CURLVERSION_NOW)->features);
+    if (mHttp2Mode != 0) {
+        curl_multi_setopt(mClient, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        LOG_INFO(sLogger, ("http sink http2 mode", mHttp2Mode));
+    }
+
     mThreadRes = async(launch::async, &HttpSink::Run, this);
     return true;
 }
@@ -90,6 +102,7 @@ void HttpSink::Stop() {
 
 void HttpSink::Run() {
     LOG_INFO(sLogger, ("http sink", "started"));
+    CpuProfiler::GetInstance()->RegisterThread("http_sink");
     while (true) {
         SET_GAUGE(mLastRunTime,
                   chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count());
@@ -114,10 +127,12 @@ void HttpSink::Run() {
         }
         DoRun();
     }
+    ClearIdleCurlHandlers();
     auto mc = curl_multi_cleanup(mClient);
     if (mc != CURLM_OK) {
         LOG_ERROR(sLogger, ("failed to cleanup curl multi handle", "exit anyway")("errMsg", curl_multi_strerror(mc)));
     }
+    CpuProfiler::GetInstance()->UnregisterThread();
 }
 
 bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
@@ -136,7 +151,8 @@ bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
                                    AppConfig::GetInstance()->GetBindInterface(),
                                    false,
                                    std::nullopt,
-                                   std::move(request->mSocket));
+                                   request->mSocket,
+                                   GetIdleCurlHandler(GetCurlHandlerKey(*request)));
     if (curl == nullptr) {
         request->mItem->mStatus = SendingStatus::IDLE;
         request->mResponse.SetNetworkStatus(NetworkCode::Other, "failed to init curl handler");
@@ -150,6 +166,16 @@ bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
         return false;
     }
 
+    if (mHttp2Mode != 0) {
+        if (request->mHTTPSFlag) {
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        } else if (mHttp2Mode == 2) {
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
+        }
+        // wait for the connection being established to multiplex on it rather than opening a new one
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+    }
+
     request->mPrivateData = headers;
     curl_easy_setopt(curl, CURLOPT_PRIVATE, request.get());
     request->mLastSendTime = chrono::system_clock::now();
@@ -257,6 +283,7 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
             CURL* handler = msg->easy_handle;
             HttpSinkRequest* request = nullptr;
             curl_easy_getinfo(handler, CURLINFO_PRIVATE, &request);
+            string handlerKey = GetCurlHandlerKey(*request);
             auto pipelinePlaceHolder = request->mItem->mPipeline; // keep pipeline alive
             auto responseTime = chrono::system_clock::now() - request->mLastSendTime;
             auto responseTimeMs = chrono::duration_cast<chrono::milliseconds>(responseTime);
@@ -274,7 +301,15 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                                   "response time", ToString(responseTimeMs.count()) + "ms")("try cnt",
                                                                                             ToString(request->mTryCnt))(
                                   "sending cnt", ToString(FlusherRunner::GetInstance()->GetSendingBufferCount())));
-                    static_cast<HttpFlusher*>(request->mItem->mFlusher)->OnSendDone(request->mResponse, request->mItem);
+                    if (statusCode == 200) {
+                        request->mItem->mFlusher->AddStageLatency(FlusherStage::ACKED,
+                                                                  request->mItem->mEventCreateTime);
+                    }
+                    {
+                        CpuProfileScope scope(request->mItem->mFlusher->GetCpuProfileTag());
+                        static_cast<HttpFlusher*>(request->mItem->mFlusher)
+                            ->OnSendDone(request->mResponse, request->mItem);
+                    }
                     FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
                     ADD_COUNTER(mOutSuccessfulItemsTotal, 1);
                     ADD_COUNTER(mSuccessfulItemTotalResponseTimeMs, responseTime);
@@ -309,8 +344,11 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                                       "response time", ToString(responseTimeMs.count()) + "ms")(
                                       "try cnt", ToString(request->mTryCnt))("errMsg", errMsg)(
                                       "sending cnt", ToString(FlusherRunner::GetInstance()->GetSendingBufferCount())));
-                        static_cast<HttpFlusher*>(request->mItem->mFlusher)
-                            ->OnSendDone(request->mResponse, request->mItem);
+                        {
+                            CpuProfileScope scope(request->mItem->mFlusher->GetCpuProfileTag());
+                            static_cast<HttpFlusher*>(request->mItem->mFlusher)
+                                ->OnSendDone(request->mResponse, request->mItem);
+                        }
                         FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
                     }
                     ADD_COUNTER(mOutFailedItemsTotal, 1);
@@ -319,7 +357,7 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                     break;
             }
             curl_multi_remove_handle(mClient, handler);
-            curl_easy_cleanup(handler);
+            ReleaseCurlHandler(handlerKey, handler);
             if (!requestReused) {
                 if (request->mPrivateData) {
                     curl_slist_free_all((curl_slist*)request->mPrivateData);
@@ -331,4 +369,44 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
     }
 }
 
+CURL* HttpSink::GetIdleCurlHandler(const string& key) {
+    auto it = mIdleCurlHandlers.find(key);
+    if (it == mIdleCurlHandlers.end() || it->second.empty()) {
+        return nullptr;
+    }
+    CURL* handler = it->second.back();
+    it->second.pop_back();
+    return handler;
+}
+
+void HttpSink::ReleaseCurlHandler(const string& key, CURL* handler) {
+    auto& handlers = mIdleCurlHandlers[key];
+    if (handlers.size() >= static_cast<size_t>(INT32_FLAG(http_sink_max_idle_curl_handlers_per_host))) {
+        curl_easy_cleanup(handler);
+        return;
+    }
+    handlers.push_back(handler);
+}
+
+void HttpSink::ClearIdleCurlHandlers() {
+    for (auto& item : mIdleCurlHandlers) {
+        for (auto* handler : item.second) {
+            curl_easy_cleanup(handler);
+        }
+    }
+    mIdleCurlHandlers.clear();
+}
+
+int32_t HttpSink::GetHttp2Mode(int32_t mode, int curlFeatures) {
+    if (mode != 0 && !(curlFeatures & CURL_VERSION_HTTP2)) {
+        LOG_WARNING(sLogger, ("http2 is not supported by libcurl", "use default http version")("http2 mode", mode));
+        return 0;
+    }
+    return mode;
+}
+
+string HttpSink::GetCurlHandlerKey(const HttpSinkRequest& request) {
+    return (request.mHTTPSFlag ? "https://" : "http://") + request.mHost + ":" + ToString(request.mPort);
+}
+
 } // namespace logtail
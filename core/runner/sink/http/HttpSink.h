@@ -20,6 +20,9 @@
 #include <condition_variable>
 #include <future>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "curl/multi.h"
 
@@ -47,8 +50,18 @@ private:
     bool AddRequestToClient(std::unique_ptr<HttpSinkRequest>&& request);
     void DoRun();
     void HandleCompletedRequests(int& runningHandlers);
+    CURL* GetIdleCurlHandler(const std::string& key);
+    void ReleaseCurlHandler(const std::string& key, CURL* handler);
+    void ClearIdleCurlHandlers();
+
+    static std::string GetCurlHandlerKey(const HttpSinkRequest& request);
+    // falls back to the default http version if http2 is not supported by libcurl
+    static int32_t GetHttp2Mode(int32_t mode, int curlFeatures);
 
     CURLM* mClient = nullptr;
+    // idle easy handlers of each endpoint, only accessed by the sink thread
+    std::unordered_map<std::string, std::vector<CURL*>> mIdleCurlHandlers;
+    int32_t mHttp2Mode = 0;
 
     std::future<void> mThreadRes;
     std::atomic_bool mIsFlush = false;
@@ -66,6 +79,7 @@ private:
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class FlusherRunnerUnittest;
     friend class HttpSinkMock;
+    friend class HttpSinkUnittest;
 #endif
 };
 
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <thread>
+
 #include "collection_pipeline/batch/Batcher.h"
 #include "common/JsonUtil.h"
 #include "unittest/Unittest.h"
@@ -35,6 +37,7 @@ public:
     void TestFlushAllWithoutGroupBatch();
     void TestFlushAllWithGroupBatch();
     void TestMetric();
+    void TestAdaptiveFlush();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherMock>(); }
@@ -82,7 +85,8 @@ void BatcherUnittest::TestParamInit() {
             {
                 "MinSizeBytes": "1000",
                 "MinCnt": "10",
-                "TimeoutSecs": "5"
+                "TimeoutSecs": "5",
+                "TimeoutMs": "500"
             }
         )";
         APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
@@ -92,8 +96,25 @@ void BatcherUnittest::TestParamInit() {
         APSARA_TEST_EQUAL(1U, batch.mEventFlushStrategy.GetMinCnt());
         APSARA_TEST_EQUAL(100U, batch.mEventFlushStrategy.GetMinSizeBytes());
         APSARA_TEST_EQUAL(3U, batch.mEventFlushStrategy.GetTimeoutSecs());
+        APSARA_TEST_EQUAL(3000U, batch.mEventFlushStrategy.GetTimeoutMs());
         APSARA_TEST_EQUAL(300U, batch.mEventFlushStrategy.GetMaxSizeBytes());
     }
+    {
+        // sub-second timeout
+        Json::Value configJson;
+        string configStr, errorMsg;
+        configStr = R"(
+            {
+                "TimeoutSecs": 5,
+                "TimeoutMs": 200
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+
+        Batcher<> batch;
+        batch.Init(configJson, sFlusher.get(), strategy);
+        APSARA_TEST_EQUAL(200U, batch.mEventFlushStrategy.GetTimeoutMs());
+    }
 }
 
 void BatcherUnittest::TestInitWithoutGroupBatch() {
@@ -133,11 +154,11 @@ void BatcherUnittest::TestInitWithGroupBatch() {
     batch.Init(configJson, sFlusher.get(), DefaultFlushStrategyOptions(), true);
     APSARA_TEST_EQUAL(10U, batch.mEventFlushStrategy.GetMinCnt());
     APSARA_TEST_EQUAL(1000U, batch.mEventFlushStrategy.GetMinSizeBytes());
-    APSARA_TEST_EQUAL(3U, batch.mEventFlushStrategy.GetTimeoutSecs());
+    APSARA_TEST_EQUAL(2500U, batch.mEventFlushStrategy.GetTimeoutMs());
     APSARA_TEST_EQUAL(numeric_limits<uint32_t>::max(), batch.mEventFlushStrategy.GetMaxSizeBytes());
     APSARA_TEST_TRUE(batch.mGroupFlushStrategy);
     APSARA_TEST_EQUAL(1000U, batch.mGroupFlushStrategy->GetMinSizeBytes());
-    APSARA_TEST_EQUAL(2U, batch.mGroupFlushStrategy->GetTimeoutSecs());
+    APSARA_TEST_EQUAL(2500U, batch.mGroupFlushStrategy->GetTimeoutMs());
     APSARA_TEST_TRUE(batch.mGroupQueue);
     APSARA_TEST_EQUAL(sFlusher.get(), batch.mFlusher);
 }
@@ -164,8 +185,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     TimeoutRecord& record = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key));
-    time_t updateTime = record.mUpdateTime;
-    APSARA_TEST_EQUAL(3U, record.mTimeoutSecs);
+    int64_t updateTime = record.mUpdateTimeMs;
+    APSARA_TEST_EQUAL(3000U, record.mTimeoutMs);
     APSARA_TEST_EQUAL(sFlusher.get(), record.mFlusher);
     APSARA_TEST_EQUAL(key, record.mKey);
     APSARA_TEST_GT(updateTime, 0);
@@ -187,8 +208,9 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[1].get());
     APSARA_TEST_EQUAL(eoo1, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
-                   updateTime - 1);
+    APSARA_TEST_GT(
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
+        updateTime - 1);
 
     // flush by time then by size
     res.clear();
@@ -209,8 +231,9 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo2, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
-                   updateTime - 1);
+    APSARA_TEST_GT(
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
+        updateTime - 1);
     APSARA_TEST_EQUAL(1U, res[1].size());
     APSARA_TEST_EQUAL(1U, res[1][0].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[1][0].mTags.mInner.size());
@@ -219,8 +242,9 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(buffer3, res[1][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo3, res[1][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[1][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
-                   updateTime - 1);
+    APSARA_TEST_GT(
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
+        updateTime - 1);
 }
 
 void BatcherUnittest::TestAddWithGroupBatch() {
@@ -245,8 +269,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     TimeoutRecord& record = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key));
-    time_t updateTime = record.mUpdateTime;
-    APSARA_TEST_EQUAL(2U, record.mTimeoutSecs);
+    int64_t updateTime = record.mUpdateTimeMs;
+    APSARA_TEST_EQUAL(1500U, record.mTimeoutMs);
     APSARA_TEST_EQUAL(sFlusher.get(), record.mFlusher);
     APSARA_TEST_EQUAL(key, record.mKey);
     APSARA_TEST_GT(updateTime, 0);
@@ -268,8 +292,9 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[1].get());
     APSARA_TEST_EQUAL(eoo1, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
-                   updateTime - 1);
+    APSARA_TEST_GT(
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
+        updateTime - 1);
 
     // flush by time to group batch
     res.clear();
@@ -299,8 +324,9 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo2, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
-                   updateTime - 1);
+    APSARA_TEST_GT(
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
+        updateTime - 1);
 
     // flush by time to group batch, and then group flush by size
     res.clear();
@@ -321,8 +347,9 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer3, res[0][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo3, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
-                   updateTime - 1);
+    APSARA_TEST_GT(
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
+        updateTime - 1);
     APSARA_TEST_EQUAL(1U, res[0][1].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[0][1].mTags.mInner.size());
     APSARA_TEST_STREQ("val", res[0][1].mTags.mInner["key"].data());
@@ -330,8 +357,9 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer4, res[0][1].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo4, res[0][1].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][1].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
-                   updateTime - 1);
+    APSARA_TEST_GT(
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
+        updateTime - 1);
 
     // flush by size
     res.clear();
@@ -356,8 +384,9 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer7, res[0][0].mSourceBuffers[2].get());
     APSARA_TEST_EQUAL(eoo5, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
-                   updateTime - 1);
+    APSARA_TEST_GT(
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
+        updateTime - 1);
 }
 
 void BatcherUnittest::TestAddWithOversizedGroup() {
@@ -445,8 +474,8 @@ void BatcherUnittest::TestFlushEventQueueWithGroupBatch() {
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(2U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     TimeoutRecord& record = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, 0));
-    time_t updateTime = record.mUpdateTime;
-    APSARA_TEST_EQUAL(1U, record.mTimeoutSecs);
+    int64_t updateTime = record.mUpdateTimeMs;
+    APSARA_TEST_EQUAL(1500U, record.mTimeoutMs);
     APSARA_TEST_EQUAL(sFlusher.get(), record.mFlusher);
     APSARA_TEST_EQUAL(0U, record.mKey);
     APSARA_TEST_GT(updateTime, 0);
@@ -657,6 +686,46 @@ void BatcherUnittest::TestMetric() {
     }
 }
 
+void BatcherUnittest::TestAdaptiveFlush() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMinCnt = 100;
+    strategy.mMaxSizeBytes = 300;
+    strategy.mMinSizeBytes = 100;
+    strategy.mTimeoutSecs = 4;
+    strategy.mMaxSerializedSizeBytes = 600;
+    {
+        // disabled by default
+        Batcher<> batch;
+        batch.Init(Json::Value(), sFlusher.get(), strategy, true);
+        APSARA_TEST_FALSE(batch.mAdaptiveFlushStrategy.has_value());
+        APSARA_TEST_EQUAL(100U, batch.mTargetMinSizeBytes->GetValue());
+        APSARA_TEST_EQUAL(300U, batch.mTargetMaxSizeBytes->GetValue());
+    }
+    {
+        Json::Value configJson;
+        configJson["EnableAdaptiveFlush"] = true;
+        Batcher<> batch;
+        batch.Init(configJson, sFlusher.get(), strategy, true);
+        APSARA_TEST_TRUE(batch.mAdaptiveFlushStrategy.has_value());
+
+        INT32_FLAG(batcher_adaptive_adjust_interval_secs) = 0;
+        vector<BatchedEventsList> res;
+        batch.Add(CreateEventGroup(1), res);
+        // serialized data is twice as large, so the max size is lowered below the configured one
+        batch.OnSerialized(100, 200);
+        this_thread::sleep_for(chrono::milliseconds(10));
+        // the input rate is far beyond the max size in a timeout
+        batch.Add(CreateEventGroup(1), res);
+        INT32_FLAG(batcher_adaptive_adjust_interval_secs) = 10;
+
+        APSARA_TEST_EQUAL(240U, batch.mEventFlushStrategy.GetMaxSizeBytes());
+        APSARA_TEST_EQUAL(240U, batch.mEventFlushStrategy.GetMinSizeBytes());
+        APSARA_TEST_EQUAL(240U, batch.mGroupFlushStrategy->GetMinSizeBytes());
+        APSARA_TEST_EQUAL(240U, batch.mTargetMinSizeBytes->GetValue());
+        APSARA_TEST_EQUAL(240U, batch.mTargetMaxSizeBytes->GetValue());
+    }
+}
+
 PipelineEventGroup BatcherUnittest::CreateEventGroup(size_t cnt) {
     PipelineEventGroup group(make_shared<SourceBuffer>());
     group.SetTag(string("key"), string("val"));
@@ -681,6 +750,7 @@ UNIT_TEST_CASE(BatcherUnittest, TestFlushGroupQueue)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithoutGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestMetric)
+UNIT_TEST_CASE(BatcherUnittest, TestAdaptiveFlush)
 
 } // namespace logtail
 
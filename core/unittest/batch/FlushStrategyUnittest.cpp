@@ -15,6 +15,7 @@
 
 #include "PipelineEventGroup.h"
 #include "PipelineEventPtr.h"
+#include "collection_pipeline/batch/AdaptiveFlushStrategy.h"
 #include "collection_pipeline/batch/BatchStatus.h"
 #include "collection_pipeline/batch/FlushStrategy.h"
 #include "unittest/Unittest.h"
@@ -26,6 +27,7 @@ namespace logtail {
 class EventFlushStrategyUnittest : public ::testing::Test {
 public:
     void TestNeedFlush();
+    void TestSubSecondTimeout();
 
 protected:
     void SetUp() override {
@@ -44,7 +46,7 @@ void EventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 2;
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 1000;
     APSARA_TEST_TRUE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushBySize(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushByTime(status, PipelineEventPtr()));
@@ -52,7 +54,7 @@ void EventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 1;
     status.mSizeBytes = 100;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 1000;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_TRUE(mStrategy.NeedFlushBySize(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushByTime(status, PipelineEventPtr()));
@@ -60,19 +62,35 @@ void EventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 1;
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 4;
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 4000;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushBySize(status));
     APSARA_TEST_TRUE(mStrategy.NeedFlushByTime(status, PipelineEventPtr()));
     APSARA_TEST_FALSE(mStrategy.SizeReachingUpperLimit(status));
 
     status.mSizeBytes = 300;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 1000;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByTime(status, PipelineEventPtr()));
     APSARA_TEST_TRUE(mStrategy.SizeReachingUpperLimit(status));
 }
 
+void EventFlushStrategyUnittest::TestSubSecondTimeout() {
+    mStrategy.SetTimeoutMs(200);
+    APSARA_TEST_EQUAL(200U, mStrategy.GetTimeoutMs());
+    APSARA_TEST_EQUAL(0U, mStrategy.GetTimeoutSecs());
+
+    EventBatchStatus status;
+    status.mCnt = 1;
+    status.mSizeBytes = 50;
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 100;
+    APSARA_TEST_FALSE(mStrategy.NeedFlushByTime(status, PipelineEventPtr()));
+
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 300;
+    APSARA_TEST_TRUE(mStrategy.NeedFlushByTime(status, PipelineEventPtr()));
+}
+
 UNIT_TEST_CASE(EventFlushStrategyUnittest, TestNeedFlush)
+UNIT_TEST_CASE(EventFlushStrategyUnittest, TestSubSecondTimeout)
 
 class GroupFlushStrategyUnittest : public ::testing::Test {
 public:
@@ -80,16 +98,16 @@ public:
 };
 
 void GroupFlushStrategyUnittest::TestNeedFlush() {
-    GroupFlushStrategy strategy(100, 3);
+    GroupFlushStrategy strategy(100, 3000);
     GroupBatchStatus status;
 
     status.mSizeBytes = 100;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 1000;
     APSARA_TEST_TRUE(strategy.NeedFlushBySize(status));
     APSARA_TEST_FALSE(strategy.NeedFlushByTime(status));
 
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 4;
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 4000;
     APSARA_TEST_FALSE(strategy.NeedFlushBySize(status));
     APSARA_TEST_TRUE(strategy.NeedFlushByTime(status));
 }
@@ -121,7 +139,7 @@ void SLSEventFlushStrategyUnittest::TestNeedFlush() {
     SLSEventBatchStatus status;
     status.mCnt = 2;
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 1000;
     status.mCreateTimeMinute = 1717398001 / 60;
     APSARA_TEST_TRUE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushBySize(status));
@@ -130,7 +148,7 @@ void SLSEventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 1;
     status.mSizeBytes = 100;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 1000;
     status.mCreateTimeMinute = 1717398001 / 60;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_TRUE(mStrategy.NeedFlushBySize(status));
@@ -139,7 +157,7 @@ void SLSEventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 1;
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 4;
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 4000;
     status.mCreateTimeMinute = 1717398001 / 60;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushBySize(status));
@@ -148,7 +166,7 @@ void SLSEventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 1;
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCurrentTimeInMilliSeconds() - 1000;
     status.mCreateTimeMinute = 1717398071 / 60;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushBySize(status));
@@ -162,6 +180,131 @@ void SLSEventFlushStrategyUnittest::TestNeedFlush() {
 
 UNIT_TEST_CASE(SLSEventFlushStrategyUnittest, TestNeedFlush)
 
+class AdaptiveFlushStrategyUnittest : public ::testing::Test {
+public:
+    void TestInputRate();
+    void TestPressure();
+    void TestSerializeRatio();
+    void TestMaxSizeCap();
+};
+
+void AdaptiveFlushStrategyUnittest::TestInputRate() {
+    AdaptiveFlushStrategy strategy(512 * 1024, 8 * 1024 * 1024, 10 * 1024 * 1024, 3000);
+    auto now = chrono::steady_clock::now();
+    APSARA_TEST_FALSE(strategy.Update(now));
+
+    // not adjusted before the interval ends
+    strategy.OnAdd(10 * 1024 * 1024);
+    APSARA_TEST_FALSE(strategy.Update(now + chrono::seconds(5)));
+
+    // 1MB/s, half of the timeout is used without pressure
+    now += chrono::seconds(10);
+    APSARA_TEST_TRUE(strategy.Update(now));
+    APSARA_TEST_EQUAL(1536U * 1024, strategy.GetMinSizeBytes());
+    APSARA_TEST_EQUAL(8U * 1024 * 1024, strategy.GetMaxSizeBytes());
+
+    // 100KB/s, never less than the configured min size
+    strategy.OnAdd(1000 * 1024);
+    now += chrono::seconds(10);
+    APSARA_TEST_TRUE(strategy.Update(now));
+    APSARA_TEST_EQUAL(512U * 1024, strategy.GetMinSizeBytes());
+    strategy.OnAdd(1000 * 1024);
+    now += chrono::seconds(10);
+    APSARA_TEST_FALSE(strategy.Update(now));
+
+    // 10MB/s, never more than the max size
+    strategy.OnAdd(100 * 1024 * 1024);
+    now += chrono::seconds(10);
+    APSARA_TEST_TRUE(strategy.Update(now));
+    APSARA_TEST_EQUAL(8U * 1024 * 1024, strategy.GetMinSizeBytes());
+}
+
+void AdaptiveFlushStrategyUnittest::TestPressure() {
+    AdaptiveFlushStrategy strategy(0, 8 * 1024 * 1024, 10 * 1024 * 1024, 3000);
+    auto now = chrono::steady_clock::now();
+    strategy.Update(now);
+
+    // items wait in the sender queue for as long as the timeout, so the whole timeout is used
+    strategy.OnAdd(10 * 1024 * 1024);
+    strategy.OnSendDone(chrono::milliseconds(3000), chrono::milliseconds(50));
+    now += chrono::seconds(10);
+    APSARA_TEST_TRUE(strategy.Update(now));
+    APSARA_TEST_EQUAL(1.0, strategy.GetPressure());
+    APSARA_TEST_EQUAL(3U * 1024 * 1024, strategy.GetMinSizeBytes());
+
+    // the pressure is kept when no request is done in the interval
+    strategy.OnAdd(10 * 1024 * 1024);
+    now += chrono::seconds(10);
+    APSARA_TEST_FALSE(strategy.Update(now));
+    APSARA_TEST_EQUAL(1.0, strategy.GetPressure());
+
+    // rtt halfway between the low and the high one
+    strategy.OnAdd(10 * 1024 * 1024);
+    strategy.OnSendDone(chrono::milliseconds(0), chrono::milliseconds(1000));
+    strategy.OnSendDone(chrono::milliseconds(0), chrono::milliseconds(1100));
+    now += chrono::seconds(10);
+    APSARA_TEST_TRUE(strategy.Update(now));
+    APSARA_TEST_EQUAL(0.5, strategy.GetPressure());
+    APSARA_TEST_EQUAL(2304U * 1024, strategy.GetMinSizeBytes());
+
+    // fast sender
+    strategy.OnAdd(10 * 1024 * 1024);
+    strategy.OnSendDone(chrono::milliseconds(0), chrono::milliseconds(20));
+    now += chrono::seconds(10);
+    APSARA_TEST_TRUE(strategy.Update(now));
+    APSARA_TEST_EQUAL(0.0, strategy.GetPressure());
+    APSARA_TEST_EQUAL(1536U * 1024, strategy.GetMinSizeBytes());
+}
+
+void AdaptiveFlushStrategyUnittest::TestSerializeRatio() {
+    AdaptiveFlushStrategy strategy(512 * 1024, 8 * 1024 * 1024, 10 * 1024 * 1024, 3000);
+    auto now = chrono::steady_clock::now();
+    strategy.Update(now);
+
+    strategy.OnSerialized(0, 100);
+    APSARA_TEST_EQUAL(0.0, strategy.GetSerializeRatio());
+    strategy.OnSerialized(1000, 500);
+    APSARA_TEST_EQUAL(0.5, strategy.GetSerializeRatio());
+
+    // smoothed
+    strategy.OnSerialized(1000, 1000);
+    APSARA_TEST_TRUE(abs(strategy.GetSerializeRatio() - 0.6) < 1e-9);
+}
+
+void AdaptiveFlushStrategyUnittest::TestMaxSizeCap() {
+    AdaptiveFlushStrategy strategy(512 * 1024, 8 * 1024 * 1024, 10 * 1024 * 1024, 3000);
+    auto now = chrono::steady_clock::now();
+    strategy.Update(now);
+
+    // data shrinks when serialized, the configured max size is still the upper bound
+    strategy.OnSerialized(1000, 500);
+    now += chrono::seconds(10);
+    APSARA_TEST_FALSE(strategy.Update(now));
+    APSARA_TEST_EQUAL(8U * 1024 * 1024, strategy.GetMaxSizeBytes());
+
+    // data expands when serialized, the max size is lowered to keep within the serialized size limit
+    AdaptiveFlushStrategy expandingStrategy(512 * 1024, 8 * 1024 * 1024, 10 * 1024 * 1024, 3000);
+    expandingStrategy.Update(now);
+    expandingStrategy.OnSerialized(1000, 2000);
+    now += chrono::seconds(10);
+    APSARA_TEST_TRUE(expandingStrategy.Update(now));
+    APSARA_TEST_EQUAL(4U * 1024 * 1024, expandingStrategy.GetMaxSizeBytes());
+    APSARA_TEST_EQUAL(512U * 1024, expandingStrategy.GetMinSizeBytes());
+
+    // no serialized size limit
+    AdaptiveFlushStrategy unlimitedStrategy(512 * 1024, 8 * 1024 * 1024, 0, 3000);
+    unlimitedStrategy.Update(now);
+    unlimitedStrategy.OnSerialized(1000, 2000);
+    now += chrono::seconds(10);
+    APSARA_TEST_FALSE(unlimitedStrategy.Update(now));
+    APSARA_TEST_EQUAL(8U * 1024 * 1024, unlimitedStrategy.GetMaxSizeBytes());
+}
+
+UNIT_TEST_CASE(AdaptiveFlushStrategyUnittest, TestInputRate)
+UNIT_TEST_CASE(AdaptiveFlushStrategyUnittest, TestPressure)
+UNIT_TEST_CASE(AdaptiveFlushStrategyUnittest, TestSerializeRatio)
+UNIT_TEST_CASE(AdaptiveFlushStrategyUnittest, TestMaxSizeCap)
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
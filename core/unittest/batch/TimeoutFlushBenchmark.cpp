@@ -0,0 +1,122 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "collection_pipeline/batch/TimeoutFlushManager.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "common/TimeUtil.h"
+#include "unittest/Unittest.h"
+#include "unittest/plugin/PluginMock.h"
+
+using namespace std;
+using namespace logtail;
+
+class LatencyFlusher : public FlusherMock {
+public:
+    bool Flush(size_t key) override {
+        lock_guard<mutex> lock(mMux);
+        mFlushTimeMs[key] = GetCurrentTimeInMilliSeconds();
+        return true;
+    }
+
+    mutex mMux;
+    unordered_map<size_t, int64_t> mFlushTimeMs;
+};
+
+// At low event rates batches never fill up, so each event waits for its batch to be flushed by timeout. Each event
+// opens a new batch here, and the latency is measured from its arrival to the flush of its batch.
+//
+// legacy: the former behavior, with a timeout of at least 1 second checked by processor thread 0 once per second.
+// deadline: sub-second timeout, with the processor threads woken up by the scheduler at the batch deadline.
+static void BM_TimeoutFlush(bool legacy, uint32_t eventsPerSec, uint32_t durationSecs) {
+    const uint32_t timeoutMs = legacy ? 1000 : 200;
+    LatencyFlusher flusher;
+    atomic_bool running = true;
+    thread runner;
+    if (legacy) {
+        runner = thread([&]() {
+            auto lastFlushTime = chrono::steady_clock::now();
+            while (running) {
+                if (chrono::steady_clock::now() - lastFlushTime >= chrono::seconds(1)) {
+                    TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
+                    lastFlushTime = chrono::steady_clock::now();
+                }
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+        });
+    } else {
+        TimeoutFlushManager::GetInstance()->Start();
+        runner = thread([&]() {
+            while (running) {
+                TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
+                ProcessQueueManager::GetInstance()->Wait(100);
+            }
+        });
+    }
+
+    size_t eventCnt = eventsPerSec * durationSecs;
+    vector<int64_t> arriveTimeMs(eventCnt);
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < eventCnt; ++i) {
+        this_thread::sleep_until(start + chrono::microseconds(1000000 / eventsPerSec) * i);
+        arriveTimeMs[i] = GetCurrentTimeInMilliSeconds();
+        TimeoutFlushManager::GetInstance()->UpdateRecord("benchmark", 0, i + 1, timeoutMs, &flusher);
+    }
+    this_thread::sleep_for(chrono::milliseconds(timeoutMs + 1500));
+    running = false;
+    runner.join();
+    if (!legacy) {
+        TimeoutFlushManager::GetInstance()->Stop();
+    }
+
+    vector<int64_t> latencies;
+    {
+        lock_guard<mutex> lock(flusher.mMux);
+        for (size_t i = 0; i < eventCnt; ++i) {
+            auto it = flusher.mFlushTimeMs.find(i + 1);
+            if (it != flusher.mFlushTimeMs.end()) {
+                latencies.push_back(it->second - arriveTimeMs[i]);
+            }
+        }
+    }
+    sort(latencies.begin(), latencies.end());
+    cout << (legacy ? "legacy" : "deadline") << "\ttimeout: " << timeoutMs << " ms\trate: " << eventsPerSec
+         << " events/s\tflushed: " << latencies.size() << "/" << eventCnt;
+    if (!latencies.empty()) {
+        cout << "\tp50: " << latencies[latencies.size() / 2] << " ms\tp99: " << latencies[latencies.size() * 99 / 100]
+             << " ms\tmax: " << latencies.back() << " ms";
+    }
+    cout << endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    for (uint32_t rate : {2, 20, 100}) {
+        BM_TimeoutFlush(true, rate, 5);
+        BM_TimeoutFlush(false, rate, 5);
+    }
+    return 0;
+}
@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <thread>
+
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "unittest/Unittest.h"
 #include "unittest/plugin/PluginMock.h"
 
@@ -25,6 +28,9 @@ public:
     void TestUpdateRecord();
     void TestFlushTimeoutBatch();
     void TestUnregisterFlushers();
+    void TestSubSecondTimeout();
+    void TestFlushAllBatchesEarly();
+    void TestScheduler();
 
 protected:
     static void SetUpTestCase() {
@@ -35,7 +41,10 @@ protected:
         sFlusher->CommitMetricsRecordRef();
     }
 
-    void TearDown() override { TimeoutFlushManager::GetInstance()->mTimeoutRecords.clear(); }
+    void TearDown() override {
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords.clear();
+        TimeoutFlushManager::GetInstance()->mNextDeadlineMs = numeric_limits<int64_t>::max();
+    }
 
 private:
     static unique_ptr<FlusherMock> sFlusher;
@@ -47,30 +56,30 @@ CollectionPipelineContext TimeoutFlushManagerUnittest::sCtx;
 
 void TimeoutFlushManagerUnittest::TestUpdateRecord() {
     // new batch queue
-    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3, sFlusher.get());
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3000, sFlusher.get());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     auto& record1 = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, 1));
     APSARA_TEST_EQUAL(1U, record1.mKey);
-    APSARA_TEST_EQUAL(3U, record1.mTimeoutSecs);
+    APSARA_TEST_EQUAL(3000U, record1.mTimeoutMs);
     APSARA_TEST_EQUAL(sFlusher.get(), record1.mFlusher);
-    APSARA_TEST_GT(record1.mUpdateTime, 0);
+    APSARA_TEST_GT(record1.mUpdateTimeMs, 0);
 
     // existed batch queue
-    time_t lastTime = record1.mUpdateTime;
-    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3, sFlusher.get());
+    int64_t lastTime = record1.mUpdateTimeMs;
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3000, sFlusher.get());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     auto& record2 = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, 1));
     APSARA_TEST_EQUAL(1U, record2.mKey);
-    APSARA_TEST_EQUAL(3U, record2.mTimeoutSecs);
+    APSARA_TEST_EQUAL(3000U, record2.mTimeoutMs);
     APSARA_TEST_EQUAL(sFlusher.get(), record2.mFlusher);
-    APSARA_TEST_GT(record2.mUpdateTime, lastTime - 1);
+    APSARA_TEST_GT(record2.mUpdateTimeMs, lastTime - 1);
 }
 
 void TimeoutFlushManagerUnittest::TestFlushTimeoutBatch() {
     TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 0, 0, sFlusher.get());
-    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3, sFlusher.get());
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3000, sFlusher.get());
     TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 2, 0, sFlusher.get());
 
     TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
@@ -87,7 +96,7 @@ void TimeoutFlushManagerUnittest::TestUnregisterFlushers() {
     vector<unique_ptr<FlusherInstance>> flushers;
     flushers.push_back(std::move(instance));
 
-    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3, flusher);
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3000, flusher);
     TimeoutFlushManager::GetInstance()->UnregisterFlushers("test_config", flushers);
 
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mDeletedFlushers.size());
@@ -98,9 +107,66 @@ void TimeoutFlushManagerUnittest::TestUnregisterFlushers() {
     APSARA_TEST_TRUE(TimeoutFlushManager::GetInstance()->mTimeoutRecords.empty());
 }
 
+void TimeoutFlushManagerUnittest::TestSubSecondTimeout() {
+    sFlusher->mFlushedQueues.clear();
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 100, sFlusher.get());
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 2, 3000, sFlusher.get());
+    auto& records = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"];
+    APSARA_TEST_EQUAL(records.at(make_pair(0, 1)).GetDeadlineMs(),
+                      TimeoutFlushManager::GetInstance()->mNextDeadlineMs.load());
+
+    TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
+    APSARA_TEST_TRUE(sFlusher->mFlushedQueues.empty());
+
+    this_thread::sleep_for(chrono::milliseconds(150));
+    TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
+    APSARA_TEST_EQUAL(1U, sFlusher->mFlushedQueues.size());
+    APSARA_TEST_EQUAL(1U, sFlusher->mFlushedQueues[0]);
+    // the next deadline is moved to the remaining record
+    APSARA_TEST_EQUAL(1U, records.size());
+    APSARA_TEST_EQUAL(records.at(make_pair(0, 2)).GetDeadlineMs(),
+                      TimeoutFlushManager::GetInstance()->mNextDeadlineMs.load());
+}
+
+void TimeoutFlushManagerUnittest::TestFlushAllBatchesEarly() {
+    sFlusher->mFlushedQueues.clear();
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3000, sFlusher.get());
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 2, 3000, sFlusher.get());
+    TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
+    APSARA_TEST_TRUE(sFlusher->mFlushedQueues.empty());
+
+    TimeoutFlushManager::GetInstance()->FlushAllBatchesEarly();
+    APSARA_TEST_EQUAL(0, TimeoutFlushManager::GetInstance()->mNextDeadlineMs.load());
+    TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
+    APSARA_TEST_EQUAL(2U, sFlusher->mFlushedQueues.size());
+    APSARA_TEST_TRUE(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].empty());
+    APSARA_TEST_FALSE(TimeoutFlushManager::GetInstance()->mIsEarlyFlushRequested.load());
+
+    // later batches are flushed by deadline again
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3000, sFlusher.get());
+    TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
+    APSARA_TEST_EQUAL(2U, sFlusher->mFlushedQueues.size());
+}
+
+void TimeoutFlushManagerUnittest::TestScheduler() {
+    TimeoutFlushManager::GetInstance()->Start();
+    // consume any pending trigger
+    ProcessQueueManager::GetInstance()->Wait(0);
+
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 100, sFlusher.get());
+    auto start = chrono::steady_clock::now();
+    // processor runner threads are woken up once the deadline is reached
+    APSARA_TEST_TRUE(ProcessQueueManager::GetInstance()->Wait(1000));
+    APSARA_TEST_GE(chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count(), 90);
+    TimeoutFlushManager::GetInstance()->Stop();
+}
+
 UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestUpdateRecord)
 UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestFlushTimeoutBatch)
 UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestUnregisterFlushers)
+UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestSubSecondTimeout)
+UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestFlushAllBatchesEarly)
+UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestScheduler)
 
 } // namespace logtail
 
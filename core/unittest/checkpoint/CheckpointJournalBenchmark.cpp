@@ -0,0 +1,135 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "common/Flags.h"
+#include "file_server/checkpoint/CheckPointManager.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_checkpoint_journal);
+DECLARE_FLAG_INT32(check_point_max_count);
+
+using namespace std;
+
+namespace logtail {
+
+// Compares the cost of dumping and loading checkpoints between the json file and the journal, with a synthetic set of
+// file checkpoints of which only a small part is changed between dumps, as is the case with most files being idle.
+class CheckpointJournalBenchmark : public testing::Test {
+public:
+    void TestDumpAndLoad();
+
+protected:
+    static void SetUpTestCase() {
+        filesystem::create_directories(sRootDir);
+        sOriginalPath = AppConfig::GetInstance()->mCheckPointFilePath;
+        AppConfig::GetInstance()->mCheckPointFilePath = (sRootDir / "checkpoint").string();
+        sOriginalMaxCount = INT32_FLAG(check_point_max_count);
+        INT32_FLAG(check_point_max_count) = sCheckPointCnt;
+    }
+
+    static void TearDownTestCase() {
+        CheckPointManager::Instance()->RemoveAllCheckPoint();
+        AppConfig::GetInstance()->mCheckPointFilePath = sOriginalPath;
+        INT32_FLAG(check_point_max_count) = sOriginalMaxCount;
+        BOOL_FLAG(enable_checkpoint_journal) = false;
+        filesystem::remove_all(sRootDir);
+    }
+
+private:
+    static int64_t Measure(const function<void()>& func) {
+        auto start = chrono::steady_clock::now();
+        func();
+        return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    }
+
+    static const filesystem::path sRootDir;
+    static const int32_t sCheckPointCnt = 100000;
+    static string sOriginalPath;
+    static int32_t sOriginalMaxCount;
+};
+
+const filesystem::path CheckpointJournalBenchmark::sRootDir = "./checkpoint_journal_benchmark";
+string CheckpointJournalBenchmark::sOriginalPath;
+int32_t CheckpointJournalBenchmark::sOriginalMaxCount = 0;
+
+void CheckpointJournalBenchmark::TestDumpAndLoad() {
+    auto* manager = CheckPointManager::Instance();
+    manager->RemoveAllCheckPoint();
+    int32_t now = time(nullptr);
+    for (int32_t i = 0; i < sCheckPointCnt; ++i) {
+        string fileName = "/var/log/app_" + to_string(i / 100) + "/access_" + to_string(i) + ".log";
+        auto* ptr = new CheckPoint(fileName,
+                                   fileName,
+                                   i * 1024,
+                                   1024,
+                                   i,
+                                   DevInode(2049, i + 1),
+                                   "config_" + to_string(i % 10),
+                                   fileName,
+                                   false,
+                                   false,
+                                   "",
+                                   false);
+        ptr->mLastUpdateTime = now;
+        manager->AddCheckPoint(ptr);
+    }
+    auto modify = [&](int64_t delta) {
+        int32_t i = 0;
+        for (auto& item : manager->GetAllFileCheckPoint()) {
+            // about 1% of the files are being written
+            if (i++ % 100 == 0) {
+                item.second->mOffset += delta;
+            }
+        }
+    };
+
+    BOOL_FLAG(enable_checkpoint_journal) = false;
+    auto jsonDump = Measure([&]() { APSARA_TEST_TRUE(manager->DumpCheckPointToLocal()); });
+    modify(1);
+    auto jsonDirtyDump = Measure([&]() { APSARA_TEST_TRUE(manager->DumpCheckPointToLocal()); });
+    auto jsonSize = filesystem::file_size(AppConfig::GetInstance()->GetCheckPointFilePath());
+    manager->RemoveAllCheckPoint();
+    auto jsonLoad = Measure([&]() { manager->LoadCheckPoint(); });
+    APSARA_TEST_EQUAL(static_cast<size_t>(sCheckPointCnt), manager->GetAllFileCheckPoint().size());
+
+    BOOL_FLAG(enable_checkpoint_journal) = true;
+    auto journalDump = Measure([&]() { APSARA_TEST_TRUE(manager->DumpCheckPointToLocal()); });
+    auto snapshotSize = manager->GetJournal().GetSize();
+    modify(1);
+    auto journalDirtyDump = Measure([&]() { APSARA_TEST_TRUE(manager->DumpCheckPointToLocal()); });
+    auto journalSize = manager->GetJournal().GetSize();
+    manager->RemoveAllCheckPoint();
+    auto journalLoad = Measure([&]() { manager->LoadCheckPoint(); });
+    APSARA_TEST_EQUAL(static_cast<size_t>(sCheckPointCnt), manager->GetAllFileCheckPoint().size());
+
+    cout << "[json] checkpoints: " << sCheckPointCnt << ", full dump: " << jsonDump
+         << " ms, dump with 1% changed: " << jsonDirtyDump << " ms, load: " << jsonLoad
+         << " ms, file size: " << jsonSize << " bytes" << endl;
+    cout << "[journal] checkpoints: " << sCheckPointCnt << ", full dump: " << journalDump
+         << " ms, dump with 1% changed: " << journalDirtyDump << " ms, load: " << journalLoad
+         << " ms, bytes appended: " << journalSize - snapshotSize << ", file size: " << journalSize << " bytes"
+         << endl;
+}
+
+UNIT_TEST_CASE(CheckpointJournalBenchmark, TestDumpAndLoad)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,177 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <string>
+
+#include "common/Flags.h"
+#include "file_server/checkpoint/CheckpointJournal.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(checkpoint_journal_compact_ratio);
+DECLARE_FLAG_INT32(checkpoint_journal_min_compact_size_kb);
+
+using namespace std;
+
+namespace logtail {
+
+class CheckpointJournalUnittest : public testing::Test {
+public:
+    void TestDumpAndLoad();
+    void TestAppendChangedOnly();
+    void TestBrokenTail();
+    void TestCompaction();
+    void TestVersionChange();
+
+protected:
+    void SetUp() override {
+        filesystem::remove(mPath);
+        mRecords = CheckpointJournal::Records();
+        for (size_t i = 0; i < 10; ++i) {
+            mRecords[CheckpointJournal::FILE_CHECKPOINT]["file_" + to_string(i)] = "value_" + to_string(i);
+        }
+        mRecords[CheckpointJournal::DIR_CHECKPOINT]["dir"] = "sub_dirs";
+    }
+
+    void TearDown() override {
+        INT32_FLAG(checkpoint_journal_compact_ratio) = 4;
+        INT32_FLAG(checkpoint_journal_min_compact_size_kb) = 1024;
+        filesystem::remove(mPath);
+    }
+
+    CheckpointJournal::Records Load(uint32_t* version = nullptr) const {
+        CheckpointJournal journal(mPath);
+        CheckpointJournal::Records records;
+        uint32_t loadVersion = 0;
+        APSARA_TEST_TRUE(journal.Load(records, loadVersion));
+        if (version != nullptr) {
+            *version = loadVersion;
+        }
+        return records;
+    }
+
+    const string mPath = "checkpoint_journal_unittest.journal";
+    CheckpointJournal::Records mRecords;
+};
+
+void CheckpointJournalUnittest::TestDumpAndLoad() {
+    CheckpointJournal journal(mPath);
+    APSARA_TEST_FALSE(journal.Exists());
+    APSARA_TEST_TRUE(journal.Dump(mRecords, 200));
+    APSARA_TEST_TRUE(journal.Exists());
+    APSARA_TEST_EQUAL(filesystem::file_size(mPath), journal.GetSize());
+
+    uint32_t version = 0;
+    APSARA_TEST_TRUE(mRecords == Load(&version));
+    APSARA_TEST_EQUAL(200U, version);
+
+    journal.Remove();
+    APSARA_TEST_FALSE(journal.Exists());
+}
+
+void CheckpointJournalUnittest::TestAppendChangedOnly() {
+    CheckpointJournal journal(mPath);
+    APSARA_TEST_TRUE(journal.Dump(mRecords, 200));
+    uint64_t size = journal.GetSize();
+
+    // nothing changed
+    APSARA_TEST_TRUE(journal.Dump(mRecords, 200));
+    APSARA_TEST_EQUAL(size, journal.GetSize());
+
+    // only the changed record is appended
+    mRecords[CheckpointJournal::FILE_CHECKPOINT]["file_3"] = "value_3_changed";
+    APSARA_TEST_TRUE(journal.Dump(mRecords, 200));
+    uint64_t recordSize = CheckpointJournal::GetRecordSize("file_3", "value_3_changed");
+    APSARA_TEST_EQUAL(size + recordSize, journal.GetSize());
+    size = journal.GetSize();
+
+    // only the deletion is appended
+    mRecords[CheckpointJournal::FILE_CHECKPOINT].erase("file_5");
+    mRecords[CheckpointJournal::FILE_CHECKPOINT]["file_10"] = "value_10";
+    APSARA_TEST_TRUE(journal.Dump(mRecords, 200));
+    APSARA_TEST_EQUAL(size + CheckpointJournal::GetRecordSize("file_5", "")
+                          + CheckpointJournal::GetRecordSize("file_10", "value_10"),
+                      journal.GetSize());
+    APSARA_TEST_EQUAL(filesystem::file_size(mPath), journal.GetSize());
+
+    APSARA_TEST_TRUE(mRecords == Load());
+}
+
+void CheckpointJournalUnittest::TestBrokenTail() {
+    {
+        CheckpointJournal journal(mPath);
+        APSARA_TEST_TRUE(journal.Dump(mRecords, 200));
+    }
+    auto expected = mRecords;
+    {
+        CheckpointJournal journal(mPath);
+        CheckpointJournal::Records records;
+        uint32_t version = 0;
+        APSARA_TEST_TRUE(journal.Load(records, version));
+        mRecords[CheckpointJournal::FILE_CHECKPOINT]["file_3"] = "value_3_changed";
+        APSARA_TEST_TRUE(journal.Dump(mRecords, 200));
+    }
+    // the last record is torn
+    filesystem::resize_file(mPath, filesystem::file_size(mPath) - 3);
+
+    CheckpointJournal journal(mPath);
+    CheckpointJournal::Records records;
+    uint32_t version = 0;
+    APSARA_TEST_TRUE(journal.Load(records, version));
+    APSARA_TEST_TRUE(expected == records);
+    // the journal is rewritten on next dump
+    APSARA_TEST_EQUAL(0U, journal.GetSize());
+    APSARA_TEST_TRUE(journal.Dump(mRecords, 200));
+    APSARA_TEST_TRUE(mRecords == Load());
+}
+
+void CheckpointJournalUnittest::TestCompaction() {
+    INT32_FLAG(checkpoint_journal_min_compact_size_kb) = 0;
+    INT32_FLAG(checkpoint_journal_compact_ratio) = 2;
+    CheckpointJournal journal(mPath);
+    APSARA_TEST_TRUE(journal.Dump(mRecords, 200));
+    uint64_t snapshotSize = journal.GetSize();
+    for (size_t i = 0; i < 100; ++i) {
+        for (auto& item : mRecords[CheckpointJournal::FILE_CHECKPOINT]) {
+            item.second = "value_" + to_string(i);
+        }
+        APSARA_TEST_TRUE(journal.Dump(mRecords, 200));
+        APSARA_TEST_TRUE(journal.GetSize() <= snapshotSize * 2);
+    }
+    APSARA_TEST_TRUE(mRecords == Load());
+}
+
+void CheckpointJournalUnittest::TestVersionChange() {
+    CheckpointJournal journal(mPath);
+    APSARA_TEST_TRUE(journal.Dump(mRecords, 200));
+    uint64_t size = journal.GetSize();
+    mRecords[CheckpointJournal::FILE_CHECKPOINT]["file_3"] = "value_3_changed";
+    // the journal is rewritten with the new version
+    APSARA_TEST_TRUE(journal.Dump(mRecords, 300));
+    APSARA_TEST_EQUAL(size + string("_changed").size(), journal.GetSize());
+
+    uint32_t version = 0;
+    APSARA_TEST_TRUE(mRecords == Load(&version));
+    APSARA_TEST_EQUAL(300U, version);
+}
+
+UNIT_TEST_CASE(CheckpointJournalUnittest, TestDumpAndLoad)
+UNIT_TEST_CASE(CheckpointJournalUnittest, TestAppendChangedOnly)
+UNIT_TEST_CASE(CheckpointJournalUnittest, TestBrokenTail)
+UNIT_TEST_CASE(CheckpointJournalUnittest, TestCompaction)
+UNIT_TEST_CASE(CheckpointJournalUnittest, TestVersionChange)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -18,6 +18,7 @@
 #include "unittest/Unittest.h"
 
 DECLARE_FLAG_INT32(checkpoint_find_max_file_count);
+DECLARE_FLAG_BOOL(enable_checkpoint_journal);
 
 namespace logtail {
 
@@ -35,9 +36,11 @@ public:
     static void TearDownTestCase() { bfs::remove_all(kTestRootDir); }
 
     void TestSearchFilePathByDevInodeInDirectory();
+    void TestCheckPointJournal();
 };
 
 UNIT_TEST_CASE(CheckpointManagerUnittest, TestSearchFilePathByDevInodeInDirectory);
+UNIT_TEST_CASE(CheckpointManagerUnittest, TestCheckPointJournal);
 
 void CheckpointManagerUnittest::TestSearchFilePathByDevInodeInDirectory() {
     const std::string kRotateFileName = "test.log.5";
@@ -96,6 +99,64 @@ void CheckpointManagerUnittest::TestSearchFilePathByDevInodeInDirectory() {
     }
 }
 
+void CheckpointManagerUnittest::TestCheckPointJournal() {
+    auto* manager = CheckPointManager::Instance();
+    const std::string checkPointFile = (bfs::path(kTestRootDir) / "checkpoint").string();
+    AppConfig::GetInstance()->mCheckPointFilePath = checkPointFile;
+    BOOL_FLAG(enable_checkpoint_journal) = true;
+
+    manager->AddCheckPoint(new CheckPoint(
+        "/a/b.log", "/a/b.log", 100, 1024, 12345, DevInode(1, 2), "config_1", "/a/b.log.1", true, false, "id", false));
+    manager->AddCheckPoint(
+        new CheckPoint("/a/c.log", "/a/c.log", 200, 512, 67890, DevInode(1, 3), "config_2", "", false, true, "", true));
+    manager->AddDirCheckPoint("/a/d");
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    APSARA_TEST_TRUE(manager->GetJournal().Exists());
+    APSARA_TEST_FALSE(bfs::exists(checkPointFile));
+
+    manager->RemoveAllCheckPoint();
+    manager->LoadCheckPoint();
+    APSARA_TEST_EQUAL(2U, manager->GetAllFileCheckPoint().size());
+    CheckPointPtr checkPoint;
+    APSARA_TEST_TRUE(manager->GetCheckPoint(DevInode(1, 2), "config_1", checkPoint));
+    APSARA_TEST_EQUAL("/a/b.log", checkPoint->mFileName);
+    APSARA_TEST_EQUAL("/a/b.log.1", checkPoint->mRealFileName);
+    APSARA_TEST_EQUAL(100, checkPoint->mOffset);
+    APSARA_TEST_EQUAL(1024U, checkPoint->mSignatureSize);
+    APSARA_TEST_EQUAL(12345U, checkPoint->mSignatureHash);
+    APSARA_TEST_EQUAL("id", checkPoint->mContainerID);
+    APSARA_TEST_TRUE(checkPoint->mFileOpenFlag);
+    APSARA_TEST_FALSE(checkPoint->mContainerStopped);
+    APSARA_TEST_TRUE(manager->GetCheckPoint(DevInode(1, 3), "config_2", checkPoint));
+    APSARA_TEST_TRUE(checkPoint->mContainerStopped);
+    APSARA_TEST_TRUE(checkPoint->mLastForceRead);
+    DirCheckPointPtr dirCheckPoint;
+    APSARA_TEST_TRUE(manager->GetDirCheckPoint("/a", dirCheckPoint));
+    APSARA_TEST_EQUAL(1U, dirCheckPoint->mSubDir.count("/a/d"));
+
+    // exported to the json file once the journal is disabled
+    manager->DeleteCheckPoint(DevInode(1, 3), "config_2");
+    BOOL_FLAG(enable_checkpoint_journal) = false;
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    APSARA_TEST_FALSE(manager->GetJournal().Exists());
+    APSARA_TEST_TRUE(bfs::exists(checkPointFile));
+    manager->RemoveAllCheckPoint();
+    manager->LoadCheckPoint();
+    APSARA_TEST_EQUAL(1U, manager->GetAllFileCheckPoint().size());
+
+    // imported from the json file once the journal is enabled
+    BOOL_FLAG(enable_checkpoint_journal) = true;
+    manager->RemoveAllCheckPoint();
+    manager->LoadCheckPoint();
+    APSARA_TEST_TRUE(manager->GetCheckPoint(DevInode(1, 2), "config_1", checkPoint));
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    APSARA_TEST_TRUE(manager->GetJournal().Exists());
+
+    manager->RemoveAllCheckPoint();
+    manager->RemoveLocalCheckPoint();
+    BOOL_FLAG(enable_checkpoint_journal) = false;
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "common/FileSystemUtil.h"
 #include "common/JsonUtil.h"
 #include "file_server/checkpoint/InputStaticFileCheckpointManager.h"
 #include "unittest/Unittest.h"
@@ -26,6 +27,7 @@ public:
     void TestUpdateCheckpoint() const;
     void TestCheckpointFileNames() const;
     void TestDumpCheckpoints() const;
+    void TestDumpRangeCheckpoints() const;
     void TestInvalidCheckpointFile() const;
 
 protected:
@@ -448,6 +450,88 @@ void InputStaticFileCheckpointManagerUnittest::TestDumpCheckpoints() const {
     filesystem::remove_all("test_logs");
 }
 
+void InputStaticFileCheckpointManagerUnittest::TestDumpRangeCheckpoints() const {
+    filesystem::create_directories("test_logs");
+    vector<filesystem::path> files{"./test_logs/test_file_1.log", "./test_logs/test_file_2.log"};
+    {
+        ofstream fout(files[0], std::ios_base::binary);
+        fout << string(2000, 'a') << endl;
+    }
+    {
+        ofstream fout(files[1], std::ios_base::binary);
+        fout << string(1000, 'b') << endl;
+    }
+    // file 1: range 1 finished, range 2 partially read, range 3 waiting; file 2: waiting
+    sManager->CreateCheckpoint("test_config", 0, files);
+    APSARA_TEST_TRUE(sManager->SetFileRanges(
+        "test_config", 0, 0, 2001, {FileRangeCheckpoint(0, 700), FileRangeCheckpoint(700, 1400), {1400, 2001}}));
+    APSARA_TEST_TRUE(sManager->UpdateFileRangeCheckpoint("test_config", 0, 0, 0, 700));
+    APSARA_TEST_TRUE(sManager->UpdateFileRangeCheckpoint("test_config", 0, 0, 1, 1000));
+    {
+        FileRangeCheckpoint range;
+        APSARA_TEST_FALSE(sManager->GetFileRangeCheckpoint("test_config", 0, 0, 0, &range));
+        APSARA_TEST_TRUE(sManager->GetFileRangeCheckpoint("test_config", 0, 0, 1, &range));
+        APSARA_TEST_EQUAL(1000U, range.mOffset);
+        APSARA_TEST_FALSE(sManager->GetFileRangeCheckpoint("test_config", 0, 0, 3, &range));
+        APSARA_TEST_FALSE(sManager->GetFileRangeCheckpoint("test_config", 0, 1, 0, &range));
+    }
+
+    sManager->DumpAllCheckpointFiles();
+    {
+        InputStaticFileCheckpoint cpt;
+        APSARA_TEST_TRUE(sManager->LoadCheckpointFile(sManager->mCheckpointRootPath / "test_config@0.json", &cpt));
+        const auto& expectedCpt = sManager->mInputCheckpointMap.at(make_pair("test_config", 0));
+        APSARA_TEST_EQUAL(2U, cpt.mFileCheckpoints.size());
+        APSARA_TEST_EQUAL(FileStatus::READING, cpt.mFileCheckpoints[0].mStatus);
+        APSARA_TEST_EQUAL(1000U, cpt.mFileCheckpoints[0].mOffset);
+        APSARA_TEST_EQUAL(2001U, cpt.mFileCheckpoints[0].mSize);
+        const auto& expectedRanges = expectedCpt.mFileCheckpoints[0].mRanges;
+        const auto& ranges = cpt.mFileCheckpoints[0].mRanges;
+        APSARA_TEST_EQUAL(3U, ranges.size());
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            APSARA_TEST_EQUAL(expectedRanges[i].mBegin, ranges[i].mBegin);
+            APSARA_TEST_EQUAL(expectedRanges[i].mEnd, ranges[i].mEnd);
+            APSARA_TEST_EQUAL(expectedRanges[i].mOffset, ranges[i].mOffset);
+        }
+        APSARA_TEST_TRUE(ranges[0].IsFinished());
+        APSARA_TEST_EQUAL(1000U, ranges[1].mOffset);
+        APSARA_TEST_EQUAL(1400U, ranges[2].mOffset);
+        APSARA_TEST_EQUAL(FileStatus::WAITING, cpt.mFileCheckpoints[1].mStatus);
+        APSARA_TEST_TRUE(cpt.mFileCheckpoints[1].mRanges.empty());
+    }
+
+    // invalid range
+    {
+        filesystem::path cptPath = sManager->mCheckpointRootPath / "test_config@0.json";
+        string content;
+        APSARA_TEST_TRUE(ReadFile(cptPath.string(), content));
+        Json::Value root;
+        string errorMsg;
+        APSARA_TEST_TRUE(ParseJsonTable(content, root, errorMsg));
+        root["files"][0]["ranges"][1]["end"] = 900;
+        {
+            ofstream fout(cptPath, std::ios_base::binary);
+            fout << root.toStyledString();
+        }
+        InputStaticFileCheckpoint cpt;
+        APSARA_TEST_FALSE(sManager->LoadCheckpointFile(cptPath, &cpt));
+    }
+
+    // ranges are cleared once all of them are finished
+    APSARA_TEST_TRUE(sManager->UpdateFileRangeCheckpoint("test_config", 0, 0, 1, 1400));
+    APSARA_TEST_TRUE(sManager->UpdateFileRangeCheckpoint("test_config", 0, 0, 2, 2001));
+    sManager->DumpAllCheckpointFiles();
+    {
+        InputStaticFileCheckpoint cpt;
+        APSARA_TEST_TRUE(sManager->LoadCheckpointFile(sManager->mCheckpointRootPath / "test_config@0.json", &cpt));
+        APSARA_TEST_EQUAL(FileStatus::FINISHED, cpt.mFileCheckpoints[0].mStatus);
+        APSARA_TEST_EQUAL(2001U, cpt.mFileCheckpoints[0].mSize);
+        APSARA_TEST_TRUE(cpt.mFileCheckpoints[0].mRanges.empty());
+        APSARA_TEST_EQUAL(1U, cpt.mCurrentFileIndex);
+    }
+    filesystem::remove_all("test_logs");
+}
+
 void InputStaticFileCheckpointManagerUnittest::TestInvalidCheckpointFile() const {
     filesystem::path cptPath = sManager->mCheckpointRootPath / "test_config@0.json";
     InputStaticFileCheckpoint cpt;
@@ -639,6 +723,7 @@ UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestUpdateCheckpointMap
 UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestUpdateCheckpoint)
 UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestCheckpointFileNames)
 UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestDumpCheckpoints)
+UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestDumpRangeCheckpoints)
 UNIT_TEST_CASE(InputStaticFileCheckpointManagerUnittest, TestInvalidCheckpointFile)
 
 } // namespace logtail
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "common/Flags.h"
+#include "common/SafeQueue.h"
+#include "common/memory/SourceBuffer.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(chunk_pool_max_retained_size_mb);
+
+using namespace std;
+
+namespace logtail {
+
+class ChunkPoolBenchmark : public testing::Test {
+public:
+    void TestFixedSizeBuffer();
+    void TestVariableSizeBuffer();
+
+protected:
+    void TearDown() override { INT32_FLAG(chunk_pool_max_retained_size_mb) = 64; }
+
+private:
+    // buffers are filled by the producer thread and released by the consumer thread, as in the pipeline
+    void Run(const vector<uint32_t>& sizes);
+    static uint64_t GetRssMB();
+};
+
+void ChunkPoolBenchmark::Run(const vector<uint32_t>& sizes) {
+    static const size_t kRounds = 200000;
+    // the producer is blocked on a full queue, as inputs are on a full process queue, so that memory stays bounded
+    static const size_t kMaxQueueSize = 64;
+    for (int retainedSizeMB : {0, 64}) {
+        // 0 means chunks are always freed to the heap, i.e., the behavior without the pool
+        INT32_FLAG(chunk_pool_max_retained_size_mb) = retainedSizeMB;
+        SafeQueue<unique_ptr<SourceBuffer>> queue;
+        auto start = chrono::high_resolution_clock::now();
+        thread consumer([&]() {
+            unique_ptr<SourceBuffer> buffer;
+            for (size_t i = 0; i < kRounds;) {
+                if (queue.WaitAndPop(buffer, 100)) {
+                    buffer.reset();
+                    ++i;
+                }
+            }
+        });
+        for (size_t i = 0; i < kRounds; ++i) {
+            auto buffer = make_unique<SourceBuffer>();
+            auto sb = buffer->AllocateStringBuffer(sizes[i % sizes.size()]);
+            sb.data[0] = 'a';
+            while (queue.Size() >= kMaxQueueSize) {
+                this_thread::yield();
+            }
+            queue.Push(std::move(buffer));
+        }
+        consumer.join();
+        auto end = chrono::high_resolution_clock::now();
+        chrono::duration<double> elapsed = end - start;
+        cout << "max retained size: " << retainedSizeMB << "MB, elapsed: " << elapsed.count()
+             << " seconds, rss: " << GetRssMB() << "MB" << endl;
+    }
+}
+
+uint64_t ChunkPoolBenchmark::GetRssMB() {
+    ifstream fin("/proc/self/statm");
+    uint64_t size = 0, rss = 0;
+    fin >> size >> rss;
+    return rss * getpagesize() / 1024 / 1024;
+}
+
+void ChunkPoolBenchmark::TestFixedSizeBuffer() {
+    Run({512 * 1024});
+}
+
+void ChunkPoolBenchmark::TestVariableSizeBuffer() {
+    vector<uint32_t> sizes;
+    mt19937 generator(0);
+    uniform_int_distribution<uint32_t> distribution(4 * 1024, 128 * 1024);
+    for (int i = 0; i < 1000; ++i) {
+        sizes.push_back(distribution(generator));
+    }
+    Run(sizes);
+}
+
+UNIT_TEST_CASE(ChunkPoolBenchmark, TestFixedSizeBuffer)
+UNIT_TEST_CASE(ChunkPoolBenchmark, TestVariableSizeBuffer)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
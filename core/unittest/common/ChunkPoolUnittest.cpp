@@ -0,0 +1,198 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <thread>
+#include <vector>
+
+#include "common/Flags.h"
+#include "common/memory/ChunkPool.h"
+#include "common/memory/SourceBuffer.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(chunk_pool_max_retained_size_mb);
+DECLARE_FLAG_INT32(chunk_pool_thread_cache_size_kb);
+
+using namespace std;
+
+namespace logtail {
+
+class ChunkPoolUnittest : public testing::Test {
+public:
+    void TestSizeClass();
+    void TestReuse();
+    void TestOversizedChunk();
+    void TestMaxRetainedSize();
+    void TestFreeByOtherThread();
+    void TestTrim();
+    void TestBufferAllocator();
+
+protected:
+    void SetUp() override {
+        // chunks retained by previous cases are released, so that each case starts with an empty pool
+        auto* pool = ChunkPool::GetInstance();
+        pool->FlushThreadCache(*ChunkPool::GetThreadCache());
+        pool->Trim();
+    }
+
+    void TearDown() override {
+        INT32_FLAG(chunk_pool_max_retained_size_mb) = 64;
+        INT32_FLAG(chunk_pool_thread_cache_size_kb) = 1024;
+    }
+
+    static size_t SharedChunkCnt(size_t sizeClass) {
+        lock_guard<mutex> lock(ChunkPool::GetInstance()->mMux);
+        return ChunkPool::GetInstance()->mChunks[sizeClass].size();
+    }
+};
+
+void ChunkPoolUnittest::TestSizeClass() {
+    APSARA_TEST_EQUAL(0U, ChunkPool::GetSizeClass(1));
+    APSARA_TEST_EQUAL(0U, ChunkPool::GetSizeClass(1024));
+    APSARA_TEST_EQUAL(1280U, ChunkPool::GetSizeClassSize(ChunkPool::GetSizeClass(1025)));
+    APSARA_TEST_EQUAL(4096U, ChunkPool::GetSizeClassSize(ChunkPool::GetSizeClass(4096)));
+    APSARA_TEST_EQUAL(5120U, ChunkPool::GetSizeClassSize(ChunkPool::GetSizeClass(4097)));
+    APSARA_TEST_EQUAL(640U * 1024, ChunkPool::GetSizeClassSize(ChunkPool::GetSizeClass(512 * 1024 + 8)));
+    APSARA_TEST_EQUAL(ChunkPool::kSizeClassCnt - 1, ChunkPool::GetSizeClass(ChunkPool::kMaxChunkSize));
+    for (size_t i = 0; i < ChunkPool::kSizeClassCnt; ++i) {
+        APSARA_TEST_EQUAL(i, ChunkPool::GetSizeClass(ChunkPool::GetSizeClassSize(i)));
+        if (i > 0) {
+            APSARA_TEST_EQUAL(i, ChunkPool::GetSizeClass(ChunkPool::GetSizeClassSize(i - 1) + 1));
+        }
+    }
+}
+
+void ChunkPoolUnittest::TestReuse() {
+    auto* pool = ChunkPool::GetInstance();
+    size_t capacity = 0;
+    uint8_t* chunk = pool->Allocate(3000, capacity);
+    APSARA_TEST_EQUAL(3072U, capacity);
+    uint64_t retained = pool->GetRetainedBytes();
+    pool->Free(chunk, capacity);
+    APSARA_TEST_EQUAL(retained + capacity, pool->GetRetainedBytes());
+
+    uint64_t hitTotal = pool->GetHitTotal();
+    size_t newCapacity = 0;
+    APSARA_TEST_EQUAL(chunk, pool->Allocate(2900, newCapacity));
+    APSARA_TEST_EQUAL(capacity, newCapacity);
+    APSARA_TEST_EQUAL(hitTotal + 1, pool->GetHitTotal());
+    APSARA_TEST_EQUAL(retained, pool->GetRetainedBytes());
+    pool->Free(chunk, capacity);
+}
+
+void ChunkPoolUnittest::TestOversizedChunk() {
+    auto* pool = ChunkPool::GetInstance();
+    size_t capacity = 0;
+    uint8_t* chunk = pool->Allocate(ChunkPool::kMaxChunkSize + 1, capacity);
+    APSARA_TEST_EQUAL(ChunkPool::kMaxChunkSize + 1, capacity);
+    uint64_t retained = pool->GetRetainedBytes();
+    pool->Free(chunk, capacity);
+    APSARA_TEST_EQUAL(retained, pool->GetRetainedBytes());
+}
+
+void ChunkPoolUnittest::TestMaxRetainedSize() {
+    auto* pool = ChunkPool::GetInstance();
+    INT32_FLAG(chunk_pool_max_retained_size_mb) = 1;
+    vector<pair<uint8_t*, size_t>> chunks(5);
+    for (auto& item : chunks) {
+        item.first = pool->Allocate(256 * 1024, item.second);
+    }
+    for (auto& item : chunks) {
+        pool->Free(item.first, item.second);
+    }
+    // only 4 chunks can be retained
+    APSARA_TEST_EQUAL(4U * 256 * 1024, pool->GetRetainedBytes());
+
+    INT32_FLAG(chunk_pool_max_retained_size_mb) = 0;
+    size_t capacity = 0;
+    uint8_t* chunk = pool->Allocate(64 * 1024, capacity);
+    uint64_t retained = pool->GetRetainedBytes();
+    pool->Free(chunk, capacity);
+    APSARA_TEST_EQUAL(retained, pool->GetRetainedBytes());
+}
+
+void ChunkPoolUnittest::TestFreeByOtherThread() {
+    auto* pool = ChunkPool::GetInstance();
+    INT32_FLAG(chunk_pool_thread_cache_size_kb) = 256;
+    size_t sizeClass = ChunkPool::GetSizeClass(128 * 1024);
+    vector<pair<uint8_t*, size_t>> chunks(4);
+    for (auto& item : chunks) {
+        item.first = pool->Allocate(128 * 1024, item.second);
+    }
+    thread t([&]() {
+        for (auto& item : chunks) {
+            pool->Free(item.first, item.second);
+        }
+        // chunks beyond the thread cache are returned to the shared pool
+        APSARA_TEST_EQUAL(2U, SharedChunkCnt(sizeClass));
+    });
+    t.join();
+    // chunks in the thread cache are returned to the shared pool when the thread exits
+    APSARA_TEST_EQUAL(4U, SharedChunkCnt(sizeClass));
+
+    uint64_t hitTotal = pool->GetHitTotal();
+    for (auto& item : chunks) {
+        item.first = pool->Allocate(128 * 1024, item.second);
+    }
+    APSARA_TEST_EQUAL(hitTotal + 4, pool->GetHitTotal());
+    for (auto& item : chunks) {
+        pool->Free(item.first, item.second);
+    }
+}
+
+void ChunkPoolUnittest::TestTrim() {
+    auto* pool = ChunkPool::GetInstance();
+    INT32_FLAG(chunk_pool_thread_cache_size_kb) = 0;
+    size_t capacity = 0;
+    uint8_t* chunk = pool->Allocate(8192, capacity);
+    pool->Free(chunk, capacity);
+    APSARA_TEST_EQUAL(1U, SharedChunkCnt(ChunkPool::GetSizeClass(8192)));
+    APSARA_TEST_EQUAL(capacity, pool->GetRetainedBytes());
+    pool->Trim();
+    APSARA_TEST_EQUAL(0U, SharedChunkCnt(ChunkPool::GetSizeClass(8192)));
+    APSARA_TEST_EQUAL(0U, pool->GetRetainedBytes());
+}
+
+void ChunkPoolUnittest::TestBufferAllocator() {
+    auto* pool = ChunkPool::GetInstance();
+    uint64_t hitTotal = 0;
+    {
+        BufferAllocator allocator;
+        allocator.Allocate(1000);
+        allocator.Allocate(520 * 1024);
+        hitTotal = pool->GetHitTotal();
+    }
+    {
+        // chunks are returned to the pool when the allocator is destructed
+        BufferAllocator allocator;
+        allocator.Allocate(1000);
+        // the free area of the oversized chunk is used for later allocations
+        auto* mem = static_cast<uint8_t*>(allocator.Allocate(520 * 1024));
+        auto* next = static_cast<uint8_t*>(allocator.Allocate(4000));
+        APSARA_TEST_EQUAL(mem + 520 * 1024, next);
+        APSARA_TEST_EQUAL(hitTotal + 2, pool->GetHitTotal());
+        APSARA_TEST_EQUAL(4096 + 640 * 1024, allocator.TotalAllocated());
+    }
+}
+
+UNIT_TEST_CASE(ChunkPoolUnittest, TestSizeClass)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestReuse)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestOversizedChunk)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestMaxRetainedSize)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestFreeByOtherThread)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestTrim)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestBufferAllocator)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,170 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "boost/regex.hpp"
+
+#include "common/FastRegexMatcher.h"
+#include "common/StringTools.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FastRegexMatcherUnittest : public testing::Test {
+public:
+    void TestCompile() const;
+    void TestMatch() const;
+    void TestConsistentWithBoost() const;
+};
+
+void FastRegexMatcherUnittest::TestCompile() const {
+    {
+        FastRegexMatcher matcher;
+        APSARA_TEST_TRUE(matcher.Compile(R"(^\d{4}-\d{2}-\d{2}.*)"));
+        APSARA_TEST_TRUE(matcher.IsExact());
+        APSARA_TEST_EQUAL(1U, matcher.mBranches.size());
+        APSARA_TEST_EQUAL(6U, matcher.mBranches[0].mAtoms.size());
+    }
+    {
+        FastRegexMatcher matcher;
+        APSARA_TEST_TRUE(matcher.Compile(R"(\s+at\s.*|Caused by:.*|\s+\.\.\.\s\d+ more)"));
+        APSARA_TEST_TRUE(matcher.IsExact());
+        APSARA_TEST_EQUAL(3U, matcher.mBranches.size());
+    }
+    {
+        // only the prefix before the group is compiled
+        FastRegexMatcher matcher;
+        APSARA_TEST_TRUE(matcher.Compile(R"(^\[\d+(INFO|WARN)\].*)"));
+        APSARA_TEST_FALSE(matcher.IsExact());
+        APSARA_TEST_EQUAL(2U, matcher.mBranches[0].mAtoms.size());
+    }
+    {
+        // \d+ is followed by a digit, so greedy matching is not equivalent to backtracking
+        FastRegexMatcher matcher;
+        APSARA_TEST_TRUE(matcher.Compile(R"(\d+1abc)"));
+        APSARA_TEST_FALSE(matcher.IsExact());
+        APSARA_TEST_EQUAL(1U, matcher.mBranches[0].mAtoms.size());
+    }
+    {
+        FastRegexMatcher matcher;
+        APSARA_TEST_FALSE(matcher.Compile(R"((?i)error.*)"));
+        APSARA_TEST_FALSE(matcher.IsCompiled());
+        APSARA_TEST_FALSE(matcher.Compile(R"(\bword)"));
+        APSARA_TEST_FALSE(matcher.Compile(R"([[:digit:]]+)"));
+        APSARA_TEST_FALSE(matcher.Compile(R"(a*?b)"));
+        APSARA_TEST_FALSE(matcher.Compile(R"((a|b)"));
+        // inline flags in the middle of a branch apply to the following branches as well
+        APSARA_TEST_FALSE(matcher.Compile(R"(a(?i)|b)"));
+        APSARA_TEST_FALSE(matcher.Compile(R"(a(?i:b)|c)"));
+        APSARA_TEST_FALSE(matcher.Compile(R"(a(?-s).*|b)"));
+    }
+    {
+        // groups without flags are fine
+        FastRegexMatcher matcher;
+        APSARA_TEST_TRUE(matcher.Compile(R"(a(?:b)|c)"));
+        APSARA_TEST_EQUAL(2U, matcher.mBranches.size());
+    }
+}
+
+void FastRegexMatcherUnittest::TestMatch() const {
+    {
+        FastRegexMatcher matcher;
+        matcher.Compile(R"(^\d{4}-\d{2}-\d{2}.*)");
+        string s = "2024-01-02 12:00:00 INFO hello";
+        APSARA_TEST_EQUAL(FastRegexMatcher::Result::MATCH, matcher.Match(s.data(), s.size()));
+        s = "\tat com.example.Main.main(Main.java:10)";
+        APSARA_TEST_EQUAL(FastRegexMatcher::Result::NOT_MATCH, matcher.Match(s.data(), s.size()));
+        s = "2024-01-0";
+        APSARA_TEST_EQUAL(FastRegexMatcher::Result::NOT_MATCH, matcher.Match(s.data(), s.size()));
+        // non-ascii bytes are left to boost
+        s = "2024-01-0\xe4";
+        APSARA_TEST_EQUAL(FastRegexMatcher::Result::UNKNOWN, matcher.Match(s.data(), s.size()));
+    }
+    {
+        FastRegexMatcher matcher;
+        matcher.Compile(R"(^\[\d+(INFO|WARN)\].*)");
+        string s = "[123WARN] hello";
+        APSARA_TEST_EQUAL(FastRegexMatcher::Result::UNKNOWN, matcher.Match(s.data(), s.size()));
+        s = "123WARN] hello";
+        APSARA_TEST_EQUAL(FastRegexMatcher::Result::NOT_MATCH, matcher.Match(s.data(), s.size()));
+    }
+    {
+        FastRegexMatcher matcher;
+        matcher.Compile(R"([^\]]+\].*|\s+at\s.*)");
+        string s = "\tat com.example.Main.main(Main.java:10)";
+        APSARA_TEST_EQUAL(FastRegexMatcher::Result::MATCH, matcher.Match(s.data(), s.size()));
+        s = "abc] hello";
+        APSARA_TEST_EQUAL(FastRegexMatcher::Result::MATCH, matcher.Match(s.data(), s.size()));
+        s = "abc hello";
+        APSARA_TEST_EQUAL(FastRegexMatcher::Result::NOT_MATCH, matcher.Match(s.data(), s.size()));
+    }
+}
+
+void FastRegexMatcherUnittest::TestConsistentWithBoost() const {
+    vector<string> patterns{R"(^\d{4}-\d{2}-\d{2}.*)",
+                            R"(\[\d+-\d+-\w+:\d+:\d+.*)",
+                            R"(\s+at\s.*|Caused by:.*|\s+\.\.\.\s\d+ more)",
+                            R"(^\[)",
+                            R"([^\s]+\s[^\s]+)",
+                            R"(\w+\s*:\s*\d{1,3}$)",
+                            R"(.*end)",
+                            R"(a?b{2,}[c-e]*x)",
+                            R"(\S+\.\S+)",
+                            R"([]a-]+z)",
+                            R"(\\\d\t)",
+                            R"(^$)"};
+    vector<string> contents{"2024-01-02 12:00:00 INFO hello",
+                            "[2024-01-02 12:00:00] INFO hello",
+                            "\tat com.example.Main.main(Main.java:10)",
+                            "Caused by: java.lang.NullPointerException",
+                            "    ... 23 more",
+                            "key : 123",
+                            "key:1234",
+                            "the end",
+                            "abbbcdex",
+                            "bbx",
+                            "]-a]z",
+                            "\\1\t",
+                            "",
+                            "a\r",
+                            "\xe4\xb8\xad\xe6\x96\x87 end",
+                            "1\xe4",
+                            "x.y"};
+    for (const auto& pattern : patterns) {
+        boost::regex reg(pattern);
+        FastRegexMatcher matcher;
+        matcher.Compile(pattern);
+        for (const auto& content : contents) {
+            auto res = matcher.Match(content.data(), content.size());
+            if (res == FastRegexMatcher::Result::UNKNOWN) {
+                continue;
+            }
+            string exception;
+            bool expected = BoostRegexSearch(content.data(), content.size(), reg, exception);
+            APSARA_TEST_EQUAL_DESC(expected, res == FastRegexMatcher::Result::MATCH, pattern + " " + content);
+        }
+    }
+}
+
+UNIT_TEST_CASE(FastRegexMatcherUnittest, TestCompile)
+UNIT_TEST_CASE(FastRegexMatcherUnittest, TestMatch)
+UNIT_TEST_CASE(FastRegexMatcherUnittest, TestConsistentWithBoost)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
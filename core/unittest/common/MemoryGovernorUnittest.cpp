@@ -0,0 +1,165 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "collection_pipeline/queue/SenderQueueItem.h"
+#include "common/memory/ChunkPool.h"
+#include "common/memory/MemoryGovernor.h"
+#include "common/memory/SourceBuffer.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class MemoryGovernorUnittest : public testing::Test {
+public:
+    void TestMemoryAccount();
+    void TestPressureLevel();
+    void TestNoBudget();
+    void TestThrottle();
+    void TestSourceBufferAccounting();
+    void TestSenderQueueItemAccounting();
+
+protected:
+    void TearDown() override { MemoryGovernor::GetInstance()->SetBudget(0); }
+};
+
+void MemoryGovernorUnittest::TestMemoryAccount() {
+    auto governor = MemoryGovernor::GetInstance();
+    uint64_t base = governor->GetBytes(MemoryCategory::READER_CACHE);
+    uint64_t total = governor->GetTotalBytes();
+    {
+        MemoryAccount account(MemoryCategory::READER_CACHE, 100);
+        APSARA_TEST_EQUAL(base + 100, governor->GetBytes(MemoryCategory::READER_CACHE));
+        account.Update(300);
+        APSARA_TEST_EQUAL(base + 300, governor->GetBytes(MemoryCategory::READER_CACHE));
+        {
+            MemoryAccount copy(account);
+            APSARA_TEST_EQUAL(base + 600, governor->GetBytes(MemoryCategory::READER_CACHE));
+            MemoryAccount other(MemoryCategory::READER_CACHE, 50);
+            other = account;
+            APSARA_TEST_EQUAL(base + 900, governor->GetBytes(MemoryCategory::READER_CACHE));
+            APSARA_TEST_EQUAL(total + 900, governor->GetTotalBytes());
+        }
+        account.Update(0);
+        APSARA_TEST_EQUAL(base, governor->GetBytes(MemoryCategory::READER_CACHE));
+        account.Update(10);
+    }
+    APSARA_TEST_EQUAL(base, governor->GetBytes(MemoryCategory::READER_CACHE));
+    APSARA_TEST_EQUAL(total, governor->GetTotalBytes());
+}
+
+void MemoryGovernorUnittest::TestPressureLevel() {
+    auto governor = MemoryGovernor::GetInstance();
+    // bytes accounted elsewhere, e.g., by static objects, are negligible compared with the budget
+    uint64_t base = governor->GetTotalBytes();
+    APSARA_TEST_TRUE_FATAL(base < 10000);
+    MemoryAccount account(MemoryCategory::READER_CACHE);
+    auto setTotal = [&](uint64_t total) { account.Update(total - base); };
+    governor->SetBudget(100000);
+
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NORMAL, governor->GetLevel());
+    setTotal(59999);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NORMAL, governor->GetLevel());
+    setTotal(60000);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::SOFT, governor->GetLevel());
+    setTotal(80000);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::HARD, governor->GetLevel());
+    APSARA_TEST_TRUE(governor->ShouldFlushEarly());
+    APSARA_TEST_FALSE(governor->ShouldSpill());
+    setTotal(95000);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::CRITICAL, governor->GetLevel());
+    APSARA_TEST_TRUE(governor->ShouldSpill());
+
+    // the level is lowered only when the usage falls below the threshold by 5%
+    setTotal(92000);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::CRITICAL, governor->GetLevel());
+    setTotal(89999);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::HARD, governor->GetLevel());
+    setTotal(20000);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NORMAL, governor->GetLevel());
+
+    // jumps over several levels at once
+    setTotal(200000);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::CRITICAL, governor->GetLevel());
+    // raising the budget lowers the level immediately
+    governor->SetBudget(1000000);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NORMAL, governor->GetLevel());
+}
+
+void MemoryGovernorUnittest::TestNoBudget() {
+    auto governor = MemoryGovernor::GetInstance();
+    MemoryAccount account(MemoryCategory::READER_CACHE, 100);
+    governor->SetBudget(1);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::CRITICAL, governor->GetLevel());
+    governor->SetBudget(0);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NORMAL, governor->GetLevel());
+    account.Update(1000);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::NORMAL, governor->GetLevel());
+}
+
+void MemoryGovernorUnittest::TestThrottle() {
+    auto governor = MemoryGovernor::GetInstance();
+    governor->mLevel = MemoryPressureLevel::NORMAL;
+    APSARA_TEST_FALSE(governor->IsThrottled(0));
+    APSARA_TEST_FALSE(governor->IsThrottled(1));
+    APSARA_TEST_FALSE(governor->IsThrottled(2));
+    governor->mLevel = MemoryPressureLevel::SOFT;
+    APSARA_TEST_FALSE(governor->IsThrottled(0));
+    APSARA_TEST_FALSE(governor->IsThrottled(1));
+    APSARA_TEST_TRUE(governor->IsThrottled(2));
+    governor->mLevel = MemoryPressureLevel::HARD;
+    APSARA_TEST_FALSE(governor->IsThrottled(0));
+    APSARA_TEST_TRUE(governor->IsThrottled(1));
+    governor->mLevel = MemoryPressureLevel::CRITICAL;
+    APSARA_TEST_TRUE(governor->IsThrottled(0));
+    governor->mLevel = MemoryPressureLevel::NORMAL;
+}
+
+void MemoryGovernorUnittest::TestSourceBufferAccounting() {
+    auto governor = MemoryGovernor::GetInstance();
+    uint64_t base = governor->GetBytes(MemoryCategory::SOURCE_BUFFER);
+    {
+        BufferAllocator allocator;
+        allocator.Allocate(10000);
+        APSARA_TEST_EQUAL(base + allocator.TotalAllocated(), governor->GetBytes(MemoryCategory::SOURCE_BUFFER));
+    }
+    // chunks retained by the pool are not accounted
+    APSARA_TEST_EQUAL(base, governor->GetBytes(MemoryCategory::SOURCE_BUFFER));
+}
+
+void MemoryGovernorUnittest::TestSenderQueueItemAccounting() {
+    auto governor = MemoryGovernor::GetInstance();
+    uint64_t base = governor->GetBytes(MemoryCategory::SENDER_QUEUE);
+    {
+        auto item = make_unique<SenderQueueItem>(string(1000, 'a'), 2000, nullptr, 0);
+        APSARA_TEST_EQUAL(base + 1000, governor->GetBytes(MemoryCategory::SENDER_QUEUE));
+        unique_ptr<SenderQueueItem> clone(item->Clone());
+        APSARA_TEST_EQUAL(base + 2000, governor->GetBytes(MemoryCategory::SENDER_QUEUE));
+    }
+    APSARA_TEST_EQUAL(base, governor->GetBytes(MemoryCategory::SENDER_QUEUE));
+}
+
+UNIT_TEST_CASE(MemoryGovernorUnittest, TestMemoryAccount)
+UNIT_TEST_CASE(MemoryGovernorUnittest, TestPressureLevel)
+UNIT_TEST_CASE(MemoryGovernorUnittest, TestNoBudget)
+UNIT_TEST_CASE(MemoryGovernorUnittest, TestThrottle)
+UNIT_TEST_CASE(MemoryGovernorUnittest, TestSourceBufferAccounting)
+UNIT_TEST_CASE(MemoryGovernorUnittest, TestSenderQueueItemAccounting)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,141 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "common/TimeFormatParser.h"
+#include "common/TimeUtil.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class TimeFormatParserUnittest : public testing::Test {
+public:
+    void TestCompile() const;
+    void TestParse() const;
+    void TestConsistentWithStrptime() const;
+    void TestDaysFromCivil() const;
+};
+
+void TimeFormatParserUnittest::TestCompile() const {
+    TimeFormatParser parser;
+    APSARA_TEST_TRUE(parser.Compile("%Y-%m-%d %H:%M:%S"));
+    APSARA_TEST_EQUAL(11U, parser.mFields.size());
+    APSARA_TEST_TRUE(parser.Compile("%F %T.%f"));
+    APSARA_TEST_EQUAL(13U, parser.mFields.size());
+    APSARA_TEST_TRUE(parser.Compile("%s"));
+    APSARA_TEST_TRUE(parser.mIsTimestamp);
+    APSARA_TEST_TRUE(parser.Compile("%b %d %H:%M:%S", 2024));
+
+    // no year and no specified year
+    APSARA_TEST_FALSE(parser.Compile("%b %d %H:%M:%S"));
+    APSARA_TEST_FALSE(parser.Compile("%b %d %H:%M:%S", 0));
+    APSARA_TEST_FALSE(parser.IsCompiled());
+    // unsupported conversions
+    APSARA_TEST_FALSE(parser.Compile("%Y-%j"));
+    APSARA_TEST_FALSE(parser.Compile("%Y-%m-%d %I:%M:%S %p"));
+    APSARA_TEST_FALSE(parser.Compile("%Y-%m-%d %Z"));
+    APSARA_TEST_FALSE(parser.Compile("%Y-%m-%d %"));
+    APSARA_TEST_FALSE(parser.Compile("%f"));
+}
+
+void TimeFormatParserUnittest::TestParse() const {
+    TimeFormatParser::Cache cache;
+    LogtailTime logTime = {0, 0};
+    int nanosecondLength = -1;
+    {
+        TimeFormatParser parser;
+        parser.Compile("%Y-%m-%dT%H:%M:%S.%f%z");
+        APSARA_TEST_TRUE(parser.Parse("2017-01-11T15:05:07.012999999Z", logTime, nanosecondLength, cache));
+        APSARA_TEST_EQUAL(12999999, logTime.tv_nsec);
+        APSARA_TEST_EQUAL(9, nanosecondLength);
+        APSARA_TEST_TRUE(parser.Parse("2017-01-11T15:05:07.012+08:00", logTime, nanosecondLength, cache));
+        APSARA_TEST_EQUAL(12000000, logTime.tv_nsec);
+        APSARA_TEST_EQUAL(3, nanosecondLength);
+        // not zero padded
+        APSARA_TEST_FALSE(parser.Parse("2017-1-11T15:05:07.012Z", logTime, nanosecondLength, cache));
+        // out of range
+        APSARA_TEST_FALSE(parser.Parse("2017-13-11T15:05:07.012Z", logTime, nanosecondLength, cache));
+        // leap second
+        APSARA_TEST_FALSE(parser.Parse("2016-12-31T23:59:60.000Z", logTime, nanosecondLength, cache));
+        // named time zone
+        APSARA_TEST_FALSE(parser.Parse("2017-01-11T15:05:07.012 MST", logTime, nanosecondLength, cache));
+    }
+    {
+        TimeFormatParser parser;
+        parser.Compile("%s");
+        APSARA_TEST_TRUE(parser.Parse("1484147107", logTime, nanosecondLength, cache));
+        APSARA_TEST_EQUAL(1484147107, logTime.tv_sec);
+        APSARA_TEST_EQUAL(0, logTime.tv_nsec);
+        APSARA_TEST_EQUAL(0, nanosecondLength);
+        APSARA_TEST_TRUE(parser.Parse("1484147107123", logTime, nanosecondLength, cache));
+        APSARA_TEST_EQUAL(1484147107, logTime.tv_sec);
+        APSARA_TEST_EQUAL(123000000, logTime.tv_nsec);
+        APSARA_TEST_EQUAL(3, nanosecondLength);
+        APSARA_TEST_FALSE(parser.Parse("148414710", logTime, nanosecondLength, cache));
+    }
+}
+
+void TimeFormatParserUnittest::TestConsistentWithStrptime() const {
+    struct Case {
+        string mFormat;
+        int32_t mSpecifiedYear;
+        vector<string> mInputs;
+    };
+    vector<Case> cases{
+        {"%Y-%m-%d %H:%M:%S",
+         -1,
+         {"2024-02-29 23:59:59", "2024-01-01 00:00:00", "1999-12-31 12:30:45 extra", "2024-03-10 02:30:00"}},
+        {"%Y-%m-%d %H:%M:%S.%f", -1, {"2024-04-08 12:48:59.665", "2024-04-08 12:48:59.1", "2024-04-08 12:48:59.000000001"}},
+        {"[%Y-%m-%d %H:%M:%S.%f]", -1, {"[2024-04-08 12:48:59.665663]", "[2024-11-03 01:30:00.5]"}},
+        {"%d/%b/%Y:%H:%M:%S %z", -1, {"10/Oct/2023:13:55:36 +0800", "01/january/2023:00:00:00 -07:00"}},
+        {"%A, %d %b %y %H:%M", -1, {"Tuesday, 11 Jan 17 15:05", "tue, 31 Dec 69 23:59"}},
+        {"%b %d %H:%M:%S", 2023, {"Oct 10 13:55:36", "Feb 29 00:00:00"}},
+        {"%Y%m%d%H%M%S", -1, {"20240408124859"}},
+        {"%s", -1, {"1712551739", "1712551739665663286"}},
+    };
+    for (const auto& c : cases) {
+        TimeFormatParser parser;
+        APSARA_TEST_TRUE_DESC(parser.Compile(c.mFormat, c.mSpecifiedYear), c.mFormat);
+        TimeFormatParser::Cache cache;
+        for (const auto& input : c.mInputs) {
+            LogtailTime expected = {0, 0}, actual = {0, 0};
+            int expectedLength = -1, actualLength = -1;
+            APSARA_TEST_TRUE(Strptime(input.c_str(), c.mFormat.c_str(), &expected, expectedLength, c.mSpecifiedYear));
+            APSARA_TEST_TRUE_DESC(parser.Parse(input, actual, actualLength, cache), input);
+            APSARA_TEST_EQUAL_DESC(expected.tv_sec, actual.tv_sec, input);
+            APSARA_TEST_EQUAL_DESC(expected.tv_nsec, actual.tv_nsec, input);
+            APSARA_TEST_EQUAL_DESC(expectedLength, actualLength, input);
+        }
+    }
+}
+
+void TimeFormatParserUnittest::TestDaysFromCivil() const {
+    APSARA_TEST_EQUAL(0, TimeFormatParser::DaysFromCivil(1970, 1, 1));
+    APSARA_TEST_EQUAL(19821, TimeFormatParser::DaysFromCivil(2024, 4, 8));
+    APSARA_TEST_EQUAL(-1, TimeFormatParser::DaysFromCivil(1970, 1, 0));
+    APSARA_TEST_EQUAL(TimeFormatParser::DaysFromCivil(2023, 3, 1), TimeFormatParser::DaysFromCivil(2023, 2, 29));
+}
+
+UNIT_TEST_CASE(TimeFormatParserUnittest, TestCompile)
+UNIT_TEST_CASE(TimeFormatParserUnittest, TestParse)
+UNIT_TEST_CASE(TimeFormatParserUnittest, TestConsistentWithStrptime)
+UNIT_TEST_CASE(TimeFormatParserUnittest, TestDaysFromCivil)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
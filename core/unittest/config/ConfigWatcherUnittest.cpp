@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 
@@ -38,6 +39,7 @@ public:
     void IgnoreNewLowerPrioritySingletonConfig() const;
     void IgnoreModifiedLowerPrioritySingletonConfig() const;
     void HigherPriorityOverrideLowerPrioritySingletonConfig() const;
+    void SkipParsingUnchangedContent() const;
 
 protected:
     static void SetUpTestCase() {
@@ -428,12 +430,53 @@ void ConfigWatcherUnittest::HigherPriorityOverrideLowerPrioritySingletonConfig()
     filesystem::remove_all("continuous_pipeline_config");
 }
 
+void ConfigWatcherUnittest::SkipParsingUnchangedContent() const {
+    filesystem::create_directories(configDir);
+    const filesystem::path configPath = configDir / "config.json";
+    size_t builtinPipelineCnt = 0;
+#ifdef __ENTERPRISE__
+    builtinPipelineCnt += EnterpriseConfigProvider::GetInstance()->GetAllBuiltInPipelineConfigs().size();
+#endif
+    {
+        // no flusher
+        ofstream fout(configPath);
+        fout << R"({"inputs": [{"Type": "input_mock"}]})";
+    }
+    auto diff = PipelineConfigWatcher::GetInstance()->CheckConfigDiff();
+    APSARA_TEST_EQUAL(0U + builtinPipelineCnt, diff.first.mAdded.size());
+    auto& fileInfo = PipelineConfigWatcher::GetInstance()->mFileInfoMap[configPath.string()];
+    APSARA_TEST_TRUE(fileInfo.mIsInvalid);
+    int64_t contentHash = fileInfo.mContentHash;
+
+    // only mtime is changed
+    filesystem::last_write_time(configPath, filesystem::last_write_time(configPath) + chrono::seconds(1));
+    diff = PipelineConfigWatcher::GetInstance()->CheckConfigDiff();
+    APSARA_TEST_FALSE(diff.first.HasDiff());
+    APSARA_TEST_EQUAL(filesystem::last_write_time(configPath), fileInfo.mMTime);
+    APSARA_TEST_EQUAL(contentHash, fileInfo.mContentHash);
+    APSARA_TEST_TRUE(fileInfo.mIsInvalid);
+
+    // content is changed
+    {
+        ofstream fout(configPath);
+        fout << R"({"inputs": [{"Type": "input_mock"}], "flushers": [{"Type": "flusher_mock"}]})";
+    }
+    filesystem::last_write_time(configPath, fileInfo.mMTime + chrono::seconds(1));
+    diff = PipelineConfigWatcher::GetInstance()->CheckConfigDiff();
+    APSARA_TEST_EQUAL(1U, diff.first.mAdded.size());
+    APSARA_TEST_NOT_EQUAL(contentHash, fileInfo.mContentHash);
+    APSARA_TEST_FALSE(fileInfo.mIsInvalid);
+
+    filesystem::remove_all(configDir);
+}
+
 UNIT_TEST_CASE(ConfigWatcherUnittest, InvalidConfigDirFound)
 UNIT_TEST_CASE(ConfigWatcherUnittest, InvalidConfigFileFound)
 UNIT_TEST_CASE(ConfigWatcherUnittest, DuplicateConfigs)
 UNIT_TEST_CASE(ConfigWatcherUnittest, IgnoreNewLowerPrioritySingletonConfig)
 UNIT_TEST_CASE(ConfigWatcherUnittest, IgnoreModifiedLowerPrioritySingletonConfig)
 UNIT_TEST_CASE(ConfigWatcherUnittest, HigherPriorityOverrideLowerPrioritySingletonConfig)
+UNIT_TEST_CASE(ConfigWatcherUnittest, SkipParsingUnchangedContent)
 
 } // namespace logtail
 
@@ -0,0 +1,155 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/HashUtil.h"
+#include "ebpf/util/AggregateTree.h"
+#include "ebpf/util/FlatAggregateTree.h"
+#include "unittest/Unittest.h"
+
+namespace logtail {
+namespace ebpf {
+
+struct BenchMetric {
+    uint64_t mCount = 0;
+    uint64_t mErrCount = 0;
+    double mSum = 0;
+};
+
+struct BenchRecord {
+    std::array<size_t, 2> mKeys;
+    bool mError = false;
+    double mLatency = 0;
+};
+
+struct BenchAggregate {
+    void operator()(std::unique_ptr<BenchMetric>& base, const BenchRecord* other) const {
+        base->mCount++;
+        base->mErrCount += other->mError;
+        base->mSum += other->mLatency;
+    }
+};
+
+struct BenchBuild {
+    std::unique_ptr<BenchMetric> operator()(const BenchRecord*, std::shared_ptr<SourceBuffer>&) const {
+        return std::make_unique<BenchMetric>();
+    }
+};
+
+class AggregatorBenchmark : public testing::Test {
+public:
+    void TestAppMetricCardinality();
+    void TestHighCardinality();
+
+private:
+    // records of apps * seriesPerApp series, the same shape as the app metric keys of the network observer
+    static std::vector<BenchRecord> GenerateRecords(size_t apps, size_t seriesPerApp, size_t count);
+    static void
+    Run(const std::vector<BenchRecord>& records, size_t maxNodes, bool underLimit, const std::string& name);
+};
+
+std::vector<BenchRecord> AggregatorBenchmark::GenerateRecords(size_t apps, size_t seriesPerApp, size_t count) {
+    std::hash<std::string> hasher;
+    std::vector<std::array<size_t, 2>> keys;
+    for (size_t app = 0; app < apps; ++app) {
+        size_t appKey = 0;
+        AttrHashCombine(appKey, hasher("host-" + std::to_string(app % 4)));
+        AttrHashCombine(appKey, hasher("app-" + std::to_string(app)));
+        for (size_t series = 0; series < seriesPerApp; ++series) {
+            size_t seriesKey = 0;
+            AttrHashCombine(seriesKey, hasher("workload-" + std::to_string(series % 20)));
+            AttrHashCombine(seriesKey, hasher("/api/v1/resource/" + std::to_string(series)));
+            keys.push_back({appKey, seriesKey});
+        }
+    }
+    // a few hot series take most of the traffic
+    std::mt19937 gen(42);
+    std::geometric_distribution<size_t> dist(4.0 / keys.size());
+    std::vector<BenchRecord> records(count);
+    for (auto& record : records) {
+        record.mKeys = keys[dist(gen) % keys.size()];
+        record.mError = gen() % 100 == 0;
+        record.mLatency = 0.001 * (gen() % 100);
+    }
+    return records;
+}
+
+void AggregatorBenchmark::Run(const std::vector<BenchRecord>& records,
+                              size_t maxNodes,
+                              bool underLimit,
+                              const std::string& name) {
+    // each round is one aggregate interval, consumed by GetAndReset
+    const size_t kRounds = 20;
+    uint64_t treeCount = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    SIZETAggTreeWithSourceBuffer<BenchMetric, const BenchRecord*> tree(maxNodes, BenchAggregate(), BenchBuild());
+    for (size_t round = 0; round < kRounds; ++round) {
+        for (const auto& record : records) {
+            tree.Aggregate(&record, record.mKeys);
+        }
+        auto snapshot = tree.GetAndReset();
+        for (auto* node : snapshot.GetNodesWithAggDepth(1)) {
+            snapshot.ForEach(node, [&](const BenchMetric* data) { treeCount += data->mCount; });
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> treeElapsed = end - start;
+
+    uint64_t flatCount = 0;
+    start = std::chrono::high_resolution_clock::now();
+    FlatAggTree<BenchMetric, const BenchRecord*, 2, BenchAggregate, BenchBuild, true> flat(maxNodes);
+    for (size_t round = 0; round < kRounds; ++round) {
+        for (const auto& record : records) {
+            flat.Aggregate(&record, record.mKeys);
+        }
+        auto snapshot = flat.GetAndReset();
+        for (const auto& group : snapshot->Groups()) {
+            snapshot->ForEach(group, [&](const BenchMetric* data) { flatCount += data->mCount; });
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> flatElapsed = end - start;
+
+    if (underLimit) {
+        APSARA_TEST_EQUAL(treeCount, flatCount);
+    }
+    size_t events = kRounds * records.size();
+    std::cout << "[" << name << "] tree: " << treeElapsed.count() * 1e9 / events
+              << " ns per event, flat: " << flatElapsed.count() * 1e9 / events << " ns per event" << std::endl;
+}
+
+void AggregatorBenchmark::TestAppMetricCardinality() {
+    Run(GenerateRecords(16, 300, 200000), 10240, true, "16 apps * 300 series");
+}
+
+void AggregatorBenchmark::TestHighCardinality() {
+    // more series than the limit, the trees may drop different series once they are full
+    Run(GenerateRecords(64, 500, 200000), 10240, false, "64 apps * 500 series");
+}
+
+UNIT_TEST_CASE(AggregatorBenchmark, TestAppMetricCardinality)
+UNIT_TEST_CASE(AggregatorBenchmark, TestHighCardinality)
+
+} // namespace ebpf
+} // namespace logtail
+
+UNIT_TEST_MAIN
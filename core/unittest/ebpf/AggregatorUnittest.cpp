@@ -24,6 +24,7 @@
 #include "ebpf/type/FileEvent.h"
 #include "ebpf/type/NetworkEvent.h"
 #include "ebpf/util/AggregateTree.h"
+#include "ebpf/util/FlatAggregateTree.h"
 #include "logger/Logger.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
@@ -52,6 +53,9 @@ public:
     void TestGetAndReset();
     void TestAggManager();
     void TestAggregator();
+    void TestFlatAgg();
+    void TestFlatAggMaxNodes();
+    void TestFlatGetAndReset();
 
 protected:
     void SetUp() override {
@@ -108,6 +112,24 @@ private:
     std::unique_ptr<SIZETAggTree<NetworkEventGroup, std::shared_ptr<NetworkEvent>>> mNetAggregateTree;
 };
 
+struct FlatCount {
+    explicit FlatCount(std::shared_ptr<SourceBuffer> sourceBuffer) : mSourceBuffer(std::move(sourceBuffer)) {}
+    std::shared_ptr<SourceBuffer> mSourceBuffer;
+    int mVal = 0;
+};
+
+struct FlatCountAggregate {
+    void operator()(std::unique_ptr<FlatCount>& base, const int& other) const { base->mVal += other; }
+};
+
+struct FlatCountBuild {
+    std::unique_ptr<FlatCount> operator()(const int&, std::shared_ptr<SourceBuffer>& sourceBuffer) const {
+        return std::make_unique<FlatCount>(sourceBuffer);
+    }
+};
+
+using FlatCountTree = FlatAggTree<FlatCount, int, 2, FlatCountAggregate, FlatCountBuild, true>;
+
 std::array<size_t, 2> GenerateAggKey(const std::shared_ptr<FileEvent> event) {
     std::array<size_t, 2> hash_result;
     hash_result.fill(0UL);
@@ -246,9 +268,107 @@ void AggregatorUnittest::TestGetAndReset() {
     APSARA_TEST_EQUAL(GetSum(newTree), 5);
 }
 
+void AggregatorUnittest::TestFlatAgg() {
+    FlatCountTree tree(100);
+    APSARA_TEST_TRUE(tree.Aggregate(1, {1, 1}));
+    APSARA_TEST_TRUE(tree.Aggregate(2, {1, 2}));
+    APSARA_TEST_TRUE(tree.Aggregate(3, {1, 1}));
+    APSARA_TEST_TRUE(tree.Aggregate(4, {2, 1}));
+    APSARA_TEST_TRUE(tree.Aggregate(5, {2, 2}));
+    APSARA_TEST_EQUAL(tree.NodeCount(), 6UL);
+    APSARA_TEST_EQUAL(tree.EventCount(), 5UL);
+
+    auto snapshot = tree.GetAndReset();
+    APSARA_TEST_EQUAL(tree.NodeCount(), 0UL);
+    APSARA_TEST_EQUAL(snapshot->NodeCount(), 6UL);
+    const auto& groups = snapshot->Groups();
+    APSARA_TEST_EQUAL(groups.size(), 2UL);
+    APSARA_TEST_EQUAL(groups[0].mKey, 1UL);
+    APSARA_TEST_EQUAL(groups[0].mSize, 2U);
+    APSARA_TEST_EQUAL(groups[1].mKey, 2UL);
+    APSARA_TEST_EQUAL(groups[1].mSize, 2U);
+    APSARA_TEST_TRUE(groups[0].mSourceBuffer != nullptr);
+    APSARA_TEST_TRUE(groups[0].mSourceBuffer != groups[1].mSourceBuffer);
+
+    std::vector<int> vals;
+    snapshot->ForEach(groups[0], [&](const FlatCount* data) {
+        APSARA_TEST_EQUAL(data->mSourceBuffer, groups[0].mSourceBuffer);
+        vals.push_back(data->mVal);
+    });
+    APSARA_TEST_EQUAL(vals, std::vector<int>({4, 2}));
+    vals.clear();
+    snapshot->ForEach(groups[1], [&](const FlatCount* data) { vals.push_back(data->mVal); });
+    APSARA_TEST_EQUAL(vals, std::vector<int>({4, 5}));
+
+    // grow the tables past several rehashes
+    FlatCountTree large(2000);
+    for (size_t i = 0; i < 1000; ++i) {
+        APSARA_TEST_TRUE(large.Aggregate(1, {i % 10, i}));
+        APSARA_TEST_TRUE(large.Aggregate(1, {i % 10, i}));
+    }
+    APSARA_TEST_EQUAL(large.NodeCount(), 1010UL);
+    int sum = 0;
+    size_t count = 0;
+    large.ForEach([&](const FlatCount* data) {
+        sum += data->mVal;
+        ++count;
+    });
+    APSARA_TEST_EQUAL(sum, 2000);
+    APSARA_TEST_EQUAL(count, 1000UL);
+}
+
+void AggregatorUnittest::TestFlatAggMaxNodes() {
+    FlatCountTree tree(5);
+    APSARA_TEST_TRUE(tree.Aggregate(1, {1, 1}));
+    APSARA_TEST_TRUE(tree.Aggregate(1, {1, 2}));
+    APSARA_TEST_TRUE(tree.Aggregate(1, {1, 3}));
+    APSARA_TEST_TRUE(tree.Aggregate(1, {1, 4}));
+    APSARA_TEST_EQUAL(tree.NodeCount(), 5UL);
+    // a new group needs 2 nodes, a new entry 1, existing entries are always aggregated
+    APSARA_TEST_FALSE(tree.Aggregate(1, {2, 1}));
+    APSARA_TEST_FALSE(tree.Aggregate(1, {1, 5}));
+    APSARA_TEST_TRUE(tree.Aggregate(1, {1, 1}));
+    APSARA_TEST_EQUAL(tree.NodeCount(), 5UL);
+    APSARA_TEST_EQUAL(tree.EventCount(), 5UL);
+    tree.Reset();
+    APSARA_TEST_EQUAL(tree.NodeCount(), 0UL);
+    APSARA_TEST_TRUE(tree.Aggregate(1, {2, 1}));
+}
+
+void AggregatorUnittest::TestFlatGetAndReset() {
+    FlatCountTree tree(100);
+    std::weak_ptr<SourceBuffer> weakBuffer;
+    FlatCountTree::Arena* first = nullptr;
+    {
+        APSARA_TEST_TRUE(tree.Aggregate(1, {1, 1}));
+        auto snapshot = tree.GetAndReset();
+        first = snapshot.get();
+        weakBuffer = snapshot->Groups()[0].mSourceBuffer;
+        APSARA_TEST_FALSE(weakBuffer.expired());
+    }
+    // the dropped snapshot is cleared and becomes the spare arena
+    APSARA_TEST_TRUE(weakBuffer.expired());
+    APSARA_TEST_TRUE(tree.Aggregate(1, {1, 1}));
+    {
+        auto snapshot = tree.GetAndReset();
+        APSARA_TEST_TRUE(snapshot.get() != first);
+        APSARA_TEST_EQUAL(snapshot->EventCount(), 1UL);
+    }
+    APSARA_TEST_TRUE(tree.Aggregate(2, {1, 1}));
+    auto snapshot = tree.GetAndReset();
+    APSARA_TEST_EQUAL(snapshot.get(), first);
+    APSARA_TEST_EQUAL(snapshot->Groups().size(), 1UL);
+    int sum = 0;
+    snapshot->ForEach([&](const FlatCount* data) { sum += data->mVal; });
+    APSARA_TEST_EQUAL(sum, 2);
+}
+
 UNIT_TEST_CASE(AggregatorUnittest, TestBasicAgg);
 UNIT_TEST_CASE(AggregatorUnittest, TestGetAndReset);
 UNIT_TEST_CASE(AggregatorUnittest, TestAggregator);
+UNIT_TEST_CASE(AggregatorUnittest, TestFlatAgg);
+UNIT_TEST_CASE(AggregatorUnittest, TestFlatAggMaxNodes);
+UNIT_TEST_CASE(AggregatorUnittest, TestFlatGetAndReset);
 
 
 } // namespace ebpf
@@ -0,0 +1,163 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ebpf/protocol/http/HttpParser.h"
+#include "unittest/Unittest.h"
+
+namespace logtail {
+namespace ebpf {
+
+// request and response pairs in the form they are captured by the kernel probes
+const std::vector<std::pair<std::string, std::string>> kSamples = {
+    {"GET /api/v1/users/10086?fields=name,email HTTP/1.1\r\n"
+     "Host: user-service.default.svc.cluster.local:8080\r\n"
+     "User-Agent: Go-http-client/1.1\r\n"
+     "Accept: application/json\r\n"
+     "X-Request-Id: 5f1e7b2c-3d4a-4b6e-9c8d-0a1b2c3d4e5f\r\n"
+     "Accept-Encoding: gzip\r\n"
+     "\r\n",
+     "HTTP/1.1 200 OK\r\n"
+     "Content-Type: application/json\r\n"
+     "Date: Mon, 19 Oct 2026 08:00:00 GMT\r\n"
+     "Content-Length: 52\r\n"
+     "\r\n"
+     "{\"id\":10086,\"name\":\"loongcollector\",\"email\":\"a@b.c\"}"},
+    {"POST /api/v1/orders HTTP/1.1\r\n"
+     "Host: order-service:8080\r\n"
+     "Content-Type: application/json\r\n"
+     "Content-Length: 37\r\n"
+     "traceparent: 00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01\r\n"
+     "\r\n"
+     "{\"item\":\"book\",\"count\":2,\"price\":9.9}",
+     "HTTP/1.1 201 Created\r\n"
+     "Content-Type: application/json\r\n"
+     "Location: /api/v1/orders/123\r\n"
+     "Content-Length: 11\r\n"
+     "\r\n"
+     "{\"id\":123}\n"},
+    {"GET /static/js/app.3f2a1b.js HTTP/1.1\r\n"
+     "Host: www.example.com\r\n"
+     "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0 Safari/537.36\r\n"
+     "Accept: */*\r\n"
+     "Referer: https://www.example.com/\r\n"
+     "Cookie: session=abc123; theme=dark\r\n"
+     "\r\n",
+     "HTTP/1.1 304 Not Modified\r\n"
+     "ETag: \"3f2a1b\"\r\n"
+     "Cache-Control: max-age=3600\r\n"
+     "\r\n"},
+    {"GET /api/v1/inventory?sku=42 HTTP/1.1\r\n"
+     "Host: inventory-service:8080\r\n"
+     "Accept: application/json\r\n"
+     "\r\n",
+     "HTTP/1.1 503 Service Unavailable\r\n"
+     "Content-Type: text/plain\r\n"
+     "Transfer-Encoding: chunked\r\n"
+     "Retry-After: 5\r\n"
+     "\r\n"
+     "13\r\n"
+     "upstream overloaded\r\n"
+     "1B\r\n"
+     ", retry after a few seconds\r\n"
+     "0\r\n"
+     "\r\n"},
+};
+
+class HttpParserBenchmark : public testing::Test {
+public:
+    void TestReplayUnsampled();
+    void TestReplaySampled();
+
+protected:
+    void SetUp() override {
+        for (const auto& sample : kSamples) {
+            std::string msg = sample.first + sample.second;
+            auto* evt = static_cast<conn_data_event_t*>(malloc(offsetof(conn_data_event_t, msg) + msg.size()));
+            memset(evt, 0, offsetof(conn_data_event_t, msg));
+            memcpy(evt->msg, msg.data(), msg.size());
+            evt->protocol = support_proto_e::ProtoHTTP;
+            evt->role = support_role_e::IsServer;
+            evt->request_len = sample.first.size();
+            evt->response_len = sample.second.size();
+            evt->start_ts = 1000000;
+            evt->end_ts = 3000000;
+            mEvents.push_back(evt);
+        }
+    }
+    void TearDown() override {
+        for (auto* evt : mEvents) {
+            free(evt);
+        }
+        mEvents.clear();
+    }
+
+private:
+    void Replay(double sampleRate, const std::string& name);
+
+    std::vector<conn_data_event_t*> mEvents;
+};
+
+void HttpParserBenchmark::Replay(double sampleRate, const std::string& name) {
+    ObserverNetworkOption options;
+    options.mL7Config.mSampleRate = sampleRate;
+    auto appDetail = std::make_shared<AppDetail>(&options, nullptr);
+    auto conn = std::make_shared<Connection>(ConnId(1, 1000, 123456));
+    HTTPProtocolParser parser;
+
+    // records are held by the span/event generate queue for a while before being released
+    const size_t kInflightRecords = 1024;
+    const size_t kEventCount = 1000000;
+    std::deque<std::shared_ptr<L7Record>> inflight;
+    size_t recordCount = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < kEventCount; ++i) {
+        auto records = parser.Parse(mEvents[i % mEvents.size()], conn, appDetail, nullptr);
+        recordCount += records.size();
+        for (auto& record : records) {
+            inflight.emplace_back(std::move(record));
+        }
+        while (inflight.size() > kInflightRecords) {
+            inflight.pop_front();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    APSARA_TEST_EQUAL(recordCount, kEventCount);
+    std::cout << "[" << name << "] elapsed: " << elapsed.count() << " seconds, "
+              << elapsed.count() * 1e9 / kEventCount << " ns per event" << std::endl;
+}
+
+void HttpParserBenchmark::TestReplayUnsampled() {
+    Replay(0, "unsampled");
+}
+
+void HttpParserBenchmark::TestReplaySampled() {
+    Replay(1, "sampled");
+}
+
+UNIT_TEST_CASE(HttpParserBenchmark, TestReplayUnsampled)
+UNIT_TEST_CASE(HttpParserBenchmark, TestReplaySampled)
+
+} // namespace ebpf
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -120,7 +120,7 @@ void NetworkObserverEventUnittest::TestHeadersMap() {
     auto range = headers.equal_range("content-type");
     std::vector<std::string> values;
     for (auto it = range.first; it != range.second; ++it) {
-        values.push_back(it->second);
+        values.emplace_back(it->second);
     }
 
     APSARA_TEST_EQUAL(values.size(), 2UL);
@@ -248,11 +248,11 @@ void NetworkObserverEventUnittest::TestHeadersMapCaseInsensitive() {
     // 测试大小写不敏感的键查找
     auto res = headers.find("content-type");
     APSARA_TEST_NOT_EQUAL(res, headers.end());
-    APSARA_TEST_STREQ(res->second.c_str(), "application/json");
+    APSARA_TEST_EQUAL(res->second, "application/json");
 
     res = headers.find("CONTENT-TYPE");
     APSARA_TEST_NOT_EQUAL(res, headers.end());
-    APSARA_TEST_STREQ(res->second.c_str(), "application/json");
+    APSARA_TEST_EQUAL(res->second, "application/json");
 
     // 测试多值插入
     headers.insert({"Accept", "text/plain"});
@@ -36,6 +36,9 @@ public:
     void TestParsePartialRequests();
     void TestProtocolParserManager();
     void TestHttpParserEdgeCases();
+    void TestHeadersOutliveDataEvent();
+    void TestParseChunkedInPlace();
+    void TestRecordPool();
 
     void RequestBenchmark();
     void RequestWithoutBodyBenchmark();
@@ -249,6 +252,120 @@ void ProtocolParserUnittest::TestHttpParserEdgeCases() {
     APSARA_TEST_EQUAL(state, ParseState::kInvalid);
 }
 
+void ProtocolParserUnittest::TestHeadersOutliveDataEvent() {
+    std::string input = "POST /test?id=1 HTTP/1.0\r\n"
+                        "Host: example.com\r\n"
+                        "Content-Type: application/json\r\n"
+                        "Content-Length: 4\r\n"
+                        "\r\n"
+                        "body";
+    std::string_view buf(input);
+    std::shared_ptr<HttpRecord> result = std::make_shared<HttpRecord>(nullptr, nullptr);
+    ParseState state = http::ParseRequest(buf, result, true);
+    APSARA_TEST_EQUAL(state, ParseState::kSuccess);
+    // the buffer of the data event is reused by the poller after parsing
+    input.assign(input.size(), 'x');
+
+    APSARA_TEST_EQUAL(result->GetPath(), "/test");
+    APSARA_TEST_EQUAL(result->GetMethod(), "POST");
+    APSARA_TEST_EQUAL(result->GetProtocolVersion(), "http1.0");
+    APSARA_TEST_EQUAL(result->GetReqBody(), "body");
+    APSARA_TEST_EQUAL(result->GetReqHeaderMap().size(), 3UL);
+    auto host = result->GetReqHeaderMap().find("host");
+    APSARA_TEST_NOT_EQUAL(host, result->GetReqHeaderMap().end());
+    APSARA_TEST_EQUAL(host->second, "example.com");
+    auto contentType = result->GetReqHeaderMap().find("content-type");
+    APSARA_TEST_NOT_EQUAL(contentType, result->GetReqHeaderMap().end());
+    APSARA_TEST_EQUAL(contentType->second, "application/json");
+
+    const std::string invalidLength = "POST /test HTTP/1.1\r\n"
+                                      "Content-Length: 4x\r\n"
+                                      "\r\n"
+                                      "body";
+    std::string_view buf2(invalidLength);
+    result = std::make_shared<HttpRecord>(nullptr, nullptr);
+    state = http::ParseRequest(buf2, result, true);
+    APSARA_TEST_EQUAL(state, ParseState::kInvalid);
+}
+
+void ProtocolParserUnittest::TestParseChunkedInPlace() {
+    const std::string input = "4;ext=1\r\n"
+                              "Wiki\r\n"
+                              "A\r\n"
+                              "pedia in\r\n\r\n"
+                              "0\r\n"
+                              "Trailer: value\r\n"
+                              "\r\n"
+                              "next";
+    std::string_view buf(input);
+    std::string body;
+    size_t bodySize = 0;
+    APSARA_TEST_EQUAL(http::ParseChunked(buf, 8, body, bodySize), ParseState::kSuccess);
+    // only the first bytes within the limit are kept
+    APSARA_TEST_EQUAL(body, "Wikipedi");
+    APSARA_TEST_EQUAL(bodySize, 14UL);
+    APSARA_TEST_EQUAL(buf, "next");
+
+    for (size_t len = 0; len < input.size() - 4; ++len) {
+        std::string_view partial(input.data(), len);
+        APSARA_TEST_EQUAL(http::ParseChunked(partial, 256, body, bodySize), ParseState::kNeedsMoreData);
+    }
+
+    std::string_view invalidSize("x\r\nabc\r\n0\r\n\r\n");
+    APSARA_TEST_EQUAL(http::ParseChunked(invalidSize, 256, body, bodySize), ParseState::kInvalid);
+    std::string_view invalidData("3\r\nabcd\r\n0\r\n\r\n");
+    APSARA_TEST_EQUAL(http::ParseChunked(invalidData, 256, body, bodySize), ParseState::kInvalid);
+}
+
+void ProtocolParserUnittest::TestRecordPool() {
+    const std::string req = "GET /index.html HTTP/1.1\r\nHost: www.cmonitor.ai\r\n\r\n";
+    const std::string resp = "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 5\r\n\r\nerror";
+    std::string msg = req + resp;
+    conn_data_event_t* evt = (conn_data_event_t*)malloc(offsetof(conn_data_event_t, msg) + msg.size());
+    memcpy(evt->msg, msg.data(), msg.size());
+    evt->request_len = req.size();
+    evt->response_len = resp.size();
+    evt->start_ts = 1;
+    evt->end_ts = 2;
+
+    ObserverNetworkOption options;
+    auto appDetail = std::make_shared<AppDetail>(&options, nullptr);
+    HTTPProtocolParser parser;
+    L7Record* first = nullptr;
+    {
+        auto records = parser.Parse(evt, nullptr, appDetail, nullptr);
+        APSARA_TEST_EQUAL(records.size(), 1UL);
+        first = records[0].get();
+        auto* record = static_cast<HttpRecord*>(first);
+        APSARA_TEST_EQUAL(record->GetStatusCode(), 500);
+        APSARA_TEST_EQUAL(record->GetRespBody(), "error");
+        APSARA_TEST_EQUAL(record->GetMethod(), "GET");
+        APSARA_TEST_TRUE(record->ShouldSample());
+        APSARA_TEST_EQUAL(record->GetAppDetail(), appDetail);
+        APSARA_TEST_EQUAL(parser.mRecordPool->FreeSize(), 0UL);
+    }
+    // released records drop their references and are reused
+    APSARA_TEST_EQUAL(parser.mRecordPool->FreeSize(), 1UL);
+    APSARA_TEST_EQUAL(static_cast<HttpRecord*>(first)->GetAppDetail(), nullptr);
+    APSARA_TEST_EQUAL(static_cast<HttpRecord*>(first)->GetRespBody(), "");
+
+    const std::string okResp = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+    msg = req + okResp;
+    memcpy(evt->msg, msg.data(), msg.size());
+    evt->response_len = okResp.size();
+    {
+        auto records = parser.Parse(evt, nullptr, appDetail, nullptr);
+        APSARA_TEST_EQUAL(records.size(), 1UL);
+        APSARA_TEST_EQUAL(records[0].get(), first);
+        auto* record = static_cast<HttpRecord*>(first);
+        APSARA_TEST_EQUAL(record->GetStatusCode(), 200);
+        APSARA_TEST_FALSE(record->ShouldSample());
+        APSARA_TEST_EQUAL(record->GetPath(), "/index.html");
+        APSARA_TEST_EQUAL(record->GetRespHeaderMap().size(), 0UL);
+    }
+    free(evt);
+}
+
 const std::string REQ
     = "GET /wp-content/uploads/2010/03/hello-kitty-darth-vader-pink.jpg HTTP/1.1\r\n"
       "Host: www.kittyhell.com\r\n"
@@ -352,6 +469,9 @@ UNIT_TEST_CASE(ProtocolParserUnittest, TestParseInvalidRequests);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestParsePartialRequests);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestProtocolParserManager);
 UNIT_TEST_CASE(ProtocolParserUnittest, TestHttpParserEdgeCases);
+UNIT_TEST_CASE(ProtocolParserUnittest, TestHeadersOutliveDataEvent);
+UNIT_TEST_CASE(ProtocolParserUnittest, TestParseChunkedInPlace);
+UNIT_TEST_CASE(ProtocolParserUnittest, TestRecordPool);
 UNIT_TEST_CASE(ProtocolParserUnittest, RequestBenchmark);
 UNIT_TEST_CASE(ProtocolParserUnittest, RequestWithoutBodyBenchmark);
 UNIT_TEST_CASE(ProtocolParserUnittest, ResponseBenchmark);
@@ -43,18 +43,25 @@ public:
         : ModifyHandler(configName, pConfig) {}
     virtual void Handle(const Event& event) { ++handle_count; }
     virtual void HandleTimeOut() { ++handle_timeout_count; }
-    virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) { return true; }
+    virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) {
+        if (dump_count) {
+            ++(*dump_count);
+        }
+        return true;
+    }
     void Reset() {
         handle_count = 0;
         handle_timeout_count = 0;
     }
     int handle_count = 0;
     int handle_timeout_count = 0;
+    int* dump_count = nullptr;
 };
 
 class CreateModifyHandlerUnittest : public ::testing::Test {
 public:
     void TestHandleContainerStoppedEvent();
+    void TestRemoveReaders();
 
 protected:
     static void SetUpTestCase() {
@@ -197,10 +204,39 @@ void CreateModifyHandlerUnittest::TestHandleContainerStoppedEvent() {
     APSARA_TEST_EQUAL_FATAL(pHanlder->handle_count, 2);
 }
 
+void CreateModifyHandlerUnittest::TestRemoveReaders() {
+    CreateModifyHandler createModifyHandler(&mCreateHandler);
+    const std::string otherConfigName = "##1.0##project-0$config-1";
+    int dumpCount = 0;
+    int otherDumpCount = 0;
+
+    MockModifyHandler* pHanlder = new MockModifyHandler(mConfigName, mConfig); // released by RemoveReaders
+    pHanlder->dump_count = &dumpCount;
+    createModifyHandler.mModifyHandlerPtrMap.insert(std::make_pair(mConfigName, pHanlder));
+    // released by ~CreateModifyHandler
+    MockModifyHandler* pOtherHanlder = new MockModifyHandler(otherConfigName, mConfig);
+    pOtherHanlder->dump_count = &otherDumpCount;
+    createModifyHandler.mModifyHandlerPtrMap.insert(std::make_pair(otherConfigName, pOtherHanlder));
+
+    createModifyHandler.RemoveReaders({mConfigName, "not_exist_config"});
+    // both rotator readers and normal readers are dumped before removal
+    APSARA_TEST_EQUAL(2, dumpCount);
+    APSARA_TEST_EQUAL(0, otherDumpCount);
+    APSARA_TEST_EQUAL(1U, createModifyHandler.mModifyHandlerPtrMap.size());
+    APSARA_TEST_TRUE(createModifyHandler.mModifyHandlerPtrMap.find(otherConfigName)
+                     != createModifyHandler.mModifyHandlerPtrMap.end());
+
+    // readers of other configs are left intact
+    Event event(gRootDir, "", EVENT_ISDIR | EVENT_CONTAINER_STOPPED, 0);
+    createModifyHandler.Handle(event);
+    APSARA_TEST_EQUAL(1, pOtherHanlder->handle_count);
+}
+
 std::string CreateModifyHandlerUnittest::gRootDir;
 std::string CreateModifyHandlerUnittest::gLogName;
 
 UNIT_TEST_CASE(CreateModifyHandlerUnittest, TestHandleContainerStoppedEvent);
+UNIT_TEST_CASE(CreateModifyHandlerUnittest, TestRemoveReaders);
 } // end of namespace logtail
 
 int main(int argc, char** argv) {
@@ -0,0 +1,203 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/Flags.h"
+#include "common/JsonUtil.h"
+#include "common/RuntimeUtil.h"
+#include "file_server/ConfigManager.h"
+#include "file_server/EventDispatcher.h"
+#include "file_server/FileServer.h"
+#include "file_server/checkpoint/CheckPointManager.h"
+#include "file_server/event_handler/EventHandler.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_polling_discovery);
+DECLARE_FLAG_BOOL(enable_file_server_incremental_update);
+DECLARE_FLAG_INT32(default_max_inotify_watch_num);
+
+using namespace std;
+
+namespace logtail {
+
+class FileServerUnittest : public testing::Test {
+public:
+    void TestIncrementalUpdateOfModifiedConfig();
+    void TestIncrementalUpdateOfRemovedConfig();
+
+protected:
+    static void SetUpTestCase() {
+        BOOL_FLAG(enable_polling_discovery) = false;
+        BOOL_FLAG(enable_file_server_incremental_update) = true;
+        INT32_FLAG(default_max_inotify_watch_num) = 0;
+        sRootDir = (filesystem::path(GetProcessExecutionDir()) / "FileServerUnittest").string();
+        sDirA = (filesystem::path(sRootDir) / "a").string();
+        sDirB = (filesystem::path(sRootDir) / "b").string();
+    }
+
+    static void TearDownTestCase() {
+        BOOL_FLAG(enable_polling_discovery) = true;
+        BOOL_FLAG(enable_file_server_incremental_update) = false;
+    }
+
+    void SetUp() override {
+        filesystem::create_directories(sDirA);
+        filesystem::create_directories(sDirB);
+        AddConfig(kConfigA, sDirA, mOptsA, mCtxA);
+        AddConfig(kConfigB, sDirB, mOptsB, mCtxB);
+        ConfigManager::GetInstance()->RegisterHandlers();
+        // as if files in both dirs have been read, see NormalEventHandler::Handle
+        mHandlerA = InstallCreateModifyHandler(sDirA, kConfigA);
+        mHandlerB = InstallCreateModifyHandler(sDirB, kConfigB);
+        // the configs have no pipelines, so these checkpoints are deleted once validated
+        AddCheckPoint(kConfigA, 1);
+        AddCheckPoint(kConfigB, 2);
+    }
+
+    void TearDown() override {
+        FileServer::GetInstance()->RemoveFileDiscoveryConfig(kConfigA);
+        FileServer::GetInstance()->RemoveFileDiscoveryConfig(kConfigB);
+        for (const auto& dir : {sDirA, sDirB}) {
+            EventDispatcher::GetInstance()->UnregisterEventHandler(dir);
+            ConfigManager::GetInstance()->RemoveHandler(dir, true);
+        }
+        ConfigManager::GetInstance()->DeleteHandlers();
+        ConfigManager::GetInstance()->ClearFilePipelineMatchCache();
+        CheckPointManager::Instance()->RemoveAllCheckPoint();
+        filesystem::remove_all(sRootDir);
+    }
+
+private:
+    void AddConfig(const string& configName,
+                   const string& dir,
+                   FileDiscoveryOptions& opts,
+                   CollectionPipelineContext& ctx) {
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value((filesystem::path(dir) / "*.log").string()));
+        ctx.SetConfigName(configName);
+        APSARA_TEST_TRUE_FATAL(opts.Init(configJson, ctx, "test"));
+        FileServer::GetInstance()->AddFileDiscoveryConfig(configName, &opts, &ctx);
+    }
+
+    CreateModifyHandler* InstallCreateModifyHandler(const string& dir, const string& configName) {
+        auto* handler = new CreateModifyHandler(&mCreateHandler);
+        EventHandler* registeredHandler = handler;
+        auto config = FileServer::GetInstance()->GetFileDiscoveryConfig(configName);
+        APSARA_TEST_TRUE(EventDispatcher::GetInstance()->RegisterEventHandler(dir, config, registeredHandler));
+        APSARA_TEST_EQUAL(handler, registeredHandler);
+        ConfigManager::GetInstance()->AddNewHandler(dir, handler);
+        handler->GetOrCreateModifyHandler(configName, config);
+        return handler;
+    }
+
+    void AddCheckPoint(const string& configName, uint64_t inode) {
+        string filePath = (filesystem::path(sRootDir) / "c" / "test.log").string();
+        CheckPointManager::Instance()->AddCheckPoint(new CheckPoint(
+            filePath, filePath, 0, 0, 0, DevInode(0, inode), configName, filePath, false, false, "", false));
+    }
+
+    bool HasCheckPoint(const string& configName, uint64_t inode) {
+        CheckPointPtr checkPoint;
+        return CheckPointManager::Instance()->GetCheckPoint(DevInode(0, inode), configName, checkPoint);
+    }
+
+    static string sRootDir;
+    static string sDirA;
+    static string sDirB;
+
+    const string kConfigA = "config_a";
+    const string kConfigB = "config_b";
+    FileDiscoveryOptions mOptsA;
+    FileDiscoveryOptions mOptsB;
+    CollectionPipelineContext mCtxA;
+    CollectionPipelineContext mCtxB;
+    CreateHandler mCreateHandler;
+    CreateModifyHandler* mHandlerA = nullptr;
+    CreateModifyHandler* mHandlerB = nullptr;
+};
+
+string FileServerUnittest::sRootDir;
+string FileServerUnittest::sDirA;
+string FileServerUnittest::sDirB;
+
+void FileServerUnittest::TestIncrementalUpdateOfModifiedConfig() {
+    auto* dispatcher = EventDispatcher::GetInstance();
+    int wdA = dispatcher->mPathWdMap[sDirA];
+    int wdB = dispatcher->mPathWdMap[sDirB];
+    ModifyHandler* modifyHandlerA = mHandlerA->mModifyHandlerPtrMap[kConfigA];
+
+    FileServer::GetInstance()->Pause(unordered_set<string>{kConfigB});
+    // readers of the modified config are removed at once
+    APSARA_TEST_TRUE(mHandlerB->mModifyHandlerPtrMap.empty());
+    this_thread::sleep_for(chrono::milliseconds(10));
+    FileServer::GetInstance()->Resume();
+
+    // both dirs are still matched, so their watches and handlers are kept
+    APSARA_TEST_TRUE(dispatcher->IsRegistered(sDirA));
+    APSARA_TEST_TRUE(dispatcher->IsRegistered(sDirB));
+    APSARA_TEST_EQUAL(wdA, dispatcher->mPathWdMap[sDirA]);
+    APSARA_TEST_EQUAL(wdB, dispatcher->mPathWdMap[sDirB]);
+    APSARA_TEST_EQUAL(mHandlerA, dispatcher->GetHandler(sDirA.c_str()));
+    APSARA_TEST_EQUAL(mHandlerB, dispatcher->GetHandler(sDirB.c_str()));
+    // readers of the unchanged config are left intact
+    APSARA_TEST_EQUAL(1U, mHandlerA->mModifyHandlerPtrMap.size());
+    APSARA_TEST_EQUAL(modifyHandlerA, mHandlerA->mModifyHandlerPtrMap[kConfigA]);
+    APSARA_TEST_TRUE(mHandlerB->mModifyHandlerPtrMap.empty());
+
+    // only checkpoints of the modified config are validated
+    APSARA_TEST_TRUE(HasCheckPoint(kConfigA, 1));
+    APSARA_TEST_FALSE(HasCheckPoint(kConfigB, 2));
+
+    APSARA_TEST_TRUE(FileServer::GetInstance()->mConfigUpdatePauseTimeMs->GetValue() >= 10U);
+    APSARA_TEST_FALSE(FileServer::GetInstance()->mIsIncrementalUpdate);
+    APSARA_TEST_TRUE(FileServer::GetInstance()->mUpdatedConfigNames.empty());
+}
+
+void FileServerUnittest::TestIncrementalUpdateOfRemovedConfig() {
+    auto* dispatcher = EventDispatcher::GetInstance();
+    int wdA = dispatcher->mPathWdMap[sDirA];
+    ModifyHandler* modifyHandlerA = mHandlerA->mModifyHandlerPtrMap[kConfigA];
+
+    FileServer::GetInstance()->Pause(unordered_set<string>{kConfigB});
+    FileServer::GetInstance()->RemoveFileDiscoveryConfig(kConfigB);
+    FileServer::GetInstance()->Resume();
+
+    // the dir of the removed config is no longer matched by any config, so it is unregistered
+    APSARA_TEST_FALSE(dispatcher->IsRegistered(sDirB));
+    APSARA_TEST_EQUAL(nullptr, dispatcher->GetHandler(sDirB.c_str()));
+    // while the dir of the unchanged config keeps its watch and readers
+    APSARA_TEST_TRUE(dispatcher->IsRegistered(sDirA));
+    APSARA_TEST_EQUAL(wdA, dispatcher->mPathWdMap[sDirA]);
+    APSARA_TEST_EQUAL(mHandlerA, dispatcher->GetHandler(sDirA.c_str()));
+    APSARA_TEST_EQUAL(1U, mHandlerA->mModifyHandlerPtrMap.size());
+    APSARA_TEST_EQUAL(modifyHandlerA, mHandlerA->mModifyHandlerPtrMap[kConfigA]);
+
+    APSARA_TEST_TRUE(HasCheckPoint(kConfigA, 1));
+    APSARA_TEST_FALSE(HasCheckPoint(kConfigB, 2));
+}
+
+UNIT_TEST_CASE(FileServerUnittest, TestIncrementalUpdateOfModifiedConfig)
+UNIT_TEST_CASE(FileServerUnittest, TestIncrementalUpdateOfRemovedConfig)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
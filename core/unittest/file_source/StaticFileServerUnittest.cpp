@@ -14,12 +14,18 @@
 
 #include "collection_pipeline/CollectionPipeline.h"
 #include "collection_pipeline/plugin/PluginRegistry.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
 #include "common/JsonUtil.h"
+#include "constants/Constants.h"
 #include "file_server/StaticFileServer.h"
 #include "file_server/checkpoint/InputStaticFileCheckpointManager.h"
 #include "plugin/input/InputStaticFile.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_INT32(input_static_file_bulk_thread_count);
+DECLARE_FLAG_INT64(input_static_file_bulk_range_size);
+
 using namespace std;
 
 namespace logtail {
@@ -29,6 +35,9 @@ public:
     void TestGetNextAvailableReader() const;
     void TestUpdateInputs() const;
     void TestClearUnusedCheckpoints() const;
+    void TestSplitFileIntoRanges() const;
+    void TestScheduleBulkRanges() const;
+    void TestReadFileRange() const;
 
 protected:
     static void SetUpTestCase() { PluginRegistry::GetInstance()->LoadPlugins(); }
@@ -48,6 +57,8 @@ protected:
     }
 
 private:
+    static void PrepareBulkLogs(const vector<filesystem::path>& files, size_t lineCnt, vector<string>& lines);
+
     InputStaticFileCheckpointManager* sManager;
     StaticFileServer* sServer;
 };
@@ -186,9 +197,224 @@ void StaticFileServerUnittest::TestClearUnusedCheckpoints() const {
     INT32_FLAG(unused_checkpoints_clear_interval_sec) = 600;
 }
 
+void StaticFileServerUnittest::TestSplitFileIntoRanges() const {
+    filesystem::create_directories("test_logs");
+    filesystem::path filepath = "./test_logs/test_file_split.log";
+    {
+        ofstream fout(filepath, ios::binary);
+        fout << string(99, 'a') << "\n" << string(149, 'b') << "\n" << string(49, 'c') << "\n" << string(10, 'd');
+    }
+    uint64_t size = filesystem::file_size(filepath);
+    {
+        // range boundaries are moved to the byte after the next line feed
+        auto ranges = StaticFileServer::SplitFileIntoRanges(filepath, size, 120);
+        APSARA_TEST_EQUAL(2U, ranges.size());
+        APSARA_TEST_EQUAL(0U, ranges[0].mBegin);
+        APSARA_TEST_EQUAL(250U, ranges[0].mEnd);
+        APSARA_TEST_EQUAL(250U, ranges[1].mBegin);
+        APSARA_TEST_EQUAL(size, ranges[1].mEnd);
+        APSARA_TEST_EQUAL(250U, ranges[1].mOffset);
+    }
+    {
+        auto ranges = StaticFileServer::SplitFileIntoRanges(filepath, size, 50);
+        APSARA_TEST_EQUAL(4U, ranges.size());
+        APSARA_TEST_EQUAL(100U, ranges[0].mEnd);
+        APSARA_TEST_EQUAL(250U, ranges[1].mEnd);
+        APSARA_TEST_EQUAL(300U, ranges[2].mEnd);
+        APSARA_TEST_EQUAL(size, ranges[3].mEnd);
+    }
+    {
+        auto ranges = StaticFileServer::SplitFileIntoRanges(filepath, size, size);
+        APSARA_TEST_EQUAL(1U, ranges.size());
+        APSARA_TEST_EQUAL(size, ranges[0].mEnd);
+    }
+    APSARA_TEST_TRUE(StaticFileServer::SplitFileIntoRanges(filepath, 0, 50).empty());
+    filesystem::remove_all("test_logs");
+}
+
+void StaticFileServerUnittest::PrepareBulkLogs(const vector<filesystem::path>& files,
+                                               size_t lineCnt,
+                                               vector<string>& lines) {
+    filesystem::create_directories("test_logs");
+    for (size_t i = 0; i < files.size(); ++i) {
+        ofstream fout(files[i], ios::binary);
+        // each line is 50 bytes long, including the line feed
+        for (size_t j = 0; j < lineCnt * (files.size() - i); ++j) {
+            string line = "file_" + ToString(i) + "_line_" + ToString(j);
+            line.resize(49, 'x');
+            fout << line << "\n";
+            lines.emplace_back(std::move(line));
+        }
+    }
+}
+
+void StaticFileServerUnittest::TestScheduleBulkRanges() const {
+    INT32_FLAG(input_static_file_bulk_thread_count) = 4;
+    INT64_FLAG(input_static_file_bulk_range_size) = 120;
+    vector<filesystem::path> files{"./test_logs/test_file_1.log", "./test_logs/test_file_2.log"};
+    vector<string> lines;
+    // file 1: 500 bytes, file 2: 250 bytes
+    PrepareBulkLogs(files, 5, lines);
+    sManager->CreateCheckpoint("test_config", 0, files);
+    sServer->mBulkInputs[make_pair("test_config", 0)] = 1;
+    {
+        // file 1 partially read in sequential mode before, and file 2 split into ranges
+        sManager->UpdateCurrentFileCheckpoint("test_config", 0, 100, 500);
+        APSARA_TEST_TRUE(sServer->ScheduleBulkRanges("test_config", 0, 1, true));
+        const auto& cpt = sManager->mInputCheckpointMap.at(make_pair("test_config", 0));
+        APSARA_TEST_EQUAL(FileStatus::READING, cpt.mFileCheckpoints[0].mStatus);
+        APSARA_TEST_EQUAL(1U, cpt.mFileCheckpoints[0].mRanges.size());
+        APSARA_TEST_EQUAL(100U, cpt.mFileCheckpoints[0].mRanges[0].mBegin);
+        APSARA_TEST_EQUAL(500U, cpt.mFileCheckpoints[0].mRanges[0].mEnd);
+        APSARA_TEST_EQUAL(FileStatus::READING, cpt.mFileCheckpoints[1].mStatus);
+        APSARA_TEST_EQUAL(2U, cpt.mFileCheckpoints[1].mRanges.size());
+        APSARA_TEST_EQUAL(150U, cpt.mFileCheckpoints[1].mRanges[0].mEnd);
+        APSARA_TEST_EQUAL(250U, cpt.mFileCheckpoints[1].mRanges[1].mEnd);
+
+        APSARA_TEST_EQUAL(3U, sServer->mBulkTasks.size());
+        APSARA_TEST_EQUAL(3U, sServer->mBulkRangesInProcess.size());
+        const auto& task = sServer->mBulkTasks.front();
+        APSARA_TEST_EQUAL(0U, task.mFileIdx);
+        APSARA_TEST_EQUAL(100U, task.mRange.mOffset);
+        APSARA_TEST_EQUAL(1U, task.mInputVersion);
+
+        // ranges in process are not scheduled again
+        APSARA_TEST_TRUE(sServer->ScheduleBulkRanges("test_config", 0, 1, true));
+        APSARA_TEST_EQUAL(3U, sServer->mBulkTasks.size());
+    }
+    {
+        // resume from a partially read range checkpoint after restart
+        sManager->UpdateFileRangeCheckpoint("test_config", 0, 0, 0, 300);
+        sManager->UpdateFileRangeCheckpoint("test_config", 0, 1, 0, 150);
+        sManager->DumpAllCheckpointFiles();
+        sManager->mInputCheckpointMap.clear();
+        sServer->mBulkTasks.clear();
+        sServer->mBulkRangesInProcess.clear();
+        APSARA_TEST_TRUE(sManager->CreateCheckpoint("test_config", 0));
+        sServer->mBulkInputs[make_pair("test_config", 0)] = 2;
+
+        APSARA_TEST_TRUE(sServer->ScheduleBulkRanges("test_config", 0, 2, true));
+        const auto& cpt = sManager->mInputCheckpointMap.at(make_pair("test_config", 0));
+        APSARA_TEST_EQUAL(1U, cpt.mFileCheckpoints[0].mRanges.size());
+        APSARA_TEST_EQUAL(300U, cpt.mFileCheckpoints[0].mRanges[0].mOffset);
+        APSARA_TEST_EQUAL(2U, cpt.mFileCheckpoints[1].mRanges.size());
+        // finished ranges are skipped
+        APSARA_TEST_EQUAL(2U, sServer->mBulkTasks.size());
+        APSARA_TEST_EQUAL(0U, sServer->mBulkTasks[0].mFileIdx);
+        APSARA_TEST_EQUAL(300U, sServer->mBulkTasks[0].mRange.mOffset);
+        APSARA_TEST_EQUAL(1U, sServer->mBulkTasks[1].mFileIdx);
+        APSARA_TEST_EQUAL(1U, sServer->mBulkTasks[1].mRangeIdx);
+        APSARA_TEST_EQUAL(150U, sServer->mBulkTasks[1].mRange.mOffset);
+    }
+    {
+        // input recreated before the file is split
+        sManager->CreateCheckpoint("test_config_2", 0, files);
+        sServer->mBulkInputs[make_pair("test_config_2", 0)] = 4;
+        APSARA_TEST_TRUE(sServer->ScheduleBulkRanges("test_config_2", 0, 3, true));
+        const auto& cpt = sManager->mInputCheckpointMap.at(make_pair("test_config_2", 0));
+        APSARA_TEST_EQUAL(FileStatus::WAITING, cpt.mFileCheckpoints[0].mStatus);
+        APSARA_TEST_TRUE(cpt.mFileCheckpoints[0].mRanges.empty());
+        APSARA_TEST_EQUAL(2U, sServer->mBulkTasks.size());
+    }
+    {
+        // all files read
+        sManager->UpdateFileRangeCheckpoint("test_config", 0, 0, 0, 500);
+        sManager->UpdateFileRangeCheckpoint("test_config", 0, 1, 1, 250);
+        APSARA_TEST_FALSE(sServer->ScheduleBulkRanges("test_config", 0, 2, true));
+        APSARA_TEST_EQUAL(StaticFileReadingStatus::FINISHED,
+                          sManager->mInputCheckpointMap.at(make_pair("test_config", 0)).mStatus);
+    }
+    INT32_FLAG(input_static_file_bulk_thread_count) = 4;
+    INT64_FLAG(input_static_file_bulk_range_size) = 64 * 1024 * 1024;
+    filesystem::remove_all("test_logs");
+}
+
+void StaticFileServerUnittest::TestReadFileRange() const {
+    INT64_FLAG(input_static_file_bulk_range_size) = 120;
+    vector<filesystem::path> files{"./test_logs/test_file_1.log", "./test_logs/test_file_2.log"};
+    vector<string> lines;
+    PrepareBulkLogs(files, 5, lines);
+
+    // build input, which is not started so that no thread other than the test one reads the files
+    CollectionPipeline p;
+    p.mName = "test_config";
+    p.mPluginID.store(0);
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("test_config");
+    ctx.SetPipeline(p);
+    QueueKey key = QueueKeyManager::GetInstance()->GetKey("test_config");
+    ctx.SetProcessQueueKey(key);
+    ProcessQueueManager::GetInstance()->CreateOrUpdateCountBoundedQueue(key, 0, ctx);
+    ProcessQueueManager::GetInstance()->EnablePop("test_config");
+
+    string configStr = R"(
+        {
+            "Type": "input_static_file_onetime",
+            "FilePaths": [],
+            "EnableBulkRead": true
+        }
+    )";
+    string errorMsg;
+    Json::Value configJson, optionalGoPipeline;
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    configJson["FilePaths"].append(Json::Value(filesystem::absolute("./test_logs/*.log").string()));
+    InputStaticFile input;
+    input.SetContext(ctx);
+    input.CreateMetricsRecordRef(InputStaticFile::sName, "1");
+    APSARA_TEST_TRUE(input.Init(configJson, optionalGoPipeline));
+    input.CommitMetricsRecordRef();
+
+    sManager->CreateCheckpoint("test_config", 0, files);
+    sServer->mInputFileDiscoveryConfigsMap.try_emplace(make_pair("test_config", 0), &input.mFileDiscovery, &ctx);
+    sServer->mInputFileReaderConfigsMap.try_emplace(make_pair("test_config", 0), &input.mFileReader, &ctx);
+    sServer->mInputMultilineConfigsMap.try_emplace(make_pair("test_config", 0), &input.mMultiline, &ctx);
+    sServer->mInputFileTagConfigsMap.try_emplace(make_pair("test_config", 0), &input.mFileTag, &ctx);
+    sServer->mBulkInputs[make_pair("test_config", 0)] = 1;
+    sServer->mIsBulkWorkerRunning = true;
+
+    APSARA_TEST_TRUE(sServer->ScheduleBulkRanges("test_config", 0, 1, true));
+    APSARA_TEST_EQUAL(6U, sServer->mBulkTasks.size());
+    // ranges are read in reverse order, as concurrent workers may do
+    multiset<string> readLines;
+    while (!sServer->mBulkTasks.empty()) {
+        auto task = sServer->mBulkTasks.back();
+        sServer->mBulkTasks.pop_back();
+        sServer->ReadFileRange(task);
+
+        unique_ptr<ProcessQueueItem> item;
+        string configName;
+        while (ProcessQueueManager::GetInstance()->PopItem(0, item, configName)) {
+            APSARA_TEST_EQUAL("test_config", configName);
+            for (const auto& e : item->mEventGroup.GetEvents()) {
+                auto content = e.Cast<LogEvent>().GetContent(DEFAULT_CONTENT_KEY);
+                size_t begin = 0;
+                while (begin < content.size()) {
+                    size_t end = content.find('\n', begin);
+                    if (end == StringView::npos) {
+                        end = content.size();
+                    }
+                    readLines.emplace(content.substr(begin, end - begin).to_string());
+                    begin = end + 1;
+                }
+            }
+        }
+    }
+    APSARA_TEST_EQUAL(multiset<string>(lines.begin(), lines.end()), readLines);
+    APSARA_TEST_EQUAL(StaticFileReadingStatus::FINISHED,
+                      sManager->mInputCheckpointMap.at(make_pair("test_config", 0)).mStatus);
+
+    sServer->mIsBulkWorkerRunning = false;
+    ProcessQueueManager::GetInstance()->DeleteQueue(key);
+    INT64_FLAG(input_static_file_bulk_range_size) = 64 * 1024 * 1024;
+    filesystem::remove_all("test_logs");
+}
+
 UNIT_TEST_CASE(StaticFileServerUnittest, TestGetNextAvailableReader)
 UNIT_TEST_CASE(StaticFileServerUnittest, TestUpdateInputs)
 UNIT_TEST_CASE(StaticFileServerUnittest, TestClearUnusedCheckpoints)
+UNIT_TEST_CASE(StaticFileServerUnittest, TestSplitFileIntoRanges)
+UNIT_TEST_CASE(StaticFileServerUnittest, TestScheduleBulkRanges)
+UNIT_TEST_CASE(StaticFileServerUnittest, TestReadFileRange)
 
 } // namespace logtail
 
@@ -0,0 +1,221 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpcpp/create_channel.h>
+#include <grpcpp/server_builder.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "common/TimeUtil.h"
+#include "forward/loongsuite/LoongSuiteForwardService.h"
+#include "models/PipelineEventGroup.h"
+#include "models/RawEvent.h"
+#include "protobuf/forward/loongsuite.grpc.pb.h"
+#include "protobuf/models/ManualPBParser.h"
+#include "protobuf/models/pipeline_event_group.pb.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+static atomic_uint64_t sAllocCnt{0};
+
+void* operator new(size_t size) {
+    sAllocCnt.fetch_add(1, memory_order_relaxed);
+    if (void* ptr = malloc(size)) {
+        return ptr;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+namespace logtail {
+
+static string MakeForwardData(int eventCnt) {
+    models::PipelineEventGroup group;
+    (*group.mutable_tags())["host.name"] = "benchmark-host";
+    (*group.mutable_tags())["service.name"] = "benchmark-service";
+    auto* logEvents = group.mutable_logs();
+    for (int i = 0; i < eventCnt; ++i) {
+        auto* logEvent = logEvents->add_events();
+        logEvent->set_timestamp(1712551739000000000ULL + i);
+        logEvent->set_level("INFO");
+        auto* content = logEvent->add_contents();
+        content->set_key("message");
+        content->set_value("GET /api/v1/users/" + to_string(i) + "?fields=name,email HTTP/1.1 200 " + to_string(i % 1000));
+        content = logEvent->add_contents();
+        content->set_key("thread");
+        content->set_value("worker-" + to_string(i % 16));
+    }
+    return group.SerializeAsString();
+}
+
+// Parses the raw events of a forwarded event group the same way as processor_parse_from_pb_native.
+static size_t ParseRawEventGroup(PipelineEventGroup& rawGroup, bool noCopy) {
+    size_t eventCnt = 0;
+    for (const auto& e : rawGroup.GetEvents()) {
+        const auto& content = e.Cast<RawEvent>().GetContent();
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        if (noCopy) {
+            group.GetSourceBuffer()->AddExternalBuffer(rawGroup.GetSourceBuffer());
+        }
+        ManualPBParser parser(reinterpret_cast<const uint8_t*>(content.data()), content.size(), false, noCopy);
+        string errMsg;
+        if (parser.ParsePipelineEventGroup(group, errMsg)) {
+            eventCnt += group.GetEvents().size();
+        }
+    }
+    return eventCnt;
+}
+
+class LoongSuiteForwardBenchmark {
+public:
+    // The ingestion of forwarded data without gRPC: raw events are built from the request, and then parsed.
+    // copy: the data is copied into the raw events, and then copied again into the parsed event groups.
+    // no copy: both the raw events and the parsed event groups reference the data in the request.
+    static void BM_Ingest(bool noCopy, int eventsPerData, int dataPerRequest, int requestCnt) {
+        auto request = make_shared<LoongSuiteForwardRequest>();
+        for (int i = 0; i < dataPerRequest; ++i) {
+            request->add_data(MakeForwardData(eventsPerData));
+        }
+
+        size_t eventCnt = 0;
+        uint64_t allocCnt = sAllocCnt.load();
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        for (int i = 0; i < requestCnt; ++i) {
+            PipelineEventGroup rawGroup(make_shared<SourceBuffer>());
+            if (noCopy) {
+                rawGroup.GetSourceBuffer()->AddExternalBuffer(request);
+            }
+            for (const auto& data : request->data()) {
+                auto* event = rawGroup.AddRawEvent(true);
+                if (noCopy) {
+                    event->SetContentNoCopy(StringView(data));
+                } else {
+                    event->SetContent(data);
+                }
+            }
+            eventCnt += ParseRawEventGroup(rawGroup, noCopy);
+        }
+        uint64_t duration = GetCurrentTimeInMicroSeconds() - startTime;
+        allocCnt = sAllocCnt.load() - allocCnt;
+        Print(noCopy ? "ingest no copy" : "ingest copy", eventCnt, duration, allocCnt);
+    }
+
+    // Forwards data through a local gRPC server, and parses the groups popped from the process queue.
+    static void BM_Grpc(int eventsPerData, int dataPerRequest, int requestCnt) {
+        const string configName = "forward_benchmark";
+        CollectionPipelineContext ctx;
+        ctx.SetConfigName(configName);
+        QueueKey key = QueueKeyManager::GetInstance()->GetKey(configName);
+        ProcessQueueManager::GetInstance()->CreateOrUpdateCountBoundedQueue(key, 0, ctx);
+        ProcessQueueManager::GetInstance()->EnablePop(configName);
+
+        LoongSuiteForwardServiceImpl service;
+        Json::Value config;
+        config["QueueKey"] = key;
+        config["InputIndex"] = 0;
+        service.Update(configName, config);
+
+        int port = 0;
+        grpc::ServerBuilder builder;
+        builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+        builder.RegisterService(&service);
+        auto server = builder.BuildAndStart();
+        if (!server || port == 0) {
+            cout << "failed to start grpc server" << endl;
+            return;
+        }
+
+        size_t totalEvents = static_cast<size_t>(eventsPerData) * dataPerRequest * requestCnt;
+        atomic_size_t eventCnt = 0;
+        thread consumer([&]() {
+            while (eventCnt < totalEvents) {
+                unique_ptr<ProcessQueueItem> item;
+                string name;
+                if (!ProcessQueueManager::GetInstance()->PopItem(0, item, name)) {
+                    ProcessQueueManager::GetInstance()->Wait(10);
+                    continue;
+                }
+                eventCnt += ParseRawEventGroup(item->mEventGroup, true);
+            }
+        });
+
+        LoongSuiteForwardRequest request;
+        for (int i = 0; i < dataPerRequest; ++i) {
+            request.add_data(MakeForwardData(eventsPerData));
+        }
+        auto stub = LoongSuiteForwardService::NewStub(
+            grpc::CreateChannel("127.0.0.1:" + to_string(port), grpc::InsecureChannelCredentials()));
+        uint64_t allocCnt = sAllocCnt.load();
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        for (int i = 0; i < requestCnt; ++i) {
+            grpc::ClientContext context;
+            context.AddMetadata("x-loongsuite-apm-configname", configName);
+            LoongSuiteForwardResponse response;
+            auto status = stub->Forward(&context, request, &response);
+            if (!status.ok()) {
+                cout << "forward failed: " << status.error_message() << endl;
+                totalEvents -= static_cast<size_t>(eventsPerData) * dataPerRequest;
+            }
+        }
+        consumer.join();
+        uint64_t duration = GetCurrentTimeInMicroSeconds() - startTime;
+        allocCnt = sAllocCnt.load() - allocCnt;
+        Print("grpc", eventCnt, duration, allocCnt);
+
+        server->Shutdown();
+        ProcessQueueManager::GetInstance()->DeleteQueue(key);
+    }
+
+private:
+    static void Print(const string& name, size_t eventCnt, uint64_t durationUs, uint64_t allocCnt) {
+        cout << name << "\tevents: " << eventCnt << "\tdurationTime: " << durationUs / 1000 << " ms\tevents/s: "
+             << static_cast<uint64_t>(eventCnt * 1000000.0 / max<uint64_t>(durationUs, 1))
+             << "\tallocations per event: " << static_cast<double>(allocCnt) / max<size_t>(eventCnt, 1) << endl;
+    }
+};
+
+} // namespace logtail
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    for (int eventsPerData : {10, 100, 1000}) {
+        int requestCnt = 1000000 / (eventsPerData * 10);
+        logtail::LoongSuiteForwardBenchmark::BM_Ingest(false, eventsPerData, 10, requestCnt);
+        logtail::LoongSuiteForwardBenchmark::BM_Ingest(true, eventsPerData, 10, requestCnt);
+    }
+    logtail::LoongSuiteForwardBenchmark::BM_Grpc(100, 10, 1000);
+    return 0;
+}
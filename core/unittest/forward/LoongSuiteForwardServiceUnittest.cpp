@@ -16,10 +16,15 @@
 
 #include <json/value.h>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <thread>
 
+#include "collection_pipeline/queue/PendingPushManager.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
 #include "common/Flags.h"
 #include "forward/loongsuite/LoongSuiteForwardService.h"
 #include "protobuf/forward/loongsuite.grpc.pb.h"
@@ -47,6 +52,8 @@ public:
     void TestProcessorRunnerIntegration();
     void TestForwardMethod();
     void TestProcessForwardRequest();
+    void TestProcessSharedForwardRequest();
+    void TestProcessForwardRequestOnFullQueue();
     void TestFindMatchingConfig();
     void TestForwardWithValidRequest();
     void TestForwardWithInvalidRequest();
@@ -309,6 +316,67 @@ void LoongSuiteForwardServiceUnittest::TestProcessForwardRequest() {
     APSARA_TEST_EQUAL_FATAL(grpc::StatusCode::UNAVAILABLE, status.error_code());
 }
 
+void LoongSuiteForwardServiceUnittest::TestProcessSharedForwardRequest() {
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("shared_request_config");
+    auto config = std::make_shared<ForwardConfig>();
+    config->configName = "shared_request_config";
+    config->queueKey = QueueKeyManager::GetInstance()->GetKey("shared_request_config");
+    config->inputIndex = 0;
+    // pop is not enabled, so the item stays in the queue
+    ProcessQueueManager::GetInstance()->CreateOrUpdateCountBoundedQueue(config->queueKey, 0, ctx);
+
+    // the request is referenced by the event group instead of being copied
+    auto request = std::make_shared<LoongSuiteForwardRequest>();
+    request->add_data("test data");
+    grpc::Status status;
+    service->ProcessForwardRequest(request.get(), config, 1, status, request);
+    APSARA_TEST_TRUE_FATAL(status.ok());
+    APSARA_TEST_EQUAL(2, request.use_count());
+
+    ProcessQueueManager::GetInstance()->DeleteQueue(config->queueKey);
+}
+
+void LoongSuiteForwardServiceUnittest::TestProcessForwardRequestOnFullQueue() {
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("full_queue_config");
+    auto config = std::make_shared<ForwardConfig>();
+    config->configName = "full_queue_config";
+    config->queueKey = QueueKeyManager::GetInstance()->GetKey("full_queue_config");
+    config->inputIndex = 0;
+    ProcessQueueManager::GetInstance()->CreateOrUpdateCountBoundedQueue(config->queueKey, 0, ctx);
+    ProcessQueueManager::GetInstance()->SetFeedbackInterface(config->queueKey, {PendingPushManager::GetInstance()});
+    for (size_t i = 0; i < 5; ++i) {
+        PipelineEventGroup group(std::make_shared<SourceBuffer>());
+        ProcessQueueManager::GetInstance()->PushQueue(config->queueKey,
+                                                      std::make_unique<ProcessQueueItem>(std::move(group), 0));
+    }
+
+    // the request waits for the queue without blocking the caller
+    LoongSuiteForwardRequest request;
+    request.add_data("test data");
+    grpc::Status status;
+    std::atomic_int finishedCnt = 0;
+    grpc::Status finalStatus(grpc::StatusCode::UNKNOWN, "");
+    APSARA_TEST_FALSE(
+        service->ProcessForwardRequest(&request, config, 100, status, nullptr, [&](const grpc::Status& s) {
+            finalStatus = s;
+            ++finishedCnt;
+        }));
+    APSARA_TEST_EQUAL(0, finishedCnt.load());
+
+    // the request is pushed once processor runner threads make room in the queue
+    ProcessQueueManager::GetInstance()->EnablePop("full_queue_config");
+    ProcessQueueManager::GetInstance()->Trigger();
+    for (size_t i = 0; i < 100 && finishedCnt.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    APSARA_TEST_EQUAL(1, finishedCnt.load());
+    APSARA_TEST_TRUE(finalStatus.ok());
+
+    ProcessQueueManager::GetInstance()->DeleteQueue(config->queueKey);
+}
+
 void LoongSuiteForwardServiceUnittest::TestFindMatchingConfig() {
     // Setup config first
     Json::Value config;
@@ -455,6 +523,8 @@ UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestConcurrentAccess)
 UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestProcessorRunnerIntegration)
 UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestForwardMethod)
 UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestProcessForwardRequest)
+UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestProcessSharedForwardRequest)
+UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestProcessForwardRequestOnFullQueue)
 UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestFindMatchingConfig)
 UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestForwardWithValidRequest)
 UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestForwardWithInvalidRequest)
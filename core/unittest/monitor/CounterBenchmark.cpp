@@ -0,0 +1,120 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/TimeUtil.h"
+#include "monitor/MetricManager.h"
+#include "unittest/Unittest.h"
+
+
+using namespace logtail;
+
+
+// each thread adds to the same counter, like processor threads adding to the counters of a pipeline
+static uint64_t AddConcurrently(Counter& counter, int threadCount, int addCount) {
+    std::vector<std::thread> threads;
+    uint64_t startTime = GetCurrentTimeInMicroSeconds();
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back([&counter, addCount]() {
+            for (int j = 0; j < addCount; ++j) {
+                counter.Add(1);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    return GetCurrentTimeInMicroSeconds() - startTime;
+}
+
+static void BM_AddCounter(int threadCount, int addCount) {
+    std::cout << "threads:\t" << threadCount << "\tadds per thread:\t" << addCount << std::endl;
+    Counter counter("counter");
+    uint64_t durationTime = AddConcurrently(counter, threadCount, addCount);
+    std::cout << "atomic durationTime: " << durationTime << "\tns per add: "
+              << durationTime * 1000.0 * threadCount / counter.GetValue() << std::endl;
+
+    Counter shardedCounter("sharded_counter", 0, threadCount);
+    uint64_t shardedDurationTime = AddConcurrently(shardedCounter, threadCount, addCount);
+    std::cout << "sharded durationTime: " << shardedDurationTime << "\tns per add: "
+              << shardedDurationTime * 1000.0 * threadCount / shardedCounter.GetValue() << std::endl;
+    if (counter.GetValue() != shardedCounter.GetValue()) {
+        std::cout << "error: atomic " << counter.GetValue() << ", sharded " << shardedCounter.GetValue() << std::endl;
+    }
+}
+
+static void BM_Snapshot(int recordCount, int batchSize) {
+    std::cout << "records:\t" << recordCount << std::endl;
+    std::vector<std::unique_ptr<MetricsRecordRef>> refs;
+    std::vector<CounterPtr> counters;
+    for (int i = 0; i < recordCount; ++i) {
+        refs.emplace_back(std::make_unique<MetricsRecordRef>());
+        WriteMetrics::GetInstance()->CreateMetricsRecordRef(
+            *refs.back(), MetricCategory::METRIC_CATEGORY_PLUGIN, {{"plugin_id", std::to_string(i)}});
+        for (int j = 0; j < 5; ++j) {
+            counters.emplace_back(refs.back()->CreateCounter("counter_" + std::to_string(j), true));
+        }
+        refs.back()->CreateIntGauge("gauge");
+        WriteMetrics::GetInstance()->CommitMetricsRecordRef(*refs.back());
+    }
+
+    auto release = [](MetricsRecord* head) {
+        while (head) {
+            MetricsRecord* toDelete = head;
+            head = head->GetNext();
+            delete toDelete;
+        }
+    };
+    uint64_t durationTime = 0;
+    for (int i = 0; i < batchSize; ++i) {
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        MetricsRecord* snapshot = WriteMetrics::GetInstance()->DoSnapshot();
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        release(snapshot);
+    }
+    std::cout << "new snapshot durationTime: " << durationTime << "\tus per round: " << durationTime / batchSize
+              << std::endl;
+
+    MetricsRecord* recycled = nullptr;
+    MetricsRecord* last = nullptr;
+    uint64_t reuseDurationTime = 0;
+    for (int i = 0; i < batchSize; ++i) {
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        MetricsRecord* snapshot = WriteMetrics::GetInstance()->DoSnapshot(recycled);
+        reuseDurationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        recycled = last;
+        last = snapshot;
+    }
+    release(recycled);
+    release(last);
+    std::cout << "reused snapshot durationTime: " << reuseDurationTime
+              << "\tus per round: " << reuseDurationTime / batchSize << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    BM_AddCounter(32, 1000000);
+    BM_Snapshot(10000, 10);
+    return 0;
+}
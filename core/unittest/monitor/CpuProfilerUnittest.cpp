@@ -0,0 +1,137 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "common/Flags.h"
+#include "monitor/CpuProfiler.h"
+#include "monitor/MetricManager.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_cpu_profiler);
+DECLARE_FLAG_INT32(cpu_profiler_frequency);
+
+using namespace std;
+
+namespace logtail {
+
+class CpuProfilerUnittest : public testing::Test {
+public:
+    void TestRegisterTag();
+    void TestScope();
+    void TestSample();
+
+protected:
+    void SetUp() override {
+        BOOL_FLAG(enable_cpu_profiler) = true;
+        WriteMetrics::GetInstance()->CreateMetricsRecordRef(
+            mMetricsRecordRef, MetricCategory::METRIC_CATEGORY_UNKNOWN, {});
+    }
+
+    void TearDown() override {
+        CpuProfiler::GetInstance()->Stop();
+        CpuProfiler::GetInstance()->UnregisterThread();
+        BOOL_FLAG(enable_cpu_profiler) = false;
+        INT32_FLAG(cpu_profiler_frequency) = 99;
+    }
+
+    MetricsRecordRef mMetricsRecordRef;
+};
+
+void CpuProfilerUnittest::TestRegisterTag() {
+    auto* profiler = CpuProfiler::GetInstance();
+    uint32_t pipelineTag = profiler->RegisterTag("test_config", "", "", mMetricsRecordRef.CreateCounter("pipeline"));
+    uint32_t pluginTag = profiler->RegisterTag(
+        "test_config", "processor_parse_json_native", "1", mMetricsRecordRef.CreateCounter("plugin"));
+    APSARA_TEST_NOT_EQUAL(0U, pipelineTag);
+    APSARA_TEST_NOT_EQUAL(0U, pluginTag);
+    APSARA_TEST_NOT_EQUAL(pipelineTag, pluginTag);
+
+    // the plugin recreated by a pipeline update keeps its tag, with the new counter
+    auto counter = mMetricsRecordRef.CreateCounter("plugin_updated");
+    APSARA_TEST_EQUAL(pluginTag,
+                      profiler->RegisterTag("test_config", "processor_parse_json_native", "1", counter));
+    APSARA_TEST_EQUAL(counter, profiler->mTags[pluginTag - 1].mCpuTimeMs);
+
+    // the cpu of a plugin is added to its pipeline
+    profiler->mPeriodUs = 10000;
+    profiler->AddCpuTime(pluginTag, 15);
+    APSARA_TEST_EQUAL(150U, counter->GetValue());
+    APSARA_TEST_EQUAL(150U, profiler->mTags[pipelineTag - 1].mCpuTimeMs->GetValue());
+
+    BOOL_FLAG(enable_cpu_profiler) = false;
+    APSARA_TEST_EQUAL(0U, profiler->RegisterTag("test_config", "", "", mMetricsRecordRef.CreateCounter("disabled")));
+}
+
+void CpuProfilerUnittest::TestScope() {
+    APSARA_TEST_EQUAL(0U, CpuProfiler::sThreadTag);
+    {
+        CpuProfileScope outer(1);
+        APSARA_TEST_EQUAL(1U, CpuProfiler::sThreadTag);
+        {
+            CpuProfileScope inner(2);
+            APSARA_TEST_EQUAL(2U, CpuProfiler::sThreadTag);
+        }
+        APSARA_TEST_EQUAL(1U, CpuProfiler::sThreadTag);
+    }
+    APSARA_TEST_EQUAL(0U, CpuProfiler::sThreadTag);
+}
+
+void CpuProfilerUnittest::TestSample() {
+#if defined(__linux__)
+    auto* profiler = CpuProfiler::GetInstance();
+    INT32_FLAG(cpu_profiler_frequency) = 1000;
+    auto pipelineCounter = mMetricsRecordRef.CreateCounter("sample_pipeline");
+    auto pluginCounter = mMetricsRecordRef.CreateCounter("sample_plugin");
+    profiler->RegisterTag("sample_config", "", "", pipelineCounter);
+    uint32_t tag = profiler->RegisterTag("sample_config", "flusher_blackhole", "2", pluginCounter);
+    profiler->RegisterThread("test_thread");
+    APSARA_TEST_TRUE(profiler->Start());
+    {
+        CpuProfileScope scope(tag);
+        volatile uint64_t sum = 0;
+        clock_t begin = clock();
+        while (clock() - begin < CLOCKS_PER_SEC / 2) {
+            for (uint64_t i = 0; i < 10000; ++i) {
+                sum = sum + i;
+            }
+        }
+    }
+    profiler->Stop();
+
+    APSARA_TEST_TRUE(pluginCounter->GetValue() > 0);
+    APSARA_TEST_EQUAL(pluginCounter->GetValue(), pipelineCounter->GetValue());
+    bool found = false;
+    for (const auto& stack : profiler->FlushStacks()) {
+        if (stack.mConfigName == "sample_config" && stack.mPlugin == "flusher_blackhole/2") {
+            found = true;
+            APSARA_TEST_EQUAL("test_thread", stack.mThreadName);
+            APSARA_TEST_FALSE(stack.mFrames.empty());
+            APSARA_TEST_TRUE(stack.mSamples > 0);
+        }
+    }
+    APSARA_TEST_TRUE(found);
+    APSARA_TEST_TRUE(profiler->FlushStacks().empty());
+#endif
+}
+
+UNIT_TEST_CASE(CpuProfilerUnittest, TestRegisterTag)
+UNIT_TEST_CASE(CpuProfilerUnittest, TestScope)
+UNIT_TEST_CASE(CpuProfilerUnittest, TestSample)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -41,11 +41,15 @@ public:
     void TestCreateMetricAutoDelete();
     void TestCreateMetricAutoDeleteMultiThread();
     void TestCreateAndDeleteMetric();
+    void TestShardedCounter();
+    void TestSnapshotReuse();
 };
 
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateMetricAutoDelete, 0);
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateMetricAutoDeleteMultiThread, 1);
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateAndDeleteMetric, 2);
+APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestShardedCounter, 3);
+APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestSnapshotReuse, 4);
 
 
 void MetricManagerUnittest::TestCreateMetricAutoDelete() {
@@ -335,6 +339,63 @@ void MetricManagerUnittest::TestCreateAndDeleteMetric() {
     delete fileMetric1;
 }
 
+void MetricManagerUnittest::TestShardedCounter() {
+    Counter counter("sharded", 0, 8);
+    TimeCounter timeCounter("sharded_time", 0, 8);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 16; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 1000; ++j) {
+                counter.Add(1);
+                timeCounter.Add(std::chrono::milliseconds(1));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    APSARA_TEST_EQUAL(16000U, counter.GetValue());
+    APSARA_TEST_EQUAL(16000U, timeCounter.GetValue());
+
+    Counter snapshot("");
+    counter.CollectTo(snapshot);
+    APSARA_TEST_EQUAL("sharded", snapshot.GetName());
+    APSARA_TEST_EQUAL(16000U, snapshot.GetValue());
+    APSARA_TEST_EQUAL(0U, counter.GetValue());
+    std::unique_ptr<TimeCounter> timeSnapshot(timeCounter.Collect());
+    APSARA_TEST_EQUAL(16000U, timeSnapshot->GetValue());
+    APSARA_TEST_EQUAL(0U, timeCounter.GetValue());
+}
+
+void MetricManagerUnittest::TestSnapshotReuse() {
+    MetricsRecordRef fileMetric;
+    WriteMetrics::GetInstance()->CreateMetricsRecordRef(
+        fileMetric, MetricCategory::METRIC_CATEGORY_UNKNOWN, {{"project", "project1"}});
+    CounterPtr fileCounter = fileMetric.CreateCounter("filed1", true);
+    IntGaugePtr fileGauge = fileMetric.CreateIntGauge("gauge1");
+    WriteMetrics::GetInstance()->CommitMetricsRecordRef(fileMetric);
+
+    ADD_COUNTER(fileCounter, 1UL);
+    SET_GAUGE(fileGauge, 10UL);
+    ReadMetrics::GetInstance()->UpdateMetrics();
+    MetricsRecord* first = ReadMetrics::GetInstance()->GetHead();
+    ReadMetrics::GetInstance()->UpdateMetrics();
+    APSARA_TEST_NOT_EQUAL(first, ReadMetrics::GetInstance()->GetHead());
+
+    // the snapshot of the first round is reused
+    ADD_COUNTER(fileCounter, 2UL);
+    SET_GAUGE(fileGauge, 20UL);
+    ReadMetrics::GetInstance()->UpdateMetrics();
+    MetricsRecord* third = ReadMetrics::GetInstance()->GetHead();
+    APSARA_TEST_EQUAL(first, third);
+    APSARA_TEST_EQUAL(nullptr, third->GetNext());
+    APSARA_TEST_EQUAL(1U, third->GetCounters().size());
+    APSARA_TEST_EQUAL("filed1", third->GetCounters()[0]->GetName());
+    APSARA_TEST_EQUAL(2U, third->GetCounters()[0]->GetValue());
+    APSARA_TEST_EQUAL(1U, third->GetIntGauges().size());
+    APSARA_TEST_EQUAL(20U, third->GetIntGauges()[0]->GetValue());
+}
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
@@ -31,6 +31,7 @@ public:
     void TestMerge();
     void TestSendInterval();
     void TestGlobalMetrics();
+    void TestHistogram();
 
 private:
     std::shared_ptr<SourceBuffer> mSourceBuffer;
@@ -43,6 +44,7 @@ APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestCreateFromGoMetricMap,
 APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestMerge, 2);
 APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestSendInterval, 3);
 APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestGlobalMetrics, 4);
+APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestHistogram, 5);
 
 void SelfMonitorMetricEventUnittest::TestCreateFromMetricEvent() {
     std::vector<std::pair<std::string, std::string>> labels;
@@ -256,6 +258,64 @@ void SelfMonitorMetricEventUnittest::TestGlobalMetrics() {
     }
 }
 
+void SelfMonitorMetricEventUnittest::TestHistogram() {
+    // bucket boundaries
+    APSARA_TEST_EQUAL(7U, Histogram::GetBucketIndex(7));
+    APSARA_TEST_EQUAL(8U, Histogram::GetBucketIndex(8));
+    APSARA_TEST_EQUAL(15U, Histogram::GetBucketIndex(15));
+    APSARA_TEST_EQUAL(16U, Histogram::GetBucketIndex(16));
+    APSARA_TEST_EQUAL(16U, Histogram::GetBucketIndex(17));
+    APSARA_TEST_EQUAL(Histogram::kBucketCount - 1, Histogram::GetBucketIndex(UINT64_MAX));
+    for (uint64_t val : {0UL, 1UL, 9UL, 100UL, 1000UL, 123456UL, 99999999UL}) {
+        uint64_t upper = Histogram::GetBucketUpperBound(Histogram::GetBucketIndex(val));
+        APSARA_TEST_TRUE(upper >= val);
+        APSARA_TEST_TRUE(upper - val <= val / Histogram::kSubBucketCount);
+        APSARA_TEST_EQUAL(Histogram::GetBucketIndex(val), Histogram::GetBucketIndex(upper));
+        APSARA_TEST_NOT_EQUAL(Histogram::GetBucketIndex(val), Histogram::GetBucketIndex(upper + 1));
+    }
+
+    MetricsRecord* pipelineMetric = new MetricsRecord(MetricCategory::METRIC_CATEGORY_PIPELINE,
+                                                      std::make_shared<MetricLabels>(),
+                                                      std::make_shared<DynamicMetricLabels>());
+    HistogramPtr latency = pipelineMetric->CreateHistogram("latency_ms");
+    // 1ms * 98, 10ms, 1s
+    for (int i = 0; i < 98; ++i) {
+        ADD_HISTOGRAM(latency, std::chrono::milliseconds(1));
+    }
+    ADD_HISTOGRAM(latency, std::chrono::milliseconds(10));
+    ADD_HISTOGRAM(latency, std::chrono::seconds(1));
+    APSARA_TEST_EQUAL(100U, latency->GetCount());
+    APSARA_TEST_EQUAL(1.023, latency->GetPercentile(50));
+    APSARA_TEST_EQUAL(10.239, latency->GetPercentile(99));
+    APSARA_TEST_EQUAL(1048.575, latency->GetPercentile(100));
+
+    SelfMonitorMetricEvent event(pipelineMetric);
+    APSARA_TEST_EQUAL(1.023, event.GetHistogramPercentile("latency_ms", 50));
+    std::unique_ptr<MetricsRecord> snapshot(pipelineMetric->Collect());
+    APSARA_TEST_EQUAL(0U, latency->GetCount());
+    APSARA_TEST_EQUAL(100U, snapshot->GetHistograms()[0]->GetCount());
+
+    // merged events hold the buckets of both, so half of the 200 records are 1s
+    for (int i = 0; i < 100; ++i) {
+        ADD_HISTOGRAM(latency, std::chrono::seconds(1));
+    }
+    event.Merge(SelfMonitorMetricEvent(pipelineMetric));
+    APSARA_TEST_EQUAL(1048.575, event.GetHistogramPercentile("latency_ms", 90));
+
+    mSourceBuffer.reset(new SourceBuffer);
+    mEventGroup.reset(new PipelineEventGroup(mSourceBuffer));
+    mMetricEvent = mEventGroup->CreateMetricEvent();
+    event.ReadAsMetricEvent(mMetricEvent.get());
+    UntypedMultiDoubleValue value;
+    APSARA_TEST_TRUE(mMetricEvent->GetValue<UntypedMultiDoubleValues>()->GetValue("latency_ms_p50", value));
+    APSARA_TEST_EQUAL(1048.575, value.Value);
+    APSARA_TEST_TRUE(mMetricEvent->GetValue<UntypedMultiDoubleValues>()->GetValue("latency_ms_max", value));
+    APSARA_TEST_EQUAL(1048.575, value.Value);
+    APSARA_TEST_EQUAL(0, event.GetHistogramPercentile("latency_ms", 50));
+
+    delete pipelineMetric;
+}
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
@@ -0,0 +1,183 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "collection_pipeline/limiter/ConcurrencyLimiter.h"
+#include "common/Flags.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// A backend with a fixed number of workers and a bounded request queue, driven in virtual time. Requests wait in the
+// queue when all workers are busy, and are rejected after a short delay when the queue is full.
+class SimulatedBackend {
+public:
+    struct Phase {
+        double mEndMs;
+        uint32_t mWorkers;
+        double mServiceMs;
+    };
+
+    SimulatedBackend(vector<Phase> phases, uint32_t queueCapacity, double rejectMs)
+        : mPhases(std::move(phases)), mQueueCapacity(queueCapacity), mRejectMs(rejectMs) {}
+
+    // returns the time the request is done, and whether it succeeded
+    pair<double, bool> Send(double nowMs) {
+        const auto& phase = CurrentPhase(nowMs);
+        // workers are modeled by the time each one is free again, and requests are served in order
+        mWorkerFreeMs.resize(max<size_t>(mWorkerFreeMs.size(), phase.mWorkers), 0.0);
+        while (!mQueuedStartMs.empty() && mQueuedStartMs.front() <= nowMs) {
+            mQueuedStartMs.pop_front();
+        }
+        if (mQueuedStartMs.size() >= mQueueCapacity) {
+            return {nowMs + mRejectMs, false};
+        }
+        auto worker = min_element(mWorkerFreeMs.begin(), mWorkerFreeMs.begin() + phase.mWorkers);
+        double startMs = max(*worker, nowMs);
+        if (startMs > nowMs) {
+            mQueuedStartMs.push_back(startMs);
+        }
+        *worker = startMs + phase.mServiceMs * uniform_real_distribution<double>(0.8, 1.2)(mGen);
+        return {*worker, true};
+    }
+
+private:
+    const Phase& CurrentPhase(double nowMs) const {
+        for (const auto& phase : mPhases) {
+            if (nowMs < phase.mEndMs) {
+                return phase;
+            }
+        }
+        return mPhases.back();
+    }
+
+    vector<Phase> mPhases;
+    uint32_t mQueueCapacity;
+    double mRejectMs;
+    vector<double> mWorkerFreeMs;
+    deque<double> mQueuedStartMs;
+    mt19937 mGen{42};
+};
+
+class ConcurrencyLimiterBenchmark : public testing::Test {
+public:
+    void TestStableBackend();
+    void TestSlowingBackend();
+
+private:
+    struct Result {
+        double mThroughput = 0;
+        double mAvgLatencyMs = 0;
+        double mP99LatencyMs = 0;
+        double mFailRatio = 0;
+        double mAvgLimit = 0;
+    };
+
+    static Result Simulate(bool latencyBased, const vector<SimulatedBackend::Phase>& phases);
+    static void Compare(const vector<SimulatedBackend::Phase>& phases, const string& name);
+};
+
+ConcurrencyLimiterBenchmark::Result ConcurrencyLimiterBenchmark::Simulate(bool latencyBased,
+                                                                          const vector<SimulatedBackend::Phase>& phases) {
+    BOOL_FLAG(enable_latency_based_concurrency_limit) = latencyBased;
+    ConcurrencyLimiter limiter("simulation", 80, 1);
+    BOOL_FLAG(enable_latency_based_concurrency_limit) = false;
+    SimulatedBackend backend(phases, 64, 5);
+
+    // the sender always has data, so it sends whenever the limiter allows
+    using Inflight = pair<double, pair<double, bool>>; // done time, (send time, success)
+    priority_queue<Inflight, vector<Inflight>, greater<>> inflight;
+    auto start = chrono::system_clock::now();
+    double nowMs = 0;
+    double endMs = phases.back().mEndMs;
+    vector<double> latencies;
+    uint64_t success = 0;
+    uint64_t fail = 0;
+    double limitSum = 0;
+    uint64_t limitSamples = 0;
+    while (nowMs < endMs) {
+        while (limiter.IsValidToPop()) {
+            limiter.PostPop();
+            auto res = backend.Send(nowMs);
+            inflight.push({res.first, {nowMs, res.second}});
+        }
+        auto [doneMs, request] = inflight.top();
+        inflight.pop();
+        nowMs = doneMs;
+        auto currentTime = start + chrono::microseconds(static_cast<int64_t>(nowMs * 1000));
+        auto responseTime = chrono::milliseconds(static_cast<int64_t>(doneMs - request.first));
+        if (request.second) {
+            limiter.OnSuccess(currentTime, responseTime);
+            latencies.push_back(doneMs - request.first);
+            ++success;
+        } else {
+            limiter.OnFail(currentTime);
+            ++fail;
+        }
+        limiter.OnSendDone();
+        limitSum += limiter.GetCurrentLimit();
+        ++limitSamples;
+    }
+
+    Result result;
+    result.mThroughput = success * 1000.0 / endMs;
+    sort(latencies.begin(), latencies.end());
+    for (auto latency : latencies) {
+        result.mAvgLatencyMs += latency;
+    }
+    result.mAvgLatencyMs /= max<size_t>(latencies.size(), 1);
+    result.mP99LatencyMs = latencies.empty() ? 0 : latencies[latencies.size() * 99 / 100];
+    result.mFailRatio = static_cast<double>(fail) / max<uint64_t>(success + fail, 1);
+    result.mAvgLimit = limitSum / max<uint64_t>(limitSamples, 1);
+    return result;
+}
+
+void ConcurrencyLimiterBenchmark::Compare(const vector<SimulatedBackend::Phase>& phases, const string& name) {
+    auto lossBased = Simulate(false, phases);
+    auto latencyBased = Simulate(true, phases);
+    for (const auto& [mode, res] : {make_pair("loss", lossBased), make_pair("latency", latencyBased)}) {
+        cout << "[" << name << "][" << mode << "] throughput: " << res.mThroughput
+             << " req/s, avg latency: " << res.mAvgLatencyMs << " ms, p99 latency: " << res.mP99LatencyMs
+             << " ms, fail ratio: " << res.mFailRatio << ", avg limit: " << res.mAvgLimit << endl;
+    }
+    // the latency based mode should keep the backend queue short without losing much throughput
+    APSARA_TEST_TRUE(latencyBased.mAvgLatencyMs < lossBased.mAvgLatencyMs);
+    APSARA_TEST_TRUE(latencyBased.mThroughput > lossBased.mThroughput * 0.9);
+}
+
+void ConcurrencyLimiterBenchmark::TestStableBackend() {
+    // 16 workers with 20ms service time, about 800 req/s
+    Compare({{600000, 16, 20}}, "stable");
+}
+
+void ConcurrencyLimiterBenchmark::TestSlowingBackend() {
+    // the backend gets slower and then loses half of its workers, before it recovers
+    Compare({{200000, 16, 20}, {400000, 16, 40}, {600000, 8, 40}, {800000, 16, 20}}, "slowing");
+}
+
+UNIT_TEST_CASE(ConcurrencyLimiterBenchmark, TestStableBackend)
+UNIT_TEST_CASE(ConcurrencyLimiterBenchmark, TestSlowingBackend)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "collection_pipeline/limiter/ConcurrencyLimiter.h"
+#include "common/Flags.h"
 #include "unittest/Unittest.h"
 
 using namespace std;
@@ -25,6 +26,19 @@ public:
     void TestTimeFallback() const;
     void TestNoTimeFallback() const;
     void TestExponentialBackoffWithMaxDuration() const;
+    void TestLatencyBased() const;
+    void TestLatencyBasedDisabled() const;
+
+private:
+    static void SucceedOnce(ConcurrencyLimiter& limiter,
+                            chrono::milliseconds responseTime,
+                            chrono::system_clock::time_point currentTime = chrono::system_clock::now()) {
+        for (uint32_t i = 0; i < limiter.GetStatisticThreshold(); i++) {
+            limiter.PostPop();
+            limiter.OnSuccess(currentTime, responseTime);
+            limiter.OnSendDone();
+        }
+    }
 };
 
 void ConcurrencyLimiterUnittest::TestLimiter() const {
@@ -403,10 +417,68 @@ void ConcurrencyLimiterUnittest::TestExponentialBackoffWithMaxDuration() const {
     APSARA_TEST_TRUE(limiter->IsValidToPop()); // Should work after 1s (reset to initial)
 }
 
+void ConcurrencyLimiterUnittest::TestLatencyBased() const {
+    BOOL_FLAG(enable_latency_based_concurrency_limit) = true;
+    ConcurrencyLimiter limiter("test_latency_based", 80, 1);
+    BOOL_FLAG(enable_latency_based_concurrency_limit) = false;
+
+    // no queueing delay, stay at maximum
+    SucceedOnce(limiter, chrono::milliseconds(20));
+    APSARA_TEST_EQUAL(20.0, limiter.GetMinRttMs());
+    APSARA_TEST_EQUAL(20.0, limiter.GetSmoothedRttMs());
+    APSARA_TEST_EQUAL(80U, limiter.GetCurrentLimit());
+
+    // backend slows down before failing, decrease until the estimated queue is below beta
+    uint32_t last = limiter.GetCurrentLimit();
+    for (int i = 0; i < 10; i++) {
+        SucceedOnce(limiter, chrono::milliseconds(40));
+        APSARA_TEST_TRUE(limiter.GetCurrentLimit() <= last);
+        last = limiter.GetCurrentLimit();
+    }
+    APSARA_TEST_EQUAL(20.0, limiter.GetMinRttMs());
+    APSARA_TEST_TRUE(limiter.GetCurrentLimit() < 70U);
+
+    // recover when the queueing delay is gone
+    for (int i = 0; i < 30; i++) {
+        SucceedOnce(limiter, chrono::milliseconds(20));
+    }
+    APSARA_TEST_TRUE(limiter.GetCurrentLimit() > last);
+
+    // failures still fall back by ratio
+    limiter.SetCurrentLimit(40);
+    for (uint32_t i = 0; i < limiter.GetStatisticThreshold(); i++) {
+        limiter.PostPop();
+        limiter.OnFail(chrono::system_clock::now());
+        limiter.OnSendDone();
+    }
+    APSARA_TEST_EQUAL(20U, limiter.GetCurrentLimit());
+
+    // min rtt follows a backend whose no-load latency has increased, after two epochs
+    auto curSystemTime = chrono::system_clock::now();
+    for (uint32_t i = 0; i <= 2 * kMinRttEpochSeconds; i++) {
+        SucceedOnce(limiter, chrono::milliseconds(50), curSystemTime + chrono::seconds(i));
+    }
+    APSARA_TEST_EQUAL(50.0, limiter.GetMinRttMs());
+    last = limiter.GetCurrentLimit();
+    SucceedOnce(limiter, chrono::milliseconds(50), curSystemTime + chrono::seconds(2 * kMinRttEpochSeconds + 1));
+    APSARA_TEST_TRUE(limiter.GetCurrentLimit() > last);
+}
+
+void ConcurrencyLimiterUnittest::TestLatencyBasedDisabled() const {
+    ConcurrencyLimiter limiter("test_latency_based_disabled", 80, 1);
+    limiter.SetCurrentLimit(40);
+    SucceedOnce(limiter, chrono::milliseconds(20));
+    SucceedOnce(limiter, chrono::milliseconds(200));
+    APSARA_TEST_EQUAL(42U, limiter.GetCurrentLimit());
+    APSARA_TEST_EQUAL(0.0, limiter.GetMinRttMs());
+}
+
 UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestLimiter)
 UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestTimeFallback)
 UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestNoTimeFallback)
 UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestExponentialBackoffWithMaxDuration)
+UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestLatencyBased)
+UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestLatencyBasedDisabled)
 
 } // namespace logtail
 
@@ -0,0 +1,127 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "collection_pipeline/CollectionPipelineManager.h"
+#include "common/Flags.h"
+#include "config/watcher/PipelineConfigWatcher.h"
+#include "unittest/Unittest.h"
+#include "unittest/plugin/PluginMock.h"
+
+DECLARE_FLAG_INT32(pipeline_build_thread_count);
+
+using namespace std;
+
+namespace logtail {
+
+// Measures the time from config files being found to all pipelines being built, which bounds how soon the first
+// byte can be collected after startup, with a synthetic set of config files.
+class PipelineBuildBenchmark : public testing::Test {
+public:
+    void TestColdStart();
+    void TestTouchedConfigs();
+
+protected:
+    static void SetUpTestCase() {
+        PluginRegistry::GetInstance()->LoadPlugins();
+        LoadPluginMock();
+    }
+
+    static void TearDownTestCase() { PluginRegistry::GetInstance()->UnloadPlugins(); }
+
+    void SetUp() override {
+        filesystem::create_directories(sConfigDir);
+        for (size_t i = 0; i < sConfigCnt; ++i) {
+            ofstream fout(sConfigDir / ("config_" + to_string(i) + ".json"));
+            fout << R"({
+                "inputs": [{"Type": "input_mock"}],
+                "processors": [
+                    {"Type": "processor_mock"},
+                    {"Type": "processor_mock"},
+                    {"Type": "processor_mock"}
+                ],
+                "flushers": [{"Type": "flusher_mock"}]
+            })";
+        }
+    }
+
+    void TearDown() override {
+        PipelineConfigWatcher::GetInstance()->ClearEnvironment();
+        CollectionPipelineManager::GetInstance()->ClearAllPipelines();
+        INT32_FLAG(pipeline_build_thread_count) = 1;
+        filesystem::remove_all(sConfigDir);
+    }
+
+private:
+    static const filesystem::path sConfigDir;
+    static const size_t sConfigCnt = 500;
+};
+
+const filesystem::path PipelineBuildBenchmark::sConfigDir = "./pipeline_build_benchmark_config";
+
+void PipelineBuildBenchmark::TestColdStart() {
+    for (int32_t threadCnt : {1, 2, 4, 8}) {
+        PipelineConfigWatcher::GetInstance()->ClearEnvironment();
+        PipelineConfigWatcher::GetInstance()->AddSource(sConfigDir.string());
+        INT32_FLAG(pipeline_build_thread_count) = threadCnt;
+
+        auto start = chrono::steady_clock::now();
+        auto diff = PipelineConfigWatcher::GetInstance()->CheckConfigDiff();
+        auto scanDone = chrono::steady_clock::now();
+        auto pipelines = CollectionPipelineManager::GetInstance()->BuildPipelines(diff.first.mAdded);
+        auto buildDone = chrono::steady_clock::now();
+
+        size_t builtCnt = 0;
+        for (const auto& p : pipelines) {
+            builtCnt += p != nullptr;
+        }
+        APSARA_TEST_EQUAL(sConfigCnt, builtCnt);
+        cout << "[cold start][" << threadCnt << " threads] configs: " << sConfigCnt
+             << ", scan: " << chrono::duration_cast<chrono::milliseconds>(scanDone - start).count()
+             << " ms, build: " << chrono::duration_cast<chrono::milliseconds>(buildDone - scanDone).count()
+             << " ms, total: " << chrono::duration_cast<chrono::milliseconds>(buildDone - start).count() << " ms"
+             << endl;
+    }
+}
+
+void PipelineBuildBenchmark::TestTouchedConfigs() {
+    PipelineConfigWatcher::GetInstance()->AddSource(sConfigDir.string());
+    auto diff = PipelineConfigWatcher::GetInstance()->CheckConfigDiff();
+    CollectionPipelineManager::GetInstance()->UpdatePipelines(diff.first);
+    APSARA_TEST_EQUAL(sConfigCnt, CollectionPipelineManager::GetInstance()->GetPipelineCount());
+
+    // only mtime is changed, e.g. config files rewritten by a config provider with the same content
+    for (size_t i = 0; i < sConfigCnt; ++i) {
+        auto path = sConfigDir / ("config_" + to_string(i) + ".json");
+        filesystem::last_write_time(path, filesystem::last_write_time(path) + chrono::seconds(1));
+    }
+    auto start = chrono::steady_clock::now();
+    diff = PipelineConfigWatcher::GetInstance()->CheckConfigDiff();
+    auto scanDone = chrono::steady_clock::now();
+    APSARA_TEST_FALSE(diff.first.HasDiff());
+    cout << "[touched configs] configs: " << sConfigCnt
+         << ", scan: " << chrono::duration_cast<chrono::milliseconds>(scanDone - start).count() << " ms" << endl;
+}
+
+UNIT_TEST_CASE(PipelineBuildBenchmark, TestColdStart)
+UNIT_TEST_CASE(PipelineBuildBenchmark, TestTouchedConfigs)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,545 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipeline.h"
+#include "collection_pipeline/batch/TimeoutFlushManager.h"
+#include "collection_pipeline/plugin/PluginRegistry.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "collection_pipeline/queue/SenderQueueManager.h"
+#include "common/DevInode.h"
+#include "common/Flags.h"
+#include "common/JsonUtil.h"
+#include "common/StringTools.h"
+#include "config/CollectionConfig.h"
+#include "file_server/reader/LogFileReader.h"
+#include "plugin/input/InputFile.h"
+#include "unittest/Unittest.h"
+
+DEFINE_FLAG_STRING(e2e_benchmark_flushers,
+                   "flushers the pipelines end in, separated by comma, flusher_sls serializes and compresses the data "
+                   "and its sender queue is drained locally instead of sending by http",
+                   "flusher_blackhole,flusher_sls");
+DEFINE_FLAG_INT32(e2e_benchmark_file_count, "count of files the events are written to", 10);
+DEFINE_FLAG_INT32(e2e_benchmark_event_count, "count of events of each workload when no rate is given", 100000);
+DEFINE_FLAG_INT32(e2e_benchmark_rate, "events written per second, 0 means all events are written at once", 0);
+DEFINE_FLAG_INT32(e2e_benchmark_duration_sec, "how long the events are written when a rate is given", 10);
+DEFINE_FLAG_STRING(e2e_benchmark_report_file, "file the json report lines are appended to besides stdout", "");
+
+using namespace std;
+
+namespace logtail {
+
+enum class Workload { PLAIN, JSON, CSV, MULTILINE, CONTAINER_STDIO };
+
+// Measures the whole way of synthetic logs from files through real pipelines to the flusher, i.e. reading, inner and
+// user processors, batching, serialization and sender queues. Each run reports one json line with events/s, cpu per
+// event, rss and latency of each stage, so that results of two builds can be compared by CI.
+//
+// e.g. pipeline_e2e_benchmark --gtest_filter=*TestJson --e2e_benchmark_rate=20000 --e2e_benchmark_file_count=100
+class PipelineE2EBenchmark : public testing::Test {
+public:
+    void TestPlain();
+    void TestJson();
+    void TestCsv();
+    void TestMultiline();
+    void TestContainerStdio();
+
+protected:
+    static void SetUpTestCase() { PluginRegistry::GetInstance()->LoadPlugins(); }
+
+    static void TearDownTestCase() { PluginRegistry::GetInstance()->UnloadPlugins(); }
+
+    void TearDown() override { Clear(); }
+
+private:
+    struct Stage {
+        explicit Stage(const string& name) : mName(name) {}
+
+        void Add(chrono::steady_clock::duration cost) { mCosts.push_back(cost); }
+        Json::Value Report(uint64_t eventCnt);
+
+        string mName;
+        vector<chrono::steady_clock::duration> mCosts;
+    };
+
+    void Run(Workload workload, const string& workloadName);
+    void RunWithFlusher(Workload workload, const string& workloadName, const string& flusher);
+    // releases the pipeline, queues and files of the last run
+    void Clear();
+    bool BuildPipeline(Workload workload, const string& flusher);
+    bool CreateReaders(Workload workload);
+    // returns the count of events written
+    uint64_t WriteEvents(Workload workload, uint64_t eventCnt);
+    void ReadAndSend(Stage& read, Stage& process, Stage& send, Stage& sink, uint64_t& outEventCnt);
+    uint64_t DrainSenderQueues();
+
+    static string MakeEvent(Workload workload, uint64_t idx);
+    static uint64_t GetRssKB();
+    static uint64_t GetPeakRssKB();
+
+    static const filesystem::path sTestDir;
+
+    shared_ptr<CollectionPipeline> mPipeline;
+    FileReaderOptions mContainerReaderOpts;
+    FileDiscoveryOptions mDiscoveryOpts;
+    vector<LogFileReaderPtr> mReaders;
+    vector<filesystem::path> mFiles;
+    uint64_t mEventIdx = 0;
+    uint64_t mWrittenBytes = 0;
+    uint64_t mSinkBytes = 0;
+};
+
+const filesystem::path PipelineE2EBenchmark::sTestDir = "./pipeline_e2e_benchmark";
+
+Json::Value PipelineE2EBenchmark::Stage::Report(uint64_t eventCnt) {
+    Json::Value res;
+    chrono::steady_clock::duration total{0};
+    for (const auto& cost : mCosts) {
+        total += cost;
+    }
+    sort(mCosts.begin(), mCosts.end());
+    auto percentileUs = [&](double p) -> Json::UInt64 {
+        if (mCosts.empty()) {
+            return 0;
+        }
+        auto idx = min(mCosts.size() - 1, static_cast<size_t>(p * mCosts.size()));
+        return chrono::duration_cast<chrono::microseconds>(mCosts[idx]).count();
+    };
+    auto totalNs = chrono::duration_cast<chrono::nanoseconds>(total).count();
+    res["total_ms"] = static_cast<double>(totalNs) / 1e6;
+    res["ns_per_event"] = eventCnt == 0 ? 0.0 : static_cast<double>(totalNs) / eventCnt;
+    res["batches"] = static_cast<Json::UInt64>(mCosts.size());
+    res["p50_us"] = percentileUs(0.5);
+    res["p99_us"] = percentileUs(0.99);
+    res["max_us"] = percentileUs(1.0);
+    return res;
+}
+
+void PipelineE2EBenchmark::Run(Workload workload, const string& workloadName) {
+    for (const auto& flusher : SplitString(STRING_FLAG(e2e_benchmark_flushers), ",")) {
+        RunWithFlusher(workload, workloadName, flusher);
+        Clear();
+    }
+}
+
+void PipelineE2EBenchmark::Clear() {
+    mReaders.clear();
+    mPipeline.reset();
+    TimeoutFlushManager::GetInstance()->mTimeoutRecords.clear();
+    SenderQueueManager::GetInstance()->Clear();
+    ProcessQueueManager::GetInstance()->Clear();
+    QueueKeyManager::GetInstance()->Clear();
+    filesystem::remove_all(sTestDir);
+}
+
+void PipelineE2EBenchmark::RunWithFlusher(Workload workload, const string& workloadName, const string& flusher) {
+    filesystem::remove_all(sTestDir);
+    filesystem::create_directories(sTestDir);
+    mFiles.clear();
+    for (int32_t i = 0; i < max(INT32_FLAG(e2e_benchmark_file_count), 1); ++i) {
+        mFiles.emplace_back(filesystem::absolute(sTestDir / ("file_" + to_string(i) + ".log")));
+        ofstream(mFiles.back());
+    }
+    mEventIdx = 0;
+    mWrittenBytes = 0;
+    mSinkBytes = 0;
+    APSARA_TEST_TRUE_FATAL(BuildPipeline(workload, flusher));
+    APSARA_TEST_TRUE_FATAL(CreateReaders(workload));
+
+    Stage read("read"), process("process"), send("send"), sink("sink");
+    uint64_t inEventCnt = 0, outEventCnt = 0;
+    clock_t cpu = 0;
+    auto start = chrono::steady_clock::now();
+    if (INT32_FLAG(e2e_benchmark_rate) <= 0) {
+        inEventCnt = WriteEvents(workload, static_cast<uint64_t>(max(INT32_FLAG(e2e_benchmark_event_count), 1)));
+        start = chrono::steady_clock::now();
+        clock_t before = clock();
+        ReadAndSend(read, process, send, sink, outEventCnt);
+        cpu += clock() - before;
+    } else {
+        // events are written in rounds of 100ms, so that the pipeline sees a steady flow instead of one burst
+        const auto round = chrono::milliseconds(100);
+        const uint64_t eventsPerRound = max<uint64_t>(INT32_FLAG(e2e_benchmark_rate) / 10, 1);
+        const auto roundCnt = static_cast<uint64_t>(max(INT32_FLAG(e2e_benchmark_duration_sec), 1)) * 10;
+        for (uint64_t i = 0; i < roundCnt; ++i) {
+            auto roundEnd = start + round * (i + 1);
+            inEventCnt += WriteEvents(workload, eventsPerRound);
+            clock_t before = clock();
+            ReadAndSend(read, process, send, sink, outEventCnt);
+            cpu += clock() - before;
+            this_thread::sleep_until(roundEnd);
+        }
+    }
+    // what is left in the batchers is flushed as it is when the pipeline is stopped
+    {
+        clock_t before = clock();
+        auto sendStart = chrono::steady_clock::now();
+        mPipeline->FlushBatch();
+        auto sinkStart = chrono::steady_clock::now();
+        send.Add(sinkStart - sendStart);
+        DrainSenderQueues();
+        sink.Add(chrono::steady_clock::now() - sinkStart);
+        cpu += clock() - before;
+    }
+    auto wall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double cpuSec = static_cast<double>(cpu) / CLOCKS_PER_SEC;
+    double busySec = 0;
+    for (auto* stage : {&read, &process, &send, &sink}) {
+        for (const auto& cost : stage->mCosts) {
+            busySec += chrono::duration<double>(cost).count();
+        }
+    }
+
+    Json::Value report;
+    report["benchmark"] = "pipeline_e2e";
+    report["workload"] = workloadName;
+    report["flusher"] = flusher;
+#ifdef NDEBUG
+    report["build"] = "release";
+#else
+    report["build"] = "debug";
+#endif
+    report["files"] = static_cast<Json::UInt64>(mFiles.size());
+    report["rate"] = INT32_FLAG(e2e_benchmark_rate);
+    report["in_events"] = static_cast<Json::UInt64>(inEventCnt);
+    report["out_events"] = static_cast<Json::UInt64>(outEventCnt);
+    report["in_bytes"] = static_cast<Json::UInt64>(mWrittenBytes);
+    report["out_bytes"] = static_cast<Json::UInt64>(mSinkBytes);
+    report["wall_sec"] = wall;
+    // wall clock throughput, bounded by e2e_benchmark_rate if set, while the busy one only counts the time spent in
+    // the stages, i.e. the capacity of the pipeline
+    report["events_per_sec"] = wall > 0 ? inEventCnt / wall : 0.0;
+    report["busy_events_per_sec"] = busySec > 0 ? inEventCnt / busySec : 0.0;
+    report["cpu_sec"] = cpuSec;
+    report["cpu_ns_per_event"] = inEventCnt == 0 ? 0.0 : cpuSec * 1e9 / inEventCnt;
+    report["rss_kb"] = static_cast<Json::UInt64>(GetRssKB());
+    report["peak_rss_kb"] = static_cast<Json::UInt64>(GetPeakRssKB());
+    for (auto* stage : {&read, &process, &send, &sink}) {
+        report["stages"][stage->mName] = stage->Report(inEventCnt);
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    auto line = Json::writeString(builder, report);
+    cout << line << endl;
+    if (!STRING_FLAG(e2e_benchmark_report_file).empty()) {
+        ofstream(STRING_FLAG(e2e_benchmark_report_file), ios::app) << line << endl;
+    }
+    APSARA_TEST_TRUE(outEventCnt > 0);
+}
+
+bool PipelineE2EBenchmark::BuildPipeline(Workload workload, const string& flusher) {
+    Json::Value input;
+    input["Type"] = "input_file";
+    input["FilePaths"].append((filesystem::absolute(sTestDir) / "*.log").string());
+    Json::Value processors(Json::arrayValue);
+    switch (workload) {
+        case Workload::PLAIN:
+            break;
+        case Workload::JSON: {
+            Json::Value processor;
+            processor["Type"] = "processor_parse_json_native";
+            processor["SourceKey"] = "content";
+            processors.append(processor);
+            break;
+        }
+        case Workload::CSV: {
+            Json::Value processor;
+            processor["Type"] = "processor_parse_delimiter_native";
+            processor["SourceKey"] = "content";
+            processor["Separator"] = ",";
+            processor["Quote"] = "\"";
+            for (const auto& key : {"time", "ip", "method", "url", "status", "size", "agent"}) {
+                processor["Keys"].append(key);
+            }
+            processors.append(processor);
+            break;
+        }
+        case Workload::MULTILINE:
+            input["Multiline"]["Mode"] = "custom";
+            input["Multiline"]["StartPattern"] = R"(\d{4}-\d{2}-\d{2} .*)";
+            break;
+        case Workload::CONTAINER_STDIO: {
+            // the inner processor of input_container_stdio, which needs no container to be discovered
+            Json::Value processor;
+            processor["Type"] = "processor_parse_container_log_native";
+            processors.append(processor);
+            break;
+        }
+    }
+
+    auto configJson = make_unique<Json::Value>();
+    (*configJson)["inputs"].append(input);
+    (*configJson)["processors"] = processors;
+    Json::Value flusherConfig;
+    flusherConfig["Type"] = flusher;
+    if (flusher == "flusher_sls") {
+        flusherConfig["Project"] = "e2e_benchmark_project";
+        flusherConfig["Logstore"] = "e2e_benchmark_logstore";
+        flusherConfig["Region"] = "e2e_benchmark_region";
+        flusherConfig["Endpoint"] = "127.0.0.1";
+    }
+    (*configJson)["flushers"].append(flusherConfig);
+
+    CollectionConfig config("e2e_benchmark", std::move(configJson), sTestDir / "e2e_benchmark.json");
+    if (!config.Parse()) {
+        return false;
+    }
+    mPipeline = make_shared<CollectionPipeline>();
+    return mPipeline->Init(std::move(config));
+}
+
+bool PipelineE2EBenchmark::CreateReaders(Workload workload) {
+    const auto& ctx = mPipeline->GetContext();
+    const auto* input = static_cast<const InputFile*>(mPipeline->GetInputs()[0]->GetPlugin());
+    const FileReaderOptions* readerOpts = &input->mFileReader;
+    if (workload == Workload::CONTAINER_STDIO) {
+        mContainerReaderOpts = input->mFileReader;
+        mContainerReaderOpts.mInputType = FileReaderOptions::InputType::InputContainerStdio;
+        readerOpts = &mContainerReaderOpts;
+    }
+    mReaders.clear();
+    for (const auto& file : mFiles) {
+        LogFileReaderPtr reader(LogFileReader::CreateLogFileReader(file.parent_path().string(),
+                                                                   file.filename().string(),
+                                                                   GetFileDevInode(file.string()),
+                                                                   make_pair(readerOpts, &ctx),
+                                                                   make_pair(&input->mMultiline, &ctx),
+                                                                   make_pair(&mDiscoveryOpts, &ctx),
+                                                                   make_pair(&input->mFileTag, &ctx),
+                                                                   0,
+                                                                   true));
+        if (!reader || !reader->UpdateFilePtr()) {
+            return false;
+        }
+        mReaders.push_back(reader);
+    }
+    return true;
+}
+
+uint64_t PipelineE2EBenchmark::WriteEvents(Workload workload, uint64_t eventCnt) {
+    // events are spread over the files evenly, and each file is appended once
+    vector<string> contents(mFiles.size());
+    for (uint64_t i = 0; i < eventCnt; ++i, ++mEventIdx) {
+        contents[mEventIdx % mFiles.size()] += MakeEvent(workload, mEventIdx);
+    }
+    for (size_t i = 0; i < mFiles.size(); ++i) {
+        ofstream(mFiles[i], ios::app | ios::binary) << contents[i];
+        mWrittenBytes += contents[i].size();
+    }
+    return eventCnt;
+}
+
+void PipelineE2EBenchmark::ReadAndSend(Stage& read, Stage& process, Stage& send, Stage& sink, uint64_t& outEventCnt) {
+    for (const auto& reader : mReaders) {
+        // the same as what a modify event of the file leads to
+        auto readStart = chrono::steady_clock::now();
+        vector<PipelineEventGroup> groups;
+        if (reader->CheckFileSignatureAndOffset(true)) {
+            bool moreData = true;
+            while (moreData) {
+                LogBuffer logBuffer;
+                moreData = reader->ReadLog(logBuffer, nullptr);
+                if (logBuffer.rawBuffer.empty()) {
+                    break;
+                }
+                groups.emplace_back(LogFileReader::GenerateEventGroup(reader, &logBuffer));
+            }
+        }
+        auto processStart = chrono::steady_clock::now();
+        read.Add(processStart - readStart);
+        if (groups.empty()) {
+            continue;
+        }
+
+        mPipeline->Process(groups, 0);
+        for (const auto& group : groups) {
+            outEventCnt += group.GetEvents().size();
+        }
+        auto sendStart = chrono::steady_clock::now();
+        process.Add(sendStart - processStart);
+
+        mPipeline->Send(std::move(groups));
+        auto sinkStart = chrono::steady_clock::now();
+        send.Add(sinkStart - sendStart);
+
+        DrainSenderQueues();
+        sink.Add(chrono::steady_clock::now() - sinkStart);
+    }
+}
+
+uint64_t PipelineE2EBenchmark::DrainSenderQueues() {
+    // stands in for the flusher runner and the http sink, so that sender queues never block the pipeline
+    uint64_t cnt = 0;
+    vector<SenderQueueItem*> items;
+    while (true) {
+        items.clear();
+        SenderQueueManager::GetInstance()->GetAvailableItems(items, -1);
+        if (items.empty()) {
+            break;
+        }
+        for (auto* item : items) {
+            mSinkBytes += item->mData.size();
+            SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
+            ++cnt;
+        }
+    }
+    return cnt;
+}
+
+string PipelineE2EBenchmark::MakeEvent(Workload workload, uint64_t idx) {
+    char buf[512];
+    int sec = static_cast<int>(idx % 60);
+    int status = idx % 10 == 0 ? 503 : 200;
+    switch (workload) {
+        case Workload::PLAIN:
+            snprintf(buf,
+                     sizeof(buf),
+                     "2025-01-01 12:00:%02d.%03d INFO [worker-%d] request %llu handled, status %d, cost %dms\n",
+                     sec,
+                     static_cast<int>(idx % 1000),
+                     static_cast<int>(idx % 16),
+                     static_cast<unsigned long long>(idx),
+                     status,
+                     static_cast<int>(idx % 300));
+            break;
+        case Workload::JSON:
+            snprintf(buf,
+                     sizeof(buf),
+                     R"({"time":"2025-01-01 12:00:%02d","level":"INFO","ip":"10.0.%d.%d","method":"GET",)"
+                     R"("url":"/api/v1/users/%llu","status":%d,"size":%d,"msg":"request handled"})"
+                     "\n",
+                     sec,
+                     static_cast<int>(idx / 256 % 256),
+                     static_cast<int>(idx % 256),
+                     static_cast<unsigned long long>(idx),
+                     status,
+                     static_cast<int>(100 + idx % 1000));
+            break;
+        case Workload::CSV:
+            snprintf(buf,
+                     sizeof(buf),
+                     "2025-01-01 12:00:%02d,10.0.%d.%d,GET,/api/v1/users/%llu,%d,%d,\"Mozilla/5.0 (X11, Linux)\"\n",
+                     sec,
+                     static_cast<int>(idx / 256 % 256),
+                     static_cast<int>(idx % 256),
+                     static_cast<unsigned long long>(idx),
+                     status,
+                     static_cast<int>(100 + idx % 1000));
+            break;
+        case Workload::MULTILINE:
+            snprintf(buf,
+                     sizeof(buf),
+                     "2025-01-01 12:00:%02d ERROR request %llu failed\n"
+                     "java.lang.IllegalStateException: status %d\n"
+                     "\tat com.example.Handler.handle(Handler.java:%d)\n"
+                     "\tat com.example.Server.run(Server.java:42)\n",
+                     sec,
+                     static_cast<unsigned long long>(idx),
+                     status,
+                     static_cast<int>(idx % 500));
+            break;
+        case Workload::CONTAINER_STDIO:
+            snprintf(buf,
+                     sizeof(buf),
+                     R"({"log":"2025-01-01 12:00:%02d INFO request %llu handled, status %d\n",)"
+                     R"("stream":"%s","time":"2025-01-01T12:00:%02d.%09dZ"})"
+                     "\n",
+                     sec,
+                     static_cast<unsigned long long>(idx),
+                     status,
+                     idx % 4 == 0 ? "stderr" : "stdout",
+                     sec,
+                     static_cast<int>(idx % 1000000000));
+            break;
+    }
+    return buf;
+}
+
+uint64_t PipelineE2EBenchmark::GetRssKB() {
+#if defined(__linux__)
+    ifstream fin("/proc/self/statm");
+    uint64_t size = 0, rss = 0;
+    fin >> size >> rss;
+    return rss * getpagesize() / 1024;
+#else
+    return 0;
+#endif
+}
+
+uint64_t PipelineE2EBenchmark::GetPeakRssKB() {
+#if defined(__linux__)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return static_cast<uint64_t>(usage.ru_maxrss);
+    }
+#endif
+    return 0;
+}
+
+void PipelineE2EBenchmark::TestPlain() {
+    Run(Workload::PLAIN, "plain");
+}
+
+void PipelineE2EBenchmark::TestJson() {
+    Run(Workload::JSON, "json");
+}
+
+void PipelineE2EBenchmark::TestCsv() {
+    Run(Workload::CSV, "csv");
+}
+
+void PipelineE2EBenchmark::TestMultiline() {
+    Run(Workload::MULTILINE, "multiline");
+}
+
+void PipelineE2EBenchmark::TestContainerStdio() {
+    Run(Workload::CONTAINER_STDIO, "container_stdio");
+}
+
+UNIT_TEST_CASE(PipelineE2EBenchmark, TestPlain)
+UNIT_TEST_CASE(PipelineE2EBenchmark, TestJson)
+UNIT_TEST_CASE(PipelineE2EBenchmark, TestCsv)
+UNIT_TEST_CASE(PipelineE2EBenchmark, TestMultiline)
+UNIT_TEST_CASE(PipelineE2EBenchmark, TestContainerStdio)
+
+} // namespace logtail
+
+int main(int argc, char** argv) {
+    InitUnittestMain();
+    ::testing::InitGoogleTest(&argc, argv);
+    // the rest of the arguments are the e2e_benchmark_* flags
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    ::testing::AddGlobalTestEnvironment(new GlobalEnvironment);
+    return RUN_ALL_TESTS();
+}
@@ -14,7 +14,12 @@
 
 #include "collection_pipeline/CollectionPipeline.h"
 #include "collection_pipeline/CollectionPipelineManager.h"
+#include "common/Flags.h"
+#include "common/JsonUtil.h"
 #include "unittest/Unittest.h"
+#include "unittest/plugin/PluginMock.h"
+
+DECLARE_FLAG_INT32(pipeline_build_thread_count);
 
 using namespace std;
 
@@ -23,6 +28,19 @@ namespace logtail {
 class PipelineManagerUnittest : public testing::Test {
 public:
     void TestPipelineManagement() const;
+    void TestBuildPipelines() const;
+
+protected:
+    static void SetUpTestCase() {
+        PluginRegistry::GetInstance()->LoadPlugins();
+        LoadPluginMock();
+    }
+
+    static void TearDownTestCase() { PluginRegistry::GetInstance()->UnloadPlugins(); }
+
+    void TearDown() override {
+        INT32_FLAG(pipeline_build_thread_count) = 1;
+    }
 };
 
 void PipelineManagerUnittest::TestPipelineManagement() const {
@@ -34,7 +52,37 @@ void PipelineManagerUnittest::TestPipelineManagement() const {
     APSARA_TEST_EQUAL(nullptr, CollectionPipelineManager::GetInstance()->FindConfigByName("test3"));
 }
 
+void PipelineManagerUnittest::TestBuildPipelines() const {
+    for (int32_t threadCnt : {1, 4}) {
+        INT32_FLAG(pipeline_build_thread_count) = threadCnt;
+        vector<CollectionConfig> configs;
+        for (size_t i = 0; i < 10; ++i) {
+            auto detail = make_unique<Json::Value>();
+            string errorMsg;
+            string content = R"({"inputs": [{"Type": "input_mock"}], "flushers": [{"Type": "flusher_mock"}]})";
+            if (i == 3) {
+                // failed to init, since mandatory params of flusher_sls are missing
+                content = R"({"inputs": [{"Type": "input_mock"}], "flushers": [{"Type": "flusher_sls"}]})";
+            }
+            APSARA_TEST_TRUE(ParseJsonTable(content, *detail, errorMsg));
+            configs.emplace_back("test_" + to_string(threadCnt) + "_" + to_string(i), std::move(detail), "");
+            APSARA_TEST_TRUE(configs.back().Parse());
+        }
+        auto pipelines = CollectionPipelineManager::GetInstance()->BuildPipelines(configs);
+        APSARA_TEST_EQUAL(configs.size(), pipelines.size());
+        for (size_t i = 0; i < pipelines.size(); ++i) {
+            if (i == 3) {
+                APSARA_TEST_EQUAL(nullptr, pipelines[i]);
+                continue;
+            }
+            APSARA_TEST_NOT_EQUAL(nullptr, pipelines[i]);
+            APSARA_TEST_EQUAL(configs[i].mName, pipelines[i]->Name());
+        }
+    }
+}
+
 UNIT_TEST_CASE(PipelineManagerUnittest, TestPipelineManagement)
+UNIT_TEST_CASE(PipelineManagerUnittest, TestBuildPipelines)
 
 } // namespace logtail
 
@@ -24,6 +24,7 @@
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
 #include "collection_pipeline/plugin/PluginRegistry.h"
 #include "collection_pipeline/queue/CountBoundedProcessQueue.h"
+#include "collection_pipeline/queue/PendingPushManager.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "common/JsonUtil.h"
@@ -2417,9 +2418,11 @@ void PipelineUnittest::TestProcessQueue() const {
     APSARA_TEST_EQUAL(configName, (*que)->GetConfigName());
     APSARA_TEST_EQUAL(key, (*que)->GetKey());
     APSARA_TEST_EQUAL(0U, (*que)->GetPriority());
-    APSARA_TEST_EQUAL(1U, static_cast<CountBoundedProcessQueue*>(que->get())->mUpStreamFeedbacks.size());
+    APSARA_TEST_EQUAL(2U, static_cast<CountBoundedProcessQueue*>(que->get())->mUpStreamFeedbacks.size());
     APSARA_TEST_EQUAL(InputFeedbackInterfaceRegistry::GetInstance()->GetFeedbackInterface("input_file"),
                       static_cast<CountBoundedProcessQueue*>(que->get())->mUpStreamFeedbacks[0]);
+    APSARA_TEST_EQUAL(PendingPushManager::GetInstance(),
+                      static_cast<CountBoundedProcessQueue*>(que->get())->mUpStreamFeedbacks[1]);
     APSARA_TEST_EQUAL(1U, (*que)->mDownStreamQueues.size());
     // pipeline level
     APSARA_TEST_EQUAL(key, pipeline->GetContext().GetProcessQueueKey());
@@ -2997,8 +3000,8 @@ void PipelineUnittest::TestFlushBatch() const {
     }
     {
         // all successful
-        TimeoutFlushManager::GetInstance()->UpdateRecord(configName, 0, 1, 3, nullptr);
-        TimeoutFlushManager::GetInstance()->UpdateRecord(configName, 1, 1, 3, nullptr);
+        TimeoutFlushManager::GetInstance()->UpdateRecord(configName, 0, 1, 3000, nullptr);
+        TimeoutFlushManager::GetInstance()->UpdateRecord(configName, 1, 1, 3000, nullptr);
         APSARA_TEST_TRUE(pipeline.FlushBatch());
         APSARA_TEST_EQUAL(0U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
         APSARA_TEST_EQUAL(2U, TimeoutFlushManager::GetInstance()->mDeletedFlushers.size());
@@ -3007,8 +3010,8 @@ void PipelineUnittest::TestFlushBatch() const {
     {
         // some failed
         const_cast<FlusherMock*>(static_cast<const FlusherMock*>(pipeline.mFlushers[0]->GetPlugin()))->mIsValid = false;
-        TimeoutFlushManager::GetInstance()->UpdateRecord(configName, 0, 1, 3, nullptr);
-        TimeoutFlushManager::GetInstance()->UpdateRecord(configName, 1, 1, 3, nullptr);
+        TimeoutFlushManager::GetInstance()->UpdateRecord(configName, 0, 1, 3000, nullptr);
+        TimeoutFlushManager::GetInstance()->UpdateRecord(configName, 1, 1, 3000, nullptr);
         APSARA_TEST_FALSE(pipeline.FlushBatch());
         APSARA_TEST_EQUAL(0U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
         APSARA_TEST_EQUAL(2U, TimeoutFlushManager::GetInstance()->mDeletedFlushers.size());
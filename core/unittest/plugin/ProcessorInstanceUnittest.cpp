@@ -22,11 +22,56 @@ using namespace std;
 
 namespace logtail {
 
+// appends its tag to the content "path" of each event, and discards the events with the content "drop" equal to it
+class EventProcessorMock : public Processor {
+public:
+    static const string sName;
+
+    explicit EventProcessorMock(string tag) : mTag(std::move(tag)) {}
+
+    const string& Name() const override { return sName; }
+    bool Init([[maybe_unused]] const Json::Value& config) override { return true; }
+    void Process(PipelineEventGroup& logGroup) override {
+        ++mGroupCnt;
+        EventProcessContext context(logGroup);
+        auto& events = logGroup.MutableEvents();
+        size_t wIdx = 0;
+        for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
+            if (ProcessEvent(events[rIdx], context)) {
+                if (wIdx != rIdx) {
+                    events[wIdx] = std::move(events[rIdx]);
+                }
+                ++wIdx;
+            }
+        }
+        events.resize(wIdx);
+    }
+    bool SupportsEventProcessing() const override { return true; }
+    bool ProcessEvent(PipelineEventPtr& e, [[maybe_unused]] EventProcessContext& context) override {
+        ++mEventCnt;
+        auto& logEvent = e.Cast<LogEvent>();
+        logEvent.SetContent(string("path"), logEvent.GetContent("path").to_string() + mTag);
+        return logEvent.GetContent("drop") != mTag;
+    }
+
+    uint32_t mGroupCnt = 0;
+    uint32_t mEventCnt = 0;
+
+protected:
+    bool IsSupportedEvent([[maybe_unused]] const PipelineEventPtr& e) const override { return true; }
+
+private:
+    string mTag;
+};
+
+const string EventProcessorMock::sName = "event_processor_mock";
+
 class ProcessorInstanceUnittest : public testing::Test {
 public:
     void TestName() const;
     void TestInit() const;
     void TestProcess() const;
+    void TestProcessFused() const;
 };
 
 void ProcessorInstanceUnittest::TestName() const {
@@ -63,9 +108,73 @@ void ProcessorInstanceUnittest::TestProcess() const {
     APSARA_TEST_EQUAL(1U, static_cast<ProcessorMock*>(processor->mPlugin.get())->mCnt);
 }
 
+static vector<unique_ptr<ProcessorInstance>> CreateEventProcessors(CollectionPipelineContext& context) {
+    vector<unique_ptr<ProcessorInstance>> processors;
+    for (const auto& tag : {"a", "b", "c"}) {
+        processors.emplace_back(
+            make_unique<ProcessorInstance>(new EventProcessorMock(tag), PluginInstance::PluginMeta(tag)));
+        APSARA_TEST_TRUE(processors.back()->Init(Json::Value(), context));
+        APSARA_TEST_TRUE(processors.back()->SupportsEventProcessing());
+    }
+    return processors;
+}
+
+static vector<PipelineEventGroup> CreateEventGroups() {
+    vector<PipelineEventGroup> groups;
+    for (size_t i = 0; i < 2; ++i) {
+        auto& group = groups.emplace_back(make_shared<SourceBuffer>());
+        group.SetTag(string("tag"), string("value"));
+        for (const auto& drop : {"", "b", "", "a"}) {
+            auto* e = group.AddLogEvent();
+            e->SetContent(string("drop"), string(drop));
+        }
+    }
+    return groups;
+}
+
+void ProcessorInstanceUnittest::TestProcessFused() const {
+    CollectionPipelineContext context;
+    auto processors = CreateEventProcessors(context);
+    APSARA_TEST_FALSE(ProcessorInstance(new ProcessorMock(), PluginInstance::PluginMeta("0")).SupportsEventProcessing());
+
+    auto groups = CreateEventGroups();
+    ProcessorInstance::ProcessFused(processors, 0, 3, groups);
+    for (const auto& group : groups) {
+        // the kept events are still in order, and the discarded ones are not passed to the following processors
+        APSARA_TEST_EQUAL(2U, group.GetEvents().size());
+        for (const auto& e : group.GetEvents()) {
+            APSARA_TEST_EQUAL("abc", e.Cast<LogEvent>().GetContent("path").to_string());
+            APSARA_TEST_EQUAL("", e.Cast<LogEvent>().GetContent("drop").to_string());
+        }
+    }
+    vector<uint32_t> expectedEventCnts = {8, 6, 4};
+    vector<uint64_t> expectedOutCnts = {6, 4, 4};
+    for (size_t i = 0; i < processors.size(); ++i) {
+        auto* plugin = static_cast<EventProcessorMock*>(processors[i]->mPlugin.get());
+        APSARA_TEST_EQUAL(0U, plugin->mGroupCnt);
+        APSARA_TEST_EQUAL(expectedEventCnts[i], plugin->mEventCnt);
+        APSARA_TEST_EQUAL(expectedEventCnts[i], processors[i]->mInEventsTotal->GetValue());
+        APSARA_TEST_EQUAL(expectedOutCnts[i], processors[i]->mOutEventsTotal->GetValue());
+    }
+
+    // the sizes of each processor are the same as when the processors run one by one
+    auto unfusedProcessors = CreateEventProcessors(context);
+    auto unfusedGroups = CreateEventGroups();
+    for (auto& processor : unfusedProcessors) {
+        processor->Process(unfusedGroups);
+    }
+    for (size_t i = 0; i < processors.size(); ++i) {
+        APSARA_TEST_TRUE(processors[i]->mInSizeBytes->GetValue() > 0);
+        APSARA_TEST_TRUE(processors[i]->mOutSizeBytes->GetValue() > 0);
+        APSARA_TEST_EQUAL(unfusedProcessors[i]->mInSizeBytes->GetValue(), processors[i]->mInSizeBytes->GetValue());
+        APSARA_TEST_EQUAL(unfusedProcessors[i]->mOutSizeBytes->GetValue(), processors[i]->mOutSizeBytes->GetValue());
+    }
+}
+
 UNIT_TEST_CASE(ProcessorInstanceUnittest, TestName)
 UNIT_TEST_CASE(ProcessorInstanceUnittest, TestInit)
 UNIT_TEST_CASE(ProcessorInstanceUnittest, TestProcess)
+UNIT_TEST_CASE(ProcessorInstanceUnittest, TestProcessFused)
 
 } // namespace logtail
 
@@ -0,0 +1,126 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "common/TimeUtil.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/polling/PollingDirFile.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+DECLARE_FLAG_BOOL(enable_polling_dir_prune);
+DECLARE_FLAG_INT32(polling_dir_full_scan_round);
+DECLARE_FLAG_INT32(polling_max_stat_count);
+DECLARE_FLAG_INT32(polling_max_stat_count_per_dir);
+DECLARE_FLAG_INT32(dirfile_stat_sleep);
+
+namespace logtail {
+
+// Polls a synthetic tree of mostly unchanged directories, with and without pruning of unchanged directories.
+// Rounds with pruning still read some directories fully, as each directory is read once every
+// polling_dir_full_scan_round rounds.
+class PollingDirFileBenchmark {
+public:
+    static void Run(const string& rootDir, size_t fileCnt, size_t filesPerDir, int rounds) {
+        BuildTree(rootDir, fileCnt, filesPerDir);
+        INT32_FLAG(polling_max_stat_count) = INT32_MAX;
+        INT32_FLAG(polling_max_stat_count_per_dir) = INT32_MAX;
+        INT32_FLAG(dirfile_stat_sleep) = 0;
+        for (bool prune : {false, true}) {
+            BOOL_FLAG(enable_polling_dir_prune) = prune;
+            Poll(rootDir, rounds, prune ? "pruned" : "full");
+        }
+        filesystem::remove_all(rootDir);
+    }
+
+private:
+    // 2 levels of directories, so that both reading and skipping directories are covered
+    static void BuildTree(const string& rootDir, size_t fileCnt, size_t filesPerDir) {
+        filesystem::remove_all(rootDir);
+        size_t dirCnt = (fileCnt + filesPerDir - 1) / filesPerDir;
+        for (size_t i = 0; i < dirCnt; ++i) {
+            string dir = PathJoin(PathJoin(rootDir, "d" + to_string(i / 100)), "d" + to_string(i % 100));
+            filesystem::create_directories(dir);
+            for (size_t j = 0; j < filesPerDir && i * filesPerDir + j < fileCnt; ++j) {
+                ofstream(PathJoin(dir, to_string(j) + ".log"));
+            }
+        }
+        // directories modified just now are always read
+        auto old = filesystem::file_time_type::clock::now() - chrono::seconds(10);
+        for (auto& entry : filesystem::recursive_directory_iterator(rootDir)) {
+            if (entry.is_directory()) {
+                filesystem::last_write_time(entry.path(), old);
+            }
+        }
+        filesystem::last_write_time(rootDir, old);
+    }
+
+    static void Poll(const string& rootDir, int rounds, const string& name) {
+        FileDiscoveryOptions options;
+        options.mMaxDirSearchDepth = 10;
+        CollectionPipelineContext ctx;
+        FileDiscoveryConfig config(&options, &ctx);
+        auto* polling = PollingDirFile::GetInstance();
+        polling->ClearCache();
+        polling->mRuningFlag = true;
+        polling->mHoldOnFlag = false;
+
+        uint64_t totalTime = 0;
+        int64_t totalStatCount = 0;
+        for (int i = 0; i < rounds; ++i) {
+            ++polling->mCurrentRound;
+            polling->mStatCount = 0;
+            fsutil::PathStat statBuf;
+            fsutil::PathStat::stat(rootDir, statBuf);
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            polling->PollingNormalConfigPath(config, rootDir, "", statBuf, 0);
+            uint64_t duration = GetCurrentTimeInMicroSeconds() - startTime;
+            // the first round fills the cache, which is the same in both modes
+            if (i > 0) {
+                totalTime += duration;
+                totalStatCount += polling->mStatCount;
+            }
+        }
+        polling->mRuningFlag = false;
+        polling->ClearCache();
+        cout << name << "\trounds: " << rounds - 1 << "\tavg stat count: " << totalStatCount / (rounds - 1)
+             << "\tavg round time: " << totalTime / (rounds - 1) << " us" << endl;
+    }
+};
+
+} // namespace logtail
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    // usage: polling_dir_file_benchmark [file count] [files per dir] [rounds]
+    size_t fileCnt = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    size_t filesPerDir = argc > 2 ? std::stoul(argv[2]) : 100;
+    int rounds = argc > 3 ? std::stoi(argv[3]) : 25;
+    logtail::PollingDirFileBenchmark::Run(
+        std::filesystem::absolute("polling_dir_file_benchmark").string(), fileCnt, filesPerDir, rounds);
+    return 0;
+}
@@ -0,0 +1,145 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/polling/PollingDirFile.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+DECLARE_FLAG_BOOL(enable_polling_dir_prune);
+DECLARE_FLAG_INT32(polling_dir_full_scan_round);
+
+namespace logtail {
+
+class PollingDirFileUnittest : public testing::Test {
+public:
+    void TestPruneUnchangedDir();
+    void TestPruneDisabled();
+    void TestFullScanRound();
+
+protected:
+    void SetUp() override {
+        mRootDir = filesystem::absolute("polling_dir_file_unittest").string();
+        filesystem::remove_all(mRootDir);
+        // root: 5 files, root/a and root/b: 10 files each
+        for (const auto& dir : {string("a"), string("b")}) {
+            filesystem::create_directories(PathJoin(mRootDir, dir));
+            for (int i = 0; i < 10; ++i) {
+                ofstream(PathJoin(PathJoin(mRootDir, dir), to_string(i) + ".log")) << "test";
+            }
+        }
+        for (int i = 0; i < 5; ++i) {
+            ofstream(PathJoin(mRootDir, to_string(i) + ".log")) << "test";
+        }
+        SetOld(mRootDir, 20);
+        SetOld(PathJoin(mRootDir, "a"), 20);
+        SetOld(PathJoin(mRootDir, "b"), 20);
+
+        mOptions.mMaxDirSearchDepth = 10;
+        mConfig = make_pair(&mOptions, &mCtx);
+
+        auto* polling = PollingDirFile::GetInstance();
+        polling->ClearCache();
+        polling->mRuningFlag = true;
+        polling->mHoldOnFlag = false;
+        BOOL_FLAG(enable_polling_dir_prune) = true;
+        // never scan fully in tests unless required
+        INT32_FLAG(polling_dir_full_scan_round) = INT32_MAX;
+    }
+
+    void TearDown() override {
+        auto* polling = PollingDirFile::GetInstance();
+        polling->ClearCache();
+        polling->mRuningFlag = false;
+        BOOL_FLAG(enable_polling_dir_prune) = false;
+        INT32_FLAG(polling_dir_full_scan_round) = 12;
+        filesystem::remove_all(mRootDir);
+    }
+
+    // polls the root directory as a new round, and returns the stat count of the round
+    int32_t PollRound() {
+        auto* polling = PollingDirFile::GetInstance();
+        ++polling->mCurrentRound;
+        polling->mStatCount = 0;
+        fsutil::PathStat statBuf;
+        fsutil::PathStat::stat(mRootDir, statBuf);
+        polling->PollingNormalConfigPath(mConfig, mRootDir, "", statBuf, 0);
+        return polling->mStatCount;
+    }
+
+    static void SetOld(const string& path, int secs) {
+        filesystem::last_write_time(path, filesystem::file_time_type::clock::now() - chrono::seconds(secs));
+    }
+
+    string mRootDir;
+    FileDiscoveryOptions mOptions;
+    CollectionPipelineContext mCtx;
+    FileDiscoveryConfig mConfig;
+};
+
+void PollingDirFileUnittest::TestPruneUnchangedDir() {
+    auto* polling = PollingDirFile::GetInstance();
+    APSARA_TEST_EQUAL(27, PollRound());
+    APSARA_TEST_EQUAL(3U, polling->mDirCacheMap.size());
+    // only sub directories are stated when nothing changes
+    APSARA_TEST_EQUAL(2, PollRound());
+    APSARA_TEST_EQUAL(2, PollRound());
+
+    // a new sub directory changes the modify time of its parent
+    filesystem::create_directories(PathJoin(PathJoin(mRootDir, "a"), "c"));
+    SetOld(PathJoin(mRootDir, "a"), 10);
+    SetOld(PathJoin(PathJoin(mRootDir, "a"), "c"), 10);
+    APSARA_TEST_EQUAL(13, PollRound());
+    APSARA_TEST_EQUAL(4U, polling->mDirCacheMap.size());
+    APSARA_TEST_EQUAL(3, PollRound());
+
+    // removed sub directories are skipped
+    filesystem::remove_all(PathJoin(mRootDir, "b"));
+    SetOld(mRootDir, 10);
+    APSARA_TEST_EQUAL(7, PollRound());
+    APSARA_TEST_EQUAL(2, PollRound());
+}
+
+void PollingDirFileUnittest::TestPruneDisabled() {
+    BOOL_FLAG(enable_polling_dir_prune) = false;
+    APSARA_TEST_EQUAL(27, PollRound());
+    APSARA_TEST_EQUAL(27, PollRound());
+}
+
+void PollingDirFileUnittest::TestFullScanRound() {
+    INT32_FLAG(polling_dir_full_scan_round) = 1;
+    APSARA_TEST_EQUAL(27, PollRound());
+    APSARA_TEST_EQUAL(27, PollRound());
+
+    // each directory is read once every 2 rounds, and its sub directories are only stated in the other round
+    INT32_FLAG(polling_dir_full_scan_round) = 2;
+    APSARA_TEST_EQUAL(29, PollRound() + PollRound());
+}
+
+UNIT_TEST_CASE(PollingDirFileUnittest, TestPruneUnchangedDir)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestPruneDisabled)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestFullScanRound)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -17,6 +17,8 @@
 
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "config/CollectionConfig.h"
@@ -41,78 +43,18 @@ std::string formatSize(long long size) {
     return ss.str();
 }
 
-static void BM_DockerJson(int size, int batchSize) {
-    logtail::Logger::Instance().InitGlobalLoggers();
-
-    CollectionPipelineContext mContext;
-    mContext.SetConfigName("project##config_0");
-
-    Json::Value config;
-    config["IgnoringStdout"] = false;
-    config["IgnoringStderr"] = false;
-    ProcessorParseContainerLogNative processor;
-    processor.SetContext(mContext);
-    processor.CreateMetricsRecordRef(ProcessorParseContainerLogNative::sName, "1");
-
-    std::string data1
-        = R"({"log":"Exception in thread \"main\" java.lang.NullPointerExceptionat  com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873971412Z"})";
-    std::string data2
-        = R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873976048Z"})";
-    std::string data3
-        = R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873978568Z"})";
-    std::string data4
-        = R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.87398107Z"})";
-    std::cout << "log size:\t" << formatSize((data1.size() + data2.size() + data3.size() + data4.size() + 7 * 4) * size)
-              << std::endl;
-
-    // make events
+static std::string MakeEventsJson(const std::vector<std::string>& lines, int size) {
     Json::Value root;
     Json::Value events;
     for (int i = 0; i < size; i++) {
-        {
-            Json::Value event;
-            event["type"] = 1;
-            event["timestamp"] = 1234567890;
-            event["timestampNanosecond"] = 0;
-            {
-                Json::Value contents;
-                contents["content"] = data1;
-                event["contents"] = std::move(contents);
-            }
-            events.append(event);
-        }
-        {
-            Json::Value event;
-            event["type"] = 1;
-            event["timestamp"] = 1234567890;
-            event["timestampNanosecond"] = 0;
-            {
-                Json::Value contents;
-                contents["content"] = data2;
-                event["contents"] = std::move(contents);
-            }
-            events.append(event);
-        }
-        {
+        for (const auto& line : lines) {
             Json::Value event;
             event["type"] = 1;
             event["timestamp"] = 1234567890;
             event["timestampNanosecond"] = 0;
             {
                 Json::Value contents;
-                contents["content"] = data3;
-                event["contents"] = std::move(contents);
-            }
-            events.append(event);
-        }
-        {
-            Json::Value event;
-            event["type"] = 1;
-            event["timestamp"] = 1234567890;
-            event["timestampNanosecond"] = 0;
-            {
-                Json::Value contents;
-                contents["content"] = data4;
+                contents["content"] = line;
                 event["contents"] = std::move(contents);
             }
             events.append(event);
@@ -125,39 +67,11 @@ static void BM_DockerJson(int size, int batchSize) {
     std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
     std::ostringstream oss;
     writer->write(root, &oss);
-    std::string inJson = oss.str();
-
-    bool init = processor.Init(config);
-    processor.CommitMetricsRecordRef();
-    if (init) {
-        int count = 0;
-        // Perform setup here
-        uint64_t durationTime = 0;
-        for (int i = 0; i < batchSize; i++) {
-            count++;
-            auto sourceBuffer = std::make_shared<SourceBuffer>();
-            PipelineEventGroup eventGroup(sourceBuffer);
-            eventGroup.SetMetadata(EventGroupMetaKey::LOG_FORMAT, ProcessorParseContainerLogNative::DOCKER_JSON_FILE);
-            eventGroup.FromJsonString(inJson);
-
-            uint64_t startTime = GetCurrentTimeInMicroSeconds();
-            processor.Process(eventGroup);
-            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
-
-            // std::string outJson = eventGroup.ToJsonString();
-            // std::cout << "outJson: " << outJson << std::endl;
-        }
-        std::cout << "durationTime: " << durationTime << std::endl;
-        std::cout << "process: "
-                  << formatSize((data1.size() + data2.size() + data3.size() + data4.size() + 7 * 4) * (uint64_t)count
-                                * 1000000 * (uint64_t)size / durationTime)
-                  << std::endl;
-    }
+    return oss.str();
 }
 
-static void BM_ContainerdText(int size, int batchSize) {
-    logtail::Logger::Instance().InitGlobalLoggers();
-
+static void
+BM_ParseContainerLog(const std::string& format, const std::vector<std::string>& lines, int size, int batchSize) {
     CollectionPipelineContext mContext;
     mContext.SetConfigName("project##config_0");
 
@@ -168,107 +82,58 @@ static void BM_ContainerdText(int size, int batchSize) {
     processor.SetContext(mContext);
     processor.CreateMetricsRecordRef(ProcessorParseContainerLogNative::sName, "1");
 
-    std::string data1
-        = R"(2024-04-08T12:48:59.665663286+08:00 stdout P Exception in thread "main" java.lang.NullPointerExceptionat  com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat )";
-    std::string data2
-        = R"(2024-04-08T12:48:59.665663286+08:00 stdout P com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat)";
-
-    std::string data3
-        = R"(2024-04-08T12:48:59.66566455+08:00 stdout P com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitle)";
-    std::string data4 = R"(2024-04-08T12:48:59.665665738+08:00 stdout F     at com.example.myproject.Book.getTitle)";
-    std::cout << "log size:\t" << formatSize((data1.size() + data2.size() + data3.size() + data4.size() + 7 * 4) * size)
-              << std::endl;
-
-    // make events
-    Json::Value root;
-    Json::Value events;
-    for (int i = 0; i < size; i++) {
-        {
-            Json::Value event;
-            event["type"] = 1;
-            event["timestamp"] = 1234567890;
-            event["timestampNanosecond"] = 0;
-            {
-                Json::Value contents;
-                contents["content"] = data1;
-                event["contents"] = std::move(contents);
-            }
-            events.append(event);
-        }
-        {
-            Json::Value event;
-            event["type"] = 1;
-            event["timestamp"] = 1234567890;
-            event["timestampNanosecond"] = 0;
-            {
-                Json::Value contents;
-                contents["content"] = data2;
-                event["contents"] = std::move(contents);
-            }
-            events.append(event);
-        }
-        {
-            Json::Value event;
-            event["type"] = 1;
-            event["timestamp"] = 1234567890;
-            event["timestampNanosecond"] = 0;
-            {
-                Json::Value contents;
-                contents["content"] = data3;
-                event["contents"] = std::move(contents);
-            }
-            events.append(event);
-        }
-        {
-            Json::Value event;
-            event["type"] = 1;
-            event["timestamp"] = 1234567890;
-            event["timestampNanosecond"] = 0;
-            {
-                Json::Value contents;
-                contents["content"] = data4;
-                event["contents"] = std::move(contents);
-            }
-            events.append(event);
-        }
+    size_t linesSize = 0;
+    for (const auto& line : lines) {
+        linesSize += line.size();
     }
-
-    root["events"] = events;
-    Json::StreamWriterBuilder builder;
-    builder["commentStyle"] = "None";
-    std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
-    std::ostringstream oss;
-    writer->write(root, &oss);
-    std::string inJson = oss.str();
+    std::cout << "log size:\t" << formatSize(linesSize * size) << std::endl;
+    std::string inJson = MakeEventsJson(lines, size);
 
     bool init = processor.Init(config);
     processor.CommitMetricsRecordRef();
     if (init) {
         int count = 0;
-        // Perform setup here
         uint64_t durationTime = 0;
         for (int i = 0; i < batchSize; i++) {
             count++;
             auto sourceBuffer = std::make_shared<SourceBuffer>();
             PipelineEventGroup eventGroup(sourceBuffer);
-            eventGroup.SetMetadata(EventGroupMetaKey::LOG_FORMAT, ProcessorParseContainerLogNative::CONTAINERD_TEXT);
+            eventGroup.SetMetadata(EventGroupMetaKey::LOG_FORMAT, format);
             eventGroup.FromJsonString(inJson);
 
             uint64_t startTime = GetCurrentTimeInMicroSeconds();
             processor.Process(eventGroup);
             durationTime += GetCurrentTimeInMicroSeconds() - startTime;
-
-            // std::string outJson = eventGroup.ToJsonString();
-            // std::cout << "outJson: " << outJson << std::endl;
         }
         std::cout << "durationTime: " << durationTime << std::endl;
-        std::cout << "process: "
-                  << formatSize((data1.size() + data2.size() + data3.size() + data4.size() + 7 * 4) * (uint64_t)count
-                                * 1000000 * (uint64_t)size / durationTime)
+        std::cout << "process: " << formatSize(linesSize * (uint64_t)count * 1000000 * (uint64_t)size / durationTime)
                   << std::endl;
     }
 }
 
+// a java exception, the log field ends with an escaped line feed as docker always writes
+static const std::vector<std::string> kDockerJsonLines = {
+    R"({"log":"Exception in thread \"main\" java.lang.NullPointerExceptionat  com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873971412Z"})",
+    R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873976048Z"})",
+    R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.873978568Z"})",
+    R"({"log":"    at com.example.myproject.Book.getTitle\n","stream":"stdout","time":"2024-04-07T08:02:40.87398107Z"})"};
+
+// the common case of application logs: no escape except the trailing line feed
+static const std::vector<std::string> kDockerJsonPlainLines = {
+    R"({"log":"2024-04-08 12:48:59.665 INFO [main] com.example.myproject.Service - request handled, cost=12ms\n","stream":"stdout","time":"2024-04-07T08:02:40.873971412Z"})",
+    R"({"log":"2024-04-08 12:48:59.666 WARN [main] com.example.myproject.Service - slow request, cost=512ms\n","stream":"stderr","time":"2024-04-07T08:02:40.873976048Z"})"};
+
+// non-ascii text escaped as unicode code points
+static const std::vector<std::string> kDockerJsonUnicodeLines = {
+    R"({"log":"\u0069\u004c\u006f\u0067\u0074\u0061\u0069\u006c\u0020\u4e3a\u53ef\u89c2\u6d4b\u573a\u666f\u800c\u751f \ud83c\udf0d\n","stream":"stdout","time":"2024-04-07T08:02:40.873971412Z"})"};
+
+// a long line split into partial lines
+static const std::vector<std::string> kContainerdTextLines = {
+    R"(2024-04-08T12:48:59.665663286+08:00 stdout P Exception in thread "main" java.lang.NullPointerExceptionat  com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat )",
+    R"(2024-04-08T12:48:59.665663286+08:00 stdout P com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat)",
+    R"(2024-04-08T12:48:59.66566455+08:00 stdout P com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitleat com.example.myproject.Book.getTitle)",
+    R"(2024-04-08T12:48:59.665665738+08:00 stdout F     at com.example.myproject.Book.getTitle)"};
+
 int main(int argc, char** argv) {
     logtail::Logger::Instance().InitGlobalLoggers();
 #ifdef NDEBUG
@@ -277,8 +142,12 @@ int main(int argc, char** argv) {
     std::cout << "debug" << std::endl;
 #endif
     std::cout << "docker json" << std::endl;
-    BM_DockerJson(512, 100);
+    BM_ParseContainerLog(ProcessorParseContainerLogNative::DOCKER_JSON_FILE, kDockerJsonLines, 512, 100);
+    std::cout << "docker json without escape" << std::endl;
+    BM_ParseContainerLog(ProcessorParseContainerLogNative::DOCKER_JSON_FILE, kDockerJsonPlainLines, 1024, 100);
+    std::cout << "docker json with unicode escape" << std::endl;
+    BM_ParseContainerLog(ProcessorParseContainerLogNative::DOCKER_JSON_FILE, kDockerJsonUnicodeLines, 2048, 100);
     std::cout << "containerdText" << std::endl;
-    BM_ContainerdText(512, 100);
+    BM_ParseContainerLog(ProcessorParseContainerLogNative::CONTAINERD_TEXT, kContainerdTextLines, 512, 100);
     return 0;
 }
@@ -0,0 +1,115 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/StringTools.h"
+#include "models/LogEvent.h"
+#include "plugin/processor/ProcessorParseDelimiterNative.h"
+#include "unittest/Unittest.h"
+
+
+using namespace logtail;
+
+
+std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+// a csv access log with 32 columns, every other column is quoted if required
+static std::string MakeCsvLog(int row, bool quoted) {
+    std::string res;
+    for (int col = 0; col < 32; ++col) {
+        if (col > 0) {
+            res += ',';
+        }
+        std::string value = "value_" + ToString(row * col);
+        if (quoted && col % 2 == 1) {
+            res += "\"" + value + ", \"\"quoted\"\" text\"";
+        } else {
+            res += value;
+        }
+    }
+    return res;
+}
+
+static void BM_ParseDelimiter(bool quoted, int size, int batchSize) {
+    CollectionPipelineContext mContext;
+    mContext.SetConfigName("project##config_0");
+
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Separator"] = ",";
+    config["Quote"] = "\"";
+    config["Keys"] = Json::arrayValue;
+    for (int col = 0; col < 32; ++col) {
+        config["Keys"].append("key" + ToString(col));
+    }
+    ProcessorParseDelimiterNative processor;
+    processor.SetContext(mContext);
+    processor.CreateMetricsRecordRef(ProcessorParseDelimiterNative::sName, "1");
+    bool init = processor.Init(config);
+    processor.CommitMetricsRecordRef();
+    if (!init) {
+        return;
+    }
+
+    std::vector<std::string> logs;
+    size_t totalSize = 0;
+    for (int i = 0; i < size; ++i) {
+        logs.emplace_back(MakeCsvLog(i, quoted));
+        totalSize += logs.back().size();
+    }
+    std::cout << (quoted ? "quoted" : "unquoted") << " log size:\t" << formatSize(totalSize) << std::endl;
+
+    uint64_t durationTime = 0;
+    for (int i = 0; i < batchSize; i++) {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        for (const auto& log : logs) {
+            eventGroup.AddLogEvent()->SetContentNoCopy(StringView("content"), StringView(log));
+        }
+
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        processor.Process(eventGroup);
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    std::cout << "durationTime: " << durationTime << std::endl;
+    std::cout << "process: " << formatSize(totalSize * (uint64_t)batchSize * 1000000 / durationTime) << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    BM_ParseDelimiter(false, 1000, 100);
+    BM_ParseDelimiter(true, 1000, 100);
+    return 0;
+}
@@ -0,0 +1,128 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/TimeFormatParser.h"
+#include "common/TimeUtil.h"
+#include "unittest/Unittest.h"
+
+
+using namespace logtail;
+
+
+std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+// timestamps of consecutive seconds starting from 2024-04-08 12:48:59, the same as a busy log file
+static std::vector<std::string> MakeTimestamps(const std::string& format, int size) {
+    std::vector<std::string> res;
+    time_t t = 1712551739;
+    char buf[128];
+    for (int i = 0; i < size; ++i, ++t) {
+        if (format == "%s") {
+            res.emplace_back(std::to_string(t));
+            continue;
+        }
+        struct tm tm;
+        localtime_r(&t, &tm);
+        std::string fmt = format;
+        auto pos = fmt.find("%f");
+        if (pos != std::string::npos) {
+            fmt.replace(pos, 2, std::to_string(100000 + i % 900000));
+        }
+        strftime(buf, sizeof(buf), fmt.c_str(), &tm);
+        res.emplace_back(buf);
+    }
+    return res;
+}
+
+static void BM_ParseTimestamp(const std::string& format, int size, int batchSize) {
+    std::vector<std::string> timestamps = MakeTimestamps(format, size);
+    size_t totalSize = 0;
+    for (const auto& ts : timestamps) {
+        totalSize += ts.size();
+    }
+    std::cout << "format:\t" << format << "\texample:\t" << timestamps[0] << std::endl;
+
+    int64_t strptimeSum = 0;
+    uint64_t strptimeDurationTime = 0;
+    for (int i = 0; i < batchSize; i++) {
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        for (const auto& ts : timestamps) {
+            LogtailTime logTime = {0, 0};
+            int nanosecondLength = 0;
+            Strptime(ts.c_str(), format.c_str(), &logTime, nanosecondLength);
+            strptimeSum += logTime.tv_sec + logTime.tv_nsec;
+        }
+        strptimeDurationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+
+    TimeFormatParser parser;
+    if (!parser.Compile(format)) {
+        std::cout << "error: failed to compile format" << std::endl;
+        return;
+    }
+    TimeFormatParser::Cache cache;
+    int64_t parserSum = 0;
+    uint64_t parserDurationTime = 0;
+    for (int i = 0; i < batchSize; i++) {
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        for (const auto& ts : timestamps) {
+            LogtailTime logTime = {0, 0};
+            int nanosecondLength = 0;
+            if (!parser.Parse(ts, logTime, nanosecondLength, cache)) {
+                Strptime(ts.c_str(), format.c_str(), &logTime, nanosecondLength);
+            }
+            parserSum += logTime.tv_sec + logTime.tv_nsec;
+        }
+        parserDurationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    if (strptimeSum != parserSum) {
+        std::cout << "error: results of strptime and parser are different" << std::endl;
+    }
+    std::cout << "strptime durationTime: " << strptimeDurationTime << "\tprocess: "
+              << formatSize(totalSize * (uint64_t)batchSize * 1000000 / strptimeDurationTime) << std::endl;
+    std::cout << "parser durationTime: " << parserDurationTime << "\tprocess: "
+              << formatSize(totalSize * (uint64_t)batchSize * 1000000 / parserDurationTime) << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    BM_ParseTimestamp("%Y-%m-%d %H:%M:%S", 10000, 100);
+    BM_ParseTimestamp("%Y-%m-%dT%H:%M:%S.%f%z", 10000, 100);
+    BM_ParseTimestamp("[%Y-%m-%d %H:%M:%S.%f]", 10000, 100);
+    BM_ParseTimestamp("%d/%b/%Y:%H:%M:%S %z", 10000, 100);
+    BM_ParseTimestamp("%s", 10000, 100);
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/StringTools.h"
+#include "models/LogEvent.h"
+#include "plugin/processor/ProcessorDesensitizeNative.h"
+#include "plugin/processor/ProcessorFilterNative.h"
+#include "plugin/processor/ProcessorParseRegexNative.h"
+#include "plugin/processor/ProcessorParseTimestampNative.h"
+#include "plugin/processor/ProcessorTimestampFilterNative.h"
+#include "unittest/Unittest.h"
+
+
+using namespace logtail;
+
+
+// an access log line, one in ten of which is a server error
+static std::string MakeAccessLog(int row) {
+    char buf[512];
+    snprintf(buf,
+             sizeof(buf),
+             "10.0.%d.%d - - [2024-04-08 12:%02d:%02d] %d \"GET /api/v1/users/%d?fields=name,email HTTP/1.1\" %d %d "
+             "token=%08x%08x",
+             row / 256 % 256,
+             row % 256,
+             row / 60 % 60,
+             row % 60,
+             1712551739 + row,
+             row,
+             row % 10 == 0 ? 503 : 200,
+             100 + row % 1000,
+             row * 2654435761U,
+             row * 40503U);
+    return buf;
+}
+
+static std::vector<std::unique_ptr<ProcessorInstance>> MakeChain(CollectionPipelineContext& context) {
+    std::vector<std::unique_ptr<ProcessorInstance>> chain;
+    auto add = [&](Processor* processor, const Json::Value& config) {
+        chain.emplace_back(std::make_unique<ProcessorInstance>(
+            processor, PluginInstance::PluginMeta(ToString(chain.size() + 1))));
+        if (!chain.back()->Init(config, context)) {
+            std::cout << "failed to init processor " << chain.back()->Name() << std::endl;
+        }
+    };
+
+    Json::Value regex;
+    regex["SourceKey"] = "content";
+    regex["Regex"] = R"((\S+) - - \[([^\]]+)\] (\d+) "(\S+) (\S+) \S+" (\d+) (\d+) (.*))";
+    regex["Keys"] = Json::arrayValue;
+    for (const auto& key : {"ip", "time", "ts", "method", "url", "status", "size", "token"}) {
+        regex["Keys"].append(key);
+    }
+    add(new ProcessorParseRegexNative(), regex);
+
+    Json::Value timestamp;
+    timestamp["SourceKey"] = "time";
+    timestamp["SourceFormat"] = "%Y-%m-%d %H:%M:%S";
+    add(new ProcessorParseTimestampNative(), timestamp);
+
+    Json::Value filter;
+    filter["Include"] = Json::Value(Json::objectValue);
+    filter["Include"]["status"] = "[23]\\d\\d";
+    add(new ProcessorFilterNative(), filter);
+
+    Json::Value desensitize;
+    desensitize["SourceKey"] = "token";
+    desensitize["Method"] = "const";
+    desensitize["ReplacingString"] = "********";
+    desensitize["ContentPatternBeforeReplacedString"] = "token=";
+    desensitize["ReplacedContentPattern"] = "[0-9a-f]+";
+    desensitize["ReplacingAll"] = true;
+    add(new ProcessorDesensitizeNative(), desensitize);
+
+    Json::Value timestampFilter;
+    timestampFilter["SourceKey"] = "ts";
+    timestampFilter["TimestampPrecision"] = "second";
+    timestampFilter["LowerBound"] = 1000000000;
+    timestampFilter["UpperBound"] = 2000000000;
+    add(new ProcessorTimestampFilterNative(), timestampFilter);
+    return chain;
+}
+
+static void BM_ProcessorChain(bool fused, int size, int batchSize) {
+    CollectionPipelineContext context;
+    context.SetConfigName("project##config_0");
+    auto chain = MakeChain(context);
+
+    std::vector<std::string> logs;
+    for (int i = 0; i < size; ++i) {
+        logs.emplace_back(MakeAccessLog(i));
+    }
+
+    uint64_t durationTime = 0;
+    size_t outEvents = 0;
+    for (int i = 0; i < batchSize; i++) {
+        std::vector<PipelineEventGroup> groups;
+        groups.emplace_back(std::make_shared<SourceBuffer>());
+        for (const auto& log : logs) {
+            groups.back().AddLogEvent()->SetContentNoCopy(StringView("content"), StringView(log));
+        }
+
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        if (fused) {
+            ProcessorInstance::ProcessFused(chain, 0, chain.size(), groups);
+        } else {
+            for (auto& processor : chain) {
+                processor->Process(groups);
+            }
+        }
+        durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        outEvents += groups.back().GetEvents().size();
+    }
+    std::cout << (fused ? "fused" : "unfused") << "\tevents: " << size * batchSize << "\tout events: " << outEvents
+              << "\tdurationTime: " << durationTime << " us\tper event: " << durationTime * 1000.0 / (size * batchSize)
+              << " ns" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    // small groups fit in cache anyway, while the large ones show the cost of walking a group once per processor
+    for (int size : {100, 1000, 10000}) {
+        BM_ProcessorChain(false, size, 1000000 / size);
+        BM_ProcessorChain(true, size, 1000000 / size);
+    }
+    return 0;
+}
@@ -2247,6 +2247,23 @@ void ProcessorParseContainerLogNativeUnittest::TestParseDockerLog() {
         APSARA_TEST_EQUAL("2021-12-01T00:00:00.000Z", dockerLog.time);
         delete[] buffer;
     }
+    // Test with surrogate pairs and invalid unicode escapes, which are kept as they are.
+    {
+        DockerLog dockerLog;
+        std::string str
+            = R"({"log":"\ud83c\udf0d \ud83c x \udf0d \uzzzz \u12","stream":"stdout","time":"2021-12-01T00:00:00.000Z"})";
+        int32_t size = str.size();
+
+        char* buffer = new char[size + 1]();
+        strcpy(buffer, str.c_str());
+
+        bool result = ProcessorParseContainerLogNative::ParseDockerLog(buffer, size, dockerLog);
+
+        APSARA_TEST_TRUE(result);
+        APSARA_TEST_STREQ("🌍 \\ud83c x \\udf0d \\uzzzz \\u12", dockerLog.log.to_string().c_str());
+        APSARA_TEST_EQUAL("stdout", dockerLog.stream);
+        delete[] buffer;
+    }
     // Test with a incomplete log
     {
         DockerLog dockerLog;
@@ -47,6 +47,7 @@ public:
     void TestAllowingShortenedFields();
     void TestExtend();
     void TestEmpty();
+    void TestLongLineWithQuote();
     CollectionPipelineContext mContext;
 };
 
@@ -64,6 +65,7 @@ UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestProcessEventDiscardUnm
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestAllowingShortenedFields);
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestExtend);
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestEmpty);
+UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestLongLineWithQuote);
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
@@ -2574,6 +2576,66 @@ void ProcessorParseDelimiterNativeUnittest::TestEmpty() {
     }
 }
 
+void ProcessorParseDelimiterNativeUnittest::TestLongLineWithQuote() {
+    // quoted fields with separators and doubled quotes crossing 64-byte boundaries
+    std::vector<std::string> values;
+    std::string line;
+    for (int i = 0; i < 40; ++i) {
+        std::string value = "value" + ToString(i);
+        if (i % 3 == 0) {
+            value += ", with 'quoted' separator,";
+            std::string quoted = "'";
+            for (char c : value) {
+                quoted += c;
+                if (c == '\'') {
+                    quoted += c;
+                }
+            }
+            line += quoted + "',";
+        } else {
+            line += value + ",";
+        }
+        values.push_back(value);
+    }
+    line.pop_back();
+
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Separator"] = ",";
+    config["Quote"] = "'";
+    config["Keys"] = Json::arrayValue;
+    for (size_t i = 0; i < values.size(); ++i) {
+        config["Keys"].append("key" + ToString(i));
+    }
+    config["KeepingSourceWhenParseFail"] = true;
+    config["RenamedSourceKey"] = "rawLog";
+    ProcessorParseDelimiterNative& processor = *(new ProcessorParseDelimiterNative);
+    ProcessorInstance processorInstance(&processor, getPluginMeta());
+    APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+    {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        eventGroup.AddLogEvent()->SetContent(std::string("content"), line);
+        processor.Process(eventGroup);
+        APSARA_TEST_EQUAL_FATAL(1U, eventGroup.GetEvents().size());
+        const auto& event = eventGroup.GetEvents()[0].Cast<LogEvent>();
+        for (size_t i = 0; i < values.size(); ++i) {
+            APSARA_TEST_EQUAL(values[i], event.GetContent("key" + ToString(i)).to_string());
+        }
+    }
+    {
+        // unclosed quote
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        eventGroup.AddLogEvent()->SetContent(std::string("content"), line + ",'unclosed");
+        processor.Process(eventGroup);
+        APSARA_TEST_EQUAL_FATAL(1U, eventGroup.GetEvents().size());
+        const auto& event = eventGroup.GetEvents()[0].Cast<LogEvent>();
+        APSARA_TEST_FALSE(event.HasContent("key0"));
+        APSARA_TEST_EQUAL(line + ",'unclosed", event.GetContent("rawLog").to_string());
+    }
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
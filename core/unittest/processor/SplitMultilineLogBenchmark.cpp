@@ -0,0 +1,188 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <cstring>
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "boost/regex.hpp"
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/FastRegexMatcher.h"
+#include "common/StringTools.h"
+#include "models/LogEvent.h"
+#include "plugin/processor/inner/ProcessorSplitMultilineLogStringNative.h"
+#include "unittest/Unittest.h"
+
+
+using namespace logtail;
+
+
+std::string formatSize(long long size) {
+    static const char* units[] = {" B", "KB", "MB", "GB", "TB"};
+    int index = 0;
+    double doubleSize = static_cast<double>(size);
+    while (doubleSize >= 1024.0 && index < 4) {
+        doubleSize /= 1024.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << std::setw(6) << std::setfill(' ') << doubleSize << " " << units[index];
+    return ss.str();
+}
+
+static const std::string kStartPattern = R"(\d{4}-\d{2}-\d{2}\s\d{2}:\d{2}:\d{2}.*)";
+static const std::string kContinuePattern = R"(\s+at\s.*|Caused by:.*|\s+\.\.\.\s\d+ more)";
+
+// a java service log with an exception every 4 logs, each exception has 2 causes and 30 frames
+static std::string MakeJavaStackTraceLog(int size) {
+    std::string res;
+    for (int i = 0; i < size; ++i) {
+        res += "2024-04-08 12:48:59.665 INFO [main] com.example.myproject.Service - request handled, cost=12ms\n";
+        if (i % 4 != 0) {
+            continue;
+        }
+        res += "2024-04-08 12:48:59.666 ERROR [main] com.example.myproject.Service - request failed\n";
+        res += "java.lang.IllegalStateException: failed to get title\n";
+        for (int cause = 0; cause < 3; ++cause) {
+            if (cause > 0) {
+                res += "Caused by: java.lang.NullPointerException: title is null\n";
+            }
+            for (int frame = 0; frame < 10; ++frame) {
+                res += "\tat com.example.myproject.Book.getTitle(Book.java:" + std::to_string(frame + 16) + ")\n";
+            }
+            if (cause > 0) {
+                res += "\t... 23 more\n";
+            }
+        }
+    }
+    res.pop_back();
+    return res;
+}
+
+static void BM_MatchLines(int size, int batchSize) {
+    std::string log = MakeJavaStackTraceLog(size);
+    std::vector<StringView> lines;
+    size_t begin = 0;
+    for (size_t i = 0; i <= log.size(); ++i) {
+        if (i == log.size() || log[i] == '\n') {
+            lines.emplace_back(log.data() + begin, i - begin);
+            begin = i + 1;
+        }
+    }
+    std::cout << "log size:\t" << formatSize(log.size()) << "\tlines:\t" << lines.size() << std::endl;
+
+    boost::regex startReg(kStartPattern);
+    boost::regex continueReg(kContinuePattern);
+    FastRegexMatcher startMatcher;
+    FastRegexMatcher continueMatcher;
+    startMatcher.Compile(kStartPattern);
+    continueMatcher.Compile(kContinuePattern);
+
+    std::string exception;
+    size_t boostMatched = 0;
+    uint64_t boostDurationTime = 0;
+    for (int i = 0; i < batchSize; i++) {
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        for (const auto& line : lines) {
+            if (BoostRegexSearch(line.data(), line.size(), startReg, exception)
+                || BoostRegexSearch(line.data(), line.size(), continueReg, exception)) {
+                ++boostMatched;
+            }
+        }
+        boostDurationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+
+    auto match = [&](const FastRegexMatcher& matcher, const boost::regex& reg, StringView line) {
+        switch (matcher.Match(line.data(), line.size())) {
+            case FastRegexMatcher::Result::MATCH:
+                return true;
+            case FastRegexMatcher::Result::NOT_MATCH:
+                return false;
+            default:
+                return BoostRegexSearch(line.data(), line.size(), reg, exception);
+        }
+    };
+    size_t fastMatched = 0;
+    uint64_t fastDurationTime = 0;
+    for (int i = 0; i < batchSize; i++) {
+        uint64_t startTime = GetCurrentTimeInMicroSeconds();
+        for (const auto& line : lines) {
+            if (match(startMatcher, startReg, line) || match(continueMatcher, continueReg, line)) {
+                ++fastMatched;
+            }
+        }
+        fastDurationTime += GetCurrentTimeInMicroSeconds() - startTime;
+    }
+    if (boostMatched != fastMatched) {
+        std::cout << "error: boost matched " << boostMatched << ", fast matched " << fastMatched << std::endl;
+    }
+    std::cout << "boost durationTime: " << boostDurationTime << "\tprocess: "
+              << formatSize(log.size() * (uint64_t)batchSize * 1000000 / boostDurationTime) << std::endl;
+    std::cout << "fast durationTime: " << fastDurationTime << "\tprocess: "
+              << formatSize(log.size() * (uint64_t)batchSize * 1000000 / fastDurationTime) << std::endl;
+}
+
+static void BM_SplitMultiline(int size, int batchSize) {
+    CollectionPipelineContext mContext;
+    mContext.SetConfigName("project##config_0");
+
+    Json::Value config;
+    config["StartPattern"] = kStartPattern;
+    config["ContinuePattern"] = kContinuePattern;
+    config["UnmatchedContentTreatment"] = "single_line";
+    ProcessorSplitMultilineLogStringNative processor;
+    processor.SetContext(mContext);
+    processor.CreateMetricsRecordRef(ProcessorSplitMultilineLogStringNative::sName, "1");
+
+    std::string log = MakeJavaStackTraceLog(size);
+    std::cout << "log size:\t" << formatSize(log.size()) << std::endl;
+
+    bool init = processor.Init(config);
+    processor.CommitMetricsRecordRef();
+    if (init) {
+        int count = 0;
+        uint64_t durationTime = 0;
+        for (int i = 0; i < batchSize; i++) {
+            count++;
+            auto sourceBuffer = std::make_shared<SourceBuffer>();
+            PipelineEventGroup eventGroup(sourceBuffer);
+            auto* event = eventGroup.AddLogEvent();
+            event->SetContent(DEFAULT_CONTENT_KEY, log);
+
+            uint64_t startTime = GetCurrentTimeInMicroSeconds();
+            processor.Process(eventGroup);
+            durationTime += GetCurrentTimeInMicroSeconds() - startTime;
+        }
+        std::cout << "durationTime: " << durationTime << std::endl;
+        std::cout << "process: " << formatSize(log.size() * (uint64_t)count * 1000000 / durationTime) << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+#ifdef NDEBUG
+    std::cout << "release" << std::endl;
+#else
+    std::cout << "debug" << std::endl;
+#endif
+    std::cout << "match java stack trace lines" << std::endl;
+    BM_MatchLines(512, 100);
+    std::cout << "split java stack trace log" << std::endl;
+    BM_SplitMultiline(512, 100);
+    return 0;
+}
@@ -252,6 +252,10 @@ public:
     void TestSpanInnerEventReadTimestampFailed();
     void TestSpanLinkReadTraceIdFailed();
 
+    // Category 18: No Copy Mode Tests
+    void TestNoCopyLogEvent();
+    void TestNoCopySpanEvent();
+
 protected:
     void SetUp() override {}
 
@@ -5851,6 +5855,89 @@ void ManualPBParserUnittest::TestSpanLinkReadTraceIdFailed() {
     APSARA_TEST_FALSE(parser.ParsePipelineEventGroup(eventGroup, errMsg));
 }
 
+// ============================================================================
+// Category 18: No Copy Mode Tests
+// ============================================================================
+
+// Strings reference the input data in no copy mode, and are copied into the source buffer otherwise
+void ManualPBParserUnittest::TestNoCopyLogEvent() {
+    vector<uint8_t> result;
+    auto tagsTag = encodeVarint32(encodeTag(2, 2));
+    result.insert(result.end(), tagsTag.begin(), tagsTag.end());
+    auto tagsData = encodeMapEntry("region", "us-west");
+    auto tagsLen = encodeVarint32(tagsData.size());
+    result.insert(result.end(), tagsLen.begin(), tagsLen.end());
+    result.insert(result.end(), tagsData.begin(), tagsData.end());
+
+    auto logEventsData = encodeLogEvents({encodeLogEvent(1000ULL, {{"key", "value"}})});
+    auto logEventsTag = encodeVarint32(encodeTag(3, 2));
+    result.insert(result.end(), logEventsTag.begin(), logEventsTag.end());
+    auto logEventsLen = encodeVarint32(logEventsData.size());
+    result.insert(result.end(), logEventsLen.begin(), logEventsLen.end());
+    result.insert(result.end(), logEventsData.begin(), logEventsData.end());
+
+    auto isInData = [&result](StringView str) {
+        const auto* ptr = reinterpret_cast<const uint8_t*>(str.data());
+        return ptr >= result.data() && ptr + str.size() <= result.data() + result.size();
+    };
+    for (bool noCopy : {true, false}) {
+        ManualPBParser parser(result.data(), result.size(), false, noCopy);
+        PipelineEventGroup eventGroup(make_shared<SourceBuffer>());
+        string errMsg;
+        APSARA_TEST_TRUE_FATAL(parser.ParsePipelineEventGroup(eventGroup, errMsg));
+        APSARA_TEST_EQUAL_FATAL(1U, eventGroup.GetEvents().size());
+
+        const auto& logEvent = eventGroup.GetEvents()[0].Cast<LogEvent>();
+        APSARA_TEST_EQUAL("value", logEvent.GetContent("key").to_string());
+        APSARA_TEST_EQUAL("us-west", eventGroup.GetTag("region").to_string());
+        APSARA_TEST_EQUAL(noCopy, isInData(logEvent.GetContent("key")));
+        APSARA_TEST_EQUAL(noCopy, isInData(logEvent.begin()->first));
+        APSARA_TEST_EQUAL(noCopy, isInData(eventGroup.GetTag("region")));
+    }
+}
+
+void ManualPBParserUnittest::TestNoCopySpanEvent() {
+    auto spanEventData = encodeSpanEvent(1234567890ULL,
+                                         "trace-123",
+                                         "span-456",
+                                         "HTTP GET /api/users",
+                                         3,
+                                         1000000000ULL,
+                                         2000000000ULL,
+                                         {{"http.method", "GET"}},
+                                         {{"service.name", "api-service"}},
+                                         "congo=abcde",
+                                         "parent-789",
+                                         1);
+    auto data = encodePipelineEventGroupWithSpans({spanEventData});
+
+    ManualPBParser parser(data.data(), data.size(), false, true);
+    PipelineEventGroup eventGroup(make_shared<SourceBuffer>());
+    string errMsg;
+    APSARA_TEST_TRUE_FATAL(parser.ParsePipelineEventGroup(eventGroup, errMsg));
+    APSARA_TEST_EQUAL_FATAL(1U, eventGroup.GetEvents().size());
+
+    auto isInData = [&data](StringView str) {
+        const auto* ptr = reinterpret_cast<const uint8_t*>(str.data());
+        return ptr >= data.data() && ptr + str.size() <= data.data() + data.size();
+    };
+    const auto& spanEvent = eventGroup.GetEvents()[0].Cast<SpanEvent>();
+    APSARA_TEST_EQUAL("trace-123", spanEvent.GetTraceId().to_string());
+    APSARA_TEST_EQUAL("span-456", spanEvent.GetSpanId().to_string());
+    APSARA_TEST_EQUAL("HTTP GET /api/users", spanEvent.GetName().to_string());
+    APSARA_TEST_EQUAL("congo=abcde", spanEvent.GetTraceState().to_string());
+    APSARA_TEST_EQUAL("parent-789", spanEvent.GetParentSpanId().to_string());
+    APSARA_TEST_EQUAL("GET", spanEvent.GetTag("http.method").to_string());
+    APSARA_TEST_EQUAL("api-service", spanEvent.GetScopeTag("service.name").to_string());
+    APSARA_TEST_TRUE(isInData(spanEvent.GetTraceId()));
+    APSARA_TEST_TRUE(isInData(spanEvent.GetSpanId()));
+    APSARA_TEST_TRUE(isInData(spanEvent.GetName()));
+    APSARA_TEST_TRUE(isInData(spanEvent.GetTraceState()));
+    APSARA_TEST_TRUE(isInData(spanEvent.GetParentSpanId()));
+    APSARA_TEST_TRUE(isInData(spanEvent.GetTag("http.method")));
+    APSARA_TEST_TRUE(isInData(spanEvent.GetScopeTag("service.name")));
+}
+
 // Category 1 test cases
 UNIT_TEST_CASE(ManualPBParserUnittest, TestReadVarint32Success)
 UNIT_TEST_CASE(ManualPBParserUnittest, TestReadVarint32MaxValue)
@@ -6047,6 +6134,10 @@ UNIT_TEST_CASE(ManualPBParserUnittest, TestSpanScopeTagsUnknownField)
 UNIT_TEST_CASE(ManualPBParserUnittest, TestSpanInnerEventReadTimestampFailed)
 UNIT_TEST_CASE(ManualPBParserUnittest, TestSpanLinkReadTraceIdFailed)
 
+// Category 18 test cases
+UNIT_TEST_CASE(ManualPBParserUnittest, TestNoCopyLogEvent)
+UNIT_TEST_CASE(ManualPBParserUnittest, TestNoCopySpanEvent)
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -0,0 +1,222 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "collection_pipeline/queue/PendingPushManager.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "common/Flags.h"
+#include "models/PipelineEventGroup.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(process_queue_max_pending_push_cnt);
+
+using namespace std;
+
+namespace logtail {
+
+class PendingPushManagerUnittest : public testing::Test {
+public:
+    void TestPushOnFeedback();
+    void TestKeepOrder();
+    void TestDeadline();
+    void TestCancel();
+    void TestMaxPendingCnt();
+    void TestQueueNotExist();
+    void TestStop();
+
+protected:
+    void SetUp() override {
+        mCtx.SetConfigName("test_config");
+        mKey = QueueKeyManager::GetInstance()->GetKey("test_config");
+        ProcessQueueManager::GetInstance()->CreateOrUpdateCountBoundedQueue(mKey, 0, mCtx);
+        ProcessQueueManager::GetInstance()->SetFeedbackInterface(mKey, {PendingPushManager::GetInstance()});
+        ProcessQueueManager::GetInstance()->EnablePop("test_config");
+        // capacity: 5, low watermark: 3
+        for (size_t i = 0; i < 5; ++i) {
+            APSARA_TEST_EQUAL(QueueStatus::OK, ProcessQueueManager::GetInstance()->PushQueue(mKey, GenerateItem(i)));
+        }
+        PendingPushManager::GetInstance()->Start();
+    }
+
+    void TearDown() override {
+        PendingPushManager::GetInstance()->Stop();
+        INT32_FLAG(process_queue_max_pending_push_cnt) = 100;
+        ProcessQueueManager::GetInstance()->Clear();
+        QueueKeyManager::GetInstance()->Clear();
+    }
+
+    static unique_ptr<ProcessQueueItem> GenerateItem(size_t inputIndex) {
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        return make_unique<ProcessQueueItem>(std::move(g), inputIndex);
+    }
+
+    static chrono::steady_clock::time_point After(int ms) {
+        return chrono::steady_clock::now() + chrono::milliseconds(ms);
+    }
+
+    static size_t PopInputIndex() {
+        unique_ptr<ProcessQueueItem> item;
+        string configName;
+        if (!ProcessQueueManager::GetInstance()->PopItem(0, item, configName)) {
+            return SIZE_MAX;
+        }
+        return item->mInputIndex;
+    }
+
+    static bool WaitFor(const atomic_int& cnt, int expected) {
+        for (int i = 0; i < 200 && cnt.load() != expected; ++i) {
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        return cnt.load() == expected;
+    }
+
+    CollectionPipelineContext mCtx;
+    QueueKey mKey = 0;
+};
+
+void PendingPushManagerUnittest::TestPushOnFeedback() {
+    atomic_int successCnt = 0;
+    auto item = GenerateItem(5);
+    APSARA_TEST_NOT_EQUAL(
+        0U, PendingPushManager::GetInstance()->Park(mKey, item, After(60000), [&](bool success) {
+            if (success) {
+                ++successCnt;
+            }
+        }));
+    APSARA_TEST_TRUE(PendingPushManager::GetInstance()->HasPendingItems(mKey));
+    this_thread::sleep_for(chrono::milliseconds(50));
+    APSARA_TEST_EQUAL(0, successCnt.load());
+
+    // the queue becomes valid to push when the low watermark is reached
+    APSARA_TEST_EQUAL(0U, PopInputIndex());
+    APSARA_TEST_EQUAL(1U, PopInputIndex());
+    APSARA_TEST_TRUE(WaitFor(successCnt, 1));
+    APSARA_TEST_FALSE(PendingPushManager::GetInstance()->HasPendingItems(mKey));
+    for (size_t i = 2; i <= 5; ++i) {
+        APSARA_TEST_EQUAL(i, PopInputIndex());
+    }
+}
+
+void PendingPushManagerUnittest::TestKeepOrder() {
+    atomic_int successCnt = 0;
+    for (size_t i = 5; i < 8; ++i) {
+        auto item = GenerateItem(i);
+        APSARA_TEST_NOT_EQUAL(
+            0U, PendingPushManager::GetInstance()->Park(mKey, item, After(60000), [&](bool success) {
+                if (success) {
+                    ++successCnt;
+                }
+            }));
+    }
+    // only 2 items can be pushed before the queue is full again
+    APSARA_TEST_EQUAL(0U, PopInputIndex());
+    APSARA_TEST_EQUAL(1U, PopInputIndex());
+    APSARA_TEST_TRUE(WaitFor(successCnt, 2));
+    APSARA_TEST_TRUE(PendingPushManager::GetInstance()->HasPendingItems(mKey));
+
+    APSARA_TEST_EQUAL(2U, PopInputIndex());
+    APSARA_TEST_EQUAL(3U, PopInputIndex());
+    APSARA_TEST_TRUE(WaitFor(successCnt, 3));
+    for (size_t i = 4; i < 8; ++i) {
+        APSARA_TEST_EQUAL(i, PopInputIndex());
+    }
+}
+
+void PendingPushManagerUnittest::TestDeadline() {
+    atomic_int failCnt = 0;
+    auto start = chrono::steady_clock::now();
+    auto item = GenerateItem(5);
+    PendingPushManager::GetInstance()->Park(mKey, item, After(100), [&](bool success) {
+        if (!success) {
+            ++failCnt;
+        }
+    });
+    APSARA_TEST_TRUE(WaitFor(failCnt, 1));
+    APSARA_TEST_TRUE(chrono::steady_clock::now() - start >= chrono::milliseconds(100));
+    APSARA_TEST_FALSE(PendingPushManager::GetInstance()->HasPendingItems(mKey));
+}
+
+void PendingPushManagerUnittest::TestCancel() {
+    atomic_int cnt = 0;
+    auto item = GenerateItem(5);
+    uint64_t token = PendingPushManager::GetInstance()->Park(mKey, item, After(60000), [&](bool) { ++cnt; });
+    APSARA_TEST_TRUE(PendingPushManager::GetInstance()->Cancel(token));
+    APSARA_TEST_FALSE(PendingPushManager::GetInstance()->Cancel(token));
+
+    APSARA_TEST_EQUAL(0U, PopInputIndex());
+    APSARA_TEST_EQUAL(1U, PopInputIndex());
+    this_thread::sleep_for(chrono::milliseconds(50));
+    APSARA_TEST_EQUAL(0, cnt.load());
+    APSARA_TEST_FALSE(PendingPushManager::GetInstance()->HasPendingItems(mKey));
+}
+
+void PendingPushManagerUnittest::TestMaxPendingCnt() {
+    INT32_FLAG(process_queue_max_pending_push_cnt) = 2;
+    for (size_t i = 5; i < 7; ++i) {
+        auto item = GenerateItem(i);
+        APSARA_TEST_NOT_EQUAL(0U, PendingPushManager::GetInstance()->Park(mKey, item, After(60000), nullptr));
+    }
+    // the item is left intact if rejected
+    auto item = GenerateItem(7);
+    APSARA_TEST_EQUAL(0U, PendingPushManager::GetInstance()->Park(mKey, item, After(60000), nullptr));
+    APSARA_TEST_NOT_EQUAL(nullptr, item.get());
+}
+
+void PendingPushManagerUnittest::TestQueueNotExist() {
+    atomic_int failCnt = 0;
+    QueueKey key = QueueKeyManager::GetInstance()->GetKey("not_exist_config");
+    auto item = GenerateItem(0);
+    PendingPushManager::GetInstance()->Park(key, item, After(60000), [&](bool success) {
+        if (!success) {
+            ++failCnt;
+        }
+    });
+    APSARA_TEST_TRUE(WaitFor(failCnt, 1));
+    APSARA_TEST_FALSE(PendingPushManager::GetInstance()->HasPendingItems(key));
+}
+
+void PendingPushManagerUnittest::TestStop() {
+    atomic_int failCnt = 0;
+    auto item = GenerateItem(5);
+    PendingPushManager::GetInstance()->Park(mKey, item, After(60000), [&](bool success) {
+        if (!success) {
+            ++failCnt;
+        }
+    });
+    PendingPushManager::GetInstance()->Stop();
+    APSARA_TEST_EQUAL(1, failCnt.load());
+    APSARA_TEST_FALSE(PendingPushManager::GetInstance()->HasPendingItems(mKey));
+
+    // nothing can be parked after stopped
+    item = GenerateItem(6);
+    APSARA_TEST_EQUAL(0U, PendingPushManager::GetInstance()->Park(mKey, item, After(60000), nullptr));
+}
+
+UNIT_TEST_CASE(PendingPushManagerUnittest, TestPushOnFeedback)
+UNIT_TEST_CASE(PendingPushManagerUnittest, TestKeepOrder)
+UNIT_TEST_CASE(PendingPushManagerUnittest, TestDeadline)
+UNIT_TEST_CASE(PendingPushManagerUnittest, TestCancel)
+UNIT_TEST_CASE(PendingPushManagerUnittest, TestMaxPendingCnt)
+UNIT_TEST_CASE(PendingPushManagerUnittest, TestQueueNotExist)
+UNIT_TEST_CASE(PendingPushManagerUnittest, TestStop)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -19,6 +19,7 @@
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "collection_pipeline/queue/QueueParam.h"
+#include "common/memory/MemoryGovernor.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
 
@@ -33,6 +34,7 @@ public:
     void TestDeleteQueue();
     void TestSetQueueUpstreamAndDownStream();
     void TestPushQueue();
+    void TestPushQueueUnderMemoryPressure();
     void TestPopItem();
     void TestIsAllQueueEmpty();
     void OnPipelineUpdate();
@@ -260,6 +262,31 @@ void ProcessQueueManagerUnittest::TestPushQueue() {
     APSARA_TEST_EQUAL(QueueStatus::QUEUE_FULL, sProcessQueueManager->PushQueue(1, GenerateItem()));
 }
 
+void ProcessQueueManagerUnittest::TestPushQueueUnderMemoryPressure() {
+    auto governor = MemoryGovernor::GetInstance();
+    sProcessQueueManager->CreateOrUpdateCountBoundedQueue(0, 0, sCtx);
+    sProcessQueueManager->CreateOrUpdateCountBoundedQueue(1, 2, sCtx);
+
+    // the least important queue is throttled first
+    uint64_t base = governor->GetTotalBytes();
+    MemoryAccount account(MemoryCategory::READER_CACHE);
+    governor->SetBudget(100000);
+    account.Update(70000 - base);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::SOFT, governor->GetLevel());
+    APSARA_TEST_TRUE(sProcessQueueManager->IsValidToPush(0));
+    APSARA_TEST_EQUAL(QueueStatus::OK, sProcessQueueManager->PushQueue(0, GenerateItem()));
+    APSARA_TEST_FALSE(sProcessQueueManager->IsValidToPush(1));
+    APSARA_TEST_EQUAL(QueueStatus::QUEUE_FULL, sProcessQueueManager->PushQueue(1, GenerateItem()));
+
+    // all queues are throttled on critical level
+    governor->SetBudget(1);
+    APSARA_TEST_EQUAL(MemoryPressureLevel::CRITICAL, governor->GetLevel());
+    APSARA_TEST_EQUAL(QueueStatus::QUEUE_FULL, sProcessQueueManager->PushQueue(0, GenerateItem()));
+
+    governor->SetBudget(0);
+    APSARA_TEST_EQUAL(QueueStatus::OK, sProcessQueueManager->PushQueue(1, GenerateItem()));
+}
+
 void ProcessQueueManagerUnittest::TestPopItem() {
     unique_ptr<ProcessQueueItem> item;
     string configName;
@@ -447,6 +474,7 @@ UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestUpdateDifferentTypeQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestDeleteQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestSetQueueUpstreamAndDownStream)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPushQueue)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPushQueueUnderMemoryPressure)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItem)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestIsAllQueueEmpty)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, OnPipelineUpdate)
@@ -0,0 +1,154 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/LogFileOperator.h"
+#include "file_server/reader/FileReadEngine.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// Measures the time to read the new bytes of many slowly growing files, one pread per file against one batch of reads
+// per batch_file_read_max_files files, which is how the files of a batch of modify events are read ahead.
+class BatchFileReaderBenchmark : public testing::Test {
+public:
+    void TestActiveFiles();
+
+protected:
+    static void SetUpTestCase() {
+#if defined(__linux__)
+        rlimit limit;
+        if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+            limit.rlim_cur = limit.rlim_max;
+            setrlimit(RLIMIT_NOFILE, &limit);
+        }
+#endif
+    }
+
+    void TearDown() override {
+        mFileOps.clear();
+        filesystem::remove_all(sTestDir);
+    }
+
+private:
+    void PrepareFiles(size_t fileCnt);
+    // returns the average cost of reading all files in microseconds
+    double Measure(FileReadEngine& engine, bool useRegisteredBuffers);
+
+    static const filesystem::path sTestDir;
+    static const size_t sBatchSize = 256;
+    static const size_t sBufferSize = 64 * 1024;
+    static const size_t sLineSize = 200;
+    static const size_t sRounds = 10;
+
+    vector<unique_ptr<LogFileOperator>> mFileOps;
+    vector<string> mBuffers;
+};
+
+const filesystem::path BatchFileReaderBenchmark::sTestDir = "./batch_file_reader_benchmark";
+
+void BatchFileReaderBenchmark::PrepareFiles(size_t fileCnt) {
+    mFileOps.clear();
+    filesystem::remove_all(sTestDir);
+    filesystem::create_directories(sTestDir);
+    string line(sLineSize - 1, 'a');
+    line += '\n';
+    for (size_t i = 0; i < fileCnt; ++i) {
+        auto path = sTestDir / ("file_" + to_string(i) + ".log");
+        ofstream(path) << line;
+        mFileOps.emplace_back(new LogFileOperator());
+        if (mFileOps.back()->Open(path.string().c_str()) < 0) {
+            mFileOps.pop_back();
+            break;
+        }
+    }
+    mBuffers.assign(sBatchSize, string(sBufferSize, '\0'));
+}
+
+double BatchFileReaderBenchmark::Measure(FileReadEngine& engine, bool useRegisteredBuffers) {
+    if (useRegisteredBuffers) {
+        vector<pair<char*, size_t>> buffers;
+        for (auto& buffer : mBuffers) {
+            buffers.emplace_back(buffer.data(), buffer.size());
+        }
+        if (!engine.RegisterBuffers(buffers)) {
+            return -1;
+        }
+    }
+    vector<FileReadRequest> requests;
+    requests.reserve(sBatchSize);
+    auto start = chrono::steady_clock::now();
+    for (size_t round = 0; round < sRounds; ++round) {
+        for (size_t begin = 0; begin < mFileOps.size(); begin += sBatchSize) {
+            requests.clear();
+            for (size_t i = begin; i < min(mFileOps.size(), begin + sBatchSize); ++i) {
+                FileReadRequest request;
+                request.mFileOp = mFileOps[i].get();
+                request.mBufIndex = static_cast<int32_t>(i - begin);
+                request.mBuf = mBuffers[request.mBufIndex].data();
+                request.mSize = sBufferSize;
+                requests.push_back(request);
+            }
+            engine.Read(requests);
+            for (const auto& request : requests) {
+                APSARA_TEST_EQUAL(static_cast<int64_t>(sLineSize), request.mResult);
+            }
+        }
+    }
+    auto cost = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    return static_cast<double>(cost) / sRounds;
+}
+
+void BatchFileReaderBenchmark::TestActiveFiles() {
+    for (size_t fileCnt : {1000, 5000, 10000}) {
+        PrepareFiles(fileCnt);
+        if (mFileOps.size() < fileCnt) {
+            cout << "[" << fileCnt << " files] skipped, too many open files" << endl;
+            continue;
+        }
+        auto pread = FileReadEngine::Create(false, sBatchSize);
+        cout << "[" << fileCnt << " files] pread: " << Measure(*pread, false) << " us";
+        auto ioUring = FileReadEngine::Create(true, sBatchSize);
+        if (string(ioUring->GetName()) == "io_uring") {
+            cout << ", io_uring: " << Measure(*ioUring, false) << " us";
+            double registered = Measure(*ioUring, true);
+            if (registered >= 0) {
+                cout << ", io_uring with registered buffers: " << registered << " us";
+            }
+        } else {
+            cout << ", io_uring: not available";
+        }
+        cout << endl;
+    }
+}
+
+UNIT_TEST_CASE(BatchFileReaderBenchmark, TestActiveFiles)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,212 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/Flags.h"
+#include "common/LogFileOperator.h"
+#include "file_server/reader/BatchFileReader.h"
+#include "file_server/reader/FileReadEngine.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(batch_file_read_max_files);
+DECLARE_FLAG_INT32(batch_file_read_buffer_size_kb);
+
+using namespace std;
+
+namespace logtail {
+
+static const filesystem::path kTestDir = "batch_file_reader_unittest";
+
+static string GetContent(size_t idx) {
+    return "file " + to_string(idx) + " " + string(idx % 100, 'a') + "\n";
+}
+
+class FileReadEngineUnittest : public testing::Test {
+public:
+    void TestPread();
+    void TestIoUring();
+
+protected:
+    void SetUp() override {
+        filesystem::create_directories(kTestDir);
+        for (size_t i = 0; i < sFileCnt; ++i) {
+            auto path = kTestDir / ("file_" + to_string(i) + ".log");
+            ofstream(path) << GetContent(i);
+            mFileOps.emplace_back(new LogFileOperator());
+            mFileOps.back()->Open(path.string().c_str());
+        }
+    }
+
+    void TearDown() override {
+        mFileOps.clear();
+        filesystem::remove_all(kTestDir);
+    }
+
+    void ReadAndCheck(FileReadEngine& engine, bool useRegisteredBuffers) {
+        vector<string> buffers(sFileCnt, string(256, '\0'));
+        if (useRegisteredBuffers) {
+            vector<pair<char*, size_t>> registered;
+            for (auto& buffer : buffers) {
+                registered.emplace_back(buffer.data(), buffer.size());
+            }
+            engine.RegisterBuffers(registered);
+        }
+        vector<FileReadRequest> requests(sFileCnt);
+        for (size_t i = 0; i < sFileCnt; ++i) {
+            requests[i].mFileOp = mFileOps[i].get();
+            requests[i].mBuf = buffers[i].data();
+            requests[i].mSize = buffers[i].size();
+            // skip the prefix "file "
+            requests[i].mOffset = 5;
+            requests[i].mBufIndex = useRegisteredBuffers ? static_cast<int32_t>(i) : -1;
+        }
+        engine.Read(requests);
+        for (size_t i = 0; i < sFileCnt; ++i) {
+            string expected = GetContent(i).substr(5);
+            APSARA_TEST_EQUAL(static_cast<int64_t>(expected.size()), requests[i].mResult);
+            APSARA_TEST_EQUAL(expected, buffers[i].substr(0, expected.size()));
+        }
+    }
+
+    static const size_t sFileCnt = 20;
+    vector<unique_ptr<LogFileOperator>> mFileOps;
+};
+
+void FileReadEngineUnittest::TestPread() {
+    auto engine = FileReadEngine::Create(false, 8);
+    APSARA_TEST_EQUAL(string("pread"), string(engine->GetName()));
+    ReadAndCheck(*engine, false);
+    APSARA_TEST_FALSE(engine->RegisterBuffers({}));
+}
+
+void FileReadEngineUnittest::TestIoUring() {
+    // more requests than the queue depth, so that they are submitted in several rounds
+    auto engine = FileReadEngine::Create(true, 8);
+    if (string(engine->GetName()) != "io_uring") {
+        // io_uring may be disabled by the kernel or seccomp, where pread is used instead
+        ReadAndCheck(*engine, false);
+        return;
+    }
+    ReadAndCheck(*engine, false);
+    ReadAndCheck(*engine, true);
+}
+
+UNIT_TEST_CASE(FileReadEngineUnittest, TestPread)
+UNIT_TEST_CASE(FileReadEngineUnittest, TestIoUring)
+
+class BatchFileReaderUnittest : public testing::Test {
+public:
+    void TestReadAhead();
+    void TestReadAheadWithFileGrown();
+    void TestReadAheadDropped();
+
+protected:
+    void SetUp() override {
+        filesystem::create_directories(kTestDir);
+        ofstream(kTestDir / "test.log") << mContent;
+        readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        mReader = make_shared<LogFileReader>(kTestDir.string(),
+                                             "test.log",
+                                             DevInode(),
+                                             make_pair(&readerOpts, &ctx),
+                                             make_pair(&multilineOpts, &ctx),
+                                             make_pair(&fileTagOpts, &ctx));
+        mReader->UpdateReaderManual();
+        mReader->InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        mReader->CheckFileSignatureAndOffset(true);
+    }
+
+    void TearDown() override {
+        mBatchFileReader.reset();
+        mReader.reset();
+        INT32_FLAG(batch_file_read_max_files) = 256;
+        INT32_FLAG(batch_file_read_buffer_size_kb) = 64;
+        filesystem::remove_all(kTestDir);
+    }
+
+    string ReadAll() {
+        LogBuffer logBuffer;
+        bool moreData = false;
+        mReader->ReadUTF8(logBuffer, mReader->mLogFileOp.GetFileSize(), moreData);
+        return string(logBuffer.rawBuffer.data(), logBuffer.rawBuffer.size());
+    }
+
+    const string mContent = "line 1\nline 2\nline 3\n";
+    unique_ptr<BatchFileReader> mBatchFileReader = make_unique<BatchFileReader>();
+    LogFileReaderPtr mReader;
+    MultilineOptions multilineOpts;
+    FileReaderOptions readerOpts;
+    FileTagOptions fileTagOpts;
+    CollectionPipelineContext ctx;
+};
+
+void BatchFileReaderUnittest::TestReadAhead() {
+    // the same reader is read only once
+    mBatchFileReader->Read({mReader, mReader});
+    APSARA_TEST_EQUAL(1U, mBatchFileReader->mReaders.size());
+    APSARA_TEST_EQUAL(mContent.size(), mReader->mReadAheadSize);
+    APSARA_TEST_EQUAL(0, mReader->mReadAheadOffset);
+
+    // served by the bytes read ahead
+    ofstream(kTestDir / "test.log", ios::trunc) << string(mContent.size(), 'x');
+    APSARA_TEST_EQUAL("line 1\nline 2\nline 3", ReadAll());
+    APSARA_TEST_EQUAL(nullptr, mReader->mReadAheadData);
+    mBatchFileReader->Clear();
+    APSARA_TEST_TRUE(mBatchFileReader->mReaders.empty());
+}
+
+void BatchFileReaderUnittest::TestReadAheadWithFileGrown() {
+    mBatchFileReader->Read({mReader});
+    APSARA_TEST_EQUAL(mContent.size(), mReader->mReadAheadSize);
+
+    // the rest is read from the file
+    ofstream(kTestDir / "test.log", ios::app) << "line 4\n";
+    mReader->CheckFileSignatureAndOffset(true);
+    APSARA_TEST_EQUAL("line 1\nline 2\nline 3\nline 4", ReadAll());
+}
+
+void BatchFileReaderUnittest::TestReadAheadDropped() {
+    // dropped when the buffers are to be reused
+    mBatchFileReader->Read({mReader});
+    mBatchFileReader->Clear();
+    APSARA_TEST_EQUAL(nullptr, mReader->mReadAheadData);
+    APSARA_TEST_EQUAL("line 1\nline 2\nline 3", ReadAll());
+
+    // dropped when the read starts at another offset
+    ofstream(kTestDir / "test.log", ios::app) << "line 4\n";
+    mBatchFileReader->Read({mReader});
+    APSARA_TEST_EQUAL(string("line 4\n").size(), mReader->mReadAheadSize);
+    mReader->mLastFilePos = 0;
+    mReader->mCache.clear();
+    mReader->CheckFileSignatureAndOffset(true);
+    APSARA_TEST_EQUAL("line 1\nline 2\nline 3\nline 4", ReadAll());
+
+    // dropped when the file is closed
+    mBatchFileReader->Read({mReader});
+    mReader->CloseFilePtr();
+    APSARA_TEST_EQUAL(nullptr, mReader->mReadAheadData);
+}
+
+UNIT_TEST_CASE(BatchFileReaderUnittest, TestReadAhead)
+UNIT_TEST_CASE(BatchFileReaderUnittest, TestReadAheadWithFileGrown)
+UNIT_TEST_CASE(BatchFileReaderUnittest, TestReadAheadDropped)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,320 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/http/Curl.h"
+#include "runner/FlusherRunner.h"
+#include "runner/sink/http/HttpSink.h"
+#include "unittest/Unittest.h"
+#include "unittest/plugin/PluginMock.h"
+
+DECLARE_FLAG_INT32(http_sink_max_idle_curl_handlers_per_host);
+
+using namespace std;
+
+namespace logtail {
+
+// sends items to the given local port
+class LocalFlusherHttpMock : public FlusherHttpMock {
+public:
+    bool BuildRequest(SenderQueueItem* item,
+                      unique_ptr<HttpSinkRequest>& req,
+                      [[maybe_unused]] bool* keepItem,
+                      [[maybe_unused]] string* errMsg) override {
+        req = make_unique<HttpSinkRequest>(
+            "POST", false, "127.0.0.1", mPort, "/", "", map<string, string>(), item->mData, item);
+        return true;
+    }
+    void OnSendDone(const HttpResponse& response, [[maybe_unused]] SenderQueueItem* item) override {
+        mStatusCode = response.GetStatusCode();
+    }
+
+    int32_t mPort = 0;
+    int32_t mStatusCode = 0;
+};
+
+class HttpSinkUnittest : public ::testing::Test {
+public:
+    void TestGetCurlHandlerKey();
+    void TestIdleCurlHandlers();
+    void TestReuseCurlHandler();
+    void TestGetHttp2Mode();
+    void TestStageLatency();
+
+protected:
+    void TearDown() override {
+        INT32_FLAG(http_sink_max_idle_curl_handlers_per_host) = 32;
+        HttpSink::GetInstance()->mQueue.Clear();
+    }
+
+private:
+    // listens on a random local port, returns the socket or -1 on failure
+    static int Listen(int32_t& port);
+    // accepts cnt connections on the listening socket, each carrying one request, and records the raw requests
+    static void ServeRequests(int listenFd, size_t cnt, vector<string>& requests);
+};
+
+void HttpSinkUnittest::TestGetCurlHandlerKey() {
+    HttpSinkRequest request("POST", true, "test.endpoint", 443, "/path", "a=b", {{"k", "v"}}, "body", nullptr);
+    APSARA_TEST_EQUAL("https://test.endpoint:443", HttpSink::GetCurlHandlerKey(request));
+
+    // the path, query, headers and body do not matter
+    HttpSinkRequest sameEndpoint("GET", true, "test.endpoint", 443, "/other", "", {}, "", nullptr);
+    APSARA_TEST_EQUAL(HttpSink::GetCurlHandlerKey(request), HttpSink::GetCurlHandlerKey(sameEndpoint));
+
+    // scheme, host and port do
+    HttpSinkRequest http("POST", false, "test.endpoint", 443, "/path", "", {}, "", nullptr);
+    HttpSinkRequest otherHost("POST", true, "other.endpoint", 443, "/path", "", {}, "", nullptr);
+    HttpSinkRequest otherPort("POST", true, "test.endpoint", 8443, "/path", "", {}, "", nullptr);
+    APSARA_TEST_EQUAL("http://test.endpoint:443", HttpSink::GetCurlHandlerKey(http));
+    APSARA_TEST_EQUAL("https://other.endpoint:443", HttpSink::GetCurlHandlerKey(otherHost));
+    APSARA_TEST_EQUAL("https://test.endpoint:8443", HttpSink::GetCurlHandlerKey(otherPort));
+}
+
+void HttpSinkUnittest::TestIdleCurlHandlers() {
+    INT32_FLAG(http_sink_max_idle_curl_handlers_per_host) = 2;
+    HttpSink sink;
+    APSARA_TEST_EQUAL(nullptr, sink.GetIdleCurlHandler("http://host:80"));
+
+    CURL* handler1 = curl_easy_init();
+    CURL* handler2 = curl_easy_init();
+    CURL* handler3 = curl_easy_init();
+    CURL* handler4 = curl_easy_init();
+    sink.ReleaseCurlHandler("http://host:80", handler1);
+    sink.ReleaseCurlHandler("http://host:80", handler2);
+    // beyond the limit, cleaned up instead of being kept
+    sink.ReleaseCurlHandler("http://host:80", handler3);
+    sink.ReleaseCurlHandler("https://host:443", handler4);
+    APSARA_TEST_EQUAL(2U, sink.mIdleCurlHandlers["http://host:80"].size());
+    APSARA_TEST_EQUAL(1U, sink.mIdleCurlHandlers["https://host:443"].size());
+
+    // the most recently released one is reused first, since its connection is the most likely to be alive
+    APSARA_TEST_EQUAL(handler2, sink.GetIdleCurlHandler("http://host:80"));
+    APSARA_TEST_EQUAL(handler1, sink.GetIdleCurlHandler("http://host:80"));
+    APSARA_TEST_EQUAL(nullptr, sink.GetIdleCurlHandler("http://host:80"));
+    APSARA_TEST_EQUAL(nullptr, sink.GetIdleCurlHandler("http://other:80"));
+
+    sink.ReleaseCurlHandler("http://host:80", handler1);
+    sink.ReleaseCurlHandler("http://host:80", handler2);
+    sink.ClearIdleCurlHandlers();
+    APSARA_TEST_TRUE(sink.mIdleCurlHandlers.empty());
+}
+
+void HttpSinkUnittest::TestReuseCurlHandler() {
+    int32_t port = 0;
+    int listenFd = Listen(port);
+    APSARA_TEST_TRUE_FATAL(listenFd >= 0);
+
+    vector<string> requests;
+    thread server(&HttpSinkUnittest::ServeRequests, listenFd, 2, ref(requests));
+
+    HttpResponse response1;
+    curl_slist* headers1 = nullptr;
+    CURL* curl = CreateCurlHandler("POST",
+                                   false,
+                                   "127.0.0.1",
+                                   port,
+                                   "/first",
+                                   "a=b",
+                                   {{"x-test-header", "1"}},
+                                   "test body",
+                                   response1,
+                                   headers1,
+                                   5);
+    APSARA_TEST_NOT_EQUAL(nullptr, curl);
+    // an option set outside CreateCurlHandler, as HttpSink does for http2
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "test-agent");
+    APSARA_TEST_EQUAL(CURLE_OK, curl_easy_perform(curl));
+    // the header list is freed once the request is done, the reused handler must no longer refer to it
+    curl_slist_free_all(headers1);
+
+    HttpResponse response2;
+    curl_slist* headers2 = nullptr;
+    CURL* reusedCurl = CreateCurlHandler("GET",
+                                         false,
+                                         "127.0.0.1",
+                                         port,
+                                         "/second",
+                                         "",
+                                         {},
+                                         "",
+                                         response2,
+                                         headers2,
+                                         5,
+                                         "",
+                                         false,
+                                         nullopt,
+                                         nullopt,
+                                         curl);
+    APSARA_TEST_EQUAL(curl, reusedCurl);
+    APSARA_TEST_EQUAL(nullptr, headers2);
+    APSARA_TEST_EQUAL(CURLE_OK, curl_easy_perform(curl));
+    curl_easy_cleanup(curl);
+
+    server.join();
+    close(listenFd);
+    APSARA_TEST_EQUAL_FATAL(2U, requests.size());
+    APSARA_TEST_EQUAL(0U, requests[0].find("POST /first?a=b HTTP/1.1\r\n"));
+    APSARA_TEST_NOT_EQUAL(string::npos, requests[0].find("x-test-header:"));
+    APSARA_TEST_NOT_EQUAL(string::npos, requests[0].find("test-agent"));
+    APSARA_TEST_NOT_EQUAL(string::npos, requests[0].find("\r\n\r\ntest body"));
+    APSARA_TEST_EQUAL(0U, requests[1].find("GET /second HTTP/1.1\r\n"));
+    APSARA_TEST_EQUAL(string::npos, requests[1].find("x-test-header"));
+    APSARA_TEST_EQUAL(string::npos, requests[1].find("test-agent"));
+    APSARA_TEST_EQUAL(string::npos, requests[1].find("test body"));
+    APSARA_TEST_EQUAL(string::npos, requests[1].find("Content-Length"));
+}
+
+void HttpSinkUnittest::TestGetHttp2Mode() {
+    APSARA_TEST_EQUAL(0, HttpSink::GetHttp2Mode(0, CURL_VERSION_HTTP2));
+    APSARA_TEST_EQUAL(1, HttpSink::GetHttp2Mode(1, CURL_VERSION_HTTP2));
+    APSARA_TEST_EQUAL(2, HttpSink::GetHttp2Mode(2, CURL_VERSION_HTTP2 | CURL_VERSION_SSL));
+    // not supported by libcurl, falls back to the default http version
+    APSARA_TEST_EQUAL(0, HttpSink::GetHttp2Mode(1, 0));
+    APSARA_TEST_EQUAL(0, HttpSink::GetHttp2Mode(2, CURL_VERSION_SSL));
+}
+
+void HttpSinkUnittest::TestStageLatency() {
+    int32_t port = 0;
+    int listenFd = Listen(port);
+    APSARA_TEST_TRUE_FATAL(listenFd >= 0);
+    vector<string> requests;
+    thread server(&HttpSinkUnittest::ServeRequests, listenFd, 1, ref(requests));
+
+    auto flusher = make_unique<LocalFlusherHttpMock>();
+    flusher->mPort = port;
+    Json::Value tmp;
+    CollectionPipelineContext ctx;
+    flusher->SetContext(ctx);
+    flusher->CreateMetricsRecordRef("name", "1");
+    flusher->Init(Json::Value(), tmp);
+    flusher->CreateStageLatencyHistograms();
+    flusher->CommitMetricsRecordRef();
+    // batched and serialized stages are recorded by the flusher itself, which is not the case for the mock
+    auto& batched = flusher->mStageLatencyMs[static_cast<size_t>(FlusherStage::BATCHED)];
+    auto& serialized = flusher->mStageLatencyMs[static_cast<size_t>(FlusherStage::SERIALIZED)];
+    auto& sent = flusher->mStageLatencyMs[static_cast<size_t>(FlusherStage::SENT)];
+    auto& acked = flusher->mStageLatencyMs[static_cast<size_t>(FlusherStage::ACKED)];
+    APSARA_TEST_EQUAL(nullptr, batched);
+    APSARA_TEST_EQUAL(nullptr, serialized);
+    APSARA_TEST_TRUE_FATAL(sent != nullptr);
+    APSARA_TEST_TRUE_FATAL(acked != nullptr);
+
+    auto item = make_unique<SenderQueueItem>("content", 7, flusher.get(), flusher->GetQueueKey());
+    item->mEventCreateTime = chrono::system_clock::now() - chrono::milliseconds(100);
+    APSARA_TEST_TRUE(FlusherRunner::GetInstance()->PushToHttpSink(item.get(), false));
+    APSARA_TEST_EQUAL(1U, sent->GetCount());
+    APSARA_TEST_EQUAL(0U, acked->GetCount());
+    APSARA_TEST_TRUE(sent->GetPercentile(100) >= 100);
+
+    // the sink of unit test is a mock, so the request is sent by a real one
+    unique_ptr<HttpSinkRequest> request;
+    APSARA_TEST_TRUE_FATAL(HttpSink::GetInstance()->mQueue.TryPop(request));
+    HttpSink sink;
+    sink.mClient = curl_multi_init();
+    APSARA_TEST_TRUE(sink.AddRequestToClient(std::move(request)));
+    sink.DoRun();
+    sink.ClearIdleCurlHandlers();
+    curl_multi_cleanup(sink.mClient);
+    server.join();
+    close(listenFd);
+
+    APSARA_TEST_EQUAL(200, flusher->mStatusCode);
+    APSARA_TEST_EQUAL(1U, acked->GetCount());
+    APSARA_TEST_TRUE(acked->GetPercentile(100) >= sent->GetPercentile(100));
+
+    // retries are not counted as sent again
+    item->mTryCnt = 2;
+    APSARA_TEST_TRUE(FlusherRunner::GetInstance()->PushToHttpSink(item.get(), false));
+    FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
+    APSARA_TEST_EQUAL(1U, sent->GetCount());
+
+    // items without create time are skipped
+    item->mTryCnt = 1;
+    item->mEventCreateTime = chrono::system_clock::time_point();
+    APSARA_TEST_TRUE(FlusherRunner::GetInstance()->PushToHttpSink(item.get(), false));
+    FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
+    APSARA_TEST_EQUAL(1U, sent->GetCount());
+}
+
+int HttpSinkUnittest::Listen(int32_t& port) {
+    int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        return -1;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t addrLen = sizeof(addr);
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), addrLen) != 0 || listen(listenFd, 2) != 0
+        || getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &addrLen) != 0) {
+        close(listenFd);
+        return -1;
+    }
+    port = ntohs(addr.sin_port);
+    return listenFd;
+}
+
+void HttpSinkUnittest::ServeRequests(int listenFd, size_t cnt, vector<string>& requests) {
+    for (size_t i = 0; i < cnt; ++i) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        string request;
+        char buf[4096];
+        size_t headerEnd = string::npos;
+        size_t contentLength = 0;
+        while (headerEnd == string::npos || request.size() < headerEnd + 4 + contentLength) {
+            auto n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) {
+                break;
+            }
+            request.append(buf, n);
+            if (headerEnd == string::npos && (headerEnd = request.find("\r\n\r\n")) != string::npos) {
+                auto pos = request.find("Content-Length:");
+                if (pos != string::npos && pos < headerEnd) {
+                    contentLength = stoul(request.substr(pos + strlen("Content-Length:")));
+                }
+            }
+        }
+        requests.emplace_back(std::move(request));
+        string response = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        send(fd, response.data(), response.size(), 0);
+        close(fd);
+    }
+}
+
+UNIT_TEST_CASE(HttpSinkUnittest, TestGetCurlHandlerKey)
+UNIT_TEST_CASE(HttpSinkUnittest, TestIdleCurlHandlers)
+UNIT_TEST_CASE(HttpSinkUnittest, TestReuseCurlHandler)
+UNIT_TEST_CASE(HttpSinkUnittest, TestGetHttp2Mode)
+UNIT_TEST_CASE(HttpSinkUnittest, TestStageLatency)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN